@@ -0,0 +1,672 @@
+/**
+ * @file bench_dispatch.c
+ * @brief 调度器微基准测试 / Dispatcher microbenchmark / Dispatcher-Mikrobenchmark
+ * @details 使用空操作插件和生成的.nxpt规则集测量调度开销：直接调用、单跳、主动调用链、广播扇出、批量元组调用和规则数量扩展 / Measures dispatch overhead with the no-op plugin and generated .nxpt rule sets: direct calls, single hops, active call chains, broadcast fan-out, batched tuple calls and rule count scaling / Misst den Dispatch-Aufwand mit dem No-Op-Plugin und generierten .nxpt-Regelsätzen: direkte Aufrufe, Einzelsprünge, aktive Aufrufketten, Broadcast-Fan-out, Stapel-Tupelaufrufe und Skalierung der Regelanzahl
+ *
+ * 用法 / Usage / Verwendung:
+ *   bench_dispatch [--plugin PATH] [--iterations N] [--max-rules N]
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_plugin.h"
+#include "nxld_logger.h"
+#include "nxld_transfer_rules.h"
+#include "nxld_transfer_plan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+
+#define DEFAULT_PLUGIN_PATH "bench/bench_noop_plugin.so"
+#define DEFAULT_ITERATIONS 1000000
+#define DEFAULT_MAX_RULES 100000
+#define MAX_LATENCY_SAMPLES 100000
+#define WARMUP_CALLS 1000
+#define TARGET_PLUGIN_COUNT 64
+#define LOOKUP_TABLE_SIZE 1024
+#define MAX_PATH_LENGTH 4096
+#define BATCH_TUPLE_SIZE 2
+#define BATCH_TUPLE_COUNT 4096
+
+/**
+ * @brief 分配计数（glibc上替换malloc系列函数） / Allocation counter (replaces the malloc family on glibc) / Zuweisungszähler (ersetzt die malloc-Familie unter glibc)
+ */
+static size_t g_allocations = 0;
+
+#if defined(__GLIBC__)
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+    __atomic_add_fetch(&g_allocations, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    __atomic_add_fetch(&g_allocations, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    __atomic_add_fetch(&g_allocations, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, size);
+}
+#define ALLOCATIONS_COUNTED 1
+#else
+#define ALLOCATIONS_COUNTED 0
+#endif
+
+/**
+ * @brief 基准测试结果结构体 / Benchmark result structure / Benchmark-Ergebnisstruktur
+ */
+typedef struct {
+    double ns_per_call;                     /**< 每次调用纳秒数 / Nanoseconds per call / Nanosekunden pro Aufruf */
+    double allocations_per_call;            /**< 每次调用分配次数 / Allocations per call / Zuweisungen pro Aufruf */
+    double p50;                             /**< 延迟中位数（纳秒） / Median latency in ns / Median-Latenz in ns */
+    double p99;                             /**< 99分位延迟（纳秒） / 99th percentile latency in ns / 99.-Perzentil-Latenz in ns */
+    double p999;                            /**< 99.9分位延迟（纳秒） / 99.9th percentile latency in ns / 99,9.-Perzentil-Latenz in ns */
+    double max;                             /**< 最大延迟（纳秒） / Maximum latency in ns / Maximale Latenz in ns */
+    int failed;                             /**< 调用是否失败 / Whether calls failed / Ob Aufrufe fehlgeschlagen sind */
+} bench_result_t;
+
+/**
+ * @brief 被测调用函数类型 / Measured call function type / Typ der gemessenen Aufruffunktion
+ */
+typedef int (*bench_call_t)(void* arg, size_t iteration);
+
+/**
+ * @brief 计划调用参数结构体 / Plan call argument structure / Plan-Aufrufargument-Struktur
+ */
+typedef struct {
+    nxld_transfer_plan_t* plan;             /**< 执行计划 / Execution plan / Ausführungsplan */
+    size_t route;                           /**< 路由索引 / Route index / Routenindex */
+    void* value;                            /**< 源参数值 / Source parameter value / Quellparameterwert */
+    char (*source_names)[32];               /**< 按名称查找时的源接口名称表 / Source interface names for lookups by name / Quellschnittstellennamen für Suchen per Name */
+    void** tuples;                          /**< 批量调用的元组数组 / Tuple array for batch calls / Tupel-Array für Stapelaufrufe */
+    size_t batch_size;                      /**< 每次批量调用的元组数量 / Tuples per batch call / Tupel pro Stapelaufruf */
+} plan_call_t;
+
+static size_t g_iterations = DEFAULT_ITERATIONS;
+static double* g_samples = NULL;
+static char g_plugin_path[MAX_PATH_LENGTH];
+static char g_work_dir[MAX_PATH_LENGTH - 64];
+static int g_bench_value = 42;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * @brief 测量调用函数的吞吐、分配和尾延迟 / Measure throughput, allocations and tail latency of a call function / Durchsatz, Zuweisungen und Tail-Latenz einer Aufruffunktion messen
+ * @details 吞吐量在无逐次计时的循环中测量；尾延迟另外逐次计时采样 / Throughput is measured in a loop without per-call timing; tail latency is sampled separately with per-call timing / Der Durchsatz wird ohne Einzelzeitmessung gemessen; die Tail-Latenz wird separat mit Einzelzeitmessung erfasst
+ */
+static void measure(bench_call_t call, void* arg, size_t iterations, bench_result_t* result) {
+    memset(result, 0, sizeof(bench_result_t));
+
+    for (size_t i = 0; i < WARMUP_CALLS; i++) {
+        if (call(arg, i) != 0) {
+            result->failed = 1;
+            return;
+        }
+    }
+
+    size_t allocations = __atomic_load_n(&g_allocations, __ATOMIC_RELAXED);
+    uint64_t start = now_ns();
+    for (size_t i = 0; i < iterations; i++) {
+        call(arg, i);
+    }
+    uint64_t elapsed = now_ns() - start;
+    allocations = __atomic_load_n(&g_allocations, __ATOMIC_RELAXED) - allocations;
+    result->ns_per_call = (double)elapsed / (double)iterations;
+    result->allocations_per_call = (double)allocations / (double)iterations;
+
+    size_t samples = iterations < MAX_LATENCY_SAMPLES ? iterations : MAX_LATENCY_SAMPLES;
+    for (size_t i = 0; i < samples; i++) {
+        uint64_t t0 = now_ns();
+        call(arg, i);
+        g_samples[i] = (double)(now_ns() - t0);
+    }
+    qsort(g_samples, samples, sizeof(double), compare_double);
+    result->p50 = g_samples[samples / 2];
+    result->p99 = g_samples[(size_t)((double)samples * 0.99)];
+    result->p999 = g_samples[(size_t)((double)samples * 0.999)];
+    result->max = g_samples[samples - 1];
+}
+
+static void print_header(void) {
+    printf("%-12s %-22s %7s %12s %10s %9s %11s %8s %8s %8s %9s\n",
+           "scenario", "variant", "hops", "calls/s", "ns/call", "ns/hop", "allocs/call", "p50", "p99", "p99.9", "max");
+}
+
+static void print_result(const char* scenario, const char* variant, size_t hops, const bench_result_t* result) {
+    if (result->failed) {
+        printf("%-12s %-22s %7zu %12s\n", scenario, variant, hops, "failed");
+        return;
+    }
+    char allocations[32];
+    if (ALLOCATIONS_COUNTED) {
+        snprintf(allocations, sizeof(allocations), "%.3f", result->allocations_per_call);
+    } else {
+        snprintf(allocations, sizeof(allocations), "n/a");
+    }
+    printf("%-12s %-22s %7zu %12.0f %10.1f %9.2f %11s %8.0f %8.0f %8.0f %9.0f\n",
+           scenario, variant, hops, 1e9 / result->ns_per_call, result->ns_per_call,
+           result->ns_per_call / (double)(hops > 0 ? hops : 1), allocations,
+           result->p50, result->p99, result->p999, result->max);
+    fflush(stdout);
+}
+
+/* ---------- 直接调用 / Direct calls / Direkte Aufrufe ---------- */
+
+static int (*volatile g_noop0)(void);
+static int (*volatile g_noop_int1)(int);
+static int (*volatile g_noop_int4)(int, int, int, int);
+static int (*volatile g_noop_int8)(int, int, int, int, int, int, int, int);
+static int (*volatile g_noop_ptr2)(void*, void*);
+static int (*volatile g_noop_str2)(const char*, const char*);
+static int (*volatile g_noop_mixed4)(int, void*, const char*, int);
+static int (*volatile g_noop_double2)(double, double);
+
+static int direct_noop0(void* arg, size_t i) { (void)arg; (void)i; return g_noop0(); }
+static int direct_int1(void* arg, size_t i) { (void)arg; return g_noop_int1((int)i); }
+static int direct_int4(void* arg, size_t i) { (void)arg; return g_noop_int4((int)i, 1, 2, 3); }
+static int direct_int8(void* arg, size_t i) { (void)arg; return g_noop_int8((int)i, 1, 2, 3, 4, 5, 6, 7); }
+static int direct_ptr2(void* arg, size_t i) { (void)i; return g_noop_ptr2(arg, arg); }
+static int direct_str2(void* arg, size_t i) { (void)arg; (void)i; return g_noop_str2("bench", "bench"); }
+static int direct_mixed4(void* arg, size_t i) { return g_noop_mixed4((int)i, arg, "bench", 3); }
+static int direct_double2(void* arg, size_t i) { (void)arg; return g_noop_double2((double)i, 0.5); }
+
+static void bench_direct(const nxld_plugin_t* plugin) {
+    *(void**)&g_noop0 = nxld_plugin_get_symbol(plugin, "Noop0");
+    *(void**)&g_noop_int1 = nxld_plugin_get_symbol(plugin, "NoopInt1");
+    *(void**)&g_noop_int4 = nxld_plugin_get_symbol(plugin, "NoopInt4");
+    *(void**)&g_noop_int8 = nxld_plugin_get_symbol(plugin, "NoopInt8");
+    *(void**)&g_noop_ptr2 = nxld_plugin_get_symbol(plugin, "NoopPtr2");
+    *(void**)&g_noop_str2 = nxld_plugin_get_symbol(plugin, "NoopStr2");
+    *(void**)&g_noop_mixed4 = nxld_plugin_get_symbol(plugin, "NoopMixed4");
+    *(void**)&g_noop_double2 = nxld_plugin_get_symbol(plugin, "NoopDouble2");
+
+    static const struct {
+        const char* name;
+        bench_call_t call;
+    } cases[] = {
+        { "Noop0", direct_noop0 },
+        { "NoopInt1", direct_int1 },
+        { "NoopInt4", direct_int4 },
+        { "NoopInt8", direct_int8 },
+        { "NoopPtr2", direct_ptr2 },
+        { "NoopStr2", direct_str2 },
+        { "NoopMixed4", direct_mixed4 },
+        { "NoopDouble2", direct_double2 }
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        bench_result_t result;
+        measure(cases[c].call, &g_bench_value, g_iterations, &result);
+        print_result("direct", cases[c].name, 1, &result);
+    }
+}
+
+/* ---------- 规则集生成 / Rule set generation / Regelsatz-Generierung ---------- */
+
+/**
+ * @brief 开始写入规则文件 / Begin writing a rule file / Schreiben einer Regeldatei beginnen
+ */
+static FILE* begin_rules(const char* name, size_t rule_count, char* rules_path, size_t rules_path_size) {
+    char entry_path[MAX_PATH_LENGTH];
+    snprintf(rules_path, rules_path_size, "%s/%s_rules.nxpt", g_work_dir, name);
+    snprintf(entry_path, sizeof(entry_path), "%s/%s.nxpt", g_work_dir, name);
+
+    FILE* entry = fopen(entry_path, "w");
+    if (entry == NULL) {
+        return NULL;
+    }
+    fprintf(entry, "[EntryPlugin]\nPluginName=BenchDriver\nPluginPath=%s\nNxptPath=%s\n", g_plugin_path, rules_path);
+    fclose(entry);
+
+    FILE* fp = fopen(rules_path, "w");
+    if (fp != NULL) {
+        fprintf(fp, "[TransferRules]\nCount=%zu\n", rule_count);
+    }
+    return fp;
+}
+
+/**
+ * @brief 写入一条规则 / Write one rule / Eine Regel schreiben
+ */
+static void write_rule(FILE* fp, size_t index, const char* source_plugin, const char* source_interface, int source_index,
+                       const char* target_plugin, const char* target_interface, int target_index,
+                       const char* value, const char* mode) {
+    fprintf(fp, "[TransferRule_%zu]\nSourcePlugin=%s\nSourceInterface=%s\nSourceParamIndex=%d\n", index,
+            source_plugin, source_interface, source_index);
+    fprintf(fp, "TargetPlugin=%s\nTargetPluginPath=%s\nTargetInterface=%s\nTargetParamIndex=%d\n",
+            target_plugin, g_plugin_path, target_interface, target_index);
+    if (value != NULL) {
+        fprintf(fp, "TargetParamValue=%s\n", value);
+    }
+    fprintf(fp, "TransferMode=%s\nEnabled=true\n", mode != NULL ? mode : "unicast");
+}
+
+/**
+ * @brief 加载生成的规则集并编译计划 / Load generated rule set and compile plan / Generierten Regelsatz laden und Plan kompilieren
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+static int compile_rules(const char* name, nxld_transfer_rule_set_t* rules, nxld_transfer_plan_t* plan,
+                         double* load_ms, double* compile_ms) {
+    char entry_path[MAX_PATH_LENGTH];
+    snprintf(entry_path, sizeof(entry_path), "%s/%s.nxpt", g_work_dir, name);
+
+    uint64_t t0 = now_ns();
+    if (nxld_transfer_rules_init(rules, g_work_dir) != 0) {
+        return -1;
+    }
+    if (nxld_transfer_rules_load_chain(rules, entry_path) != NXLD_TRANSFER_RULES_SUCCESS) {
+        nxld_transfer_rules_free(rules);
+        return -1;
+    }
+    uint64_t t1 = now_ns();
+    if (nxld_transfer_plan_compile(rules, plan) != NXLD_TRANSFER_PLAN_SUCCESS) {
+        nxld_transfer_rules_free(rules);
+        return -1;
+    }
+    uint64_t t2 = now_ns();
+
+    if (load_ms != NULL) {
+        *load_ms = (double)(t1 - t0) / 1e6;
+    }
+    if (compile_ms != NULL) {
+        *compile_ms = (double)(t2 - t1) / 1e6;
+    }
+    return 0;
+}
+
+static void free_rules(nxld_transfer_rule_set_t* rules, nxld_transfer_plan_t* plan) {
+    nxld_transfer_plan_free(plan);
+    nxld_transfer_rules_free(rules);
+}
+
+static int plan_execute(void* arg, size_t i) {
+    (void)i;
+    plan_call_t* call = (plan_call_t*)arg;
+    return nxld_transfer_plan_execute(call->plan, call->route, call->value);
+}
+
+static int plan_call_by_name(void* arg, size_t i) {
+    plan_call_t* call = (plan_call_t*)arg;
+    return nxld_transfer_plan_call(call->plan, "BenchDriver", call->source_names[i % LOOKUP_TABLE_SIZE], 0, call->value);
+}
+
+/**
+ * @brief 运行入口路由并输出结果 / Run the entry route and print the result / Einstiegsroute ausführen und Ergebnis ausgeben
+ */
+static void run_entry_route(const char* scenario, const char* variant, const char* name, size_t hops, size_t iterations) {
+    nxld_transfer_rule_set_t rules;
+    nxld_transfer_plan_t plan;
+    bench_result_t result;
+
+    if (compile_rules(name, &rules, &plan, NULL, NULL) != 0) {
+        memset(&result, 0, sizeof(result));
+        result.failed = 1;
+        print_result(scenario, variant, hops, &result);
+        return;
+    }
+
+    plan_call_t call;
+    memset(&call, 0, sizeof(call));
+    call.plan = &plan;
+    call.route = nxld_transfer_plan_find_route(&plan, "BenchDriver", "Src0", 0);
+    call.value = &g_bench_value;
+    if (call.route == NXLD_PLAN_INVALID_INDEX) {
+        memset(&result, 0, sizeof(result));
+        result.failed = 1;
+    } else {
+        measure(plan_execute, &call, iterations, &result);
+    }
+    print_result(scenario, variant, hops, &result);
+    free_rules(&rules, &plan);
+}
+
+/* ---------- 场景 / Scenarios / Szenarien ---------- */
+
+/**
+ * @brief 单跳：源参数绑定到目标接口的第一个槽，其余槽为常量 / Single hop: source parameter bound to the target's first slot, other slots constant / Einzelsprung: Quellparameter an den ersten Ziel-Slot gebunden, übrige Slots konstant
+ */
+static void bench_single_hop(void) {
+    static const struct {
+        const char* interface_name;
+        int param_count;
+        const char* constants;              // 每个常量槽一个字符：i整数，s字符串 / One character per constant slot: i integer, s string / Ein Zeichen je Konstanten-Slot: i Ganzzahl, s Zeichenfolge
+    } cases[] = {
+        { "NoopInt1", 1, "" },
+        { "NoopInt4", 4, "iii" },
+        { "NoopInt8", 8, "iiiiiii" },
+        { "NoopPtr2", 2, "s" },
+        { "NoopStr2", 2, "s" },
+        { "NoopMixed4", 4, "isi" },
+        { "NoopDouble2", 2, "i" }
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        char rules_path[MAX_PATH_LENGTH];
+        FILE* fp = begin_rules("single", (size_t)cases[c].param_count, rules_path, sizeof(rules_path));
+        if (fp == NULL) {
+            continue;
+        }
+        write_rule(fp, 0, "BenchDriver", "Src0", 0, "Bench0", cases[c].interface_name, 0, NULL, NULL);
+        for (int p = 1; p < cases[c].param_count; p++) {
+            write_rule(fp, (size_t)p, "BenchDriver", "Src0", 0, "Bench0", cases[c].interface_name, p,
+                       cases[c].constants[p - 1] == 's' ? "bench" : "7", NULL);
+        }
+        fclose(fp);
+        run_entry_route("single-hop", cases[c].interface_name, "single", 1, g_iterations);
+    }
+}
+
+/**
+ * @brief 主动调用链：每个节点调用后触发下一个节点 / Active call chain: each node triggers the next one after it is called / Aktive Aufrufkette: jeder Knoten löst nach seinem Aufruf den nächsten aus
+ */
+static void bench_chain(void) {
+    static const size_t lengths[] = { 1, 4, 16, 64 };
+
+    for (size_t c = 0; c < sizeof(lengths) / sizeof(lengths[0]); c++) {
+        size_t length = lengths[c];
+        char rules_path[MAX_PATH_LENGTH];
+        FILE* fp = begin_rules("chain", length, rules_path, sizeof(rules_path));
+        if (fp == NULL) {
+            continue;
+        }
+        write_rule(fp, 0, "BenchDriver", "Src0", 0, "Bench0", "NoopInt1", 0, NULL, NULL);
+        for (size_t i = 1; i < length; i++) {
+            char source[32];
+            char target[32];
+            snprintf(source, sizeof(source), "Bench%zu", i - 1);
+            snprintf(target, sizeof(target), "Bench%zu", i);
+            write_rule(fp, i, source, "NoopInt1", -1, target, "NoopInt1", 0, "1", NULL);
+        }
+        fclose(fp);
+
+        char variant[32];
+        snprintf(variant, sizeof(variant), "length=%zu", length);
+        size_t iterations = g_iterations / length > 1000 ? g_iterations / length : 1000;
+        run_entry_route("chain", variant, "chain", length, iterations);
+    }
+}
+
+/**
+ * @brief 广播扇出：一个源参数传递给N个目标 / Broadcast fan-out: one source parameter delivered to N targets / Broadcast-Fan-out: ein Quellparameter an N Ziele
+ */
+static void bench_broadcast(void) {
+    static const size_t widths[] = { 1, 16, 256, 4096 };
+
+    for (size_t c = 0; c < sizeof(widths) / sizeof(widths[0]); c++) {
+        size_t width = widths[c];
+        char rules_path[MAX_PATH_LENGTH];
+        FILE* fp = begin_rules("broadcast", width, rules_path, sizeof(rules_path));
+        if (fp == NULL) {
+            continue;
+        }
+        for (size_t i = 0; i < width; i++) {
+            char target[32];
+            snprintf(target, sizeof(target), "Bench%zu", i);
+            write_rule(fp, i, "BenchDriver", "Src0", 0, target, "NoopInt1", 0, NULL, "broadcast");
+        }
+        fclose(fp);
+
+        char variant[32];
+        snprintf(variant, sizeof(variant), "width=%zu", width);
+        size_t iterations = g_iterations / width > 1000 ? g_iterations / width : 1000;
+        run_entry_route("broadcast", variant, "broadcast", width, iterations);
+    }
+}
+
+static int plan_call_tuple(void* arg, size_t i) {
+    plan_call_t* call = (plan_call_t*)arg;
+    void** tuple = call->tuples + (i % BATCH_TUPLE_COUNT) * BATCH_TUPLE_SIZE;
+    int status = 0;
+    for (int j = 0; j < BATCH_TUPLE_SIZE; j++) {
+        if (nxld_transfer_plan_call(call->plan, "BenchDriver", "Src0", j, tuple[j]) != 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+static int plan_call_batch(void* arg, size_t i) {
+    plan_call_t* call = (plan_call_t*)arg;
+    size_t first = (i * call->batch_size) % BATCH_TUPLE_COUNT;
+    return nxld_transfer_plan_call_batch(call->plan, "BenchDriver", "Src0", 0, call->tuples + first * BATCH_TUPLE_SIZE,
+                                         BATCH_TUPLE_SIZE, call->batch_size, NULL);
+}
+
+/**
+ * @brief 批量元组调用：逐元组调用与批量调用对比，并核对两者传递的值 / Batched tuple calls: per-tuple versus batch calls, checking both deliver the same values / Stapel-Tupelaufrufe: Einzel- gegen Stapelaufrufe, mit Prüfung, dass beide dieselben Werte liefern
+ * @details 元组的两个元素分别传给两个插件实例的Accumulate，插件摘要须一致 / The two tuple elements go to Accumulate on two plugin instances, and the plugin digests must match / Die beiden Tupelelemente gehen an Accumulate zweier Plugin-Instanzen, und die Plugin-Digests müssen übereinstimmen
+ */
+static void bench_batch(const nxld_plugin_t* plugin) {
+    static const size_t batch_sizes[] = { 16, 256, BATCH_TUPLE_COUNT };
+    int (*take_digest)(void) = NULL;
+    *(void**)&take_digest = nxld_plugin_get_symbol(plugin, "TakeDigest");
+
+    char rules_path[MAX_PATH_LENGTH];
+    FILE* fp = begin_rules("batch", BATCH_TUPLE_SIZE, rules_path, sizeof(rules_path));
+    if (fp == NULL || take_digest == NULL) {
+        if (fp != NULL) {
+            fclose(fp);
+        }
+        return;
+    }
+    for (int j = 0; j < BATCH_TUPLE_SIZE; j++) {
+        char target[32];
+        snprintf(target, sizeof(target), "Bench%d", j);
+        write_rule(fp, (size_t)j, "BenchDriver", "Src0", j, target, "Accumulate", 0, NULL, NULL);
+    }
+    fclose(fp);
+
+    nxld_transfer_rule_set_t rules;
+    nxld_transfer_plan_t plan;
+    bench_result_t result;
+    int* values = (int*)malloc(BATCH_TUPLE_COUNT * BATCH_TUPLE_SIZE * sizeof(int));
+    void** tuples = (void**)malloc(BATCH_TUPLE_COUNT * BATCH_TUPLE_SIZE * sizeof(void*));
+    if (values == NULL || tuples == NULL || compile_rules("batch", &rules, &plan, NULL, NULL) != 0) {
+        memset(&result, 0, sizeof(result));
+        result.failed = 1;
+        print_result("batch", "per-tuple", BATCH_TUPLE_SIZE, &result);
+        free(values);
+        free(tuples);
+        return;
+    }
+    for (size_t i = 0; i < BATCH_TUPLE_COUNT * BATCH_TUPLE_SIZE; i++) {
+        values[i] = (int)(i * 2654435761u);
+        tuples[i] = &values[i];
+    }
+
+    plan_call_t call;
+    memset(&call, 0, sizeof(call));
+    call.plan = &plan;
+    call.tuples = tuples;
+
+    // 同一组元组分别逐个和批量调用一次，插件看到的值和顺序须相同 / The same tuples run once per tuple and once as a batch; the plugin must see the same values in the same order / Dieselben Tupel laufen einmal einzeln und einmal als Stapel; das Plugin muss dieselben Werte in derselben Reihenfolge sehen
+    take_digest();
+    int status = 0;
+    for (size_t t = 0; t < BATCH_TUPLE_COUNT; t++) {
+        status |= plan_call_tuple(&call, t);
+    }
+    int per_tuple_digest = take_digest();
+    status |= nxld_transfer_plan_call_batch(&plan, "BenchDriver", "Src0", 0, tuples, BATCH_TUPLE_SIZE, BATCH_TUPLE_COUNT, NULL);
+    int batch_digest = take_digest();
+    if (status != 0 || per_tuple_digest != batch_digest) {
+        printf("%-12s %-22s batch output differs from per-tuple output (digest %08x vs %08x)\n", "batch", "check",
+               (unsigned)batch_digest, (unsigned)per_tuple_digest);
+        memset(&result, 0, sizeof(result));
+        result.failed = 1;
+        print_result("batch", "per-tuple", BATCH_TUPLE_SIZE, &result);
+    } else {
+        measure(plan_call_tuple, &call, g_iterations, &result);
+        print_result("batch", "per-tuple", BATCH_TUPLE_SIZE, &result);
+        for (size_t c = 0; c < sizeof(batch_sizes) / sizeof(batch_sizes[0]); c++) {
+            char variant[32];
+            snprintf(variant, sizeof(variant), "tuples=%zu", batch_sizes[c]);
+            call.batch_size = batch_sizes[c];
+            size_t iterations = g_iterations / batch_sizes[c] > 1000 ? g_iterations / batch_sizes[c] : 1000;
+            measure(plan_call_batch, &call, iterations, &result);
+            print_result("batch", variant, batch_sizes[c] * BATCH_TUPLE_SIZE, &result);
+        }
+    }
+
+    free_rules(&rules, &plan);
+    free(values);
+    free(tuples);
+}
+
+/**
+ * @brief 规则数量扩展：R条规则各自成为一条路由，按名称随机调用 / Rule count scaling: R rules each form a route, called by name at random / Skalierung der Regelanzahl: R Regeln bilden je eine Route, zufällig per Name aufgerufen
+ * @details 测量包括路由查找在内的CallPlugin完整路径，以及加载和编译时间 / Measures the full CallPlugin path including route lookup, plus load and compile time / Misst den vollständigen CallPlugin-Pfad einschließlich Routensuche sowie Lade- und Kompilierzeit
+ */
+static void bench_rule_scaling(size_t max_rules) {
+    char (*names)[32] = (char (*)[32])malloc(LOOKUP_TABLE_SIZE * sizeof(*names));
+    if (names == NULL) {
+        return;
+    }
+
+    for (size_t rule_count = 1; rule_count <= max_rules; rule_count *= 10) {
+        char rules_path[MAX_PATH_LENGTH];
+        FILE* fp = begin_rules("scaling", rule_count, rules_path, sizeof(rules_path));
+        if (fp == NULL) {
+            break;
+        }
+        for (size_t i = 0; i < rule_count; i++) {
+            char source[32];
+            char target[32];
+            snprintf(source, sizeof(source), "Src%zu", i);
+            snprintf(target, sizeof(target), "Bench%zu", i % TARGET_PLUGIN_COUNT);
+            write_rule(fp, i, "BenchDriver", source, 0, target, "NoopInt1", 0, NULL, NULL);
+        }
+        fclose(fp);
+
+        nxld_transfer_rule_set_t rules;
+        nxld_transfer_plan_t plan;
+        double load_ms = 0.0;
+        double compile_ms = 0.0;
+        char variant[32];
+        snprintf(variant, sizeof(variant), "rules=%zu", rule_count);
+        bench_result_t result;
+
+        if (compile_rules("scaling", &rules, &plan, &load_ms, &compile_ms) != 0) {
+            memset(&result, 0, sizeof(result));
+            result.failed = 1;
+            print_result("scaling", variant, 1, &result);
+            continue;
+        }
+
+        // 固定伪随机序列，使不同规模的结果可比 / Fixed pseudo-random sequence so results across sizes are comparable / Feste Pseudozufallsfolge, damit Ergebnisse über Größen vergleichbar sind
+        uint32_t seed = 2463534242u;
+        for (size_t i = 0; i < LOOKUP_TABLE_SIZE; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            snprintf(names[i], sizeof(names[i]), "Src%zu", (size_t)(seed % rule_count));
+        }
+
+        plan_call_t call;
+        memset(&call, 0, sizeof(call));
+        call.plan = &plan;
+        call.value = &g_bench_value;
+        call.source_names = names;
+        size_t iterations = rule_count >= 10000 ? g_iterations / 100 : g_iterations;
+        measure(plan_call_by_name, &call, iterations > 1000 ? iterations : 1000, &result);
+        print_result("scaling", variant, 1, &result);
+        printf("%-12s %-22s load %.2f ms, compile %.2f ms, %zu routes\n", "", "", load_ms, compile_ms, plan.route_count);
+        free_rules(&rules, &plan);
+    }
+
+    free(names);
+}
+
+int main(int argc, char* argv[]) {
+    const char* plugin_arg = DEFAULT_PLUGIN_PATH;
+    size_t max_rules = DEFAULT_MAX_RULES;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--plugin") == 0 && i + 1 < argc) {
+            plugin_arg = argv[++i];
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            g_iterations = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max-rules") == 0 && i + 1 < argc) {
+            max_rules = (size_t)strtoull(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [--plugin PATH] [--iterations N] [--max-rules N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (g_iterations == 0) {
+        g_iterations = 1;
+    }
+
+    if (realpath(plugin_arg, g_plugin_path) == NULL) {
+        fprintf(stderr, "Plugin not found: %s\n", plugin_arg);
+        return 1;
+    }
+    // 工作目录留出生成文件名的空间，过长的路径直接拒绝 / The work directory leaves room for generated file names, longer paths are rejected / Das Arbeitsverzeichnis lässt Platz für generierte Dateinamen, längere Pfade werden abgelehnt
+    if ((size_t)snprintf(g_work_dir, sizeof(g_work_dir), "%s", g_plugin_path) >= sizeof(g_work_dir)) {
+        fprintf(stderr, "Plugin path too long: %s\n", g_plugin_path);
+        return 1;
+    }
+    char* last_slash = strrchr(g_work_dir, '/');
+    if (last_slash != NULL) {
+        *last_slash = '\0';
+    }
+
+    if (nxld_logger_init("bench_dispatch.log") != 0) {
+        fprintf(stderr, "Failed to initialize logger\n");
+        return 1;
+    }
+
+    g_samples = (double*)malloc(MAX_LATENCY_SAMPLES * sizeof(double));
+    nxld_plugin_t plugin;
+    if (g_samples == NULL || nxld_plugin_load(g_plugin_path, &plugin) != NXLD_PLUGIN_LOAD_SUCCESS) {
+        fprintf(stderr, "Failed to load benchmark plugin: %s\n", g_plugin_path);
+        free(g_samples);
+        nxld_logger_close();
+        return 1;
+    }
+
+    // 计划从.so旁边的.nxp读取参数类型 / The plan reads parameter types from the .nxp next to the .so / Der Plan liest Parametertypen aus der .nxp neben der .so
+    char nxp_path[MAX_PATH_LENGTH];
+    snprintf(nxp_path, sizeof(nxp_path), "%s", g_plugin_path);
+    char* ext = strrchr(nxp_path, '.');
+    if (ext != NULL) {
+        strcpy(ext, ".nxp");
+    }
+    if (nxld_plugin_generate_metadata_file(&plugin, nxp_path) != 0) {
+        fprintf(stderr, "Failed to write plugin metadata: %s\n", nxp_path);
+    }
+
+    printf("Dispatcher microbenchmark: %zu iterations, latency from up to %d samples, allocations %s\n\n",
+           g_iterations, MAX_LATENCY_SAMPLES, ALLOCATIONS_COUNTED ? "counted" : "not counted");
+    print_header();
+    bench_direct(&plugin);
+    bench_single_hop();
+    bench_chain();
+    bench_broadcast();
+    bench_batch(&plugin);
+    bench_rule_scaling(max_rules);
+
+    nxld_plugin_free(&plugin);
+    free(g_samples);
+    nxld_logger_close();
+    return 0;
+}
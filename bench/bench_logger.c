@@ -0,0 +1,289 @@
+/**
+ * @file bench_logger.c
+ * @brief 日志系统吞吐和延迟基准测试 / Logger throughput and latency benchmark / Durchsatz- und Latenz-Benchmark des Protokollsystems
+ * @details 对文件日志（文本、二进制、预分配段）和日志插件（逐条调用、批量写入）按生产者线程数和消息大小测量每秒消息数、调用点延迟分位和写入磁盘的字节速率 / Measures messages per second, call-site latency percentiles and bytes per second to disk for the file logger (text, binary, preallocated segments) and the logger plugin (per-message calls, batch writes) across producer thread counts and message sizes / Misst Nachrichten pro Sekunde, Latenzperzentile an der Aufrufstelle und Bytes pro Sekunde auf die Festplatte für den Datei-Logger (Text, binär, vorab reservierte Segmente) und das Logger-Plugin (Aufrufe pro Nachricht, Stapelschreiben) über Produzenten-Threadanzahlen und Nachrichtengrößen
+ *
+ * 用法 / Usage / Verwendung:
+ *   bench_logger [--plugin PATH] [--plugin-single PATH] [--messages N] [--max-threads N] [--dir DIR]
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_logger.h"
+#include "nxld_thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define DEFAULT_PLUGIN_PATH "bench/bench_logger_plugin.so"
+#define DEFAULT_PLUGIN_SINGLE_PATH "bench/bench_logger_plugin_single.so"
+#define DEFAULT_MESSAGES 200000
+#define DEFAULT_MAX_THREADS 8
+#define WARMUP_CALLS 100
+#define SEGMENT_SIZE (64 * 1024 * 1024)
+#define SEGMENT_COUNT 4
+#define MAX_PATH_LENGTH 4096
+#define MAX_PAYLOAD 400
+
+/**
+ * @brief 日志后端描述结构体 / Logger backend description structure / Beschreibungsstruktur eines Protokoll-Backends
+ */
+typedef struct {
+    const char* name;                       /**< 后端名称 / Backend name / Backend-Name */
+    nxld_log_encoding_t encoding;           /**< 文件编码 / File encoding / Dateikodierung */
+    int segments;                           /**< 是否使用预分配段 / Whether preallocated segments are used / Ob vorab reservierte Segmente verwendet werden */
+    int plugin;                             /**< 0无插件，1逐条调用插件，2批量写入插件 / 0 no plugin, 1 per-message plugin, 2 batch plugin / 0 kein Plugin, 1 Plugin pro Nachricht, 2 Stapel-Plugin */
+    nxld_log_io_t io;                       /**< 文件写入方式 / File write backend / Schreib-Backend der Datei */
+} bench_backend_t;
+
+/**
+ * @brief 生产者线程参数结构体 / Producer thread argument structure / Argumentstruktur des Produzenten-Threads
+ */
+typedef struct {
+    size_t count;                           /**< 计时的消息数量 / Timed message count / Anzahl gemessener Nachrichten */
+    uint32_t* latencies;                    /**< 每次调用的延迟（纳秒） / Per-call latency in ns / Latenz pro Aufruf in ns */
+} bench_producer_t;
+
+/**
+ * @brief 基准测试结果结构体 / Benchmark result structure / Benchmark-Ergebnisstruktur
+ */
+typedef struct {
+    double messages_per_second;             /**< 生产者每秒消息数 / Producer messages per second / Produzenten-Nachrichten pro Sekunde */
+    double p50;                             /**< 延迟中位数（纳秒） / Median latency in ns / Median-Latenz in ns */
+    double p99;                             /**< 99分位延迟（纳秒） / 99th percentile latency in ns / 99.-Perzentil-Latenz in ns */
+    double p999;                            /**< 99.9分位延迟（纳秒） / 99.9th percentile latency in ns / 99,9.-Perzentil-Latenz in ns */
+    double disk_mb_per_second;              /**< 直到全部写出为止的磁盘速率 / Disk rate until everything is written / Festplattenrate, bis alles geschrieben ist */
+    uint64_t dropped;                       /**< 丢弃的消息数量 / Dropped messages / Verworfene Nachrichten */
+    int failed;                             /**< 是否失败 / Whether the run failed / Ob der Lauf fehlgeschlagen ist */
+} bench_result_t;
+
+static const bench_backend_t g_backends[] = {
+    { "file", NXLD_LOG_ENCODING_TEXT, 0, 0, NXLD_LOG_IO_WRITE },
+    { "file-uring", NXLD_LOG_ENCODING_TEXT, 0, 0, NXLD_LOG_IO_URING },
+    { "file-binary", NXLD_LOG_ENCODING_BINARY, 0, 0, NXLD_LOG_IO_WRITE },
+    { "segments", NXLD_LOG_ENCODING_TEXT, 1, 0, NXLD_LOG_IO_WRITE },
+    { "plugin", NXLD_LOG_ENCODING_TEXT, 0, 1, NXLD_LOG_IO_WRITE },
+    { "plugin-batch", NXLD_LOG_ENCODING_TEXT, 0, 2, NXLD_LOG_IO_WRITE }
+};
+
+static const size_t g_payload_sizes[] = { 32, 128, MAX_PAYLOAD };
+
+static char g_payload[MAX_PAYLOAD + 1];
+static const char* g_plugin_path = DEFAULT_PLUGIN_PATH;
+static const char* g_plugin_single_path = DEFAULT_PLUGIN_SINGLE_PATH;
+static char g_log_path[MAX_PATH_LENGTH];
+static char g_plugin_log_path[MAX_PATH_LENGTH];
+static int g_ready = 0;
+static int g_go = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_latency(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * @brief 生产者线程入口 / Producer thread entry / Einstiegspunkt des Produzenten-Threads
+ * @details 预热后在起跑标志处等待，使所有线程同时开始 / Waits at the start flag after warming up so all threads begin together / Wartet nach dem Aufwärmen an der Startmarke, damit alle Threads gleichzeitig beginnen
+ */
+static void producer_main(void* arg) {
+    bench_producer_t* producer = (bench_producer_t*)arg;
+    for (size_t i = 0; i < WARMUP_CALLS; i++) {
+        nxld_log_write(NXLD_LOG_MODULE_GENERAL, NXLD_LOG_LEVEL_INFO, "bench warmup %zu %s", i, g_payload);
+    }
+    __atomic_add_fetch(&g_ready, 1, __ATOMIC_RELEASE);
+    while (!__atomic_load_n(&g_go, __ATOMIC_ACQUIRE)) {
+    }
+
+    for (size_t i = 0; i < producer->count; i++) {
+        uint64_t t0 = now_ns();
+        nxld_log_write(NXLD_LOG_MODULE_GENERAL, NXLD_LOG_LEVEL_INFO, "bench message %zu %s", i, g_payload);
+        uint64_t elapsed = now_ns() - t0;
+        producer->latencies[i] = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+    }
+}
+
+/**
+ * @brief 统计输出文件大小 / Sum the sizes of the output files / Größen der Ausgabedateien summieren
+ */
+static uint64_t output_bytes(void) {
+    uint64_t total = 0;
+    char path[MAX_PATH_LENGTH + 24];
+    struct stat info;
+    for (int index = 0; index <= SEGMENT_COUNT; index++) {
+        if (index == 0) {
+            snprintf(path, sizeof(path), "%s", g_log_path);
+        } else {
+            snprintf(path, sizeof(path), "%s.%d", g_log_path, index);
+        }
+        if (stat(path, &info) == 0) {
+            total += (uint64_t)info.st_size;
+        }
+    }
+    if (stat(g_plugin_log_path, &info) == 0) {
+        total += (uint64_t)info.st_size;
+    }
+    return total;
+}
+
+/**
+ * @brief 删除上一次运行的输出文件 / Remove the output files of the previous run / Ausgabedateien des vorherigen Laufs entfernen
+ */
+static void remove_outputs(void) {
+    char path[MAX_PATH_LENGTH + 24];
+    remove(g_log_path);
+    for (int index = 1; index <= SEGMENT_COUNT; index++) {
+        snprintf(path, sizeof(path), "%s.%d", g_log_path, index);
+        remove(path);
+    }
+    remove(g_plugin_log_path);
+}
+
+/**
+ * @brief 运行一种配置 / Run one configuration / Eine Konfiguration ausführen
+ * @details 延迟为调用点延迟；磁盘速率计到nxld_logger_close返回，即后台写出全部完成 / Latency is call-site latency; the disk rate runs until nxld_logger_close returns, i.e. until background writing has finished / Die Latenz ist die Latenz an der Aufrufstelle; die Festplattenrate läuft, bis nxld_logger_close zurückkehrt, also bis das Hintergrundschreiben beendet ist
+ */
+static void run_config(const bench_backend_t* backend, size_t threads, size_t messages, bench_result_t* result) {
+    memset(result, 0, sizeof(bench_result_t));
+    remove_outputs();
+
+    nxld_logger_set_encoding(backend->encoding);
+    nxld_logger_set_segments(backend->segments ? SEGMENT_SIZE : 0, SEGMENT_COUNT);
+    nxld_logger_set_io(backend->io);
+    if (nxld_logger_init(g_log_path) != 0 || nxld_logger_get_io() != backend->io) {
+        nxld_logger_close();
+        result->failed = 1;
+        return;
+    }
+    if (backend->plugin != 0 &&
+        nxld_logger_load_plugin(backend->plugin == 2 ? g_plugin_path : g_plugin_single_path, g_plugin_log_path) != 0) {
+        nxld_logger_close();
+        result->failed = 1;
+        return;
+    }
+
+    size_t per_thread = messages / threads > 0 ? messages / threads : 1;
+    bench_producer_t* producers = (bench_producer_t*)calloc(threads, sizeof(bench_producer_t));
+    nxld_thread_t* handles = (nxld_thread_t*)calloc(threads, sizeof(nxld_thread_t));
+    uint32_t* latencies = (uint32_t*)malloc(per_thread * threads * sizeof(uint32_t));
+    if (producers == NULL || handles == NULL || latencies == NULL) {
+        free(producers);
+        free(handles);
+        free(latencies);
+        nxld_logger_close();
+        result->failed = 1;
+        return;
+    }
+
+    g_ready = 0;
+    g_go = 0;
+    size_t started = 0;
+    for (; started < threads; started++) {
+        producers[started].count = per_thread;
+        producers[started].latencies = latencies + started * per_thread;
+        if (nxld_thread_create(&handles[started], producer_main, &producers[started]) != 0) {
+            result->failed = 1;
+            break;
+        }
+    }
+    while (__atomic_load_n(&g_ready, __ATOMIC_ACQUIRE) < (int)started) {
+    }
+
+    uint64_t start = now_ns();
+    __atomic_store_n(&g_go, 1, __ATOMIC_RELEASE);
+    for (size_t t = 0; t < started; t++) {
+        nxld_thread_join(handles[t]);
+    }
+    uint64_t produced = now_ns();
+    result->dropped = nxld_logger_get_dropped_count();
+    nxld_logger_close();
+    uint64_t written = now_ns();
+
+    size_t total = per_thread * started;
+    if (total > 0) {
+        qsort(latencies, total, sizeof(uint32_t), compare_latency);
+        result->messages_per_second = (double)total * 1e9 / (double)(produced - start);
+        result->p50 = latencies[total / 2];
+        result->p99 = latencies[(size_t)((double)total * 0.99)];
+        result->p999 = latencies[(size_t)((double)total * 0.999)];
+        result->disk_mb_per_second = (double)output_bytes() / (1024.0 * 1024.0) * 1e9 / (double)(written - start);
+    }
+    free(producers);
+    free(handles);
+    free(latencies);
+}
+
+static void print_header(void) {
+    printf("%-14s %7s %7s %12s %8s %8s %8s %10s %9s\n",
+           "backend", "threads", "payload", "msgs/s", "p50", "p99", "p99.9", "disk MB/s", "dropped");
+}
+
+static void print_result(const char* backend, size_t threads, size_t payload, const bench_result_t* result) {
+    if (result->failed) {
+        printf("%-14s %7zu %7zu %12s\n", backend, threads, payload, "failed");
+        return;
+    }
+    printf("%-14s %7zu %7zu %12.0f %8.0f %8.0f %8.0f %10.1f %9llu\n",
+           backend, threads, payload, result->messages_per_second, result->p50, result->p99, result->p999,
+           result->disk_mb_per_second, (unsigned long long)result->dropped);
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    size_t messages = DEFAULT_MESSAGES;
+    size_t max_threads = DEFAULT_MAX_THREADS;
+    const char* dir = ".";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--plugin") == 0 && i + 1 < argc) {
+            g_plugin_path = argv[++i];
+        } else if (strcmp(argv[i], "--plugin-single") == 0 && i + 1 < argc) {
+            g_plugin_single_path = argv[++i];
+        } else if (strcmp(argv[i], "--messages") == 0 && i + 1 < argc) {
+            messages = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc) {
+            max_threads = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc) {
+            dir = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--plugin PATH] [--plugin-single PATH] [--messages N] [--max-threads N] [--dir DIR]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (messages == 0) {
+        messages = 1;
+    }
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    snprintf(g_log_path, sizeof(g_log_path), "%s/bench_logger.log", dir);
+    snprintf(g_plugin_log_path, sizeof(g_plugin_log_path), "%s/bench_logger_plugin.log", dir);
+
+    printf("Logger benchmark: %zu messages per run, latency in ns per call, disk rate until the log is closed\n\n", messages);
+    print_header();
+    for (size_t b = 0; b < sizeof(g_backends) / sizeof(g_backends[0]); b++) {
+        for (size_t s = 0; s < sizeof(g_payload_sizes) / sizeof(g_payload_sizes[0]); s++) {
+            memset(g_payload, 'x', g_payload_sizes[s]);
+            g_payload[g_payload_sizes[s]] = '\0';
+            for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+                bench_result_t result;
+                run_config(&g_backends[b], threads, messages, &result);
+                print_result(g_backends[b].name, threads, g_payload_sizes[s], &result);
+            }
+        }
+    }
+    remove_outputs();
+    return 0;
+}
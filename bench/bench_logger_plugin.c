@@ -0,0 +1,75 @@
+/**
+ * @file bench_logger_plugin.c
+ * @brief 基准测试用文件日志插件 / File logger plugin for benchmarks / Datei-Logger-Plugin für Benchmarks
+ * @details 把日志写入配置字符串给出的文件；定义BENCH_LOGGER_NO_BATCH时不导出批量写入，用于测量逐条调用路径 / Writes the log to the file named by the configuration string; with BENCH_LOGGER_NO_BATCH defined the batch export is left out to measure the per-message path / Schreibt das Protokoll in die von der Konfigurationszeichenfolge benannte Datei; mit BENCH_LOGGER_NO_BATCH entfällt der Stapel-Export, um den Pfad pro Nachricht zu messen
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "logger_plugin_interface.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#define BENCH_LOGGER_MESSAGE_SIZE 1024
+#define BENCH_LOGGER_IOV_COUNT 1020
+
+static const char* const g_prefixes[] = {"[ERROR] ", "[WARNING] ", "[INFO] "};
+static int g_fd = -1;
+
+LOGGER_PLUGIN_EXPORT int logger_plugin_init(const char* config) {
+    if (config == NULL) {
+        return -1;
+    }
+    g_fd = open(config, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    return g_fd >= 0 ? 0 : -1;
+}
+
+LOGGER_PLUGIN_EXPORT void logger_plugin_close(void) {
+    if (g_fd >= 0) {
+        close(g_fd);
+        g_fd = -1;
+    }
+}
+
+// 每条消息一次write，与典型的逐条插件相同 / One write per message, like a typical per-message plugin / Ein write pro Nachricht, wie bei einem typischen Plugin pro Nachricht
+LOGGER_PLUGIN_EXPORT void logger_plugin_write(logger_level_t level, const char* format, va_list args) {
+    char buffer[BENCH_LOGGER_MESSAGE_SIZE];
+    size_t length = strlen(g_prefixes[level]);
+    memcpy(buffer, g_prefixes[level], length);
+    int written = vsnprintf(buffer + length, sizeof(buffer) - length - 1, format, args);
+    if (written > 0) {
+        length += (size_t)written < sizeof(buffer) - length - 1 ? (size_t)written : sizeof(buffer) - length - 2;
+    }
+    buffer[length++] = '\n';
+    if (write(g_fd, buffer, length) < 0) {
+        return;
+    }
+}
+
+#ifndef BENCH_LOGGER_NO_BATCH
+// 整批记录用writev写出，每条记录三段：级别前缀、消息、换行 / The whole batch goes out through writev, three pieces per record: level prefix, message, newline / Der ganze Stapel geht per writev hinaus, drei Teile je Datensatz: Ebenenpräfix, Nachricht, Zeilenumbruch
+LOGGER_PLUGIN_EXPORT void logger_plugin_write_batch(const logger_record_t* records, size_t count) {
+    static char newline = '\n';
+    struct iovec vectors[BENCH_LOGGER_IOV_COUNT];
+    size_t index = 0;
+    while (index < count) {
+        int used = 0;
+        for (; index < count && used + 3 <= BENCH_LOGGER_IOV_COUNT; index++) {
+            vectors[used].iov_base = (void*)g_prefixes[records[index].level];
+            vectors[used++].iov_len = strlen(g_prefixes[records[index].level]);
+            vectors[used].iov_base = (void*)records[index].text;
+            vectors[used++].iov_len = records[index].length;
+            vectors[used].iov_base = &newline;
+            vectors[used++].iov_len = 1;
+        }
+        if (writev(g_fd, vectors, used) < 0) {
+            return;
+        }
+    }
+}
+#endif
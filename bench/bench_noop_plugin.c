@@ -0,0 +1,195 @@
+/**
+ * @file bench_noop_plugin.c
+ * @brief 基准测试用空操作插件 / No-op plugin for benchmarks / No-Op-Plugin für Benchmarks
+ * @details 导出不同签名的空接口，用于测量调度开销而不包含插件工作量 / Exports empty interfaces with varied signatures to measure dispatch overhead without plugin work / Exportiert leere Schnittstellen mit verschiedenen Signaturen, um den Dispatch-Aufwand ohne Plugin-Arbeit zu messen
+ */
+
+#include "nxld_plugin_interface.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#define BENCH_PLUGIN_NAME "BenchNoopPlugin"
+#define BENCH_PLUGIN_VERSION "1.0.0"
+#define BENCH_MAX_PARAMS 8
+
+/**
+ * @brief 接口描述结构体 / Interface description structure / Schnittstellenbeschreibungsstruktur
+ */
+typedef struct {
+    const char* name;                       /**< 接口名称 / Interface name / Schnittstellenname */
+    int param_count;                        /**< 参数数量 / Parameter count / Parameteranzahl */
+    nxld_param_type_t types[BENCH_MAX_PARAMS];  /**< 参数类型 / Parameter types / Parametertypen */
+} bench_interface_t;
+
+#define I NXLD_PARAM_TYPE_INT
+#define P NXLD_PARAM_TYPE_POINTER
+#define S NXLD_PARAM_TYPE_STRING
+#define D NXLD_PARAM_TYPE_DOUBLE
+
+static const bench_interface_t g_interfaces[] = {
+    { "Noop0", 0, { 0 } },
+    { "NoopInt1", 1, { I } },
+    { "NoopInt2", 2, { I, I } },
+    { "NoopInt4", 4, { I, I, I, I } },
+    { "NoopInt8", 8, { I, I, I, I, I, I, I, I } },
+    { "NoopPtr2", 2, { P, P } },
+    { "NoopStr2", 2, { S, S } },
+    { "NoopMixed4", 4, { I, P, S, I } },
+    { "NoopDouble2", 2, { D, D } },
+    { "Accumulate", 1, { I } },
+    { "TakeDigest", 0, { 0 } }
+};
+
+#undef I
+#undef P
+#undef S
+#undef D
+
+#define BENCH_INTERFACE_COUNT (sizeof(g_interfaces) / sizeof(g_interfaces[0]))
+
+static const char* get_type_name(nxld_param_type_t type) {
+    switch (type) {
+        case NXLD_PARAM_TYPE_INT: return "int";
+        case NXLD_PARAM_TYPE_POINTER: return "void*";
+        case NXLD_PARAM_TYPE_STRING: return "const char*";
+        case NXLD_PARAM_TYPE_DOUBLE: return "double";
+        default: return "unknown";
+    }
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_name(char* name, size_t name_size) {
+    if (name == NULL || name_size == 0) {
+        return -1;
+    }
+    snprintf(name, name_size, "%s", BENCH_PLUGIN_NAME);
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_version(char* version, size_t version_size) {
+    if (version == NULL || version_size == 0) {
+        return -1;
+    }
+    snprintf(version, version_size, "%s", BENCH_PLUGIN_VERSION);
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_count(size_t* count) {
+    if (count == NULL) {
+        return -1;
+    }
+    *count = BENCH_INTERFACE_COUNT;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_info(size_t index, char* name, size_t name_size,
+                                                      char* description, size_t desc_size,
+                                                      char* version, size_t version_size) {
+    if (index >= BENCH_INTERFACE_COUNT) {
+        return -1;
+    }
+    if (name != NULL && name_size > 0) {
+        snprintf(name, name_size, "%s", g_interfaces[index].name);
+    }
+    if (description != NULL && desc_size > 0) {
+        snprintf(description, desc_size, "No-op benchmark interface");
+    }
+    if (version != NULL && version_size > 0) {
+        snprintf(version, version_size, "%s", BENCH_PLUGIN_VERSION);
+    }
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_count(size_t index, nxld_param_count_type_t* count_type,
+                                                             int* min_count, int* max_count) {
+    if (index >= BENCH_INTERFACE_COUNT || count_type == NULL || min_count == NULL || max_count == NULL) {
+        return -1;
+    }
+    *count_type = NXLD_PARAM_COUNT_FIXED;
+    *min_count = g_interfaces[index].param_count;
+    *max_count = g_interfaces[index].param_count;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_info(size_t index, int param_index,
+                                                            char* param_name, size_t name_size,
+                                                            nxld_param_type_t* param_type,
+                                                            char* type_name, size_t type_name_size) {
+    if (index >= BENCH_INTERFACE_COUNT || param_index < 0 || param_index >= g_interfaces[index].param_count) {
+        return -1;
+    }
+    nxld_param_type_t type = g_interfaces[index].types[param_index];
+    if (param_name != NULL && name_size > 0) {
+        snprintf(param_name, name_size, "arg%d", param_index);
+    }
+    if (param_type != NULL) {
+        *param_type = type;
+    }
+    if (type_name != NULL && type_name_size > 0) {
+        snprintf(type_name, type_name_size, "%s", get_type_name(type));
+    }
+    return 0;
+}
+
+// 空接口只返回0，调用开销全部来自调度 / Empty interfaces only return 0, so all cost comes from dispatch / Leere Schnittstellen geben nur 0 zurück, der gesamte Aufwand stammt vom Dispatch
+
+NXLD_PLUGIN_EXPORT int Noop0(void) {
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopInt1(int a) {
+    (void)a;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopInt2(int a, int b) {
+    (void)a; (void)b;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopInt4(int a, int b, int c, int d) {
+    (void)a; (void)b; (void)c; (void)d;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopInt8(int a, int b, int c, int d, int e, int f, int g, int h) {
+    (void)a; (void)b; (void)c; (void)d; (void)e; (void)f; (void)g; (void)h;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopPtr2(void* a, void* b) {
+    (void)a; (void)b;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopStr2(const char* a, const char* b) {
+    (void)a; (void)b;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopMixed4(int a, void* b, const char* c, int d) {
+    (void)a; (void)b; (void)c; (void)d;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int NoopDouble2(double a, double b) {
+    (void)a; (void)b;
+    return 0;
+}
+
+/**
+ * @brief 按调用顺序累积的参数摘要（FNV-1a） / Digest of arguments in call order (FNV-1a) / Digest der Argumente in Aufrufreihenfolge (FNV-1a)
+ * @details 用于核对不同调度方式是否以相同顺序传递相同的值 / Used to check that different dispatch paths deliver the same values in the same order / Dient zur Prüfung, ob verschiedene Dispatch-Wege dieselben Werte in derselben Reihenfolge liefern
+ */
+static uint32_t g_digest = 2166136261u;
+
+NXLD_PLUGIN_EXPORT int Accumulate(int a) {
+    g_digest = (g_digest ^ (uint32_t)a) * 16777619u;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int TakeDigest(void) {
+    uint32_t digest = g_digest;
+    g_digest = 2166136261u;
+    return (int)digest;
+}
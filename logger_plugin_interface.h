@@ -8,6 +8,8 @@
 #define LOGGER_PLUGIN_INTERFACE_H
 
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +30,17 @@ typedef enum {
     LOGGER_LEVEL_INFO                       /**< 信息级别 / Info level / Informationsebene */
 } logger_level_t;
 
+/**
+ * @brief 已格式化的日志记录结构体 / Preformatted log record structure / Vorformatierte Protokolldatensatz-Struktur
+ * @details 只包含消息本身，不含时间戳和级别前缀，也不以换行或空字符结尾 / Holds the message only, without timestamp or level prefix and without a trailing newline or null terminator / Enthält nur die Nachricht, ohne Zeitstempel- und Ebenenpräfix und ohne abschließenden Zeilenumbruch oder Nullzeichen
+ */
+typedef struct {
+    logger_level_t level;                   /**< 日志级别 / Log level / Protokollierungsebene */
+    uint64_t timestamp_ns;                  /**< 记录时间（自1970年起的纳秒数） / Record time in nanoseconds since 1970 / Datensatzzeit in Nanosekunden seit 1970 */
+    size_t length;                          /**< 消息长度 / Message length / Nachrichtenlänge */
+    const char* text;                       /**< 消息字节 / Message bytes / Nachrichtenbytes */
+} logger_record_t;
+
 /**
  * @brief 初始化日志插件 / Initialize logger plugin / Logger-Plugin initialisieren
  * @param config 配置字符串（可选，由插件自行解析） / Configuration string (optional, parsed by plugin) / Konfigurationszeichenfolge (optional, vom Plugin geparst)
@@ -48,6 +61,14 @@ LOGGER_PLUGIN_EXPORT void logger_plugin_close(void);
  */
 LOGGER_PLUGIN_EXPORT void logger_plugin_write(logger_level_t level, const char* format, va_list args);
 
+/**
+ * @brief 批量写入已格式化的日志记录（可选导出） / Write a batch of preformatted log records (optional export) / Einen Stapel vorformatierter Protokolldatensätze schreiben (optionaler Export)
+ * @param records 记录数组 / Record array / Datensatz-Array
+ * @param count 记录数量 / Record count / Anzahl der Datensätze
+ * @details 导出此函数的插件由日志后台线程每批调用一次，不再逐条调用logger_plugin_write；记录只在调用期间有效，可用一次writev写出 / A plugin exporting this function is called once per batch from the logging background thread instead of logger_plugin_write per message; the records are only valid during the call and can be written with a single writev / Ein Plugin, das diese Funktion exportiert, wird vom Protokoll-Hintergrund-Thread einmal pro Stapel statt logger_plugin_write pro Nachricht aufgerufen; die Datensätze sind nur während des Aufrufs gültig und können mit einem einzigen writev geschrieben werden
+ */
+LOGGER_PLUGIN_EXPORT void logger_plugin_write_batch(const logger_record_t* records, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,24 +4,527 @@
  * @details 加载配置文件并初始化根插件 / Load config file and initialize root plugins / Konfigurationsdatei laden und Root-Plugins initialisieren
  */
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "nxld_parser.h"
 #include "nxld_logger.h"
 #include "nxld_plugin.h"
 #include "nxld_plugin_loader.h"
 #include "nxld_plugin_interface.h"
+#include "nxld_transfer_rules.h"
+#include "nxld_transfer_plan.h"
+#include "nxld_buffer_pool.h"
+#include "nxld_async.h"
+#include "nxld_trace.h"
+#include "nxld_replay.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
 #include <dlfcn.h>
+#include <unistd.h>
+#include <signal.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+#define POINTER_TRANSFER_PLUGIN_NAME "PointerTransferPlugin"
+#define MAX_ENTRY_DATA 64
+#define ASYNC_REAP_BATCH 64
+#define ENTRY_BATCH_SIZE 16
+
+/**
+ * @brief 入口数据项结构体 / Entry data item structure / Einstiegsdaten-Element-Struktur
+ */
+typedef struct {
+    int int_value;                          /**< 整数值 / Integer value / Ganzzahlwert */
+    char* string_value;                     /**< 字符串值（非字符串类型为NULL） / String value (NULL for non-string types) / Zeichenfolgenwert (NULL bei anderen Typen) */
+} entry_data_t;
+
+/**
+ * @brief 指标转储器结构体 / Metrics dumper structure / Metrik-Ausgeber-Struktur
+ */
+typedef struct {
+    nxld_transfer_plan_t* plan;             /**< 执行计划 / Execution plan / Ausführungsplan */
+    const nxld_transfer_rule_set_t* rules;  /**< 规则集合 / Rule set / Regelsatz */
+    const char* path;                       /**< JSON输出路径 / JSON output path / JSON-Ausgabepfad */
+    nxld_thread_t thread;                   /**< 信号等待线程 / Signal waiting thread / Signal-Warte-Thread */
+    nxld_mutex_t mutex;                     /**< 停止标志互斥锁 / Stop flag mutex / Mutex des Stoppflags */
+    int stop;                               /**< 停止标志 / Stop flag / Stoppflag */
+    int running;                            /**< 线程是否已启动 / Whether the thread was started / Ob der Thread gestartet wurde */
+} metrics_dumper_t;
+
+/**
+ * @brief 获取配置文件所在目录 / Get directory of config file / Verzeichnis der Konfigurationsdatei abrufen
+ */
+static int get_config_dir(const char* file_path, char* dir_path, size_t dir_path_size) {
+    if (file_path == NULL || dir_path == NULL || dir_path_size == 0) {
+        return 0;
+    }
+    
+    const char* last_slash = strrchr(file_path, '/');
+#ifdef _WIN32
+    const char* last_backslash = strrchr(file_path, '\\');
+    if (last_backslash != NULL && (last_slash == NULL || last_backslash > last_slash)) {
+        last_slash = last_backslash;
+    }
+#endif
+    
+    if (last_slash == NULL) {
+        dir_path[0] = '.';
+        dir_path[1] = '\0';
+        return 1;
+    }
+    
+    size_t dir_len = last_slash - file_path;
+    if (dir_len >= dir_path_size) {
+        dir_len = dir_path_size - 1;
+    }
+    
+    memcpy(dir_path, file_path, dir_len);
+    dir_path[dir_len] = '\0';
+    return 1;
+}
+
+/**
+ * @brief 链式加载传递规则并编译执行计划 / Chain load transfer rules and compile execution plan / Übertragungsregeln kettenweise laden und Ausführungsplan kompilieren
+ * @param plugins 已加载的根插件数组 / Loaded root plugin array / Geladenes Root-Plugin-Array
+ * @param plugin_count 根插件数量 / Root plugin count / Anzahl der Root-Plugins
+ * @param config_file 配置文件路径 / Config file path / Konfigurationsdateipfad
+ * @param rules 输出规则集合 / Output rule set / Ausgabe-Regelsatz
+ * @param plan 输出执行计划 / Output execution plan / Ausgabe-Ausführungsplan
+ * @return 成功返回0，未找到指针传递插件返回1，失败返回-1 / Returns 0 on success, 1 if no pointer transfer plugin is loaded, -1 on failure / Gibt 0 bei Erfolg zurück, 1 wenn kein Zeigerübertragungs-Plugin geladen ist, -1 bei Fehler
+ */
+static int compile_transfer_plan(const nxld_plugin_t* plugins, size_t plugin_count, const char* config_file,
+                                 nxld_transfer_rule_set_t* rules, nxld_transfer_plan_t* plan) {
+    const nxld_plugin_t* transfer_plugin = NULL;
+    for (size_t i = 0; i < plugin_count; i++) {
+        if (plugins[i].plugin_name != NULL && strcmp(plugins[i].plugin_name, POINTER_TRANSFER_PLUGIN_NAME) == 0) {
+            transfer_plugin = &plugins[i];
+            break;
+        }
+    }
+    
+    if (transfer_plugin == NULL || transfer_plugin->plugin_path == NULL) {
+        nxld_log_info("No %s loaded, skipping execution plan compilation", POINTER_TRANSFER_PLUGIN_NAME);
+        return 1;
+    }
+    
+    char config_dir[4096];
+    char nxpt_path[4096];
+    if (!get_config_dir(config_file, config_dir, sizeof(config_dir)) ||
+        !nxld_transfer_rules_build_nxpt_path(transfer_plugin->plugin_path, nxpt_path, sizeof(nxpt_path))) {
+        nxld_log_error("Failed to build transfer rule path for %s", POINTER_TRANSFER_PLUGIN_NAME);
+        return -1;
+    }
+    
+    if (nxld_transfer_rules_init(rules, config_dir) != 0) {
+        return -1;
+    }
+    
+    uint64_t trace_start = nxld_trace_begin();
+    nxld_transfer_rules_result_t rules_result = nxld_transfer_rules_load_chain(rules, nxpt_path);
+    nxld_trace_end("nxpt", "load .nxpt chain", trace_start, nxpt_path);
+    if (rules_result != NXLD_TRANSFER_RULES_SUCCESS) {
+        nxld_log_error("Failed to load transfer rules: %s", nxld_transfer_rules_get_error_message(rules_result));
+        nxld_transfer_rules_free(rules);
+        return -1;
+    }
+    
+    trace_start = nxld_trace_begin();
+    nxld_transfer_plan_result_t plan_result = nxld_transfer_plan_compile(rules, plan);
+    nxld_trace_end("plan", "compile plan", trace_start, NULL);
+    if (plan_result != NXLD_TRANSFER_PLAN_SUCCESS) {
+        nxld_log_error("Failed to compile execution plan: %s", nxld_transfer_plan_get_error_message(plan_result));
+        nxld_transfer_rules_free(rules);
+        return -1;
+    }
+
+    // 预热失败不影响执行，插件仍在首次调用时加载 / Warm-up failure is not fatal, plugins still load on first call / Ein Fehler beim Aufwärmen ist nicht fatal, Plugins laden weiterhin beim ersten Aufruf
+    nxld_transfer_plan_warmup(plan, rules->warmup_policy);
+
+    return 0;
+}
+
+/**
+ * @brief 读取入口插件.nxin中的入口数据 / Read entry data from the entry plugin's .nxin / Einstiegsdaten aus der .nxin des Einstiegs-Plugins lesen
+ * @return 读取的数据项数量 / Number of items read / Anzahl gelesener Elemente
+ */
+static size_t load_entry_data(const nxld_transfer_rule_set_t* rules, entry_data_t* items, size_t max_items) {
+    char nxin_path[4096];
+    char full_path[4096];
+    if (!nxld_transfer_rules_build_nxpt_path(rules->entry_plugin_path, nxin_path, sizeof(nxin_path))) {
+        return 0;
+    }
+    // 扩展名.nxpt与.nxin等长 / The .nxpt and .nxin extensions have the same length / Die Endungen .nxpt und .nxin sind gleich lang
+    strcpy(nxin_path + strlen(nxin_path) - 4, "nxin");
+    if (!nxld_transfer_rules_resolve_path(rules, nxin_path, full_path, sizeof(full_path))) {
+        return 0;
+    }
+
+    FILE* file = fopen(full_path, "r");
+    if (file == NULL) {
+        nxld_log_warning("Failed to open entry data file: %s", full_path);
+        return 0;
+    }
+
+    char line[1024];
+    size_t count = 0;
+    int in_item = 0;
+    int is_string = 0;
+    while (fgets(line, sizeof(line), file) != NULL && count < max_items) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '[') {
+            in_item = strncmp(line, "[EntryData_", 11) == 0;
+            is_string = 0;
+        } else if (in_item && strncmp(line, "Type=", 5) == 0) {
+            is_string = strcmp(line + 5, "string") == 0;
+        } else if (in_item && strncmp(line, "Value=", 6) == 0) {
+            items[count].int_value = atoi(line + 6);
+            items[count].string_value = NULL;
+            if (is_string) {
+                size_t len = strlen(line + 6);
+                items[count].string_value = (char*)malloc(len + 1);
+                if (items[count].string_value == NULL) {
+                    break;
+                }
+                memcpy(items[count].string_value, line + 6, len + 1);
+            }
+            count++;
+            in_item = 0;
+        }
+    }
+
+    fclose(file);
+    nxld_log_info("Loaded %zu entry data items from %s", count, full_path);
+    return count;
+}
+
+/**
+ * @brief 等待完成事件 / Wait for completion event / Auf Abschlussereignis warten
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+static int wait_completion_event(intptr_t event, int poll_fd) {
+#ifdef _WIN32
+    (void)poll_fd;
+    return WaitForSingleObject((HANDLE)event, INFINITE) == WAIT_OBJECT_0 ? 0 : -1;
+#elif defined(__linux__)
+    (void)event;
+    struct epoll_event ready;
+    int result;
+    do {
+        result = epoll_wait(poll_fd, &ready, 1, -1);
+    } while (result < 0 && errno == EINTR);
+    return result >= 0 ? 0 : -1;
+#else
+    (void)poll_fd;
+    struct pollfd pfd;
+    pfd.fd = (int)event;
+    pfd.events = POLLIN;
+    int result;
+    do {
+        result = poll(&pfd, 1, -1);
+    } while (result < 0 && errno == EINTR);
+    return result >= 0 ? 0 : -1;
 #endif
+}
+
+/**
+ * @brief 写出指标文件 / Write metrics file / Metrikdatei schreiben
+ */
+static void dump_metrics(metrics_dumper_t* dumper) {
+    if (nxld_transfer_plan_dump_metrics(dumper->plan, dumper->rules, dumper->path) == 0) {
+        nxld_log_info("Metrics written to %s", dumper->path);
+    }
+}
+
+#ifndef _WIN32
+/**
+ * @brief 信号等待线程函数：每次收到SIGUSR1写出指标 / Signal waiting thread: writes metrics on every SIGUSR1 / Signal-Warte-Thread: schreibt Metriken bei jedem SIGUSR1
+ * @details 在普通线程中用sigwait接收信号，转储不受信号处理函数的限制 / Receives the signal with sigwait on a normal thread, so dumping is not limited to async-signal-safe calls / Empfängt das Signal mit sigwait in einem normalen Thread, daher ist das Ausgeben nicht auf async-signal-sichere Aufrufe beschränkt
+ */
+static void metrics_signal_worker(void* arg) {
+    metrics_dumper_t* dumper = (metrics_dumper_t*)arg;
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+
+    for (;;) {
+        int received = 0;
+        if (sigwait(&signals, &received) != 0) {
+            break;
+        }
+        nxld_mutex_lock(&dumper->mutex);
+        int stop = dumper->stop;
+        nxld_mutex_unlock(&dumper->mutex);
+        if (stop) {
+            break;
+        }
+        dump_metrics(dumper);
+    }
+}
+#endif
+
+/**
+ * @brief 阻塞SIGUSR1，使其只由信号等待线程接收 / Block SIGUSR1 so only the signal waiting thread receives it / SIGUSR1 blockieren, damit nur der Signal-Warte-Thread es empfängt
+ * @details 须在创建任何线程之前调用，新线程继承信号掩码 / Must be called before any thread is created, new threads inherit the signal mask / Muss vor dem Erstellen eines Threads aufgerufen werden, neue Threads erben die Signalmaske
+ */
+static void block_metrics_signal(void) {
+#ifndef _WIN32
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+#endif
+}
+
+/**
+ * @brief 启动指标转储器 / Start metrics dumper / Metrik-Ausgeber starten
+ */
+static void start_metrics_dumper(metrics_dumper_t* dumper) {
+    nxld_mutex_init(&dumper->mutex);
+    dumper->stop = 0;
+    dumper->running = 0;
+#ifndef _WIN32
+    if (nxld_thread_create(&dumper->thread, metrics_signal_worker, dumper) == 0) {
+        dumper->running = 1;
+        nxld_log_info("Send SIGUSR1 to write metrics to %s", dumper->path);
+    } else {
+        nxld_log_warning("Failed to start metrics signal thread, metrics are written on exit only");
+    }
+#endif
+}
+
+/**
+ * @brief 停止指标转储器并写出最终指标 / Stop metrics dumper and write final metrics / Metrik-Ausgeber stoppen und abschließende Metriken schreiben
+ */
+static void stop_metrics_dumper(metrics_dumper_t* dumper) {
+#ifndef _WIN32
+    if (dumper->running) {
+        nxld_mutex_lock(&dumper->mutex);
+        dumper->stop = 1;
+        nxld_mutex_unlock(&dumper->mutex);
+        pthread_kill(dumper->thread, SIGUSR1);
+        nxld_thread_join(dumper->thread);
+        dumper->running = 0;
+    }
+#endif
+    nxld_mutex_destroy(&dumper->mutex);
+    dump_metrics(dumper);
+}
+
+/**
+ * @brief 通过异步执行器运行所有入口调用链 / Run every entry chain through the async executor / Alle Einstiegsketten über den asynchronen Ausführer ausführen
+ * @details 入口数据按ENTRY_BATCH_SIZE个元组一批全部提交，每批在一个工作线程上只查找和准备一次路由；事件循环在完成事件上等待并取回结果 / All entry data is submitted up front in batches of ENTRY_BATCH_SIZE tuples, each batch looking up and preparing its route once on one worker; the event loop waits on the completion event and reaps results / Alle Einstiegsdaten werden vorab in Stapeln zu ENTRY_BATCH_SIZE Tupeln eingereicht, jeder Stapel sucht und bereitet seine Route einmal auf einem Worker vor; die Ereignisschleife wartet auf das Abschlussereignis und holt die Ergebnisse ab
+ * @param recorder 录制器，入口数据在提交时录制（可为NULL） / Recorder, entry data is recorded on submission (may be NULL) / Aufzeichner, Einstiegsdaten werden beim Einreichen aufgezeichnet (kann NULL sein)
+ * @return 全部成功返回0，否则返回-1 / Returns 0 if all chains succeed, -1 otherwise / Gibt 0 zurück, wenn alle Ketten erfolgreich sind, sonst -1
+ */
+static int run_entry_chains(nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules,
+                            nxld_replay_recorder_t* recorder) {
+    if (plan->entry_route == NXLD_PLAN_INVALID_INDEX) {
+        nxld_log_warning("Execution plan has no entry route, nothing to run");
+        return -1;
+    }
+
+    entry_data_t items[MAX_ENTRY_DATA];
+    size_t item_count = load_entry_data(rules, items, MAX_ENTRY_DATA);
+    if (item_count == 0) {
+        nxld_log_warning("No entry data to run");
+        return -1;
+    }
+
+    const nxld_plan_route_t* entry = &plan->routes[plan->entry_route];
+    const nxld_plan_node_t* source = &plan->nodes[entry->source_node];
+    const char* source_plugin = plan->plugins[source->plugin_index].plugin_name;
+
+    nxld_async_t* async = nxld_async_create(plan, 0);
+    if (async == NULL) {
+        for (size_t i = 0; i < item_count; i++) {
+            free(items[i].string_value);
+        }
+        return -1;
+    }
+
+    int poll_fd = -1;
+#if !defined(_WIN32) && defined(__linux__)
+    poll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event watch;
+    memset(&watch, 0, sizeof(watch));
+    watch.events = EPOLLIN;
+    if (poll_fd < 0 || epoll_ctl(poll_fd, EPOLL_CTL_ADD, (int)nxld_async_get_event(async), &watch) != 0) {
+        nxld_log_error("Failed to set up epoll for async executor");
+        if (poll_fd >= 0) {
+            close(poll_fd);
+        }
+        nxld_async_destroy(async);
+        for (size_t i = 0; i < item_count; i++) {
+            free(items[i].string_value);
+        }
+        return -1;
+    }
+#endif
+
+    void* values[MAX_ENTRY_DATA];
+    int statuses[MAX_ENTRY_DATA];
+    for (size_t i = 0; i < item_count; i++) {
+        values[i] = items[i].string_value != NULL ? (void*)items[i].string_value : (void*)&items[i].int_value;
+        statuses[i] = -1;
+        nxld_replay_record(recorder, source_plugin, source->interface_name, entry->source_param_index,
+                           items[i].string_value != NULL ? NXLD_PARAM_TYPE_STRING : NXLD_PARAM_TYPE_INT, values[i]);
+    }
+
+    // 每个入口数据是只含入口源参数的单元素元组 / Each entry datum is a one-element tuple holding the entry source parameter / Jedes Einstiegsdatum ist ein einelementiges Tupel mit dem Einstiegsquellparameter
+    size_t submitted = 0;
+    for (size_t first = 0; first < item_count; first += ENTRY_BATCH_SIZE) {
+        size_t count = item_count - first < ENTRY_BATCH_SIZE ? item_count - first : ENTRY_BATCH_SIZE;
+        if (nxld_async_call_batch(async, source_plugin, source->interface_name, entry->source_param_index,
+                                  values + first, 1, count, statuses + first, (void*)(uintptr_t)first) != NULL) {
+            submitted += count;
+        }
+    }
+
+    size_t succeeded = 0;
+    size_t completed = 0;
+    nxld_future_t* futures[ASYNC_REAP_BATCH];
+    while (nxld_async_in_flight(async) > 0) {
+        if (wait_completion_event(nxld_async_get_event(async), poll_fd) != 0) {
+            nxld_log_error("Waiting for async completions failed");
+            break;
+        }
+        size_t reaped = nxld_async_reap(async, futures, ASYNC_REAP_BATCH);
+        for (size_t i = 0; i < reaped; i++) {
+            size_t first = (size_t)(uintptr_t)nxld_future_user_data(futures[i]);
+            size_t count = item_count - first < ENTRY_BATCH_SIZE ? item_count - first : ENTRY_BATCH_SIZE;
+            for (size_t item = first; item < first + count; item++) {
+                int ok = statuses[item] == 0;
+                printf("  Entry data [%zu]: %s\n", item, ok ? "completed" : "failed");
+                succeeded += ok ? 1 : 0;
+            }
+            completed += count;
+            nxld_future_release(futures[i]);
+        }
+    }
+
+#if !defined(_WIN32) && defined(__linux__)
+    close(poll_fd);
+#endif
+    nxld_async_destroy(async);
+    for (size_t i = 0; i < item_count; i++) {
+        free(items[i].string_value);
+    }
+
+    nxld_log_info("Entry chains finished: %zu of %zu succeeded (%zu completed)", succeeded, item_count, completed);
+    return succeeded == item_count && submitted == item_count ? 0 : -1;
+}
+
+/**
+ * @brief 回放录制的入口调用并打印统计 / Replay recorded entry invocations and print statistics / Aufgezeichnete Einstiegsaufrufe wiedergeben und Statistik ausgeben
+ * @return 回放成功返回0，否则返回-1 / Returns 0 if the replay succeeds, -1 otherwise / Gibt 0 zurück, wenn die Wiedergabe erfolgreich ist, sonst -1
+ */
+static int replay_recording(nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules, const char* path,
+                            nxld_replay_pacing_t pacing) {
+    printf("\nReplaying %s (%s pacing):\n", path, pacing == NXLD_REPLAY_PACING_ORIGINAL ? "original" : "fast");
+    nxld_replay_stats_t stats;
+    int status = nxld_replay_run(plan, rules, path, pacing, &stats);
+    double seconds = (double)stats.elapsed_ns / 1e9;
+    printf("  Invocations: %zu (%zu failed, %zu skipped, %zu opaque values as NULL)\n", stats.invocations,
+           stats.failed, stats.skipped, stats.opaque);
+    printf("  Constants: %s\n", stats.constants_match ? "match recording" : "differ from recording");
+    if (stats.traces > 0) {
+        printf("  Hop values: %zu of %zu invocations diverged from %zu recorded traces\n", stats.diverged, stats.invocations,
+               stats.traces);
+    } else {
+        printf("  Hop values: not compared, recording has no hop traces\n");
+    }
+    printf("  Elapsed: %.3f ms (recorded %.3f ms), %.0f calls/s\n", (double)stats.elapsed_ns / 1e6,
+           (double)stats.recorded_ns / 1e6, seconds > 0.0 ? (double)stats.invocations / seconds : 0.0);
+    printf("  Latency: p50 %llu ns, p99 %llu ns, max %llu ns\n",
+           (unsigned long long)nxld_metrics_percentile(&stats.latency, 50.0),
+           (unsigned long long)nxld_metrics_percentile(&stats.latency, 99.0),
+           (unsigned long long)stats.latency.max_ns);
+    if (pacing == NXLD_REPLAY_PACING_ORIGINAL) {
+        printf("  Max lag: %.3f ms\n", (double)stats.max_lag_ns / 1e6);
+    }
+    return status;
+}
 
 int main(int argc, char* argv[]) {
-    const char* config_file = argc > 1 ? argv[1] : "NexusEngine.nxld";
-    const char* log_file = "nxld_parser.log";
+    const char* config_file = "NexusEngine.nxld";
+    const char* metrics_path = NULL;
+    const char* trace_path = NULL;
+    const char* record_path = NULL;
+    const char* replay_path = NULL;
+    nxld_replay_pacing_t replay_pacing = NXLD_REPLAY_PACING_FAST;
+    int run_chains = 0;
+    int log_binary = 0;
+    int log_uring = 0;
+    int log_compress = 0;
+    const char* log_plugin = NULL;
+    const char* log_plugin_config = "";
+    unsigned long log_segment_mb = 0;
+    unsigned long log_segments = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--run") == 0) {
+            run_chains = 1;
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metrics_path = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay-pacing") == 0 && i + 1 < argc) {
+            replay_pacing = strcmp(argv[++i], "original") == 0 ? NXLD_REPLAY_PACING_ORIGINAL : NXLD_REPLAY_PACING_FAST;
+        } else if (strcmp(argv[i], "--log-overflow") == 0 && i + 1 < argc) {
+            const char* policy = argv[++i];
+            nxld_logger_set_overflow_policy(strcmp(policy, "drop") == 0 ? NXLD_LOG_OVERFLOW_DROP :
+                                            strcmp(policy, "count") == 0 ? NXLD_LOG_OVERFLOW_COUNT :
+                                            NXLD_LOG_OVERFLOW_BLOCK);
+        } else if (strcmp(argv[i], "--log-binary") == 0) {
+            log_binary = 1;
+        } else if (strcmp(argv[i], "--log-io-uring") == 0) {
+            log_uring = 1;
+        } else if (strcmp(argv[i], "--log-plugin") == 0 && i + 1 < argc) {
+            log_plugin = argv[++i];
+        } else if (strcmp(argv[i], "--log-plugin-config") == 0 && i + 1 < argc) {
+            log_plugin_config = argv[++i];
+        } else if (strcmp(argv[i], "--log-compress") == 0) {
+            log_compress = 1;
+        } else if (strcmp(argv[i], "--log-segment-size") == 0 && i + 1 < argc) {
+            log_segment_mb = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--log-segments") == 0 && i + 1 < argc) {
+            log_segments = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+            if (nxld_logger_parse_levels(argv[++i]) != 0) {
+                fprintf(stderr, "Ignoring unknown parts of --log-level %s\n", argv[i]);
+            }
+        } else {
+            config_file = argv[i];
+        }
+    }
+    // 二进制日志用nxld_log_decode还原为文本 / Binary logs are turned back into text with nxld_log_decode / Binäre Protokolle werden mit nxld_log_decode in Text zurückverwandelt
+    const char* log_file = log_binary ? "nxld_parser.nxlog" : "nxld_parser.log";
+    if (log_binary) {
+        nxld_logger_set_encoding(NXLD_LOG_ENCODING_BINARY);
+    }
+    nxld_logger_set_segments((size_t)log_segment_mb * 1024 * 1024, (size_t)log_segments);
+    nxld_logger_set_segment_compression(log_compress);
+    nxld_logger_set_io(log_uring ? NXLD_LOG_IO_URING : NXLD_LOG_IO_WRITE);
+
+    if (metrics_path != NULL) {
+        block_metrics_signal();
+    }
     
     if (nxld_logger_init(log_file) != 0) {
         fprintf(stderr, "Failed to initialize logger\n");
@@ -29,15 +532,37 @@ int main(int argc, char* argv[]) {
     }
     
     nxld_log_info("Starting NXLD engine");
+    if (log_uring && nxld_logger_get_io() != NXLD_LOG_IO_URING) {
+        nxld_log_warning("io_uring is not available, writing the log with write()");
+    }
+    if (log_compress && log_segment_mb == 0) {
+        nxld_log_warning("--log-compress only applies with --log-segment-size, the log is not compressed");
+    }
+    // 切换到日志插件不需要其他线程停止记录日志 / Switching to the logger plugin does not require other threads to stop logging / Das Umschalten auf das Logger-Plugin erfordert nicht, dass andere Threads aufhören zu protokollieren
+    if (log_plugin != NULL && nxld_logger_load_plugin(log_plugin, log_plugin_config) != 0) {
+        nxld_log_warning("Failed to load logger plugin %s, logging to %s", log_plugin, log_file);
+    }
     nxld_log_info("Config file: %s", config_file);
+
+    // 跟踪须在其他线程启动前开始，在所有线程结束后停止 / Tracing must start before other threads and stop after all of them have ended / Die Verfolgung muss vor anderen Threads beginnen und nach dem Ende aller Threads stoppen
+    if (trace_path != NULL) {
+        if (nxld_trace_start(trace_path) == 0) {
+            nxld_trace_thread_name("main");
+        } else {
+            nxld_log_warning("Failed to start tracing to %s", trace_path);
+        }
+    }
     
     nxld_config_t config;
+    uint64_t trace_start = nxld_trace_begin();
     nxld_parse_result_t result = nxld_parse_file(config_file, &config);
+    nxld_trace_end("config", "parse config", trace_start, config_file);
     
     if (result != NXLD_PARSE_SUCCESS) {
         const char* error_msg = nxld_get_error_message(result);
         nxld_log_error("Parse failed: %s", error_msg);
         fprintf(stderr, "Parse failed: %s\n", error_msg);
+        nxld_trace_stop();
         nxld_logger_close();
         return 1;
     }
@@ -57,13 +582,19 @@ int main(int argc, char* argv[]) {
         printf("    %s = %s\n", config.virtual_parent_keys[i], config.virtual_parent_values[i]);
     }
     
+    if (nxld_buffer_pool_init(NULL) != 0) {
+        nxld_log_warning("Failed to initialize buffer pool, plugins will fall back to their own allocations");
+    }
+    
     printf("\nLoading root plugins:\n");
     nxld_plugin_t* plugins = NULL;
     size_t loaded_count = 0;
     
     if (nxld_load_plugins_from_config(&config, config_file, &plugins, &loaded_count) != 0) {
         fprintf(stderr, "Failed to load plugins\n");
+        nxld_buffer_pool_shutdown();
         nxld_config_free(&config);
+        nxld_trace_stop();
         nxld_logger_close();
         return 1;
     }
@@ -85,10 +616,61 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    nxld_transfer_rule_set_t transfer_rules;
+    nxld_transfer_plan_t transfer_plan;
+    int plan_status = compile_transfer_plan(plugins, loaded_count, config_file, &transfer_rules, &transfer_plan);
+    if (plan_status == 0) {
+        printf("\nExecution plan:\n");
+        printf("  Rules: %zu (%zu removed) from %zu files\n", transfer_rules.rule_count,
+               transfer_plan.skipped_rule_count, transfer_rules.loaded_file_count);
+        printf("  Nodes: %zu, Routes: %zu, Steps: %zu\n", transfer_plan.node_count,
+               transfer_plan.route_count, transfer_plan.step_count);
+        for (size_t i = 0; i < transfer_plan.route_count; i++) {
+            const nxld_plan_route_t* route = &transfer_plan.routes[i];
+            const nxld_plan_node_t* source = &transfer_plan.nodes[route->source_node];
+            printf("    %s.%s[%d]: %zu steps%s\n",
+                   transfer_plan.plugins[source->plugin_index].plugin_name, source->interface_name,
+                   route->source_param_index, route->step_count,
+                   i == transfer_plan.entry_route ? " (entry)" : "");
+        }
+        metrics_dumper_t dumper;
+        memset(&dumper, 0, sizeof(dumper));
+        dumper.plan = &transfer_plan;
+        dumper.rules = &transfer_rules;
+        dumper.path = metrics_path;
+        if (metrics_path != NULL) {
+            start_metrics_dumper(&dumper);
+        }
+        if (run_chains) {
+            printf("\nRunning entry chains:\n");
+            nxld_replay_recorder_t* recorder = NULL;
+            if (record_path != NULL && (recorder = nxld_replay_recorder_open(record_path, &transfer_rules)) == NULL) {
+                nxld_log_warning("Failed to start recording to %s", record_path);
+            }
+            if (recorder != NULL && nxld_replay_recorder_attach(recorder, &transfer_plan) != 0) {
+                nxld_log_warning("Hop values will not be recorded to %s", record_path);
+            }
+            run_entry_chains(&transfer_plan, &transfer_rules, recorder);
+            if (recorder != NULL) {
+                nxld_replay_recorder_close(recorder);
+            }
+        }
+        if (replay_path != NULL) {
+            replay_recording(&transfer_plan, &transfer_rules, replay_path, replay_pacing);
+        }
+        if (metrics_path != NULL) {
+            stop_metrics_dumper(&dumper);
+        }
+        nxld_transfer_plan_free(&transfer_plan);
+        nxld_transfer_rules_free(&transfer_rules);
+    }
+    
     nxld_free_plugins(plugins, loaded_count);
+    nxld_buffer_pool_shutdown();
     
     nxld_config_free(&config);
     nxld_log_info("Engine initialized successfully");
+    nxld_trace_stop();
     nxld_logger_close();
     
     return 0;
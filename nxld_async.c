@@ -0,0 +1,484 @@
+/**
+ * @file nxld_async.c
+ * @brief NXLD异步调用实现 / NXLD Asynchronous Call Implementation / NXLD-Implementierung asynchroner Aufrufe
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_async.h"
+#include "nxld_thread.h"
+#include "nxld_logger.h"
+#include "nxld_trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
+/**
+ * @brief 完成句柄结构体 / Completion handle structure / Abschluss-Handle-Struktur
+ */
+struct nxld_future {
+    nxld_async_t* async;                    /**< 所属执行器 / Owning executor / Zugehöriger Ausführer */
+    size_t route;                           /**< 计划路由索引 / Plan route index / Planroutenindex */
+    void* param_value;                      /**< 源参数值 / Source parameter value / Quellparameterwert */
+    const char* source_plugin;              /**< 批量调用的源插件名称 / Source plugin name of a batch call / Quell-Plugin-Name eines Stapelaufrufs */
+    const char* source_interface;           /**< 批量调用的源接口名称 / Source interface name of a batch call / Quellschnittstellenname eines Stapelaufrufs */
+    int first_param_index;                  /**< 批量调用的第一个源参数索引 / First source parameter index of a batch call / Erster Quellparameterindex eines Stapelaufrufs */
+    void* const* tuples;                    /**< 批量调用的元组数组，单次调用为NULL / Tuple array of a batch call, NULL for a single call / Tupel-Array eines Stapelaufrufs, NULL bei Einzelaufruf */
+    size_t tuple_size;                      /**< 每个元组的参数数量 / Parameters per tuple / Parameter je Tupel */
+    size_t tuple_count;                     /**< 元组数量 / Tuple count / Anzahl der Tupel */
+    int* statuses;                          /**< 每个元组的结果 / Per-tuple results / Ergebnisse je Tupel */
+    void* user_data;                        /**< 用户数据 / User data / Benutzerdaten */
+    nxld_future_status_t status;            /**< 句柄状态 / Handle status / Handle-Status */
+    long reaped;                            /**< 是否已取回，在锁内原子写入、锁外原子读取 / Whether reaped, stored atomically under the lock and loaded atomically without it / Ob abgeholt, atomar unter der Sperre gespeichert und ohne sie atomar geladen */
+    struct nxld_future* next;               /**< 队列中的下一个句柄 / Next handle in queue / Nächstes Handle in der Warteschlange */
+};
+
+/**
+ * @brief 工作线程结构体 / Worker thread structure / Worker-Thread-Struktur
+ */
+typedef struct {
+    nxld_async_t* async;                    /**< 所属执行器 / Owning executor / Zugehöriger Ausführer */
+    nxld_plan_context_t* context;           /**< 工作线程私有的执行上下文 / Worker-private execution context / Worker-eigener Ausführungskontext */
+    nxld_thread_t thread;                   /**< 线程句柄 / Thread handle / Thread-Handle */
+} async_worker_t;
+
+/**
+ * @brief 异步执行器结构体 / Asynchronous executor structure / Struktur des asynchronen Ausführers
+ */
+struct nxld_async {
+    nxld_transfer_plan_t* plan;             /**< 执行计划 / Execution plan / Ausführungsplan */
+    async_worker_t* workers;                /**< 工作线程数组 / Worker thread array / Worker-Thread-Array */
+    size_t worker_count;                    /**< 工作线程数量 / Worker thread count / Anzahl der Worker-Threads */
+    nxld_future_t* queue_head;              /**< 待执行队列头 / Pending queue head / Kopf der Warteschlange */
+    nxld_future_t* queue_tail;              /**< 待执行队列尾 / Pending queue tail / Ende der Warteschlange */
+    nxld_future_t* done_head;               /**< 已完成队列头 / Completed queue head / Kopf der Abschlussliste */
+    nxld_future_t* done_tail;               /**< 已完成队列尾 / Completed queue tail / Ende der Abschlussliste */
+    size_t in_flight;                       /**< 未取回的调用数量 / Calls not yet reaped / Noch nicht abgeholte Aufrufe */
+    int shutdown;                           /**< 正在关闭 / Shutting down / Wird heruntergefahren */
+    nxld_mutex_t mutex;                     /**< 队列互斥锁 / Queue mutex / Warteschlangen-Mutex */
+    nxld_cond_t work_ready;                 /**< 有待执行调用 / Pending call available / Ausstehender Aufruf verfügbar */
+    nxld_cond_t work_done;                  /**< 有调用完成 / A call completed / Ein Aufruf wurde abgeschlossen */
+#ifdef _WIN32
+    HANDLE event;                           /**< 手动重置事件 / Manual-reset event / Manuell zurückgesetztes Ereignis */
+#else
+    int event_fd;                           /**< eventfd或管道读端 / eventfd or pipe read end / eventfd oder Pipe-Leseende */
+    int signal_fd;                          /**< eventfd或管道写端 / eventfd or pipe write end / eventfd oder Pipe-Schreibende */
+#endif
+};
+
+#ifdef _WIN32
+static int load_reaped(nxld_future_t* future) {
+    return InterlockedCompareExchange((volatile LONG*)&future->reaped, 0, 0) != 0;
+}
+
+static void publish_reaped(nxld_future_t* future) {
+    InterlockedExchange((volatile LONG*)&future->reaped, 1);
+}
+#else
+static int load_reaped(nxld_future_t* future) {
+    return __atomic_load_n(&future->reaped, __ATOMIC_ACQUIRE) != 0;
+}
+
+static void publish_reaped(nxld_future_t* future) {
+    __atomic_store_n(&future->reaped, 1, __ATOMIC_RELEASE);
+}
+#endif
+
+/**
+ * @brief 创建完成事件 / Create completion event / Abschlussereignis erstellen
+ */
+static int event_open(nxld_async_t* async) {
+#ifdef _WIN32
+    async->event = CreateEventA(NULL, TRUE, FALSE, NULL);
+    return async->event != NULL ? 0 : -1;
+#elif defined(__linux__)
+    async->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    async->signal_fd = async->event_fd;
+    return async->event_fd >= 0 ? 0 : -1;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    async->event_fd = fds[0];
+    async->signal_fd = fds[1];
+    return 0;
+#endif
+}
+
+/**
+ * @brief 关闭完成事件 / Close completion event / Abschlussereignis schließen
+ */
+static void event_close(nxld_async_t* async) {
+#ifdef _WIN32
+    if (async->event != NULL) {
+        CloseHandle(async->event);
+    }
+#else
+    if (async->event_fd >= 0) {
+        close(async->event_fd);
+    }
+    if (async->signal_fd >= 0 && async->signal_fd != async->event_fd) {
+        close(async->signal_fd);
+    }
+#endif
+}
+
+/**
+ * @brief 触发完成事件 / Signal completion event / Abschlussereignis signalisieren
+ */
+static void event_signal(nxld_async_t* async) {
+#ifdef _WIN32
+    SetEvent(async->event);
+#elif defined(__linux__)
+    uint64_t one = 1;
+    ssize_t written = write(async->signal_fd, &one, sizeof(one));
+    (void)written;
+#else
+    // 管道已满时读端必然可读，忽略EAGAIN / A full pipe is already readable, so EAGAIN is ignored / Eine volle Pipe ist bereits lesbar, daher wird EAGAIN ignoriert
+    char byte = 1;
+    ssize_t written = write(async->signal_fd, &byte, 1);
+    (void)written;
+#endif
+}
+
+/**
+ * @brief 清除完成事件 / Clear completion event / Abschlussereignis zurücksetzen
+ */
+static void event_drain(nxld_async_t* async) {
+#ifdef _WIN32
+    ResetEvent(async->event);
+#elif defined(__linux__)
+    uint64_t count;
+    ssize_t got = read(async->event_fd, &count, sizeof(count));
+    (void)got;
+#else
+    char bytes[64];
+    while (read(async->event_fd, bytes, sizeof(bytes)) > 0) {
+    }
+#endif
+}
+
+/**
+ * @brief 工作线程入口 / Worker thread entry / Worker-Thread-Einstieg
+ */
+static void async_worker(void* arg) {
+    async_worker_t* worker = (async_worker_t*)arg;
+    nxld_async_t* async = worker->async;
+    nxld_trace_thread_name("async worker");
+
+    for (;;) {
+        nxld_mutex_lock(&async->mutex);
+        while (async->queue_head == NULL && !async->shutdown) {
+            nxld_cond_wait(&async->work_ready, &async->mutex);
+        }
+        nxld_future_t* future = async->queue_head;
+        if (future == NULL) {
+            nxld_mutex_unlock(&async->mutex);
+            break;
+        }
+        async->queue_head = future->next;
+        if (async->queue_head == NULL) {
+            async->queue_tail = NULL;
+        }
+        future->next = NULL;
+        nxld_mutex_unlock(&async->mutex);
+
+        int status = future->tuples != NULL
+                         ? nxld_transfer_plan_call_batch_context(worker->context, future->source_plugin, future->source_interface,
+                                                                 future->first_param_index, future->tuples, future->tuple_size,
+                                                                 future->tuple_count, future->statuses)
+                         : nxld_transfer_plan_execute_context(worker->context, future->route, future->param_value);
+
+        nxld_mutex_lock(&async->mutex);
+        future->status = status == 0 ? NXLD_FUTURE_SUCCESS : NXLD_FUTURE_FAILED;
+        if (async->done_tail != NULL) {
+            async->done_tail->next = future;
+        } else {
+            async->done_head = future;
+        }
+        async->done_tail = future;
+        nxld_cond_broadcast(&async->work_done);
+        nxld_mutex_unlock(&async->mutex);
+
+        event_signal(async);
+    }
+}
+
+nxld_async_t* nxld_async_create(nxld_transfer_plan_t* plan, size_t worker_count) {
+    if (plan == NULL) {
+        return NULL;
+    }
+
+    nxld_async_t* async = (nxld_async_t*)calloc(1, sizeof(nxld_async_t));
+    if (async == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for async executor");
+        return NULL;
+    }
+#ifndef _WIN32
+    async->event_fd = -1;
+    async->signal_fd = -1;
+#endif
+
+    if (event_open(async) != 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to create completion event for async executor");
+        event_close(async);
+        free(async);
+        return NULL;
+    }
+
+    if (worker_count == 0) {
+        worker_count = nxld_thread_cpu_count();
+    }
+    async->workers = (async_worker_t*)calloc(worker_count, sizeof(async_worker_t));
+    if (async->workers == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for async executor");
+        event_close(async);
+        free(async);
+        return NULL;
+    }
+
+    async->plan = plan;
+    nxld_mutex_init(&async->mutex);
+    nxld_cond_init(&async->work_ready);
+    nxld_cond_init(&async->work_done);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        async_worker_t* worker = &async->workers[i];
+        worker->async = async;
+        worker->context = nxld_transfer_plan_context_create(plan);
+        if (worker->context == NULL || nxld_thread_create(&worker->thread, async_worker, worker) != 0) {
+            nxld_transfer_plan_context_free(worker->context);
+            worker->context = NULL;
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Failed to create async worker %zu, continuing with %zu workers", i, i);
+            break;
+        }
+        async->worker_count++;
+    }
+
+    if (async->worker_count == 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to create any async worker");
+        nxld_async_destroy(async);
+        return NULL;
+    }
+
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Async executor started with %zu workers", async->worker_count);
+    return async;
+}
+
+void nxld_async_destroy(nxld_async_t* async) {
+    if (async == NULL) {
+        return;
+    }
+
+    nxld_mutex_lock(&async->mutex);
+    async->shutdown = 1;
+    nxld_cond_broadcast(&async->work_ready);
+    nxld_mutex_unlock(&async->mutex);
+
+    // 工作线程在退出前执行完队列中剩余的调用 / Workers finish the remaining queued calls before exiting / Worker arbeiten verbleibende Aufrufe vor dem Beenden ab
+    for (size_t i = 0; i < async->worker_count; i++) {
+        nxld_thread_join(async->workers[i].thread);
+        nxld_transfer_plan_context_free(async->workers[i].context);
+    }
+
+    nxld_future_t* future = async->done_head;
+    while (future != NULL) {
+        nxld_future_t* next = future->next;
+        free(future);
+        future = next;
+    }
+
+    nxld_cond_destroy(&async->work_done);
+    nxld_cond_destroy(&async->work_ready);
+    nxld_mutex_destroy(&async->mutex);
+    event_close(async);
+    free(async->workers);
+    free(async);
+}
+
+/**
+ * @brief 将句柄加入待执行队列并唤醒工作线程 / Queue a handle and wake a worker / Handle einreihen und einen Worker wecken
+ */
+static void enqueue_future(nxld_async_t* async, nxld_future_t* future) {
+    nxld_mutex_lock(&async->mutex);
+    if (async->queue_tail != NULL) {
+        async->queue_tail->next = future;
+    } else {
+        async->queue_head = future;
+    }
+    async->queue_tail = future;
+    async->in_flight++;
+    nxld_cond_signal(&async->work_ready);
+    nxld_mutex_unlock(&async->mutex);
+}
+
+nxld_future_t* nxld_async_call(nxld_async_t* async, const char* source_plugin, const char* source_interface,
+                               int param_index, void* param_value, void* user_data) {
+    if (async == NULL) {
+        return NULL;
+    }
+
+    // 路由在提交时解析，计划编译后只读 / Routes are resolved at submission, the compiled plan is read-only / Routen werden bei der Einreichung aufgelöst, der kompilierte Plan ist schreibgeschützt
+    size_t route = nxld_transfer_plan_find_route(async->plan, source_plugin, source_interface, param_index);
+    if (route == NXLD_PLAN_INVALID_INDEX) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "No execution plan route for %s.%s[%d]",
+                         source_plugin != NULL ? source_plugin : "NULL",
+                         source_interface != NULL ? source_interface : "NULL", param_index);
+        return NULL;
+    }
+
+    nxld_future_t* future = (nxld_future_t*)calloc(1, sizeof(nxld_future_t));
+    if (future == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for completion handle");
+        return NULL;
+    }
+    future->async = async;
+    future->route = route;
+    future->param_value = param_value;
+    future->user_data = user_data;
+    future->status = NXLD_FUTURE_PENDING;
+    enqueue_future(async, future);
+    return future;
+}
+
+nxld_future_t* nxld_async_call_batch(nxld_async_t* async, const char* source_plugin, const char* source_interface,
+                                     int first_param_index, void* const* tuples, size_t tuple_size, size_t tuple_count,
+                                     int* statuses, void* user_data) {
+    if (async == NULL || tuples == NULL || tuple_size == 0 || tuple_count == 0) {
+        return NULL;
+    }
+
+    nxld_future_t* future = (nxld_future_t*)calloc(1, sizeof(nxld_future_t));
+    if (future == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for completion handle");
+        return NULL;
+    }
+    // 路由在工作线程中每批查找一次 / Routes are looked up once per batch on the worker / Routen werden einmal pro Stapel im Worker gesucht
+    future->async = async;
+    future->route = NXLD_PLAN_INVALID_INDEX;
+    future->source_plugin = source_plugin;
+    future->source_interface = source_interface;
+    future->first_param_index = first_param_index;
+    future->tuples = tuples;
+    future->tuple_size = tuple_size;
+    future->tuple_count = tuple_count;
+    future->statuses = statuses;
+    future->user_data = user_data;
+    future->status = NXLD_FUTURE_PENDING;
+    enqueue_future(async, future);
+    return future;
+}
+
+intptr_t nxld_async_get_event(const nxld_async_t* async) {
+    if (async == NULL) {
+        return -1;
+    }
+#ifdef _WIN32
+    return (intptr_t)async->event;
+#else
+    return (intptr_t)async->event_fd;
+#endif
+}
+
+size_t nxld_async_reap(nxld_async_t* async, nxld_future_t** futures, size_t max_futures) {
+    if (async == NULL || futures == NULL || max_futures == 0) {
+        return 0;
+    }
+
+    // 先清除事件再取队列，避免丢失并发完成的通知 / Clear the event before taking the list so concurrent completions are not lost / Ereignis vor dem Entnehmen zurücksetzen, damit gleichzeitige Abschlüsse nicht verloren gehen
+    event_drain(async);
+
+    size_t count = 0;
+    nxld_mutex_lock(&async->mutex);
+    while (async->done_head != NULL && count < max_futures) {
+        nxld_future_t* future = async->done_head;
+        async->done_head = future->next;
+        future->next = NULL;
+        publish_reaped(future);
+        futures[count++] = future;
+    }
+    if (async->done_head == NULL) {
+        async->done_tail = NULL;
+    }
+    async->in_flight -= count;
+    int remaining = async->done_head != NULL;
+    nxld_mutex_unlock(&async->mutex);
+
+    if (remaining) {
+        event_signal(async);
+    }
+    return count;
+}
+
+size_t nxld_async_in_flight(nxld_async_t* async) {
+    if (async == NULL) {
+        return 0;
+    }
+
+    nxld_mutex_lock(&async->mutex);
+    size_t in_flight = async->in_flight;
+    nxld_mutex_unlock(&async->mutex);
+    return in_flight;
+}
+
+nxld_future_status_t nxld_future_status(nxld_future_t* future) {
+    if (future == NULL) {
+        return NXLD_FUTURE_FAILED;
+    }
+    // 取回后执行器可能已销毁，因此不加锁；取回前写入的状态对获取读可见 / Once reaped the executor may be destroyed, so no lock is taken; the acquire load makes the status written before reaping visible / Nach dem Abholen kann der Ausführer zerstört sein, daher ohne Sperre; das Acquire-Laden macht den vor dem Abholen geschriebenen Status sichtbar
+    if (load_reaped(future)) {
+        return future->status;
+    }
+
+    nxld_mutex_lock(&future->async->mutex);
+    nxld_future_status_t status = future->status;
+    nxld_mutex_unlock(&future->async->mutex);
+    return status;
+}
+
+nxld_future_status_t nxld_future_wait(nxld_future_t* future) {
+    if (future == NULL) {
+        return NXLD_FUTURE_FAILED;
+    }
+    // 同nxld_future_status / As in nxld_future_status / Wie in nxld_future_status
+    if (load_reaped(future)) {
+        return future->status;
+    }
+
+    nxld_async_t* async = future->async;
+    nxld_mutex_lock(&async->mutex);
+    while (future->status == NXLD_FUTURE_PENDING) {
+        nxld_cond_wait(&async->work_done, &async->mutex);
+    }
+    nxld_future_status_t status = future->status;
+    nxld_mutex_unlock(&async->mutex);
+    return status;
+}
+
+void* nxld_future_user_data(const nxld_future_t* future) {
+    return future != NULL ? future->user_data : NULL;
+}
+
+void nxld_future_release(nxld_future_t* future) {
+    if (future == NULL || !load_reaped(future)) {
+        return;
+    }
+    free(future);
+}
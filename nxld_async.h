@@ -0,0 +1,129 @@
+/**
+ * @file nxld_async.h
+ * @brief NXLD异步调用接口 / NXLD Asynchronous Call Interface / NXLD-Schnittstelle für asynchrone Aufrufe
+ * @details 非阻塞CallPlugin变体：调用立即返回完成句柄，工作线程执行调用链，完成通过事件描述符通知 / Non-blocking CallPlugin variant: calls return a completion handle immediately, worker threads run the chain and completion is signalled through an event descriptor / Nicht blockierende CallPlugin-Variante: Aufrufe liefern sofort ein Abschluss-Handle, Worker-Threads führen die Kette aus und der Abschluss wird über einen Ereignisdeskriptor signalisiert
+ */
+
+#ifndef NXLD_ASYNC_H
+#define NXLD_ASYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nxld_transfer_plan.h"
+
+/**
+ * @brief 完成句柄状态枚举 / Completion handle status enumeration / Abschluss-Handle-Status-Aufzählung
+ */
+typedef enum {
+    NXLD_FUTURE_PENDING = 0,                /**< 尚未完成 / Not yet completed / Noch nicht abgeschlossen */
+    NXLD_FUTURE_SUCCESS,                    /**< 调用链成功 / Chain succeeded / Kette erfolgreich */
+    NXLD_FUTURE_FAILED                      /**< 调用链失败 / Chain failed / Kette fehlgeschlagen */
+} nxld_future_status_t;
+
+/**
+ * @brief 完成句柄 / Completion handle / Abschluss-Handle
+ */
+typedef struct nxld_future nxld_future_t;
+
+/**
+ * @brief 异步执行器 / Asynchronous executor / Asynchroner Ausführer
+ */
+typedef struct nxld_async nxld_async_t;
+
+/**
+ * @brief 创建异步执行器 / Create asynchronous executor / Asynchronen Ausführer erstellen
+ * @param plan 已编译的执行计划（在执行器销毁前须保持有效） / Compiled execution plan (must outlive the executor) / Kompilierter Ausführungsplan (muss den Ausführer überdauern)
+ * @param worker_count 工作线程数量（0表示CPU数量） / Worker thread count (0 for CPU count) / Anzahl der Worker-Threads (0 für CPU-Anzahl)
+ * @return 执行器指针，失败返回NULL / Executor pointer, NULL on failure / Ausführer-Zeiger, NULL bei Fehler
+ */
+nxld_async_t* nxld_async_create(nxld_transfer_plan_t* plan, size_t worker_count);
+
+/**
+ * @brief 销毁异步执行器 / Destroy asynchronous executor / Asynchronen Ausführer zerstören
+ * @param async 执行器指针 / Executor pointer / Ausführer-Zeiger
+ * @details 等待已提交的调用完成，并释放所有未取回的完成句柄 / Waits for submitted calls to finish and frees every completion handle not yet reaped / Wartet auf eingereichte Aufrufe und gibt alle nicht abgeholten Abschluss-Handles frei
+ */
+void nxld_async_destroy(nxld_async_t* async);
+
+/**
+ * @brief 提交异步调用（CallPlugin的非阻塞变体） / Submit asynchronous call (non-blocking variant of CallPlugin) / Asynchronen Aufruf einreichen (nicht blockierende Variante von CallPlugin)
+ * @param async 执行器指针 / Executor pointer / Ausführer-Zeiger
+ * @param source_plugin 源插件名称 / Source plugin name / Quell-Plugin-Name
+ * @param source_interface 源接口名称 / Source interface name / Quellschnittstellenname
+ * @param param_index 源参数索引 / Source parameter index / Quellparameterindex
+ * @param param_value 源参数值（完成前须保持有效） / Source parameter value (must stay valid until completion) / Quellparameterwert (muss bis zum Abschluss gültig bleiben)
+ * @param user_data 用户数据 / User data / Benutzerdaten
+ * @return 完成句柄，未找到路由或失败时返回NULL / Completion handle, NULL if no route exists or on failure / Abschluss-Handle, NULL ohne Route oder bei Fehler
+ */
+nxld_future_t* nxld_async_call(nxld_async_t* async, const char* source_plugin, const char* source_interface,
+                               int param_index, void* param_value, void* user_data);
+
+/**
+ * @brief 提交异步批量调用 / Submit asynchronous batch call / Asynchronen Stapelaufruf einreichen
+ * @param async 执行器指针 / Executor pointer / Ausführer-Zeiger
+ * @param source_plugin 源插件名称（完成前须保持有效） / Source plugin name (must stay valid until completion) / Quell-Plugin-Name (muss bis zum Abschluss gültig bleiben)
+ * @param source_interface 源接口名称（完成前须保持有效） / Source interface name (must stay valid until completion) / Quellschnittstellenname (muss bis zum Abschluss gültig bleiben)
+ * @param first_param_index 元组第一个元素对应的源参数索引 / Source parameter index of the first tuple element / Quellparameterindex des ersten Tupelelements
+ * @param tuples 按行存储的参数元组数组（完成前须保持有效） / Row-major argument tuple array (must stay valid until completion) / Zeilenweise gespeichertes Argumenttupel-Array (muss bis zum Abschluss gültig bleiben)
+ * @param tuple_size 每个元组的参数数量 / Parameters per tuple / Parameter je Tupel
+ * @param tuple_count 元组数量 / Tuple count / Anzahl der Tupel
+ * @param statuses 输出每个元组的结果（可为NULL，完成后可读） / Output per-tuple results (may be NULL, readable after completion) / Ausgabe der Ergebnisse je Tupel (kann NULL sein, nach Abschluss lesbar)
+ * @param user_data 用户数据 / User data / Benutzerdaten
+ * @return 完成句柄，失败返回NULL；任一元组失败时句柄状态为失败 / Completion handle, NULL on failure; the handle fails if any tuple fails / Abschluss-Handle, NULL bei Fehler; das Handle schlägt fehl, wenn ein Tupel fehlschlägt
+ * @details 整批在一个工作线程上通过nxld_transfer_plan_call_batch_context执行 / The whole batch runs on one worker through nxld_transfer_plan_call_batch_context / Der ganze Stapel läuft auf einem Worker über nxld_transfer_plan_call_batch_context
+ */
+nxld_future_t* nxld_async_call_batch(nxld_async_t* async, const char* source_plugin, const char* source_interface,
+                                     int first_param_index, void* const* tuples, size_t tuple_size, size_t tuple_count,
+                                     int* statuses, void* user_data);
+
+/**
+ * @brief 获取完成事件描述符 / Get completion event descriptor / Abschluss-Ereignisdeskriptor abrufen
+ * @param async 执行器指针 / Executor pointer / Ausführer-Zeiger
+ * @return Linux上为eventfd，其他POSIX系统为管道读端，Windows上为事件HANDLE；可读或有信号时表示有完成句柄可取回 / eventfd on Linux, pipe read end on other POSIX systems, event HANDLE on Windows; readable or signalled when completions can be reaped / eventfd unter Linux, Pipe-Leseende auf anderen POSIX-Systemen, Ereignis-HANDLE unter Windows; lesbar bzw. signalisiert, wenn Abschlüsse abholbar sind
+ */
+intptr_t nxld_async_get_event(const nxld_async_t* async);
+
+/**
+ * @brief 取回已完成的句柄 / Reap completed handles / Abgeschlossene Handles abholen
+ * @param async 执行器指针 / Executor pointer / Ausführer-Zeiger
+ * @param futures 输出句柄数组 / Output handle array / Ausgabe-Handle-Array
+ * @param max_futures 数组容量 / Array capacity / Array-Kapazität
+ * @return 取回的句柄数量；每个句柄只返回一次，之后须用nxld_future_release释放 / Number of reaped handles; each handle is returned once and must then be released with nxld_future_release / Anzahl abgeholter Handles; jedes Handle wird einmal geliefert und muss danach mit nxld_future_release freigegeben werden
+ */
+size_t nxld_async_reap(nxld_async_t* async, nxld_future_t** futures, size_t max_futures);
+
+/**
+ * @brief 获取尚未取回的调用数量 / Get number of calls not yet reaped / Anzahl noch nicht abgeholter Aufrufe abrufen
+ * @param async 执行器指针 / Executor pointer / Ausführer-Zeiger
+ * @return 已提交但未取回的调用数量 / Submitted calls not yet reaped / Eingereichte, noch nicht abgeholte Aufrufe
+ */
+size_t nxld_async_in_flight(nxld_async_t* async);
+
+/**
+ * @brief 获取完成句柄状态 / Get completion handle status / Status des Abschluss-Handles abrufen
+ * @param future 完成句柄 / Completion handle / Abschluss-Handle
+ * @return 句柄状态 / Handle status / Handle-Status
+ */
+nxld_future_status_t nxld_future_status(nxld_future_t* future);
+
+/**
+ * @brief 阻塞等待完成句柄 / Block until completion handle finishes / Blockieren, bis das Abschluss-Handle fertig ist
+ * @param future 完成句柄 / Completion handle / Abschluss-Handle
+ * @return 最终状态 / Final status / Endstatus
+ */
+nxld_future_status_t nxld_future_wait(nxld_future_t* future);
+
+/**
+ * @brief 获取提交时的用户数据 / Get user data given at submission / Bei der Einreichung angegebene Benutzerdaten abrufen
+ * @param future 完成句柄 / Completion handle / Abschluss-Handle
+ * @return 用户数据 / User data / Benutzerdaten
+ */
+void* nxld_future_user_data(const nxld_future_t* future);
+
+/**
+ * @brief 释放已取回的完成句柄 / Release a reaped completion handle / Abgeholtes Abschluss-Handle freigeben
+ * @param future 完成句柄 / Completion handle / Abschluss-Handle
+ */
+void nxld_future_release(nxld_future_t* future);
+
+#endif /* NXLD_ASYNC_H */
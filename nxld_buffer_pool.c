@@ -0,0 +1,381 @@
+/**
+ * @file nxld_buffer_pool.c
+ * @brief NXLD大缓冲区池实现 / NXLD Large Buffer Pool Implementation / NXLD-Großpufferpool-Implementierung
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_buffer_pool.h"
+#include "nxld_logger.h"
+#include "nxld_thread.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#define POOL_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+#define POOL_DEFAULT_MAX_CACHED_BYTES ((size_t)2 * 1024 * 1024 * 1024)
+#define POOL_MAX_TOUCH_THREADS 64
+
+/**
+ * @brief 池内存块结构体 / Pool block structure / Pool-Blockstruktur
+ */
+typedef struct pool_block {
+    void* mapping;                          /**< 映射起始地址 / Mapping start address / Startadresse der Abbildung */
+    void* base;                             /**< 对齐后的块起始地址 / Aligned block base address / Ausgerichtete Block-Basisadresse */
+    size_t size;                            /**< 块大小 / Block size / Blockgröße */
+    int in_use;                             /**< 是否已分配 / Whether allocated / Ob zugewiesen */
+    struct pool_block* next;                /**< 下一个块 / Next block / Nächster Block */
+} pool_block_t;
+
+/**
+ * @brief 首次访问任务结构体 / First-touch task structure / Erstzugriffs-Aufgabenstruktur
+ */
+typedef struct {
+    unsigned char* start;                   /**< 分片起始地址 / Slice start address / Startadresse des Abschnitts */
+    size_t length;                          /**< 分片长度 / Slice length / Abschnittslänge */
+} touch_task_t;
+
+static nxld_buffer_pool_config_t g_pool_config;
+static nxld_mutex_t g_pool_mutex;
+static pool_block_t* g_pool_blocks = NULL;
+static nxld_buffer_pool_stats_t g_pool_stats;
+static int g_pool_initialized = 0;
+// 映射在池锁外进行，hugetlbfs是否可用用原子标志记录 / Mapping happens outside the pool lock, so hugetlbfs availability is an atomic flag / Die Abbildung erfolgt außerhalb der Pool-Sperre, daher ist die hugetlbfs-Verfügbarkeit ein atomares Flag
+static int g_pool_hugetlb = 0;
+
+/**
+ * @brief 向上取整到大页边界 / Round up to huge page boundary / Auf Huge-Page-Grenze aufrunden
+ */
+static size_t round_to_huge_page(size_t size) {
+    return (size + POOL_HUGE_PAGE_SIZE - 1) & ~(POOL_HUGE_PAGE_SIZE - 1);
+}
+
+/**
+ * @brief 映射新内存块 / Map new memory block / Neuen Speicherblock abbilden
+ * @details 映射按2MB对齐，使透明大页可以覆盖整个块 / Mappings are 2 MB aligned so transparent huge pages can back the whole block / Abbildungen sind auf 2 MB ausgerichtet, damit Transparent Huge Pages den ganzen Block abdecken können
+ */
+static void* map_block(size_t size, void** mapping) {
+#ifdef _WIN32
+    unsigned char* raw = (unsigned char*)VirtualAlloc(NULL, size + POOL_HUGE_PAGE_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (raw == NULL) {
+        return NULL;
+    }
+    *mapping = raw;
+    return (void*)(((uintptr_t)raw + POOL_HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(POOL_HUGE_PAGE_SIZE - 1));
+#else
+#ifdef MAP_HUGETLB
+    if (__atomic_load_n(&g_pool_hugetlb, __ATOMIC_RELAXED)) {
+        void* huge = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (huge != MAP_FAILED) {
+            *mapping = huge;
+            return huge;
+        }
+        // 只有清除标志的线程记录一次 / Only the thread that clears the flag logs it, once / Nur der Thread, der das Flag löscht, protokolliert einmal
+        if (__atomic_exchange_n(&g_pool_hugetlb, 0, __ATOMIC_RELAXED)) {
+            nxld_log_info("hugetlbfs mapping of %zu bytes unavailable, falling back to regular pages", size);
+        }
+    }
+#endif
+
+    size_t mapped_size = size + POOL_HUGE_PAGE_SIZE;
+    unsigned char* raw = (unsigned char*)mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == (unsigned char*)MAP_FAILED) {
+        return NULL;
+    }
+
+    // 裁掉未对齐的头尾 / Trim the unaligned head and tail / Nicht ausgerichteten Anfang und Ende abschneiden
+    uintptr_t aligned = ((uintptr_t)raw + POOL_HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(POOL_HUGE_PAGE_SIZE - 1);
+    size_t head = (size_t)(aligned - (uintptr_t)raw);
+    size_t tail = mapped_size - head - size;
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (tail > 0) {
+        munmap((unsigned char*)aligned + size, tail);
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (g_pool_config.use_transparent_hugepages) {
+        madvise((void*)aligned, size, MADV_HUGEPAGE);
+    }
+#endif
+    *mapping = (void*)aligned;
+    return (void*)aligned;
+#endif
+}
+
+/**
+ * @brief 解除内存块映射 / Unmap memory block / Speicherblock-Abbildung aufheben
+ */
+static void unmap_block(pool_block_t* block) {
+#ifdef _WIN32
+    VirtualFree(block->mapping, 0, MEM_RELEASE);
+#else
+    munmap(block->mapping, block->size);
+#endif
+}
+
+/**
+ * @brief 首次访问线程函数 / First-touch thread function / Erstzugriffs-Thread-Funktion
+ */
+static void touch_worker(void* arg) {
+    touch_task_t* task = (touch_task_t*)arg;
+    memset(task->start, 0, task->length);
+}
+
+/**
+ * @brief 并行首次访问新映射 / First-touch fresh mapping in parallel / Neue Abbildung parallel erstmals berühren
+ * @details 每个线程访问一段连续分片，默认本地分配策略会把分片放在该线程所在的NUMA节点上 / Each thread touches one contiguous slice, so the default local allocation policy places the slice on that thread's NUMA node / Jeder Thread berührt einen zusammenhängenden Abschnitt, sodass die standardmäßige lokale Zuweisungsrichtlinie ihn auf dem NUMA-Knoten dieses Threads platziert
+ */
+static void first_touch(void* base, size_t size) {
+    size_t thread_count = g_pool_config.touch_threads != 0 ? g_pool_config.touch_threads : nxld_thread_cpu_count();
+    size_t max_by_size = size / POOL_HUGE_PAGE_SIZE;
+    if (thread_count > max_by_size) {
+        thread_count = max_by_size;
+    }
+    if (thread_count > POOL_MAX_TOUCH_THREADS) {
+        thread_count = POOL_MAX_TOUCH_THREADS;
+    }
+    if (thread_count <= 1) {
+        memset(base, 0, size);
+        return;
+    }
+
+    touch_task_t tasks[POOL_MAX_TOUCH_THREADS];
+    nxld_thread_t threads[POOL_MAX_TOUCH_THREADS];
+    int started[POOL_MAX_TOUCH_THREADS];
+    size_t pages = size / POOL_HUGE_PAGE_SIZE;
+    size_t offset = 0;
+
+    for (size_t i = 0; i < thread_count; i++) {
+        size_t slice_pages = pages / thread_count + (i < pages % thread_count ? 1 : 0);
+        tasks[i].start = (unsigned char*)base + offset;
+        tasks[i].length = slice_pages * POOL_HUGE_PAGE_SIZE;
+        offset += tasks[i].length;
+        started[i] = (i > 0 && nxld_thread_create(&threads[i], touch_worker, &tasks[i]) == 0);
+    }
+
+    // 当前线程处理第一个分片及启动失败的分片 / The calling thread handles the first slice and any slice whose thread failed to start / Der aufrufende Thread bearbeitet den ersten Abschnitt und Abschnitte, deren Thread nicht starten konnte
+    for (size_t i = 0; i < thread_count; i++) {
+        if (!started[i]) {
+            touch_worker(&tasks[i]);
+        }
+    }
+    for (size_t i = 1; i < thread_count; i++) {
+        if (started[i]) {
+            nxld_thread_join(threads[i]);
+        }
+    }
+}
+
+/**
+ * @brief 在缓存超限时释放空闲块（需持有锁） / Release free blocks while the cache exceeds its limit (lock held) / Freie Blöcke freigeben, solange der Cache sein Limit überschreitet (Sperre gehalten)
+ */
+static void trim_cache_locked(void) {
+    while (g_pool_stats.cached_bytes > g_pool_config.max_cached_bytes) {
+        pool_block_t** largest = NULL;
+        for (pool_block_t** link = &g_pool_blocks; *link != NULL; link = &(*link)->next) {
+            if (!(*link)->in_use && (largest == NULL || (*link)->size > (*largest)->size)) {
+                largest = link;
+            }
+        }
+        if (largest == NULL) {
+            break;
+        }
+
+        pool_block_t* block = *largest;
+        *largest = block->next;
+        g_pool_stats.cached_bytes -= block->size;
+        g_pool_stats.mapped_bytes -= block->size;
+        unmap_block(block);
+        free(block);
+    }
+}
+
+void nxld_buffer_pool_default_config(nxld_buffer_pool_config_t* config) {
+    if (config == NULL) {
+        return;
+    }
+    config->max_cached_bytes = POOL_DEFAULT_MAX_CACHED_BYTES;
+    config->touch_threads = 0;
+    config->use_hugetlb = 1;
+    config->use_transparent_hugepages = 1;
+}
+
+int nxld_buffer_pool_init(const nxld_buffer_pool_config_t* config) {
+    if (g_pool_initialized) {
+        return 0;
+    }
+
+    if (config != NULL) {
+        g_pool_config = *config;
+    } else {
+        nxld_buffer_pool_default_config(&g_pool_config);
+    }
+
+    g_pool_hugetlb = g_pool_config.use_hugetlb;
+    nxld_mutex_init(&g_pool_mutex);
+    memset(&g_pool_stats, 0, sizeof(g_pool_stats));
+    g_pool_blocks = NULL;
+    g_pool_initialized = 1;
+    return 0;
+}
+
+void nxld_buffer_pool_shutdown(void) {
+    if (!g_pool_initialized) {
+        return;
+    }
+
+    nxld_mutex_lock(&g_pool_mutex);
+    pool_block_t* block = g_pool_blocks;
+    size_t leaked = 0;
+    while (block != NULL) {
+        pool_block_t* next = block->next;
+        if (block->in_use) {
+            leaked++;
+        }
+        unmap_block(block);
+        free(block);
+        block = next;
+    }
+    g_pool_blocks = NULL;
+    nxld_mutex_unlock(&g_pool_mutex);
+
+    if (leaked > 0) {
+        nxld_log_warning("Buffer pool shut down with %zu blocks still in use", leaked);
+    }
+
+    nxld_mutex_destroy(&g_pool_mutex);
+    g_pool_initialized = 0;
+}
+
+void* nxld_buffer_pool_alloc(size_t size, size_t alignment) {
+    if (!g_pool_initialized || size == 0) {
+        return NULL;
+    }
+    if (alignment > POOL_HUGE_PAGE_SIZE || (alignment & (alignment - 1)) != 0) {
+        nxld_log_error("Unsupported buffer pool alignment: %zu", alignment);
+        return NULL;
+    }
+
+    size_t rounded = round_to_huge_page(size);
+    if (rounded < size) {
+        return NULL;
+    }
+
+    // 复用不超过请求两倍大小的最小空闲块 / Reuse the smallest free block no larger than twice the request / Kleinsten freien Block bis zur doppelten Anforderungsgröße wiederverwenden
+    nxld_mutex_lock(&g_pool_mutex);
+    pool_block_t* best = NULL;
+    for (pool_block_t* block = g_pool_blocks; block != NULL; block = block->next) {
+        if (!block->in_use && block->size >= rounded && block->size / 2 <= rounded &&
+            (best == NULL || block->size < best->size)) {
+            best = block;
+        }
+    }
+    if (best != NULL) {
+        best->in_use = 1;
+        g_pool_stats.cached_bytes -= best->size;
+        g_pool_stats.allocations++;
+        g_pool_stats.reuses++;
+        nxld_mutex_unlock(&g_pool_mutex);
+        return best->base;
+    }
+    nxld_mutex_unlock(&g_pool_mutex);
+
+    pool_block_t* block = (pool_block_t*)malloc(sizeof(pool_block_t));
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->base = map_block(rounded, &block->mapping);
+    if (block->base == NULL) {
+        nxld_log_error("Failed to map %zu bytes for buffer pool", rounded);
+        free(block);
+        return NULL;
+    }
+    block->size = rounded;
+    block->in_use = 1;
+
+    first_touch(block->base, block->size);
+
+    nxld_mutex_lock(&g_pool_mutex);
+    block->next = g_pool_blocks;
+    g_pool_blocks = block;
+    g_pool_stats.mapped_bytes += block->size;
+    g_pool_stats.allocations++;
+    nxld_mutex_unlock(&g_pool_mutex);
+    return block->base;
+}
+
+void nxld_buffer_pool_free(void* ptr) {
+    if (ptr == NULL || !g_pool_initialized) {
+        return;
+    }
+
+    nxld_mutex_lock(&g_pool_mutex);
+    pool_block_t* block = g_pool_blocks;
+    while (block != NULL && block->base != ptr) {
+        block = block->next;
+    }
+
+    if (block == NULL || !block->in_use) {
+        nxld_mutex_unlock(&g_pool_mutex);
+        nxld_log_warning("Buffer pool free of unknown or already freed pointer %p", ptr);
+        return;
+    }
+
+    block->in_use = 0;
+    g_pool_stats.cached_bytes += block->size;
+    trim_cache_locked();
+    nxld_mutex_unlock(&g_pool_mutex);
+}
+
+/**
+ * @brief 池化缓冲区释放回调 / Pooled buffer release callback / Freigabe-Callback für gepoolte Puffer
+ */
+static void pool_buffer_release(void* owner, void* data) {
+    (void)owner;
+    nxld_buffer_pool_free(data);
+}
+
+int nxld_buffer_pool_alloc_buffer(nxld_buffer_t* buffer, size_t count, nxld_param_type_t element_type, size_t element_size) {
+    if (buffer == NULL || count == 0 || element_size == 0 || count > SIZE_MAX / element_size) {
+        return -1;
+    }
+
+    void* data = nxld_buffer_pool_alloc(count * element_size, POOL_HUGE_PAGE_SIZE);
+    if (data == NULL) {
+        return -1;
+    }
+
+    buffer->data = data;
+    buffer->count = count;
+    buffer->element_type = element_type;
+    buffer->element_size = element_size;
+    buffer->alignment = POOL_HUGE_PAGE_SIZE;
+    buffer->owner = NULL;
+    buffer->release = pool_buffer_release;
+    return 0;
+}
+
+void nxld_buffer_pool_get_stats(nxld_buffer_pool_stats_t* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (!g_pool_initialized) {
+        memset(stats, 0, sizeof(nxld_buffer_pool_stats_t));
+        return;
+    }
+
+    nxld_mutex_lock(&g_pool_mutex);
+    *stats = g_pool_stats;
+    nxld_mutex_unlock(&g_pool_mutex);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file nxld_buffer_pool.h
+ * @brief NXLD大缓冲区池接口 / NXLD Large Buffer Pool Interface / NXLD-Großpufferpool-Schnittstelle
+ * @details 引擎持有的可复用大块内存池，通过主机服务表提供给插件 / Engine-owned reusable pool of large memory blocks, offered to plugins through the host services table / Engine-eigener wiederverwendbarer Pool großer Speicherblöcke, Plugins über die Host-Dienst-Tabelle angeboten
+ */
+
+#ifndef NXLD_BUFFER_POOL_H
+#define NXLD_BUFFER_POOL_H
+
+#include <stddef.h>
+#include "nxld_plugin_interface.h"
+
+/**
+ * @brief 缓冲池配置结构体 / Buffer pool configuration structure / Pufferpool-Konfigurationsstruktur
+ */
+typedef struct {
+    size_t max_cached_bytes;                /**< 空闲块缓存上限（字节） / Upper bound for cached free blocks in bytes / Obergrenze für zwischengespeicherte freie Blöcke in Bytes */
+    size_t touch_threads;                   /**< 首次访问线程数（0表示CPU数量） / First-touch thread count (0 for CPU count) / Anzahl der Erstzugriffs-Threads (0 für CPU-Anzahl) */
+    int use_hugetlb;                        /**< 优先尝试hugetlbfs大页 / Try hugetlbfs huge pages first / Zuerst hugetlbfs-Huge-Pages versuchen */
+    int use_transparent_hugepages;          /**< 使用透明大页建议 / Use transparent huge page advice / Transparent-Huge-Page-Hinweis verwenden */
+} nxld_buffer_pool_config_t;
+
+/**
+ * @brief 缓冲池统计结构体 / Buffer pool statistics structure / Pufferpool-Statistikstruktur
+ */
+typedef struct {
+    size_t mapped_bytes;                    /**< 已映射字节数 / Mapped bytes / Abgebildete Bytes */
+    size_t cached_bytes;                    /**< 空闲缓存字节数 / Cached free bytes / Zwischengespeicherte freie Bytes */
+    size_t allocations;                     /**< 分配次数 / Allocation count / Anzahl der Zuweisungen */
+    size_t reuses;                          /**< 复用缓存块次数 / Cached block reuse count / Anzahl der Wiederverwendungen */
+} nxld_buffer_pool_stats_t;
+
+/**
+ * @brief 获取默认缓冲池配置 / Get default buffer pool configuration / Standard-Pufferpool-Konfiguration abrufen
+ * @param config 输出配置指针 / Output configuration pointer / Ausgabe-Konfigurationszeiger
+ */
+void nxld_buffer_pool_default_config(nxld_buffer_pool_config_t* config);
+
+/**
+ * @brief 初始化缓冲池 / Initialize buffer pool / Pufferpool initialisieren
+ * @param config 配置指针（NULL表示默认配置） / Configuration pointer (NULL for defaults) / Konfigurationszeiger (NULL für Standardwerte)
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_buffer_pool_init(const nxld_buffer_pool_config_t* config);
+
+/**
+ * @brief 关闭缓冲池并释放所有映射 / Shut down buffer pool and release all mappings / Pufferpool herunterfahren und alle Abbildungen freigeben
+ */
+void nxld_buffer_pool_shutdown(void);
+
+/**
+ * @brief 分配大块内存 / Allocate large block / Großen Block zuweisen
+ * @param size 请求大小（字节） / Requested size in bytes / Angeforderte Größe in Bytes
+ * @param alignment 对齐要求（最大2MB） / Alignment requirement (at most 2 MB) / Ausrichtungsanforderung (höchstens 2 MB)
+ * @return 内存指针，失败返回NULL / Memory pointer, NULL on failure / Speicherzeiger, NULL bei Fehler
+ * @details 新映射的内存由多个线程并行首次访问并清零；复用的块内容未定义 / Fresh mappings are first-touched and zeroed by several threads in parallel; contents of reused blocks are undefined / Neue Abbildungen werden von mehreren Threads parallel erstmals berührt und genullt; Inhalt wiederverwendeter Blöcke ist undefiniert
+ */
+void* nxld_buffer_pool_alloc(size_t size, size_t alignment);
+
+/**
+ * @brief 归还大块内存 / Return large block / Großen Block zurückgeben
+ * @param ptr 由nxld_buffer_pool_alloc返回的指针 / Pointer returned by nxld_buffer_pool_alloc / Von nxld_buffer_pool_alloc zurückgegebener Zeiger
+ */
+void nxld_buffer_pool_free(void* ptr);
+
+/**
+ * @brief 分配池化缓冲区描述符 / Allocate pooled buffer descriptor / Gepoolten Pufferdeskriptor zuweisen
+ * @param buffer 输出缓冲区描述符 / Output buffer descriptor / Ausgabe-Pufferdeskriptor
+ * @param count 元素数量 / Element count / Elementanzahl
+ * @param element_type 元素类型 / Element type / Elementtyp
+ * @param element_size 元素大小（字节） / Element size in bytes / Elementgröße in Bytes
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_buffer_pool_alloc_buffer(nxld_buffer_t* buffer, size_t count, nxld_param_type_t element_type, size_t element_size);
+
+/**
+ * @brief 获取缓冲池统计 / Get buffer pool statistics / Pufferpool-Statistik abrufen
+ * @param stats 输出统计指针 / Output statistics pointer / Ausgabe-Statistikzeiger
+ */
+void nxld_buffer_pool_get_stats(nxld_buffer_pool_stats_t* stats);
+
+#endif /* NXLD_BUFFER_POOL_H */
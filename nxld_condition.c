@@ -0,0 +1,335 @@
+/**
+ * @file nxld_condition.c
+ * @brief NXLD传递条件谓词实现 / NXLD Transfer Condition Predicate Implementation / NXLD-Übertragungsbedingungs-Prädikat-Implementierung
+ */
+
+#include "nxld_condition.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * @brief 编译器状态结构体 / Compiler state structure / Compiler-Zustandsstruktur
+ */
+typedef struct {
+    const char* text;                       /**< 条件字符串 / Condition string / Bedingungszeichenfolge */
+    const char* pos;                        /**< 当前位置 / Current position / Aktuelle Position */
+    nxld_condition_t* condition;            /**< 输出谓词 / Output predicate / Ausgabeprädikat */
+    int depth;                              /**< 当前栈深度 / Current stack depth / Aktuelle Stapeltiefe */
+    const char* error;                      /**< 错误说明 / Error description / Fehlerbeschreibung */
+} condition_parser_t;
+
+static int parse_or(condition_parser_t* parser);
+
+/**
+ * @brief 跳过空白 / Skip whitespace / Leerzeichen überspringen
+ */
+static void skip_space(condition_parser_t* parser) {
+    while (isspace((unsigned char)*parser->pos)) {
+        parser->pos++;
+    }
+}
+
+/**
+ * @brief 匹配符号 / Match symbol / Symbol abgleichen
+ */
+static int match_symbol(condition_parser_t* parser, const char* symbol) {
+    size_t len = strlen(symbol);
+    skip_space(parser);
+    if (strncmp(parser->pos, symbol, len) == 0) {
+        parser->pos += len;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 匹配关键字（不区分大小写，须完整单词） / Match keyword (case-insensitive, whole word) / Schlüsselwort abgleichen (Groß-/Kleinschreibung egal, ganzes Wort)
+ */
+static int match_keyword(condition_parser_t* parser, const char* keyword) {
+    size_t len = strlen(keyword);
+    skip_space(parser);
+    for (size_t i = 0; i < len; i++) {
+        if (tolower((unsigned char)parser->pos[i]) != keyword[i]) {
+            return 0;
+        }
+    }
+    char next = parser->pos[len];
+    if (isalnum((unsigned char)next) || next == '_') {
+        return 0;
+    }
+    parser->pos += len;
+    return 1;
+}
+
+/**
+ * @brief 追加指令并跟踪栈深度 / Append instruction and track stack depth / Befehl anhängen und Stapeltiefe verfolgen
+ */
+static int emit(condition_parser_t* parser, nxld_condition_op_t op, nxld_condition_cmp_t cmp, long long a, long long b) {
+    nxld_condition_t* condition = parser->condition;
+    if (condition->op_count >= NXLD_CONDITION_MAX_OPS) {
+        parser->error = "too many operations";
+        return -1;
+    }
+
+    if (op == NXLD_CONDITION_OP_AND || op == NXLD_CONDITION_OP_OR) {
+        parser->depth--;
+    } else if (op != NXLD_CONDITION_OP_NOT) {
+        if (++parser->depth > NXLD_CONDITION_MAX_DEPTH) {
+            parser->error = "expression nested too deeply";
+            return -1;
+        }
+    }
+
+    nxld_condition_instr_t* instr = &condition->ops[condition->op_count++];
+    instr->op = (unsigned char)op;
+    instr->cmp = (unsigned char)cmp;
+    instr->a = a;
+    instr->b = b;
+    return 0;
+}
+
+/**
+ * @brief 解析整数 / Parse integer / Ganzzahl analysieren
+ */
+static int parse_number(condition_parser_t* parser, long long* value) {
+    skip_space(parser);
+    char* end = NULL;
+    *value = strtoll(parser->pos, &end, 0);
+    if (end == parser->pos) {
+        parser->error = "number expected";
+        return -1;
+    }
+    parser->pos = end;
+    return 0;
+}
+
+/**
+ * @brief 解析比较运算符 / Parse comparison operator / Vergleichsoperator analysieren
+ */
+static int parse_cmp(condition_parser_t* parser, nxld_condition_cmp_t* cmp) {
+    if (match_symbol(parser, "==")) {
+        *cmp = NXLD_CONDITION_CMP_EQ;
+    } else if (match_symbol(parser, "!=")) {
+        *cmp = NXLD_CONDITION_CMP_NE;
+    } else if (match_symbol(parser, "<=")) {
+        *cmp = NXLD_CONDITION_CMP_LE;
+    } else if (match_symbol(parser, ">=")) {
+        *cmp = NXLD_CONDITION_CMP_GE;
+    } else if (match_symbol(parser, "<")) {
+        *cmp = NXLD_CONDITION_CMP_LT;
+    } else if (match_symbol(parser, ">")) {
+        *cmp = NXLD_CONDITION_CMP_GT;
+    } else {
+        parser->error = "comparison operator expected";
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 解析数值或长度比较 / Parse value or length comparison / Wert- oder Längenvergleich analysieren
+ */
+static int parse_comparison(condition_parser_t* parser, int is_length) {
+    long long a = 0;
+    long long b = 0;
+
+    if (is_length) {
+        parser->condition->needs_length = 1;
+    } else {
+        parser->condition->needs_value = 1;
+    }
+
+    if (match_keyword(parser, "in")) {
+        if (!match_symbol(parser, "[") || parse_number(parser, &a) != 0 || !match_symbol(parser, ",") ||
+            parse_number(parser, &b) != 0 || !match_symbol(parser, "]")) {
+            if (parser->error == NULL) {
+                parser->error = "range must look like [low, high]";
+            }
+            return -1;
+        }
+        return emit(parser, is_length ? NXLD_CONDITION_OP_RANGE_LENGTH : NXLD_CONDITION_OP_RANGE_VALUE,
+                    NXLD_CONDITION_CMP_EQ, a, b);
+    }
+
+    nxld_condition_cmp_t cmp;
+    if (parse_cmp(parser, &cmp) != 0 || parse_number(parser, &a) != 0) {
+        return -1;
+    }
+    return emit(parser, is_length ? NXLD_CONDITION_OP_CMP_LENGTH : NXLD_CONDITION_OP_CMP_VALUE, cmp, a, 0);
+}
+
+/**
+ * @brief 解析一元表达式 / Parse unary expression / Unären Ausdruck analysieren
+ */
+static int parse_unary(condition_parser_t* parser) {
+    if (match_symbol(parser, "!") || match_keyword(parser, "not")) {
+        if (parse_unary(parser) != 0) {
+            return -1;
+        }
+        return emit(parser, NXLD_CONDITION_OP_NOT, NXLD_CONDITION_CMP_EQ, 0, 0);
+    }
+
+    if (match_symbol(parser, "(")) {
+        if (parse_or(parser) != 0) {
+            return -1;
+        }
+        if (!match_symbol(parser, ")")) {
+            parser->error = "')' expected";
+            return -1;
+        }
+        return 0;
+    }
+
+    if (match_keyword(parser, "not_null") || match_keyword(parser, "notnull")) {
+        return emit(parser, NXLD_CONDITION_OP_NOT_NULL, NXLD_CONDITION_CMP_EQ, 0, 0);
+    }
+    if (match_keyword(parser, "null")) {
+        if (emit(parser, NXLD_CONDITION_OP_NOT_NULL, NXLD_CONDITION_CMP_EQ, 0, 0) != 0) {
+            return -1;
+        }
+        return emit(parser, NXLD_CONDITION_OP_NOT, NXLD_CONDITION_CMP_EQ, 0, 0);
+    }
+    if (match_keyword(parser, "not_empty")) {
+        parser->condition->needs_length = 1;
+        if (emit(parser, NXLD_CONDITION_OP_EMPTY, NXLD_CONDITION_CMP_EQ, 0, 0) != 0) {
+            return -1;
+        }
+        return emit(parser, NXLD_CONDITION_OP_NOT, NXLD_CONDITION_CMP_EQ, 0, 0);
+    }
+    if (match_keyword(parser, "empty")) {
+        parser->condition->needs_length = 1;
+        return emit(parser, NXLD_CONDITION_OP_EMPTY, NXLD_CONDITION_CMP_EQ, 0, 0);
+    }
+    if (match_keyword(parser, "value")) {
+        return parse_comparison(parser, 0);
+    }
+    if (match_keyword(parser, "len") || match_keyword(parser, "length")) {
+        return parse_comparison(parser, 1);
+    }
+
+    parser->error = "unknown predicate";
+    return -1;
+}
+
+/**
+ * @brief 解析与表达式 / Parse and expression / Und-Ausdruck analysieren
+ */
+static int parse_and(condition_parser_t* parser) {
+    if (parse_unary(parser) != 0) {
+        return -1;
+    }
+    while (match_symbol(parser, "&&") || match_keyword(parser, "and")) {
+        if (parse_unary(parser) != 0 || emit(parser, NXLD_CONDITION_OP_AND, NXLD_CONDITION_CMP_EQ, 0, 0) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 解析或表达式 / Parse or expression / Oder-Ausdruck analysieren
+ */
+static int parse_or(condition_parser_t* parser) {
+    if (parse_and(parser) != 0) {
+        return -1;
+    }
+    while (match_symbol(parser, "||") || match_keyword(parser, "or")) {
+        if (parse_and(parser) != 0 || emit(parser, NXLD_CONDITION_OP_OR, NXLD_CONDITION_CMP_EQ, 0, 0) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int nxld_condition_compile(const char* text, nxld_condition_t* condition, char* error, size_t error_size) {
+    if (text == NULL || condition == NULL) {
+        return -1;
+    }
+
+    memset(condition, 0, sizeof(nxld_condition_t));
+
+    condition_parser_t parser;
+    parser.text = text;
+    parser.pos = text;
+    parser.condition = condition;
+    parser.depth = 0;
+    parser.error = NULL;
+
+    int result = parse_or(&parser);
+    skip_space(&parser);
+    if (result == 0 && *parser.pos != '\0') {
+        parser.error = "unexpected trailing text";
+        result = -1;
+    }
+
+    if (result != 0) {
+        if (error != NULL && error_size > 0) {
+            snprintf(error, error_size, "%s at offset %d", parser.error != NULL ? parser.error : "syntax error",
+                     (int)(parser.pos - parser.text));
+        }
+        memset(condition, 0, sizeof(nxld_condition_t));
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 比较两个整数 / Compare two integers / Zwei Ganzzahlen vergleichen
+ */
+static int compare(nxld_condition_cmp_t cmp, long long left, long long right) {
+    switch (cmp) {
+        case NXLD_CONDITION_CMP_EQ: return left == right;
+        case NXLD_CONDITION_CMP_NE: return left != right;
+        case NXLD_CONDITION_CMP_LT: return left < right;
+        case NXLD_CONDITION_CMP_LE: return left <= right;
+        case NXLD_CONDITION_CMP_GT: return left > right;
+        case NXLD_CONDITION_CMP_GE: return left >= right;
+        default: return 0;
+    }
+}
+
+int nxld_condition_eval(const nxld_condition_t* condition, const nxld_condition_operand_t* operand) {
+    unsigned char stack[NXLD_CONDITION_MAX_DEPTH];
+    int sp = 0;
+
+    for (unsigned char i = 0; i < condition->op_count; i++) {
+        const nxld_condition_instr_t* instr = &condition->ops[i];
+        switch (instr->op) {
+            case NXLD_CONDITION_OP_NOT_NULL:
+                stack[sp++] = operand->pointer != NULL;
+                break;
+            case NXLD_CONDITION_OP_EMPTY:
+                stack[sp++] = operand->pointer == NULL || operand->length == 0;
+                break;
+            case NXLD_CONDITION_OP_CMP_VALUE:
+                stack[sp++] = (unsigned char)compare((nxld_condition_cmp_t)instr->cmp, operand->value, instr->a);
+                break;
+            case NXLD_CONDITION_OP_CMP_LENGTH:
+                stack[sp++] = (unsigned char)compare((nxld_condition_cmp_t)instr->cmp, (long long)operand->length, instr->a);
+                break;
+            case NXLD_CONDITION_OP_RANGE_VALUE:
+                stack[sp++] = operand->value >= instr->a && operand->value <= instr->b;
+                break;
+            case NXLD_CONDITION_OP_RANGE_LENGTH:
+                stack[sp++] = (long long)operand->length >= instr->a && (long long)operand->length <= instr->b;
+                break;
+            case NXLD_CONDITION_OP_AND:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] && stack[sp];
+                break;
+            case NXLD_CONDITION_OP_OR:
+                sp--;
+                stack[sp - 1] = stack[sp - 1] || stack[sp];
+                break;
+            case NXLD_CONDITION_OP_NOT:
+                stack[sp - 1] = !stack[sp - 1];
+                break;
+            default:
+                return 0;
+        }
+    }
+
+    return sp > 0 ? stack[sp - 1] : 1;
+}
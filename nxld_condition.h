@@ -0,0 +1,98 @@
+/**
+ * @file nxld_condition.h
+ * @brief NXLD传递条件谓词接口 / NXLD Transfer Condition Predicate Interface / NXLD-Übertragungsbedingungs-Prädikat-Schnittstelle
+ * @details 在加载规则时将Condition字符串编译为小型后缀字节码 / Compiles Condition strings into a small postfix bytecode when rules are loaded / Kompiliert Condition-Zeichenfolgen beim Laden der Regeln in einen kleinen Postfix-Bytecode
+ *
+ * 语法 / Syntax / Syntax:
+ *   expr    := and ( ("||" | "or") and )*
+ *   and     := unary ( ("&&" | "and") unary )*
+ *   unary   := ("!" | "not") unary | "(" expr ")" | atom
+ *   atom    := "not_null" | "null" | "empty" | "not_empty"
+ *            | ("value" | "len") cmp NUMBER
+ *            | ("value" | "len") "in" "[" NUMBER "," NUMBER "]"
+ *   cmp     := "==" | "!=" | "<" | "<=" | ">" | ">="
+ */
+
+#ifndef NXLD_CONDITION_H
+#define NXLD_CONDITION_H
+
+#include <stddef.h>
+
+#define NXLD_CONDITION_MAX_OPS 32
+#define NXLD_CONDITION_MAX_DEPTH 16
+
+/**
+ * @brief 谓词指令枚举 / Predicate instruction enumeration / Prädikat-Befehls-Aufzählung
+ */
+typedef enum {
+    NXLD_CONDITION_OP_NOT_NULL = 0,        /**< 指针非空 / Pointer is not null / Zeiger ist nicht null */
+    NXLD_CONDITION_OP_EMPTY,               /**< 指针为空或长度为0 / Pointer is null or length is 0 / Zeiger ist null oder Länge ist 0 */
+    NXLD_CONDITION_OP_CMP_VALUE,           /**< 比较数值 / Compare numeric value / Numerischen Wert vergleichen */
+    NXLD_CONDITION_OP_CMP_LENGTH,          /**< 比较长度 / Compare length / Länge vergleichen */
+    NXLD_CONDITION_OP_RANGE_VALUE,         /**< 数值在闭区间内 / Value within closed range / Wert im geschlossenen Bereich */
+    NXLD_CONDITION_OP_RANGE_LENGTH,        /**< 长度在闭区间内 / Length within closed range / Länge im geschlossenen Bereich */
+    NXLD_CONDITION_OP_AND,                 /**< 逻辑与 / Logical and / Logisches Und */
+    NXLD_CONDITION_OP_OR,                  /**< 逻辑或 / Logical or / Logisches Oder */
+    NXLD_CONDITION_OP_NOT                  /**< 逻辑非 / Logical not / Logisches Nicht */
+} nxld_condition_op_t;
+
+/**
+ * @brief 比较运算符枚举 / Comparison operator enumeration / Vergleichsoperator-Aufzählung
+ */
+typedef enum {
+    NXLD_CONDITION_CMP_EQ = 0,             /**< 等于 / Equal / Gleich */
+    NXLD_CONDITION_CMP_NE,                 /**< 不等于 / Not equal / Ungleich */
+    NXLD_CONDITION_CMP_LT,                 /**< 小于 / Less than / Kleiner als */
+    NXLD_CONDITION_CMP_LE,                 /**< 小于等于 / Less or equal / Kleiner oder gleich */
+    NXLD_CONDITION_CMP_GT,                 /**< 大于 / Greater than / Größer als */
+    NXLD_CONDITION_CMP_GE                  /**< 大于等于 / Greater or equal / Größer oder gleich */
+} nxld_condition_cmp_t;
+
+/**
+ * @brief 谓词指令结构体 / Predicate instruction structure / Prädikat-Befehlsstruktur
+ */
+typedef struct {
+    unsigned char op;                       /**< 指令（nxld_condition_op_t） / Instruction (nxld_condition_op_t) / Befehl (nxld_condition_op_t) */
+    unsigned char cmp;                      /**< 比较运算符（nxld_condition_cmp_t） / Comparison operator (nxld_condition_cmp_t) / Vergleichsoperator (nxld_condition_cmp_t) */
+    long long a;                            /**< 比较常量或区间下界 / Comparison constant or range lower bound / Vergleichskonstante oder untere Bereichsgrenze */
+    long long b;                            /**< 区间上界 / Range upper bound / Obere Bereichsgrenze */
+} nxld_condition_instr_t;
+
+/**
+ * @brief 已编译谓词结构体 / Compiled predicate structure / Kompilierte Prädikatstruktur
+ */
+typedef struct {
+    nxld_condition_instr_t ops[NXLD_CONDITION_MAX_OPS];  /**< 后缀指令序列 / Postfix instruction sequence / Postfix-Befehlsfolge */
+    unsigned char op_count;                 /**< 指令数量 / Instruction count / Befehlsanzahl */
+    unsigned char needs_value;              /**< 是否需要数值操作数 / Whether a numeric operand is needed / Ob ein numerischer Operand benötigt wird */
+    unsigned char needs_length;             /**< 是否需要长度操作数 / Whether a length operand is needed / Ob ein Längenoperand benötigt wird */
+} nxld_condition_t;
+
+/**
+ * @brief 谓词操作数结构体 / Predicate operand structure / Prädikat-Operandenstruktur
+ */
+typedef struct {
+    const void* pointer;                    /**< 指针值 / Pointer value / Zeigerwert */
+    long long value;                        /**< 数值（needs_value时有效） / Numeric value (valid if needs_value) / Numerischer Wert (gültig bei needs_value) */
+    size_t length;                          /**< 长度（needs_length时有效） / Length (valid if needs_length) / Länge (gültig bei needs_length) */
+} nxld_condition_operand_t;
+
+/**
+ * @brief 编译条件字符串 / Compile condition string / Bedingungszeichenfolge kompilieren
+ * @param text 条件字符串 / Condition string / Bedingungszeichenfolge
+ * @param condition 输出已编译谓词 / Output compiled predicate / Ausgabe des kompilierten Prädikats
+ * @param error 输出错误位置说明（可为NULL） / Output error description (may be NULL) / Ausgabe der Fehlerbeschreibung (kann NULL sein)
+ * @param error_size 错误缓冲区大小 / Error buffer size / Fehlerpuffergröße
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_condition_compile(const char* text, nxld_condition_t* condition, char* error, size_t error_size);
+
+/**
+ * @brief 计算已编译谓词 / Evaluate compiled predicate / Kompiliertes Prädikat auswerten
+ * @param condition 已编译谓词 / Compiled predicate / Kompiliertes Prädikat
+ * @param operand 操作数 / Operand / Operand
+ * @return 满足返回1，否则返回0 / Returns 1 if satisfied, 0 otherwise / Gibt 1 zurück, wenn erfüllt, sonst 0
+ */
+int nxld_condition_eval(const nxld_condition_t* condition, const nxld_condition_operand_t* operand);
+
+#endif /* NXLD_CONDITION_H */
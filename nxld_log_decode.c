@@ -0,0 +1,404 @@
+/**
+ * @file nxld_log_decode.c
+ * @brief NXLD二进制日志解码工具 / NXLD Binary Log Decoder Tool / NXLD-Werkzeug zum Dekodieren binärer Protokolle
+ * @details 把二进制编码的日志文件还原为与文本编码相同的行；压缩的日志段（.lz4）先解压，其中的文本日志原样输出 / Turns a binary-encoded log file back into the same lines the text encoding writes; compressed log segments (.lz4) are decompressed first and text logs inside them are written as is / Wandelt eine binär kodierte Protokolldatei in dieselben Zeilen zurück, die die Textkodierung schreibt; komprimierte Protokollsegmente (.lz4) werden zuerst dekomprimiert und darin enthaltene Textprotokolle unverändert ausgegeben
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_logger.h"
+#include "nxld_lz.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+
+static const char* const g_level_names[] = {"ERROR", "WARNING", "INFO", "DEBUG"};
+
+/**
+ * @brief 会话状态结构体 / Session state structure / Sitzungszustandsstruktur
+ */
+typedef struct {
+    uint64_t wall_ns;                       /**< 会话开始时的墙钟时间 / Wall clock at session start / Wanduhrzeit beim Sitzungsstart */
+    uint64_t monotonic_ns;                  /**< 会话开始时的单调计数 / Monotonic counter at session start / Monotoner Zähler beim Sitzungsstart */
+    const char** formats;                   /**< 按编号索引的格式字符串（指向文件数据） / Format strings indexed by id (pointing into the file data) / Nach ID indizierte Formatzeichenfolgen (zeigen in die Dateidaten) */
+    size_t* format_lengths;                 /**< 格式字符串长度 / Format string lengths / Längen der Formatzeichenfolgen */
+    size_t format_capacity;                 /**< 格式数组容量 / Format array capacity / Kapazität des Format-Arrays */
+} decode_session_t;
+
+/**
+ * @brief 读取整个文件 / Read whole file / Ganze Datei lesen
+ */
+static unsigned char* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    unsigned char* data = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        if (length >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+            data = (unsigned char*)malloc((size_t)length + 1);
+            if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+                free(data);
+                data = NULL;
+            }
+            *size = (size_t)length;
+        }
+    }
+    fclose(file);
+    return data;
+}
+
+/**
+ * @brief 记录格式定义 / Store format definition / Formatdefinition speichern
+ */
+static int add_format(decode_session_t* session, uint32_t id, const char* format, size_t length) {
+    if (id >= session->format_capacity) {
+        size_t capacity = session->format_capacity == 0 ? 256 : session->format_capacity;
+        while (capacity <= id) {
+            capacity *= 2;
+        }
+        const char** formats = (const char**)realloc((void*)session->formats, capacity * sizeof(const char*));
+        if (formats == NULL) {
+            return -1;
+        }
+        session->formats = formats;
+        size_t* lengths = (size_t*)realloc(session->format_lengths, capacity * sizeof(size_t));
+        if (lengths == NULL) {
+            return -1;
+        }
+        session->format_lengths = lengths;
+        for (size_t i = session->format_capacity; i < capacity; i++) {
+            session->formats[i] = NULL;
+            session->format_lengths[i] = 0;
+        }
+        session->format_capacity = capacity;
+    }
+    session->formats[id] = format;
+    session->format_lengths[id] = length;
+    return 0;
+}
+
+/**
+ * @brief 写出行前缀（时间戳和级别） / Write line prefix (timestamp and level) / Zeilenpräfix schreiben (Zeitstempel und Ebene)
+ */
+static void write_prefix(FILE* out, const decode_session_t* session, uint64_t timestamp, unsigned int level) {
+    uint64_t wall_ns = session->wall_ns + (timestamp - session->monotonic_ns);
+    time_t seconds = (time_t)(wall_ns / 1000000000ull);
+    struct tm timeinfo;
+#ifdef _WIN32
+    localtime_s(&timeinfo, &seconds);
+#else
+    localtime_r(&seconds, &timeinfo);
+#endif
+    char time_str[24];
+    strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &timeinfo);
+    fprintf(out, "[%s] [%s] ", time_str, level <= NXLD_LOG_LEVEL_DEBUG ? g_level_names[level] : "UNKNOWN");
+}
+
+/**
+ * @brief 读取一个8字节参数 / Read one 8-byte argument / Ein 8-Byte-Argument lesen
+ */
+static int read_word(const unsigned char** p, const unsigned char* end, int64_t* value) {
+    if ((size_t)(end - *p) < sizeof(*value)) {
+        return -1;
+    }
+    memcpy(value, *p, sizeof(*value));
+    *p += sizeof(*value);
+    return 0;
+}
+
+/**
+ * @brief 按格式字符串还原一条消息 / Rebuild one message from its format string / Eine Nachricht anhand ihrer Formatzeichenfolge wiederherstellen
+ * @return 成功返回0，参数字节不足返回-1 / Returns 0 on success, -1 if argument bytes run short / Gibt 0 bei Erfolg zurück, -1 wenn Argumentbytes fehlen
+ */
+static int write_message(FILE* out, const char* format, size_t format_length, const unsigned char* p, const unsigned char* end) {
+    const char* f = format;
+    const char* f_end = format + format_length;
+    while (f < f_end) {
+        if (*f != '%') {
+            fputc(*f++, out);
+            continue;
+        }
+
+        // 格式字符串在记录中不以NUL结尾，复制出转换说明再解析 / Format strings are not NUL-terminated in the record, so copy the specification out before parsing / Formatzeichenfolgen sind im Datensatz nicht NUL-terminiert, daher die Angabe vor dem Parsen herauskopieren
+        char spec[64];
+        size_t available = (size_t)(f_end - f) < sizeof(spec) - 1 ? (size_t)(f_end - f) : sizeof(spec) - 1;
+        memcpy(spec, f, available);
+        spec[available] = '\0';
+        nxld_log_conversion_t conversion;
+        if (nxld_log_scan_conversion(spec, &conversion) != 0 || conversion.length > available) {
+            return -1;
+        }
+        f += conversion.length;
+        if (conversion.arg == NXLD_LOG_ARG_NONE) {
+            fputc('%', out);
+            continue;
+        }
+
+        // 把*替换为记录中的数值，之后只需传一个参数 / Replace each * with the value from the record so only one argument remains / Jedes * durch den Wert aus dem Datensatz ersetzen, damit nur ein Argument übrig bleibt
+        char resolved[96];
+        size_t r = 0;
+        for (size_t i = 0; i < conversion.length && r + 24 < sizeof(resolved); i++) {
+            if (spec[i] == '*') {
+                int64_t star = 0;
+                if (read_word(&p, end, &star) != 0) {
+                    return -1;
+                }
+                r += (size_t)snprintf(resolved + r, sizeof(resolved) - r, "%d", (int)star);
+            } else {
+                resolved[r++] = spec[i];
+            }
+        }
+        resolved[r] = '\0';
+        char type = spec[conversion.length - 1];
+        int is_unsigned = type == 'u' || type == 'o' || type == 'x' || type == 'X';
+
+        if (conversion.arg == NXLD_LOG_ARG_STRING) {
+            uint16_t length = 0;
+            if ((size_t)(end - p) < sizeof(length)) {
+                return -1;
+            }
+            memcpy(&length, p, sizeof(length));
+            p += sizeof(length);
+            if (length == 0xFFFF) {
+                fprintf(out, resolved, "(null)");
+                continue;
+            }
+            if ((size_t)(end - p) < length) {
+                return -1;
+            }
+            char* text = (char*)malloc((size_t)length + 1);
+            if (text == NULL) {
+                return -1;
+            }
+            memcpy(text, p, length);
+            text[length] = '\0';
+            p += length;
+            fprintf(out, resolved, text);
+            free(text);
+            continue;
+        }
+
+        int64_t value = 0;
+        if (read_word(&p, end, &value) != 0) {
+            return -1;
+        }
+        switch (conversion.arg) {
+            case NXLD_LOG_ARG_INT:
+                if (is_unsigned) {
+                    fprintf(out, resolved, (unsigned int)value);
+                } else {
+                    fprintf(out, resolved, (int)value);
+                }
+                break;
+            case NXLD_LOG_ARG_LONG:
+                if (is_unsigned) {
+                    fprintf(out, resolved, (unsigned long)value);
+                } else {
+                    fprintf(out, resolved, (long)value);
+                }
+                break;
+            case NXLD_LOG_ARG_LLONG:
+                if (is_unsigned) {
+                    fprintf(out, resolved, (unsigned long long)value);
+                } else {
+                    fprintf(out, resolved, (long long)value);
+                }
+                break;
+            case NXLD_LOG_ARG_SIZE:
+                fprintf(out, resolved, (size_t)value);
+                break;
+            case NXLD_LOG_ARG_INTMAX:
+                if (is_unsigned) {
+                    fprintf(out, resolved, (uintmax_t)value);
+                } else {
+                    fprintf(out, resolved, (intmax_t)value);
+                }
+                break;
+            case NXLD_LOG_ARG_PTRDIFF:
+                fprintf(out, resolved, (ptrdiff_t)value);
+                break;
+            case NXLD_LOG_ARG_POINTER:
+                fprintf(out, resolved, (void*)(uintptr_t)value);
+                break;
+            case NXLD_LOG_ARG_DOUBLE: {
+                double real;
+                memcpy(&real, &value, sizeof(real));
+                fprintf(out, resolved, real);
+                break;
+            }
+            default:
+                return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 解码一个会话 / Decode one session / Eine Sitzung dekodieren
+ * @param data 会话头之后的数据 / Data after the session header / Daten nach dem Sitzungskopf
+ * @param size 剩余字节数 / Remaining bytes / Verbleibende Bytes
+ * @param consumed 输出会话占用的字节数 / Output bytes taken by the session / Ausgabe der von der Sitzung belegten Bytes
+ * @return 输出的消息数量，数据损坏时返回-1 / Number of messages written, -1 on corrupt data / Anzahl ausgegebener Nachrichten, -1 bei beschädigten Daten
+ * @details 格式定义可能晚于首次使用它的消息写出，因此先收集所有定义再输出 / A format definition may be written after the first message using it, so all definitions are collected before output / Eine Formatdefinition kann nach der ersten sie verwendenden Nachricht geschrieben werden, daher werden zuerst alle Definitionen gesammelt
+ */
+static long decode_session(FILE* out, decode_session_t* session, const unsigned char* data, size_t size, size_t* consumed) {
+    size_t end = 0;
+    while (end + NXLD_LOG_RECORD_HEADER_SIZE <= size && data[end] != (unsigned char)NXLD_LOG_BINARY_MAGIC[0]) {
+        uint16_t length;
+        memcpy(&length, data + end + 2, sizeof(length));
+        if (length < NXLD_LOG_RECORD_HEADER_SIZE || end + length > size) {
+            break;
+        }
+        if (data[end] == NXLD_LOG_RECORD_FORMAT && length >= NXLD_LOG_RECORD_HEADER_SIZE + 4) {
+            uint32_t id;
+            memcpy(&id, data + end + NXLD_LOG_RECORD_HEADER_SIZE, sizeof(id));
+            if (add_format(session, id, (const char*)data + end + NXLD_LOG_RECORD_HEADER_SIZE + 4,
+                           (size_t)length - NXLD_LOG_RECORD_HEADER_SIZE - 4) != 0) {
+                return -1;
+            }
+        }
+        end += length;
+    }
+    *consumed = end;
+
+    long messages = 0;
+    for (size_t offset = 0; offset < end;) {
+        const unsigned char* record = data + offset;
+        uint16_t length;
+        memcpy(&length, record + 2, sizeof(length));
+        const unsigned char* record_end = record + length;
+        uint64_t timestamp;
+        offset += length;
+
+        if (record[0] == NXLD_LOG_RECORD_TEXT && length >= NXLD_LOG_RECORD_HEADER_SIZE + 8) {
+            memcpy(&timestamp, record + NXLD_LOG_RECORD_HEADER_SIZE, sizeof(timestamp));
+            write_prefix(out, session, timestamp, record[1]);
+            fwrite(record + NXLD_LOG_RECORD_HEADER_SIZE + 8, 1, (size_t)length - NXLD_LOG_RECORD_HEADER_SIZE - 8, out);
+            fputc('\n', out);
+            messages++;
+        } else if (record[0] == NXLD_LOG_RECORD_MESSAGE && length >= NXLD_LOG_RECORD_HEADER_SIZE + 12) {
+            uint32_t id;
+            memcpy(&id, record + NXLD_LOG_RECORD_HEADER_SIZE, sizeof(id));
+            memcpy(&timestamp, record + NXLD_LOG_RECORD_HEADER_SIZE + 4, sizeof(timestamp));
+            write_prefix(out, session, timestamp, record[1]);
+            if (id >= session->format_capacity || session->formats[id] == NULL) {
+                fprintf(out, "<unknown format %u>", (unsigned int)id);
+            } else if (write_message(out, session->formats[id], session->format_lengths[id],
+                                     record + NXLD_LOG_RECORD_HEADER_SIZE + 12, record_end) != 0) {
+                fprintf(out, " <truncated record>");
+            }
+            fputc('\n', out);
+            messages++;
+        }
+    }
+    return messages;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <binary log or compressed segment> [output]\n", argv[0]);
+        return 1;
+    }
+
+    size_t size = 0;
+    unsigned char* data = read_file(argv[1], &size);
+    if (data == NULL) {
+        fprintf(stderr, "Failed to read %s\n", argv[1]);
+        return 1;
+    }
+    int status = 0;
+    int compressed = nxld_lz_is_frame(data, size);
+    if (compressed) {
+        int complete = 0;
+        size_t raw_size = 0;
+        unsigned char* raw = nxld_lz_decompress_frame(data, size, &raw_size, &complete);
+        free(data);
+        if (raw == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+        if (!complete) {
+            // 已解压的块仍然输出 / The blocks decompressed so far are still written / Die bisher dekomprimierten Blöcke werden trotzdem ausgegeben
+            fprintf(stderr, "Compressed data in %s is truncated or corrupt after %zu bytes\n", argv[1], raw_size);
+            status = 1;
+        }
+        data = raw;
+        size = raw_size;
+    }
+    FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (out == NULL) {
+        fprintf(stderr, "Failed to open %s\n", argv[2]);
+        free(data);
+        return 1;
+    }
+
+    // 文本日志段压缩后同样只能用本工具读取，解压后原样输出 / Compressed text log segments are likewise only readable with this tool, so they are written out as is / Komprimierte Textprotokollsegmente sind ebenfalls nur mit diesem Werkzeug lesbar und werden unverändert ausgegeben
+    if (compressed && (size < 4 || memcmp(data, NXLD_LOG_BINARY_MAGIC, 4) != 0)) {
+        fwrite(data, 1, size, out);
+        if (out != stdout) {
+            fclose(out);
+        }
+        fprintf(stderr, "Decompressed %zu bytes of text\n", size);
+        free(data);
+        return status;
+    }
+
+    size_t offset = 0;
+    size_t sessions = 0;
+    long messages = 0;
+    while (offset < size) {
+        uint32_t version;
+        uint32_t byte_order;
+        if (size - offset < NXLD_LOG_BINARY_HEADER_SIZE || memcmp(data + offset, NXLD_LOG_BINARY_MAGIC, 4) != 0) {
+            fprintf(stderr, "No session header at offset %zu\n", offset);
+            status = 1;
+            break;
+        }
+        memcpy(&version, data + offset + 4, sizeof(version));
+        memcpy(&byte_order, data + offset + 8, sizeof(byte_order));
+        if (version != NXLD_LOG_BINARY_VERSION || byte_order != 0x01020304) {
+            fprintf(stderr, "Unsupported session at offset %zu (version %u, written with a different byte order: %s)\n",
+                    offset, (unsigned int)version, byte_order != 0x01020304 ? "yes" : "no");
+            status = 1;
+            break;
+        }
+
+        decode_session_t session;
+        memset(&session, 0, sizeof(session));
+        memcpy(&session.wall_ns, data + offset + 16, sizeof(session.wall_ns));
+        memcpy(&session.monotonic_ns, data + offset + 24, sizeof(session.monotonic_ns));
+        offset += NXLD_LOG_BINARY_HEADER_SIZE;
+
+        size_t consumed = 0;
+        long count = decode_session(out, &session, data + offset, size - offset, &consumed);
+        free((void*)session.formats);
+        free(session.format_lengths);
+        if (count < 0) {
+            fprintf(stderr, "Out of memory\n");
+            status = 1;
+            break;
+        }
+        messages += count;
+        sessions++;
+        offset += consumed;
+        // 会话之后不是下一个会话头说明记录被截断（例如进程崩溃） / Anything after a session other than the next header means a truncated record (for example after a crash) / Alles nach einer Sitzung außer dem nächsten Kopf bedeutet einen abgeschnittenen Datensatz (etwa nach einem Absturz)
+        if (offset < size && data[offset] != (unsigned char)NXLD_LOG_BINARY_MAGIC[0]) {
+            fprintf(stderr, "Truncated record at offset %zu\n", offset);
+            status = 1;
+            break;
+        }
+    }
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    fprintf(stderr, "Decoded %ld messages from %zu sessions\n", messages, sessions);
+    free(data);
+    return status;
+}
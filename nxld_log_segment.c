@@ -0,0 +1,393 @@
+/**
+ * @file nxld_log_segment.c
+ * @brief NXLD日志段文件实现 / NXLD Log Segment File Implementation / NXLD-Protokollsegmentdatei-Implementierung
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_log_segment.h"
+#include "nxld_logger.h"
+#include "nxld_lz.h"
+#include "nxld_thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief 日志段结构体 / Log segment structure / Protokollsegment-Struktur
+ */
+struct nxld_log_segment {
+    char* path;                             /**< 当前段路径 / Active segment path / Pfad des aktiven Segments */
+    size_t size;                            /**< 段大小 / Segment size / Segmentgröße */
+    size_t count;                           /**< 保留的段数量 / Number of segments kept / Anzahl aufbewahrter Segmente */
+    int binary;                             /**< 是否为二进制记录 / Whether records are binary / Ob Datensätze binär sind */
+    int compress;                           /**< 是否压缩轮转出的段 / Whether rotated segments are compressed / Ob rotierte Segmente komprimiert werden */
+    int compressing;                        /**< 压缩线程是否在运行 / Whether the compressor thread is running / Ob der Kompressions-Thread läuft */
+    nxld_thread_t compressor;               /**< 压缩线程 / Compressor thread / Kompressions-Thread */
+    char* base;                             /**< 映射地址（NULL表示未映射） / Mapped address (NULL when unmapped) / Abgebildete Adresse (NULL, wenn nicht abgebildet) */
+    size_t used;                            /**< 已写入的字节数 / Bytes written / Geschriebene Bytes */
+    int failed;                             /**< 映射新段失败后锁定，不再轮转 / Latched once mapping a new segment fails, no further rotation / Gesetzt, sobald das Abbilden eines neuen Segments fehlschlägt, keine weitere Rotation */
+    size_t trim_failures;                   /**< 未能截断到有效长度的段数量，读取后清零 / Segments that could not be truncated to their valid length, cleared when read / Segmente, die nicht auf ihre gültige Länge gekürzt werden konnten, beim Lesen zurückgesetzt */
+#ifdef _WIN32
+    HANDLE file;                            /**< 文件句柄 / File handle / Dateihandle */
+    HANDLE mapping;                         /**< 映射句柄 / Mapping handle / Abbildungshandle */
+#else
+    int fd;                                 /**< 文件描述符 / File descriptor / Dateideskriptor */
+#endif
+};
+
+/**
+ * @brief 找出已有段中可以续写的长度 / Find the length of an existing segment that can be appended to / Länge eines vorhandenen Segments finden, an die angehängt werden kann
+ * @details 文本段去掉预分配留下的结尾零字节，中间不能有零字节也不能以二进制会话头开头；二进制段须以会话头开头，逐条遍历记录头，最后一条完整记录之后只能是预分配的零字节 / Text segments drop the trailing zero bytes left by preallocation and must neither contain zero bytes nor start with a binary session header; binary segments must start with a session header, records are walked header by header, and only preallocation zeros may follow the last whole record / Textsegmente verwerfen die von der Vorreservierung hinterlassenen Nullbytes am Ende und dürfen weder Nullbytes enthalten noch mit einem binären Sitzungskopf beginnen; binäre Segmente müssen mit einem Sitzungskopf beginnen, Datensätze werden Kopf für Kopf durchlaufen, und nach dem letzten vollständigen Datensatz dürfen nur Vorreservierungs-Nullbytes folgen
+ * @param used 输出可续写的长度 / Output length that can be appended to / Ausgabe der Länge, an die angehängt werden kann
+ * @return 段的编码一致且长度可确定返回1，否则返回0 / Returns 1 if the segment has the same encoding and a determinable length, 0 otherwise / Gibt 1 zurück, wenn das Segment dieselbe Kodierung und eine bestimmbare Länge hat, sonst 0
+ */
+static int reusable_length(const char* data, size_t size, int binary, size_t* used) {
+    size_t content = size;
+    while (content > 0 && data[content - 1] == '\0') {
+        content--;
+    }
+    *used = 0;
+    if (content == 0) {
+        return 1;
+    }
+
+    int starts_binary = content >= 4 && memcmp(data, NXLD_LOG_BINARY_MAGIC, 4) == 0;
+    if (!binary) {
+        if (starts_binary || memchr(data, '\0', content) != NULL) {
+            return 0;
+        }
+        *used = content;
+        return 1;
+    }
+    if (!starts_binary) {
+        return 0;
+    }
+
+    size_t offset = 0;
+    while (offset < size) {
+        if (size - offset >= NXLD_LOG_BINARY_HEADER_SIZE && memcmp(data + offset, NXLD_LOG_BINARY_MAGIC, 4) == 0) {
+            offset += NXLD_LOG_BINARY_HEADER_SIZE;
+            continue;
+        }
+        unsigned char type = (unsigned char)data[offset];
+        uint16_t length;
+        if (size - offset < NXLD_LOG_RECORD_HEADER_SIZE || type < NXLD_LOG_RECORD_FORMAT || type > NXLD_LOG_RECORD_TEXT) {
+            break;
+        }
+        memcpy(&length, data + offset + 2, sizeof(length));
+        if (length < NXLD_LOG_RECORD_HEADER_SIZE || length > size - offset) {
+            break;
+        }
+        offset += length;
+    }
+    // 二进制记录可能以零字节结尾，所以遍历可能停在结尾零字节之后；两者之间只能是零 / Binary records may end in zero bytes, so the walk may stop past the zero tail; only zeros may lie in between / Binäre Datensätze können auf Nullbytes enden, daher kann der Durchlauf hinter dem Null-Ende stehen bleiben; dazwischen dürfen nur Nullen liegen
+    if (offset < content) {
+        return 0;
+    }
+    *used = offset;
+    return 1;
+}
+
+/**
+ * @brief 生成旧段文件名 / Build an old segment file name / Dateinamen eines alten Segments bilden
+ * @param suffix 附加的扩展名（压缩段为NXLD_LZ_EXTENSION，否则为空串） / Appended extension (NXLD_LZ_EXTENSION for compressed segments, otherwise empty) / Angehängte Erweiterung (NXLD_LZ_EXTENSION für komprimierte Segmente, sonst leer)
+ */
+static void segment_name(const nxld_log_segment_t* segment, size_t index, const char* suffix, char* out, size_t out_size) {
+    if (index == 0) {
+        snprintf(out, out_size, "%s%s", segment->path, suffix);
+    } else {
+        snprintf(out, out_size, "%s.%zu%s", segment->path, index, suffix);
+    }
+}
+
+/**
+ * @brief 改名并覆盖已有文件 / Rename, replacing an existing file / Umbenennen und vorhandene Datei ersetzen
+ */
+static void replace_file(const char* from, const char* to) {
+#ifdef _WIN32
+    MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING);
+#else
+    rename(from, to);
+#endif
+}
+
+/**
+ * @brief 把当前段和旧段依次后移一位，超出数量的最旧段被删除 / Shift the active and old segments back by one, removing the oldest beyond the count / Aktives und alte Segmente um eins nach hinten verschieben, das älteste über der Anzahl wird entfernt
+ * @details 旧段可能是压缩的也可能不是（压缩关闭或失败），两种文件名都要移动 / Old segments may or may not be compressed (compression off or failed), so both file names are moved / Alte Segmente können komprimiert sein oder nicht (Kompression aus oder fehlgeschlagen), daher werden beide Dateinamen verschoben
+ */
+static void shift_segments(const nxld_log_segment_t* segment) {
+    size_t name_size = strlen(segment->path) + 24 + sizeof(NXLD_LZ_EXTENSION);
+    char* from = (char*)malloc(name_size);
+    char* to = (char*)malloc(name_size);
+    if (from == NULL || to == NULL) {
+        free(from);
+        free(to);
+        return;
+    }
+
+    if (segment->count <= 1) {
+        remove(segment->path);
+    } else {
+        segment_name(segment, segment->count - 1, "", to, name_size);
+        remove(to);
+        segment_name(segment, segment->count - 1, NXLD_LZ_EXTENSION, to, name_size);
+        remove(to);
+    }
+    for (size_t index = segment->count - 1; index >= 1; index--) {
+        segment_name(segment, index - 1, "", from, name_size);
+        segment_name(segment, index, "", to, name_size);
+        replace_file(from, to);
+        if (index > 1) {
+            segment_name(segment, index - 1, NXLD_LZ_EXTENSION, from, name_size);
+            segment_name(segment, index, NXLD_LZ_EXTENSION, to, name_size);
+            replace_file(from, to);
+        }
+    }
+    free(from);
+    free(to);
+}
+
+/**
+ * @brief 压缩线程：把path.1压缩为path.1.lz4 / Compressor thread: compress path.1 into path.1.lz4 / Kompressions-Thread: path.1 zu path.1.lz4 komprimieren
+ * @details 先写入临时文件再改名，失败时保留未压缩的段 / Writes a temporary file first and renames it, keeping the uncompressed segment on failure / Schreibt zuerst eine temporäre Datei und benennt sie um; bei Fehler bleibt das unkomprimierte Segment erhalten
+ */
+static void compress_main(void* arg) {
+    const nxld_log_segment_t* segment = (const nxld_log_segment_t*)arg;
+    size_t name_size = strlen(segment->path) + 32 + sizeof(NXLD_LZ_EXTENSION);
+    char* from = (char*)malloc(name_size);
+    char* temp = (char*)malloc(name_size);
+    char* to = (char*)malloc(name_size);
+    if (from != NULL && temp != NULL && to != NULL) {
+        segment_name(segment, 1, "", from, name_size);
+        segment_name(segment, 1, NXLD_LZ_EXTENSION ".tmp", temp, name_size);
+        segment_name(segment, 1, NXLD_LZ_EXTENSION, to, name_size);
+        if (nxld_lz_compress_file(from, temp) == 0) {
+            replace_file(temp, to);
+            remove(from);
+        }
+    }
+    free(from);
+    free(temp);
+    free(to);
+}
+
+/**
+ * @brief 等待上一次压缩结束 / Wait for the previous compression to finish / Auf das Ende der vorherigen Kompression warten
+ */
+static void wait_compressor(nxld_log_segment_t* segment) {
+    if (segment->compressing) {
+        nxld_thread_join(segment->compressor);
+        segment->compressing = 0;
+    }
+}
+
+/**
+ * @brief 解除映射并把文件截断到有效长度 / Unmap and truncate the file to its valid length / Abbildung aufheben und Datei auf ihre gültige Länge kürzen
+ */
+static void unmap_segment(nxld_log_segment_t* segment) {
+    if (segment->base == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(segment->base);
+    CloseHandle(segment->mapping);
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)segment->used;
+    // 截断失败时文件保留零字节结尾，由日志模块告警 / If truncation fails the file keeps its zero tail and the logger warns about it / Schlägt das Kürzen fehl, behält die Datei ihr Null-Ende und das Protokollmodul warnt
+    if (!SetFilePointerEx(segment->file, end, NULL, FILE_BEGIN) || !SetEndOfFile(segment->file)) {
+        segment->trim_failures++;
+    }
+    CloseHandle(segment->file);
+#else
+    munmap(segment->base, segment->size);
+    if (ftruncate(segment->fd, (off_t)segment->used) != 0) {
+        segment->trim_failures++;
+    }
+    close(segment->fd);
+#endif
+    segment->base = NULL;
+    segment->used = 0;
+}
+
+/**
+ * @brief 打开、预分配并映射当前段 / Open, preallocate and map the active segment / Aktives Segment öffnen, vorab reservieren und abbilden
+ * @param shifted 是否已为此次打开轮转过一次（再次遇到无法续写的段时放弃，不覆盖） / Whether the segments were already shifted for this open (a second unusable segment gives up instead of overwriting) / Ob die Segmente für dieses Öffnen bereits verschoben wurden (ein zweites unbrauchbares Segment gibt auf, statt zu überschreiben)
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 已有段过大、编码不同或有效长度无法确定时先轮转，原有内容保留在path.1 / An existing segment that is too large, uses the other encoding or has no determinable valid length is rotated first, keeping its content in path.1 / Ein vorhandenes Segment, das zu groß ist, die andere Kodierung verwendet oder keine bestimmbare gültige Länge hat, wird zuerst rotiert; sein Inhalt bleibt in path.1 erhalten
+ */
+static int map_segment(nxld_log_segment_t* segment, int shifted) {
+    size_t existing = 0;
+#ifdef _WIN32
+    segment->file = CreateFileA(segment->path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS,
+                                FILE_ATTRIBUTE_NORMAL, NULL);
+    if (segment->file == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(segment->file, &file_size)) {
+        existing = (size_t)file_size.QuadPart;
+    }
+    if (existing > segment->size) {
+        CloseHandle(segment->file);
+        if (shifted) {
+            return -1;
+        }
+        shift_segments(segment);
+        return map_segment(segment, 1);
+    }
+    // 映射大于文件时系统按映射大小扩展文件 / A mapping larger than the file extends the file to the mapping size / Eine Abbildung größer als die Datei erweitert die Datei auf die Abbildungsgröße
+    segment->mapping = CreateFileMappingA(segment->file, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)segment->size >> 32),
+                                          (DWORD)segment->size, NULL);
+    if (segment->mapping == NULL) {
+        CloseHandle(segment->file);
+        return -1;
+    }
+    segment->base = (char*)MapViewOfFile(segment->mapping, FILE_MAP_WRITE, 0, 0, segment->size);
+    if (segment->base == NULL) {
+        CloseHandle(segment->mapping);
+        LARGE_INTEGER end;
+        end.QuadPart = (LONGLONG)existing;
+        if (!SetFilePointerEx(segment->file, end, NULL, FILE_BEGIN) || !SetEndOfFile(segment->file)) {
+            segment->trim_failures++;
+        }
+        CloseHandle(segment->file);
+        return -1;
+    }
+#else
+    segment->fd = open(segment->path, O_RDWR | O_CREAT, 0644);
+    if (segment->fd < 0) {
+        return -1;
+    }
+    struct stat info;
+    if (fstat(segment->fd, &info) == 0) {
+        existing = (size_t)info.st_size;
+    }
+    if (existing > segment->size) {
+        close(segment->fd);
+        if (shifted) {
+            return -1;
+        }
+        shift_segments(segment);
+        return map_segment(segment, 1);
+    }
+    // 预先分配磁盘块，追加时不再扩展文件 / Allocate the disk blocks up front so appends never extend the file / Festplattenblöcke vorab zuweisen, damit Anhänge die Datei nie erweitern
+    // 失败时截回原长度，调用方改为追加的文件不以零字节开头 / On failure truncate back to the original length so a file the caller appends to instead does not start with zero bytes / Bei Fehler auf die ursprüngliche Länge kürzen, damit eine Datei, an die der Aufrufer stattdessen anhängt, nicht mit Nullbytes beginnt
+    void* base = MAP_FAILED;
+    if (posix_fallocate(segment->fd, 0, (off_t)segment->size) == 0 || ftruncate(segment->fd, (off_t)segment->size) == 0) {
+        base = mmap(NULL, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    }
+    if (base == MAP_FAILED) {
+        if (ftruncate(segment->fd, (off_t)existing) != 0) {
+            segment->trim_failures++;
+        }
+        close(segment->fd);
+        return -1;
+    }
+    segment->base = (char*)base;
+#endif
+    if (existing > 0 && !reusable_length(segment->base, existing, segment->binary, &segment->used)) {
+        // 解除映射时截回原长度，内容原样移到path.1 / Unmapping truncates back to the original length and the content moves to path.1 unchanged / Beim Aufheben der Abbildung wird auf die ursprüngliche Länge gekürzt und der Inhalt unverändert nach path.1 verschoben
+        segment->used = existing;
+        unmap_segment(segment);
+        if (shifted) {
+            return -1;
+        }
+        shift_segments(segment);
+        return map_segment(segment, 1);
+    }
+    return 0;
+}
+
+nxld_log_segment_t* nxld_log_segment_open(const char* path, size_t segment_size, size_t segment_count, int binary,
+                                          int compress) {
+    if (path == NULL) {
+        return NULL;
+    }
+
+    nxld_log_segment_t* segment = (nxld_log_segment_t*)calloc(1, sizeof(nxld_log_segment_t));
+    if (segment == NULL) {
+        return NULL;
+    }
+    size_t path_length = strlen(path);
+    segment->path = (char*)malloc(path_length + 1);
+    if (segment->path == NULL) {
+        free(segment);
+        return NULL;
+    }
+    memcpy(segment->path, path, path_length + 1);
+    segment->size = segment_size < NXLD_LOG_SEGMENT_MIN_SIZE ? NXLD_LOG_SEGMENT_MIN_SIZE : segment_size;
+    segment->count = segment_count == 0 ? 1 : segment_count;
+    segment->binary = binary;
+    segment->compress = compress;
+
+    if (map_segment(segment, 0) != 0) {
+        free(segment->path);
+        free(segment);
+        return NULL;
+    }
+    return segment;
+}
+
+size_t nxld_log_segment_available(const nxld_log_segment_t* segment) {
+    return segment->base != NULL ? segment->size - segment->used : 0;
+}
+
+int nxld_log_segment_rotate(nxld_log_segment_t* segment) {
+    // 失败后再轮转会每次都移动并删除保留的段 / Rotating again after a failure would shift and delete the kept segments every time / Erneutes Rotieren nach einem Fehler würde die aufbewahrten Segmente jedes Mal verschieben und löschen
+    if (segment->failed) {
+        return -1;
+    }
+    unmap_segment(segment);
+    // 压缩中的path.1不能被移动；压缩比写满一段快得多，这里通常不需等待 / path.1 must not move while it is being compressed; compressing is far faster than filling a segment, so this rarely waits / path.1 darf während der Kompression nicht verschoben werden; Komprimieren ist weit schneller als das Füllen eines Segments, daher wird hier selten gewartet
+    wait_compressor(segment);
+    shift_segments(segment);
+    if (segment->compress && segment->count > 1 &&
+        nxld_thread_create(&segment->compressor, compress_main, segment) == 0) {
+        segment->compressing = 1;
+    }
+    if (map_segment(segment, 0) != 0) {
+        segment->failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+size_t nxld_log_segment_take_trim_failures(nxld_log_segment_t* segment) {
+    size_t failures = segment->trim_failures;
+    segment->trim_failures = 0;
+    return failures;
+}
+
+const char* nxld_log_segment_path(const nxld_log_segment_t* segment) {
+    return segment->path;
+}
+
+void nxld_log_segment_append(nxld_log_segment_t* segment, const void* data, size_t length) {
+    if (segment->base == NULL || length > segment->size - segment->used) {
+        return;
+    }
+    memcpy(segment->base + segment->used, data, length);
+    segment->used += length;
+}
+
+void nxld_log_segment_close(nxld_log_segment_t* segment) {
+    if (segment == NULL) {
+        return;
+    }
+    unmap_segment(segment);
+    wait_compressor(segment);
+    free(segment->path);
+    free(segment);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file nxld_log_segment.h
+ * @brief NXLD日志段文件接口 / NXLD Log Segment File Interface / NXLD-Protokollsegmentdatei-Schnittstelle
+ * @details 预分配固定大小的段文件并映射到内存，追加只是一次内存复制；写满后轮转，按数量保留旧段 / Preallocates fixed-size segment files and maps them into memory so an append is a single memory copy; full segments are rotated and old segments are retained by count / Reserviert Segmentdateien fester Größe vorab und bildet sie in den Speicher ab, sodass ein Anhängen eine einzige Speicherkopie ist; volle Segmente werden rotiert und alte Segmente nach Anzahl aufbewahrt
+ */
+
+#ifndef NXLD_LOG_SEGMENT_H
+#define NXLD_LOG_SEGMENT_H
+
+#include <stddef.h>
+
+/**
+ * @brief 最小段大小（字节），须容纳二进制会话头和所有格式定义 / Minimum segment size in bytes, must hold a binary session header and every format definition / Minimale Segmentgröße in Bytes, muss einen binären Sitzungskopf und alle Formatdefinitionen aufnehmen
+ */
+#define NXLD_LOG_SEGMENT_MIN_SIZE (1024 * 1024)
+
+/**
+ * @brief 默认保留的段数量（含当前段） / Default number of segments kept, including the active one / Standardanzahl aufbewahrter Segmente einschließlich des aktiven
+ */
+#define NXLD_LOG_SEGMENT_DEFAULT_COUNT 8
+
+/**
+ * @brief 日志段（不透明） / Log segment (opaque) / Protokollsegment (undurchsichtig)
+ */
+typedef struct nxld_log_segment nxld_log_segment_t;
+
+/**
+ * @brief 打开当前段 / Open the active segment / Aktives Segment öffnen
+ * @param path 当前段路径，旧段命名为path.1（最新）到path.N / Active segment path, old segments are named path.1 (newest) to path.N / Pfad des aktiven Segments, alte Segmente heißen path.1 (neuestes) bis path.N
+ * @param segment_size 段大小（字节，不小于NXLD_LOG_SEGMENT_MIN_SIZE） / Segment size in bytes (at least NXLD_LOG_SEGMENT_MIN_SIZE) / Segmentgröße in Bytes (mindestens NXLD_LOG_SEGMENT_MIN_SIZE)
+ * @param segment_count 保留的段数量（含当前段，至少1） / Number of segments kept, including the active one (at least 1) / Anzahl aufbewahrter Segmente einschließlich des aktiven (mindestens 1)
+ * @param binary 段内是否为二进制记录，用于找出已有段的结尾 / Whether segments hold binary records, used to find the end of an existing segment / Ob Segmente binäre Datensätze enthalten, dient zum Finden des Endes eines vorhandenen Segments
+ * @param compress 是否在后台线程把轮转出的段压缩为path.N.lz4 / Whether rotated segments are compressed into path.N.lz4 on a background thread / Ob rotierte Segmente in einem Hintergrund-Thread zu path.N.lz4 komprimiert werden
+ * @return 段指针，失败返回NULL / Segment pointer, NULL on failure / Segment-Zeiger, NULL bei Fehler
+ * @details 已有的当前段在其有效内容之后继续追加；超过段大小、编码不同或有效长度无法确定时先轮转，不覆盖原有内容 / An existing active segment is appended to after its valid content; if it exceeds the segment size, uses the other encoding or has no determinable valid length it is rotated first instead of being overwritten / An ein vorhandenes aktives Segment wird nach seinem gültigen Inhalt angehängt; überschreitet es die Segmentgröße, verwendet es die andere Kodierung oder ist seine gültige Länge nicht bestimmbar, wird es zuerst rotiert statt überschrieben
+ */
+nxld_log_segment_t* nxld_log_segment_open(const char* path, size_t segment_size, size_t segment_count, int binary,
+                                          int compress);
+
+/**
+ * @brief 获取当前段的剩余空间 / Get the space left in the active segment / Verbleibenden Platz im aktiven Segment abrufen
+ * @param segment 段指针 / Segment pointer / Segment-Zeiger
+ * @return 剩余字节数，当前段未映射时为0 / Bytes left, 0 when no segment is mapped / Verbleibende Bytes, 0 wenn kein Segment abgebildet ist
+ */
+size_t nxld_log_segment_available(const nxld_log_segment_t* segment);
+
+/**
+ * @brief 结束当前段并开始新段 / Finish the active segment and start a new one / Aktives Segment abschließen und ein neues beginnen
+ * @param segment 段指针 / Segment pointer / Segment-Zeiger
+ * @return 成功返回0，失败返回-1；新段无法映射时段被锁定，此后追加被忽略，再次轮转直接返回-1，不再移动或删除保留的段 / Returns 0 on success, -1 on failure; when the new segment cannot be mapped the segment is latched, later appends are ignored and further rotations return -1 at once without shifting or deleting the kept segments / Gibt 0 bei Erfolg zurück, -1 bei Fehler; kann das neue Segment nicht abgebildet werden, wird das Segment gesperrt, spätere Anhänge werden ignoriert und weitere Rotationen geben sofort -1 zurück, ohne aufbewahrte Segmente zu verschieben oder zu löschen
+ * @details 结束的段截断到有效长度后改名为path.1，最旧的段被删除；开启压缩时path.1随后在后台压缩为path.1.lz4 / The finished segment is truncated to its valid length and renamed to path.1, the oldest segment is removed; with compression on, path.1 is then compressed into path.1.lz4 in the background / Das abgeschlossene Segment wird auf seine gültige Länge gekürzt und in path.1 umbenannt, das älteste Segment wird entfernt; bei aktiver Kompression wird path.1 anschließend im Hintergrund zu path.1.lz4 komprimiert
+ */
+int nxld_log_segment_rotate(nxld_log_segment_t* segment);
+
+/**
+ * @brief 取出未能截断的段数量 / Take the number of segments that could not be truncated / Anzahl nicht kürzbarer Segmente abholen
+ * @param segment 段指针 / Segment pointer / Segment-Zeiger
+ * @return 上次调用以来未能截断到有效长度的段数量，这些段保留预分配的零字节结尾 / Segments since the previous call that could not be truncated to their valid length; they keep the zero tail left by preallocation / Segmente seit dem vorherigen Aufruf, die nicht auf ihre gültige Länge gekürzt werden konnten; sie behalten das Null-Ende der Vorreservierung
+ * @details 段模块自身不能记录日志，由调用方报告 / The segment module cannot log itself, so the caller reports it / Das Segmentmodul kann selbst nicht protokollieren, daher meldet es der Aufrufer
+ */
+size_t nxld_log_segment_take_trim_failures(nxld_log_segment_t* segment);
+
+/**
+ * @brief 获取当前段路径 / Get the active segment path / Pfad des aktiven Segments abrufen
+ * @param segment 段指针 / Segment pointer / Segment-Zeiger
+ * @return 当前段路径 / Active segment path / Pfad des aktiven Segments
+ */
+const char* nxld_log_segment_path(const nxld_log_segment_t* segment);
+
+/**
+ * @brief 追加数据 / Append data / Daten anhängen
+ * @param segment 段指针 / Segment pointer / Segment-Zeiger
+ * @param data 数据 / Data / Daten
+ * @param length 数据长度，须不超过nxld_log_segment_available / Data length, must not exceed nxld_log_segment_available / Datenlänge, darf nxld_log_segment_available nicht überschreiten
+ * @details 不是线程安全的，由调用方串行化 / Not thread-safe, callers serialize / Nicht threadsicher, Aufrufer serialisieren
+ */
+void nxld_log_segment_append(nxld_log_segment_t* segment, const void* data, size_t length);
+
+/**
+ * @brief 关闭段 / Close segment / Segment schließen
+ * @param segment 段指针（可为NULL） / Segment pointer (may be NULL) / Segment-Zeiger (kann NULL sein)
+ * @details 当前段截断到有效长度，并等待进行中的压缩结束 / The active segment is truncated to its valid length and a compression in progress is waited for / Das aktive Segment wird auf seine gültige Länge gekürzt und auf eine laufende Kompression gewartet
+ */
+void nxld_log_segment_close(nxld_log_segment_t* segment);
+
+#endif /* NXLD_LOG_SEGMENT_H */
@@ -4,54 +4,1136 @@
  * @details 实现日志系统插件化包装器，保持与原有接口兼容 / Implements pluginized logging system wrapper, maintains compatibility with original interface / Implementiert pluginisiertes Protokollierungssystem-Wrapper, behält Kompatibilität mit ursprünglicher Schnittstelle
  */
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "nxld_logger.h"
 #include "logger_plugin_interface.h"
+#include "nxld_thread.h"
+#include "nxld_metrics.h"
+#include "nxld_log_segment.h"
+#include "nxld_uring.h"
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <time.h>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
 #include <dlfcn.h>
+#include <sched.h>
 #endif
 
 static void* g_logger_plugin_handle = NULL;
 static int (*g_logger_plugin_init_func)(const char*) = NULL;
 static void (*g_logger_plugin_close_func)(void) = NULL;
 static void (*g_logger_plugin_write_func)(logger_level_t, const char*, va_list) = NULL;
+static void (*g_logger_plugin_write_batch_func)(const logger_record_t*, size_t) = NULL;
 static int g_logger_plugin_loaded = 0;
 
+#define WRITE_BATCH_SIZE (64 * 1024)
+#define WRITER_IDLE_MS 1
+#define FORMAT_TABLE_BITS 10
+#define MAX_FORMAT_ARGS 16
+#define MAX_BATCH_RECORDS (WRITE_BATCH_SIZE / (NXLD_LOG_RECORD_HEADER_SIZE + 8))
+
+static const char* const g_level_names[] = {"ERROR", "WARNING", "INFO", "DEBUG"};
+static const char* const g_module_names[] = {"general", "parser", "loader", "plugin", "dispatch"};
+
 /**
  * @brief 文件日志实现 / File logger implementation / Datei-Logger-Implementierung
  * @details 当日志插件未加载时使用的文件日志实现 / File logger implementation used when logger plugin is not loaded / Datei-Logger-Implementierung, die verwendet wird, wenn Logger-Plugin nicht geladen ist
  */
 static FILE* g_fallback_log_file = NULL;
+static nxld_log_segment_t* g_log_segment = NULL;
+static size_t g_log_segment_size = 0;
+static size_t g_log_segment_count = NXLD_LOG_SEGMENT_DEFAULT_COUNT;
+static int g_log_segment_compress = 0;
+
+#ifdef _WIN32
+typedef volatile LONG64 log_atomic_t;
+
+static uint64_t load_atomic(log_atomic_t* value) {
+    return (uint64_t)InterlockedCompareExchange64(value, 0, 0);
+}
+
+static void store_atomic(log_atomic_t* value, uint64_t desired) {
+    InterlockedExchange64(value, (LONG64)desired);
+}
+
+static int compare_exchange_atomic(log_atomic_t* value, uint64_t expected, uint64_t desired) {
+    return InterlockedCompareExchange64(value, (LONG64)desired, (LONG64)expected) == (LONG64)expected;
+}
+
+static void increment_atomic(log_atomic_t* value) {
+    InterlockedIncrement64(value);
+}
+
+static uint64_t load_atomic_seq(log_atomic_t* value) {
+    return (uint64_t)InterlockedCompareExchange64(value, 0, 0);
+}
+
+static void add_atomic(log_atomic_t* value, int64_t delta) {
+    InterlockedExchangeAdd64(value, (LONG64)delta);
+}
+
+static int load_level(const int* level) {
+    return *(const volatile int*)level;
+}
+
+static void store_level(int* level, int desired) {
+    *(volatile int*)level = desired;
+}
+
+static void yield_thread(void) {
+    SwitchToThread();
+}
+
+static void sleep_idle(void) {
+    Sleep(WRITER_IDLE_MS);
+}
+#else
+typedef uint64_t log_atomic_t;
+
+static uint64_t load_atomic(log_atomic_t* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static void store_atomic(log_atomic_t* value, uint64_t desired) {
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+}
+
+static int compare_exchange_atomic(log_atomic_t* value, uint64_t expected, uint64_t desired) {
+    return __atomic_compare_exchange_n(value, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE);
+}
+
+static void increment_atomic(log_atomic_t* value) {
+    __atomic_add_fetch(value, 1, __ATOMIC_RELAXED);
+}
+
+// 路由句柄两边须按顺序一致：调用方先计数再读路由，重新配置先改路由再读计数 / Both sides of the route handle need sequential consistency: callers count before reading the route, reconfiguration changes the route before reading the count / Beide Seiten des Routen-Handles brauchen sequentielle Konsistenz: Aufrufer zählen vor dem Lesen der Route, die Neukonfiguration ändert die Route vor dem Lesen des Zählers
+static uint64_t load_atomic_seq(log_atomic_t* value) {
+    return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+}
+
+static void add_atomic(log_atomic_t* value, int64_t delta) {
+    __atomic_add_fetch(value, (uint64_t)delta, __ATOMIC_SEQ_CST);
+}
+
+// 级别阈值只需单独可见，不与其他数据排序 / Level thresholds only need to become visible on their own, not ordered with other data / Ebenenschwellen müssen nur für sich sichtbar werden, ohne Ordnung zu anderen Daten
+static int load_level(const int* level) {
+    return __atomic_load_n(level, __ATOMIC_RELAXED);
+}
+
+static void store_level(int* level, int desired) {
+    __atomic_store_n(level, desired, __ATOMIC_RELAXED);
+}
+
+static void yield_thread(void) {
+    sched_yield();
+}
+
+static void sleep_idle(void) {
+    struct timespec request;
+    request.tv_sec = 0;
+    request.tv_nsec = WRITER_IDLE_MS * 1000000L;
+    nanosleep(&request, NULL);
+}
+#endif
+
+/**
+ * @brief 环形缓冲区槽结构体 / Ring buffer slot structure / Ringpuffer-Slot-Struktur
+ * @details 序号等于位置时槽空闲，等于位置加一时消息已发布 / The slot is free when its sequence equals the position and holds a published message when it equals the position plus one / Der Slot ist frei, wenn seine Sequenz der Position entspricht, und enthält eine veröffentlichte Nachricht, wenn sie der Position plus eins entspricht
+ */
+typedef struct {
+    log_atomic_t sequence;                  /**< 槽序号 / Slot sequence / Slot-Sequenz */
+    size_t length;                          /**< 消息长度 / Message length / Nachrichtenlänge */
+    char text[NXLD_LOG_MESSAGE_SIZE];       /**< 已格式化的消息（以换行结尾） / Formatted message ending in a newline / Formatierte Nachricht mit abschließendem Zeilenumbruch */
+} log_slot_t;
+
+/**
+ * @brief 线程格式化缓冲区结构体 / Thread formatting buffer structure / Thread-Formatierungspuffer-Struktur
+ * @details 只由所属线程使用；时间戳前缀每秒只重新生成一次 / Only used by its owning thread; the timestamp prefix is rebuilt at most once per second / Nur vom eigenen Thread verwendet; das Zeitstempel-Präfix wird höchstens einmal pro Sekunde neu erzeugt
+ */
+typedef struct log_thread {
+    time_t second;                          /**< 缓存前缀对应的秒 / Second of the cached prefix / Sekunde des zwischengespeicherten Präfixes */
+    size_t prefix_length;                   /**< 时间戳前缀长度 / Timestamp prefix length / Länge des Zeitstempel-Präfixes */
+    char prefix[32];                        /**< 时间戳前缀 / Timestamp prefix / Zeitstempel-Präfix */
+    char text[NXLD_LOG_MESSAGE_SIZE];       /**< 格式化缓冲区 / Formatting buffer / Formatierungspuffer */
+    struct log_thread* next;                /**< 下一个线程缓冲区 / Next thread buffer / Nächster Thread-Puffer */
+} log_thread_t;
+
+/**
+ * @brief 已登记的格式字符串结构体 / Registered format string structure / Registrierte Formatzeichenfolgen-Struktur
+ * @details 在互斥锁内填写，最后发布地址；读取方只做加载，不加锁 / Filled in under the mutex with the address published last; readers only load and never lock / Unter dem Mutex befüllt, die Adresse wird zuletzt veröffentlicht; Leser laden nur und sperren nie
+ */
+typedef struct {
+    log_atomic_t format;                    /**< 格式字符串地址（0表示空槽） / Format string address (0 for an empty slot) / Adresse der Formatzeichenfolge (0 für einen leeren Slot) */
+    uint32_t id;                            /**< 会话内编号 / Id within the session / ID innerhalb der Sitzung */
+    int deferrable;                         /**< 所有转换均支持延迟格式化 / Every conversion supports deferred formatting / Alle Umwandlungen unterstützen aufgeschobene Formatierung */
+    size_t arg_count;                       /**< 参数数量 / Argument count / Argumentanzahl */
+    unsigned char args[MAX_FORMAT_ARGS];    /**< 参数类型（nxld_log_arg_t） / Argument types (nxld_log_arg_t) / Argumenttypen (nxld_log_arg_t) */
+    short precision[MAX_FORMAT_ARGS];       /**< 字符串精度，-1无，-2取前一个int参数 / String precision, -1 none, -2 from the preceding int argument / Zeichenfolgengenauigkeit, -1 keine, -2 aus dem vorangehenden int-Argument */
+} log_format_t;
+
+static log_slot_t* g_log_ring = NULL;
+static log_atomic_t g_log_enqueue_position = 0;
+static log_atomic_t g_log_stopping = 0;
+static log_atomic_t g_log_dropped = 0;
+static log_atomic_t g_log_overflow_policy = NXLD_LOG_OVERFLOW_BLOCK;
+static int g_log_async = 0;
+static char* g_log_batch = NULL;
+static char* g_log_batch_spare = NULL;
+static char* g_log_uring_buffers[2] = {NULL, NULL};
+static nxld_uring_t* g_log_uring = NULL;
+static nxld_log_io_t g_log_requested_io = NXLD_LOG_IO_WRITE;
+static int g_log_plugin_batch = 0;
+static logger_record_t* g_log_records = NULL;
+static nxld_thread_t g_log_writer;
+static nxld_mutex_t g_log_mutex;
+static nxld_tls_t g_log_key;
+static log_thread_t* g_log_threads = NULL;
+static nxld_log_encoding_t g_log_requested_encoding = NXLD_LOG_ENCODING_TEXT;
+static int g_log_binary = 0;
+static log_format_t* g_log_formats = NULL;
+static uint32_t g_log_format_count = 0;
+static int g_log_level = NXLD_LOG_LEVEL_INFO;
+static int g_log_module_levels[NXLD_LOG_MODULE_COUNT] = {-1, -1, -1, -1, -1};
+static int g_log_thresholds[NXLD_LOG_MODULE_COUNT] = {
+    NXLD_LOG_LEVEL_INFO, NXLD_LOG_LEVEL_INFO, NXLD_LOG_LEVEL_INFO, NXLD_LOG_LEVEL_INFO, NXLD_LOG_LEVEL_INFO
+};
+
+/**
+ * @brief 日志路由枚举 / Log route enumeration / Protokollrouten-Aufzählung
+ * @details 调用方每次只读一次路由；文件、插件和后台线程的状态只在LOG_ROUTE_SWITCHING期间且没有调用方持有句柄时修改 / Callers read the route once per call; file, plugin and writer-thread state only changes during LOG_ROUTE_SWITCHING while no caller holds the handle / Aufrufer lesen die Route einmal pro Aufruf; Datei-, Plugin- und Schreib-Thread-Zustand ändert sich nur während LOG_ROUTE_SWITCHING, solange kein Aufrufer das Handle hält
+ */
+typedef enum {
+    LOG_ROUTE_CLOSED = 0,                   /**< 未初始化或已关闭，消息被丢弃 / Not initialized or closed, messages are discarded / Nicht initialisiert oder geschlossen, Nachrichten werden verworfen */
+    LOG_ROUTE_FILE,                         /**< 写入日志文件或段 / Written to the log file or segments / In Protokolldatei oder Segmente geschrieben */
+    LOG_ROUTE_PLUGIN,                       /**< 逐条调用日志插件 / Logger plugin called per message / Logger-Plugin pro Nachricht aufgerufen */
+    LOG_ROUTE_PLUGIN_BATCH,                 /**< 入队后由后台线程整批交给插件 / Enqueued and handed to the plugin in batches by the writer thread / Eingereiht und vom Schreib-Thread stapelweise an das Plugin übergeben */
+    LOG_ROUTE_SWITCHING                     /**< 正在重新配置，调用方等待 / Reconfiguration in progress, callers wait / Neukonfiguration läuft, Aufrufer warten */
+} log_route_t;
+
+static log_atomic_t g_log_route = LOG_ROUTE_CLOSED;
+static log_atomic_t g_log_callers = 0;
+
+/**
+ * @brief 获取路由句柄 / Acquire the route handle / Routen-Handle erwerben
+ * @return 当前路由，在release_route之前其状态不会改变 / Current route, whose state does not change before release_route / Aktuelle Route, deren Zustand sich vor release_route nicht ändert
+ * @details 只做一次原子加法和一次加载，不加锁；重新配置期间让出处理器直到完成 / Only one atomic add and one load, no lock; during reconfiguration the caller yields until it completes / Nur eine atomare Addition und ein Laden, keine Sperre; während der Neukonfiguration gibt der Aufrufer den Prozessor ab, bis sie abgeschlossen ist
+ */
+static log_route_t acquire_route(void) {
+    for (;;) {
+        add_atomic(&g_log_callers, 1);
+        uint64_t route = load_atomic_seq(&g_log_route);
+        if (route != LOG_ROUTE_SWITCHING) {
+            return (log_route_t)route;
+        }
+        add_atomic(&g_log_callers, -1);
+        while (load_atomic_seq(&g_log_route) == LOG_ROUTE_SWITCHING) {
+            yield_thread();
+        }
+    }
+}
+
+/**
+ * @brief 释放路由句柄 / Release the route handle / Routen-Handle freigeben
+ */
+static void release_route(void) {
+    add_atomic(&g_log_callers, -1);
+}
+
+/**
+ * @brief 开始重新配置 / Begin reconfiguration / Neukonfiguration beginnen
+ * @return 之前的路由 / Previous route / Vorherige Route
+ * @details 把路由切换为LOG_ROUTE_SWITCHING（同时串行化重新配置），再等待持有句柄的调用方全部离开；之后新来的调用方只看到切换状态 / Switches the route to LOG_ROUTE_SWITCHING (which also serializes reconfiguration), then waits until every caller holding the handle has left; later callers only see the switching state / Schaltet die Route auf LOG_ROUTE_SWITCHING (was die Neukonfiguration zugleich serialisiert) und wartet, bis alle Aufrufer mit Handle gegangen sind; spätere Aufrufer sehen nur den Umschaltzustand
+ */
+static log_route_t begin_switch(void) {
+    uint64_t route;
+    for (;;) {
+        route = load_atomic_seq(&g_log_route);
+        if (route != LOG_ROUTE_SWITCHING && compare_exchange_atomic(&g_log_route, route, LOG_ROUTE_SWITCHING)) {
+            break;
+        }
+        yield_thread();
+    }
+    while (load_atomic_seq(&g_log_callers) != 0) {
+        yield_thread();
+    }
+    return (log_route_t)route;
+}
+
+/**
+ * @brief 发布新路由，结束重新配置 / Publish the new route and end reconfiguration / Neue Route veröffentlichen und Neukonfiguration beenden
+ */
+static void end_switch(log_route_t route) {
+    store_atomic(&g_log_route, (uint64_t)route);
+}
+
+/**
+ * @brief 获取当前线程缓冲区，首次调用时注册 / Get the current thread's buffer, registering it on first use / Puffer des aktuellen Threads abrufen, bei erster Verwendung registrieren
+ */
+static log_thread_t* current_thread(void) {
+    log_thread_t* thread = (log_thread_t*)nxld_tls_get(g_log_key);
+    if (thread != NULL) {
+        return thread;
+    }
+
+    thread = (log_thread_t*)calloc(1, sizeof(log_thread_t));
+    if (thread == NULL) {
+        return NULL;
+    }
+    if (nxld_tls_set(g_log_key, thread) != 0) {
+        free(thread);
+        return NULL;
+    }
+
+    nxld_mutex_lock(&g_log_mutex);
+    thread->next = g_log_threads;
+    g_log_threads = thread;
+    nxld_mutex_unlock(&g_log_mutex);
+    return thread;
+}
+
+/**
+ * @brief 将消息格式化到线程缓冲区 / Format message into the thread buffer / Nachricht in den Thread-Puffer formatieren
+ * @return 消息长度（含结尾换行） / Message length including the trailing newline / Nachrichtenlänge inklusive abschließendem Zeilenumbruch
+ */
+static size_t format_message(log_thread_t* thread, const char* level, const char* format, va_list args) {
+    time_t now = time(NULL);
+    if (thread->prefix_length == 0 || now != thread->second) {
+        // 调用链可能在多个线程中记录日志，使用可重入版本 / Chains may log from several threads, so use the reentrant variant / Ketten können aus mehreren Threads protokollieren, daher die reentrante Variante verwenden
+        struct tm timeinfo;
+#ifdef _WIN32
+        localtime_s(&timeinfo, &now);
+#else
+        localtime_r(&now, &timeinfo);
+#endif
+        char time_str[24];
+        strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &timeinfo);
+        thread->prefix_length = (size_t)snprintf(thread->prefix, sizeof(thread->prefix), "[%s] ", time_str);
+        thread->second = now;
+    }
+
+    // 为结尾换行保留一个字节 / Keep one byte for the trailing newline / Ein Byte für den abschließenden Zeilenumbruch reservieren
+    const size_t limit = NXLD_LOG_MESSAGE_SIZE - 1;
+    size_t length = thread->prefix_length;
+    memcpy(thread->text, thread->prefix, length);
+    size_t level_length = strlen(level);
+    thread->text[length++] = '[';
+    memcpy(thread->text + length, level, level_length);
+    length += level_length;
+    thread->text[length++] = ']';
+    thread->text[length++] = ' ';
+    int written = vsnprintf(thread->text + length, limit - length, format, args);
+    if (written > 0) {
+        length += (size_t)written < limit - length ? (size_t)written : limit - length - 1;
+    }
+    thread->text[length++] = '\n';
+    return length;
+}
+
+int nxld_log_scan_conversion(const char* spec, nxld_log_conversion_t* out) {
+    const char* p = spec + 1;
+    out->arg = NXLD_LOG_ARG_NONE;
+    out->width_star = 0;
+    out->precision_star = 0;
+    out->precision = -1;
+    if (*p == '%') {
+        out->length = 2;
+        return 0;
+    }
+
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+        p++;
+    }
+    if (*p == '*') {
+        out->width_star = 1;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            out->precision_star = 1;
+            p++;
+        } else {
+            out->precision = 0;
+            while (*p >= '0' && *p <= '9') {
+                if (out->precision < 10000) {
+                    out->precision = out->precision * 10 + (*p - '0');
+                }
+                p++;
+            }
+        }
+    }
+
+    // 长度修饰符决定整数参数的类型 / The length modifier decides the integer argument type / Der Längenmodifikator bestimmt den Typ des Ganzzahlarguments
+    nxld_log_arg_t integer = NXLD_LOG_ARG_INT;
+    int modified = 1;
+    if (p[0] == 'h') {
+        p += p[1] == 'h' ? 2 : 1;
+    } else if (p[0] == 'l' && p[1] == 'l') {
+        integer = NXLD_LOG_ARG_LLONG;
+        p += 2;
+    } else if (p[0] == 'l') {
+        integer = NXLD_LOG_ARG_LONG;
+        p++;
+    } else if (p[0] == 'z') {
+        integer = NXLD_LOG_ARG_SIZE;
+        p++;
+    } else if (p[0] == 'j') {
+        integer = NXLD_LOG_ARG_INTMAX;
+        p++;
+    } else if (p[0] == 't') {
+        integer = NXLD_LOG_ARG_PTRDIFF;
+        p++;
+    } else if (p[0] == 'L') {
+        return -1;
+    } else {
+        modified = 0;
+    }
+
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            out->arg = integer;
+            break;
+        case 'c':
+            if (integer != NXLD_LOG_ARG_INT) {
+                return -1;
+            }
+            out->arg = NXLD_LOG_ARG_INT;
+            break;
+        case 's':
+            if (modified) {
+                return -1;
+            }
+            out->arg = NXLD_LOG_ARG_STRING;
+            break;
+        case 'p':
+            out->arg = NXLD_LOG_ARG_POINTER;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            out->arg = NXLD_LOG_ARG_DOUBLE;
+            break;
+        default:
+            return -1;
+    }
+    out->length = (size_t)(p + 1 - spec);
+    return 0;
+}
+
+/**
+ * @brief 解析格式字符串的参数列表 / Parse the argument list of a format string / Argumentliste einer Formatzeichenfolge parsen
+ */
+static void parse_format(log_format_t* entry, const char* format) {
+    entry->arg_count = 0;
+    entry->deferrable = strlen(format) <= NXLD_LOG_MESSAGE_SIZE - NXLD_LOG_RECORD_HEADER_SIZE - 4;
+    for (const char* p = format; entry->deferrable && *p != '\0'; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        nxld_log_conversion_t conversion;
+        size_t needed = 0;
+        if (nxld_log_scan_conversion(p, &conversion) != 0) {
+            entry->deferrable = 0;
+            break;
+        }
+        needed = (size_t)conversion.width_star + (size_t)conversion.precision_star +
+                 (conversion.arg != NXLD_LOG_ARG_NONE ? 1 : 0);
+        if (entry->arg_count + needed > MAX_FORMAT_ARGS) {
+            entry->deferrable = 0;
+            break;
+        }
+        if (conversion.width_star) {
+            entry->precision[entry->arg_count] = -1;
+            entry->args[entry->arg_count++] = NXLD_LOG_ARG_INT;
+        }
+        if (conversion.precision_star) {
+            entry->precision[entry->arg_count] = -1;
+            entry->args[entry->arg_count++] = NXLD_LOG_ARG_INT;
+        }
+        if (conversion.arg != NXLD_LOG_ARG_NONE) {
+            entry->precision[entry->arg_count] = (short)(conversion.precision_star ? -2 : conversion.precision);
+            entry->args[entry->arg_count++] = (unsigned char)conversion.arg;
+        }
+        p += conversion.length - 1;
+    }
+}
+
+/**
+ * @brief 查找或登记格式字符串 / Find or register a format string / Formatzeichenfolge suchen oder registrieren
+ * @param created 新登记且可延迟格式化时置1，调用方须写出格式定义 / Set to 1 when newly registered and deferrable, the caller must write the format definition / Wird auf 1 gesetzt, wenn neu registriert und aufschiebbar; der Aufrufer muss die Formatdefinition schreiben
+ * @return 格式条目，表已满时返回NULL / Format entry, NULL when the table is full / Formateintrag, NULL bei voller Tabelle
+ */
+static const log_format_t* find_format(const char* format, int* created) {
+    const size_t mask = ((size_t)1 << FORMAT_TABLE_BITS) - 1;
+    uint64_t key = (uint64_t)(uintptr_t)format;
+    size_t start = (size_t)((key * 0x9e3779b97f4a7c15ull) >> (64 - FORMAT_TABLE_BITS));
+
+    *created = 0;
+    for (size_t i = 0; i <= mask; i++) {
+        log_format_t* entry = &g_log_formats[(start + i) & mask];
+        uint64_t current = load_atomic(&entry->format);
+        if (current == key) {
+            return entry;
+        }
+        if (current == 0) {
+            break;
+        }
+    }
+
+    nxld_mutex_lock(&g_log_mutex);
+    log_format_t* found = NULL;
+    for (size_t i = 0; i <= mask; i++) {
+        log_format_t* entry = &g_log_formats[(start + i) & mask];
+        uint64_t current = load_atomic(&entry->format);
+        if (current == key) {
+            found = entry;
+            break;
+        }
+        // 装载率保持在3/4以下，满时按文本记录写出 / Keep the load factor under 3/4, a full table falls back to text records / Ladefaktor unter 3/4 halten, bei voller Tabelle werden Textdatensätze geschrieben
+        if (current == 0 && g_log_format_count < (mask + 1) / 4 * 3) {
+            parse_format(entry, format);
+            entry->id = ++g_log_format_count;
+            store_atomic(&entry->format, key);
+            *created = entry->deferrable;
+            found = entry;
+            break;
+        }
+        if (current == 0) {
+            break;
+        }
+    }
+    nxld_mutex_unlock(&g_log_mutex);
+    return found;
+}
+
+/**
+ * @brief 写入记录头 / Write record header / Datensatzkopf schreiben
+ */
+static void put_record_header(char* out, nxld_log_record_type_t type, nxld_log_level_t level, size_t length) {
+    uint16_t total = (uint16_t)length;
+    out[0] = (char)type;
+    out[1] = (char)level;
+    memcpy(out + 2, &total, sizeof(total));
+}
+
+/**
+ * @brief 编码格式定义记录 / Encode format definition record / Formatdefinitions-Datensatz kodieren
+ */
+static size_t encode_format_record(char* out, const log_format_t* entry, const char* format) {
+    size_t length = strlen(format);
+    memcpy(out + NXLD_LOG_RECORD_HEADER_SIZE, &entry->id, sizeof(entry->id));
+    memcpy(out + NXLD_LOG_RECORD_HEADER_SIZE + 4, format, length);
+    length += NXLD_LOG_RECORD_HEADER_SIZE + 4;
+    put_record_header(out, NXLD_LOG_RECORD_FORMAT, NXLD_LOG_LEVEL_INFO, length);
+    return length;
+}
+
+/**
+ * @brief 编码消息记录，只复制参数字节 / Encode message record, copying only the argument bytes / Nachrichtendatensatz kodieren, nur die Argumentbytes kopieren
+ * @return 记录长度，参数放不下时返回0 / Record length, 0 if the arguments do not fit / Datensatzlänge, 0 wenn die Argumente nicht passen
+ */
+static size_t encode_message_record(char* out, const log_format_t* entry, nxld_log_level_t level, va_list args) {
+    uint64_t now = nxld_metrics_now_ns();
+    size_t length = NXLD_LOG_RECORD_HEADER_SIZE;
+    memcpy(out + length, &entry->id, sizeof(entry->id));
+    length += sizeof(entry->id);
+    memcpy(out + length, &now, sizeof(now));
+    length += sizeof(now);
+
+    int last_int = -1;
+    for (size_t i = 0; i < entry->arg_count; i++) {
+        int64_t integer = 0;
+        double real = 0.0;
+        if (entry->args[i] == NXLD_LOG_ARG_STRING) {
+            const char* text = va_arg(args, const char*);
+            int precision = entry->precision[i] == -2 ? last_int : entry->precision[i];
+            uint16_t text_length = 0xFFFF;
+            size_t bytes = 0;
+            if (text != NULL) {
+                const char* end = precision >= 0 ? (const char*)memchr(text, '\0', (size_t)precision) : NULL;
+                bytes = precision >= 0 ? (end != NULL ? (size_t)(end - text) : (size_t)precision) : strlen(text);
+                if (bytes >= 0xFFFF) {
+                    return 0;
+                }
+                text_length = (uint16_t)bytes;
+            }
+            if (length + sizeof(text_length) + bytes > NXLD_LOG_MESSAGE_SIZE) {
+                return 0;
+            }
+            memcpy(out + length, &text_length, sizeof(text_length));
+            length += sizeof(text_length);
+            if (bytes > 0) {
+                memcpy(out + length, text, bytes);
+                length += bytes;
+            }
+            continue;
+        }
+
+        switch ((nxld_log_arg_t)entry->args[i]) {
+            case NXLD_LOG_ARG_INT:
+                last_int = va_arg(args, int);
+                integer = last_int;
+                break;
+            case NXLD_LOG_ARG_LONG:
+                integer = va_arg(args, long);
+                break;
+            case NXLD_LOG_ARG_LLONG:
+                integer = va_arg(args, long long);
+                break;
+            case NXLD_LOG_ARG_SIZE:
+                integer = (int64_t)va_arg(args, size_t);
+                break;
+            case NXLD_LOG_ARG_INTMAX:
+                integer = (int64_t)va_arg(args, intmax_t);
+                break;
+            case NXLD_LOG_ARG_PTRDIFF:
+                integer = (int64_t)va_arg(args, ptrdiff_t);
+                break;
+            case NXLD_LOG_ARG_POINTER:
+                integer = (int64_t)(uintptr_t)va_arg(args, void*);
+                break;
+            case NXLD_LOG_ARG_DOUBLE:
+                real = va_arg(args, double);
+                memcpy(&integer, &real, sizeof(integer));
+                break;
+            default:
+                return 0;
+        }
+        if (length + sizeof(integer) > NXLD_LOG_MESSAGE_SIZE) {
+            return 0;
+        }
+        memcpy(out + length, &integer, sizeof(integer));
+        length += sizeof(integer);
+    }
+
+    put_record_header(out, NXLD_LOG_RECORD_MESSAGE, level, length);
+    return length;
+}
+
+/**
+ * @brief 编码已格式化的文本记录 / Encode preformatted text record / Vorformatierten Textdatensatz kodieren
+ */
+static size_t encode_text_record(char* out, nxld_log_level_t level, const char* format, va_list args) {
+    uint64_t now = nxld_metrics_now_ns();
+    const size_t offset = NXLD_LOG_RECORD_HEADER_SIZE + sizeof(now);
+    memcpy(out + NXLD_LOG_RECORD_HEADER_SIZE, &now, sizeof(now));
+    int written = vsnprintf(out + offset, NXLD_LOG_MESSAGE_SIZE - offset, format, args);
+    size_t length = offset;
+    if (written > 0) {
+        length += (size_t)written < NXLD_LOG_MESSAGE_SIZE - offset ? (size_t)written : NXLD_LOG_MESSAGE_SIZE - offset - 1;
+    }
+    put_record_header(out, NXLD_LOG_RECORD_TEXT, level, length);
+    return length;
+}
+
+/**
+ * @brief 获取墙钟时间（纳秒） / Get wall clock time in nanoseconds / Wanduhrzeit in Nanosekunden abrufen
+ */
+static uint64_t wall_clock_ns(void) {
+#ifdef _WIN32
+    FILETIME file_time;
+    GetSystemTimeAsFileTime(&file_time);
+    uint64_t ticks = ((uint64_t)file_time.dwHighDateTime << 32) | file_time.dwLowDateTime;
+    // FILETIME从1601年起以100纳秒计 / FILETIME counts 100 ns ticks since 1601 / FILETIME zählt 100-ns-Takte seit 1601
+    return (ticks - 116444736000000000ull) * 100;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief 编码二进制会话头 / Encode binary session header / Binären Sitzungskopf kodieren
+ * @details 同时记录墙钟时间和单调计数，解码工具据此把时间计数换算为墙钟时间 / Records the wall clock together with the monotonic counter so the decoder can convert timestamp counters to wall clock time / Zeichnet die Wanduhrzeit zusammen mit dem monotonen Zähler auf, damit der Decoder Zeitstempelzähler in Wanduhrzeit umrechnen kann
+ */
+static void encode_session_header(char* out) {
+    uint32_t version = NXLD_LOG_BINARY_VERSION;
+    uint32_t byte_order = 0x01020304;
+    uint32_t reserved = 0;
+    uint64_t monotonic = nxld_metrics_now_ns();
+    uint64_t wall = wall_clock_ns();
+    memcpy(out, NXLD_LOG_BINARY_MAGIC, 4);
+    memcpy(out + 4, &version, 4);
+    memcpy(out + 8, &byte_order, 4);
+    memcpy(out + 12, &reserved, 4);
+    memcpy(out + 16, &wall, 8);
+    memcpy(out + 24, &monotonic, 8);
+}
+
+/**
+ * @brief 格式化写出线程自身的警告消息 / Format a warning message of the writer thread itself / Eine Warnmeldung des Schreib-Threads selbst formatieren
+ */
+static size_t format_warning(log_thread_t* thread, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t length = g_log_binary || g_log_plugin_batch ? encode_text_record(thread->text, NXLD_LOG_LEVEL_WARNING, format, args)
+                                 : format_message(thread, "WARNING", format, args);
+    va_end(args);
+    return length;
+}
+
+/**
+ * @brief 写入日志文件或当前段，不轮转 / Write to the log file or the active segment without rotating / In die Protokolldatei oder das aktive Segment schreiben, ohne zu rotieren
+ */
+static void sink_put(const char* data, size_t length) {
+    if (g_fallback_log_file != NULL) {
+        fwrite(data, 1, length, g_fallback_log_file);
+    } else {
+        nxld_log_segment_append(g_log_segment, data, length);
+    }
+}
+
+/**
+ * @brief 开始新段或改写的文件 / Start a new segment or the file written instead / Ein neues Segment oder die stattdessen geschriebene Datei beginnen
+ * @details 二进制编码先写会话头和所有已登记的格式定义，使其可单独解码；随后写出段模块无法自行记录的告警 / The binary encoding first writes a session header and every registered format definition so it decodes on its own; then the warnings the segment module cannot log itself are written / Die Binärkodierung schreibt zuerst einen Sitzungskopf und alle registrierten Formatdefinitionen, damit es einzeln dekodierbar ist; danach werden die Warnungen geschrieben, die das Segmentmodul nicht selbst protokollieren kann
+ */
+static void sink_begin(int mapped) {
+    if (g_log_binary) {
+        char record[NXLD_LOG_MESSAGE_SIZE];
+        encode_session_header(record);
+        sink_put(record, NXLD_LOG_BINARY_HEADER_SIZE);
+        for (size_t i = 0; i < (size_t)1 << FORMAT_TABLE_BITS; i++) {
+            const log_format_t* entry = &g_log_formats[i];
+            uint64_t format = load_atomic((log_atomic_t*)&entry->format);
+            if (format != 0) {
+                size_t record_length = encode_format_record(record, entry, (const char*)(uintptr_t)format);
+                sink_put(record, record_length);
+            }
+        }
+    }
+
+    log_thread_t local;
+    local.second = 0;
+    local.prefix_length = 0;
+    if (!mapped) {
+        sink_put(local.text, format_warning(&local, "Log segment %s could not be mapped, appending to it without segments",
+                                            nxld_log_segment_path(g_log_segment)));
+    }
+    size_t failures = nxld_log_segment_take_trim_failures(g_log_segment);
+    if (failures > 0) {
+        sink_put(local.text, format_warning(&local, "%zu log segments of %s could not be truncated and keep a zero-filled tail",
+                                            failures, nxld_log_segment_path(g_log_segment)));
+    }
+}
+
+/**
+ * @brief 写入日志文件或当前段 / Write to the log file or the active segment / In die Protokolldatei oder das aktive Segment schreiben
+ * @details 段模式下记录不跨段，段写满时轮转；新段无法映射时段被锁定，之后追加到当前段路径的普通文件，与不分段时相同。调用方须持有互斥锁或是唯一的写入方 / In segment mode records never span segments and a full segment rotates; when the new segment cannot be mapped the segment is latched and later writes append to a plain file at the active segment path, as without segments. Callers hold the mutex or are the only writer / Im Segmentmodus überspannen Datensätze nie Segmente, ein volles Segment rotiert; kann das neue Segment nicht abgebildet werden, wird das Segment gesperrt und spätere Schreibvorgänge hängen wie ohne Segmente an eine normale Datei am Pfad des aktiven Segments an. Aufrufer halten den Mutex oder sind der einzige Schreiber
+ */
+static void sink_write(const char* data, size_t length) {
+    if (g_fallback_log_file == NULL && nxld_log_segment_available(g_log_segment) < length) {
+        int mapped = nxld_log_segment_rotate(g_log_segment) == 0;
+        if (!mapped) {
+            g_fallback_log_file = fopen(nxld_log_segment_path(g_log_segment), "a");
+            if (g_fallback_log_file == NULL) {
+                return;
+            }
+        }
+        sink_begin(mapped);
+    }
+    sink_put(data, length);
+}
+
+/**
+ * @brief 刷新日志文件；段是共享映射，无需刷新 / Flush the log file; segments are shared mappings and need no flush / Protokolldatei leeren; Segmente sind gemeinsame Abbildungen und müssen nicht geleert werden
+ */
+static void sink_flush(void) {
+    if (g_fallback_log_file != NULL) {
+        fflush(g_fallback_log_file);
+    }
+}
+
+/**
+ * @brief 写出二进制会话头 / Write binary session header / Binären Sitzungskopf schreiben
+ */
+static void write_session_header(void) {
+    char header[NXLD_LOG_BINARY_HEADER_SIZE];
+    encode_session_header(header);
+    sink_write(header, sizeof(header));
+    sink_flush();
+}
 
-static void fallback_log_write(const char* level, const char* format, va_list args) {
-    if (g_fallback_log_file == NULL) {
+/**
+ * @brief 将消息放入环形缓冲区 / Push message onto the ring buffer / Nachricht in den Ringpuffer legen
+ * @param may_drop 缓冲区满时是否按策略丢弃；格式定义不可丢弃 / Whether the overflow policy may drop the record; format definitions must not be dropped / Ob die Überlaufstrategie den Datensatz verwerfen darf; Formatdefinitionen dürfen nicht verworfen werden
+ * @details 多个生产者通过比较交换争夺写入位置，之后只复制消息并发布槽序号 / Producers race for the write position with compare-and-swap, then only copy the message and publish the slot sequence / Produzenten konkurrieren per Compare-and-Swap um die Schreibposition und kopieren danach nur die Nachricht und veröffentlichen die Slot-Sequenz
+ */
+static void ring_push(const char* text, size_t length, int may_drop) {
+    for (;;) {
+        uint64_t position = load_atomic(&g_log_enqueue_position);
+        log_slot_t* slot = &g_log_ring[position & (NXLD_LOG_RING_SLOTS - 1)];
+        int64_t distance = (int64_t)(load_atomic(&slot->sequence) - position);
+        if (distance == 0) {
+            if (compare_exchange_atomic(&g_log_enqueue_position, position, position + 1)) {
+                memcpy(slot->text, text, length);
+                slot->length = length;
+                store_atomic(&slot->sequence, position + 1);
+                return;
+            }
+        } else if (distance < 0) {
+            // 槽仍保存上一轮的消息：缓冲区已满 / The slot still holds the previous lap's message: the ring is full / Der Slot enthält noch die Nachricht der vorherigen Runde: der Ring ist voll
+            if (may_drop && load_atomic(&g_log_overflow_policy) != (uint64_t)NXLD_LOG_OVERFLOW_BLOCK) {
+                increment_atomic(&g_log_dropped);
+                return;
+            }
+            yield_thread();
+        }
+    }
+}
+
+/**
+ * @brief 把一批文本记录交给日志插件 / Hand a batch of text records to the logger plugin / Einen Stapel Textdatensätze an das Logger-Plugin übergeben
+ * @param wall_base 写出线程启动时的墙钟时间 / Wall clock time when the writer started / Wanduhrzeit beim Start des Schreib-Threads
+ * @param monotonic_base 同一时刻的单调计数 / Monotonic counter at the same moment / Monotoner Zähler im selben Moment
+ */
+static void deliver_batch(const char* batch, size_t used, uint64_t wall_base, uint64_t monotonic_base) {
+    size_t count = 0;
+    size_t offset = 0;
+    while (offset < used) {
+        const char* record = batch + offset;
+        uint16_t length;
+        uint64_t timestamp;
+        memcpy(&length, record + 2, sizeof(length));
+        memcpy(&timestamp, record + NXLD_LOG_RECORD_HEADER_SIZE, sizeof(timestamp));
+        logger_record_t* out = &g_log_records[count++];
+        // 插件接口没有调试级别 / The plugin interface has no debug level / Die Plugin-Schnittstelle hat keine Debug-Ebene
+        out->level = (unsigned char)record[1] > NXLD_LOG_LEVEL_INFO ? LOGGER_LEVEL_INFO : (logger_level_t)record[1];
+        out->timestamp_ns = wall_base + (timestamp - monotonic_base);
+        out->text = record + NXLD_LOG_RECORD_HEADER_SIZE + sizeof(timestamp);
+        out->length = (size_t)length - NXLD_LOG_RECORD_HEADER_SIZE - sizeof(timestamp);
+        offset += length;
+    }
+    g_logger_plugin_write_batch_func(g_log_records, count);
+}
+
+/**
+ * @brief 在途的io_uring写入结构体 / In-flight io_uring write structure / Laufender io_uring-Schreibvorgang-Struktur
+ */
+typedef struct {
+    const char* data;                       /**< 数据（位于已注册的缓冲区内） / Data inside a registered buffer / Daten in einem registrierten Puffer */
+    size_t length;                          /**< 数据长度，0表示没有在途写入 / Data length, 0 when nothing is in flight / Datenlänge, 0 wenn nichts unterwegs ist */
+} log_flight_t;
+
+/**
+ * @brief 等待在途的写入完成 / Wait for the in-flight write to complete / Auf den Abschluss des laufenden Schreibvorgangs warten
+ * @param notice 写出线程的格式化缓冲区（可为NULL） / Writer thread formatting buffer (may be NULL) / Formatierungspuffer des Schreib-Threads (kann NULL sein)
+ * @details 短写入的剩余部分和失败的写入改为同步写出；收取完成事件失败时同步重写整批，记录一次警告并放弃io_uring / The rest of a short write and failed writes are written synchronously instead; when reaping the completion fails the whole batch is rewritten synchronously, one warning is logged and io_uring is given up / Der Rest eines kurzen Schreibvorgangs und fehlgeschlagene Schreibvorgänge werden stattdessen synchron geschrieben; schlägt das Abholen des Abschlusses fehl, wird der ganze Stapel synchron neu geschrieben, eine Warnung protokolliert und io_uring aufgegeben
+ */
+static void uring_wait(log_flight_t* flight, log_thread_t* notice) {
+    if (flight->length == 0) {
         return;
     }
-    
-    time_t now;
-    time(&now);
-    struct tm* timeinfo = localtime(&now);
-    char time_str[64];
-    strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", timeinfo);
-    
-    fprintf(g_fallback_log_file, "[%s] [%s] ", time_str, level);
-    vfprintf(g_fallback_log_file, format, args);
-    fprintf(g_fallback_log_file, "\n");
+    uint64_t user_data;
+    int32_t result;
+    int reaped = nxld_uring_complete(g_log_uring, 1, &user_data, &result);
+    if (reaped != 1) {
+        // 写入是否完成未知，宁可重复也不丢失 / Whether the write finished is unknown, so prefer a duplicate over a loss / Ob der Schreibvorgang fertig wurde, ist unbekannt, daher lieber doppelt als verloren
+        nxld_uring_destroy(g_log_uring);
+        g_log_uring = NULL;
+        fwrite(flight->data, 1, flight->length, g_fallback_log_file);
+        if (notice != NULL) {
+            size_t length = format_warning(notice, "io_uring completion failed, falling back to write()");
+            fwrite(notice->text, 1, length, g_fallback_log_file);
+        }
+        fflush(g_fallback_log_file);
+    } else if ((size_t)(result > 0 ? result : 0) < flight->length) {
+        size_t written = result > 0 ? (size_t)result : 0;
+        fwrite(flight->data + written, 1, flight->length - written, g_fallback_log_file);
+        fflush(g_fallback_log_file);
+    }
+    flight->length = 0;
+}
+
+/**
+ * @brief 通过io_uring写出一批 / Write a batch through io_uring / Einen Stapel über io_uring schreiben
+ * @details 同一时刻最多一次写入在途，日志顺序不变；提交后交换批量缓冲区，下一批在内核写入时收集 / At most one write is in flight at a time so the log order is kept; the batch buffers are swapped after submitting so the next batch is collected while the kernel writes / Höchstens ein Schreibvorgang ist gleichzeitig unterwegs, sodass die Protokollreihenfolge erhalten bleibt; nach dem Einreichen werden die Stapelpuffer getauscht, sodass der nächste Stapel gesammelt wird, während der Kernel schreibt
+ */
+static void uring_write(log_flight_t* flight, size_t used, log_thread_t* notice) {
+    uring_wait(flight, notice);
+    int buffer = g_log_batch == g_log_uring_buffers[0] ? 0 : 1;
+    // O_APPEND文件总是追加，偏移被忽略 / O_APPEND files always append and the offset is ignored / O_APPEND-Dateien hängen immer an, der Versatz wird ignoriert
+    if (g_log_uring == NULL || nxld_uring_prepare_write(g_log_uring, 0, buffer, g_log_batch, used, 0, 0) != 0) {
+        fwrite(g_log_batch, 1, used, g_fallback_log_file);
+        fflush(g_fallback_log_file);
+        return;
+    }
+    if (nxld_uring_submit(g_log_uring) != 1) {
+        // 条目仍在队列中，放弃io_uring以免重复写入 / The entry is still queued, so give up on io_uring to avoid a duplicate write / Der Eintrag ist noch eingereiht, daher io_uring aufgeben, um doppeltes Schreiben zu vermeiden
+        nxld_uring_destroy(g_log_uring);
+        g_log_uring = NULL;
+        fwrite(g_log_batch, 1, used, g_fallback_log_file);
+        fflush(g_fallback_log_file);
+        return;
+    }
+    flight->data = g_log_batch;
+    flight->length = used;
+    g_log_batch = g_log_batch_spare;
+    g_log_batch_spare = (char*)flight->data;
+}
+
+/**
+ * @brief 后台写出线程入口 / Background writer thread entry / Einstiegspunkt des Hintergrund-Schreib-Threads
+ * @details 把已发布的消息收集到批量缓冲区，每批只写入并刷新一次，或只调用一次插件的批量导出 / Collects published messages into the batch buffer and writes and flushes once per batch, or calls the plugin's batch export once / Sammelt veröffentlichte Nachrichten im Stapelpuffer und schreibt und leert einmal pro Stapel oder ruft den Stapel-Export des Plugins einmal auf
+ */
+static void writer_main(void* arg) {
+    (void)arg;
+    log_thread_t* notice = (log_thread_t*)calloc(1, sizeof(log_thread_t));
+    uint64_t position = 0;
+    uint64_t reported = 0;
+    uint64_t wall_base = wall_clock_ns();
+    uint64_t monotonic_base = nxld_metrics_now_ns();
+    log_flight_t flight = {NULL, 0};
+
+    for (;;) {
+        size_t used = 0;
+        // 段模式下直接从槽复制到映射，同步写入可能同时发生，因此持锁 / In segment mode slots are copied straight into the mapping; synchronous writes may happen concurrently, so hold the lock / Im Segmentmodus werden Slots direkt in die Abbildung kopiert; synchrone Schreibvorgänge können gleichzeitig stattfinden, daher die Sperre halten
+        int direct = g_log_segment != NULL && !g_log_plugin_batch;
+        if (direct) {
+            nxld_mutex_lock(&g_log_mutex);
+        }
+        // 留出一条消息的空间给丢弃通知 / Leave room for one message for the drop notice / Platz für eine Nachricht als Verwerfungshinweis lassen
+        while (used + 2 * NXLD_LOG_MESSAGE_SIZE <= WRITE_BATCH_SIZE) {
+            log_slot_t* slot = &g_log_ring[position & (NXLD_LOG_RING_SLOTS - 1)];
+            if (load_atomic(&slot->sequence) != position + 1) {
+                break;
+            }
+            if (direct) {
+                sink_write(slot->text, slot->length);
+            } else {
+                memcpy(g_log_batch + used, slot->text, slot->length);
+            }
+            used += slot->length;
+            store_atomic(&slot->sequence, position + NXLD_LOG_RING_SLOTS);
+            position++;
+        }
+
+        uint64_t dropped = load_atomic(&g_log_dropped);
+        if (dropped != reported && notice != NULL &&
+            load_atomic(&g_log_overflow_policy) == (uint64_t)NXLD_LOG_OVERFLOW_COUNT) {
+            size_t length = format_warning(notice, "%llu log messages dropped, ring buffer full",
+                                           (unsigned long long)(dropped - reported));
+            if (direct) {
+                sink_write(notice->text, length);
+            } else {
+                memcpy(g_log_batch + used, notice->text, length);
+            }
+            used += length;
+            reported = dropped;
+        }
+        if (direct) {
+            // 段失败后改写文件时才需要刷新 / Only needed once a failed segment switched to the file / Nur nötig, nachdem ein fehlgeschlagenes Segment auf die Datei umgeschaltet hat
+            sink_flush();
+            nxld_mutex_unlock(&g_log_mutex);
+        }
+
+        if (used > 0) {
+            if (g_log_plugin_batch) {
+                deliver_batch(g_log_batch, used, wall_base, monotonic_base);
+            } else if (g_log_uring != NULL) {
+                uring_write(&flight, used, notice);
+            } else if (!direct) {
+                fwrite(g_log_batch, 1, used, g_fallback_log_file);
+                fflush(g_fallback_log_file);
+            }
+            continue;
+        }
+        if (flight.length > 0) {
+            uring_wait(&flight, notice);
+            continue;
+        }
+        if (load_atomic(&g_log_stopping)) {
+            break;
+        }
+
+        // 生产者从不唤醒写出线程，空闲时短暂休眠，下一批在此期间累积 / Producers never wake the writer; it sleeps briefly when idle and the next batch accumulates meanwhile / Produzenten wecken den Schreib-Thread nie; er schläft im Leerlauf kurz, währenddessen sammelt sich der nächste Stapel
+        sleep_idle();
+    }
+    free(notice);
+}
+
+/**
+ * @brief 为日志文件建立io_uring / Set up io_uring for the log file / io_uring für die Protokolldatei einrichten
+ * @details 注册日志文件和两个批量缓冲区；不可用时保持write()路径 / Registers the log file and two batch buffers; the write() path is kept when unavailable / Registriert die Protokolldatei und zwei Stapelpuffer; ist es nicht verfügbar, bleibt der write()-Pfad
+ */
+static void start_uring(void) {
+    if (g_log_requested_io != NXLD_LOG_IO_URING || g_fallback_log_file == NULL || g_log_plugin_batch) {
+        return;
+    }
+    g_log_batch_spare = (char*)malloc(WRITE_BATCH_SIZE);
+    g_log_uring = g_log_batch_spare != NULL ? nxld_uring_create(4) : NULL;
+    if (g_log_uring == NULL) {
+        free(g_log_batch_spare);
+        g_log_batch_spare = NULL;
+        return;
+    }
+
     fflush(g_fallback_log_file);
+#ifdef _WIN32
+    int fd = _fileno(g_fallback_log_file);
+#else
+    int fd = fileno(g_fallback_log_file);
+#endif
+    g_log_uring_buffers[0] = g_log_batch;
+    g_log_uring_buffers[1] = g_log_batch_spare;
+    if (nxld_uring_register_files(g_log_uring, &fd, 1) != 0 ||
+        nxld_uring_register_buffers(g_log_uring, (void* const*)g_log_uring_buffers, WRITE_BATCH_SIZE, 2) != 0) {
+        nxld_uring_destroy(g_log_uring);
+        g_log_uring = NULL;
+        free(g_log_batch_spare);
+        g_log_batch_spare = NULL;
+    }
+}
+
+/**
+ * @brief 启动异步写出 / Start asynchronous writing / Asynchrones Schreiben starten
+ * @return 成功返回0，失败返回-1（此时同步写入） / Returns 0 on success, -1 on failure (writes are then synchronous) / Gibt 0 bei Erfolg zurück, -1 bei Fehler (dann wird synchron geschrieben)
+ */
+static int start_async(void) {
+    g_log_ring = (log_slot_t*)malloc(NXLD_LOG_RING_SLOTS * sizeof(log_slot_t));
+    g_log_batch = (char*)malloc(WRITE_BATCH_SIZE);
+    g_log_records = g_log_plugin_batch ? (logger_record_t*)malloc(MAX_BATCH_RECORDS * sizeof(logger_record_t)) : NULL;
+    if (g_log_ring == NULL || g_log_batch == NULL || (g_log_plugin_batch && g_log_records == NULL) ||
+        nxld_tls_create(&g_log_key) != 0) {
+        free(g_log_ring);
+        free(g_log_batch);
+        free(g_log_records);
+        g_log_ring = NULL;
+        g_log_batch = NULL;
+        g_log_records = NULL;
+        return -1;
+    }
+    for (size_t i = 0; i < NXLD_LOG_RING_SLOTS; i++) {
+        g_log_ring[i].sequence = i;
+    }
+    g_log_enqueue_position = 0;
+    g_log_stopping = 0;
+    g_log_threads = NULL;
+    start_uring();
+
+    if (nxld_thread_create(&g_log_writer, writer_main, NULL) != 0) {
+        nxld_tls_delete(g_log_key);
+        nxld_uring_destroy(g_log_uring);
+        free(g_log_ring);
+        free(g_log_batch);
+        free(g_log_batch_spare);
+        free(g_log_records);
+        g_log_uring = NULL;
+        g_log_ring = NULL;
+        g_log_batch = NULL;
+        g_log_batch_spare = NULL;
+        g_log_records = NULL;
+        return -1;
+    }
+    g_log_async = 1;
+    return 0;
+}
+
+/**
+ * @brief 写出剩余消息并停止异步写出 / Write the remaining messages and stop asynchronous writing / Verbleibende Nachrichten schreiben und asynchrones Schreiben stoppen
+ */
+static void stop_async(void) {
+    if (!g_log_async) {
+        return;
+    }
+
+    store_atomic(&g_log_stopping, 1);
+    nxld_thread_join(g_log_writer);
+    g_log_async = 0;
+
+    while (g_log_threads != NULL) {
+        log_thread_t* thread = g_log_threads;
+        g_log_threads = thread->next;
+        free(thread);
+    }
+    // 删除键使旧的线程局部指针失效 / Deleting the key invalidates stale thread-local pointers / Das Löschen des Schlüssels macht veraltete thread-lokale Zeiger ungültig
+    nxld_tls_delete(g_log_key);
+    nxld_uring_destroy(g_log_uring);
+    free(g_log_ring);
+    free(g_log_batch);
+    free(g_log_batch_spare);
+    free(g_log_records);
+    g_log_uring = NULL;
+    g_log_ring = NULL;
+    g_log_batch = NULL;
+    g_log_batch_spare = NULL;
+    g_log_records = NULL;
+}
+
+/**
+ * @brief 写出一条已编码的记录 / Emit one encoded record / Einen kodierten Datensatz ausgeben
+ * @param async 是否放入环形缓冲区 / Whether to push onto the ring buffer / Ob in den Ringpuffer gelegt wird
+ */
+static void emit_record(int async, const char* data, size_t length, int may_drop) {
+    if (async) {
+        ring_push(data, length, may_drop);
+        return;
+    }
+
+    // 没有后台线程或线程缓冲区时在锁内同步写入 / Without a background thread or thread buffer, write synchronously under the lock / Ohne Hintergrund-Thread oder Thread-Puffer synchron unter der Sperre schreiben
+    nxld_mutex_lock(&g_log_mutex);
+    sink_write(data, length);
+    sink_flush();
+    nxld_mutex_unlock(&g_log_mutex);
+}
+
+static void fallback_log_write(nxld_log_level_t level, const char* format, va_list args) {
+    // 段模式下写入方可能改设文件，因此先检查段 / In segment mode the writer may switch to the file, so check the segment first / Im Segmentmodus kann der Schreiber auf die Datei umschalten, daher zuerst das Segment prüfen
+    if (g_log_segment == NULL && g_fallback_log_file == NULL) {
+        return;
+    }
+
+    log_thread_t local;
+    log_thread_t* thread = g_log_async ? current_thread() : NULL;
+    int async = thread != NULL;
+    if (thread == NULL) {
+        local.prefix_length = 0;
+        thread = &local;
+    }
+
+    if (!g_log_binary) {
+        size_t length = format_message(thread, g_level_names[level], format, args);
+        emit_record(async, thread->text, length, 1);
+        return;
+    }
+
+    // 二进制模式只复制参数，格式化推迟到解码工具 / Binary mode only copies the arguments and leaves formatting to the decoder / Der Binärmodus kopiert nur die Argumente und überlässt das Formatieren dem Decoder
+    int created = 0;
+    const log_format_t* entry = g_log_formats != NULL ? find_format(format, &created) : NULL;
+    if (created) {
+        size_t length = encode_format_record(thread->text, entry, format);
+        emit_record(async, thread->text, length, 0);
+    }
+    size_t length = 0;
+    if (entry != NULL && entry->deferrable) {
+        va_list copy;
+        va_copy(copy, args);
+        length = encode_message_record(thread->text, entry, level, copy);
+        va_end(copy);
+    }
+    if (length == 0) {
+        length = encode_text_record(thread->text, level, format, args);
+    }
+    emit_record(async, thread->text, length, 1);
 }
 
 /**
  * @brief 加载日志插件 / Load logger plugin / Logger-Plugin laden
  * @param plugin_path 插件路径 / Plugin path / Plugin-Pfad
+ * @param config 传给插件初始化函数的配置字符串 / Configuration string passed to the plugin's init function / An die Init-Funktion des Plugins übergebene Konfigurationszeichenfolge
  * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
- * @details 动态加载日志插件库并获取函数指针 / Dynamically loads logger plugin library and obtains function pointers / Lädt Logger-Plugin-Bibliothek dynamisch und erhält Funktionszeiger
+ * @details 动态加载日志插件库并获取函数指针；只在重新配置期间调用 / Dynamically loads logger plugin library and obtains function pointers; only called during reconfiguration / Lädt Logger-Plugin-Bibliothek dynamisch und erhält Funktionszeiger; nur während der Neukonfiguration aufgerufen
  */
-static int load_logger_plugin(const char* plugin_path) {
+static int load_logger_plugin(const char* plugin_path, const char* config) {
     if (g_logger_plugin_loaded) {
         return 0;
     }
@@ -75,31 +1157,49 @@ static int load_logger_plugin(const char* plugin_path) {
     g_logger_plugin_init_func = (int (*)(const char*))GetProcAddress((HMODULE)g_logger_plugin_handle, "logger_plugin_init");
     g_logger_plugin_close_func = (void (*)(void))GetProcAddress((HMODULE)g_logger_plugin_handle, "logger_plugin_close");
     g_logger_plugin_write_func = (void (*)(logger_level_t, const char*, va_list))GetProcAddress((HMODULE)g_logger_plugin_handle, "logger_plugin_write");
+    g_logger_plugin_write_batch_func = (void (*)(const logger_record_t*, size_t))GetProcAddress((HMODULE)g_logger_plugin_handle, "logger_plugin_write_batch");
 #else
     g_logger_plugin_init_func = (int (*)(const char*))dlsym(g_logger_plugin_handle, "logger_plugin_init");
     g_logger_plugin_close_func = (void (*)(void))dlsym(g_logger_plugin_handle, "logger_plugin_close");
     g_logger_plugin_write_func = (void (*)(logger_level_t, const char*, va_list))dlsym(g_logger_plugin_handle, "logger_plugin_write");
+    g_logger_plugin_write_batch_func = (void (*)(const logger_record_t*, size_t))dlsym(g_logger_plugin_handle, "logger_plugin_write_batch");
 #endif
     
-    if (g_logger_plugin_init_func == NULL || g_logger_plugin_close_func == NULL || g_logger_plugin_write_func == NULL) {
+    if (g_logger_plugin_init_func == NULL || g_logger_plugin_close_func == NULL || g_logger_plugin_write_func == NULL ||
+        g_logger_plugin_init_func(config) != 0) {
 #ifdef _WIN32
         FreeLibrary((HMODULE)g_logger_plugin_handle);
 #else
         dlclose(g_logger_plugin_handle);
 #endif
         g_logger_plugin_handle = NULL;
+        g_logger_plugin_write_batch_func = NULL;
         return -1;
     }
     
     g_logger_plugin_loaded = 1;
+
+    // 插件支持批量写入时由后台线程整批交付；需要nxld_logger_init已初始化的互斥锁 / When the plugin supports batch writes the background thread delivers whole batches; this needs the mutex set up by nxld_logger_init / Unterstützt das Plugin Stapelschreiben, liefert der Hintergrund-Thread ganze Stapel; dies benötigt den von nxld_logger_init eingerichteten Mutex
+    if (g_logger_plugin_write_batch_func != NULL && (g_fallback_log_file != NULL || g_log_segment != NULL)) {
+        stop_async();
+        g_log_plugin_batch = 1;
+        if (start_async() != 0) {
+            g_log_plugin_batch = 0;
+        }
+    }
     return 0;
 }
 
 /**
  * @brief 卸载日志插件 / Unload logger plugin / Logger-Plugin entladen
- * @details 关闭插件并释放动态库句柄 / Closes plugin and releases dynamic library handle / Schließt Plugin und gibt dynamisches Bibliothekshandle frei
+ * @details 关闭插件并释放动态库句柄；只在重新配置期间调用 / Closes plugin and releases dynamic library handle; only called during reconfiguration / Schließt Plugin und gibt dynamisches Bibliothekshandle frei; nur während der Neukonfiguration aufgerufen
  */
 static void unload_logger_plugin(void) {
+    // 先把已排队的记录交给插件 / Deliver the queued records to the plugin first / Zuerst die eingereihten Datensätze an das Plugin liefern
+    if (g_log_plugin_batch) {
+        stop_async();
+        g_log_plugin_batch = 0;
+    }
     if (g_logger_plugin_handle != NULL) {
         if (g_logger_plugin_close_func != NULL) {
             g_logger_plugin_close_func();
@@ -115,66 +1215,279 @@ static void unload_logger_plugin(void) {
     g_logger_plugin_init_func = NULL;
     g_logger_plugin_close_func = NULL;
     g_logger_plugin_write_func = NULL;
+    g_logger_plugin_write_batch_func = NULL;
     g_logger_plugin_loaded = 0;
 }
 
-int nxld_logger_init(const char* log_file_path) {
-    const char* actual_log_path = log_file_path != NULL ? log_file_path : "nxld_parser.log";
-    
-    g_logger_plugin_loaded = 0;
+/**
+ * @brief 关闭日志文件或当前段 / Close the log file or the active segment / Protokolldatei oder aktives Segment schließen
+ */
+static void close_sink(void) {
+    if (g_log_segment != NULL) {
+        nxld_log_segment_close(g_log_segment);
+        g_log_segment = NULL;
+    }
     if (g_fallback_log_file != NULL) {
         fclose(g_fallback_log_file);
+        g_fallback_log_file = NULL;
     }
-    
-    g_fallback_log_file = fopen(actual_log_path, "a");
-    if (g_fallback_log_file == NULL) {
-        return -1;
+}
+
+/**
+ * @brief 关闭插件、后台线程和日志文件 / Shut down the plugin, the writer thread and the log file / Plugin, Schreib-Thread und Protokolldatei herunterfahren
+ * @param keep_plugin 非0时保留已加载的插件 / Keep a loaded plugin when non-zero / Ein geladenes Plugin behalten, wenn ungleich 0
+ * @details 只在重新配置期间调用；已排队的消息先写出 / Only called during reconfiguration; queued messages are written out first / Nur während der Neukonfiguration aufgerufen; eingereihte Nachrichten werden zuerst geschrieben
+ */
+static void shutdown_logger(int keep_plugin) {
+    if (g_logger_plugin_loaded && !keep_plugin) {
+        unload_logger_plugin();
+    }
+    if (g_fallback_log_file != NULL || g_log_segment != NULL) {
+        stop_async();
+        g_log_plugin_batch = 0;
+        free(g_log_formats);
+        g_log_formats = NULL;
+        nxld_mutex_destroy(&g_log_mutex);
+        close_sink();
+    }
+}
+
+int nxld_logger_load_plugin(const char* plugin_path, const char* config) {
+    log_route_t previous = begin_switch();
+    int result = load_logger_plugin(plugin_path, config);
+    if (result != 0 || previous == LOG_ROUTE_PLUGIN || previous == LOG_ROUTE_PLUGIN_BATCH) {
+        end_switch(previous);
+        return result;
+    }
+    // 切换之前入队的消息已写入文件，之后的消息全部交给插件 / Messages enqueued before the switch are already in the file, every later message goes to the plugin / Vor dem Umschalten eingereihte Nachrichten stehen bereits in der Datei, alle späteren gehen an das Plugin
+    end_switch(g_log_plugin_batch ? LOG_ROUTE_PLUGIN_BATCH : LOG_ROUTE_PLUGIN);
+    return 0;
+}
+
+int nxld_logger_init(const char* log_file_path) {
+    const char* actual_log_path = log_file_path != NULL ? log_file_path : "nxld_parser.log";
+
+    begin_switch();
+    shutdown_logger(1);
+
+    g_log_binary = g_log_requested_encoding == NXLD_LOG_ENCODING_BINARY;
+    if (g_log_segment_size > 0) {
+        g_log_segment = nxld_log_segment_open(actual_log_path, g_log_segment_size, g_log_segment_count, g_log_binary,
+                                              g_log_segment_compress);
+        if (g_log_segment == NULL) {
+            end_switch(g_logger_plugin_loaded ? LOG_ROUTE_PLUGIN : LOG_ROUTE_CLOSED);
+            return -1;
+        }
+    } else {
+        g_fallback_log_file = fopen(actual_log_path, "a");
+        if (g_fallback_log_file == NULL) {
+            end_switch(g_logger_plugin_loaded ? LOG_ROUTE_PLUGIN : LOG_ROUTE_CLOSED);
+            return -1;
+        }
     }
     
+    nxld_mutex_init(&g_log_mutex);
+    store_atomic(&g_log_dropped, 0);
+    if (g_log_binary) {
+        g_log_formats = (log_format_t*)calloc((size_t)1 << FORMAT_TABLE_BITS, sizeof(log_format_t));
+        g_log_format_count = 0;
+        write_session_header();
+    }
+    // 已加载的插件（包括初始化之前加载的）继续接收消息，支持批量写入时由新的后台线程整批交付 / A loaded plugin, including one loaded before initialization, keeps receiving messages; with batch writes the new background thread delivers whole batches / Ein geladenes Plugin, auch eines vor der Initialisierung geladenes, empfängt weiter Nachrichten; bei Stapelschreiben liefert der neue Hintergrund-Thread ganze Stapel
+    g_log_plugin_batch = g_logger_plugin_write_batch_func != NULL;
+    int async = start_async();
+    if (async != 0) {
+        g_log_plugin_batch = 0;
+    }
+    if (g_logger_plugin_loaded) {
+        end_switch(g_log_plugin_batch ? LOG_ROUTE_PLUGIN_BATCH : LOG_ROUTE_PLUGIN);
+    } else {
+        end_switch(LOG_ROUTE_FILE);
+    }
+    // 重新配置期间记录日志会等待自身，因此在发布路由之后告警 / Logging during reconfiguration would wait on itself, so warn after publishing the route / Protokollieren während der Neukonfiguration würde auf sich selbst warten, daher nach dem Veröffentlichen der Route warnen
+    if (async != 0) {
+        nxld_log_warning("Failed to start log writer thread, logging synchronously");
+    }
     return 0;
 }
 
 void nxld_logger_close(void) {
-    if (g_logger_plugin_loaded && g_logger_plugin_close_func != NULL) {
-        unload_logger_plugin();
-    } else {
-        if (g_fallback_log_file != NULL) {
-            fclose(g_fallback_log_file);
-            g_fallback_log_file = NULL;
+    begin_switch();
+    shutdown_logger(0);
+    end_switch(LOG_ROUTE_CLOSED);
+}
+
+void nxld_logger_set_overflow_policy(nxld_log_overflow_t policy) {
+    store_atomic(&g_log_overflow_policy, (uint64_t)policy);
+}
+
+void nxld_logger_set_segments(size_t segment_size, size_t segment_count) {
+    g_log_segment_size = segment_size;
+    g_log_segment_count = segment_count == 0 ? NXLD_LOG_SEGMENT_DEFAULT_COUNT : segment_count;
+}
+
+void nxld_logger_set_segment_compression(int enabled) {
+    g_log_segment_compress = enabled != 0;
+}
+
+void nxld_logger_set_io(nxld_log_io_t io) {
+    g_log_requested_io = io;
+}
+
+nxld_log_io_t nxld_logger_get_io(void) {
+    acquire_route();
+    nxld_log_io_t io = g_log_uring != NULL ? NXLD_LOG_IO_URING : NXLD_LOG_IO_WRITE;
+    release_route();
+    return io;
+}
+
+void nxld_logger_set_encoding(nxld_log_encoding_t encoding) {
+    g_log_requested_encoding = encoding;
+}
+
+/**
+ * @brief 重新计算各模块的生效阈值 / Recompute the effective threshold of every module / Wirksame Schwelle jedes Moduls neu berechnen
+ * @details 记录时只原子读取一个数组元素；级别可在其他线程记录日志时修改 / Logging then atomically reads a single array element; levels may change while other threads log / Beim Protokollieren wird dann nur ein Array-Element atomar gelesen; Ebenen dürfen sich ändern, während andere Threads protokollieren
+ */
+static void update_thresholds(void) {
+    for (int m = 0; m < NXLD_LOG_MODULE_COUNT; m++) {
+        int module_level = load_level(&g_log_module_levels[m]);
+        store_level(&g_log_thresholds[m], module_level >= 0 ? module_level : load_level(&g_log_level));
+    }
+}
+
+void nxld_logger_set_level(nxld_log_level_t level) {
+    store_level(&g_log_level, (int)level);
+    update_thresholds();
+}
+
+void nxld_logger_set_module_level(nxld_log_module_t module, int level) {
+    if ((unsigned int)module >= NXLD_LOG_MODULE_COUNT) {
+        return;
+    }
+    store_level(&g_log_module_levels[module], level < 0 ? -1 : level);
+    update_thresholds();
+}
+
+/**
+ * @brief 按名称查找表项（不区分大小写） / Look up table entry by name, ignoring case / Tabelleneintrag nach Namen suchen, ohne Groß-/Kleinschreibung
+ * @return 索引，未找到返回-1 / Index, -1 if not found / Index, -1 wenn nicht gefunden
+ */
+static int find_name(const char* const* names, int count, const char* name, size_t length) {
+    for (int i = 0; i < count; i++) {
+        size_t k = 0;
+        while (k < length && names[i][k] != '\0' &&
+               tolower((unsigned char)names[i][k]) == tolower((unsigned char)name[k])) {
+            k++;
+        }
+        if (k == length && names[i][k] == '\0') {
+            return i;
         }
     }
+    return -1;
 }
 
-void nxld_log_error(const char* format, ...) {
+int nxld_logger_parse_levels(const char* spec) {
+    int status = 0;
+    if (spec == NULL) {
+        return -1;
+    }
+
+    while (*spec != '\0') {
+        size_t length = strcspn(spec, ",");
+        const char* equals = (const char*)memchr(spec, '=', length);
+        if (equals == NULL) {
+            int level = find_name(g_level_names, NXLD_LOG_LEVEL_DEBUG + 1, spec, length);
+            if (level >= 0) {
+                nxld_logger_set_level((nxld_log_level_t)level);
+            } else if (length > 0) {
+                status = -1;
+            }
+        } else {
+            int module = find_name(g_module_names, NXLD_LOG_MODULE_COUNT, spec, (size_t)(equals - spec));
+            int level = find_name(g_level_names, NXLD_LOG_LEVEL_DEBUG + 1, equals + 1, length - (size_t)(equals - spec) - 1);
+            if (module >= 0 && level >= 0) {
+                nxld_logger_set_module_level((nxld_log_module_t)module, level);
+            } else {
+                status = -1;
+            }
+        }
+        spec += length;
+        if (*spec == ',') {
+            spec++;
+        }
+    }
+    return status;
+}
+
+uint64_t nxld_logger_get_dropped_count(void) {
+    return load_atomic(&g_log_dropped);
+}
+
+/**
+ * @brief 把消息交给日志插件或文件日志 / Hand message to the logger plugin or the file logger / Nachricht an das Logger-Plugin oder den Datei-Logger übergeben
+ * @details 持有路由句柄期间插件不会被卸载，文件也不会被关闭 / While the route handle is held the plugin is not unloaded and the file is not closed / Solange das Routen-Handle gehalten wird, wird das Plugin nicht entladen und die Datei nicht geschlossen
+ */
+static void log_dispatch(nxld_log_level_t level, const char* format, va_list args) {
+    log_route_t route = acquire_route();
+    if (route == LOG_ROUTE_PLUGIN_BATCH) {
+        // 调用线程只格式化并入队，不跨库调用 / The calling thread only formats and enqueues, without crossing the library boundary / Der aufrufende Thread formatiert und reiht nur ein, ohne die Bibliotheksgrenze zu überqueren
+        log_thread_t* thread = current_thread();
+        if (thread != NULL) {
+            size_t length = encode_text_record(thread->text, level, format, args);
+            ring_push(thread->text, length, 1);
+            release_route();
+            return;
+        }
+    }
+    if (route == LOG_ROUTE_PLUGIN || route == LOG_ROUTE_PLUGIN_BATCH) {
+        g_logger_plugin_write_func(level > NXLD_LOG_LEVEL_INFO ? LOGGER_LEVEL_INFO : (logger_level_t)level, format, args);
+    } else if (route == LOG_ROUTE_FILE) {
+        fallback_log_write(level, format, args);
+    }
+    release_route();
+}
+
+int nxld_log_enabled(nxld_log_module_t module, nxld_log_level_t level) {
+    return (unsigned int)module < NXLD_LOG_MODULE_COUNT && (int)level <= load_level(&g_log_thresholds[module]);
+}
+
+void nxld_log_write(nxld_log_module_t module, nxld_log_level_t level, const char* format, ...) {
+    if (!nxld_log_enabled(module, level)) {
+        return;
+    }
     va_list args;
     va_start(args, format);
-    if (g_logger_plugin_loaded && g_logger_plugin_write_func != NULL) {
-        g_logger_plugin_write_func(LOGGER_LEVEL_ERROR, format, args);
-    } else {
-        fallback_log_write("ERROR", format, args);
+    log_dispatch(level, format, args);
+    va_end(args);
+}
+
+void nxld_log_error(const char* format, ...) {
+    if (!nxld_log_enabled(NXLD_LOG_MODULE_GENERAL, NXLD_LOG_LEVEL_ERROR)) {
+        return;
     }
+    va_list args;
+    va_start(args, format);
+    log_dispatch(NXLD_LOG_LEVEL_ERROR, format, args);
     va_end(args);
 }
 
 void nxld_log_warning(const char* format, ...) {
+    if (!nxld_log_enabled(NXLD_LOG_MODULE_GENERAL, NXLD_LOG_LEVEL_WARNING)) {
+        return;
+    }
     va_list args;
     va_start(args, format);
-    if (g_logger_plugin_loaded && g_logger_plugin_write_func != NULL) {
-        g_logger_plugin_write_func(LOGGER_LEVEL_WARNING, format, args);
-    } else {
-        fallback_log_write("WARNING", format, args);
-    }
+    log_dispatch(NXLD_LOG_LEVEL_WARNING, format, args);
     va_end(args);
 }
 
 void nxld_log_info(const char* format, ...) {
+    if (!nxld_log_enabled(NXLD_LOG_MODULE_GENERAL, NXLD_LOG_LEVEL_INFO)) {
+        return;
+    }
     va_list args;
     va_start(args, format);
-    if (g_logger_plugin_loaded && g_logger_plugin_write_func != NULL) {
-        g_logger_plugin_write_func(LOGGER_LEVEL_INFO, format, args);
-    } else {
-        fallback_log_write("INFO", format, args);
-    }
+    log_dispatch(NXLD_LOG_LEVEL_INFO, format, args);
     va_end(args);
 }
-
@@ -9,19 +9,267 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
+
+/**
+ * @brief 日志级别 / Log level / Protokollierungsebene
+ * @details 数值与logger_level_t一致；DEBUG交给日志插件时按INFO处理 / Values match logger_level_t; DEBUG is passed to logger plugins as INFO / Werte entsprechen logger_level_t; DEBUG wird an Logger-Plugins als INFO übergeben
+ */
+typedef enum {
+    NXLD_LOG_LEVEL_ERROR = 0,               /**< 错误 / Error / Fehler */
+    NXLD_LOG_LEVEL_WARNING = 1,             /**< 警告 / Warning / Warnung */
+    NXLD_LOG_LEVEL_INFO = 2,                /**< 信息（默认阈值） / Info (default threshold) / Information (Standardschwelle) */
+    NXLD_LOG_LEVEL_DEBUG = 3                /**< 详细诊断 / Verbose diagnostics / Ausführliche Diagnose */
+} nxld_log_level_t;
+
+/**
+ * @brief 日志模块，每个模块可单独设置阈值 / Log module, each module may have its own threshold / Protokollmodul, jedes Modul kann eine eigene Schwelle haben
+ */
+typedef enum {
+    NXLD_LOG_MODULE_GENERAL = 0,            /**< 未归入模块的调用（nxld_log_error等） / Calls not assigned to a module (nxld_log_error and friends) / Keinem Modul zugeordnete Aufrufe (nxld_log_error usw.) */
+    NXLD_LOG_MODULE_PARSER,                 /**< 配置文件解析 / Config file parsing / Parsen der Konfigurationsdatei */
+    NXLD_LOG_MODULE_LOADER,                 /**< 根插件加载和.nxpt链式加载 / Root plugin loading and .nxpt chain loading / Laden der Root-Plugins und verkettetes .nxpt-Laden */
+    NXLD_LOG_MODULE_PLUGIN,                 /**< 动态库和元数据 / Dynamic libraries and metadata / Dynamische Bibliotheken und Metadaten */
+    NXLD_LOG_MODULE_DISPATCH,               /**< 执行计划和调用分派 / Execution plan and call dispatch / Ausführungsplan und Aufrufverteilung */
+    NXLD_LOG_MODULE_COUNT                   /**< 模块数量 / Module count / Modulanzahl */
+} nxld_log_module_t;
+
+/**
+ * @brief 编译期最低保留级别（0到3），高于它的NXLD_LOG_*调用在编译时删除 / Compile-time minimum level kept (0 to 3), NXLD_LOG_* calls above it are removed at compile time / Zur Kompilierzeit beibehaltene Mindestebene (0 bis 3), NXLD_LOG_*-Aufrufe darüber werden beim Kompilieren entfernt
+ * @details 例如 scons log_level=2 删除所有DEBUG调用 / For example scons log_level=2 removes every DEBUG call / Zum Beispiel entfernt scons log_level=2 jeden DEBUG-Aufruf
+ */
+#ifndef NXLD_LOG_COMPILE_LEVEL
+#define NXLD_LOG_COMPILE_LEVEL 3
+#endif
+
+/**
+ * @brief 按级别和模块记录日志 / Log at a level for a module / Auf einer Ebene für ein Modul protokollieren
+ * @details 参数只在级别通过时求值；级别高于NXLD_LOG_COMPILE_LEVEL时条件为常量0，调用连同参数被编译器删除 / Arguments are only evaluated when the level passes; above NXLD_LOG_COMPILE_LEVEL the condition is a constant 0 and the compiler drops the call with its arguments / Argumente werden nur ausgewertet, wenn die Ebene passiert; oberhalb von NXLD_LOG_COMPILE_LEVEL ist die Bedingung konstant 0 und der Compiler entfernt den Aufruf samt Argumenten
+ */
+#define NXLD_LOG_AT(level, module, ...)                                                    \
+    do {                                                                                   \
+        if ((level) <= NXLD_LOG_COMPILE_LEVEL && nxld_log_enabled((module), (level))) {    \
+            nxld_log_write((module), (level), __VA_ARGS__);                                \
+        }                                                                                  \
+    } while (0)
+
+#define NXLD_LOG_ERROR(module, ...) NXLD_LOG_AT(NXLD_LOG_LEVEL_ERROR, module, __VA_ARGS__)
+#define NXLD_LOG_WARNING(module, ...) NXLD_LOG_AT(NXLD_LOG_LEVEL_WARNING, module, __VA_ARGS__)
+#define NXLD_LOG_INFO(module, ...) NXLD_LOG_AT(NXLD_LOG_LEVEL_INFO, module, __VA_ARGS__)
+#define NXLD_LOG_DEBUG(module, ...) NXLD_LOG_AT(NXLD_LOG_LEVEL_DEBUG, module, __VA_ARGS__)
+
+/**
+ * @brief 日志环形缓冲区的槽数量（2的幂） / Slot count of the log ring buffer (power of two) / Slot-Anzahl des Protokoll-Ringpuffers (Zweierpotenz)
+ */
+#define NXLD_LOG_RING_SLOTS 1024
+
+/**
+ * @brief 单条日志消息的最大字节数（含时间戳和级别），更长的消息被截断 / Maximum bytes of one log message including timestamp and level, longer messages are truncated / Maximale Bytes einer Protokollnachricht inklusive Zeitstempel und Ebene, längere Nachrichten werden gekürzt
+ */
+#define NXLD_LOG_MESSAGE_SIZE 512
+
+/**
+ * @brief 环形缓冲区满时的处理策略 / Policy when the ring buffer is full / Strategie bei vollem Ringpuffer
+ */
+typedef enum {
+    NXLD_LOG_OVERFLOW_BLOCK = 0,            /**< 等待写出线程腾出空间（不丢消息） / Wait for the writer thread to make room (no message is lost) / Warten, bis der Schreib-Thread Platz schafft (keine Nachricht geht verloren) */
+    NXLD_LOG_OVERFLOW_DROP,                 /**< 丢弃新消息 / Drop the new message / Neue Nachricht verwerfen */
+    NXLD_LOG_OVERFLOW_COUNT                 /**< 丢弃新消息，并在日志中记录丢弃数量 / Drop the new message and record the drop count in the log / Neue Nachricht verwerfen und die Verwerfungsanzahl im Protokoll vermerken */
+} nxld_log_overflow_t;
+
+/**
+ * @brief 日志文件编码 / Log file encoding / Kodierung der Protokolldatei
+ */
+typedef enum {
+    NXLD_LOG_ENCODING_TEXT = 0,             /**< 在进程内格式化的文本行 / Text lines formatted in-process / Im Prozess formatierte Textzeilen */
+    NXLD_LOG_ENCODING_BINARY                /**< 格式字符串编号、时间计数和原始参数字节，由nxld_log_decode离线还原为文本 / Format string id, timestamp counter and raw argument bytes, turned back into text offline by nxld_log_decode / Formatzeichenfolgen-ID, Zeitstempelzähler und rohe Argumentbytes, offline von nxld_log_decode in Text zurückverwandelt */
+} nxld_log_encoding_t;
+
+/**
+ * @brief 日志文件写入方式 / Log file write backend / Schreib-Backend der Protokolldatei
+ */
+typedef enum {
+    NXLD_LOG_IO_WRITE = 0,                  /**< 每批一次write和刷新 / One write and flush per batch / Ein write und Leeren pro Stapel */
+    NXLD_LOG_IO_URING                       /**< 通过io_uring异步提交，使用已注册的文件和缓冲区（仅Linux） / Submitted asynchronously through io_uring with registered file and buffers (Linux only) / Asynchron über io_uring mit registrierter Datei und registrierten Puffern eingereicht (nur Linux) */
+} nxld_log_io_t;
+
+/**
+ * @brief 二进制日志会话头的魔数 / Magic of a binary log session header / Magische Zahl eines binären Protokoll-Sitzungskopfs
+ * @details 会话头共32字节：魔数、版本（uint32）、字节序标记0x01020304（uint32）、保留（uint32）、起始墙钟时间（uint64，纳秒）、起始单调时间计数（uint64，纳秒）；以追加方式打开的文件可包含多个会话 / The session header is 32 bytes: magic, version (uint32), byte order mark 0x01020304 (uint32), reserved (uint32), wall clock at start (uint64, ns), monotonic counter at start (uint64, ns); a file opened for appending may hold several sessions / Der Sitzungskopf hat 32 Bytes: magische Zahl, Version (uint32), Byte-Reihenfolge-Markierung 0x01020304 (uint32), reserviert (uint32), Wanduhrzeit beim Start (uint64, ns), monotoner Zähler beim Start (uint64, ns); eine im Anhängemodus geöffnete Datei kann mehrere Sitzungen enthalten
+ */
+#define NXLD_LOG_BINARY_MAGIC "NXLG"
+
+/**
+ * @brief 二进制日志格式版本 / Binary log format version / Version des binären Protokollformats
+ */
+#define NXLD_LOG_BINARY_VERSION 1
+
+/**
+ * @brief 二进制日志会话头长度 / Binary log session header length / Länge des binären Protokoll-Sitzungskopfs
+ */
+#define NXLD_LOG_BINARY_HEADER_SIZE 32
+
+/**
+ * @brief 二进制日志记录头长度 / Binary log record header length / Länge des binären Datensatzkopfs
+ */
+#define NXLD_LOG_RECORD_HEADER_SIZE 4
+
+/**
+ * @brief 二进制日志记录类型 / Binary log record type / Typ eines binären Protokolldatensatzes
+ * @details 每条记录以类型（uint8）、级别（uint8）和记录总长度（uint16）开头，多字节字段按写入机器的字节序存储 / Every record starts with type (uint8), level (uint8) and total record length (uint16); multi-byte fields use the writing machine's byte order / Jeder Datensatz beginnt mit Typ (uint8), Ebene (uint8) und Gesamtlänge (uint16); Mehrbytefelder verwenden die Byte-Reihenfolge der schreibenden Maschine
+ */
+typedef enum {
+    NXLD_LOG_RECORD_FORMAT = 1,             /**< 格式字符串定义：编号（uint32）和格式字符串 / Format string definition: id (uint32) and format string / Formatzeichenfolgen-Definition: ID (uint32) und Formatzeichenfolge */
+    NXLD_LOG_RECORD_MESSAGE,                /**< 消息：格式编号（uint32）、时间计数（uint64）和参数 / Message: format id (uint32), timestamp counter (uint64) and arguments / Nachricht: Format-ID (uint32), Zeitstempelzähler (uint64) und Argumente */
+    NXLD_LOG_RECORD_TEXT                    /**< 已格式化的消息：时间计数（uint64）和文本，用于无法延迟格式化的消息 / Preformatted message: timestamp counter (uint64) and text, for messages that cannot be deferred / Vorformatierte Nachricht: Zeitstempelzähler (uint64) und Text, für nicht aufschiebbare Nachrichten */
+} nxld_log_record_type_t;
+
+/**
+ * @brief 格式转换的参数类型 / Argument type of a format conversion / Argumenttyp einer Formatumwandlung
+ * @details 整数、指针和浮点参数在记录中各占8字节，字符串为长度（uint16，0xFFFF表示NULL）加内容 / Integer, pointer and floating-point arguments take 8 bytes each in a record, strings are a length (uint16, 0xFFFF for NULL) followed by the bytes / Ganzzahl-, Zeiger- und Gleitkommaargumente belegen je 8 Bytes im Datensatz, Zeichenfolgen eine Länge (uint16, 0xFFFF für NULL) gefolgt von den Bytes
+ */
+typedef enum {
+    NXLD_LOG_ARG_NONE = 0,                  /**< 不消耗参数（%%） / Consumes no argument (%%) / Verbraucht kein Argument (%%) */
+    NXLD_LOG_ARG_INT,                       /**< int（含char、short和*宽度） / int (including char, short and * widths) / int (inklusive char, short und *-Breiten) */
+    NXLD_LOG_ARG_LONG,                      /**< long */
+    NXLD_LOG_ARG_LLONG,                     /**< long long */
+    NXLD_LOG_ARG_SIZE,                      /**< size_t */
+    NXLD_LOG_ARG_INTMAX,                    /**< intmax_t */
+    NXLD_LOG_ARG_PTRDIFF,                   /**< ptrdiff_t */
+    NXLD_LOG_ARG_DOUBLE,                    /**< double */
+    NXLD_LOG_ARG_STRING,                    /**< const char* */
+    NXLD_LOG_ARG_POINTER                    /**< void* */
+} nxld_log_arg_t;
+
+/**
+ * @brief 格式转换描述结构体 / Format conversion description structure / Beschreibungsstruktur einer Formatumwandlung
+ */
+typedef struct {
+    size_t length;                          /**< 转换说明的字符数（从%开始） / Characters of the conversion specification starting at % / Zeichen der Umwandlungsangabe ab % */
+    nxld_log_arg_t arg;                     /**< 值参数类型 / Value argument type / Typ des Wertarguments */
+    int width_star;                         /**< 宽度由前一个int参数给出 / Width is given by a preceding int argument / Breite wird durch ein vorangehendes int-Argument angegeben */
+    int precision_star;                     /**< 精度由前一个int参数给出 / Precision is given by a preceding int argument / Genauigkeit wird durch ein vorangehendes int-Argument angegeben */
+    int precision;                          /**< 固定精度，-1表示未指定 / Fixed precision, -1 if absent / Feste Genauigkeit, -1 wenn nicht angegeben */
+} nxld_log_conversion_t;
 
 /**
  * @brief 初始化日志系统 / Initialize logging system / Protokollierungssystem initialisieren
  * @param log_file_path 日志文件路径 / Log file path / Protokollierungsdateipfad
  * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 调用线程只格式化消息并放入无锁环形缓冲区，后台线程批量写入文件；后台线程无法启动时同步写入。已初始化时先关闭原有的文件；已加载的日志插件（包括初始化之前加载的）保持加载并接收之后的消息；可与其他线程的日志调用并发，这些调用在切换期间短暂等待 / Calling threads only format messages and push them onto a lock-free ring buffer, a background thread writes them to the file in batches; writes synchronously if the background thread cannot start. If already initialized, the previous file is closed first; a loaded logger plugin, including one loaded before initialization, stays loaded and receives later messages; may run concurrently with logging on other threads, which wait briefly during the switch / Aufrufende Threads formatieren Nachrichten nur und legen sie in einen sperrfreien Ringpuffer, ein Hintergrund-Thread schreibt sie stapelweise in die Datei; schreibt synchron, wenn der Hintergrund-Thread nicht starten kann. Ist bereits initialisiert, wird die vorherige Datei zuerst geschlossen; ein geladenes Logger-Plugin, auch ein vor der Initialisierung geladenes, bleibt geladen und empfängt spätere Nachrichten; darf gleichzeitig mit Protokollaufrufen anderer Threads laufen, die während des Umschaltens kurz warten
  */
 int nxld_logger_init(const char* log_file_path);
 
 /**
  * @brief 关闭日志系统 / Close logging system / Protokollierungssystem schließen
+ * @details 等待正在进行的日志调用结束，写出缓冲区中剩余的消息后停止后台线程；之后的日志调用被丢弃 / Waits for logging calls in progress to finish, writes the messages still buffered, then stops the background thread; later logging calls are discarded / Wartet auf laufende Protokollaufrufe, schreibt die noch gepufferten Nachrichten und stoppt dann den Hintergrund-Thread; spätere Protokollaufrufe werden verworfen
  */
 void nxld_logger_close(void);
 
+/**
+ * @brief 加载日志插件 / Load logger plugin / Logger-Plugin laden
+ * @param plugin_path 插件路径 / Plugin path / Plugin-Pfad
+ * @param config 传给logger_plugin_init的配置字符串（可为NULL） / Configuration string passed to logger_plugin_init (may be NULL) / An logger_plugin_init übergebene Konfigurationszeichenfolge (kann NULL sein)
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 可在其他线程记录日志时调用：切换之前的消息写入日志文件，之后的消息全部交给插件，没有消息丢失或同时进入两处；已加载插件时不做任何事。插件由nxld_logger_close关闭 / May be called while other threads are logging: messages before the switch go to the log file and every later one to the plugin, none is lost or sent to both; does nothing if a plugin is already loaded. The plugin is closed by nxld_logger_close / Darf aufgerufen werden, während andere Threads protokollieren: Nachrichten vor dem Umschalten gehen in die Protokolldatei, alle späteren an das Plugin, keine geht verloren oder an beide; tut nichts, wenn bereits ein Plugin geladen ist. Das Plugin wird von nxld_logger_close geschlossen
+ */
+int nxld_logger_load_plugin(const char* plugin_path, const char* config);
+
+/**
+ * @brief 设置环形缓冲区满时的处理策略 / Set the policy when the ring buffer is full / Strategie bei vollem Ringpuffer festlegen
+ * @param policy 处理策略（默认NXLD_LOG_OVERFLOW_BLOCK） / Policy (default NXLD_LOG_OVERFLOW_BLOCK) / Strategie (Standard NXLD_LOG_OVERFLOW_BLOCK)
+ */
+void nxld_logger_set_overflow_policy(nxld_log_overflow_t policy);
+
+/**
+ * @brief 设置预分配的日志段 / Set preallocated log segments / Vorab reservierte Protokollsegmente festlegen
+ * @param segment_size 段大小（字节），0表示以追加方式写入单个无限增长的文件（默认） / Segment size in bytes, 0 to append to a single unbounded file (default) / Segmentgröße in Bytes, 0 zum Anhängen an eine einzelne unbegrenzte Datei (Standard)
+ * @param segment_count 保留的段数量（含当前段），0表示NXLD_LOG_SEGMENT_DEFAULT_COUNT / Number of segments kept including the active one, 0 for NXLD_LOG_SEGMENT_DEFAULT_COUNT / Anzahl aufbewahrter Segmente einschließlich des aktiven, 0 für NXLD_LOG_SEGMENT_DEFAULT_COUNT
+ * @details 在下一次nxld_logger_init时生效；段文件映射到内存，写入一条记录只是一次内存复制 / Takes effect on the next nxld_logger_init; segment files are mapped into memory so writing a record is a single memory copy / Wirkt ab dem nächsten nxld_logger_init; Segmentdateien werden in den Speicher abgebildet, sodass das Schreiben eines Datensatzes eine einzige Speicherkopie ist
+ */
+void nxld_logger_set_segments(size_t segment_size, size_t segment_count);
+
+/**
+ * @brief 设置是否压缩轮转出的日志段 / Set whether rotated log segments are compressed / Festlegen, ob rotierte Protokollsegmente komprimiert werden
+ * @param enabled 非0时写满的段在后台线程压缩为path.N.lz4（标准LZ4帧，lz4 -d可解压），nxld_log_decode可直接读取 / When non-zero, full segments are compressed into path.N.lz4 (standard LZ4 frames that lz4 -d decompresses) on a background thread; nxld_log_decode reads them directly / Wenn ungleich 0, werden volle Segmente in einem Hintergrund-Thread zu path.N.lz4 (Standard-LZ4-Rahmen, die lz4 -d dekomprimiert) komprimiert; nxld_log_decode liest sie direkt
+ * @details 只对nxld_logger_set_segments设置的段有效，在下一次nxld_logger_init时生效 / Applies only to segments set with nxld_logger_set_segments and takes effect on the next nxld_logger_init / Gilt nur für mit nxld_logger_set_segments festgelegte Segmente und wirkt ab dem nächsten nxld_logger_init
+ */
+void nxld_logger_set_segment_compression(int enabled);
+
+/**
+ * @brief 设置日志文件写入方式 / Set log file write backend / Schreib-Backend der Protokolldatei festlegen
+ * @param io 写入方式（默认NXLD_LOG_IO_WRITE），在下一次nxld_logger_init时生效 / Write backend (default NXLD_LOG_IO_WRITE), takes effect on the next nxld_logger_init / Schreib-Backend (Standard NXLD_LOG_IO_WRITE), wirkt ab dem nächsten nxld_logger_init
+ * @details io_uring不可用、使用预分配段或批量写入插件时仍用write() / write() is still used when io_uring is unavailable, with preallocated segments or with a batch-writing plugin / write() wird weiterhin verwendet, wenn io_uring nicht verfügbar ist, bei vorab reservierten Segmenten oder bei einem stapelschreibenden Plugin
+ */
+void nxld_logger_set_io(nxld_log_io_t io);
+
+/**
+ * @brief 获取实际使用的日志文件写入方式 / Get the log file write backend actually in use / Tatsächlich verwendetes Schreib-Backend der Protokolldatei abrufen
+ * @return 写入方式 / Write backend / Schreib-Backend
+ */
+nxld_log_io_t nxld_logger_get_io(void);
+
+/**
+ * @brief 设置日志文件编码 / Set log file encoding / Kodierung der Protokolldatei festlegen
+ * @param encoding 编码（默认NXLD_LOG_ENCODING_TEXT），在下一次nxld_logger_init时生效 / Encoding (default NXLD_LOG_ENCODING_TEXT), takes effect on the next nxld_logger_init / Kodierung (Standard NXLD_LOG_ENCODING_TEXT), wirkt ab dem nächsten nxld_logger_init
+ * @details 二进制编码按地址识别格式字符串，格式字符串须为字符串常量 / The binary encoding identifies format strings by address, so format strings must be string literals / Die binäre Kodierung erkennt Formatzeichenfolgen an ihrer Adresse, daher müssen Formatzeichenfolgen Zeichenfolgenkonstanten sein
+ */
+void nxld_logger_set_encoding(nxld_log_encoding_t encoding);
+
+/**
+ * @brief 解析一个格式转换说明 / Parse one format conversion specification / Eine Formatumwandlungsangabe parsen
+ * @param spec 指向%的指针 / Pointer at the % / Zeiger auf das %
+ * @param out 输出转换描述 / Output conversion description / Ausgabe der Umwandlungsbeschreibung
+ * @return 支持的转换返回0，不支持（如%n、%ls、%Lf）返回-1 / Returns 0 for a supported conversion, -1 for an unsupported one (such as %n, %ls, %Lf) / Gibt 0 für eine unterstützte Umwandlung zurück, -1 für eine nicht unterstützte (etwa %n, %ls, %Lf)
+ * @details 写入方和解码工具共用，保证两侧按相同方式读取参数 / Shared by the writer and the decoder so both sides read arguments the same way / Von Schreiber und Decoder gemeinsam genutzt, damit beide Seiten Argumente gleich lesen
+ */
+int nxld_log_scan_conversion(const char* spec, nxld_log_conversion_t* out);
+
+/**
+ * @brief 获取因环形缓冲区满而丢弃的消息数量 / Get the number of messages dropped because the ring buffer was full / Anzahl der wegen vollem Ringpuffer verworfenen Nachrichten abrufen
+ * @return 自初始化以来丢弃的消息数量 / Messages dropped since initialization / Seit der Initialisierung verworfene Nachrichten
+ */
+uint64_t nxld_logger_get_dropped_count(void);
+
+/**
+ * @brief 设置全局日志阈值 / Set global log threshold / Globale Protokollschwelle festlegen
+ * @param level 高于该级别的消息被丢弃（默认NXLD_LOG_LEVEL_INFO） / Messages above this level are discarded (default NXLD_LOG_LEVEL_INFO) / Nachrichten oberhalb dieser Ebene werden verworfen (Standard NXLD_LOG_LEVEL_INFO)
+ * @details 未单独设置阈值的模块使用全局阈值 / Modules without their own threshold use the global one / Module ohne eigene Schwelle verwenden die globale
+ */
+void nxld_logger_set_level(nxld_log_level_t level);
+
+/**
+ * @brief 设置模块日志阈值 / Set module log threshold / Protokollschwelle eines Moduls festlegen
+ * @param module 模块 / Module / Modul
+ * @param level 阈值，-1表示恢复使用全局阈值 / Threshold, -1 to fall back to the global threshold / Schwelle, -1 um wieder die globale Schwelle zu verwenden
+ */
+void nxld_logger_set_module_level(nxld_log_module_t module, int level);
+
+/**
+ * @brief 按文本设置日志阈值 / Set log thresholds from text / Protokollschwellen aus Text festlegen
+ * @param spec 逗号分隔的项，"level"设置全局阈值，"module=level"设置模块阈值，如"warning,loader=debug" / Comma-separated items, "level" sets the global threshold and "module=level" a module threshold, e.g. "warning,loader=debug" / Kommagetrennte Einträge, "level" setzt die globale Schwelle und "module=level" eine Modulschwelle, z. B. "warning,loader=debug"
+ * @return 成功返回0，有无法识别的项返回-1（其余项仍生效） / Returns 0 on success, -1 if an item is not recognized (the other items still apply) / Gibt 0 bei Erfolg zurück, -1 wenn ein Eintrag nicht erkannt wird (die übrigen gelten trotzdem)
+ * @details 级别为error、warning、info、debug，模块为general、parser、loader、plugin、dispatch / Levels are error, warning, info, debug; modules are general, parser, loader, plugin, dispatch / Ebenen sind error, warning, info, debug; Module sind general, parser, loader, plugin, dispatch
+ */
+int nxld_logger_parse_levels(const char* spec);
+
+/**
+ * @brief 判断级别是否会被记录 / Check whether a level would be logged / Prüfen, ob eine Ebene protokolliert würde
+ * @param module 模块 / Module / Modul
+ * @param level 级别 / Level / Ebene
+ * @return 会记录返回1，否则返回0 / Returns 1 if it would be logged, 0 otherwise / Gibt 1 zurück, wenn protokolliert würde, sonst 0
+ */
+int nxld_log_enabled(nxld_log_module_t module, nxld_log_level_t level);
+
+/**
+ * @brief 按级别和模块写入日志，通常经由NXLD_LOG_*宏调用 / Write log at a level for a module, usually called through the NXLD_LOG_* macros / Protokoll auf einer Ebene für ein Modul schreiben, meist über die NXLD_LOG_*-Makros aufgerufen
+ * @param module 模块 / Module / Modul
+ * @param level 级别 / Level / Ebene
+ * @param format 格式化字符串 / Format string / Formatzeichenfolge
+ * @param ... 可变参数 / Variable arguments / Variable Argumente
+ */
+void nxld_log_write(nxld_log_module_t module, nxld_log_level_t level, const char* format, ...);
+
 /**
  * @brief 写入错误日志 / Write error log / Fehlerprotokoll schreiben
  * @param format 格式化字符串 / Format string / Formatzeichenfolge
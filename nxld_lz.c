@@ -0,0 +1,369 @@
+/**
+ * @file nxld_lz.c
+ * @brief NXLD LZ压缩实现 / NXLD LZ Compression Implementation / NXLD-LZ-Kompressionsimplementierung
+ */
+
+#include "nxld_lz.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define LZ_MIN_MATCH 4
+#define LZ_LAST_LITERALS 5
+#define LZ_MATCH_LIMIT 12
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_BITS 12
+#define LZ_BLOCK_HEADER_SIZE 4
+#define LZ_FRAME_VERSION 0x40
+#define LZ_FLAG_BLOCK_INDEPENDENT 0x20
+#define LZ_FLAG_BLOCK_CHECKSUM 0x10
+#define LZ_FLAG_CONTENT_SIZE 0x08
+#define LZ_FLAG_CONTENT_CHECKSUM 0x04
+#define LZ_FLAG_DICTIONARY 0x01
+#define LZ_BLOCK_SIZE_CODE 5
+#define LZ_BLOCK_UNCOMPRESSED 0x80000000u
+#define LZ_XXH_PRIME1 2654435761u
+#define LZ_XXH_PRIME2 2246822519u
+#define LZ_XXH_PRIME3 3266489917u
+#define LZ_XXH_PRIME4 668265263u
+#define LZ_XXH_PRIME5 374761393u
+
+static uint32_t read32(const unsigned char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint32_t lz_hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+/**
+ * @brief 写出长度的扩展字节 / Write the extension bytes of a length / Erweiterungsbytes einer Länge schreiben
+ */
+static unsigned char* write_length(unsigned char* op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (unsigned char)length;
+    return op;
+}
+
+/**
+ * @brief 写出一个序列：字面量和之后的匹配 / Write one sequence: literals and the match after them / Eine Sequenz schreiben: Literale und die folgende Übereinstimmung
+ * @param match_length 匹配长度，0表示块末尾只有字面量 / Match length, 0 for the literals-only tail of a block / Übereinstimmungslänge, 0 für das reine Literal-Ende eines Blocks
+ */
+static unsigned char* write_sequence(unsigned char* op, const unsigned char* literals, size_t literal_length,
+                                     size_t offset, size_t match_length) {
+    unsigned char* token = op++;
+    *token = (unsigned char)((literal_length >= 15 ? 15 : literal_length) << 4);
+    if (literal_length >= 15) {
+        op = write_length(op, literal_length - 15);
+    }
+    memcpy(op, literals, literal_length);
+    op += literal_length;
+    if (match_length == 0) {
+        return op;
+    }
+
+    *op++ = (unsigned char)(offset & 0xFF);
+    *op++ = (unsigned char)(offset >> 8);
+    size_t code = match_length - LZ_MIN_MATCH;
+    *token |= (unsigned char)(code >= 15 ? 15 : code);
+    if (code >= 15) {
+        op = write_length(op, code - 15);
+    }
+    return op;
+}
+
+size_t nxld_lz_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t nxld_lz_compress_block(const void* src, size_t size, void* dst) {
+    const unsigned char* in = (const unsigned char*)src;
+    unsigned char* op = (unsigned char*)dst;
+    size_t anchor = 0;
+
+    // 表项保存位置加1，0表示空 / Entries hold position plus one, 0 means empty / Einträge enthalten Position plus eins, 0 bedeutet leer
+    uint32_t table[1 << LZ_HASH_BITS];
+    memset(table, 0, sizeof(table));
+
+    if (size > LZ_MATCH_LIMIT) {
+        // 格式要求最后一个匹配距块末尾至少12字节开始、至少5字节结束 / The format requires the last match to start at least 12 bytes and end at least 5 bytes before the block end / Das Format verlangt, dass die letzte Übereinstimmung mindestens 12 Bytes vor dem Blockende beginnt und mindestens 5 Bytes davor endet
+        size_t limit = size - LZ_MATCH_LIMIT;
+        size_t match_end_limit = size - LZ_LAST_LITERALS;
+        size_t ip = 0;
+        while (ip < limit) {
+            uint32_t sequence = read32(in + ip);
+            uint32_t h = lz_hash(sequence);
+            size_t candidate = table[h];
+            table[h] = (uint32_t)ip + 1;
+            if (candidate == 0 || ip - (candidate - 1) > LZ_MAX_OFFSET || read32(in + candidate - 1) != sequence) {
+                // 长时间没有匹配时加大步长，跳过难以压缩的数据 / Stride grows while nothing matches so incompressible data is skipped quickly / Die Schrittweite wächst, solange nichts passt, damit nicht komprimierbare Daten schnell übersprungen werden
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            size_t ref = candidate - 1;
+            while (ip > anchor && ref > 0 && in[ip - 1] == in[ref - 1]) {
+                ip--;
+                ref--;
+            }
+            size_t length = LZ_MIN_MATCH;
+            while (ip + length < match_end_limit && in[ip + length] == in[ref + length]) {
+                length++;
+            }
+            op = write_sequence(op, in + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+            if (ip - 2 < limit) {
+                table[lz_hash(read32(in + ip - 2))] = (uint32_t)(ip - 2) + 1;
+            }
+        }
+    }
+
+    op = write_sequence(op, in + anchor, size - anchor, 0, 0);
+    return (size_t)(op - (unsigned char*)dst);
+}
+
+/**
+ * @brief 读取长度的扩展字节 / Read the extension bytes of a length / Erweiterungsbytes einer Länge lesen
+ * @return 成功返回0，数据不足返回-1 / Returns 0 on success, -1 if data runs out / Gibt 0 bei Erfolg zurück, -1 wenn Daten fehlen
+ */
+static int read_length(const unsigned char** ip, const unsigned char* end, size_t* length) {
+    unsigned char byte;
+    do {
+        if (*ip >= end) {
+            return -1;
+        }
+        byte = *(*ip)++;
+        *length += byte;
+    } while (byte == 255);
+    return 0;
+}
+
+size_t nxld_lz_decompress_block(const void* src, size_t size, void* dst, size_t capacity) {
+    const unsigned char* ip = (const unsigned char*)src;
+    const unsigned char* end = ip + size;
+    unsigned char* out = (unsigned char*)dst;
+    size_t op = 0;
+
+    while (ip < end) {
+        unsigned char token = *ip++;
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && read_length(&ip, end, &literal_length) != 0) {
+            return (size_t)-1;
+        }
+        if (literal_length > (size_t)(end - ip) || literal_length > capacity - op) {
+            return (size_t)-1;
+        }
+        memcpy(out + op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+        if (ip == end) {
+            break;
+        }
+
+        if (end - ip < 2) {
+            return (size_t)-1;
+        }
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        size_t match_length = token & 15;
+        if (match_length == 15 && read_length(&ip, end, &match_length) != 0) {
+            return (size_t)-1;
+        }
+        match_length += LZ_MIN_MATCH;
+        if (offset == 0 || offset > op || match_length > capacity - op) {
+            return (size_t)-1;
+        }
+        // 匹配可与输出重叠（短偏移表示重复），逐字节复制 / Matches may overlap the output (a short offset means repetition), so copy byte by byte / Übereinstimmungen können die Ausgabe überlappen (kurzer Versatz bedeutet Wiederholung), daher byteweise kopieren
+        const unsigned char* match = out + op - offset;
+        for (size_t i = 0; i < match_length; i++) {
+            out[op + i] = match[i];
+        }
+        op += match_length;
+    }
+    return op;
+}
+
+static void write_le32(unsigned char* p, uint32_t value) {
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+    p[2] = (unsigned char)(value >> 16);
+    p[3] = (unsigned char)(value >> 24);
+}
+
+static uint32_t read_le32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t rotate_left(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+/**
+ * @brief 计算帧描述符的头校验 / Compute the header checksum of a frame descriptor / Kopfprüfsumme eines Rahmendeskriptors berechnen
+ * @details 种子为0的xxh32第二字节；描述符最长14字节，因此只需xxh32的短输入路径 / Second byte of xxh32 with seed 0; descriptors are at most 14 bytes, so only the short-input path of xxh32 is needed / Zweites Byte von xxh32 mit Seed 0; Deskriptoren sind höchstens 14 Bytes lang, daher genügt der Kurzeingabe-Pfad von xxh32
+ */
+static unsigned char header_checksum(const unsigned char* p, size_t length) {
+    uint32_t h = LZ_XXH_PRIME5 + (uint32_t)length;
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        h = rotate_left(h + read_le32(p + i) * LZ_XXH_PRIME3, 17) * LZ_XXH_PRIME4;
+    }
+    for (; i < length; i++) {
+        h = rotate_left(h + p[i] * LZ_XXH_PRIME5, 11) * LZ_XXH_PRIME1;
+    }
+    h ^= h >> 15;
+    h *= LZ_XXH_PRIME2;
+    h ^= h >> 13;
+    h *= LZ_XXH_PRIME3;
+    h ^= h >> 16;
+    return (unsigned char)(h >> 8);
+}
+
+/**
+ * @brief 解析帧头 / Parse a frame header / Rahmenkopf analysieren
+ * @param header_size 输出帧头大小 / Output frame header size / Ausgabe der Rahmenkopfgröße
+ * @param block_size 输出块的原始大小上限 / Output maximum raw block size / Ausgabe der maximalen Rohblockgröße
+ * @param flags 输出FLG字节 / Output FLG byte / Ausgabe des FLG-Bytes
+ * @return 可解压返回0，否则返回-1 / Returns 0 when decodable, -1 otherwise / Gibt 0 zurück, wenn dekodierbar, sonst -1
+ */
+static int parse_header(const unsigned char* frame, size_t size, size_t* header_size, size_t* block_size, unsigned char* flags) {
+    if (size < NXLD_LZ_HEADER_SIZE || read_le32(frame) != NXLD_LZ_MAGIC) {
+        return -1;
+    }
+    unsigned char flg = frame[4];
+    unsigned char bd = frame[5];
+    // 相互依赖的块需要跨块窗口，这里不支持 / Linked blocks need a window across blocks, which is not supported here / Verknüpfte Blöcke brauchen ein blockübergreifendes Fenster, das hier nicht unterstützt wird
+    if ((flg & 0xC2) != LZ_FRAME_VERSION || !(flg & LZ_FLAG_BLOCK_INDEPENDENT) || (bd & 0x8F) != 0 || (bd >> 4) < 4) {
+        return -1;
+    }
+    size_t descriptor = 2 + (flg & LZ_FLAG_CONTENT_SIZE ? 8 : 0) + (flg & LZ_FLAG_DICTIONARY ? 4 : 0);
+    if (size < 4 + descriptor + 1 || header_checksum(frame + 4, descriptor) != frame[4 + descriptor]) {
+        return -1;
+    }
+    *header_size = 4 + descriptor + 1;
+    *block_size = (size_t)1 << (8 + 2 * (bd >> 4));
+    *flags = flg;
+    return 0;
+}
+
+int nxld_lz_compress_file(const char* from, const char* to) {
+    FILE* in = fopen(from, "rb");
+    if (in == NULL) {
+        return -1;
+    }
+    FILE* out = fopen(to, "wb");
+    unsigned char* raw = (unsigned char*)malloc(NXLD_LZ_BLOCK_SIZE);
+    unsigned char* packed = (unsigned char*)malloc(LZ_BLOCK_HEADER_SIZE + nxld_lz_bound(NXLD_LZ_BLOCK_SIZE));
+    int status = out != NULL && raw != NULL && packed != NULL ? 0 : -1;
+
+    if (status == 0) {
+        unsigned char header[NXLD_LZ_HEADER_SIZE];
+        write_le32(header, NXLD_LZ_MAGIC);
+        header[4] = LZ_FRAME_VERSION | LZ_FLAG_BLOCK_INDEPENDENT;
+        header[5] = LZ_BLOCK_SIZE_CODE << 4;
+        header[6] = header_checksum(header + 4, 2);
+        if (fwrite(header, 1, sizeof(header), out) != sizeof(header)) {
+            status = -1;
+        }
+    }
+    // 块头为存储大小，最高位表示未压缩 / Block headers hold the stored size, the high bit marks a block stored uncompressed / Blockköpfe enthalten die Speichergröße, das höchste Bit kennzeichnet einen unkomprimiert gespeicherten Block
+    while (status == 0) {
+        size_t length = fread(raw, 1, NXLD_LZ_BLOCK_SIZE, in);
+        if (length == 0) {
+            unsigned char end_mark[LZ_BLOCK_HEADER_SIZE];
+            write_le32(end_mark, 0);
+            status = ferror(in) || fwrite(end_mark, 1, sizeof(end_mark), out) != sizeof(end_mark) ? -1 : 0;
+            break;
+        }
+        size_t stored = nxld_lz_compress_block(raw, length, packed + LZ_BLOCK_HEADER_SIZE);
+        uint32_t block_header = (uint32_t)stored;
+        if (stored >= length) {
+            memcpy(packed + LZ_BLOCK_HEADER_SIZE, raw, length);
+            stored = length;
+            block_header = (uint32_t)length | LZ_BLOCK_UNCOMPRESSED;
+        }
+        write_le32(packed, block_header);
+        if (fwrite(packed, 1, LZ_BLOCK_HEADER_SIZE + stored, out) != LZ_BLOCK_HEADER_SIZE + stored) {
+            status = -1;
+        }
+    }
+
+    free(raw);
+    free(packed);
+    fclose(in);
+    if (out != NULL && fclose(out) != 0) {
+        status = -1;
+    }
+    if (status != 0) {
+        remove(to);
+    }
+    return status;
+}
+
+int nxld_lz_is_frame(const void* data, size_t size) {
+    size_t header_size;
+    size_t block_size;
+    unsigned char flags;
+    return parse_header((const unsigned char*)data, size, &header_size, &block_size, &flags) == 0;
+}
+
+unsigned char* nxld_lz_decompress_frame(const void* data, size_t size, size_t* out_size, int* complete) {
+    const unsigned char* frame = (const unsigned char*)data;
+    size_t header_size;
+    size_t block_size;
+    unsigned char flags;
+    if (parse_header(frame, size, &header_size, &block_size, &flags) != 0) {
+        return NULL;
+    }
+    size_t block_trailer = flags & LZ_FLAG_BLOCK_CHECKSUM ? 4 : 0;
+
+    // 块头不含原始大小，先数出完整的块，按块大小上限分配一次 / Block headers do not hold the raw size, so count the whole blocks first and allocate once by the block size limit / Blockköpfe enthalten keine Rohgröße, daher zuerst die vollständigen Blöcke zählen und einmal nach der Blockgrößengrenze zuweisen
+    size_t blocks = 0;
+    size_t end = header_size;
+    while (size - end >= LZ_BLOCK_HEADER_SIZE) {
+        uint32_t stored = read_le32(frame + end) & ~LZ_BLOCK_UNCOMPRESSED;
+        if (stored == 0 || stored > block_size || block_trailer + stored > size - end - LZ_BLOCK_HEADER_SIZE) {
+            break;
+        }
+        blocks++;
+        end += LZ_BLOCK_HEADER_SIZE + stored + block_trailer;
+    }
+
+    unsigned char* out = (unsigned char*)malloc(blocks * block_size + 1);
+    if (out == NULL) {
+        return NULL;
+    }
+    size_t used = 0;
+    size_t offset = header_size;
+    while (offset < end) {
+        uint32_t header = read_le32(frame + offset);
+        uint32_t stored = header & ~LZ_BLOCK_UNCOMPRESSED;
+        const unsigned char* block = frame + offset + LZ_BLOCK_HEADER_SIZE;
+        size_t length = stored;
+        if (header & LZ_BLOCK_UNCOMPRESSED) {
+            memcpy(out + used, block, stored);
+        } else {
+            length = nxld_lz_decompress_block(block, stored, out + used, block_size);
+            if (length == (size_t)-1) {
+                break;
+            }
+        }
+        used += length;
+        offset += LZ_BLOCK_HEADER_SIZE + stored + block_trailer;
+    }
+
+    // 完整的帧以结束标记收尾，其后可能跟内容校验和 / A complete frame ends with the end mark, possibly followed by the content checksum / Ein vollständiger Rahmen endet mit der Endmarke, eventuell gefolgt von der Inhaltsprüfsumme
+    size_t tail = LZ_BLOCK_HEADER_SIZE + (flags & LZ_FLAG_CONTENT_CHECKSUM ? 4 : 0);
+    *out_size = used;
+    if (complete != NULL) {
+        *complete = offset == end && size - end == tail && read_le32(frame + end) == 0;
+    }
+    return out;
+}
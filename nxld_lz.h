@@ -0,0 +1,86 @@
+/**
+ * @file nxld_lz.h
+ * @brief NXLD LZ压缩接口 / NXLD LZ Compression Interface / NXLD-LZ-Kompressionsschnittstelle
+ * @details LZ4块格式的快速压缩：贪心哈希匹配，64KB窗口，解压只做复制；文件写成标准LZ4帧（256KB独立块，无校验和），lz4 -d可直接解压，可边读边压缩，截断时前面的块仍可解压 / Fast compression in the LZ4 block format: greedy hash matching, 64 KB window, decompression is plain copying; files are written as standard LZ4 frames (256 KB independent blocks, no checksums) that lz4 -d decompresses, so they can be compressed while reading and earlier blocks still decompress after truncation / Schnelle Kompression im LZ4-Blockformat: gierige Hash-Suche, 64-KB-Fenster, Dekompression ist reines Kopieren; Dateien werden als Standard-LZ4-Rahmen (unabhängige 256-KB-Blöcke, keine Prüfsummen) geschrieben, die lz4 -d dekomprimiert, sodass sie beim Lesen komprimiert werden können und frühere Blöcke nach einem Abschneiden weiterhin dekomprimierbar sind
+ */
+
+#ifndef NXLD_LZ_H
+#define NXLD_LZ_H
+
+#include <stddef.h>
+
+/**
+ * @brief LZ4帧魔数（小端） / LZ4 frame magic (little-endian) / LZ4-Rahmen-Magie (Little-Endian)
+ */
+#define NXLD_LZ_MAGIC 0x184D2204u
+
+/**
+ * @brief 写出的帧头大小（魔数、FLG、BD和头校验） / Size of the written frame header (magic, FLG, BD and header checksum) / Größe des geschriebenen Rahmenkopfs (Magie, FLG, BD und Kopfprüfsumme)
+ */
+#define NXLD_LZ_HEADER_SIZE 7
+
+/**
+ * @brief 帧内块的原始大小上限 / Maximum raw size of a block in a frame / Maximale Rohgröße eines Blocks im Rahmen
+ */
+#define NXLD_LZ_BLOCK_SIZE (256 * 1024)
+
+/**
+ * @brief 压缩文件的扩展名 / Extension of compressed files / Erweiterung komprimierter Dateien
+ */
+#define NXLD_LZ_EXTENSION ".lz4"
+
+/**
+ * @brief 获取压缩结果的最大大小 / Get the maximum size of a compressed result / Maximale Größe eines Kompressionsergebnisses abrufen
+ * @param size 原始大小 / Raw size / Rohgröße
+ * @return 输出缓冲区须有的字节数 / Bytes the output buffer must hold / Bytes, die der Ausgabepuffer fassen muss
+ */
+size_t nxld_lz_bound(size_t size);
+
+/**
+ * @brief 压缩一块数据 / Compress one block / Einen Block komprimieren
+ * @param src 原始数据 / Raw data / Rohdaten
+ * @param size 原始大小（不超过NXLD_LZ_BLOCK_SIZE） / Raw size (at most NXLD_LZ_BLOCK_SIZE) / Rohgröße (höchstens NXLD_LZ_BLOCK_SIZE)
+ * @param dst 输出缓冲区，至少nxld_lz_bound(size)字节 / Output buffer of at least nxld_lz_bound(size) bytes / Ausgabepuffer mit mindestens nxld_lz_bound(size) Bytes
+ * @return 压缩后的字节数 / Compressed byte count / Anzahl komprimierter Bytes
+ */
+size_t nxld_lz_compress_block(const void* src, size_t size, void* dst);
+
+/**
+ * @brief 解压一块数据 / Decompress one block / Einen Block dekomprimieren
+ * @param src 压缩数据 / Compressed data / Komprimierte Daten
+ * @param size 压缩大小 / Compressed size / Komprimierte Größe
+ * @param dst 输出缓冲区 / Output buffer / Ausgabepuffer
+ * @param capacity 输出缓冲区大小 / Output buffer size / Größe des Ausgabepuffers
+ * @return 解压后的字节数，数据损坏时返回(size_t)-1 / Decompressed byte count, (size_t)-1 on corrupt data / Anzahl dekomprimierter Bytes, (size_t)-1 bei beschädigten Daten
+ */
+size_t nxld_lz_decompress_block(const void* src, size_t size, void* dst, size_t capacity);
+
+/**
+ * @brief 把文件压缩为帧 / Compress a file into a frame / Eine Datei in einen Rahmen komprimieren
+ * @param from 源文件路径 / Source file path / Quelldateipfad
+ * @param to 目标文件路径（覆盖已有文件） / Destination file path (replaces an existing file) / Zieldateipfad (ersetzt eine vorhandene Datei)
+ * @return 成功返回0，失败返回-1（目标文件被删除） / Returns 0 on success, -1 on failure (the destination is removed) / Gibt 0 bei Erfolg zurück, -1 bei Fehler (das Ziel wird entfernt)
+ * @details 逐块读取和写出，内存占用与文件大小无关；无法压缩的块原样存储 / Reads and writes block by block, so memory use does not depend on the file size; blocks that do not compress are stored as is / Liest und schreibt blockweise, sodass der Speicherbedarf nicht von der Dateigröße abhängt; nicht komprimierbare Blöcke werden unverändert gespeichert
+ */
+int nxld_lz_compress_file(const char* from, const char* to);
+
+/**
+ * @brief 判断数据是否为可解压的LZ4帧 / Check whether data is an LZ4 frame this decoder handles / Prüfen, ob Daten ein LZ4-Rahmen sind, den dieser Decoder verarbeitet
+ * @param data 数据 / Data / Daten
+ * @param size 数据大小 / Data size / Datengröße
+ * @return 是帧返回1，否则返回0 / Returns 1 for a frame, 0 otherwise / Gibt 1 für einen Rahmen zurück, sonst 0
+ * @details 要求头校验正确且块相互独立；lz4命令行工具默认写出的帧也满足 / Requires a valid header checksum and independent blocks; frames written by the lz4 command line tool with default options qualify too / Verlangt eine gültige Kopfprüfsumme und unabhängige Blöcke; auch Rahmen, die das lz4-Kommandozeilenwerkzeug mit Standardoptionen schreibt, erfüllen dies
+ */
+int nxld_lz_is_frame(const void* data, size_t size);
+
+/**
+ * @brief 解压整个帧 / Decompress a whole frame / Einen ganzen Rahmen dekomprimieren
+ * @param data 帧数据 / Frame data / Rahmendaten
+ * @param size 帧大小 / Frame size / Rahmengröße
+ * @param out_size 输出解压后的大小 / Output decompressed size / Ausgabe der dekomprimierten Größe
+ * @param complete 输出帧是否完整（可为NULL），截断或损坏时只返回之前的块；块校验和与内容校验和被跳过，不做验证 / Output whether the frame is complete (may be NULL); on truncation or corruption only the preceding blocks are returned; block and content checksums are skipped, not verified / Ausgabe, ob der Rahmen vollständig ist (kann NULL sein); bei Abschneiden oder Beschädigung werden nur die vorherigen Blöcke zurückgegeben; Block- und Inhaltsprüfsummen werden übersprungen, nicht geprüft
+ * @return 解压后的数据（调用方释放），不是帧或内存不足时返回NULL / Decompressed data (freed by the caller), NULL if not a frame or out of memory / Dekomprimierte Daten (vom Aufrufer freigegeben), NULL wenn kein Rahmen oder kein Speicher
+ */
+unsigned char* nxld_lz_decompress_frame(const void* data, size_t size, size_t* out_size, int* complete);
+
+#endif /* NXLD_LZ_H */
@@ -0,0 +1,272 @@
+/**
+ * @file nxld_memo.c
+ * @brief NXLD纯接口结果缓存实现 / NXLD Pure Interface Result Cache Implementation / NXLD-Ergebniscache-Implementierung für reine Schnittstellen
+ */
+
+#include "nxld_memo.h"
+#include "nxld_thread.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SHARD_COUNT 16
+
+/**
+ * @brief 缓存条目结构体 / Cache entry structure / Cache-Eintragsstruktur
+ */
+typedef struct memo_entry {
+    struct memo_entry* chain;               /**< 同一哈希桶中的下一个条目 / Next entry in the same bucket / Nächster Eintrag im selben Bucket */
+    struct memo_entry* newer;               /**< LRU链表中较新的条目 / Newer entry in the LRU list / Neuerer Eintrag in der LRU-Liste */
+    struct memo_entry* older;               /**< LRU链表中较旧的条目 / Older entry in the LRU list / Älterer Eintrag in der LRU-Liste */
+    uint64_t hash;                          /**< 键哈希值 / Key hash / Schlüssel-Hash */
+    intptr_t value;                         /**< 缓存的结果 / Cached result / Zwischengespeichertes Ergebnis */
+    size_t length;                          /**< 键长度 / Key length / Schlüssellänge */
+    unsigned char key[];                    /**< 键字节 / Key bytes / Schlüsselbytes */
+} memo_entry_t;
+
+/**
+ * @brief 缓存分片结构体 / Cache shard structure / Cache-Shard-Struktur
+ */
+typedef struct {
+    nxld_mutex_t mutex;                     /**< 分片互斥锁 / Shard mutex / Shard-Mutex */
+    memo_entry_t** buckets;                 /**< 哈希桶数组 / Bucket array / Bucket-Array */
+    size_t bucket_mask;                     /**< 哈希桶数量减一 / Bucket count minus one / Bucket-Anzahl minus eins */
+    memo_entry_t* newest;                   /**< LRU链表头（最近使用） / LRU list head (most recently used) / LRU-Listenkopf (zuletzt verwendet) */
+    memo_entry_t* oldest;                   /**< LRU链表尾（最久未使用） / LRU list tail (least recently used) / LRU-Listenende (am längsten ungenutzt) */
+    size_t count;                           /**< 条目数量 / Entry count / Eintragsanzahl */
+    size_t capacity;                        /**< 条目容量 / Entry capacity / Eintragskapazität */
+    uint64_t hits;                          /**< 命中次数 / Hits / Treffer */
+    uint64_t misses;                        /**< 未命中次数 / Misses / Fehlschläge */
+    uint64_t evictions;                     /**< 淘汰次数 / Evictions / Verdrängungen */
+} memo_shard_t;
+
+/**
+ * @brief 结果缓存结构体 / Result cache structure / Ergebniscache-Struktur
+ */
+struct nxld_memo {
+    memo_shard_t* shards;                   /**< 分片数组 / Shard array / Shard-Array */
+    size_t shard_mask;                      /**< 分片数量减一 / Shard count minus one / Shard-Anzahl minus eins */
+    size_t capacity;                        /**< 总条目容量 / Total entry capacity / Gesamte Eintragskapazität */
+};
+
+/**
+ * @brief 从LRU链表中摘下条目 / Unlink entry from the LRU list / Eintrag aus der LRU-Liste aushängen
+ */
+static void lru_unlink(memo_shard_t* shard, memo_entry_t* entry) {
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        shard->newest = entry->older;
+    }
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        shard->oldest = entry->newer;
+    }
+    entry->newer = NULL;
+    entry->older = NULL;
+}
+
+/**
+ * @brief 将条目放到LRU链表头 / Push entry to the LRU list head / Eintrag an den LRU-Listenkopf setzen
+ */
+static void lru_push(memo_shard_t* shard, memo_entry_t* entry) {
+    entry->newer = NULL;
+    entry->older = shard->newest;
+    if (shard->newest != NULL) {
+        shard->newest->newer = entry;
+    } else {
+        shard->oldest = entry;
+    }
+    shard->newest = entry;
+}
+
+/**
+ * @brief 在分片中查找条目 / Find entry in a shard / Eintrag in einem Shard suchen
+ * @param link 输出指向该条目的链接，用于删除（可为NULL） / Output link pointing at the entry for removal (may be NULL) / Ausgabe des auf den Eintrag zeigenden Links zum Entfernen (kann NULL sein)
+ */
+static memo_entry_t* shard_find(memo_shard_t* shard, const void* key, size_t length, uint64_t hash, memo_entry_t*** link) {
+    memo_entry_t** slot = &shard->buckets[hash & shard->bucket_mask];
+    while (*slot != NULL) {
+        memo_entry_t* entry = *slot;
+        if (entry->hash == hash && entry->length == length && memcmp(entry->key, key, length) == 0) {
+            if (link != NULL) {
+                *link = slot;
+            }
+            return entry;
+        }
+        slot = &entry->chain;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 淘汰分片中最久未使用的条目 / Evict the least recently used entry of a shard / Den am längsten ungenutzten Eintrag eines Shards verdrängen
+ */
+static void shard_evict(memo_shard_t* shard) {
+    memo_entry_t* victim = shard->oldest;
+    memo_entry_t** link = NULL;
+    if (victim == NULL || shard_find(shard, victim->key, victim->length, victim->hash, &link) != victim) {
+        return;
+    }
+    *link = victim->chain;
+    lru_unlink(shard, victim);
+    free(victim);
+    shard->count--;
+    shard->evictions++;
+}
+
+/**
+ * @brief 选择键所在的分片 / Select the shard holding a key / Den Shard eines Schlüssels wählen
+ * @details 分片用哈希高位，哈希桶用低位，两者互不相关 / Shards use the high hash bits and buckets the low bits so the two stay independent / Shards verwenden die hohen Hash-Bits und Buckets die niedrigen, damit beide unabhängig bleiben
+ */
+static memo_shard_t* select_shard(nxld_memo_t* memo, uint64_t hash) {
+    return &memo->shards[(size_t)(hash >> 48) & memo->shard_mask];
+}
+
+nxld_memo_t* nxld_memo_create(size_t capacity) {
+    if (capacity == 0) {
+        capacity = NXLD_MEMO_DEFAULT_CAPACITY;
+    }
+
+    nxld_memo_t* memo = (nxld_memo_t*)calloc(1, sizeof(nxld_memo_t));
+    if (memo == NULL) {
+        return NULL;
+    }
+
+    // 分片数量取不超过容量的2的幂，小缓存不会因分片而浪费容量 / The shard count is a power of two no larger than the capacity so small caches lose no capacity to sharding / Die Shard-Anzahl ist eine Zweierpotenz nicht größer als die Kapazität, damit kleine Caches keine Kapazität durch Sharding verlieren
+    size_t shard_count = 1;
+    while (shard_count * 2 <= MAX_SHARD_COUNT && shard_count * 2 <= capacity) {
+        shard_count *= 2;
+    }
+    size_t shard_capacity = (capacity + shard_count - 1) / shard_count;
+    size_t bucket_count = 1;
+    while (bucket_count < shard_capacity * 2) {
+        bucket_count *= 2;
+    }
+
+    memo->shards = (memo_shard_t*)calloc(shard_count, sizeof(memo_shard_t));
+    if (memo->shards == NULL) {
+        free(memo);
+        return NULL;
+    }
+    memo->shard_mask = shard_count - 1;
+    memo->capacity = shard_capacity * shard_count;
+
+    for (size_t s = 0; s < shard_count; s++) {
+        memo_shard_t* shard = &memo->shards[s];
+        shard->buckets = (memo_entry_t**)calloc(bucket_count, sizeof(memo_entry_t*));
+        if (shard->buckets == NULL) {
+            for (size_t k = 0; k < s; k++) {
+                free(memo->shards[k].buckets);
+                nxld_mutex_destroy(&memo->shards[k].mutex);
+            }
+            free(memo->shards);
+            free(memo);
+            return NULL;
+        }
+        shard->bucket_mask = bucket_count - 1;
+        shard->capacity = shard_capacity;
+        nxld_mutex_init(&shard->mutex);
+    }
+    return memo;
+}
+
+void nxld_memo_destroy(nxld_memo_t* memo) {
+    if (memo == NULL) {
+        return;
+    }
+
+    for (size_t s = 0; s <= memo->shard_mask; s++) {
+        memo_shard_t* shard = &memo->shards[s];
+        memo_entry_t* entry = shard->newest;
+        while (entry != NULL) {
+            memo_entry_t* older = entry->older;
+            free(entry);
+            entry = older;
+        }
+        free(shard->buckets);
+        nxld_mutex_destroy(&shard->mutex);
+    }
+    free(memo->shards);
+    free(memo);
+}
+
+uint64_t nxld_memo_hash(const void* key, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)key;
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    // 混合高位，使分片选择也依赖所有字节 / Mix the high bits so shard selection also depends on every byte / Hohe Bits mischen, damit auch die Shard-Auswahl von jedem Byte abhängt
+    hash ^= hash >> 29;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+int nxld_memo_get(nxld_memo_t* memo, const void* key, size_t length, uint64_t hash, intptr_t* value) {
+    memo_shard_t* shard = select_shard(memo, hash);
+    nxld_mutex_lock(&shard->mutex);
+    memo_entry_t* entry = shard_find(shard, key, length, hash, NULL);
+    if (entry != NULL) {
+        if (shard->newest != entry) {
+            lru_unlink(shard, entry);
+            lru_push(shard, entry);
+        }
+        *value = entry->value;
+        shard->hits++;
+    } else {
+        shard->misses++;
+    }
+    nxld_mutex_unlock(&shard->mutex);
+    return entry != NULL;
+}
+
+void nxld_memo_put(nxld_memo_t* memo, const void* key, size_t length, uint64_t hash, intptr_t value) {
+    memo_shard_t* shard = select_shard(memo, hash);
+    nxld_mutex_lock(&shard->mutex);
+
+    // 并发未命中的调用可能已先插入同一个键 / A concurrent miss may already have inserted the same key / Ein gleichzeitiger Fehlschlag kann denselben Schlüssel bereits eingefügt haben
+    memo_entry_t* entry = shard_find(shard, key, length, hash, NULL);
+    if (entry != NULL) {
+        entry->value = value;
+        nxld_mutex_unlock(&shard->mutex);
+        return;
+    }
+
+    if (shard->count >= shard->capacity) {
+        shard_evict(shard);
+    }
+    entry = (memo_entry_t*)malloc(sizeof(memo_entry_t) + length);
+    if (entry != NULL) {
+        memcpy(entry->key, key, length);
+        entry->length = length;
+        entry->hash = hash;
+        entry->value = value;
+        memo_entry_t** bucket = &shard->buckets[hash & shard->bucket_mask];
+        entry->chain = *bucket;
+        *bucket = entry;
+        lru_push(shard, entry);
+        shard->count++;
+    }
+    nxld_mutex_unlock(&shard->mutex);
+}
+
+void nxld_memo_get_stats(nxld_memo_t* memo, nxld_memo_stats_t* out) {
+    memset(out, 0, sizeof(nxld_memo_stats_t));
+    if (memo == NULL) {
+        return;
+    }
+
+    out->capacity = memo->capacity;
+    for (size_t s = 0; s <= memo->shard_mask; s++) {
+        memo_shard_t* shard = &memo->shards[s];
+        nxld_mutex_lock(&shard->mutex);
+        out->hits += shard->hits;
+        out->misses += shard->misses;
+        out->evictions += shard->evictions;
+        out->entries += shard->count;
+        nxld_mutex_unlock(&shard->mutex);
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * @file nxld_memo.h
+ * @brief NXLD纯接口结果缓存接口 / NXLD Pure Interface Result Cache Interface / NXLD-Ergebniscache-Schnittstelle für reine Schnittstellen
+ * @details 按参数值字节串缓存返回值的分片LRU缓存；每个分片有自己的互斥锁，条目数量受容量限制 / Sharded LRU cache of return values keyed on argument value bytes; every shard has its own mutex and the entry count is bounded by the capacity / Geshardeter LRU-Cache von Rückgabewerten, geschlüsselt nach Argumentwert-Bytes; jeder Shard hat seinen eigenen Mutex und die Eintragsanzahl ist durch die Kapazität begrenzt
+ */
+
+#ifndef NXLD_MEMO_H
+#define NXLD_MEMO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 插件未声明容量时的默认条目数量 / Default entry count when the plugin declares no capacity / Standard-Eintragsanzahl, wenn das Plugin keine Kapazität deklariert
+ */
+#define NXLD_MEMO_DEFAULT_CAPACITY 1024
+
+/**
+ * @brief 可缓存的最大键长度（字节），更长的参数不缓存 / Maximum cacheable key length in bytes, longer arguments bypass the cache / Maximale zwischenspeicherbare Schlüssellänge in Bytes, längere Argumente umgehen den Cache
+ */
+#define NXLD_MEMO_MAX_KEY 1024
+
+/**
+ * @brief 结果缓存（不透明） / Result cache (opaque) / Ergebniscache (undurchsichtig)
+ */
+typedef struct nxld_memo nxld_memo_t;
+
+/**
+ * @brief 缓存统计结构体 / Cache statistics structure / Cache-Statistikstruktur
+ */
+typedef struct {
+    uint64_t hits;                          /**< 命中次数 / Hits / Treffer */
+    uint64_t misses;                        /**< 未命中次数 / Misses / Fehlschläge */
+    uint64_t evictions;                     /**< 淘汰的条目数量 / Entries evicted / Verdrängte Einträge */
+    size_t entries;                         /**< 当前条目数量 / Current entry count / Aktuelle Eintragsanzahl */
+    size_t capacity;                        /**< 条目容量 / Entry capacity / Eintragskapazität */
+} nxld_memo_stats_t;
+
+/**
+ * @brief 创建结果缓存 / Create result cache / Ergebniscache erstellen
+ * @param capacity 最大条目数量，0表示使用NXLD_MEMO_DEFAULT_CAPACITY / Maximum entry count, 0 for NXLD_MEMO_DEFAULT_CAPACITY / Maximale Eintragsanzahl, 0 für NXLD_MEMO_DEFAULT_CAPACITY
+ * @return 缓存指针，失败返回NULL / Cache pointer, NULL on failure / Cache-Zeiger, NULL bei Fehler
+ */
+nxld_memo_t* nxld_memo_create(size_t capacity);
+
+/**
+ * @brief 销毁结果缓存 / Destroy result cache / Ergebniscache zerstören
+ * @param memo 缓存指针（可为NULL） / Cache pointer (may be NULL) / Cache-Zeiger (kann NULL sein)
+ */
+void nxld_memo_destroy(nxld_memo_t* memo);
+
+/**
+ * @brief 计算键的哈希值 / Compute key hash / Schlüssel-Hash berechnen
+ * @param key 键字节 / Key bytes / Schlüsselbytes
+ * @param length 键长度 / Key length / Schlüssellänge
+ * @return 哈希值 / Hash value / Hashwert
+ */
+uint64_t nxld_memo_hash(const void* key, size_t length);
+
+/**
+ * @brief 查找缓存结果 / Look up cached result / Zwischengespeichertes Ergebnis suchen
+ * @param memo 缓存指针 / Cache pointer / Cache-Zeiger
+ * @param key 键字节 / Key bytes / Schlüsselbytes
+ * @param length 键长度 / Key length / Schlüssellänge
+ * @param hash nxld_memo_hash的返回值 / Value returned by nxld_memo_hash / Rückgabewert von nxld_memo_hash
+ * @param value 命中时输出结果 / Output result on hit / Ausgabe des Ergebnisses bei Treffer
+ * @return 命中返回1，未命中返回0 / Returns 1 on hit, 0 on miss / Gibt 1 bei Treffer zurück, 0 bei Fehlschlag
+ * @details 线程安全；命中的条目移到LRU头部 / Thread-safe; a hit moves the entry to the LRU head / Threadsicher; ein Treffer verschiebt den Eintrag an den LRU-Kopf
+ */
+int nxld_memo_get(nxld_memo_t* memo, const void* key, size_t length, uint64_t hash, intptr_t* value);
+
+/**
+ * @brief 插入或更新缓存结果 / Insert or update cached result / Zwischengespeichertes Ergebnis einfügen oder aktualisieren
+ * @param memo 缓存指针 / Cache pointer / Cache-Zeiger
+ * @param key 键字节 / Key bytes / Schlüsselbytes
+ * @param length 键长度 / Key length / Schlüssellänge
+ * @param hash nxld_memo_hash的返回值 / Value returned by nxld_memo_hash / Rückgabewert von nxld_memo_hash
+ * @param value 结果 / Result / Ergebnis
+ * @details 线程安全；分片已满时淘汰最久未使用的条目，内存不足时静默放弃 / Thread-safe; evicts the least recently used entry when the shard is full, silently gives up when out of memory / Threadsicher; verdrängt bei vollem Shard den am längsten ungenutzten Eintrag, gibt bei Speichermangel stillschweigend auf
+ */
+void nxld_memo_put(nxld_memo_t* memo, const void* key, size_t length, uint64_t hash, intptr_t value);
+
+/**
+ * @brief 获取缓存统计 / Get cache statistics / Cache-Statistik abrufen
+ * @param memo 缓存指针 / Cache pointer / Cache-Zeiger
+ * @param out 输出统计 / Output statistics / Ausgabestatistik
+ */
+void nxld_memo_get_stats(nxld_memo_t* memo, nxld_memo_stats_t* out);
+
+#endif /* NXLD_MEMO_H */
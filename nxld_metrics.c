@@ -0,0 +1,467 @@
+/**
+ * @file nxld_metrics.c
+ * @brief NXLD执行计数器与延迟直方图实现 / NXLD Execution Counters and Latency Histogram Implementation / NXLD-Implementierung der Ausführungszähler und Latenzhistogramme
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define SUB_BUCKET_COUNT (1u << NXLD_METRICS_SUB_BUCKET_BITS)
+#define SUB_BUCKET_HALF (SUB_BUCKET_COUNT / 2)
+#define MAX_TRACKED_NS ((1ull << NXLD_METRICS_MAX_BITS) - 1)
+
+/**
+ * @brief 写入分片结构体 / Writer shard structure / Schreiber-Shard-Struktur
+ * @details 分片只有一个写入线程，用宽松原子存储更新计数器，读取方用原子加载合并，写入路径不加锁 / A shard has a single writer thread that updates counters with relaxed atomic stores; readers merge with atomic loads, so the write path takes no lock / Ein Shard hat genau einen Schreiber-Thread, der Zähler mit entspannten atomaren Speicherungen aktualisiert; Leser führen mit atomaren Ladevorgängen zusammen, sodass der Schreibpfad keine Sperre nimmt
+ */
+struct nxld_metrics_shard {
+    nxld_metrics_series_t** series;         /**< 按需分配的序列（指针以释放语义发布） / Series allocated on demand (pointers published with release semantics) / Bei Bedarf zugewiesene Serien (Zeiger mit Release-Semantik veröffentlicht) */
+    size_t series_count;                    /**< 序列数量 / Series count / Anzahl der Serien */
+    unsigned int sample_interval;           /**< 采样间隔 / Sampling interval / Stichprobenintervall */
+    unsigned int* sample_countdown;         /**< 每个序列距下次计时的调用数（仅写入线程访问） / Calls until the next timed one per series (writer thread only) / Aufrufe bis zur nächsten Messung je Serie (nur Schreiber-Thread) */
+    struct nxld_metrics_shard* next;        /**< 下一个活动分片 / Next active shard / Nächster aktiver Shard */
+};
+
+#ifdef _WIN32
+static uint64_t load_counter(const uint64_t* value) {
+    return *(const volatile uint64_t*)value;
+}
+
+static void store_counter(uint64_t* value, uint64_t desired) {
+    *(volatile uint64_t*)value = desired;
+}
+
+static nxld_metrics_series_t* load_series(nxld_metrics_series_t** slot) {
+    return (nxld_metrics_series_t*)InterlockedCompareExchangePointer((PVOID volatile*)slot, NULL, NULL);
+}
+
+static void publish_series(nxld_metrics_series_t** slot, nxld_metrics_series_t* series) {
+    InterlockedExchangePointer((PVOID volatile*)slot, series);
+}
+#else
+static uint64_t load_counter(const uint64_t* value) {
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static void store_counter(uint64_t* value, uint64_t desired) {
+    __atomic_store_n(value, desired, __ATOMIC_RELAXED);
+}
+
+static nxld_metrics_series_t* load_series(nxld_metrics_series_t** slot) {
+    return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+}
+
+static void publish_series(nxld_metrics_series_t** slot, nxld_metrics_series_t* series) {
+    __atomic_store_n(slot, series, __ATOMIC_RELEASE);
+}
+#endif
+
+/**
+ * @brief 单写入方递增计数器 / Increment counter with a single writer / Zähler mit einem einzigen Schreiber erhöhen
+ * @details 只有写入线程存储，因此读-加-存无需原子读改写指令 / Only the writer thread stores, so load-add-store needs no atomic read-modify-write / Nur der Schreiber-Thread speichert, daher braucht Laden-Addieren-Speichern kein atomares Lesen-Ändern-Schreiben
+ */
+static void add_counter(uint64_t* value, uint64_t delta) {
+    store_counter(value, load_counter(value) + delta);
+}
+
+uint64_t nxld_metrics_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief 获取最高置位 / Get most significant set bit / Höchstes gesetztes Bit ermitteln
+ */
+static int highest_bit(uint64_t value) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief 计算延迟所在的桶 / Compute bucket for a latency / Bucket für eine Latenz berechnen
+ * @details 小于子桶数量的值线性存放，之后每个二次幂区间分为SUB_BUCKET_HALF个等宽子桶 / Values below the sub-bucket count are stored linearly, then every power-of-two range is split into SUB_BUCKET_HALF equal sub-buckets / Werte unter der Unter-Bucket-Anzahl werden linear abgelegt, danach wird jeder Zweierpotenzbereich in SUB_BUCKET_HALF gleich breite Unter-Buckets geteilt
+ */
+static size_t bucket_index(uint64_t value) {
+    if (value > MAX_TRACKED_NS) {
+        value = MAX_TRACKED_NS;
+    }
+    if (value < SUB_BUCKET_COUNT) {
+        return (size_t)value;
+    }
+    int shift = highest_bit(value) - (NXLD_METRICS_SUB_BUCKET_BITS - 1);
+    return (size_t)(shift + 1) * SUB_BUCKET_HALF + (size_t)((value >> shift) - SUB_BUCKET_HALF);
+}
+
+/**
+ * @brief 计算桶的上界 / Compute upper bound of a bucket / Obergrenze eines Buckets berechnen
+ */
+static uint64_t bucket_upper_bound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return (uint64_t)index;
+    }
+    int shift = (int)(index / SUB_BUCKET_HALF) - 1;
+    uint64_t sub = (uint64_t)(index % SUB_BUCKET_HALF) + SUB_BUCKET_HALF;
+    return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief 将序列累加到目标 / Accumulate series into target / Serie in Ziel aufsummieren
+ */
+static void merge_series(nxld_metrics_series_t* target, const nxld_metrics_series_t* source) {
+    if (source->timed > 0) {
+        if (target->timed == 0 || source->min_ns < target->min_ns) {
+            target->min_ns = source->min_ns;
+        }
+        if (source->max_ns > target->max_ns) {
+            target->max_ns = source->max_ns;
+        }
+    }
+    target->calls += source->calls;
+    target->errors += source->errors;
+    target->skips += source->skips;
+    target->bytes += source->bytes;
+    target->timed += source->timed;
+    target->total_ns += source->total_ns;
+    for (size_t i = 0; i < NXLD_METRICS_BUCKET_COUNT; i++) {
+        target->counts[i] += source->counts[i];
+    }
+}
+
+/**
+ * @brief 用原子加载将活动分片的序列累加到目标 / Accumulate a live shard series into target using atomic loads / Serie eines aktiven Shards mit atomaren Ladevorgängen in Ziel aufsummieren
+ * @details 写入线程可能同时更新，快照中各字段之间可能相差正在进行的几次调用 / The writer may be updating concurrently, so fields in the snapshot can differ by the calls in flight / Der Schreiber kann gleichzeitig aktualisieren, daher können Felder der Momentaufnahme um laufende Aufrufe abweichen
+ */
+static void merge_live_series(nxld_metrics_series_t* target, const nxld_metrics_series_t* source) {
+    // 最小值初始为UINT64_MAX，读到它说明首个样本尚未可见 / The minimum starts at UINT64_MAX, reading it means the first sample is not visible yet / Das Minimum beginnt bei UINT64_MAX; wird es gelesen, ist der erste Messwert noch nicht sichtbar
+    uint64_t timed = load_counter(&source->timed);
+    uint64_t min_ns = load_counter(&source->min_ns);
+    if (timed > 0 && min_ns != UINT64_MAX) {
+        uint64_t max_ns = load_counter(&source->max_ns);
+        if (target->timed == 0 || min_ns < target->min_ns) {
+            target->min_ns = min_ns;
+        }
+        if (max_ns > target->max_ns) {
+            target->max_ns = max_ns;
+        }
+    }
+    target->calls += load_counter(&source->calls);
+    target->errors += load_counter(&source->errors);
+    target->skips += load_counter(&source->skips);
+    target->bytes += load_counter(&source->bytes);
+    target->timed += timed;
+    target->total_ns += load_counter(&source->total_ns);
+    for (size_t i = 0; i < NXLD_METRICS_BUCKET_COUNT; i++) {
+        target->counts[i] += load_counter(&source->counts[i]);
+    }
+}
+
+/**
+ * @brief 释放序列指针数组 / Free series pointer array / Serienzeiger-Array freigeben
+ */
+static void free_series_array(nxld_metrics_series_t** series, size_t count) {
+    if (series == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        free(series[i]);
+    }
+    free(series);
+}
+
+nxld_metrics_t* nxld_metrics_create(size_t series_count, unsigned int sample_interval) {
+    nxld_metrics_t* metrics = (nxld_metrics_t*)calloc(1, sizeof(nxld_metrics_t));
+    if (metrics == NULL) {
+        return NULL;
+    }
+
+    metrics->retired = (nxld_metrics_series_t**)calloc(series_count + 1, sizeof(nxld_metrics_series_t*));
+    if (metrics->retired == NULL) {
+        free(metrics);
+        return NULL;
+    }
+    metrics->series_count = series_count;
+    metrics->sample_interval = sample_interval > 0 ? sample_interval : 1;
+    nxld_mutex_init(&metrics->mutex);
+    return metrics;
+}
+
+void nxld_metrics_destroy(nxld_metrics_t* metrics) {
+    if (metrics == NULL) {
+        return;
+    }
+
+    nxld_metrics_shard_t* shard = metrics->shards;
+    while (shard != NULL) {
+        nxld_metrics_shard_t* next = shard->next;
+        free_series_array(shard->series, shard->series_count);
+        free(shard->sample_countdown);
+        free(shard);
+        shard = next;
+    }
+    free_series_array(metrics->retired, metrics->series_count);
+    nxld_mutex_destroy(&metrics->mutex);
+    free(metrics);
+}
+
+nxld_metrics_shard_t* nxld_metrics_shard_acquire(nxld_metrics_t* metrics) {
+    if (metrics == NULL) {
+        return NULL;
+    }
+
+    nxld_metrics_shard_t* shard = (nxld_metrics_shard_t*)calloc(1, sizeof(nxld_metrics_shard_t));
+    if (shard == NULL) {
+        return NULL;
+    }
+    shard->series = (nxld_metrics_series_t**)calloc(metrics->series_count + 1, sizeof(nxld_metrics_series_t*));
+    shard->sample_countdown = (unsigned int*)calloc(metrics->series_count + 1, sizeof(unsigned int));
+    if (shard->series == NULL || shard->sample_countdown == NULL) {
+        free(shard->series);
+        free(shard->sample_countdown);
+        free(shard);
+        return NULL;
+    }
+    shard->series_count = metrics->series_count;
+    shard->sample_interval = metrics->sample_interval;
+
+    nxld_mutex_lock(&metrics->mutex);
+    shard->next = metrics->shards;
+    metrics->shards = shard;
+    nxld_mutex_unlock(&metrics->mutex);
+    return shard;
+}
+
+void nxld_metrics_shard_release(nxld_metrics_t* metrics, nxld_metrics_shard_t* shard) {
+    if (metrics == NULL || shard == NULL) {
+        return;
+    }
+
+    nxld_mutex_lock(&metrics->mutex);
+    for (nxld_metrics_shard_t** link = &metrics->shards; *link != NULL; link = &(*link)->next) {
+        if (*link == shard) {
+            *link = shard->next;
+            break;
+        }
+    }
+
+    // 已释放分片的数据并入retired，读取结果不随上下文销毁而丢失 / Data of released shards is folded into retired so reads do not lose it when a context goes away / Daten freigegebener Shards gehen in retired ein, damit Lesevorgänge sie beim Verschwinden eines Kontexts nicht verlieren
+    for (size_t i = 0; i < shard->series_count; i++) {
+        if (shard->series[i] == NULL) {
+            continue;
+        }
+        if (metrics->retired[i] == NULL) {
+            metrics->retired[i] = shard->series[i];
+            shard->series[i] = NULL;
+        } else {
+            merge_series(metrics->retired[i], shard->series[i]);
+        }
+    }
+    nxld_mutex_unlock(&metrics->mutex);
+
+    free_series_array(shard->series, shard->series_count);
+    free(shard->sample_countdown);
+    free(shard);
+}
+
+int nxld_metrics_sample(nxld_metrics_shard_t* shard, size_t series) {
+    if (shard == NULL || series >= shard->series_count) {
+        return 0;
+    }
+    // 每个序列在分片中的第一次调用总是计时 / The first call of every series in a shard is always timed / Der erste Aufruf jeder Serie in einem Shard wird immer gemessen
+    if (shard->sample_countdown[series] == 0) {
+        shard->sample_countdown[series] = shard->sample_interval - 1;
+        return 1;
+    }
+    shard->sample_countdown[series]--;
+    return 0;
+}
+
+/**
+ * @brief 获取分片中的序列，必要时分配 / Get series in shard, allocating if needed / Serie im Shard abrufen, bei Bedarf zuweisen
+ * @details 只由分片的写入线程调用；新序列清零后才发布，读取方不会看到未初始化的计数器 / Only called by the shard's writer thread; a new series is zeroed before it is published, so readers never see uninitialized counters / Wird nur vom Schreiber-Thread des Shards aufgerufen; eine neue Serie wird vor der Veröffentlichung genullt, Leser sehen daher nie uninitialisierte Zähler
+ */
+static nxld_metrics_series_t* shard_series(nxld_metrics_shard_t* shard, size_t series) {
+    if (series >= shard->series_count) {
+        return NULL;
+    }
+    nxld_metrics_series_t* target = shard->series[series];
+    if (target == NULL) {
+        target = (nxld_metrics_series_t*)calloc(1, sizeof(nxld_metrics_series_t));
+        if (target != NULL) {
+            target->min_ns = UINT64_MAX;
+            publish_series(&shard->series[series], target);
+        }
+    }
+    return target;
+}
+
+/**
+ * @brief 将延迟计入序列 / Add latency to series / Latenz zur Serie hinzufügen
+ */
+static void add_latency(nxld_metrics_series_t* target, uint64_t latency_ns) {
+    if (latency_ns == NXLD_METRICS_NO_LATENCY) {
+        return;
+    }
+    if (latency_ns < target->min_ns) {
+        store_counter(&target->min_ns, latency_ns);
+    }
+    if (latency_ns > target->max_ns) {
+        store_counter(&target->max_ns, latency_ns);
+    }
+    add_counter(&target->total_ns, latency_ns);
+    add_counter(&target->counts[bucket_index(latency_ns)], 1);
+    add_counter(&target->timed, 1);
+}
+
+void nxld_metrics_record(nxld_metrics_shard_t* shard, size_t series, uint64_t latency_ns, uint64_t bytes) {
+    if (shard == NULL) {
+        return;
+    }
+
+    nxld_metrics_series_t* target = shard_series(shard, series);
+    if (target != NULL) {
+        add_counter(&target->calls, 1);
+        if (bytes != 0) {
+            add_counter(&target->bytes, bytes);
+        }
+        add_latency(target, latency_ns);
+    }
+}
+
+void nxld_metrics_record_latency(nxld_metrics_shard_t* shard, size_t series, uint64_t latency_ns) {
+    if (shard == NULL) {
+        return;
+    }
+
+    nxld_metrics_series_t* target = shard_series(shard, series);
+    if (target != NULL) {
+        add_latency(target, latency_ns);
+    }
+}
+
+void nxld_metrics_record_error(nxld_metrics_shard_t* shard, size_t series) {
+    if (shard == NULL) {
+        return;
+    }
+
+    nxld_metrics_series_t* target = shard_series(shard, series);
+    if (target != NULL) {
+        add_counter(&target->errors, 1);
+    }
+}
+
+void nxld_metrics_record_skip(nxld_metrics_shard_t* shard, size_t series) {
+    if (shard == NULL) {
+        return;
+    }
+
+    nxld_metrics_series_t* target = shard_series(shard, series);
+    if (target != NULL) {
+        add_counter(&target->skips, 1);
+    }
+}
+
+int nxld_metrics_snapshot(nxld_metrics_t* metrics, size_t series, nxld_metrics_series_t* out) {
+    if (out == NULL) {
+        return -1;
+    }
+    memset(out, 0, sizeof(nxld_metrics_series_t));
+    if (metrics == NULL || series >= metrics->series_count) {
+        return -1;
+    }
+
+    nxld_mutex_lock(&metrics->mutex);
+    if (metrics->retired[series] != NULL) {
+        merge_series(out, metrics->retired[series]);
+    }
+    // 注册表锁只保护分片链表，写入方从不获取它 / The registry lock only guards the shard list, writers never take it / Die Registry-Sperre schützt nur die Shard-Liste, Schreiber nehmen sie nie
+    for (nxld_metrics_shard_t* shard = metrics->shards; shard != NULL; shard = shard->next) {
+        nxld_metrics_series_t* live = load_series(&shard->series[series]);
+        if (live != NULL) {
+            merge_live_series(out, live);
+        }
+    }
+    nxld_mutex_unlock(&metrics->mutex);
+    return 0;
+}
+
+uint64_t nxld_metrics_percentile(const nxld_metrics_series_t* series, double percentile) {
+    if (series == NULL || series->timed == 0) {
+        return 0;
+    }
+
+    double wanted = percentile / 100.0 * (double)series->timed;
+    uint64_t threshold = wanted < 1.0 ? 1 : (uint64_t)wanted;
+    if ((double)threshold < wanted) {
+        threshold++;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NXLD_METRICS_BUCKET_COUNT; i++) {
+        seen += series->counts[i];
+        if (seen >= threshold) {
+            uint64_t bound = bucket_upper_bound(i);
+            return bound < series->max_ns ? bound : series->max_ns;
+        }
+    }
+    return series->max_ns;
+}
+
+void nxld_metrics_write_json(FILE* file, const nxld_metrics_series_t* series) {
+    if (file == NULL || series == NULL) {
+        return;
+    }
+
+    fprintf(file, "\"calls\": %llu, \"errors\": %llu, \"condition_skips\": %llu, \"bytes\": %llu, ",
+            (unsigned long long)series->calls, (unsigned long long)series->errors,
+            (unsigned long long)series->skips, (unsigned long long)series->bytes);
+    fprintf(file, "\"latency_ns\": {\"count\": %llu, \"min\": %llu, \"mean\": %llu, \"max\": %llu, "
+            "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"buckets\": [",
+            (unsigned long long)series->timed, (unsigned long long)series->min_ns,
+            (unsigned long long)(series->timed > 0 ? series->total_ns / series->timed : 0),
+            (unsigned long long)series->max_ns,
+            (unsigned long long)nxld_metrics_percentile(series, 50.0),
+            (unsigned long long)nxld_metrics_percentile(series, 90.0),
+            (unsigned long long)nxld_metrics_percentile(series, 99.0),
+            (unsigned long long)nxld_metrics_percentile(series, 99.9));
+
+    // 只写出非空桶，每项为[上界, 数量] / Only non-empty buckets are written, each as [upper bound, count] / Nur nicht leere Buckets werden geschrieben, jeweils als [Obergrenze, Anzahl]
+    int first = 1;
+    for (size_t i = 0; i < NXLD_METRICS_BUCKET_COUNT; i++) {
+        if (series->counts[i] == 0) {
+            continue;
+        }
+        fprintf(file, "%s[%llu, %llu]", first ? "" : ", ",
+                (unsigned long long)bucket_upper_bound(i), (unsigned long long)series->counts[i]);
+        first = 0;
+    }
+    fprintf(file, "]}");
+}
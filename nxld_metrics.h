@@ -0,0 +1,168 @@
+/**
+ * @file nxld_metrics.h
+ * @brief NXLD执行计数器与延迟直方图接口 / NXLD Execution Counters and Latency Histogram Interface / NXLD-Ausführungszähler- und Latenzhistogramm-Schnittstelle
+ * @details 每个序列记录调用、错误、条件跳过、传递字节数和HDR风格的对数线性延迟直方图；写入方各自持有分片，读取时合并 / Each series records calls, errors, condition skips, bytes passed and an HDR-style log-linear latency histogram; writers own a shard each and shards are merged on read / Jede Serie erfasst Aufrufe, Fehler, Bedingungssprünge, übergebene Bytes und ein logarithmisch-lineares Latenzhistogramm im HDR-Stil; Schreiber besitzen je einen Shard, Shards werden beim Lesen zusammengeführt
+ */
+
+#ifndef NXLD_METRICS_H
+#define NXLD_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "nxld_thread.h"
+
+/**
+ * @brief 每个二次幂区间的子桶位数（相对误差不超过1/16） / Sub-bucket bits per power-of-two range (relative error at most 1/16) / Unter-Bucket-Bits je Zweierpotenzbereich (relativer Fehler höchstens 1/16)
+ */
+#define NXLD_METRICS_SUB_BUCKET_BITS 5
+
+/**
+ * @brief 可区分的最大延迟位数（约18分钟，更大的值计入最后一个桶） / Highest distinguishable latency bit (about 18 minutes, larger values go to the last bucket) / Höchstes unterscheidbares Latenzbit (etwa 18 Minuten, größere Werte landen im letzten Bucket)
+ */
+#define NXLD_METRICS_MAX_BITS 40
+
+/**
+ * @brief 直方图桶数量 / Histogram bucket count / Anzahl der Histogramm-Buckets
+ */
+#define NXLD_METRICS_BUCKET_COUNT \
+    ((NXLD_METRICS_MAX_BITS - NXLD_METRICS_SUB_BUCKET_BITS + 2) << (NXLD_METRICS_SUB_BUCKET_BITS - 1))
+
+/**
+ * @brief 不记录延迟的标记值 / Marker for samples without latency / Markierung für Messwerte ohne Latenz
+ */
+#define NXLD_METRICS_NO_LATENCY ((uint64_t)-1)
+
+/**
+ * @brief 指标序列结构体 / Metrics series structure / Metrikserien-Struktur
+ */
+typedef struct {
+    uint64_t calls;                         /**< 完成的调用次数 / Completed calls / Abgeschlossene Aufrufe */
+    uint64_t errors;                        /**< 失败次数 / Failures / Fehlschläge */
+    uint64_t skips;                         /**< 条件不满足的次数 / Times the condition did not hold / Anzahl nicht erfüllter Bedingungen */
+    uint64_t bytes;                         /**< 传递的缓冲区和字符串字节数 / Buffer and string bytes passed / Übergebene Puffer- und Zeichenfolgen-Bytes */
+    uint64_t timed;                         /**< 带延迟的样本数量 / Samples with latency / Messwerte mit Latenz */
+    uint64_t total_ns;                      /**< 延迟总和（纳秒） / Latency sum in nanoseconds / Latenzsumme in Nanosekunden */
+    uint64_t min_ns;                        /**< 最小延迟（纳秒） / Minimum latency in nanoseconds / Minimale Latenz in Nanosekunden */
+    uint64_t max_ns;                        /**< 最大延迟（纳秒） / Maximum latency in nanoseconds / Maximale Latenz in Nanosekunden */
+    uint64_t counts[NXLD_METRICS_BUCKET_COUNT];  /**< 延迟直方图 / Latency histogram / Latenzhistogramm */
+} nxld_metrics_series_t;
+
+/**
+ * @brief 写入分片（不透明） / Writer shard (opaque) / Schreiber-Shard (undurchsichtig)
+ */
+typedef struct nxld_metrics_shard nxld_metrics_shard_t;
+
+/**
+ * @brief 指标注册表结构体 / Metrics registry structure / Metrik-Registry-Struktur
+ */
+typedef struct {
+    size_t series_count;                    /**< 序列数量 / Series count / Anzahl der Serien */
+    unsigned int sample_interval;           /**< 每个分片每隔多少次调用计时一次 / Time one call in this many per shard / Jeden so vielten Aufruf je Shard messen */
+    nxld_mutex_t mutex;                     /**< 分片列表互斥锁（仅获取、释放和读取时使用） / Shard list mutex (only taken on acquire, release and read) / Mutex der Shard-Liste (nur beim Anfordern, Freigeben und Lesen genommen) */
+    nxld_metrics_shard_t* shards;           /**< 活动分片链表 / Active shard list / Liste aktiver Shards */
+    nxld_metrics_series_t** retired;        /**< 已释放分片合并后的序列 / Series merged from released shards / Aus freigegebenen Shards zusammengeführte Serien */
+} nxld_metrics_t;
+
+/**
+ * @brief 读取单调时钟 / Read monotonic clock / Monotone Uhr lesen
+ * @return 纳秒时间戳 / Timestamp in nanoseconds / Zeitstempel in Nanosekunden
+ */
+uint64_t nxld_metrics_now_ns(void);
+
+/**
+ * @brief 创建指标注册表 / Create metrics registry / Metrik-Registry erstellen
+ * @param series_count 序列数量 / Series count / Anzahl der Serien
+ * @param sample_interval 延迟采样间隔（0或1表示每次调用都计时） / Latency sampling interval (0 or 1 times every call) / Latenz-Stichprobenintervall (0 oder 1 misst jeden Aufruf)
+ * @return 注册表指针，失败返回NULL / Registry pointer, NULL on failure / Registry-Zeiger, NULL bei Fehler
+ * @details 计数器每次调用都更新；读取时钟比调用本身更昂贵，因此延迟按间隔采样 / Counters are updated on every call; reading the clock costs more than the call itself, so latency is sampled at an interval / Zähler werden bei jedem Aufruf aktualisiert; das Lesen der Uhr kostet mehr als der Aufruf selbst, daher wird die Latenz im Intervall abgetastet
+ */
+nxld_metrics_t* nxld_metrics_create(size_t series_count, unsigned int sample_interval);
+
+/**
+ * @brief 销毁注册表及其所有分片 / Destroy registry and all its shards / Registry und alle ihre Shards zerstören
+ * @param metrics 注册表指针 / Registry pointer / Registry-Zeiger
+ */
+void nxld_metrics_destroy(nxld_metrics_t* metrics);
+
+/**
+ * @brief 获取写入分片 / Acquire writer shard / Schreiber-Shard anfordern
+ * @param metrics 注册表指针 / Registry pointer / Registry-Zeiger
+ * @return 分片指针，失败返回NULL / Shard pointer, NULL on failure / Shard-Zeiger, NULL bei Fehler
+ * @details 一个分片同一时间只由一个线程写入；记录不加锁，只用宽松原子存储，读取方用原子加载合并 / A shard is written by one thread at a time; recording takes no lock and uses relaxed atomic stores only, readers merge with atomic loads / Ein Shard wird jeweils nur von einem Thread beschrieben; das Erfassen nimmt keine Sperre und verwendet nur entspannte atomare Speicherungen, Leser führen mit atomaren Ladevorgängen zusammen
+ */
+nxld_metrics_shard_t* nxld_metrics_shard_acquire(nxld_metrics_t* metrics);
+
+/**
+ * @brief 释放分片并保留其数据 / Release shard and keep its data / Shard freigeben und seine Daten behalten
+ * @param metrics 注册表指针 / Registry pointer / Registry-Zeiger
+ * @param shard 分片指针 / Shard pointer / Shard-Zeiger
+ */
+void nxld_metrics_shard_release(nxld_metrics_t* metrics, nxld_metrics_shard_t* shard);
+
+/**
+ * @brief 判断本次调用是否计时 / Decide whether this call is timed / Entscheiden, ob dieser Aufruf gemessen wird
+ * @param shard 分片指针（NULL时返回0） / Shard pointer (returns 0 if NULL) / Shard-Zeiger (gibt 0 zurück bei NULL)
+ * @param series 序列索引（每个序列独立计数，避免固定调用模式总是采样同一序列） / Series index (counted per series so a fixed call pattern does not always sample the same series) / Serienindex (je Serie gezählt, damit ein festes Aufrufmuster nicht immer dieselbe Serie abtastet)
+ * @return 需要计时返回1，否则返回0 / Returns 1 if the call should be timed, 0 otherwise / Gibt 1 zurück, wenn der Aufruf gemessen werden soll, sonst 0
+ * @details 只由分片的写入线程调用 / Only called by the shard's writer thread / Wird nur vom Schreiber-Thread des Shards aufgerufen
+ */
+int nxld_metrics_sample(nxld_metrics_shard_t* shard, size_t series);
+
+/**
+ * @brief 记录一次完成的调用 / Record one completed call / Einen abgeschlossenen Aufruf erfassen
+ * @param shard 分片指针（NULL时忽略） / Shard pointer (ignored if NULL) / Shard-Zeiger (ignoriert bei NULL)
+ * @param series 序列索引 / Series index / Serienindex
+ * @param latency_ns 延迟（纳秒），NXLD_METRICS_NO_LATENCY表示不计时 / Latency in nanoseconds, NXLD_METRICS_NO_LATENCY if untimed / Latenz in Nanosekunden, NXLD_METRICS_NO_LATENCY wenn ungemessen
+ * @param bytes 传递的字节数 / Bytes passed / Übergebene Bytes
+ */
+void nxld_metrics_record(nxld_metrics_shard_t* shard, size_t series, uint64_t latency_ns, uint64_t bytes);
+
+/**
+ * @brief 只记录延迟，不增加调用次数 / Record latency only, without counting a call / Nur Latenz erfassen, ohne einen Aufruf zu zählen
+ * @param shard 分片指针（NULL时忽略） / Shard pointer (ignored if NULL) / Shard-Zeiger (ignoriert bei NULL)
+ * @param series 序列索引 / Series index / Serienindex
+ * @param latency_ns 延迟（纳秒） / Latency in nanoseconds / Latenz in Nanosekunden
+ */
+void nxld_metrics_record_latency(nxld_metrics_shard_t* shard, size_t series, uint64_t latency_ns);
+
+/**
+ * @brief 记录一次失败 / Record one failure / Einen Fehlschlag erfassen
+ * @param shard 分片指针（NULL时忽略） / Shard pointer (ignored if NULL) / Shard-Zeiger (ignoriert bei NULL)
+ * @param series 序列索引 / Series index / Serienindex
+ */
+void nxld_metrics_record_error(nxld_metrics_shard_t* shard, size_t series);
+
+/**
+ * @brief 记录一次条件跳过 / Record one condition skip / Einen Bedingungssprung erfassen
+ * @param shard 分片指针（NULL时忽略） / Shard pointer (ignored if NULL) / Shard-Zeiger (ignoriert bei NULL)
+ * @param series 序列索引 / Series index / Serienindex
+ */
+void nxld_metrics_record_skip(nxld_metrics_shard_t* shard, size_t series);
+
+/**
+ * @brief 合并所有分片得到序列快照 / Merge all shards into a series snapshot / Alle Shards zu einer Serien-Momentaufnahme zusammenführen
+ * @param metrics 注册表指针 / Registry pointer / Registry-Zeiger
+ * @param series 序列索引 / Series index / Serienindex
+ * @param out 输出快照 / Output snapshot / Ausgabe-Momentaufnahme
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_metrics_snapshot(nxld_metrics_t* metrics, size_t series, nxld_metrics_series_t* out);
+
+/**
+ * @brief 计算延迟分位数 / Compute latency percentile / Latenzperzentil berechnen
+ * @param series 序列快照 / Series snapshot / Serien-Momentaufnahme
+ * @param percentile 分位数（0到100） / Percentile (0 to 100) / Perzentil (0 bis 100)
+ * @return 所在桶的上界（纳秒），无样本返回0 / Upper bound of the containing bucket in nanoseconds, 0 without samples / Obergrenze des enthaltenden Buckets in Nanosekunden, 0 ohne Messwerte
+ */
+uint64_t nxld_metrics_percentile(const nxld_metrics_series_t* series, double percentile);
+
+/**
+ * @brief 以JSON对象字段写出序列 / Write series as JSON object members / Serie als JSON-Objektfelder schreiben
+ * @param file 输出文件 / Output file / Ausgabedatei
+ * @param series 序列快照 / Series snapshot / Serien-Momentaufnahme
+ * @details 写出计数器、分位数和非空桶，不含外层花括号 / Writes counters, percentiles and non-empty buckets without the enclosing braces / Schreibt Zähler, Perzentile und nicht leere Buckets ohne umschließende Klammern
+ */
+void nxld_metrics_write_json(FILE* file, const nxld_metrics_series_t* series);
+
+#endif /* NXLD_METRICS_H */
@@ -452,23 +452,23 @@ static int plugin_file_exists(const char* plugin_path) {
  */
 static nxld_parse_result_t validate_config(const nxld_config_t* config, const char* config_file_path) {
     if (config->lock_mode != 0 && config->lock_mode != 1) {
-        nxld_log_error("LockMode value is invalid, only 0 (off) or 1 (on) are supported");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "LockMode value is invalid, only 0 (off) or 1 (on) are supported");
         return NXLD_PARSE_INVALID_LOCK_MODE;
     }
     
     if (config->lock_mode == 1 && config->max_root_plugins < 1) {
-        nxld_log_error("MaxRootPlugins must be >= 1 in lock mode");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "MaxRootPlugins must be >= 1 in lock mode");
         return NXLD_PARSE_INVALID_MAX_PLUGINS;
     }
     
     if (config->enabled_root_plugins_count == 0) {
-        nxld_log_error("EnabledRootPlugins cannot be empty, at least 1 root plugin must be specified");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "EnabledRootPlugins cannot be empty, at least 1 root plugin must be specified");
         return NXLD_PARSE_EMPTY_PLUGINS;
     }
     
     if (config->lock_mode == 1) {
         if ((int)config->enabled_root_plugins_count > config->max_root_plugins) {
-            nxld_log_error("EnabledRootPlugins count (%zu) exceeds MaxRootPlugins (%d) in lock mode", 
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "EnabledRootPlugins count (%zu) exceeds MaxRootPlugins (%d) in lock mode", 
                           config->enabled_root_plugins_count, config->max_root_plugins);
             return NXLD_PARSE_INVALID_MAX_PLUGINS;
         }
@@ -476,40 +476,40 @@ static nxld_parse_result_t validate_config(const nxld_config_t* config, const ch
     
     char config_dir[MAX_PATH_LENGTH];
     if (!get_config_dir(config_file_path, config_dir, sizeof(config_dir))) {
-        nxld_log_error("Failed to get config file directory");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Failed to get config file directory");
         return NXLD_PARSE_FILE_ERROR;
     }
     
     for (size_t i = 0; i < config->enabled_root_plugins_count; i++) {
         if (!is_valid_plugin_format(config->enabled_root_plugins[i])) {
 #ifdef _WIN32
-            nxld_log_error("Plugin file format is invalid for Windows system: %s (expected .dll)", config->enabled_root_plugins[i]);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Plugin file format is invalid for Windows system: %s (expected .dll)", config->enabled_root_plugins[i]);
 #else
-            nxld_log_error("Plugin file format is invalid for Linux system: %s (expected .so)", config->enabled_root_plugins[i]);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Plugin file format is invalid for Linux system: %s (expected .so)", config->enabled_root_plugins[i]);
 #endif
             return NXLD_PARSE_PLUGIN_INVALID_FORMAT;
         }
         
         char full_path[MAX_PATH_LENGTH];
         if (!build_plugin_full_path(config_dir, config->enabled_root_plugins[i], full_path, sizeof(full_path))) {
-            nxld_log_error("Failed to build full path for plugin: %s", config->enabled_root_plugins[i]);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Failed to build full path for plugin: %s", config->enabled_root_plugins[i]);
             return NXLD_PARSE_FILE_ERROR;
         }
         
         if (!plugin_file_exists(full_path)) {
-            nxld_log_error("Plugin file not found: %s (resolved path: %s)", config->enabled_root_plugins[i], full_path);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Plugin file not found: %s (resolved path: %s)", config->enabled_root_plugins[i], full_path);
             return NXLD_PARSE_PLUGIN_NOT_FOUND;
         }
     }
     
     for (size_t i = 0; i < config->virtual_parent_count; i++) {
         if (!is_plugin_in_enabled_list(config->virtual_parent_keys[i], config->enabled_root_plugins, config->enabled_root_plugins_count)) {
-            nxld_log_error("Child plugin path in virtual parent config is not in EnabledRootPlugins: %s", config->virtual_parent_keys[i]);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Child plugin path in virtual parent config is not in EnabledRootPlugins: %s", config->virtual_parent_keys[i]);
             return NXLD_PARSE_VIRTUAL_PARENT_INVALID;
         }
         
         if (!is_plugin_in_enabled_list(config->virtual_parent_values[i], config->enabled_root_plugins, config->enabled_root_plugins_count)) {
-            nxld_log_error("Parent plugin path in virtual parent config is not in EnabledRootPlugins: %s", config->virtual_parent_values[i]);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Parent plugin path in virtual parent config is not in EnabledRootPlugins: %s", config->virtual_parent_values[i]);
             return NXLD_PARSE_VIRTUAL_PARENT_INVALID;
         }
     }
@@ -583,20 +583,20 @@ static int is_plugin_in_enabled_list(const char* plugin_path, char** enabled_plu
 
 nxld_parse_result_t nxld_parse_file(const char* file_path, nxld_config_t* config) {
     if (file_path == NULL || config == NULL) {
-        nxld_log_error("Invalid parameters: file_path or config is NULL");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Invalid parameters: file_path or config is NULL");
         return NXLD_PARSE_FILE_ERROR;
     }
     
     memset(config, 0, sizeof(nxld_config_t));
     
     if (!is_valid_utf8_file(file_path)) {
-        nxld_log_error("File encoding check failed: file is not valid UTF-8 or is binary file");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "File encoding check failed: file is not valid UTF-8 or is binary file");
         return NXLD_PARSE_ENCODING_ERROR;
     }
     
     FILE* file = fopen(file_path, "r");
     if (file == NULL) {
-        nxld_log_error("Failed to open file: %s", file_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Failed to open file: %s", file_path);
         return NXLD_PARSE_FILE_ERROR;
     }
     
@@ -611,7 +611,7 @@ nxld_parse_result_t nxld_parse_file(const char* file_path, nxld_config_t* config
     config->virtual_parent_values = (char**)malloc(virtual_parent_capacity * sizeof(char*));
     if (config->virtual_parent_keys == NULL || config->virtual_parent_values == NULL) {
         fclose(file);
-        nxld_log_error("Memory allocation failed for virtual parent arrays");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Memory allocation failed for virtual parent arrays");
         return NXLD_PARSE_MEMORY_ERROR;
     }
     
@@ -650,7 +650,7 @@ nxld_parse_result_t nxld_parse_file(const char* file_path, nxld_config_t* config
                     if (plugins == NULL && count > 0) {
                         fclose(file);
                         nxld_config_free(config);
-                        nxld_log_error("Memory allocation failed for plugin paths");
+                        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Memory allocation failed for plugin paths");
                         return NXLD_PARSE_MEMORY_ERROR;
                     }
                     config->enabled_root_plugins = plugins;
@@ -664,7 +664,7 @@ nxld_parse_result_t nxld_parse_file(const char* file_path, nxld_config_t* config
                     if (config->virtual_parent_keys == NULL || config->virtual_parent_values == NULL) {
                         fclose(file);
                         nxld_config_free(config);
-                        nxld_log_error("Memory allocation failed for virtual parent arrays expansion");
+                        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Memory allocation failed for virtual parent arrays expansion");
                         return NXLD_PARSE_MEMORY_ERROR;
                     }
                 }
@@ -675,7 +675,7 @@ nxld_parse_result_t nxld_parse_file(const char* file_path, nxld_config_t* config
                     config->virtual_parent_values[config->virtual_parent_count] == NULL) {
                     fclose(file);
                     nxld_config_free(config);
-                    nxld_log_error("Memory allocation failed for virtual parent key-value pair");
+                    NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "Memory allocation failed for virtual parent key-value pair");
                     return NXLD_PARSE_MEMORY_ERROR;
                 }
                 
@@ -689,7 +689,7 @@ nxld_parse_result_t nxld_parse_file(const char* file_path, nxld_config_t* config
     fclose(file);
     
     if (!engine_core_found) {
-        nxld_log_error("NXLD config file is missing required [EngineCore] section");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PARSER, "NXLD config file is missing required [EngineCore] section");
         return NXLD_PARSE_MISSING_SECTION;
     }
     
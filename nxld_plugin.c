@@ -3,8 +3,15 @@
  * @brief NXLD插件加载和管理实现 / NXLD Plugin Loading and Management Implementation / NXLD-Plugin-Lade- und Verwaltungsimplementierung
  */
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "nxld_plugin.h"
 #include "nxld_logger.h"
+#include "nxld_buffer_pool.h"
+#include "nxld_stream.h"
+#include "nxld_trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -40,6 +47,11 @@
 #include <windows.h>
 #else
 #include <dlfcn.h>
+#include <unistd.h>
+#include <stdint.h>
+#ifdef __linux__
+#include <link.h>
+#endif
 #endif
 
 #define MAX_NAME_LENGTH 256
@@ -47,6 +59,19 @@
 #define MAX_DESCRIPTION_LENGTH 512
 #define UID_LENGTH 64
 
+/**
+ * @brief 提供给插件的主机服务表 / Host services table offered to plugins / Plugins angebotene Host-Dienst-Tabelle
+ */
+static const nxld_host_services_t g_host_services = {
+    NXLD_HOST_SERVICES_VERSION,
+    sizeof(nxld_host_services_t),
+    nxld_buffer_pool_alloc,
+    nxld_buffer_pool_free,
+    nxld_buffer_pool_alloc_buffer,
+    nxld_stream_acquire,
+    nxld_stream_commit
+};
+
 /**
  * @brief 生成64位随机字符串UID / Generate 64-bit random string UID / 64-Bit-Zufallszeichenfolge-UID generieren
  * @param uid 输出UID缓冲区 / Output UID buffer / Ausgabe-UID-Puffer
@@ -167,26 +192,32 @@ static const char* get_dl_error(void) {
 #endif
 }
 
-nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_t* plugin) {
+/**
+ * @brief 加载插件（各阶段分别记录跟踪时间段） / Load plugin (each phase is recorded as a trace span) / Plugin laden (jede Phase wird als Verfolgungszeitspanne aufgezeichnet)
+ */
+static nxld_plugin_load_result_t load_plugin(const char* plugin_path, nxld_plugin_t* plugin) {
     if (plugin_path == NULL || plugin == NULL) {
-        nxld_log_error("Invalid parameters: plugin_path or plugin is NULL");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Invalid parameters: plugin_path or plugin is NULL");
         return NXLD_PLUGIN_LOAD_FILE_ERROR;
     }
     
     memset(plugin, 0, sizeof(nxld_plugin_t));
     
+    uint64_t phase_start = nxld_trace_begin();
     void* handle = load_dynamic_library(plugin_path);
+    nxld_trace_end("load", "dlopen", phase_start, plugin_path);
     if (handle == NULL) {
-        nxld_log_error("Failed to load dynamic library: %s, error: %s", plugin_path, get_dl_error());
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to load dynamic library: %s, error: %s", plugin_path, get_dl_error());
         return NXLD_PLUGIN_LOAD_FILE_ERROR;
     }
     
     plugin->handle = handle;
+    phase_start = nxld_trace_begin();
     
     plugin->plugin_path = (char*)malloc(strlen(plugin_path) + 1);
     if (plugin->plugin_path == NULL) {
         close_dynamic_library(handle);
-        nxld_log_error("Memory allocation failed for plugin path");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for plugin path");
         return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
     }
     strcpy_safe(plugin->plugin_path, strlen(plugin_path) + 1, plugin_path);
@@ -221,7 +252,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
             first = 0;
         }
         
-        nxld_log_error("Required exported functions not found in plugin %s: %s", plugin_path, missing_funcs);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Required exported functions not found in plugin %s: %s", plugin_path, missing_funcs);
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
         return NXLD_PLUGIN_LOAD_SYMBOL_ERROR;
@@ -231,7 +262,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
     char version_buffer[MAX_VERSION_LENGTH];
     
     if (get_name(name_buffer, sizeof(name_buffer)) != 0) {
-        nxld_log_error("Failed to get plugin name from: %s", plugin_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to get plugin name from: %s", plugin_path);
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
         return NXLD_PLUGIN_LOAD_METADATA_ERROR;
@@ -241,13 +272,13 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
     if (plugin->plugin_name == NULL) {
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
-        nxld_log_error("Memory allocation failed for plugin name");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for plugin name");
         return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
     }
     strcpy_safe(plugin->plugin_name, strlen(name_buffer) + 1, name_buffer);
     
     if (get_version(version_buffer, sizeof(version_buffer)) != 0) {
-        nxld_log_error("Failed to get plugin version from: %s", plugin_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to get plugin version from: %s", plugin_path);
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
         return NXLD_PLUGIN_LOAD_METADATA_ERROR;
@@ -257,14 +288,14 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
     if (plugin->plugin_version == NULL) {
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
-        nxld_log_error("Memory allocation failed for plugin version");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for plugin version");
         return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
     }
     strcpy_safe(plugin->plugin_version, strlen(version_buffer) + 1, version_buffer);
     
     size_t interface_count = 0;
     if (get_interface_count(&interface_count) != 0) {
-        nxld_log_error("Failed to get interface count from: %s", plugin_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to get interface count from: %s", plugin_path);
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
         return NXLD_PLUGIN_LOAD_METADATA_ERROR;
@@ -277,7 +308,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
         if (plugin->interfaces == NULL) {
             close_dynamic_library(handle);
             nxld_plugin_free(plugin);
-            nxld_log_error("Memory allocation failed for interface array");
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for interface array");
             return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
         }
         
@@ -291,8 +322,10 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
         
         int has_param_info = (get_param_count != NULL && get_param_info != NULL);
         if (!has_param_info) {
-            nxld_log_info("Plugin %s does not provide parameter information functions", plugin_path);
+            NXLD_LOG_INFO(NXLD_LOG_MODULE_PLUGIN, "Plugin %s does not provide parameter information functions", plugin_path);
         }
+        nxld_plugin_get_interface_purity_func get_purity =
+            (nxld_plugin_get_interface_purity_func)get_symbol(handle, "nxld_plugin_get_interface_purity");
         
         for (size_t i = 0; i < interface_count; i++) {
             char iface_name[MAX_NAME_LENGTH] = {0};
@@ -302,7 +335,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
             if (get_interface_info(i, iface_name, sizeof(iface_name),
                                    iface_desc, sizeof(iface_desc),
                                    iface_version, sizeof(iface_version)) != 0) {
-                nxld_log_error("Failed to get interface info at index %zu from: %s", i, plugin_path);
+                NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to get interface info at index %zu from: %s", i, plugin_path);
                 close_dynamic_library(handle);
                 nxld_plugin_free(plugin);
                 return NXLD_PLUGIN_LOAD_METADATA_ERROR;
@@ -315,7 +348,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
             if (plugin->interfaces[i].name == NULL || 
                 plugin->interfaces[i].description == NULL || 
                 plugin->interfaces[i].version == NULL) {
-                nxld_log_error("Memory allocation failed for interface info at index %zu", i);
+                NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for interface info at index %zu", i);
                 close_dynamic_library(handle);
                 nxld_plugin_free(plugin);
                 return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -332,6 +365,16 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
             plugin->interfaces[i].params = NULL;
             plugin->interfaces[i].param_count = 0;
             
+            // 纯函数声明（可选） / Purity declaration (optional) / Reinheitsdeklaration (optional)
+            if (get_purity != NULL) {
+                int pure = 0;
+                size_t cache_capacity = 0;
+                if (get_purity(i, &pure, &cache_capacity) == 0) {
+                    plugin->interfaces[i].pure = pure != 0;
+                    plugin->interfaces[i].cache_capacity = cache_capacity;
+                }
+            }
+            
             // 收集插件提供的参数信息 / Collect parameter info provided by plugin / Von Plugin bereitgestellte Parameterinformationen sammeln
             if (has_param_info) {
                 nxld_param_count_type_t count_type;
@@ -347,7 +390,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                         plugin->interfaces[i].param_count = min_count;
                         plugin->interfaces[i].params = (nxld_param_info_t*)malloc(min_count * sizeof(nxld_param_info_t));
                         if (plugin->interfaces[i].params == NULL) {
-                            nxld_log_error("Memory allocation failed for parameter info at interface %zu", i);
+                            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for parameter info at interface %zu", i);
                             close_dynamic_library(handle);
                             nxld_plugin_free(plugin);
                             return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -364,7 +407,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                                               &param_type, type_name, sizeof(type_name)) == 0) {
                                 plugin->interfaces[i].params[j].name = (char*)malloc(strlen(param_name) + 1);
                                 if (plugin->interfaces[i].params[j].name == NULL) {
-                                    nxld_log_error("Memory allocation failed for parameter name at interface %zu param %d", i, j);
+                                    NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for parameter name at interface %zu param %d", i, j);
                                     close_dynamic_library(handle);
                                     nxld_plugin_free(plugin);
                                     return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -376,7 +419,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                                 if (strlen(type_name) > 0) {
                                     plugin->interfaces[i].params[j].type_name = (char*)malloc(strlen(type_name) + 1);
                                     if (plugin->interfaces[i].params[j].type_name == NULL) {
-                                        nxld_log_error("Memory allocation failed for type name at interface %zu param %d", i, j);
+                                        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for type name at interface %zu param %d", i, j);
                                         close_dynamic_library(handle);
                                         nxld_plugin_free(plugin);
                                         return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -386,7 +429,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                                     plugin->interfaces[i].params[j].type_name = NULL;
                                 }
                             } else {
-                                nxld_log_warning("Failed to get parameter info at interface %zu param %d", i, j);
+                                NXLD_LOG_WARNING(NXLD_LOG_MODULE_PLUGIN, "Failed to get parameter info at interface %zu param %d", i, j);
                                 plugin->interfaces[i].params[j].name = NULL;
                                 plugin->interfaces[i].params[j].type = NXLD_PARAM_TYPE_UNKNOWN;
                                 plugin->interfaces[i].params[j].type_name = NULL;
@@ -398,7 +441,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                             plugin->interfaces[i].param_count = min_count;
                             plugin->interfaces[i].params = (nxld_param_info_t*)malloc(min_count * sizeof(nxld_param_info_t));
                             if (plugin->interfaces[i].params == NULL) {
-                                nxld_log_error("Memory allocation failed for parameter info at interface %zu", i);
+                                NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for parameter info at interface %zu", i);
                                 close_dynamic_library(handle);
                                 nxld_plugin_free(plugin);
                                 return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -415,7 +458,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                                                   &param_type, type_name, sizeof(type_name)) == 0) {
                                     plugin->interfaces[i].params[j].name = (char*)malloc(strlen(param_name) + 1);
                                     if (plugin->interfaces[i].params[j].name == NULL) {
-                                        nxld_log_error("Memory allocation failed for parameter name at interface %zu param %d", i, j);
+                                        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for parameter name at interface %zu param %d", i, j);
                                         close_dynamic_library(handle);
                                         nxld_plugin_free(plugin);
                                         return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -427,7 +470,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                                     if (strlen(type_name) > 0) {
                                         plugin->interfaces[i].params[j].type_name = (char*)malloc(strlen(type_name) + 1);
                                         if (plugin->interfaces[i].params[j].type_name == NULL) {
-                                            nxld_log_error("Memory allocation failed for type name at interface %zu param %d", i, j);
+                                            NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed for type name at interface %zu param %d", i, j);
                                             close_dynamic_library(handle);
                                             nxld_plugin_free(plugin);
                                             return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
@@ -437,7 +480,7 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                                         plugin->interfaces[i].params[j].type_name = NULL;
                                     }
                                 } else {
-                                    nxld_log_warning("Failed to get parameter info at interface %zu param %d", i, j);
+                                    NXLD_LOG_WARNING(NXLD_LOG_MODULE_PLUGIN, "Failed to get parameter info at interface %zu param %d", i, j);
                                     plugin->interfaces[i].params[j].name = NULL;
                                     plugin->interfaces[i].params[j].type = NXLD_PARAM_TYPE_UNKNOWN;
                                     plugin->interfaces[i].params[j].type_name = NULL;
@@ -446,20 +489,28 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
                         }
                     }
                 } else {
-                    nxld_log_warning("Failed to get parameter count for interface %zu", i);
+                    NXLD_LOG_WARNING(NXLD_LOG_MODULE_PLUGIN, "Failed to get parameter count for interface %zu", i);
                 }
             }
         }
     }
     
     if (!generate_uid(plugin->uid, sizeof(plugin->uid))) {
-        nxld_log_error("Failed to generate UID for plugin: %s", plugin_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to generate UID for plugin: %s", plugin_path);
         close_dynamic_library(handle);
         nxld_plugin_free(plugin);
         return NXLD_PLUGIN_LOAD_MEMORY_ERROR;
     }
+    nxld_trace_end("load", "metadata", phase_start, plugin->plugin_name);
+    
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_PLUGIN, "Plugin loaded successfully: %s (UID: %s)", plugin_path, plugin->uid);
     
-    nxld_log_info("Plugin loaded successfully: %s (UID: %s)", plugin_path, plugin->uid);
+    // 传递主机服务表（可选） / Hand over host services table (optional) / Host-Dienst-Tabelle übergeben (optional)
+    nxld_plugin_set_host_services_func set_host_services =
+        (nxld_plugin_set_host_services_func)get_symbol(handle, "nxld_plugin_set_host_services");
+    if (set_host_services != NULL) {
+        set_host_services(&g_host_services);
+    }
     
     // 自动生成.nxp元数据文件 / Automatically generate .nxp metadata file / .nxp-Metadaten-Datei automatisch generieren
     {
@@ -477,19 +528,29 @@ nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_
             memcpy(nxp_path, plugin_path, base_len);
             memcpy(nxp_path + base_len, ".nxp", 5);
             
-            if (nxld_plugin_generate_metadata_file(plugin, nxp_path) == 0) {
-                nxld_log_info("Plugin metadata file generated: %s", nxp_path);
+            phase_start = nxld_trace_begin();
+            int generated = nxld_plugin_generate_metadata_file(plugin, nxp_path);
+            nxld_trace_end("load", "write .nxp", phase_start, nxp_path);
+            if (generated == 0) {
+                NXLD_LOG_INFO(NXLD_LOG_MODULE_PLUGIN, "Plugin metadata file generated: %s", nxp_path);
             } else {
-                nxld_log_warning("Failed to generate metadata file: %s", nxp_path);
+                NXLD_LOG_WARNING(NXLD_LOG_MODULE_PLUGIN, "Failed to generate metadata file: %s", nxp_path);
             }
         } else {
-            nxld_log_warning("Plugin path too long to generate metadata file name");
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_PLUGIN, "Plugin path too long to generate metadata file name");
         }
     }
     
     return NXLD_PLUGIN_LOAD_SUCCESS;
 }
 
+nxld_plugin_load_result_t nxld_plugin_load(const char* plugin_path, nxld_plugin_t* plugin) {
+    uint64_t start = nxld_trace_begin();
+    nxld_plugin_load_result_t result = load_plugin(plugin_path, plugin);
+    nxld_trace_end("load", "nxld_plugin_load", start, plugin_path);
+    return result;
+}
+
 void nxld_plugin_unload(nxld_plugin_t* plugin) {
     if (plugin == NULL || plugin->handle == NULL) {
         return;
@@ -589,6 +650,7 @@ static const char* get_param_type_name(nxld_param_type_t type) {
         case NXLD_PARAM_TYPE_VARIADIC: return "variadic";
         case NXLD_PARAM_TYPE_ANY: return "any";
         case NXLD_PARAM_TYPE_UNKNOWN: return "unknown";
+        case NXLD_PARAM_TYPE_BUFFER: return "buffer";
         default: return "unknown";
     }
 }
@@ -607,13 +669,13 @@ static const char* get_param_count_type_name(nxld_param_count_type_t count_type)
 
 int nxld_plugin_generate_metadata_file(const nxld_plugin_t* plugin, const char* output_path) {
     if (plugin == NULL || output_path == NULL) {
-        nxld_log_error("Invalid parameters for metadata file generation");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Invalid parameters for metadata file generation");
         return -1;
     }
     
     FILE* fp = fopen(output_path, "w");
     if (fp == NULL) {
-        nxld_log_error("Failed to open file for writing: %s", output_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Failed to open file for writing: %s", output_path);
         return -1;
     }
     
@@ -653,6 +715,10 @@ int nxld_plugin_generate_metadata_file(const nxld_plugin_t* plugin, const char*
             fprintf(fp, "MaxParamCount=unlimited\n");
         }
         fprintf(fp, "FixedParamCount=%zu\n", iface->param_count);
+        if (iface->pure) {
+            fprintf(fp, "Pure=true\n");
+            fprintf(fp, "CacheCapacity=%zu\n", iface->cache_capacity);
+        }
         
         // 写入参数详细信息 / Write parameter details / Detaillierte Parameterinformationen schreiben
         if (iface->param_count > 0 && iface->params != NULL) {
@@ -678,7 +744,306 @@ int nxld_plugin_generate_metadata_file(const nxld_plugin_t* plugin, const char*
     }
     
     fclose(fp);
-    nxld_log_info("Plugin metadata file generated: %s", output_path);
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_PLUGIN, "Plugin metadata file generated: %s", output_path);
+    return 0;
+}
+
+/**
+ * @brief 从类型名称字符串解析参数类型 / Parse parameter type from type name string / Parametertyp aus Typnamen-Zeichenfolge analysieren
+ */
+static nxld_param_type_t parse_param_type_name(const char* name) {
+    static const nxld_param_type_t types[] = {
+        NXLD_PARAM_TYPE_VOID, NXLD_PARAM_TYPE_INT, NXLD_PARAM_TYPE_LONG, NXLD_PARAM_TYPE_FLOAT,
+        NXLD_PARAM_TYPE_DOUBLE, NXLD_PARAM_TYPE_CHAR, NXLD_PARAM_TYPE_POINTER, NXLD_PARAM_TYPE_STRING,
+        NXLD_PARAM_TYPE_VARIADIC, NXLD_PARAM_TYPE_ANY, NXLD_PARAM_TYPE_BUFFER
+    };
+    
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        if (strcmp(name, get_param_type_name(types[i])) == 0) {
+            return types[i];
+        }
+    }
+    return NXLD_PARAM_TYPE_UNKNOWN;
+}
+
+/**
+ * @brief 从名称字符串解析参数数量类型 / Parse parameter count type from name string / Parameteranzahl-Typ aus Namenszeichenfolge analysieren
+ */
+static nxld_param_count_type_t parse_param_count_type_name(const char* name) {
+    if (strcmp(name, "fixed") == 0) {
+        return NXLD_PARAM_COUNT_FIXED;
+    }
+    if (strcmp(name, "variable") == 0) {
+        return NXLD_PARAM_COUNT_VARIABLE;
+    }
+    return NXLD_PARAM_COUNT_UNKNOWN;
+}
+
+/**
+ * @brief 去除元数据行首尾空白字符 / Trim whitespace from metadata line / Leerzeichen am Anfang und Ende einer Metadatenzeile entfernen
+ */
+static char* trim_metadata_line(char* str) {
+    while (*str == ' ' || *str == '\t') {
+        str++;
+    }
+    
+    size_t len = strlen(str);
+    while (len > 0 && (str[len - 1] == '\n' || str[len - 1] == '\r' || str[len - 1] == ' ' || str[len - 1] == '\t')) {
+        str[--len] = '\0';
+    }
+    return str;
+}
+
+/**
+ * @brief 复制元数据字段值 / Duplicate metadata field value / Metadatenfeldwert duplizieren
+ */
+static int set_metadata_string(char** field, const char* value) {
+    size_t len = strlen(value);
+    char* copy = (char*)malloc(len + 1);
+    if (copy == NULL) {
+        return -1;
+    }
+    memcpy(copy, value, len + 1);
+    free(*field);
+    *field = copy;
+    return 0;
+}
+
+int nxld_plugin_read_metadata_file(const char* input_path, nxld_plugin_t* plugin) {
+    if (input_path == NULL || plugin == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Invalid parameters for metadata file reading");
+        return -1;
+    }
+    
+    memset(plugin, 0, sizeof(nxld_plugin_t));
+    
+    FILE* fp = fopen(input_path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    
+    char line[MAX_DESCRIPTION_LENGTH * 4];
+    nxld_interface_info_t* iface = NULL;
+    nxld_param_info_t* param = NULL;
+    int in_plugin_section = 0;
+    int result = 0;
+    
+    while (result == 0 && fgets(line, sizeof(line), fp) != NULL) {
+        char* trimmed = trim_metadata_line(line);
+        if (trimmed[0] == '\0' || trimmed[0] == '#') {
+            continue;
+        }
+        
+        if (trimmed[0] == '[') {
+            char* end = strchr(trimmed, ']');
+            if (end == NULL) {
+                continue;
+            }
+            *end = '\0';
+            const char* section = trimmed + 1;
+            
+            in_plugin_section = (strcmp(section, "Plugin") == 0);
+            param = NULL;
+            if (strncmp(section, "Interface_", 10) == 0) {
+                size_t index = (size_t)strtoul(section + 10, NULL, 10);
+                iface = index < plugin->interface_count ? &plugin->interfaces[index] : NULL;
+            } else if (section[0] >= '0' && section[0] <= '9') {
+                // 接口段内的参数子块 / Parameter sub-block inside interface section / Parameter-Unterblock innerhalb des Schnittstellenabschnitts
+                size_t index = (size_t)strtoul(section, NULL, 10);
+                param = (iface != NULL && index < iface->param_count) ? &iface->params[index] : NULL;
+            } else {
+                iface = NULL;
+            }
+            continue;
+        }
+        
+        char* eq_pos = strchr(trimmed, '=');
+        if (eq_pos == NULL) {
+            continue;
+        }
+        *eq_pos = '\0';
+        const char* key = trimmed;
+        const char* value = eq_pos + 1;
+        
+        if (param != NULL) {
+            if (strcmp(key, "Name") == 0) {
+                result = set_metadata_string(&param->name, value);
+            } else if (strcmp(key, "Type") == 0) {
+                param->type = parse_param_type_name(value);
+            } else if (strcmp(key, "TypeName") == 0) {
+                result = set_metadata_string(&param->type_name, value);
+            }
+        } else if (iface != NULL) {
+            if (strcmp(key, "Name") == 0) {
+                result = set_metadata_string(&iface->name, value);
+            } else if (strcmp(key, "Description") == 0) {
+                result = set_metadata_string(&iface->description, value);
+            } else if (strcmp(key, "Version") == 0) {
+                result = set_metadata_string(&iface->version, value);
+            } else if (strcmp(key, "ParamCountType") == 0) {
+                iface->param_count_type = parse_param_count_type_name(value);
+            } else if (strcmp(key, "MinParamCount") == 0) {
+                iface->min_param_count = atoi(value);
+            } else if (strcmp(key, "MaxParamCount") == 0) {
+                iface->max_param_count = strcmp(value, "unlimited") == 0 ? -1 : atoi(value);
+            } else if (strcmp(key, "Pure") == 0) {
+                iface->pure = (strcmp(value, "true") == 0 || strcmp(value, "1") == 0);
+            } else if (strcmp(key, "CacheCapacity") == 0) {
+                iface->cache_capacity = (size_t)strtoul(value, NULL, 10);
+            } else if (strcmp(key, "FixedParamCount") == 0 && iface->params == NULL) {
+                int count = atoi(value);
+                if (count > 0) {
+                    iface->params = (nxld_param_info_t*)calloc((size_t)count, sizeof(nxld_param_info_t));
+                    if (iface->params == NULL) {
+                        result = -1;
+                    } else {
+                        iface->param_count = (size_t)count;
+                    }
+                }
+            }
+        } else if (in_plugin_section) {
+            if (strcmp(key, "Name") == 0) {
+                result = set_metadata_string(&plugin->plugin_name, value);
+            } else if (strcmp(key, "Version") == 0) {
+                result = set_metadata_string(&plugin->plugin_version, value);
+            } else if (strcmp(key, "Path") == 0) {
+                result = set_metadata_string(&plugin->plugin_path, value);
+            } else if (strcmp(key, "UID") == 0) {
+                strcpy_safe(plugin->uid, sizeof(plugin->uid), value);
+            }
+        } else if (strcmp(key, "Count") == 0 && plugin->interfaces == NULL) {
+            size_t count = (size_t)strtoul(value, NULL, 10);
+            if (count > 0) {
+                plugin->interfaces = (nxld_interface_info_t*)calloc(count, sizeof(nxld_interface_info_t));
+                if (plugin->interfaces == NULL) {
+                    result = -1;
+                } else {
+                    plugin->interface_count = count;
+                }
+            }
+        }
+    }
+    
+    fclose(fp);
+    
+    if (result != 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_PLUGIN, "Memory allocation failed while reading metadata file: %s", input_path);
+        nxld_plugin_free(plugin);
+        return -1;
+    }
+    
+    return 0;
+}
+
+void* nxld_plugin_get_symbol(const nxld_plugin_t* plugin, const char* symbol_name) {
+    if (plugin == NULL) {
+        return NULL;
+    }
+    return get_symbol(plugin->handle, symbol_name);
+}
+
+#if defined(__linux__)
+/**
+ * @brief 页面预取目标结构体 / Page prefault target structure / Zielstruktur für das Vorabeinlesen von Seiten
+ */
+typedef struct {
+    uintptr_t base;                         /**< 动态库加载基址 / Library load base / Ladebasis der Bibliothek */
+    uintptr_t page_size;                    /**< 页面大小 / Page size / Seitengröße */
+    size_t pages;                           /**< 已访问页面数量 / Pages touched / Berührte Seiten */
+} prefault_target_t;
+
+/**
+ * @brief 访问匹配动态库的可读段 / Touch readable segments of the matching library / Lesbare Segmente der passenden Bibliothek berühren
+ */
+static int prefault_segments(struct dl_phdr_info* info, size_t size, void* data) {
+    prefault_target_t* target = (prefault_target_t*)data;
+    (void)size;
+    if ((uintptr_t)info->dlpi_addr != target->base) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type != PT_LOAD || (phdr->p_flags & PF_R) == 0) {
+            continue;
+        }
+        uintptr_t start = (target->base + phdr->p_vaddr) & ~(target->page_size - 1);
+        uintptr_t end = target->base + phdr->p_vaddr + phdr->p_memsz;
+        for (uintptr_t page = start; page < end; page += target->page_size) {
+            (void)*(volatile const unsigned char*)page;
+            target->pages++;
+        }
+    }
+    return 1;
+}
+#endif
+
+size_t nxld_plugin_prefault(const nxld_plugin_t* plugin) {
+    if (plugin == NULL || plugin->handle == NULL) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    // 模块句柄即映像基址，按节表访问可读节 / The module handle is the image base; readable sections are touched via the section table / Das Modul-Handle ist die Abbildbasis; lesbare Abschnitte werden über die Abschnittstabelle berührt
+    const unsigned char* base = (const unsigned char*)plugin->handle;
+    const IMAGE_DOS_HEADER* dos = (const IMAGE_DOS_HEADER*)base;
+    const IMAGE_NT_HEADERS* nt = (const IMAGE_NT_HEADERS*)(base + dos->e_lfanew);
+    const IMAGE_SECTION_HEADER* section = IMAGE_FIRST_SECTION(nt);
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    size_t page_size = system_info.dwPageSize;
+    size_t pages = 0;
+
+    for (WORD i = 0; i < nt->FileHeader.NumberOfSections; i++, section++) {
+        if ((section->Characteristics & IMAGE_SCN_MEM_READ) == 0) {
+            continue;
+        }
+        size_t start = section->VirtualAddress & ~(page_size - 1);
+        size_t end = (size_t)section->VirtualAddress + section->Misc.VirtualSize;
+        for (size_t offset = start; offset < end; offset += page_size) {
+            (void)*(volatile const unsigned char*)(base + offset);
+            pages++;
+        }
+    }
+    return pages;
+#else
+#ifdef RTLD_NOLOAD
+    // 以RTLD_NOW重新打开已加载的库，立即绑定其延迟导入 / Reopening the loaded library with RTLD_NOW binds its lazy imports immediately / Erneutes Öffnen der geladenen Bibliothek mit RTLD_NOW bindet ihre verzögerten Importe sofort
+    if (plugin->plugin_path != NULL) {
+        void* handle = dlopen(plugin->plugin_path, RTLD_NOW | RTLD_NOLOAD);
+        if (handle != NULL) {
+            dlclose(handle);
+        }
+    }
+#endif
+#if defined(__linux__)
+    struct link_map* map = NULL;
+    if (dlinfo(plugin->handle, RTLD_DI_LINKMAP, &map) != 0 || map == NULL) {
+        return 0;
+    }
+
+    prefault_target_t target;
+    target.base = (uintptr_t)map->l_addr;
+    target.page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+    target.pages = 0;
+    dl_iterate_phdr(prefault_segments, &target);
+    return target.pages;
+#else
     return 0;
+#endif
+#endif
+}
+
+const nxld_interface_info_t* nxld_plugin_find_interface(const nxld_plugin_t* plugin, const char* interface_name) {
+    if (plugin == NULL || interface_name == NULL || plugin->interfaces == NULL) {
+        return NULL;
+    }
+    
+    for (size_t i = 0; i < plugin->interface_count; i++) {
+        if (plugin->interfaces[i].name != NULL && strcmp(plugin->interfaces[i].name, interface_name) == 0) {
+            return &plugin->interfaces[i];
+        }
+    }
+    return NULL;
 }
 
@@ -31,6 +31,8 @@ typedef struct {
     int max_param_count;                    /**< 最大参数数量（-1表示无限制） / Maximum parameter count (-1 for unlimited) / Maximalparameteranzahl (-1 für unbegrenzt) */
     nxld_param_info_t* params;               /**< 参数信息数组 / Parameter information array / Parameterinformationsarray */
     size_t param_count;                     /**< 参数数量（固定参数的数量） / Parameter count (count of fixed parameters) / Parameteranzahl (Anzahl der festen Parameter) */
+    int pure;                               /**< 是否声明为纯函数 / Whether declared pure / Ob als rein deklariert */
+    size_t cache_capacity;                  /**< 结果缓存的最大条目数量（0表示引擎默认值） / Maximum entry count of the result cache (0 for the engine default) / Maximale Eintragsanzahl des Ergebniscaches (0 für den Engine-Standard) */
 } nxld_interface_info_t;
 
 /**
@@ -73,6 +75,11 @@ typedef int (*nxld_plugin_get_interface_param_info_func)(size_t index, int param
                                                           char* param_name, size_t name_size,
                                                           nxld_param_type_t* param_type,
                                                           char* type_name, size_t type_name_size);
+typedef int (*nxld_plugin_get_interface_purity_func)(size_t index, int* pure, size_t* cache_capacity);
+typedef void (*nxld_plugin_set_host_services_func)(const nxld_host_services_t* services);
+typedef void* (*nxld_plugin_create_context_func)(void);
+typedef void (*nxld_plugin_destroy_context_func)(void* context);
+typedef void (*nxld_plugin_bind_context_func)(void* context);
 
 /**
  * @brief 加载插件 / Load plugin / Plugin laden
@@ -109,6 +116,39 @@ const char* nxld_plugin_get_error_message(nxld_plugin_load_result_t result);
  */
 int nxld_plugin_generate_metadata_file(const nxld_plugin_t* plugin, const char* output_path);
 
+/**
+ * @brief 读取插件元数据文件 / Read plugin metadata file / Plugin-Metadaten-Datei lesen
+ * @param input_path 输入文件路径（.nxp文件） / Input file path (.nxp file) / Eingabedateipfad (.nxp-Datei)
+ * @param plugin 输出插件结构体指针（不加载动态库，handle为NULL） / Output plugin structure pointer (dynamic library is not loaded, handle is NULL) / Ausgabe-Plugin-Strukturzeiger (dynamische Bibliothek wird nicht geladen, handle ist NULL)
+ * @return 成功返回0，失败返回非0 / Returns 0 on success, non-zero on failure / Gibt 0 bei Erfolg zurück, ungleich 0 bei Fehler
+ * @details 用于在不加载插件的情况下获取接口签名 / Used to obtain interface signatures without loading the plugin / Dient zum Abrufen von Schnittstellensignaturen ohne Laden des Plugins
+ */
+int nxld_plugin_read_metadata_file(const char* input_path, nxld_plugin_t* plugin);
+
+/**
+ * @brief 获取插件导出符号 / Get plugin exported symbol / Exportiertes Plugin-Symbol abrufen
+ * @param plugin 插件结构体指针 / Plugin structure pointer / Plugin-Strukturzeiger
+ * @param symbol_name 符号名称 / Symbol name / Symbolname
+ * @return 符号地址，失败返回NULL / Symbol address, NULL on failure / Symboladresse, NULL bei Fehler
+ */
+void* nxld_plugin_get_symbol(const nxld_plugin_t* plugin, const char* symbol_name);
+
+/**
+ * @brief 预先访问插件映像的页面 / Fault in the pages of the plugin image / Seiten des Plugin-Abbilds vorab einlesen
+ * @param plugin 已加载的插件结构体指针 / Loaded plugin structure pointer / Zeiger auf geladene Plugin-Struktur
+ * @return 访问的页面数量，不支持或失败返回0 / Number of pages touched, 0 if unsupported or on failure / Anzahl berührter Seiten, 0 wenn nicht unterstützt oder bei Fehler
+ * @details 在glibc上同时立即绑定插件的延迟导入 / On glibc also binds the plugin's lazy imports immediately / Bindet unter glibc außerdem die verzögerten Importe des Plugins sofort
+ */
+size_t nxld_plugin_prefault(const nxld_plugin_t* plugin);
+
+/**
+ * @brief 按名称查找插件接口 / Find plugin interface by name / Plugin-Schnittstelle nach Namen suchen
+ * @param plugin 插件结构体指针 / Plugin structure pointer / Plugin-Strukturzeiger
+ * @param interface_name 接口名称 / Interface name / Schnittstellenname
+ * @return 接口信息指针，未找到返回NULL / Interface info pointer, NULL if not found / Schnittstelleninformationszeiger, NULL wenn nicht gefunden
+ */
+const nxld_interface_info_t* nxld_plugin_find_interface(const nxld_plugin_t* plugin, const char* interface_name);
+
 #endif /* NXLD_PLUGIN_H */
 
 
@@ -72,9 +72,49 @@ typedef enum {
     NXLD_PARAM_TYPE_STRING,                /**< 字符串类型 / string type / Zeichenfolgen-Typ */
     NXLD_PARAM_TYPE_VARIADIC,              /**< 可变参数类型 / variadic type / variabler Parametertyp */
     NXLD_PARAM_TYPE_ANY,                   /**< 任意类型 / any type / beliebiger Typ */
-    NXLD_PARAM_TYPE_UNKNOWN                /**< 未知类型 / unknown type / unbekannter Typ */
+    NXLD_PARAM_TYPE_UNKNOWN,               /**< 未知类型 / unknown type / unbekannter Typ */
+    NXLD_PARAM_TYPE_BUFFER                 /**< 缓冲区描述符指针（nxld_buffer_t*），追加在末尾以保持已有取值不变 / Buffer descriptor pointer (nxld_buffer_t*), appended last to keep existing values stable / Pufferdeskriptor-Zeiger (nxld_buffer_t*), am Ende angehängt, damit bestehende Werte stabil bleiben */
 } nxld_param_type_t;
 
+/**
+ * @brief 缓冲区释放回调 / Buffer release callback / Puffer-Freigabe-Callback
+ * @param owner 所有者上下文 / Owner context / Besitzerkontext
+ * @param data 缓冲区数据指针 / Buffer data pointer / Pufferdatenzeiger
+ */
+typedef void (*nxld_buffer_release_fn)(void* owner, void* data);
+
+/**
+ * @brief 零拷贝缓冲区描述符 / Zero-copy buffer descriptor / Zero-Copy-Pufferdeskriptor
+ * @details 作为NXLD_PARAM_TYPE_BUFFER参数按指针传递；导出接口返回的缓冲区在消费接口调用后由引擎释放，调用方传入的缓冲区仍归调用方所有 / Passed by pointer as an NXLD_PARAM_TYPE_BUFFER parameter; buffers returned by export interfaces are released by the engine after the consuming call, buffers passed in by the caller stay owned by the caller / Wird als NXLD_PARAM_TYPE_BUFFER-Parameter per Zeiger übergeben; von Exportschnittstellen zurückgegebene Puffer gibt die Engine nach dem verbrauchenden Aufruf frei, vom Aufrufer übergebene Puffer bleiben im Besitz des Aufrufers
+ */
+typedef struct {
+    void* data;                             /**< 数据指针 / Data pointer / Datenzeiger */
+    size_t count;                           /**< 元素数量 / Element count / Elementanzahl */
+    nxld_param_type_t element_type;         /**< 元素类型 / Element type / Elementtyp */
+    size_t element_size;                    /**< 元素大小（字节） / Element size in bytes / Elementgröße in Bytes */
+    size_t alignment;                       /**< 数据对齐（字节） / Data alignment in bytes / Datenausrichtung in Bytes */
+    void* owner;                            /**< 所有者上下文 / Owner context / Besitzerkontext */
+    nxld_buffer_release_fn release;         /**< 释放回调（NULL表示无需释放） / Release callback (NULL if nothing to release) / Freigabe-Callback (NULL, wenn nichts freizugeben ist) */
+} nxld_buffer_t;
+
+/**
+ * @brief 释放缓冲区描述符持有的数据 / Release data held by a buffer descriptor / Von einem Pufferdeskriptor gehaltene Daten freigeben
+ * @param buffer 缓冲区描述符指针 / Buffer descriptor pointer / Pufferdeskriptor-Zeiger
+ * @details 调用后描述符被清空，重复调用无副作用 / The descriptor is cleared afterwards, repeated calls have no effect / Der Deskriptor wird danach geleert, wiederholte Aufrufe sind wirkungslos
+ */
+static inline void nxld_buffer_release(nxld_buffer_t* buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+    if (buffer->release != NULL) {
+        buffer->release(buffer->owner, buffer->data);
+    }
+    buffer->data = NULL;
+    buffer->count = 0;
+    buffer->owner = NULL;
+    buffer->release = NULL;
+}
+
 /**
  * @brief 参数数量类型枚举 / Parameter count type enumeration / Parameteranzahl-Typ-Aufzählung
  */
@@ -112,6 +152,68 @@ NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_info(size_t index, int pa
                                                               nxld_param_type_t* param_type,
                                                               char* type_name, size_t type_name_size);
 
+/**
+ * @brief 获取接口纯函数声明（可选导出） / Get interface purity declaration (optional export) / Reinheitsdeklaration der Schnittstelle abrufen (optionaler Export)
+ * @param index 接口索引 / Interface index / Schnittstellenindex
+ * @param pure 输出接口是否为纯函数 / Output whether the interface is pure / Ausgabe, ob die Schnittstelle rein ist
+ * @param cache_capacity 输出结果缓存的最大条目数量（0表示引擎默认值） / Output maximum entry count of the result cache (0 for the engine default) / Ausgabe der maximalen Eintragsanzahl des Ergebniscaches (0 für den Engine-Standard)
+ * @return 成功返回0，失败返回非0 / Returns 0 on success, non-zero on failure / Gibt 0 bei Erfolg zurück, ungleich 0 bei Fehler
+ * @details 纯接口的返回值只取决于参数值，且调用没有其他接口依赖的副作用；返回的指针在插件卸载前保持有效。引擎按参数值缓存其返回值，命中时不调用插件 / A pure interface's return value depends only on its argument values and the call has no side effect other interfaces rely on; returned pointers stay valid until the plugin is unloaded. The engine caches its return values by argument value and does not call the plugin on a hit / Der Rückgabewert einer reinen Schnittstelle hängt nur von ihren Argumentwerten ab und der Aufruf hat keine Nebenwirkung, auf die andere Schnittstellen angewiesen sind; zurückgegebene Zeiger bleiben bis zum Entladen des Plugins gültig. Die Engine speichert ihre Rückgabewerte nach Argumentwert zwischen und ruft das Plugin bei einem Treffer nicht auf
+ */
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_purity(size_t index, int* pure, size_t* cache_capacity);
+
+/**
+ * @brief 主机服务表版本 / Host services table version / Version der Host-Dienst-Tabelle
+ */
+#define NXLD_HOST_SERVICES_VERSION 2
+
+/**
+ * @brief 流句柄（不透明） / Stream handle (opaque) / Stream-Handle (undurchsichtig)
+ * @details TransferMode=stream规则中生产者接口在源参数槽收到该句柄 / Producer interfaces of TransferMode=stream rules receive this handle in their source parameter slot / Erzeugerschnittstellen von TransferMode=stream-Regeln erhalten dieses Handle in ihrem Quellparameter-Slot
+ */
+typedef struct nxld_stream nxld_stream_t;
+
+/**
+ * @brief 主机服务表结构体（引擎提供给插件的函数） / Host services table structure (functions the engine offers to plugins) / Host-Dienst-Tabellenstruktur (Funktionen, die die Engine Plugins anbietet)
+ * @details 新字段只追加在末尾，插件应检查size后再访问 / New fields are only appended, plugins should check size before accessing them / Neue Felder werden nur angehängt, Plugins sollten vor dem Zugriff size prüfen
+ */
+typedef struct {
+    unsigned int version;                   /**< 表版本 / Table version / Tabellenversion */
+    size_t size;                            /**< 表大小（字节） / Table size in bytes / Tabellengröße in Bytes */
+    void* (*alloc_large)(size_t size, size_t alignment);  /**< 从引擎缓冲池分配大块内存 / Allocate large block from the engine buffer pool / Großen Block aus dem Engine-Pufferpool zuweisen */
+    void (*free_large)(void* ptr);          /**< 归还大块内存到缓冲池 / Return large block to the buffer pool / Großen Block an den Pufferpool zurückgeben */
+    int (*alloc_buffer)(nxld_buffer_t* buffer, size_t count, nxld_param_type_t element_type, size_t element_size);  /**< 分配池化缓冲区描述符（释放回调归还到池） / Allocate pooled buffer descriptor (release callback returns it to the pool) / Gepoolten Pufferdeskriptor zuweisen (Freigabe-Callback gibt ihn an den Pool zurück) */
+    nxld_buffer_t* (*stream_acquire)(nxld_stream_t* stream, size_t* capacity_bytes);  /**< 获取空分块（版本2） / Acquire empty chunk (version 2) / Leeren Block holen (Version 2) */
+    int (*stream_commit)(nxld_stream_t* stream, nxld_buffer_t* chunk);  /**< 提交已填充分块（版本2） / Commit filled chunk (version 2) / Gefüllten Block übergeben (Version 2) */
+} nxld_host_services_t;
+
+/**
+ * @brief 接收主机服务表（可选导出） / Receive host services table (optional export) / Host-Dienst-Tabelle empfangen (optionaler Export)
+ * @param services 主机服务表指针，在插件卸载前有效 / Host services table pointer, valid until the plugin is unloaded / Host-Dienst-Tabellen-Zeiger, gültig bis zum Entladen des Plugins
+ * @details 插件加载后由引擎调用一次 / Called once by the engine after the plugin is loaded / Wird nach dem Laden des Plugins einmal von der Engine aufgerufen
+ */
+NXLD_PLUGIN_EXPORT void nxld_plugin_set_host_services(const nxld_host_services_t* services);
+
+/**
+ * @brief 创建调用链上下文（可选导出，上下文感知插件） / Create per-chain context (optional export, context-aware plugins) / Kettenkontext erstellen (optionaler Export, kontextbewusste Plugins)
+ * @return 插件私有的上下文指针，保存原本放在全局变量中的状态 / Plugin-private context pointer holding state that would otherwise live in globals / Plugin-eigener Kontextzeiger mit dem Zustand, der sonst in globalen Variablen läge
+ * @details 引擎为每个执行上下文创建一次 / Created once per engine execution context / Wird je Ausführungskontext der Engine einmal erstellt
+ */
+NXLD_PLUGIN_EXPORT void* nxld_plugin_create_context(void);
+
+/**
+ * @brief 销毁调用链上下文（可选导出） / Destroy per-chain context (optional export) / Kettenkontext zerstören (optionaler Export)
+ * @param context 由nxld_plugin_create_context返回的上下文 / Context returned by nxld_plugin_create_context / Von nxld_plugin_create_context zurückgegebener Kontext
+ */
+NXLD_PLUGIN_EXPORT void nxld_plugin_destroy_context(void* context);
+
+/**
+ * @brief 绑定调用链上下文到当前线程（可选导出） / Bind per-chain context to the calling thread (optional export) / Kettenkontext an den aufrufenden Thread binden (optionaler Export)
+ * @param context 由nxld_plugin_create_context返回的上下文 / Context returned by nxld_plugin_create_context / Von nxld_plugin_create_context zurückgegebener Kontext
+ * @details 引擎在每次调用插件接口前于同一线程调用；同时导出三个函数的插件可被多个调用链并发使用 / Called by the engine on the same thread before every interface call; plugins exporting all three functions may be used by several chains concurrently / Wird von der Engine vor jedem Schnittstellenaufruf im selben Thread aufgerufen; Plugins mit allen drei Exporten dürfen von mehreren Ketten gleichzeitig verwendet werden
+ */
+NXLD_PLUGIN_EXPORT void nxld_plugin_bind_context(void* context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -95,7 +95,7 @@ static int build_plugin_full_path(const char* config_dir, const char* plugin_pat
 int nxld_load_plugins_from_config(const nxld_config_t* config, const char* config_file_path, 
                                    nxld_plugin_t** plugins, size_t* loaded_count) {
     if (config == NULL || config_file_path == NULL || plugins == NULL || loaded_count == NULL) {
-        nxld_log_error("Invalid parameters for plugin loading");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Invalid parameters for plugin loading");
         return -1;
     }
     
@@ -107,7 +107,7 @@ int nxld_load_plugins_from_config(const nxld_config_t* config, const char* confi
     
     nxld_plugin_t* plugin_array = (nxld_plugin_t*)malloc(config->enabled_root_plugins_count * sizeof(nxld_plugin_t));
     if (plugin_array == NULL) {
-        nxld_log_error("Memory allocation failed for plugin array");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for plugin array");
         return -1;
     }
     
@@ -115,7 +115,7 @@ int nxld_load_plugins_from_config(const nxld_config_t* config, const char* confi
     
     char config_dir[4096];
     if (!get_config_dir(config_file_path, config_dir, sizeof(config_dir))) {
-        nxld_log_error("Failed to get config file directory");
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Failed to get config file directory");
         free(plugin_array);
         return -1;
     }
@@ -125,18 +125,18 @@ int nxld_load_plugins_from_config(const nxld_config_t* config, const char* confi
     for (size_t i = 0; i < config->enabled_root_plugins_count; i++) {
         char full_path[4096];
         if (!build_plugin_full_path(config_dir, config->enabled_root_plugins[i], full_path, sizeof(full_path))) {
-            nxld_log_error("Failed to build full path for plugin: %s", config->enabled_root_plugins[i]);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Failed to build full path for plugin: %s", config->enabled_root_plugins[i]);
             continue;
         }
         
         nxld_plugin_load_result_t load_result = nxld_plugin_load(full_path, &plugin_array[success_count]);
         if (load_result != NXLD_PLUGIN_LOAD_SUCCESS) {
             const char* error_msg = nxld_plugin_get_error_message(load_result);
-            nxld_log_error("Failed to load plugin %s (index %zu): %s", config->enabled_root_plugins[i], i, error_msg);
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Failed to load plugin %s (index %zu): %s", config->enabled_root_plugins[i], i, error_msg);
             continue;
         }
         
-        nxld_log_info("Plugin loaded successfully: %s (UID: %s, index: %zu)", 
+        NXLD_LOG_INFO(NXLD_LOG_MODULE_LOADER, "Plugin loaded successfully: %s (UID: %s, index: %zu)", 
                      config->enabled_root_plugins[i], plugin_array[success_count].uid, i);
         success_count++;
     }
@@ -144,7 +144,7 @@ int nxld_load_plugins_from_config(const nxld_config_t* config, const char* confi
     *plugins = plugin_array;
     *loaded_count = success_count;
     
-    nxld_log_info("Total plugins loaded: %zu/%zu", success_count, config->enabled_root_plugins_count);
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_LOADER, "Total plugins loaded: %zu/%zu", success_count, config->enabled_root_plugins_count);
     
     return 0;
 }
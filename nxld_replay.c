@@ -0,0 +1,1005 @@
+/**
+ * @file nxld_replay.c
+ * @brief NXLD入口调用录制与回放实现 / NXLD Entry Invocation Record and Replay Implementation / NXLD-Implementierung zum Aufzeichnen und Wiedergeben von Einstiegsaufrufen
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_replay.h"
+#include "nxld_logger.h"
+#include "nxld_thread.h"
+#include "nxld_string_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <errno.h>
+#endif
+
+#define REPLAY_MAGIC "NXRP"
+#define REPLAY_VERSION 1
+#define RECORD_ROUTE 1
+#define RECORD_CALL 2
+#define RECORD_HOPS 3
+#define VALUE_NULL_FLAG 0x80
+#define MAX_ENDPOINT_LENGTH 1024
+#define RECORDER_BUFFER_SIZE (64 * 1024)
+#define REPLAY_BUFFER_INITIAL 256
+
+/**
+ * @brief 可增长字节缓冲区结构体 / Growable byte buffer structure / Struktur eines wachsenden Bytepuffers
+ */
+typedef struct {
+    unsigned char* data;                    /**< 数据 / Data / Daten */
+    size_t length;                          /**< 已写入字节数 / Bytes written / Geschriebene Bytes */
+    size_t capacity;                        /**< 容量 / Capacity / Kapazität */
+    int error;                              /**< 分配是否失败 / Whether an allocation failed / Ob eine Zuweisung fehlgeschlagen ist */
+} replay_buffer_t;
+
+/**
+ * @brief 单次调用的逐跳轨迹结构体 / Per-invocation hop trace structure / Struktur der Sprungspur eines Aufrufs
+ * @details 每个执行线程一份，路由结束时整体写出，并发调用的跳不会交错 / One per executing thread, written out as a whole when the route ends so hops of concurrent invocations never interleave / Eine je ausführendem Thread, wird beim Routenende als Ganzes geschrieben, sodass sich Sprünge gleichzeitiger Aufrufe nie verschränken
+ */
+typedef struct replay_trace {
+    replay_buffer_t buffer;                 /**< 已编码的跳 / Encoded hops / Kodierte Sprünge */
+    size_t hops;                            /**< 跳数量 / Hop count / Anzahl der Sprünge */
+    int depth;                              /**< 路由嵌套深度 / Route nesting depth / Verschachtelungstiefe der Routen */
+    struct replay_trace* next;              /**< 录制器中的下一条轨迹 / Next trace of the recorder / Nächste Spur des Aufzeichners */
+} replay_trace_t;
+
+/**
+ * @brief 录制器结构体 / Recorder structure / Aufzeichner-Struktur
+ */
+struct nxld_replay_recorder {
+    FILE* file;                             /**< 录制文件 / Recording file / Aufzeichnungsdatei */
+    char* path;                             /**< 录制文件路径 / Recording file path / Pfad der Aufzeichnungsdatei */
+    nxld_mutex_t mutex;                     /**< 写入互斥锁 / Write mutex / Schreib-Mutex */
+    replay_buffer_t record;                 /**< 正在组装的记录（受mutex保护） / Record being assembled (guarded by mutex) / Zusammengesetzter Datensatz (durch mutex geschützt) */
+    nxld_transfer_plan_t* plan;             /**< 观察的执行计划（未挂接时为NULL） / Observed execution plan (NULL when not attached) / Beobachteter Ausführungsplan (NULL wenn nicht angehängt) */
+    nxld_tls_t trace_key;                   /**< 当前线程轨迹的线程局部键 / Thread-local key of the current thread's trace / Threadlokaler Schlüssel der Spur des aktuellen Threads */
+    replay_trace_t* traces;                 /**< 所有线程的轨迹（受mutex保护） / Traces of all threads (guarded by mutex) / Spuren aller Threads (durch mutex geschützt) */
+    size_t trace_count;                     /**< 已写出的轨迹数量 / Traces written / Geschriebene Spuren */
+    int write_failed;                       /**< 是否有记录未能写出 / Whether a record could not be written / Ob ein Datensatz nicht geschrieben werden konnte */
+    nxld_string_index_t routes;             /**< 源端点到路由编号的索引 / Index from source endpoint to route id / Index vom Quellendpunkt auf die Routennummer */
+    size_t route_count;                     /**< 已写出的路由数量 / Routes written / Geschriebene Routen */
+    size_t call_count;                      /**< 已写出的调用数量 / Invocations written / Geschriebene Aufrufe */
+    size_t opaque_count;                    /**< 只记录为不透明指针的值数量 / Values recorded as opaque pointers only / Nur als undurchsichtige Zeiger erfasste Werte */
+    uint64_t last_ns;                       /**< 上一次调用的时间戳 / Timestamp of the previous invocation / Zeitstempel des vorherigen Aufrufs */
+};
+
+/**
+ * @brief 读取游标结构体 / Read cursor structure / Lesecursor-Struktur
+ */
+typedef struct {
+    const unsigned char* pos;               /**< 当前位置 / Current position / Aktuelle Position */
+    const unsigned char* end;               /**< 数据结尾 / End of data / Datenende */
+    int error;                              /**< 数据是否截断或损坏 / Whether data is truncated or corrupt / Ob die Daten abgeschnitten oder beschädigt sind */
+} replay_cursor_t;
+
+/**
+ * @brief 追加字节 / Append bytes / Bytes anhängen
+ */
+static void buffer_put(replay_buffer_t* buffer, const void* data, size_t length) {
+    if (buffer->error || length == 0) {
+        return;
+    }
+    if (length > buffer->capacity - buffer->length) {
+        size_t capacity = buffer->capacity > 0 ? buffer->capacity : REPLAY_BUFFER_INITIAL;
+        while (length > capacity - buffer->length) {
+            capacity *= 2;
+        }
+        unsigned char* grown = (unsigned char*)realloc(buffer->data, capacity);
+        if (grown == NULL) {
+            buffer->error = 1;
+            return;
+        }
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+}
+
+/**
+ * @brief 追加单个字节 / Append one byte / Ein Byte anhängen
+ */
+static void write_byte(replay_buffer_t* buffer, int value) {
+    unsigned char byte = (unsigned char)value;
+    buffer_put(buffer, &byte, 1);
+}
+
+/**
+ * @brief 写出变长无符号整数 / Write variable-length unsigned integer / Vorzeichenlose Ganzzahl variabler Länge schreiben
+ */
+static void write_varint(replay_buffer_t* buffer, uint64_t value) {
+    unsigned char bytes[10];
+    size_t count = 0;
+    do {
+        bytes[count] = (unsigned char)(value & 0x7f);
+        value >>= 7;
+        if (value != 0) {
+            bytes[count] |= 0x80;
+        }
+        count++;
+    } while (value != 0);
+    buffer_put(buffer, bytes, count);
+}
+
+/**
+ * @brief 写出有符号整数（ZigZag编码） / Write signed integer (ZigZag encoded) / Vorzeichenbehaftete Ganzzahl schreiben (ZigZag-kodiert)
+ */
+static void write_signed(replay_buffer_t* buffer, long long value) {
+    write_varint(buffer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/**
+ * @brief 写出带长度前缀的字节串 / Write length-prefixed bytes / Bytes mit Längenpräfix schreiben
+ */
+static void write_bytes(replay_buffer_t* buffer, const void* data, size_t length) {
+    write_varint(buffer, length);
+    buffer_put(buffer, data, length);
+}
+
+/**
+ * @brief 写出字符串 / Write string / Zeichenfolge schreiben
+ */
+static void write_string(replay_buffer_t* buffer, const char* text) {
+    write_bytes(buffer, text, text != NULL ? strlen(text) : 0);
+}
+
+/**
+ * @brief 写出按参数类型转换后的值 / Write value converted by parameter type / Nach Parametertyp konvertierten Wert schreiben
+ * @param word 调用时传递的机器字：INT/LONG/CHAR为数值，STRING为字符串指针，BUFFER为缓冲区描述符指针 / Machine word passed to the call: the number for INT/LONG/CHAR, the string pointer for STRING, the buffer descriptor pointer for BUFFER / An den Aufruf übergebenes Maschinenwort: die Zahl bei INT/LONG/CHAR, der Zeichenfolgenzeiger bei STRING, der Pufferdeskriptorzeiger bei BUFFER
+ * @return 值只记录为不透明指针返回1，否则返回0 / Returns 1 if the value is only recorded as an opaque pointer, 0 otherwise / Gibt 1 zurück, wenn der Wert nur als undurchsichtiger Zeiger erfasst wird, sonst 0
+ */
+static int write_word(replay_buffer_t* buffer, nxld_param_type_t type, intptr_t word) {
+    switch (type) {
+        case NXLD_PARAM_TYPE_INT:
+            write_byte(buffer, (int)type);
+            write_signed(buffer, (int)word);
+            return 0;
+        case NXLD_PARAM_TYPE_LONG:
+            write_byte(buffer, (int)type);
+            write_signed(buffer, (long)word);
+            return 0;
+        case NXLD_PARAM_TYPE_CHAR:
+            write_byte(buffer, (int)type);
+            write_signed(buffer, (char)word);
+            return 0;
+        case NXLD_PARAM_TYPE_STRING:
+            if (word == 0) {
+                write_byte(buffer, (int)type | VALUE_NULL_FLAG);
+                return 0;
+            }
+            write_byte(buffer, (int)type);
+            write_string(buffer, (const char*)word);
+            return 0;
+        case NXLD_PARAM_TYPE_BUFFER: {
+            const nxld_buffer_t* descriptor = (const nxld_buffer_t*)word;
+            if (descriptor == NULL) {
+                write_byte(buffer, (int)type | VALUE_NULL_FLAG);
+                return 0;
+            }
+            write_byte(buffer, (int)type);
+            write_varint(buffer, (uint64_t)descriptor->element_type);
+            write_varint(buffer, descriptor->element_size);
+            write_bytes(buffer, descriptor->data, descriptor->data != NULL ? descriptor->count * descriptor->element_size : 0);
+            return 0;
+        }
+        default:
+            // 指针目标的布局未知，只记录类型 / The layout behind the pointer is unknown, only the type is recorded / Das Layout hinter dem Zeiger ist unbekannt, nur der Typ wird erfasst
+            write_byte(buffer, (int)type);
+            return 1;
+    }
+}
+
+/**
+ * @brief 写出一跳：目标端点和传递的参数 / Write one hop: target endpoint and transferred arguments / Einen Sprung schreiben: Zielendpunkt und übergebene Argumente
+ * @details 录制和回放使用同一编码，轨迹可以逐字节比较 / Recording and replay use the same encoding so traces compare byte for byte / Aufzeichnung und Wiedergabe verwenden dieselbe Kodierung, Spuren sind daher byteweise vergleichbar
+ */
+static void write_hop(replay_buffer_t* buffer, const nxld_transfer_plan_t* plan, size_t node_index, const intptr_t* args) {
+    const nxld_plan_node_t* node = &plan->nodes[node_index];
+    const nxld_param_type_t* types = nxld_transfer_plan_get_param_types(plan, node_index);
+    write_string(buffer, plan->plugins[node->plugin_index].plugin_name);
+    write_string(buffer, node->interface_name);
+    write_varint(buffer, (uint64_t)node->param_count);
+    for (int p = 0; p < node->param_count; p++) {
+        write_word(buffer, types[p], args[p]);
+    }
+}
+
+/**
+ * @brief 将组装好的记录写入文件 / Write the assembled record to the file / Zusammengesetzten Datensatz in die Datei schreiben
+ * @details 调用方须持有录制器互斥锁 / Caller must hold the recorder mutex / Aufrufer muss den Aufzeichner-Mutex halten
+ */
+static void flush_record(nxld_replay_recorder_t* recorder) {
+    replay_buffer_t* record = &recorder->record;
+    if (record->error || fwrite(record->data, 1, record->length, recorder->file) != record->length) {
+        recorder->write_failed = 1;
+    }
+    record->length = 0;
+    record->error = 0;
+}
+
+/**
+ * @brief 读取变长无符号整数 / Read variable-length unsigned integer / Vorzeichenlose Ganzzahl variabler Länge lesen
+ */
+static uint64_t read_varint(replay_cursor_t* cursor) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (cursor->pos >= cursor->end) {
+            cursor->error = 1;
+            return 0;
+        }
+        unsigned char byte = *cursor->pos++;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    cursor->error = 1;
+    return 0;
+}
+
+/**
+ * @brief 读取有符号整数 / Read signed integer / Vorzeichenbehaftete Ganzzahl lesen
+ */
+static long long read_signed(replay_cursor_t* cursor) {
+    uint64_t value = read_varint(cursor);
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+/**
+ * @brief 读取带长度前缀的字节串 / Read length-prefixed bytes / Bytes mit Längenpräfix lesen
+ * @return 指向文件数据的指针（不以零结尾） / Pointer into the file data (not zero-terminated) / Zeiger in die Dateidaten (nicht nullterminiert)
+ */
+static const unsigned char* read_bytes(replay_cursor_t* cursor, size_t* length) {
+    uint64_t size = read_varint(cursor);
+    if (cursor->error || size > (uint64_t)(cursor->end - cursor->pos)) {
+        cursor->error = 1;
+        *length = 0;
+        return NULL;
+    }
+    const unsigned char* data = cursor->pos;
+    cursor->pos += size;
+    *length = (size_t)size;
+    return data;
+}
+
+/**
+ * @brief 读取字符串到缓冲区 / Read string into buffer / Zeichenfolge in Puffer lesen
+ */
+static int read_string(replay_cursor_t* cursor, char* out, size_t out_size) {
+    size_t length;
+    const unsigned char* data = read_bytes(cursor, &length);
+    if (cursor->error || length >= out_size) {
+        cursor->error = 1;
+        return -1;
+    }
+    memcpy(out, data, length);
+    out[length] = '\0';
+    return 0;
+}
+
+/**
+ * @brief 格式化常量规则的目标端点 / Format target endpoint of a constant rule / Zielendpunkt einer Konstantenregel formatieren
+ */
+static void format_target(char* out, size_t size, const nxld_transfer_rule_t* rule) {
+    snprintf(out, size, "%s.%s[%d]", rule->target_plugin != NULL ? rule->target_plugin : "",
+             rule->target_interface != NULL ? rule->target_interface : "", rule->target_param_index);
+}
+
+/**
+ * @brief 检查规则是否带有效常量值 / Check whether a rule carries an effective constant value / Prüfen, ob eine Regel einen wirksamen Konstantenwert trägt
+ */
+static int is_constant_rule(const nxld_transfer_rule_t* rule) {
+    return rule->enabled && rule->target_param_value != NULL;
+}
+
+nxld_replay_recorder_t* nxld_replay_recorder_open(const char* path, const nxld_transfer_rule_set_t* rules) {
+    if (path == NULL) {
+        return NULL;
+    }
+
+    nxld_replay_recorder_t* recorder = (nxld_replay_recorder_t*)calloc(1, sizeof(nxld_replay_recorder_t));
+    if (recorder == NULL || (recorder->path = (char*)malloc(strlen(path) + 1)) == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for replay recorder");
+        free(recorder);
+        return NULL;
+    }
+    strcpy(recorder->path, path);
+
+    recorder->file = fopen(path, "wb");
+    if (recorder->file == NULL || nxld_tls_create(&recorder->trace_key) != 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to create replay recording: %s", path);
+        if (recorder->file != NULL) {
+            fclose(recorder->file);
+        }
+        free(recorder->path);
+        free(recorder);
+        return NULL;
+    }
+    setvbuf(recorder->file, NULL, _IOFBF, RECORDER_BUFFER_SIZE);
+    nxld_mutex_init(&recorder->mutex);
+    nxld_string_index_init(&recorder->routes);
+
+    replay_buffer_t* record = &recorder->record;
+    buffer_put(record, REPLAY_MAGIC, 4);
+    write_byte(record, REPLAY_VERSION);
+
+    // 文件头保存常量参数值，回放时据此确认输入一致 / The header keeps the constant parameter values so replay can confirm identical input / Der Kopf enthält die konstanten Parameterwerte, damit die Wiedergabe gleiche Eingaben bestätigen kann
+    size_t constant_count = 0;
+    for (size_t i = 0; rules != NULL && i < rules->rule_count; i++) {
+        constant_count += is_constant_rule(&rules->rules[i]) ? 1 : 0;
+    }
+    write_varint(record, constant_count);
+    for (size_t i = 0; rules != NULL && i < rules->rule_count; i++) {
+        const nxld_transfer_rule_t* rule = &rules->rules[i];
+        if (is_constant_rule(rule)) {
+            char endpoint[MAX_ENDPOINT_LENGTH];
+            format_target(endpoint, sizeof(endpoint), rule);
+            write_string(record, endpoint);
+            write_string(record, rule->target_param_value);
+        }
+    }
+    flush_record(recorder);
+
+    recorder->last_ns = nxld_metrics_now_ns();
+    return recorder;
+}
+
+/**
+ * @brief 录制逐跳轨迹的执行观察函数 / Execution observer recording hop traces / Ausführungsbeobachter, der Sprungspuren aufzeichnet
+ * @details 跳先写入当前线程的轨迹，最外层路由结束时才加锁写出整条轨迹 / Hops go to the current thread's trace first; the whole trace is written under the lock only when the outermost route ends / Sprünge gehen zuerst in die Spur des aktuellen Threads; die ganze Spur wird erst beim Ende der äußersten Route unter der Sperre geschrieben
+ */
+static void record_observer(void* arg, nxld_plan_event_t event, size_t index, const intptr_t* args) {
+    nxld_replay_recorder_t* recorder = (nxld_replay_recorder_t*)arg;
+    replay_trace_t* trace = (replay_trace_t*)nxld_tls_get(recorder->trace_key);
+    if (trace == NULL) {
+        if (event != NXLD_PLAN_EVENT_ROUTE_BEGIN || (trace = (replay_trace_t*)calloc(1, sizeof(replay_trace_t))) == NULL) {
+            return;
+        }
+        nxld_mutex_lock(&recorder->mutex);
+        trace->next = recorder->traces;
+        recorder->traces = trace;
+        nxld_mutex_unlock(&recorder->mutex);
+        nxld_tls_set(recorder->trace_key, trace);
+    }
+
+    switch (event) {
+        case NXLD_PLAN_EVENT_ROUTE_BEGIN:
+            // 插件重入计划时内层路由的跳归入外层调用 / When a plugin re-enters the plan, hops of the inner route belong to the outer invocation / Betritt ein Plugin den Plan erneut, gehören Sprünge der inneren Route zum äußeren Aufruf
+            if (trace->depth++ == 0) {
+                trace->buffer.length = 0;
+                trace->buffer.error = 0;
+                trace->hops = 0;
+            }
+            break;
+        case NXLD_PLAN_EVENT_CALL:
+            if (trace->depth > 0) {
+                write_hop(&trace->buffer, recorder->plan, index, args);
+                trace->hops++;
+            }
+            break;
+        case NXLD_PLAN_EVENT_ROUTE_END:
+            if (trace->depth > 0 && --trace->depth == 0) {
+                nxld_mutex_lock(&recorder->mutex);
+                write_byte(&recorder->record, RECORD_HOPS);
+                write_varint(&recorder->record, trace->hops);
+                write_bytes(&recorder->record, trace->buffer.data, trace->buffer.length);
+                recorder->record.error |= trace->buffer.error;
+                flush_record(recorder);
+                recorder->trace_count++;
+                nxld_mutex_unlock(&recorder->mutex);
+            }
+            break;
+    }
+}
+
+int nxld_replay_recorder_attach(nxld_replay_recorder_t* recorder, nxld_transfer_plan_t* plan) {
+    if (recorder == NULL || plan == NULL || recorder->plan != NULL) {
+        return -1;
+    }
+    recorder->plan = plan;
+    nxld_transfer_plan_set_observer(plan, record_observer, recorder);
+    return 0;
+}
+
+int nxld_replay_record(nxld_replay_recorder_t* recorder, const char* source_plugin, const char* source_interface,
+                       int param_index, nxld_param_type_t type, const void* value) {
+    if (recorder == NULL) {
+        return 0;
+    }
+    if (source_plugin == NULL || source_interface == NULL) {
+        return -1;
+    }
+
+    char key[NXLD_STRING_INDEX_MAX_KEY];
+    if ((size_t)snprintf(key, sizeof(key), "%s" NXLD_STRING_INDEX_SEPARATOR "%s" NXLD_STRING_INDEX_SEPARATOR "%d",
+                         source_plugin, source_interface, param_index) >= sizeof(key)) {
+        return -1;
+    }
+
+    nxld_mutex_lock(&recorder->mutex);
+    replay_buffer_t* record = &recorder->record;
+    size_t route = nxld_string_index_get(&recorder->routes, key);
+    if (route == NXLD_STRING_INDEX_NOT_FOUND) {
+        route = recorder->route_count;
+        if (nxld_string_index_set(&recorder->routes, key, route) != 0) {
+            nxld_mutex_unlock(&recorder->mutex);
+            return -1;
+        }
+        recorder->route_count++;
+        write_byte(record, RECORD_ROUTE);
+        write_varint(record, route);
+        write_string(record, source_plugin);
+        write_string(record, source_interface);
+        write_signed(record, param_index);
+    }
+
+    uint64_t now = nxld_metrics_now_ns();
+    write_byte(record, RECORD_CALL);
+    write_varint(record, route);
+    write_varint(record, now > recorder->last_ns ? now - recorder->last_ns : 0);
+    recorder->last_ns = now;
+
+    // 入口值与逐跳参数使用同一编码，数值类型先按指针解引用 / Entry values use the same encoding as hop arguments, numbers are dereferenced first / Einstiegswerte verwenden dieselbe Kodierung wie Sprungargumente, Zahlen werden zuerst dereferenziert
+    if (value == NULL) {
+        write_byte(record, (int)type | VALUE_NULL_FLAG);
+    } else {
+        intptr_t word = (intptr_t)value;
+        switch (type) {
+            case NXLD_PARAM_TYPE_INT:
+                word = (intptr_t)*(const int*)value;
+                break;
+            case NXLD_PARAM_TYPE_LONG:
+                word = (intptr_t)*(const long*)value;
+                break;
+            case NXLD_PARAM_TYPE_CHAR:
+                word = (intptr_t)*(const char*)value;
+                break;
+            default:
+                break;
+        }
+        // 不透明指针回放时传入NULL / Opaque pointers are replayed as NULL / Undurchsichtige Zeiger werden als NULL wiedergegeben
+        recorder->opaque_count += (size_t)write_word(record, type, word);
+    }
+    flush_record(recorder);
+    recorder->call_count++;
+    nxld_mutex_unlock(&recorder->mutex);
+    return 0;
+}
+
+int nxld_replay_recorder_close(nxld_replay_recorder_t* recorder) {
+    if (recorder == NULL) {
+        return -1;
+    }
+
+    if (recorder->plan != NULL) {
+        nxld_transfer_plan_set_observer(recorder->plan, NULL, NULL);
+    }
+
+    int status = recorder->write_failed || ferror(recorder->file) ? -1 : 0;
+    if (fclose(recorder->file) != 0) {
+        status = -1;
+    }
+    if (status == 0) {
+        NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Replay recording written to %s: %zu invocations on %zu routes, %zu hop traces",
+                      recorder->path, recorder->call_count, recorder->route_count, recorder->trace_count);
+    } else {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to write replay recording: %s", recorder->path);
+    }
+    if (recorder->opaque_count > 0) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "%zu recorded values are opaque pointers and will be replayed as NULL", recorder->opaque_count);
+    }
+
+    replay_trace_t* trace = recorder->traces;
+    while (trace != NULL) {
+        replay_trace_t* next = trace->next;
+        free(trace->buffer.data);
+        free(trace);
+        trace = next;
+    }
+    nxld_tls_delete(recorder->trace_key);
+    nxld_string_index_free(&recorder->routes);
+    nxld_mutex_destroy(&recorder->mutex);
+    free(recorder->record.data);
+    free(recorder->path);
+    free(recorder);
+    return status;
+}
+
+/**
+ * @brief 读取整个文件 / Read whole file / Gesamte Datei lesen
+ */
+static unsigned char* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    size_t capacity = 64 * 1024;
+    size_t length = 0;
+    unsigned char* data = (unsigned char*)malloc(capacity);
+    while (data != NULL) {
+        length += fread(data + length, 1, capacity - length, file);
+        if (length < capacity) {
+            break;
+        }
+        unsigned char* grown = (unsigned char*)realloc(data, capacity * 2);
+        if (grown == NULL) {
+            free(data);
+            data = NULL;
+            break;
+        }
+        data = grown;
+        capacity *= 2;
+    }
+    if (data != NULL && ferror(file)) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = length;
+    return data;
+}
+
+/**
+ * @brief 比较录制时的常量参数值与当前规则集合 / Compare recorded constant parameter values with the current rule set / Aufgezeichnete konstante Parameterwerte mit dem aktuellen Regelsatz vergleichen
+ * @return 一致返回1，不一致返回0 / Returns 1 if they match, 0 otherwise / Gibt 1 bei Übereinstimmung zurück, sonst 0
+ */
+static int compare_constants(replay_cursor_t* cursor, const nxld_transfer_rule_set_t* rules) {
+    uint64_t recorded = read_varint(cursor);
+    size_t next_rule = 0;
+    int match = 1;
+
+    for (uint64_t c = 0; c < recorded && !cursor->error; c++) {
+        char endpoint[MAX_ENDPOINT_LENGTH];
+        size_t value_length;
+        read_string(cursor, endpoint, sizeof(endpoint));
+        const unsigned char* value = read_bytes(cursor, &value_length);
+        if (cursor->error || rules == NULL || !match) {
+            continue;
+        }
+
+        while (next_rule < rules->rule_count && !is_constant_rule(&rules->rules[next_rule])) {
+            next_rule++;
+        }
+        if (next_rule >= rules->rule_count) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Replay recording has constant %s that the current rule set lacks", endpoint);
+            match = 0;
+            continue;
+        }
+
+        const nxld_transfer_rule_t* rule = &rules->rules[next_rule++];
+        char current[MAX_ENDPOINT_LENGTH];
+        format_target(current, sizeof(current), rule);
+        if (strcmp(endpoint, current) != 0 || strlen(rule->target_param_value) != value_length ||
+            memcmp(rule->target_param_value, value, value_length) != 0) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Replay recording constant %s=%.*s differs from current %s=%s", endpoint,
+                             (int)value_length, (const char*)value, current, rule->target_param_value);
+            match = 0;
+        }
+    }
+
+    if (rules != NULL && match) {
+        while (next_rule < rules->rule_count && !is_constant_rule(&rules->rules[next_rule])) {
+            next_rule++;
+        }
+        if (next_rule < rules->rule_count) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Current rule set has constants that the replay recording lacks");
+            match = 0;
+        }
+    }
+    return match;
+}
+
+/**
+ * @brief 等待指定时长 / Sleep for the given duration / Für die angegebene Dauer schlafen
+ */
+static void sleep_ns(uint64_t ns) {
+#ifdef _WIN32
+    Sleep((DWORD)(ns / 1000000));
+#else
+    struct timespec request;
+    request.tv_sec = (time_t)(ns / 1000000000ull);
+    request.tv_nsec = (long)(ns % 1000000000ull);
+    while (nanosleep(&request, &request) != 0 && errno == EINTR) {
+    }
+#endif
+}
+
+/**
+ * @brief 回放值存储结构体 / Replay value storage structure / Speicherstruktur für Wiedergabewerte
+ */
+typedef struct {
+    int int_value;                          /**< int值 / int value / int-Wert */
+    long long_value;                        /**< long值 / long value / long-Wert */
+    char char_value;                        /**< char值 / char value / char-Wert */
+    nxld_buffer_t buffer;                   /**< 缓冲区描述符 / Buffer descriptor / Pufferdeskriptor */
+    unsigned char* scratch;                 /**< 字符串和缓冲区数据 / String and buffer data / Zeichenfolgen- und Pufferdaten */
+    size_t scratch_capacity;                /**< 数据区容量 / Data area capacity / Kapazität des Datenbereichs */
+} replay_value_t;
+
+/**
+ * @brief 确保数据区容量 / Ensure data area capacity / Kapazität des Datenbereichs sicherstellen
+ */
+static int reserve_scratch(replay_value_t* storage, size_t size) {
+    if (size <= storage->scratch_capacity) {
+        return 0;
+    }
+    unsigned char* grown = (unsigned char*)realloc(storage->scratch, size);
+    if (grown == NULL) {
+        return -1;
+    }
+    storage->scratch = grown;
+    storage->scratch_capacity = size;
+    return 0;
+}
+
+/**
+ * @brief 解码一个调用值 / Decode one invocation value / Einen Aufrufwert dekodieren
+ * @param bytes 输出传递的字节数 / Output bytes passed / Ausgabe der übergebenen Bytes
+ * @param opaque 输出值是否为不透明指针 / Output whether the value is an opaque pointer / Ausgabe, ob der Wert ein undurchsichtiger Zeiger ist
+ * @return 传给计划的值 / Value passed to the plan / An den Plan übergebener Wert
+ */
+static void* decode_value(replay_cursor_t* cursor, replay_value_t* storage, uint64_t* bytes, int* opaque) {
+    *bytes = 0;
+    *opaque = 0;
+    if (cursor->pos >= cursor->end) {
+        cursor->error = 1;
+        return NULL;
+    }
+    int tag = *cursor->pos++;
+    if (tag & VALUE_NULL_FLAG) {
+        return NULL;
+    }
+
+    size_t length;
+    const unsigned char* data;
+    switch ((nxld_param_type_t)tag) {
+        case NXLD_PARAM_TYPE_INT:
+            storage->int_value = (int)read_signed(cursor);
+            return &storage->int_value;
+        case NXLD_PARAM_TYPE_LONG:
+            storage->long_value = (long)read_signed(cursor);
+            return &storage->long_value;
+        case NXLD_PARAM_TYPE_CHAR:
+            storage->char_value = (char)read_signed(cursor);
+            return &storage->char_value;
+        case NXLD_PARAM_TYPE_STRING:
+            data = read_bytes(cursor, &length);
+            if (cursor->error || reserve_scratch(storage, length + 1) != 0) {
+                cursor->error = 1;
+                return NULL;
+            }
+            memcpy(storage->scratch, data, length);
+            storage->scratch[length] = '\0';
+            *bytes = length;
+            return storage->scratch;
+        case NXLD_PARAM_TYPE_BUFFER:
+            memset(&storage->buffer, 0, sizeof(storage->buffer));
+            storage->buffer.element_type = (nxld_param_type_t)read_varint(cursor);
+            storage->buffer.element_size = (size_t)read_varint(cursor);
+            data = read_bytes(cursor, &length);
+            if (cursor->error || reserve_scratch(storage, length > 0 ? length : 1) != 0) {
+                cursor->error = 1;
+                return NULL;
+            }
+            memcpy(storage->scratch, data, length);
+            storage->buffer.data = storage->scratch;
+            storage->buffer.count = storage->buffer.element_size > 0 ? length / storage->buffer.element_size : 0;
+            storage->buffer.alignment = 1;
+            *bytes = length;
+            return &storage->buffer;
+        default:
+            *opaque = 1;
+            return NULL;
+    }
+}
+
+/**
+ * @brief 轨迹引用结构体 / Trace reference structure / Spurverweis-Struktur
+ */
+typedef struct {
+    const unsigned char* data;              /**< 编码后的跳 / Encoded hops / Kodierte Sprünge */
+    size_t length;                          /**< 字节数 / Byte count / Anzahl der Bytes */
+    size_t offset;                          /**< 在回放轨迹缓冲区中的偏移 / Offset into the replay trace buffer / Versatz im Wiedergabe-Spurpuffer */
+    size_t invocation;                      /**< 产生轨迹的调用序号 / Invocation that produced the trace / Aufruf, der die Spur erzeugt hat */
+} replay_trace_ref_t;
+
+/**
+ * @brief 轨迹引用列表结构体 / Trace reference list structure / Spurverweis-Listenstruktur
+ */
+typedef struct {
+    replay_trace_ref_t* items;              /**< 引用数组 / Reference array / Verweis-Array */
+    size_t count;                           /**< 引用数量 / Reference count / Anzahl der Verweise */
+    size_t capacity;                        /**< 数组容量 / Array capacity / Array-Kapazität */
+} replay_trace_list_t;
+
+/**
+ * @brief 回放观察状态结构体 / Replay observer state structure / Zustandsstruktur des Wiedergabebeobachters
+ */
+typedef struct {
+    const nxld_transfer_plan_t* plan;       /**< 执行计划 / Execution plan / Ausführungsplan */
+    replay_buffer_t traces;                 /**< 所有回放轨迹的编码 / Encoding of all replayed traces / Kodierung aller wiedergegebenen Spuren */
+    replay_trace_list_t list;               /**< 回放轨迹引用 / Replayed trace references / Verweise auf wiedergegebene Spuren */
+    size_t trace_start;                     /**< 当前轨迹起点 / Start of the current trace / Beginn der aktuellen Spur */
+    size_t invocation;                      /**< 当前调用序号 / Current invocation number / Aktuelle Aufrufnummer */
+    int depth;                              /**< 路由嵌套深度 / Route nesting depth / Verschachtelungstiefe der Routen */
+    int error;                              /**< 分配是否失败 / Whether an allocation failed / Ob eine Zuweisung fehlgeschlagen ist */
+} replay_observer_t;
+
+/**
+ * @brief 追加轨迹引用 / Append trace reference / Spurverweis anhängen
+ */
+static int append_trace(replay_trace_list_t* list, const replay_trace_ref_t* ref) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        replay_trace_ref_t* grown = (replay_trace_ref_t*)realloc(list->items, capacity * sizeof(replay_trace_ref_t));
+        if (grown == NULL) {
+            return -1;
+        }
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = *ref;
+    return 0;
+}
+
+/**
+ * @brief 按内容比较轨迹 / Compare traces by content / Spuren nach Inhalt vergleichen
+ */
+static int compare_traces(const void* left, const void* right) {
+    const replay_trace_ref_t* a = (const replay_trace_ref_t*)left;
+    const replay_trace_ref_t* b = (const replay_trace_ref_t*)right;
+    if (a->length != b->length) {
+        return a->length < b->length ? -1 : 1;
+    }
+    int order = a->length > 0 ? memcmp(a->data, b->data, a->length) : 0;
+    if (order != 0) {
+        return order;
+    }
+    return a->invocation < b->invocation ? -1 : (a->invocation > b->invocation ? 1 : 0);
+}
+
+/**
+ * @brief 回放时收集逐跳轨迹的执行观察函数 / Execution observer collecting hop traces during replay / Ausführungsbeobachter, der während der Wiedergabe Sprungspuren sammelt
+ * @details 编码与录制器相同，轨迹头与RECORD_HOPS记录的内容一致 / Uses the recorder's encoding, the trace starts like the content of a RECORD_HOPS record / Verwendet die Kodierung des Aufzeichners, die Spur beginnt wie der Inhalt eines RECORD_HOPS-Datensatzes
+ */
+static void replay_observer(void* arg, nxld_plan_event_t event, size_t index, const intptr_t* args) {
+    replay_observer_t* observer = (replay_observer_t*)arg;
+    switch (event) {
+        case NXLD_PLAN_EVENT_ROUTE_BEGIN:
+            if (observer->depth++ == 0) {
+                observer->trace_start = observer->traces.length;
+            }
+            break;
+        case NXLD_PLAN_EVENT_CALL:
+            if (observer->depth > 0) {
+                write_hop(&observer->traces, observer->plan, index, args);
+            }
+            break;
+        case NXLD_PLAN_EVENT_ROUTE_END:
+            if (observer->depth > 0 && --observer->depth == 0) {
+                replay_trace_ref_t ref;
+                ref.data = NULL;
+                ref.offset = observer->trace_start;
+                ref.length = observer->traces.length - observer->trace_start;
+                ref.invocation = observer->invocation;
+                if (append_trace(&observer->list, &ref) != 0) {
+                    observer->error = 1;
+                }
+            }
+            break;
+    }
+}
+
+/**
+ * @brief 比较回放轨迹与录制轨迹 / Compare replayed traces with recorded traces / Wiedergegebene Spuren mit aufgezeichneten Spuren vergleichen
+ * @details 录制时调用可并发完成，因此按内容配对而不按顺序；找不到相同录制轨迹的回放调用计为偏离 / Recorded invocations may finish concurrently, so traces are paired by content rather than by order; a replayed invocation without an identical recorded trace counts as diverged / Aufgezeichnete Aufrufe können gleichzeitig enden, daher werden Spuren nach Inhalt statt nach Reihenfolge gepaart; ein wiedergegebener Aufruf ohne identische aufgezeichnete Spur gilt als abgewichen
+ * @return 偏离的调用数量 / Number of diverged invocations / Anzahl abgewichener Aufrufe
+ */
+static size_t match_traces(replay_trace_list_t* recorded, replay_observer_t* observer, const char* path) {
+    replay_trace_list_t* replayed = &observer->list;
+    for (size_t i = 0; i < replayed->count; i++) {
+        replayed->items[i].data = observer->traces.data + replayed->items[i].offset;
+    }
+    qsort(recorded->items, recorded->count, sizeof(replay_trace_ref_t), compare_traces);
+    qsort(replayed->items, replayed->count, sizeof(replay_trace_ref_t), compare_traces);
+
+    size_t diverged = 0;
+    size_t first = (size_t)-1;
+    size_t r = 0;
+    for (size_t i = 0; i < replayed->count; i++) {
+        const replay_trace_ref_t* current = &replayed->items[i];
+        int order = -1;
+        while (r < recorded->count) {
+            // 只比较内容，忽略调用序号 / Only content is compared, the invocation number is ignored / Nur der Inhalt wird verglichen, die Aufrufnummer wird ignoriert
+            replay_trace_ref_t probe = recorded->items[r];
+            probe.invocation = current->invocation;
+            order = compare_traces(&probe, current);
+            if (order >= 0) {
+                break;
+            }
+            r++;
+        }
+        if (r < recorded->count && order == 0) {
+            r++;
+            continue;
+        }
+        diverged++;
+        if (current->invocation < first) {
+            first = current->invocation;
+        }
+    }
+    if (diverged > 0) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Replay of %s diverged: %zu invocations passed values not in the recording, first at invocation %zu",
+                         path, diverged, first);
+    }
+    return diverged;
+}
+
+int nxld_replay_run(nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules, const char* path,
+                    nxld_replay_pacing_t pacing, nxld_replay_stats_t* stats) {
+    nxld_replay_stats_t local_stats;
+    if (stats == NULL) {
+        stats = &local_stats;
+    }
+    memset(stats, 0, sizeof(nxld_replay_stats_t));
+    if (plan == NULL || path == NULL) {
+        return -1;
+    }
+
+    size_t size = 0;
+    unsigned char* data = read_file(path, &size);
+    if (data == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to read replay recording: %s", path);
+        return -1;
+    }
+
+    replay_cursor_t cursor;
+    cursor.pos = data;
+    cursor.end = data + size;
+    cursor.error = 0;
+    if (size < 5 || memcmp(data, REPLAY_MAGIC, 4) != 0 || data[4] != REPLAY_VERSION) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Not a replay recording or unsupported version: %s", path);
+        free(data);
+        return -1;
+    }
+    cursor.pos += 5;
+    stats->constants_match = compare_constants(&cursor, rules);
+
+    // 记录的延迟直方图复用指标模块，每次调用都计时 / The latency histogram reuses the metrics module and times every invocation / Das Latenzhistogramm nutzt das Metrikmodul und misst jeden Aufruf
+    // 回放期间替换观察函数，收集每次调用的逐跳轨迹 / During replay the observer is replaced to collect every invocation's hop trace / Während der Wiedergabe wird der Beobachter ersetzt, um die Sprungspur jedes Aufrufs zu sammeln
+    replay_trace_list_t recorded;
+    memset(&recorded, 0, sizeof(recorded));
+    replay_observer_t observer;
+    memset(&observer, 0, sizeof(observer));
+    observer.plan = plan;
+    nxld_plan_observer_t previous_observer = plan->observer;
+    void* previous_arg = plan->observer_arg;
+    nxld_transfer_plan_set_observer(plan, replay_observer, &observer);
+
+    nxld_metrics_t* latency = nxld_metrics_create(1, 1);
+    nxld_metrics_shard_t* shard = nxld_metrics_shard_acquire(latency);
+    size_t* route_map = NULL;
+    size_t route_count = 0;
+    replay_value_t storage;
+    memset(&storage, 0, sizeof(storage));
+
+    uint64_t start = nxld_metrics_now_ns();
+    uint64_t offset = 0;
+    while (cursor.pos < cursor.end && !cursor.error) {
+        int tag = *cursor.pos++;
+        if (tag == RECORD_ROUTE) {
+            char source_plugin[MAX_ENDPOINT_LENGTH];
+            char source_interface[MAX_ENDPOINT_LENGTH];
+            uint64_t id = read_varint(&cursor);
+            read_string(&cursor, source_plugin, sizeof(source_plugin));
+            read_string(&cursor, source_interface, sizeof(source_interface));
+            int param_index = (int)read_signed(&cursor);
+            if (cursor.error || id != route_count) {
+                cursor.error = 1;
+                break;
+            }
+            size_t* grown = (size_t*)realloc(route_map, (route_count + 1) * sizeof(size_t));
+            if (grown == NULL) {
+                cursor.error = 1;
+                break;
+            }
+            route_map = grown;
+            route_map[route_count] = nxld_transfer_plan_find_route(plan, source_plugin, source_interface, param_index);
+            if (route_map[route_count] == NXLD_PLAN_INVALID_INDEX) {
+                NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Replay route %s.%s[%d] is not in the current execution plan", source_plugin,
+                                 source_interface, param_index);
+            }
+            route_count++;
+        } else if (tag == RECORD_CALL) {
+            uint64_t id = read_varint(&cursor);
+            offset += read_varint(&cursor);
+            uint64_t bytes;
+            int opaque;
+            void* value = decode_value(&cursor, &storage, &bytes, &opaque);
+            if (cursor.error || id >= route_count) {
+                cursor.error = 1;
+                break;
+            }
+            stats->recorded_ns = offset;
+            stats->opaque += opaque ? 1 : 0;
+            if (route_map[id] == NXLD_PLAN_INVALID_INDEX) {
+                stats->skipped++;
+                continue;
+            }
+
+            uint64_t now = nxld_metrics_now_ns();
+            if (pacing == NXLD_REPLAY_PACING_ORIGINAL) {
+                uint64_t due = start + offset;
+                if (now < due) {
+                    sleep_ns(due - now);
+                    now = nxld_metrics_now_ns();
+                } else if (now - due > stats->max_lag_ns) {
+                    stats->max_lag_ns = now - due;
+                }
+            }
+
+            observer.invocation = stats->invocations;
+            int status = nxld_transfer_plan_execute(plan, route_map[id], value);
+            nxld_metrics_record(shard, 0, nxld_metrics_now_ns() - now, bytes);
+            stats->invocations++;
+            stats->failed += status != 0 ? 1 : 0;
+        } else if (tag == RECORD_HOPS) {
+            replay_trace_ref_t ref;
+            read_varint(&cursor);
+            ref.data = read_bytes(&cursor, &ref.length);
+            ref.offset = 0;
+            ref.invocation = 0;
+            if (cursor.error || append_trace(&recorded, &ref) != 0) {
+                cursor.error = 1;
+                break;
+            }
+        } else {
+            cursor.error = 1;
+        }
+    }
+    stats->elapsed_ns = nxld_metrics_now_ns() - start;
+    nxld_transfer_plan_set_observer(plan, previous_observer, previous_arg);
+
+    // 旧录制文件没有逐跳轨迹，只能比较入口 / Older recordings have no hop traces, only entries can be compared / Ältere Aufzeichnungen haben keine Sprungspuren, nur Einstiege sind vergleichbar
+    stats->traces = recorded.count;
+    if (!cursor.error && recorded.count > 0) {
+        if (observer.error || observer.traces.error) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while collecting replay hop traces");
+            cursor.error = 1;
+        } else {
+            stats->diverged = match_traces(&recorded, &observer, path);
+        }
+    }
+    free(recorded.items);
+    free(observer.list.items);
+    free(observer.traces.data);
+
+    nxld_metrics_shard_release(latency, shard);
+    nxld_metrics_snapshot(latency, 0, &stats->latency);
+    nxld_metrics_destroy(latency);
+    free(storage.scratch);
+    free(route_map);
+    free(data);
+
+    if (cursor.error) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Replay recording %s is truncated or corrupt after %zu invocations", path, stats->invocations);
+        return -1;
+    }
+    if (!stats->constants_match) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Replay recording %s was made with different constant parameter values", path);
+    }
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Replayed %zu invocations from %s (%zu failed, %zu skipped)", stats->invocations, path,
+                  stats->failed, stats->skipped);
+    return stats->failed == 0 && stats->skipped == 0 && stats->diverged == 0 ? 0 : -1;
+}
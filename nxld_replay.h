@@ -0,0 +1,97 @@
+/**
+ * @file nxld_replay.h
+ * @brief NXLD入口调用录制与回放接口 / NXLD Entry Invocation Record and Replay Interface / NXLD-Schnittstelle zum Aufzeichnen und Wiedergeben von Einstiegsaufrufen
+ * @details 录制文件为紧凑二进制日志：文件头保存规则集合的常量参数值，之后每条调用记录保存一次入口调用的路由、时间偏移和带类型的参数值，每条轨迹记录保存一次调用中每一跳的目标接口和传递的参数值；回放按原始节奏或尽快重新驱动执行计划，并逐跳比较传递的值 / The recording is a compact binary log: the header keeps the rule set's constant parameter values, every call record holds one entry invocation's route, time offset and typed parameter value, and every trace record holds the target interface and transferred argument values of each hop of one invocation; replay re-drives the execution plan at the original pacing or as fast as possible and compares the transferred values hop by hop / Die Aufzeichnung ist ein kompaktes Binärprotokoll: der Kopf enthält die konstanten Parameterwerte des Regelsatzes, jeder Aufrufdatensatz enthält Route, Zeitversatz und typisierten Parameterwert eines Einstiegsaufrufs, und jeder Spurdatensatz enthält Zielschnittstelle und übergebene Argumentwerte jedes Sprungs eines Aufrufs; die Wiedergabe treibt den Ausführungsplan im ursprünglichen Takt oder so schnell wie möglich erneut an und vergleicht die übergebenen Werte Sprung für Sprung
+ */
+
+#ifndef NXLD_REPLAY_H
+#define NXLD_REPLAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nxld_transfer_rules.h"
+#include "nxld_transfer_plan.h"
+#include "nxld_metrics.h"
+
+/**
+ * @brief 回放节奏枚举 / Replay pacing enumeration / Wiedergabetakt-Aufzählung
+ */
+typedef enum {
+    NXLD_REPLAY_PACING_FAST = 0,           /**< 尽快回放 / Replay as fast as possible / So schnell wie möglich wiedergeben */
+    NXLD_REPLAY_PACING_ORIGINAL            /**< 按录制时的时间间隔回放 / Replay with the recorded time offsets / Mit den aufgezeichneten Zeitversätzen wiedergeben */
+} nxld_replay_pacing_t;
+
+/**
+ * @brief 录制器（不透明） / Recorder (opaque) / Aufzeichner (undurchsichtig)
+ */
+typedef struct nxld_replay_recorder nxld_replay_recorder_t;
+
+/**
+ * @brief 回放统计结构体 / Replay statistics structure / Wiedergabestatistik-Struktur
+ */
+typedef struct {
+    size_t invocations;                     /**< 执行的调用数量 / Invocations executed / Ausgeführte Aufrufe */
+    size_t failed;                          /**< 失败的调用数量 / Failed invocations / Fehlgeschlagene Aufrufe */
+    size_t skipped;                         /**< 找不到路由而跳过的调用数量 / Invocations skipped for lack of a route / Mangels Route übersprungene Aufrufe */
+    size_t opaque;                          /**< 以NULL回放的不透明指针值数量 / Opaque pointer values replayed as NULL / Als NULL wiedergegebene undurchsichtige Zeigerwerte */
+    size_t traces;                          /**< 录制文件中的逐跳轨迹数量（旧文件为0，此时不比较） / Hop traces in the recording (0 for older files, which are then not compared) / Sprungspuren in der Aufzeichnung (0 bei älteren Dateien, die dann nicht verglichen werden) */
+    size_t diverged;                        /**< 传递的值与任何录制轨迹都不一致的调用数量 / Invocations whose transferred values match no recorded trace / Aufrufe, deren übergebene Werte keiner aufgezeichneten Spur entsprechen */
+    int constants_match;                    /**< 录制时的常量参数值与当前规则集合是否一致 / Whether the recorded constant parameter values match the current rule set / Ob die aufgezeichneten konstanten Parameterwerte mit dem aktuellen Regelsatz übereinstimmen */
+    uint64_t recorded_ns;                   /**< 录制时第一次到最后一次调用的时长 / Time from first to last recorded invocation / Zeit vom ersten bis zum letzten aufgezeichneten Aufruf */
+    uint64_t elapsed_ns;                    /**< 回放总耗时 / Total replay time / Gesamte Wiedergabezeit */
+    uint64_t max_lag_ns;                    /**< 按原始节奏回放时的最大滞后 / Maximum lag when replaying at the original pacing / Maximaler Rückstand bei Wiedergabe im ursprünglichen Takt */
+    nxld_metrics_series_t latency;          /**< 每次调用的延迟直方图 / Per-invocation latency histogram / Latenzhistogramm je Aufruf */
+} nxld_replay_stats_t;
+
+/**
+ * @brief 创建录制文件 / Create recording file / Aufzeichnungsdatei erstellen
+ * @param path 录制文件路径 / Recording file path / Pfad der Aufzeichnungsdatei
+ * @param rules 规则集合，其常量参数值写入文件头 / Rule set whose constant parameter values go into the header / Regelsatz, dessen konstante Parameterwerte in den Kopf geschrieben werden
+ * @return 录制器指针，失败返回NULL / Recorder pointer, NULL on failure / Aufzeichner-Zeiger, NULL bei Fehler
+ */
+nxld_replay_recorder_t* nxld_replay_recorder_open(const char* path, const nxld_transfer_rule_set_t* rules);
+
+/**
+ * @brief 将录制器挂接到执行计划以录制逐跳轨迹 / Attach recorder to an execution plan to record hop traces / Aufzeichner an einen Ausführungsplan anhängen, um Sprungspuren aufzuzeichnen
+ * @param recorder 录制器指针 / Recorder pointer / Aufzeichner-Zeiger
+ * @param plan 执行计划 / Execution plan / Ausführungsplan
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 安装计划的执行观察函数，每次路由执行结束时写出一条轨迹；关闭录制器时移除。须在没有路由执行时调用，流消费者线程上的调用不录制 / Installs the plan's execution observer and writes one trace whenever a route finishes; closing the recorder removes it. Call while no route is running; calls on stream consumer threads are not recorded / Installiert den Ausführungsbeobachter des Plans und schreibt bei jedem Routenende eine Spur; das Schließen des Aufzeichners entfernt ihn. Aufrufen, während keine Route läuft; Aufrufe in Stream-Verbraucher-Threads werden nicht aufgezeichnet
+ */
+int nxld_replay_recorder_attach(nxld_replay_recorder_t* recorder, nxld_transfer_plan_t* plan);
+
+/**
+ * @brief 录制一次入口调用 / Record one entry invocation / Einen Einstiegsaufruf aufzeichnen
+ * @param recorder 录制器指针（NULL时忽略） / Recorder pointer (ignored if NULL) / Aufzeichner-Zeiger (ignoriert bei NULL)
+ * @param source_plugin 源插件名称 / Source plugin name / Quell-Plugin-Name
+ * @param source_interface 源接口名称 / Source interface name / Quellschnittstellenname
+ * @param param_index 源参数索引 / Source parameter index / Quellparameterindex
+ * @param type 值类型，决定value的解释方式 / Value type, determines how value is interpreted / Werttyp, bestimmt die Auslegung von value
+ * @param value 传递给计划的值：INT/LONG/CHAR为指向数值的指针，STRING为字符串，BUFFER为缓冲区描述符，其他类型只记录为不透明指针 / Value passed to the plan: a pointer to the number for INT/LONG/CHAR, the string for STRING, the buffer descriptor for BUFFER, other types are only recorded as opaque pointers / An den Plan übergebener Wert: Zeiger auf die Zahl bei INT/LONG/CHAR, die Zeichenfolge bei STRING, der Pufferdeskriptor bei BUFFER, andere Typen werden nur als undurchsichtige Zeiger erfasst
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 线程安全，记录顺序即调用本函数的顺序 / Thread-safe, records are kept in the order of the calls to this function / Threadsicher, Datensätze stehen in der Reihenfolge der Aufrufe dieser Funktion
+ */
+int nxld_replay_record(nxld_replay_recorder_t* recorder, const char* source_plugin, const char* source_interface,
+                       int param_index, nxld_param_type_t type, const void* value);
+
+/**
+ * @brief 关闭录制文件 / Close recording file / Aufzeichnungsdatei schließen
+ * @param recorder 录制器指针 / Recorder pointer / Aufzeichner-Zeiger
+ * @return 文件完整写出返回0，否则返回-1 / Returns 0 if the file was written completely, -1 otherwise / Gibt 0 zurück, wenn die Datei vollständig geschrieben wurde, sonst -1
+ */
+int nxld_replay_recorder_close(nxld_replay_recorder_t* recorder);
+
+/**
+ * @brief 从录制文件回放入口调用 / Replay entry invocations from a recording / Einstiegsaufrufe aus einer Aufzeichnung wiedergeben
+ * @param plan 执行计划 / Execution plan / Ausführungsplan
+ * @param rules 当前规则集合，用于比较常量参数值（可为NULL） / Current rule set to compare constant parameter values against (may be NULL) / Aktueller Regelsatz zum Vergleich der konstanten Parameterwerte (kann NULL sein)
+ * @param path 录制文件路径 / Recording file path / Pfad der Aufzeichnungsdatei
+ * @param pacing 回放节奏 / Replay pacing / Wiedergabetakt
+ * @param stats 输出统计（可为NULL） / Output statistics (may be NULL) / Ausgabestatistik (kann NULL sein)
+ * @return 文件可读、所有调用成功且逐跳传递的值与录制一致返回0，否则返回-1 / Returns 0 if the file is readable, all invocations succeed and the values passed at each hop match the recording, -1 otherwise / Gibt 0 zurück, wenn die Datei lesbar ist, alle Aufrufe erfolgreich sind und die bei jedem Sprung übergebenen Werte der Aufzeichnung entsprechen, sonst -1
+ * @details 调用在计划的默认上下文中按录制顺序依次执行，结果可在不同引擎构建之间直接比较；回放期间临时替换计划的执行观察函数。录制时调用可能并发完成，因此轨迹按内容配对而不按顺序，不透明指针只比较类型 / Invocations run one after another in recorded order on the plan's default context, so results compare directly across engine builds; the plan's execution observer is replaced during replay. Recorded invocations may finish concurrently, so traces are paired by content rather than order, and opaque pointers compare by type only / Aufrufe laufen nacheinander in aufgezeichneter Reihenfolge im Standardkontext des Plans, daher sind Ergebnisse zwischen Engine-Builds direkt vergleichbar; der Ausführungsbeobachter des Plans wird während der Wiedergabe ersetzt. Aufgezeichnete Aufrufe können gleichzeitig enden, daher werden Spuren nach Inhalt statt nach Reihenfolge gepaart, undurchsichtige Zeiger werden nur nach Typ verglichen
+ */
+int nxld_replay_run(nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules, const char* path,
+                    nxld_replay_pacing_t pacing, nxld_replay_stats_t* stats);
+
+#endif /* NXLD_REPLAY_H */
@@ -0,0 +1,241 @@
+/**
+ * @file nxld_stream.c
+ * @brief NXLD流式分块传递实现 / NXLD Streaming Chunked Transfer Implementation / NXLD-Implementierung der gestreamten Blockübertragung
+ */
+
+#include "nxld_stream.h"
+#include "nxld_thread.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define STREAM_CHUNK_ALIGNMENT 64
+
+/**
+ * @brief 流结构体 / Stream structure / Stream-Struktur
+ * @details 空闲分块和已填充分块各用一个环形索引队列，容量均为depth / Free and filled chunks each use a ring of indices with capacity depth / Freie und gefüllte Blöcke verwenden je einen Indexring mit Kapazität depth
+ */
+struct nxld_stream {
+    nxld_buffer_t* chunks;                  /**< 分块描述符数组 / Chunk descriptor array / Blockdeskriptor-Array */
+    void** chunk_memory;                    /**< 分块原始内存 / Raw chunk memory / Rohspeicher der Blöcke */
+    size_t chunk_bytes;                     /**< 分块容量（字节） / Chunk capacity in bytes / Blockkapazität in Bytes */
+    size_t depth;                           /**< 分块数量 / Chunk count / Blockanzahl */
+    size_t* free_ring;                      /**< 空闲分块索引环 / Ring of free chunk indices / Ring freier Blockindizes */
+    size_t free_head;                       /**< 空闲环读位置 / Free ring read position / Leseposition im freien Ring */
+    size_t free_count;                      /**< 空闲分块数量 / Free chunk count / Anzahl freier Blöcke */
+    size_t* full_ring;                      /**< 已填充分块索引环 / Ring of filled chunk indices / Ring gefüllter Blockindizes */
+    size_t full_head;                       /**< 已填充环读位置 / Filled ring read position / Leseposition im gefüllten Ring */
+    size_t full_count;                      /**< 已填充分块数量 / Filled chunk count / Anzahl gefüllter Blöcke */
+    int closed;                             /**< 生产端已关闭 / Producer side closed / Erzeugerseite geschlossen */
+    int aborted;                            /**< 流已中止 / Stream aborted / Stream abgebrochen */
+    nxld_stream_sink_t sink;                /**< 同步消费函数（可为NULL） / Synchronous sink (may be NULL) / Synchrone Senke (kann NULL sein) */
+    void* sink_arg;                         /**< 同步消费函数参数 / Synchronous sink argument / Argument der synchronen Senke */
+    int sync_initialized;                   /**< 同步对象已初始化 / Synchronization objects initialized / Synchronisationsobjekte initialisiert */
+    nxld_mutex_t mutex;                     /**< 互斥锁 / Mutex / Mutex */
+    nxld_cond_t not_empty;                  /**< 有已填充分块 / Filled chunk available / Gefüllter Block verfügbar */
+    nxld_cond_t not_full;                   /**< 有空闲分块 / Free chunk available / Freier Block verfügbar */
+};
+
+/**
+ * @brief 获取分块索引 / Get chunk index / Blockindex abrufen
+ */
+static size_t chunk_index(const nxld_stream_t* stream, const nxld_buffer_t* chunk) {
+    if (chunk < stream->chunks || chunk >= stream->chunks + stream->depth) {
+        return stream->depth;
+    }
+    return (size_t)(chunk - stream->chunks);
+}
+
+nxld_stream_t* nxld_stream_create(size_t chunk_bytes, size_t depth) {
+    if (chunk_bytes == 0 || depth == 0) {
+        return NULL;
+    }
+
+    nxld_stream_t* stream = (nxld_stream_t*)calloc(1, sizeof(nxld_stream_t));
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    stream->chunk_bytes = chunk_bytes;
+    stream->depth = depth;
+    stream->chunks = (nxld_buffer_t*)calloc(depth, sizeof(nxld_buffer_t));
+    stream->chunk_memory = (void**)calloc(depth, sizeof(void*));
+    stream->free_ring = (size_t*)malloc(depth * sizeof(size_t));
+    stream->full_ring = (size_t*)malloc(depth * sizeof(size_t));
+    if (stream->chunks == NULL || stream->chunk_memory == NULL || stream->free_ring == NULL || stream->full_ring == NULL) {
+        nxld_stream_destroy(stream);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < depth; i++) {
+        stream->chunk_memory[i] = malloc(chunk_bytes + STREAM_CHUNK_ALIGNMENT);
+        if (stream->chunk_memory[i] == NULL) {
+            nxld_stream_destroy(stream);
+            return NULL;
+        }
+        stream->free_ring[i] = i;
+    }
+    stream->free_count = depth;
+
+    nxld_mutex_init(&stream->mutex);
+    nxld_cond_init(&stream->not_empty);
+    nxld_cond_init(&stream->not_full);
+    stream->sync_initialized = 1;
+    return stream;
+}
+
+void nxld_stream_destroy(nxld_stream_t* stream) {
+    if (stream == NULL) {
+        return;
+    }
+
+    if (stream->sync_initialized) {
+        nxld_cond_destroy(&stream->not_full);
+        nxld_cond_destroy(&stream->not_empty);
+        nxld_mutex_destroy(&stream->mutex);
+    }
+
+    if (stream->chunk_memory != NULL) {
+        for (size_t i = 0; i < stream->depth; i++) {
+            free(stream->chunk_memory[i]);
+        }
+    }
+    free(stream->chunk_memory);
+    free(stream->chunks);
+    free(stream->free_ring);
+    free(stream->full_ring);
+    free(stream);
+}
+
+void nxld_stream_set_sink(nxld_stream_t* stream, nxld_stream_sink_t sink, void* arg) {
+    if (stream == NULL) {
+        return;
+    }
+    stream->sink = sink;
+    stream->sink_arg = arg;
+}
+
+nxld_buffer_t* nxld_stream_acquire(nxld_stream_t* stream, size_t* capacity_bytes) {
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    nxld_mutex_lock(&stream->mutex);
+    while (stream->free_count == 0 && !stream->aborted) {
+        nxld_cond_wait(&stream->not_full, &stream->mutex);
+    }
+    if (stream->aborted || stream->closed) {
+        nxld_mutex_unlock(&stream->mutex);
+        return NULL;
+    }
+
+    size_t index = stream->free_ring[stream->free_head];
+    stream->free_head = (stream->free_head + 1) % stream->depth;
+    stream->free_count--;
+    nxld_mutex_unlock(&stream->mutex);
+
+    // 每次获取都重置描述符 / Reset the descriptor on every acquire / Deskriptor bei jeder Anforderung zurücksetzen
+    nxld_buffer_t* chunk = &stream->chunks[index];
+    uintptr_t raw = (uintptr_t)stream->chunk_memory[index];
+    memset(chunk, 0, sizeof(nxld_buffer_t));
+    chunk->data = (void*)((raw + STREAM_CHUNK_ALIGNMENT - 1) & ~(uintptr_t)(STREAM_CHUNK_ALIGNMENT - 1));
+    chunk->alignment = STREAM_CHUNK_ALIGNMENT;
+    chunk->element_type = NXLD_PARAM_TYPE_UNKNOWN;
+    if (capacity_bytes != NULL) {
+        *capacity_bytes = stream->chunk_bytes;
+    }
+    return chunk;
+}
+
+int nxld_stream_commit(nxld_stream_t* stream, nxld_buffer_t* chunk) {
+    if (stream == NULL || chunk == NULL) {
+        return -1;
+    }
+
+    size_t index = chunk_index(stream, chunk);
+    if (index >= stream->depth || chunk->count * chunk->element_size > stream->chunk_bytes) {
+        return -1;
+    }
+
+    // 同步模式下消费者在生产者线程中处理分块，随后立即回收 / In synchronous mode the consumer handles the chunk on the producer thread and it is recycled right away / Im synchronen Modus verarbeitet der Verbraucher den Block im Erzeuger-Thread und er wird sofort zurückgegeben
+    if (stream->sink != NULL) {
+        if (stream->aborted) {
+            return -1;
+        }
+        stream->sink(stream->sink_arg, chunk);
+        nxld_stream_recycle(stream, chunk);
+        return 0;
+    }
+
+    nxld_mutex_lock(&stream->mutex);
+    if (stream->aborted) {
+        nxld_mutex_unlock(&stream->mutex);
+        return -1;
+    }
+    stream->full_ring[(stream->full_head + stream->full_count) % stream->depth] = index;
+    stream->full_count++;
+    nxld_cond_signal(&stream->not_empty);
+    nxld_mutex_unlock(&stream->mutex);
+    return 0;
+}
+
+void nxld_stream_close(nxld_stream_t* stream) {
+    if (stream == NULL) {
+        return;
+    }
+
+    nxld_mutex_lock(&stream->mutex);
+    stream->closed = 1;
+    nxld_cond_broadcast(&stream->not_empty);
+    nxld_mutex_unlock(&stream->mutex);
+}
+
+void nxld_stream_abort(nxld_stream_t* stream) {
+    if (stream == NULL) {
+        return;
+    }
+
+    nxld_mutex_lock(&stream->mutex);
+    stream->aborted = 1;
+    nxld_cond_broadcast(&stream->not_full);
+    nxld_cond_broadcast(&stream->not_empty);
+    nxld_mutex_unlock(&stream->mutex);
+}
+
+nxld_buffer_t* nxld_stream_pop(nxld_stream_t* stream) {
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    nxld_mutex_lock(&stream->mutex);
+    while (stream->full_count == 0 && !stream->closed && !stream->aborted) {
+        nxld_cond_wait(&stream->not_empty, &stream->mutex);
+    }
+    if (stream->full_count == 0 || stream->aborted) {
+        nxld_mutex_unlock(&stream->mutex);
+        return NULL;
+    }
+
+    size_t index = stream->full_ring[stream->full_head];
+    stream->full_head = (stream->full_head + 1) % stream->depth;
+    stream->full_count--;
+    nxld_mutex_unlock(&stream->mutex);
+    return &stream->chunks[index];
+}
+
+void nxld_stream_recycle(nxld_stream_t* stream, nxld_buffer_t* chunk) {
+    if (stream == NULL || chunk == NULL) {
+        return;
+    }
+
+    size_t index = chunk_index(stream, chunk);
+    if (index >= stream->depth) {
+        return;
+    }
+
+    nxld_mutex_lock(&stream->mutex);
+    stream->free_ring[(stream->free_head + stream->free_count) % stream->depth] = index;
+    stream->free_count++;
+    nxld_cond_signal(&stream->not_full);
+    nxld_mutex_unlock(&stream->mutex);
+}
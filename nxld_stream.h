@@ -0,0 +1,85 @@
+/**
+ * @file nxld_stream.h
+ * @brief NXLD流式分块传递接口 / NXLD Streaming Chunked Transfer Interface / NXLD-Schnittstelle für gestreamte Blockübertragung
+ * @details 生产者与消费者之间的有界分块环形队列 / Bounded ring of chunks between a producer and a consumer / Begrenzter Ring von Blöcken zwischen Erzeuger und Verbraucher
+ */
+
+#ifndef NXLD_STREAM_H
+#define NXLD_STREAM_H
+
+#include <stddef.h>
+#include "nxld_plugin_interface.h"
+
+/**
+ * @brief 同步消费函数类型 / Synchronous sink function type / Typ der synchronen Senkenfunktion
+ * @param arg 用户参数 / User argument / Benutzerargument
+ * @param chunk 已提交的分块，返回后被回收 / Committed chunk, recycled after return / Übergebener Block, nach der Rückkehr wiederverwendet
+ */
+typedef void (*nxld_stream_sink_t)(void* arg, nxld_buffer_t* chunk);
+
+/**
+ * @brief 创建流 / Create stream / Stream erstellen
+ * @param chunk_bytes 每个分块的容量（字节） / Capacity of each chunk in bytes / Kapazität jedes Blocks in Bytes
+ * @param depth 环中分块数量 / Number of chunks in the ring / Anzahl der Blöcke im Ring
+ * @return 流指针，失败返回NULL / Stream pointer, NULL on failure / Stream-Zeiger, NULL bei Fehler
+ */
+nxld_stream_t* nxld_stream_create(size_t chunk_bytes, size_t depth);
+
+/**
+ * @brief 销毁流并释放所有分块 / Destroy stream and free all chunks / Stream zerstören und alle Blöcke freigeben
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ */
+void nxld_stream_destroy(nxld_stream_t* stream);
+
+/**
+ * @brief 设置同步消费函数 / Set synchronous sink / Synchrone Senke festlegen
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ * @param sink 消费函数 / Sink function / Senkenfunktion
+ * @param arg 用户参数 / User argument / Benutzerargument
+ * @details 设置后每次提交在生产者线程中直接调用sink并回收分块，不再使用nxld_stream_pop；须在生产者开始前设置 / Once set, every commit calls the sink directly on the producer thread and recycles the chunk, nxld_stream_pop is not used; must be set before the producer starts / Danach ruft jede Übergabe die Senke direkt im Erzeuger-Thread auf und gibt den Block zurück, nxld_stream_pop wird nicht verwendet; muss vor dem Start des Erzeugers gesetzt werden
+ */
+void nxld_stream_set_sink(nxld_stream_t* stream, nxld_stream_sink_t sink, void* arg);
+
+/**
+ * @brief 生产者获取空分块（环满时阻塞） / Producer acquires an empty chunk (blocks while the ring is full) / Erzeuger holt einen leeren Block (blockiert, solange der Ring voll ist)
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ * @param capacity_bytes 输出分块容量（字节） / Output chunk capacity in bytes / Ausgabe-Blockkapazität in Bytes
+ * @return 分块描述符，流被中止时返回NULL / Chunk descriptor, NULL once the stream was aborted / Blockdeskriptor, NULL sobald der Stream abgebrochen wurde
+ */
+nxld_buffer_t* nxld_stream_acquire(nxld_stream_t* stream, size_t* capacity_bytes);
+
+/**
+ * @brief 生产者提交已填充的分块 / Producer commits a filled chunk / Erzeuger übergibt einen gefüllten Block
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ * @param chunk 由nxld_stream_acquire返回的分块，count和element_size须已设置 / Chunk returned by nxld_stream_acquire with count and element_size set / Von nxld_stream_acquire zurückgegebener Block mit gesetztem count und element_size
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_stream_commit(nxld_stream_t* stream, nxld_buffer_t* chunk);
+
+/**
+ * @brief 关闭流的生产端 / Close producer side of the stream / Erzeugerseite des Streams schließen
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ */
+void nxld_stream_close(nxld_stream_t* stream);
+
+/**
+ * @brief 中止流，后续获取返回NULL / Abort stream so later acquires return NULL / Stream abbrechen, sodass spätere Anforderungen NULL liefern
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ */
+void nxld_stream_abort(nxld_stream_t* stream);
+
+/**
+ * @brief 消费者取出下一个分块（为空时阻塞） / Consumer takes the next chunk (blocks while empty) / Verbraucher entnimmt den nächsten Block (blockiert, solange leer)
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ * @return 分块描述符，流已关闭且为空时返回NULL / Chunk descriptor, NULL once the stream is closed and drained / Blockdeskriptor, NULL sobald der Stream geschlossen und geleert ist
+ */
+nxld_buffer_t* nxld_stream_pop(nxld_stream_t* stream);
+
+/**
+ * @brief 消费者归还已处理的分块 / Consumer returns a processed chunk / Verbraucher gibt einen verarbeiteten Block zurück
+ * @param stream 流指针 / Stream pointer / Stream-Zeiger
+ * @param chunk 由nxld_stream_pop返回的分块 / Chunk returned by nxld_stream_pop / Von nxld_stream_pop zurückgegebener Block
+ */
+void nxld_stream_recycle(nxld_stream_t* stream, nxld_buffer_t* chunk);
+
+#endif /* NXLD_STREAM_H */
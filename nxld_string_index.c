@@ -0,0 +1,121 @@
+/**
+ * @file nxld_string_index.c
+ * @brief NXLD字符串哈希索引实现 / NXLD String Hash Index Implementation / NXLD-Zeichenfolgen-Hashindex-Implementierung
+ */
+
+#include "nxld_string_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INDEX_MIN_CAPACITY 16
+
+/**
+ * @brief 计算FNV-1a哈希 / Compute FNV-1a hash / FNV-1a-Hash berechnen
+ */
+static size_t hash_key(const char* key) {
+    unsigned long long hash = 14695981039346656037ull;
+    for (const unsigned char* p = (const unsigned char*)key; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ull;
+    }
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+/**
+ * @brief 查找键所在槽或应插入的空槽 / Find slot holding key or empty slot for insertion / Slot mit Schlüssel oder freien Slot zum Einfügen suchen
+ */
+static size_t find_slot(const nxld_string_index_entry_t* entries, size_t capacity, const char* key, size_t hash) {
+    size_t mask = capacity - 1;
+    size_t slot = hash & mask;
+    while (entries[slot].key != NULL) {
+        if (entries[slot].hash == hash && strcmp(entries[slot].key, key) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief 重建为指定容量 / Rehash into given capacity / In angegebene Kapazität umhashen
+ */
+static int rehash(nxld_string_index_t* index, size_t capacity) {
+    nxld_string_index_entry_t* entries = (nxld_string_index_entry_t*)calloc(capacity, sizeof(nxld_string_index_entry_t));
+    if (entries == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->entries[i].key != NULL) {
+            size_t slot = find_slot(entries, capacity, index->entries[i].key, index->entries[i].hash);
+            entries[slot] = index->entries[i];
+        }
+    }
+
+    free(index->entries);
+    index->entries = entries;
+    index->capacity = capacity;
+    return 0;
+}
+
+void nxld_string_index_init(nxld_string_index_t* index) {
+    if (index != NULL) {
+        memset(index, 0, sizeof(nxld_string_index_t));
+    }
+}
+
+int nxld_string_index_reserve(nxld_string_index_t* index, size_t count) {
+    if (index == NULL) {
+        return -1;
+    }
+
+    // 负载因子保持在1/2以下 / Keep the load factor below 1/2 / Ladefaktor unter 1/2 halten
+    size_t capacity = index->capacity != 0 ? index->capacity : INDEX_MIN_CAPACITY;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    return capacity == index->capacity ? 0 : rehash(index, capacity);
+}
+
+int nxld_string_index_set(nxld_string_index_t* index, const char* key, size_t value) {
+    if (index == NULL || key == NULL || nxld_string_index_reserve(index, index->count + 1) != 0) {
+        return -1;
+    }
+
+    size_t hash = hash_key(key);
+    size_t slot = find_slot(index->entries, index->capacity, key, hash);
+    nxld_string_index_entry_t* entry = &index->entries[slot];
+    if (entry->key == NULL) {
+        size_t len = strlen(key);
+        entry->key = (char*)malloc(len + 1);
+        if (entry->key == NULL) {
+            return -1;
+        }
+        memcpy(entry->key, key, len + 1);
+        entry->hash = hash;
+        index->count++;
+    }
+    entry->value = value;
+    return 0;
+}
+
+size_t nxld_string_index_get(const nxld_string_index_t* index, const char* key) {
+    if (index == NULL || key == NULL || index->count == 0) {
+        return NXLD_STRING_INDEX_NOT_FOUND;
+    }
+
+    size_t slot = find_slot(index->entries, index->capacity, key, hash_key(key));
+    return index->entries[slot].key != NULL ? index->entries[slot].value : NXLD_STRING_INDEX_NOT_FOUND;
+}
+
+void nxld_string_index_free(nxld_string_index_t* index) {
+    if (index == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < index->capacity; i++) {
+        free(index->entries[i].key);
+    }
+    free(index->entries);
+    memset(index, 0, sizeof(nxld_string_index_t));
+}
@@ -0,0 +1,82 @@
+/**
+ * @file nxld_string_index.h
+ * @brief NXLD字符串哈希索引接口 / NXLD String Hash Index Interface / NXLD-Zeichenfolgen-Hashindex-Schnittstelle
+ * @details 字符串键到数组索引的开放寻址哈希表，用于规则、节点和路由的O(1)查找 / Open-addressing hash table from string keys to array indices, used for O(1) lookup of rules, nodes and routes / Hashtabelle mit offener Adressierung von Zeichenfolgenschlüsseln auf Arrayindizes, für O(1)-Suche von Regeln, Knoten und Routen
+ */
+
+#ifndef NXLD_STRING_INDEX_H
+#define NXLD_STRING_INDEX_H
+
+#include <stddef.h>
+
+/**
+ * @brief 未找到键时的返回值 / Value returned when a key is not found / Rückgabewert, wenn ein Schlüssel nicht gefunden wird
+ */
+#define NXLD_STRING_INDEX_NOT_FOUND ((size_t)-1)
+
+/**
+ * @brief 组合键的字段分隔符 / Field separator for composite keys / Feldtrenner für zusammengesetzte Schlüssel
+ */
+#define NXLD_STRING_INDEX_SEPARATOR "\x1f"
+
+/**
+ * @brief 组合键缓冲区大小（两个名称加参数索引） / Composite key buffer size (two names plus a parameter index) / Puffergröße für zusammengesetzte Schlüssel (zwei Namen plus Parameterindex)
+ */
+#define NXLD_STRING_INDEX_MAX_KEY 4160
+
+/**
+ * @brief 索引条目结构体 / Index entry structure / Indexeintragsstruktur
+ */
+typedef struct {
+    char* key;                              /**< 键副本（NULL表示空槽） / Key copy (NULL for an empty slot) / Schlüsselkopie (NULL für leeren Slot) */
+    size_t hash;                            /**< 键哈希 / Key hash / Schlüssel-Hash */
+    size_t value;                           /**< 关联值 / Associated value / Zugehöriger Wert */
+} nxld_string_index_entry_t;
+
+/**
+ * @brief 字符串索引结构体 / String index structure / Zeichenfolgenindex-Struktur
+ */
+typedef struct {
+    nxld_string_index_entry_t* entries;     /**< 槽数组（容量为2的幂） / Slot array (power-of-two capacity) / Slot-Array (Kapazität ist Zweierpotenz) */
+    size_t capacity;                        /**< 槽数量 / Slot count / Anzahl der Slots */
+    size_t count;                           /**< 键数量 / Key count / Anzahl der Schlüssel */
+} nxld_string_index_t;
+
+/**
+ * @brief 初始化空索引 / Initialize empty index / Leeren Index initialisieren
+ * @param index 索引指针 / Index pointer / Index-Zeiger
+ */
+void nxld_string_index_init(nxld_string_index_t* index);
+
+/**
+ * @brief 预留容量 / Reserve capacity / Kapazität reservieren
+ * @param index 索引指针 / Index pointer / Index-Zeiger
+ * @param count 预期键数量 / Expected key count / Erwartete Schlüsselanzahl
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_string_index_reserve(nxld_string_index_t* index, size_t count);
+
+/**
+ * @brief 插入或更新键 / Insert or update key / Schlüssel einfügen oder aktualisieren
+ * @param index 索引指针 / Index pointer / Index-Zeiger
+ * @param key 键（会被复制） / Key (copied) / Schlüssel (wird kopiert)
+ * @param value 关联值 / Associated value / Zugehöriger Wert
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_string_index_set(nxld_string_index_t* index, const char* key, size_t value);
+
+/**
+ * @brief 查找键 / Look up key / Schlüssel suchen
+ * @param index 索引指针 / Index pointer / Index-Zeiger
+ * @param key 键 / Key / Schlüssel
+ * @return 关联值，未找到返回NXLD_STRING_INDEX_NOT_FOUND / Associated value, NXLD_STRING_INDEX_NOT_FOUND if not found / Zugehöriger Wert, NXLD_STRING_INDEX_NOT_FOUND wenn nicht gefunden
+ */
+size_t nxld_string_index_get(const nxld_string_index_t* index, const char* key);
+
+/**
+ * @brief 释放索引 / Free index / Index freigeben
+ * @param index 索引指针 / Index pointer / Index-Zeiger
+ */
+void nxld_string_index_free(nxld_string_index_t* index);
+
+#endif /* NXLD_STRING_INDEX_H */
@@ -0,0 +1,191 @@
+/**
+ * @file nxld_thread.c
+ * @brief NXLD线程封装实现 / NXLD Thread Wrapper Implementation / NXLD-Thread-Wrapper-Implementierung
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_thread.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/**
+ * @brief 线程启动参数结构体 / Thread start argument structure / Thread-Startargument-Struktur
+ */
+typedef struct {
+    nxld_thread_func_t func;                /**< 入口函数 / Entry function / Einstiegsfunktion */
+    void* arg;                              /**< 入口函数参数 / Entry function argument / Argument der Einstiegsfunktion */
+} thread_start_t;
+
+#ifdef _WIN32
+static DWORD WINAPI thread_trampoline(LPVOID param) {
+    thread_start_t start = *(thread_start_t*)param;
+    free(param);
+    start.func(start.arg);
+    return 0;
+}
+#else
+static void* thread_trampoline(void* param) {
+    thread_start_t start = *(thread_start_t*)param;
+    free(param);
+    start.func(start.arg);
+    return NULL;
+}
+#endif
+
+int nxld_thread_create(nxld_thread_t* thread, nxld_thread_func_t func, void* arg) {
+    if (thread == NULL || func == NULL) {
+        return -1;
+    }
+
+    thread_start_t* start = (thread_start_t*)malloc(sizeof(thread_start_t));
+    if (start == NULL) {
+        return -1;
+    }
+    start->func = func;
+    start->arg = arg;
+
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, thread_trampoline, start, 0, NULL);
+    if (*thread == NULL) {
+        free(start);
+        return -1;
+    }
+#else
+    if (pthread_create(thread, NULL, thread_trampoline, start) != 0) {
+        free(start);
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+void nxld_thread_join(nxld_thread_t thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+size_t nxld_thread_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#endif
+}
+
+void nxld_mutex_init(nxld_mutex_t* mutex) {
+#ifdef _WIN32
+    InitializeCriticalSection(mutex);
+#else
+    pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+void nxld_mutex_destroy(nxld_mutex_t* mutex) {
+#ifdef _WIN32
+    DeleteCriticalSection(mutex);
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+void nxld_mutex_lock(nxld_mutex_t* mutex) {
+#ifdef _WIN32
+    EnterCriticalSection(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+void nxld_mutex_unlock(nxld_mutex_t* mutex) {
+#ifdef _WIN32
+    LeaveCriticalSection(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+void nxld_cond_init(nxld_cond_t* cond) {
+#ifdef _WIN32
+    InitializeConditionVariable(cond);
+#else
+    pthread_cond_init(cond, NULL);
+#endif
+}
+
+void nxld_cond_destroy(nxld_cond_t* cond) {
+#ifdef _WIN32
+    (void)cond;
+#else
+    pthread_cond_destroy(cond);
+#endif
+}
+
+void nxld_cond_wait(nxld_cond_t* cond, nxld_mutex_t* mutex) {
+#ifdef _WIN32
+    SleepConditionVariableCS(cond, mutex, INFINITE);
+#else
+    pthread_cond_wait(cond, mutex);
+#endif
+}
+
+void nxld_cond_signal(nxld_cond_t* cond) {
+#ifdef _WIN32
+    WakeConditionVariable(cond);
+#else
+    pthread_cond_signal(cond);
+#endif
+}
+
+void nxld_cond_broadcast(nxld_cond_t* cond) {
+#ifdef _WIN32
+    WakeAllConditionVariable(cond);
+#else
+    pthread_cond_broadcast(cond);
+#endif
+}
+
+int nxld_tls_create(nxld_tls_t* key) {
+#ifdef _WIN32
+    *key = TlsAlloc();
+    return *key == TLS_OUT_OF_INDEXES ? -1 : 0;
+#else
+    return pthread_key_create(key, NULL) == 0 ? 0 : -1;
+#endif
+}
+
+void nxld_tls_delete(nxld_tls_t key) {
+#ifdef _WIN32
+    TlsFree(key);
+#else
+    pthread_key_delete(key);
+#endif
+}
+
+void* nxld_tls_get(nxld_tls_t key) {
+#ifdef _WIN32
+    return TlsGetValue(key);
+#else
+    return pthread_getspecific(key);
+#endif
+}
+
+int nxld_tls_set(nxld_tls_t key, void* value) {
+#ifdef _WIN32
+    return TlsSetValue(key, value) ? 0 : -1;
+#else
+    return pthread_setspecific(key, value) == 0 ? 0 : -1;
+#endif
+}
@@ -0,0 +1,136 @@
+/**
+ * @file nxld_thread.h
+ * @brief NXLD线程封装接口 / NXLD Thread Wrapper Interface / NXLD-Thread-Wrapper-Schnittstelle
+ * @details 对Windows线程和POSIX线程的最小跨平台封装 / Minimal cross-platform wrapper over Windows threads and POSIX threads / Minimaler plattformübergreifender Wrapper über Windows-Threads und POSIX-Threads
+ */
+
+#ifndef NXLD_THREAD_H
+#define NXLD_THREAD_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE nxld_thread_t;
+typedef CRITICAL_SECTION nxld_mutex_t;
+typedef CONDITION_VARIABLE nxld_cond_t;
+typedef DWORD nxld_tls_t;
+#else
+#include <pthread.h>
+typedef pthread_t nxld_thread_t;
+typedef pthread_mutex_t nxld_mutex_t;
+typedef pthread_cond_t nxld_cond_t;
+typedef pthread_key_t nxld_tls_t;
+#endif
+
+/**
+ * @brief 线程入口函数类型 / Thread entry function type / Thread-Einstiegsfunktionstyp
+ */
+typedef void (*nxld_thread_func_t)(void* arg);
+
+/**
+ * @brief 创建线程 / Create thread / Thread erstellen
+ * @param thread 输出线程句柄 / Output thread handle / Ausgabe-Thread-Handle
+ * @param func 线程入口函数 / Thread entry function / Thread-Einstiegsfunktion
+ * @param arg 入口函数参数 / Entry function argument / Argument der Einstiegsfunktion
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_thread_create(nxld_thread_t* thread, nxld_thread_func_t func, void* arg);
+
+/**
+ * @brief 等待线程结束 / Wait for thread to finish / Auf Thread-Ende warten
+ * @param thread 线程句柄 / Thread handle / Thread-Handle
+ */
+void nxld_thread_join(nxld_thread_t thread);
+
+/**
+ * @brief 获取在线CPU数量 / Get online CPU count / Anzahl der verfügbaren CPUs abrufen
+ * @return CPU数量（至少为1） / CPU count (at least 1) / CPU-Anzahl (mindestens 1)
+ */
+size_t nxld_thread_cpu_count(void);
+
+/**
+ * @brief 初始化互斥锁 / Initialize mutex / Mutex initialisieren
+ * @param mutex 互斥锁指针 / Mutex pointer / Mutex-Zeiger
+ */
+void nxld_mutex_init(nxld_mutex_t* mutex);
+
+/**
+ * @brief 销毁互斥锁 / Destroy mutex / Mutex zerstören
+ * @param mutex 互斥锁指针 / Mutex pointer / Mutex-Zeiger
+ */
+void nxld_mutex_destroy(nxld_mutex_t* mutex);
+
+/**
+ * @brief 加锁 / Lock mutex / Mutex sperren
+ * @param mutex 互斥锁指针 / Mutex pointer / Mutex-Zeiger
+ */
+void nxld_mutex_lock(nxld_mutex_t* mutex);
+
+/**
+ * @brief 解锁 / Unlock mutex / Mutex entsperren
+ * @param mutex 互斥锁指针 / Mutex pointer / Mutex-Zeiger
+ */
+void nxld_mutex_unlock(nxld_mutex_t* mutex);
+
+/**
+ * @brief 初始化条件变量 / Initialize condition variable / Bedingungsvariable initialisieren
+ * @param cond 条件变量指针 / Condition variable pointer / Bedingungsvariablen-Zeiger
+ */
+void nxld_cond_init(nxld_cond_t* cond);
+
+/**
+ * @brief 销毁条件变量 / Destroy condition variable / Bedingungsvariable zerstören
+ * @param cond 条件变量指针 / Condition variable pointer / Bedingungsvariablen-Zeiger
+ */
+void nxld_cond_destroy(nxld_cond_t* cond);
+
+/**
+ * @brief 等待条件变量（调用前须持有互斥锁） / Wait on condition variable (mutex must be held) / Auf Bedingungsvariable warten (Mutex muss gehalten werden)
+ * @param cond 条件变量指针 / Condition variable pointer / Bedingungsvariablen-Zeiger
+ * @param mutex 互斥锁指针 / Mutex pointer / Mutex-Zeiger
+ */
+void nxld_cond_wait(nxld_cond_t* cond, nxld_mutex_t* mutex);
+
+/**
+ * @brief 唤醒一个等待者 / Wake one waiter / Einen Wartenden aufwecken
+ * @param cond 条件变量指针 / Condition variable pointer / Bedingungsvariablen-Zeiger
+ */
+void nxld_cond_signal(nxld_cond_t* cond);
+
+/**
+ * @brief 唤醒所有等待者 / Wake all waiters / Alle Wartenden aufwecken
+ * @param cond 条件变量指针 / Condition variable pointer / Bedingungsvariablen-Zeiger
+ */
+void nxld_cond_broadcast(nxld_cond_t* cond);
+
+/**
+ * @brief 创建线程局部存储键 / Create thread-local storage key / Thread-lokalen Speicherschlüssel erstellen
+ * @param key 输出键 / Output key / Ausgabeschlüssel
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 线程退出时不调用析构函数，值由创建者负责释放 / No destructor runs at thread exit, the creator owns the stored values / Beim Thread-Ende läuft kein Destruktor, gespeicherte Werte gehören dem Ersteller
+ */
+int nxld_tls_create(nxld_tls_t* key);
+
+/**
+ * @brief 删除线程局部存储键 / Delete thread-local storage key / Thread-lokalen Speicherschlüssel löschen
+ * @param key 键 / Key / Schlüssel
+ */
+void nxld_tls_delete(nxld_tls_t key);
+
+/**
+ * @brief 读取当前线程的值 / Read value of the current thread / Wert des aktuellen Threads lesen
+ * @param key 键 / Key / Schlüssel
+ * @return 存储的值，未设置时为NULL / Stored value, NULL if unset / Gespeicherter Wert, NULL wenn nicht gesetzt
+ */
+void* nxld_tls_get(nxld_tls_t key);
+
+/**
+ * @brief 设置当前线程的值 / Set value of the current thread / Wert des aktuellen Threads setzen
+ * @param key 键 / Key / Schlüssel
+ * @param value 值 / Value / Wert
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_tls_set(nxld_tls_t key, void* value);
+
+#endif /* NXLD_THREAD_H */
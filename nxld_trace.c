@@ -0,0 +1,377 @@
+/**
+ * @file nxld_trace.c
+ * @brief NXLD执行跟踪实现 / NXLD Execution Tracing Implementation / NXLD-Implementierung der Ausführungsverfolgung
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_trace.h"
+#include "nxld_thread.h"
+#include "nxld_metrics.h"
+#include "nxld_logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_EVENTS 256
+
+/**
+ * @brief 跟踪事件结构体 / Trace event structure / Verfolgungsereignis-Struktur
+ */
+typedef struct {
+    char phase;                             /**< 事件类型（X、s、f） / Event phase (X, s, f) / Ereignisphase (X, s, f) */
+    const char* category;                   /**< 类别（字符串常量） / Category (string literal) / Kategorie (Zeichenfolgenkonstante) */
+    uint64_t ts_ns;                         /**< 时间戳（纳秒） / Timestamp in nanoseconds / Zeitstempel in Nanosekunden */
+    uint64_t dur_ns;                        /**< 持续时间（纳秒，X） / Duration in nanoseconds (X) / Dauer in Nanosekunden (X) */
+    uint64_t id;                            /**< 流标识（s、f） / Flow id (s, f) / Fluss-ID (s, f) */
+    char name[NXLD_TRACE_NAME_LENGTH];      /**< 名称 / Name / Name */
+    char args[NXLD_TRACE_ARGS_LENGTH];      /**< 参数JSON对象（可为空） / Argument JSON object (may be empty) / Argument-JSON-Objekt (kann leer sein) */
+} trace_event_t;
+
+/**
+ * @brief 事件块结构体 / Event chunk structure / Ereignisblock-Struktur
+ */
+typedef struct trace_chunk {
+    trace_event_t events[CHUNK_EVENTS];     /**< 事件 / Events / Ereignisse */
+    size_t count;                           /**< 已用事件数量 / Used event count / Anzahl belegter Ereignisse */
+    struct trace_chunk* next;               /**< 下一个块 / Next chunk / Nächster Block */
+} trace_chunk_t;
+
+/**
+ * @brief 线程缓冲区结构体 / Thread buffer structure / Thread-Puffer-Struktur
+ * @details 只由所属线程写入；停止时所有线程已结束，写出方才读取 / Only written by its owning thread; read by the writer on stop once all threads have finished / Nur vom eigenen Thread beschrieben; beim Stoppen nach Ende aller Threads vom Ausgeber gelesen
+ */
+typedef struct trace_thread {
+    size_t tid;                             /**< 跟踪中的线程编号 / Thread number in the trace / Thread-Nummer in der Verfolgung */
+    char name[NXLD_TRACE_NAME_LENGTH];      /**< 线程名称（可为空） / Thread name (may be empty) / Thread-Name (kann leer sein) */
+    trace_chunk_t* head;                    /**< 第一个块 / First chunk / Erster Block */
+    trace_chunk_t* tail;                    /**< 当前写入块 / Chunk being written / Aktuell beschriebener Block */
+    size_t event_count;                     /**< 已记录事件数量 / Recorded event count / Anzahl aufgezeichneter Ereignisse */
+    size_t dropped;                         /**< 超出上限丢弃的事件数量 / Events dropped over the limit / Über der Grenze verworfene Ereignisse */
+    uint64_t next_flow;                     /**< 本线程下一个流序号 / Next flow sequence of this thread / Nächste Flussnummer dieses Threads */
+    struct trace_thread* next;              /**< 下一个线程缓冲区 / Next thread buffer / Nächster Thread-Puffer */
+} trace_thread_t;
+
+static int g_trace_enabled = 0;
+static char* g_trace_path = NULL;
+static uint64_t g_trace_origin_ns = 0;
+static nxld_tls_t g_trace_key;
+static nxld_mutex_t g_trace_mutex;
+static trace_thread_t* g_trace_threads = NULL;
+static size_t g_trace_thread_count = 0;
+
+/**
+ * @brief 获取当前线程缓冲区，首次调用时注册 / Get the current thread's buffer, registering it on first use / Puffer des aktuellen Threads abrufen, bei erster Verwendung registrieren
+ * @details 只有注册时加锁，之后的记录不加锁 / Only registration takes the lock, later recording does not / Nur die Registrierung sperrt, spätere Aufzeichnungen nicht
+ */
+static trace_thread_t* current_thread(void) {
+    trace_thread_t* thread = (trace_thread_t*)nxld_tls_get(g_trace_key);
+    if (thread != NULL) {
+        return thread;
+    }
+
+    thread = (trace_thread_t*)calloc(1, sizeof(trace_thread_t));
+    if (thread == NULL) {
+        return NULL;
+    }
+    if (nxld_tls_set(g_trace_key, thread) != 0) {
+        free(thread);
+        return NULL;
+    }
+
+    nxld_mutex_lock(&g_trace_mutex);
+    thread->tid = ++g_trace_thread_count;
+    thread->next = g_trace_threads;
+    g_trace_threads = thread;
+    nxld_mutex_unlock(&g_trace_mutex);
+    return thread;
+}
+
+/**
+ * @brief 在当前线程缓冲区中分配事件 / Allocate event in the current thread buffer / Ereignis im Puffer des aktuellen Threads zuweisen
+ * @return 事件指针，超出上限或内存不足时返回NULL / Event pointer, NULL over the limit or out of memory / Ereigniszeiger, NULL über der Grenze oder bei Speichermangel
+ */
+static trace_event_t* append_event(trace_thread_t* thread) {
+    if (thread->event_count >= NXLD_TRACE_MAX_THREAD_EVENTS) {
+        thread->dropped++;
+        return NULL;
+    }
+
+    if (thread->tail == NULL || thread->tail->count == CHUNK_EVENTS) {
+        trace_chunk_t* chunk = (trace_chunk_t*)malloc(sizeof(trace_chunk_t));
+        if (chunk == NULL) {
+            thread->dropped++;
+            return NULL;
+        }
+        chunk->count = 0;
+        chunk->next = NULL;
+        if (thread->tail != NULL) {
+            thread->tail->next = chunk;
+        } else {
+            thread->head = chunk;
+        }
+        thread->tail = chunk;
+    }
+
+    thread->event_count++;
+    return &thread->tail->events[thread->tail->count++];
+}
+
+/**
+ * @brief 复制并截断字符串 / Copy and truncate string / Zeichenfolge kopieren und kürzen
+ */
+static void copy_truncated(char* out, size_t size, const char* text) {
+    size_t length = text != NULL ? strlen(text) : 0;
+    if (length >= size) {
+        length = size - 1;
+    }
+    if (length > 0) {
+        memcpy(out, text, length);
+    }
+    out[length] = '\0';
+}
+
+size_t nxld_trace_append_string(char* out, size_t size, size_t length, const char* text) {
+    static const char hex[] = "0123456789abcdef";
+    // 为结尾引号和终止符保留空间 / Keep room for the closing quote and terminator / Platz für das schließende Anführungszeichen und den Terminator lassen
+    if (out == NULL || length + 3 > size) {
+        return length;
+    }
+
+    out[length++] = '"';
+    for (const unsigned char* p = (const unsigned char*)(text != NULL ? text : ""); *p != '\0'; p++) {
+        char escaped[7];
+        size_t n = 0;
+        if (*p == '"' || *p == '\\') {
+            escaped[n++] = '\\';
+            escaped[n++] = (char)*p;
+        } else if (*p < 0x20) {
+            escaped[n++] = '\\';
+            escaped[n++] = 'u';
+            escaped[n++] = '0';
+            escaped[n++] = '0';
+            escaped[n++] = hex[*p >> 4];
+            escaped[n++] = hex[*p & 0x0f];
+        } else {
+            escaped[n++] = (char)*p;
+        }
+        if (length + n + 2 > size) {
+            break;
+        }
+        memcpy(out + length, escaped, n);
+        length += n;
+    }
+    out[length++] = '"';
+    out[length] = '\0';
+    return length;
+}
+
+int nxld_trace_start(const char* path) {
+    if (path == NULL || g_trace_enabled) {
+        return -1;
+    }
+
+    g_trace_path = (char*)malloc(strlen(path) + 1);
+    if (g_trace_path == NULL) {
+        return -1;
+    }
+    strcpy(g_trace_path, path);
+
+    if (nxld_tls_create(&g_trace_key) != 0) {
+        nxld_log_error("Failed to create thread-local key for tracing");
+        free(g_trace_path);
+        g_trace_path = NULL;
+        return -1;
+    }
+    nxld_mutex_init(&g_trace_mutex);
+    g_trace_threads = NULL;
+    g_trace_thread_count = 0;
+    g_trace_origin_ns = nxld_metrics_now_ns();
+    g_trace_enabled = 1;
+    return 0;
+}
+
+int nxld_trace_enabled(void) {
+    return g_trace_enabled;
+}
+
+uint64_t nxld_trace_begin(void) {
+    return g_trace_enabled ? nxld_metrics_now_ns() : 0;
+}
+
+void nxld_trace_span(const char* category, const char* name, uint64_t start_ns, uint64_t end_ns, const char* args_json) {
+    if (!g_trace_enabled || start_ns == 0) {
+        return;
+    }
+
+    trace_thread_t* thread = current_thread();
+    trace_event_t* event = thread != NULL ? append_event(thread) : NULL;
+    if (event == NULL) {
+        return;
+    }
+    event->phase = 'X';
+    event->category = category;
+    event->ts_ns = start_ns;
+    event->dur_ns = end_ns > start_ns ? end_ns - start_ns : 0;
+    event->id = 0;
+    copy_truncated(event->name, sizeof(event->name), name);
+    copy_truncated(event->args, sizeof(event->args), args_json);
+}
+
+void nxld_trace_end(const char* category, const char* name, uint64_t start_ns, const char* detail) {
+    if (!g_trace_enabled || start_ns == 0) {
+        return;
+    }
+
+    uint64_t end_ns = nxld_metrics_now_ns();
+    char args[NXLD_TRACE_ARGS_LENGTH];
+    args[0] = '\0';
+    if (detail != NULL) {
+        size_t length = (size_t)snprintf(args, sizeof(args), "{\"detail\":");
+        length = nxld_trace_append_string(args, sizeof(args) - 1, length, detail);
+        args[length++] = '}';
+        args[length] = '\0';
+    }
+    nxld_trace_span(category, name, start_ns, end_ns, args);
+}
+
+void nxld_trace_flow(uint64_t source_ns, uint64_t target_ns) {
+    if (!g_trace_enabled || source_ns == 0 || target_ns == 0) {
+        return;
+    }
+
+    trace_thread_t* thread = current_thread();
+    if (thread == NULL) {
+        return;
+    }
+
+    // 线程编号放在高位，流标识无需全局计数器 / The thread number goes into the high bits, so flow ids need no global counter / Die Thread-Nummer steht in den hohen Bits, daher brauchen Fluss-IDs keinen globalen Zähler
+    uint64_t id = ((uint64_t)thread->tid << 40) | ++thread->next_flow;
+    for (int k = 0; k < 2; k++) {
+        trace_event_t* event = append_event(thread);
+        if (event == NULL) {
+            return;
+        }
+        event->phase = k == 0 ? 's' : 'f';
+        event->category = "flow";
+        event->ts_ns = k == 0 ? source_ns : target_ns;
+        event->dur_ns = 0;
+        event->id = id;
+        copy_truncated(event->name, sizeof(event->name), "transfer");
+        event->args[0] = '\0';
+    }
+}
+
+void nxld_trace_thread_name(const char* name) {
+    if (!g_trace_enabled) {
+        return;
+    }
+    trace_thread_t* thread = current_thread();
+    if (thread != NULL) {
+        copy_truncated(thread->name, sizeof(thread->name), name);
+    }
+}
+
+/**
+ * @brief 写出纳秒时间为微秒 / Write nanosecond time as microseconds / Nanosekundenzeit als Mikrosekunden schreiben
+ */
+static void write_microseconds(FILE* file, uint64_t ns) {
+    fprintf(file, "%llu.%03u", (unsigned long long)(ns / 1000), (unsigned int)(ns % 1000));
+}
+
+/**
+ * @brief 写出一个事件 / Write one event / Ein Ereignis schreiben
+ */
+static void write_event(FILE* file, const trace_thread_t* thread, const trace_event_t* event) {
+    char name[NXLD_TRACE_NAME_LENGTH * 2 + 3];
+    nxld_trace_append_string(name, sizeof(name), 0, event->name);
+
+    fprintf(file, ",\n{\"name\":%s,\"cat\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%zu,\"ts\":",
+            name, event->category != NULL ? event->category : "", event->phase, thread->tid);
+    write_microseconds(file, event->ts_ns >= g_trace_origin_ns ? event->ts_ns - g_trace_origin_ns : 0);
+    if (event->phase == 'X') {
+        fprintf(file, ",\"dur\":");
+        write_microseconds(file, event->dur_ns);
+    } else {
+        fprintf(file, ",\"id\":%llu", (unsigned long long)event->id);
+        if (event->phase == 'f') {
+            fprintf(file, ",\"bp\":\"e\"");
+        }
+    }
+    if (event->args[0] != '\0') {
+        fprintf(file, ",\"args\":%s", event->args);
+    }
+    fprintf(file, "}");
+}
+
+/**
+ * @brief 写出跟踪文件 / Write trace file / Verfolgungsdatei schreiben
+ */
+static int write_trace(const char* path, size_t* event_count, size_t* dropped) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return -1;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"NXLD\"}}");
+    for (const trace_thread_t* thread = g_trace_threads; thread != NULL; thread = thread->next) {
+        if (thread->name[0] != '\0') {
+            char name[NXLD_TRACE_NAME_LENGTH * 2 + 3];
+            nxld_trace_append_string(name, sizeof(name), 0, thread->name);
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":%s}}", thread->tid, name);
+        }
+        for (const trace_chunk_t* chunk = thread->head; chunk != NULL; chunk = chunk->next) {
+            for (size_t i = 0; i < chunk->count; i++) {
+                write_event(file, thread, &chunk->events[i]);
+            }
+        }
+        *event_count += thread->event_count;
+        *dropped += thread->dropped;
+    }
+    fprintf(file, "\n]}\n");
+
+    int status = ferror(file) ? -1 : 0;
+    if (fclose(file) != 0) {
+        status = -1;
+    }
+    return status;
+}
+
+int nxld_trace_stop(void) {
+    if (!g_trace_enabled) {
+        return -1;
+    }
+    g_trace_enabled = 0;
+
+    size_t event_count = 0;
+    size_t dropped = 0;
+    int status = write_trace(g_trace_path, &event_count, &dropped);
+    if (status == 0) {
+        nxld_log_info("Trace written to %s: %zu events from %zu threads", g_trace_path, event_count, g_trace_thread_count);
+    } else {
+        nxld_log_error("Failed to write trace file: %s", g_trace_path);
+    }
+    if (dropped > 0) {
+        nxld_log_warning("Trace dropped %zu events over the per-thread limit of %d", dropped, NXLD_TRACE_MAX_THREAD_EVENTS);
+    }
+
+    while (g_trace_threads != NULL) {
+        trace_thread_t* thread = g_trace_threads;
+        g_trace_threads = thread->next;
+        while (thread->head != NULL) {
+            trace_chunk_t* chunk = thread->head;
+            thread->head = chunk->next;
+            free(chunk);
+        }
+        free(thread);
+    }
+    // 删除键使旧的线程局部指针失效，下次开始时各线程重新注册 / Deleting the key invalidates stale thread-local pointers, threads register again on the next start / Das Löschen des Schlüssels macht veraltete thread-lokale Zeiger ungültig, Threads registrieren sich beim nächsten Start neu
+    nxld_tls_delete(g_trace_key);
+    nxld_mutex_destroy(&g_trace_mutex);
+    free(g_trace_path);
+    g_trace_path = NULL;
+    return status;
+}
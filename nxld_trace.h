@@ -0,0 +1,98 @@
+/**
+ * @file nxld_trace.h
+ * @brief NXLD执行跟踪接口 / NXLD Execution Tracing Interface / NXLD-Ausführungsverfolgungs-Schnittstelle
+ * @details 以Trace Event Format（Chrome跟踪/Perfetto）记录时间段和流箭头；每个线程写入自己的缓冲区，记录时不加锁，停止时写出JSON / Records spans and flow arrows in Trace Event Format (Chrome tracing/Perfetto); every thread writes its own buffer without locking and the JSON is written on stop / Zeichnet Zeitspannen und Flusspfeile im Trace Event Format (Chrome-Tracing/Perfetto) auf; jeder Thread schreibt ohne Sperren in seinen eigenen Puffer, das JSON wird beim Stoppen geschrieben
+ */
+
+#ifndef NXLD_TRACE_H
+#define NXLD_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 事件名称最大长度（超出部分截断） / Maximum event name length (longer names are truncated) / Maximale Ereignisnamenlänge (längere Namen werden gekürzt)
+ */
+#define NXLD_TRACE_NAME_LENGTH 64
+
+/**
+ * @brief 事件参数JSON最大长度 / Maximum event argument JSON length / Maximale Länge des Ereignisargument-JSON
+ */
+#define NXLD_TRACE_ARGS_LENGTH 160
+
+/**
+ * @brief 每个线程最多保留的事件数量，超出后丢弃并计数 / Maximum events kept per thread, further events are dropped and counted / Maximal je Thread behaltene Ereignisse, weitere werden verworfen und gezählt
+ */
+#define NXLD_TRACE_MAX_THREAD_EVENTS (256 * 1024)
+
+/**
+ * @brief 开始跟踪 / Start tracing / Verfolgung starten
+ * @param path 停止时写出的JSON文件路径 / JSON file written on stop / Beim Stoppen geschriebene JSON-Datei
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 须在其他线程开始记录之前调用 / Must be called before other threads start recording / Muss aufgerufen werden, bevor andere Threads aufzeichnen
+ */
+int nxld_trace_start(const char* path);
+
+/**
+ * @brief 停止跟踪并写出JSON / Stop tracing and write JSON / Verfolgung stoppen und JSON schreiben
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 须在所有记录线程结束后调用；之后释放所有线程缓冲区 / Must be called after all recording threads have finished; all thread buffers are freed afterwards / Muss aufgerufen werden, nachdem alle aufzeichnenden Threads beendet sind; danach werden alle Thread-Puffer freigegeben
+ */
+int nxld_trace_stop(void);
+
+/**
+ * @brief 检查跟踪是否已开启 / Check whether tracing is on / Prüfen, ob die Verfolgung aktiv ist
+ * @return 已开启返回1，否则返回0 / Returns 1 if on, 0 otherwise / Gibt 1 zurück wenn aktiv, sonst 0
+ */
+int nxld_trace_enabled(void);
+
+/**
+ * @brief 开始一个时间段 / Begin a span / Eine Zeitspanne beginnen
+ * @return 开始时间（纳秒），未开启跟踪时返回0 / Start time in nanoseconds, 0 when tracing is off / Startzeit in Nanosekunden, 0 wenn die Verfolgung aus ist
+ */
+uint64_t nxld_trace_begin(void);
+
+/**
+ * @brief 结束时间段并记录 / End span and record it / Zeitspanne beenden und aufzeichnen
+ * @param category 类别（字符串常量） / Category (string literal) / Kategorie (Zeichenfolgenkonstante)
+ * @param name 名称 / Name / Name
+ * @param start_ns nxld_trace_begin的返回值，为0时忽略 / Value returned by nxld_trace_begin, ignored if 0 / Rückgabewert von nxld_trace_begin, ignoriert bei 0
+ * @param detail 作为detail参数记录的文本（可为NULL） / Text recorded as the detail argument (may be NULL) / Als detail-Argument aufgezeichneter Text (kann NULL sein)
+ */
+void nxld_trace_end(const char* category, const char* name, uint64_t start_ns, const char* detail);
+
+/**
+ * @brief 以预先格式化的参数结束时间段 / End span with preformatted arguments / Zeitspanne mit vorformatierten Argumenten beenden
+ * @param category 类别（字符串常量） / Category (string literal) / Kategorie (Zeichenfolgenkonstante)
+ * @param name 名称 / Name / Name
+ * @param start_ns 开始时间（纳秒），为0时忽略 / Start time in nanoseconds, ignored if 0 / Startzeit in Nanosekunden, ignoriert bei 0
+ * @param end_ns 结束时间（纳秒） / End time in nanoseconds / Endzeit in Nanosekunden
+ * @param args_json JSON对象文本（可为NULL） / JSON object text (may be NULL) / JSON-Objekttext (kann NULL sein)
+ */
+void nxld_trace_span(const char* category, const char* name, uint64_t start_ns, uint64_t end_ns, const char* args_json);
+
+/**
+ * @brief 记录从源时间段到目标时间段的流箭头 / Record flow arrow from a source span to a target span / Flusspfeil von einer Quell- zu einer Zielzeitspanne aufzeichnen
+ * @param source_ns 位于源时间段内的时间点 / Point in time inside the source span / Zeitpunkt innerhalb der Quellzeitspanne
+ * @param target_ns 位于目标时间段内的时间点 / Point in time inside the target span / Zeitpunkt innerhalb der Zielzeitspanne
+ * @details 两个时间段都须位于当前线程；任一时间为0时忽略 / Both spans must be on the current thread; ignored if either time is 0 / Beide Zeitspannen müssen im aktuellen Thread liegen; ignoriert, wenn eine der Zeiten 0 ist
+ */
+void nxld_trace_flow(uint64_t source_ns, uint64_t target_ns);
+
+/**
+ * @brief 设置当前线程在跟踪中的名称 / Set the current thread's name in the trace / Namen des aktuellen Threads in der Verfolgung setzen
+ * @param name 线程名称 / Thread name / Thread-Name
+ */
+void nxld_trace_thread_name(const char* name);
+
+/**
+ * @brief 追加带引号并转义的JSON字符串 / Append quoted and escaped JSON string / Zeichenfolge mit Anführungszeichen und Escapes als JSON anhängen
+ * @param out 输出缓冲区 / Output buffer / Ausgabepuffer
+ * @param size 缓冲区大小 / Buffer size / Puffergröße
+ * @param length 已写入长度 / Length already written / Bereits geschriebene Länge
+ * @param text 文本（过长时截断） / Text (truncated if too long) / Text (bei Überlänge gekürzt)
+ * @return 新长度 / New length / Neue Länge
+ */
+size_t nxld_trace_append_string(char* out, size_t size, size_t length, const char* text);
+
+#endif /* NXLD_TRACE_H */
@@ -0,0 +1,2559 @@
+/**
+ * @file nxld_transfer_plan.c
+ * @brief NXLD传递执行计划实现 / NXLD Transfer Execution Plan Implementation / NXLD-Übertragungs-Ausführungsplan-Implementierung
+ */
+
+#include "nxld_transfer_plan.h"
+#include "nxld_logger.h"
+#include "nxld_stream.h"
+#include "nxld_thread.h"
+#include "nxld_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define MAX_PATH_LENGTH 4096
+#define MAX_PLAN_CALL_ARGS 8
+#define TRACE_STRING_PREVIEW 32
+#define DEFAULT_STREAM_CHUNK_BYTES ((size_t)1024 * 1024)
+#define DEFAULT_STREAM_DEPTH 4
+#define BATCH_LOCAL_ROUTES 8
+
+#define ROUTE_MODE_UNKNOWN 0
+#define ROUTE_MODE_CONCURRENT 1
+#define ROUTE_MODE_SERIAL 2
+
+/**
+ * @brief 计划编译器状态结构体 / Plan compiler state structure / Plan-Compiler-Zustandsstruktur
+ */
+typedef struct {
+    const nxld_transfer_rule_set_t* rules;  /**< 规则集合 / Rule set / Regelsatz */
+    nxld_transfer_plan_t* plan;             /**< 正在编译的计划 / Plan being compiled / Zu kompilierender Plan */
+    size_t* rule_source_node;               /**< 每条规则的源节点 / Source node per rule / Quellknoten je Regel */
+    size_t* rule_target_node;               /**< 每条规则的目标节点 / Target node per rule / Zielknoten je Regel */
+    unsigned char* rule_active;             /**< 规则是否参与编译 / Whether rule takes part in compilation / Ob Regel an der Kompilierung teilnimmt */
+    unsigned char** bound;                  /**< 每个节点的槽绑定状态 / Slot binding state per node / Slot-Bindungszustand je Knoten */
+    unsigned char* conditional;             /**< 节点是否存在条件绑定 / Whether node has a conditional binding / Ob Knoten eine bedingte Bindung hat */
+    unsigned char* on_stack;                /**< 节点是否在展开栈中 / Whether node is on the unroll stack / Ob Knoten auf dem Entrollstapel liegt */
+    size_t* node_stream;                    /**< 以节点为生产者的流定义 / Stream definition produced by each node / Vom Knoten erzeugte Stream-Definition */
+    nxld_string_index_t plugin_lookup;      /**< 插件名称到插件条目的索引 / Index from plugin name to plugin entry / Index vom Plugin-Namen auf den Plugin-Eintrag */
+    nxld_string_index_t node_lookup;        /**< 插件和接口名称到节点的索引 / Index from plugin and interface name to node / Index von Plugin- und Schnittstellennamen auf den Knoten */
+    size_t plugin_capacity;                 /**< 插件数组容量 / Plugin array capacity / Plugin-Array-Kapazität */
+    size_t node_capacity;                   /**< 节点数组容量 / Node array capacity / Knotenarray-Kapazität */
+    size_t route_capacity;                  /**< 路由数组容量 / Route array capacity / Routenarray-Kapazität */
+    size_t* node_first_source;              /**< 以节点为源的第一条规则 / First rule with the node as source / Erste Regel mit dem Knoten als Quelle */
+    size_t* rule_next_source;               /**< 同一源节点的下一条规则 / Next rule with the same source node / Nächste Regel mit demselben Quellknoten */
+    size_t* node_first_target;              /**< 以节点为目标的第一条规则 / First rule with the node as target / Erste Regel mit dem Knoten als Ziel */
+    size_t* rule_next_target;               /**< 同一目标节点的下一条规则 / Next rule with the same target node / Nächste Regel mit demselben Zielknoten */
+    size_t* dirty_nodes;                    /**< 当前路由修改过绑定状态的节点 / Nodes whose binding state the current route changed / Knoten, deren Bindungszustand die aktuelle Route geändert hat */
+    size_t dirty_count;                     /**< 已修改节点数量 / Changed node count / Anzahl geänderter Knoten */
+    unsigned char* dirty;                   /**< 节点是否在已修改列表中 / Whether node is in the changed list / Ob Knoten in der Änderungsliste steht */
+    size_t step_capacity;                   /**< 步骤数组容量 / Step array capacity / Schrittarray-Kapazität */
+    nxld_transfer_plan_result_t error;      /**< 编译错误 / Compile error / Kompilierungsfehler */
+} plan_compiler_t;
+
+typedef intptr_t (*plan_func0_t)(void);
+typedef intptr_t (*plan_func1_t)(intptr_t);
+typedef intptr_t (*plan_func2_t)(intptr_t, intptr_t);
+typedef intptr_t (*plan_func3_t)(intptr_t, intptr_t, intptr_t);
+typedef intptr_t (*plan_func4_t)(intptr_t, intptr_t, intptr_t, intptr_t);
+typedef intptr_t (*plan_func5_t)(intptr_t, intptr_t, intptr_t, intptr_t, intptr_t);
+typedef intptr_t (*plan_func6_t)(intptr_t, intptr_t, intptr_t, intptr_t, intptr_t, intptr_t);
+typedef intptr_t (*plan_func7_t)(intptr_t, intptr_t, intptr_t, intptr_t, intptr_t, intptr_t, intptr_t);
+typedef intptr_t (*plan_func8_t)(intptr_t, intptr_t, intptr_t, intptr_t, intptr_t, intptr_t, intptr_t, intptr_t);
+
+/**
+ * @brief 复制字符串 / Duplicate string / Zeichenfolge duplizieren
+ */
+static char* duplicate_string(const char* str) {
+    if (str == NULL) {
+        return NULL;
+    }
+
+    size_t len = strlen(str);
+    char* copy = (char*)malloc(len + 1);
+    if (copy != NULL) {
+        memcpy(copy, str, len + 1);
+    }
+    return copy;
+}
+
+/**
+ * @brief 根据插件路径构建.nxp元数据路径 / Build .nxp metadata path from plugin path / .nxp-Metadatenpfad aus Plugin-Pfad erstellen
+ */
+static int build_metadata_path(const char* plugin_path, char* nxp_path, size_t nxp_path_size) {
+    const char* ext_pos = strrchr(plugin_path, '.');
+    const char* last_slash = strrchr(plugin_path, '/');
+    const char* last_backslash = strrchr(plugin_path, '\\');
+    if (last_backslash != NULL && (last_slash == NULL || last_backslash > last_slash)) {
+        last_slash = last_backslash;
+    }
+
+    // 只去掉文件名中的扩展名，目录名中的点保留 / Only strip an extension in the file name, dots in directory names stay / Nur eine Erweiterung im Dateinamen entfernen, Punkte in Verzeichnisnamen bleiben
+    size_t base_len = strlen(plugin_path);
+    if (ext_pos != NULL && (last_slash == NULL || ext_pos > last_slash)) {
+        base_len = (size_t)(ext_pos - plugin_path);
+    }
+
+    if (base_len + 5 > nxp_path_size) {
+        return 0;
+    }
+
+    memcpy(nxp_path, plugin_path, base_len);
+    memcpy(nxp_path + base_len, ".nxp", 5);
+    return 1;
+}
+
+/**
+ * @brief 查找或添加插件条目 / Find or add plugin entry / Plugin-Eintrag suchen oder hinzufügen
+ * @return 插件条目索引，失败返回NXLD_PLAN_INVALID_INDEX / Plugin entry index, NXLD_PLAN_INVALID_INDEX on failure / Plugin-Eintragsindex, NXLD_PLAN_INVALID_INDEX bei Fehler
+ */
+static size_t find_or_add_plugin(plan_compiler_t* compiler, const char* plugin_name, const char* plugin_path) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+    size_t index = nxld_string_index_get(&compiler->plugin_lookup, plugin_name);
+
+    if (index == NXLD_STRING_INDEX_NOT_FOUND) {
+        if (plan->plugin_count >= compiler->plugin_capacity) {
+            size_t new_capacity = compiler->plugin_capacity == 0 ? 8 : compiler->plugin_capacity * 2;
+            nxld_plan_plugin_t* new_plugins = (nxld_plan_plugin_t*)realloc(plan->plugins, new_capacity * sizeof(nxld_plan_plugin_t));
+            if (new_plugins == NULL) {
+                return NXLD_PLAN_INVALID_INDEX;
+            }
+            plan->plugins = new_plugins;
+            compiler->plugin_capacity = new_capacity;
+        }
+        index = plan->plugin_count;
+        memset(&plan->plugins[index], 0, sizeof(nxld_plan_plugin_t));
+        plan->plugins[index].plugin_name = duplicate_string(plugin_name);
+        if (plan->plugins[index].plugin_name == NULL ||
+            nxld_string_index_set(&compiler->plugin_lookup, plugin_name, index) != 0) {
+            free(plan->plugins[index].plugin_name);
+            return NXLD_PLAN_INVALID_INDEX;
+        }
+        plan->plugin_count++;
+    }
+
+    if (plan->plugins[index].plugin_path == NULL && plugin_path != NULL) {
+        char full_path[MAX_PATH_LENGTH];
+        if (nxld_transfer_rules_resolve_path(compiler->rules, plugin_path, full_path, sizeof(full_path))) {
+            plan->plugins[index].plugin_path = duplicate_string(full_path);
+            if (plan->plugins[index].plugin_path == NULL) {
+                return NXLD_PLAN_INVALID_INDEX;
+            }
+        }
+    }
+
+    return index;
+}
+
+/**
+ * @brief 查找或添加节点 / Find or add node / Knoten suchen oder hinzufügen
+ * @return 节点索引，失败返回NXLD_PLAN_INVALID_INDEX / Node index, NXLD_PLAN_INVALID_INDEX on failure / Knotenindex, NXLD_PLAN_INVALID_INDEX bei Fehler
+ */
+static size_t find_or_add_node(plan_compiler_t* compiler, const char* plugin_name, const char* plugin_path, const char* interface_name) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+    size_t plugin_index = find_or_add_plugin(compiler, plugin_name, plugin_path);
+    if (plugin_index == NXLD_PLAN_INVALID_INDEX) {
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+
+    char key[NXLD_STRING_INDEX_MAX_KEY];
+    int len = snprintf(key, sizeof(key), "%s" NXLD_STRING_INDEX_SEPARATOR "%s", plugin_name, interface_name);
+    if (len < 0 || (size_t)len >= sizeof(key)) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Plugin and interface name too long: %s.%s", plugin_name, interface_name);
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+
+    size_t existing = nxld_string_index_get(&compiler->node_lookup, key);
+    if (existing != NXLD_STRING_INDEX_NOT_FOUND) {
+        return existing;
+    }
+
+    if (plan->node_count >= compiler->node_capacity) {
+        size_t new_capacity = compiler->node_capacity == 0 ? 16 : compiler->node_capacity * 2;
+        nxld_plan_node_t* new_nodes = (nxld_plan_node_t*)realloc(plan->nodes, new_capacity * sizeof(nxld_plan_node_t));
+        if (new_nodes == NULL) {
+            return NXLD_PLAN_INVALID_INDEX;
+        }
+        plan->nodes = new_nodes;
+        compiler->node_capacity = new_capacity;
+    }
+
+    nxld_plan_node_t* node = &plan->nodes[plan->node_count];
+    memset(node, 0, sizeof(nxld_plan_node_t));
+    node->plugin_index = plugin_index;
+    node->interface_name = duplicate_string(interface_name);
+    if (node->interface_name == NULL || nxld_string_index_set(&compiler->node_lookup, key, plan->node_count) != 0) {
+        free(node->interface_name);
+        node->interface_name = NULL;
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+    return plan->node_count++;
+}
+
+/**
+ * @brief 构建路由查找键 / Build route lookup key / Routen-Suchschlüssel erstellen
+ * @return 成功返回1，名称过长返回0 / Returns 1 on success, 0 if names are too long / Gibt 1 bei Erfolg zurück, 0 bei zu langen Namen
+ */
+static int make_route_key(char* key, size_t key_size, const char* plugin_name, const char* interface_name, int param_index) {
+    // 每次CallPlugin都会构建，因此不使用snprintf / Built on every CallPlugin, so snprintf is avoided / Wird bei jedem CallPlugin erstellt, daher ohne snprintf
+    char digits[16];
+    size_t digit_count = 0;
+    unsigned int magnitude = param_index < 0 ? 0u - (unsigned int)param_index : (unsigned int)param_index;
+    do {
+        digits[digit_count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t plugin_len = strlen(plugin_name);
+    size_t interface_len = strlen(interface_name);
+    if (plugin_len + interface_len + digit_count + 4 > key_size) {
+        return 0;
+    }
+
+    char* out = key;
+    memcpy(out, plugin_name, plugin_len);
+    out += plugin_len;
+    *out++ = NXLD_STRING_INDEX_SEPARATOR[0];
+    memcpy(out, interface_name, interface_len);
+    out += interface_len;
+    *out++ = NXLD_STRING_INDEX_SEPARATOR[0];
+    if (param_index < 0) {
+        *out++ = '-';
+    }
+    while (digit_count > 0) {
+        *out++ = digits[--digit_count];
+    }
+    *out = '\0';
+    return 1;
+}
+
+/**
+ * @brief 按源节点和目标节点链接规则 / Link rules by source and target node / Regeln nach Quell- und Zielknoten verketten
+ * @details 逆序前插使每条链保持规则顺序，编译阶段只遍历相关规则 / Prepending in reverse keeps every chain in rule order, so compile passes only visit relevant rules / Rückwärtiges Voranstellen hält jede Kette in Regelreihenfolge, sodass Kompilierdurchläufe nur relevante Regeln besuchen
+ */
+static int link_rules(plan_compiler_t* compiler) {
+    size_t node_slots = compiler->plan->node_count + 1;
+    size_t rule_slots = compiler->rules->rule_count + 1;
+    compiler->node_first_source = (size_t*)malloc(node_slots * sizeof(size_t));
+    compiler->node_first_target = (size_t*)malloc(node_slots * sizeof(size_t));
+    compiler->rule_next_source = (size_t*)malloc(rule_slots * sizeof(size_t));
+    compiler->rule_next_target = (size_t*)malloc(rule_slots * sizeof(size_t));
+    compiler->dirty_nodes = (size_t*)malloc(node_slots * sizeof(size_t));
+    compiler->dirty = (unsigned char*)calloc(node_slots, 1);
+    if (compiler->node_first_source == NULL || compiler->node_first_target == NULL || compiler->rule_next_source == NULL ||
+        compiler->rule_next_target == NULL || compiler->dirty_nodes == NULL || compiler->dirty == NULL) {
+        return -1;
+    }
+
+    for (size_t n = 0; n < node_slots; n++) {
+        compiler->node_first_source[n] = NXLD_PLAN_INVALID_INDEX;
+        compiler->node_first_target[n] = NXLD_PLAN_INVALID_INDEX;
+    }
+
+    for (size_t r = compiler->rules->rule_count; r-- > 0;) {
+        compiler->rule_next_source[r] = NXLD_PLAN_INVALID_INDEX;
+        compiler->rule_next_target[r] = NXLD_PLAN_INVALID_INDEX;
+        if (!compiler->rule_active[r]) {
+            continue;
+        }
+        size_t source = compiler->rule_source_node[r];
+        if (source != NXLD_PLAN_INVALID_INDEX) {
+            compiler->rule_next_source[r] = compiler->node_first_source[source];
+            compiler->node_first_source[source] = r;
+        }
+        size_t target = compiler->rule_target_node[r];
+        compiler->rule_next_target[r] = compiler->node_first_target[target];
+        compiler->node_first_target[target] = r;
+    }
+    return 0;
+}
+
+/**
+ * @brief 记录当前路由修改过的节点 / Record node changed by the current route / Von der aktuellen Route geänderten Knoten vermerken
+ */
+static void mark_dirty(plan_compiler_t* compiler, size_t node) {
+    if (!compiler->dirty[node]) {
+        compiler->dirty[node] = 1;
+        compiler->dirty_nodes[compiler->dirty_count++] = node;
+    }
+}
+
+/**
+ * @brief 检查规则是否为流式规则 / Check whether rule is a stream rule / Prüfen, ob Regel eine Stream-Regel ist
+ */
+static int is_stream_rule(const plan_compiler_t* compiler, size_t rule) {
+    return compiler->rules->rules[rule].transfer_mode == NXLD_TRANSFER_MODE_STREAM;
+}
+
+/**
+ * @brief 检查规则源是否为指定节点 / Check whether rule source is the given node / Prüfen, ob Regelquelle der angegebene Knoten ist
+ */
+static int rule_has_source(const plan_compiler_t* compiler, size_t rule, size_t node) {
+    return compiler->rule_active[rule] && compiler->rule_source_node[rule] == node;
+}
+
+/**
+ * @brief 为每个节点确定参数帧大小和类型 / Determine argument frame size and types for each node / Argumentrahmengröße und -typen je Knoten bestimmen
+ * @details 优先使用.nxp元数据，缺失时根据规则中的最大目标索引推断 / Prefers .nxp metadata, falls back to the highest target index used by rules / Bevorzugt .nxp-Metadaten, sonst wird der höchste Zielindex der Regeln verwendet
+ */
+static int build_frames(plan_compiler_t* compiler) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    for (size_t i = 0; i < plan->plugin_count; i++) {
+        nxld_plan_plugin_t* entry = &plan->plugins[i];
+        char nxp_path[MAX_PATH_LENGTH];
+        if (entry->plugin_path != NULL && build_metadata_path(entry->plugin_path, nxp_path, sizeof(nxp_path))) {
+            if (nxld_plugin_read_metadata_file(nxp_path, &entry->metadata) != 0) {
+                memset(&entry->metadata, 0, sizeof(nxld_plugin_t));
+            }
+        }
+    }
+
+    for (size_t n = 0; n < plan->node_count; n++) {
+        nxld_plan_node_t* node = &plan->nodes[n];
+        const nxld_interface_info_t* info = nxld_plugin_find_interface(&plan->plugins[node->plugin_index].metadata, node->interface_name);
+
+        int rule_count = 0;
+        for (size_t r = compiler->node_first_target[n]; r != NXLD_PLAN_INVALID_INDEX; r = compiler->rule_next_target[r]) {
+            if (compiler->rule_active[r]) {
+                int needed = compiler->rules->rules[r].target_param_index + 1;
+                if (needed > rule_count) {
+                    rule_count = needed;
+                }
+            }
+        }
+        for (size_t r = compiler->node_first_source[n]; r != NXLD_PLAN_INVALID_INDEX; r = compiler->rule_next_source[r]) {
+            if (compiler->rule_active[r] && is_stream_rule(compiler, r)) {
+                int needed = compiler->rules->rules[r].source_param_index + 1;
+                if (needed > rule_count) {
+                    rule_count = needed;
+                }
+            }
+        }
+
+        if (info != NULL && info->param_count_type == NXLD_PARAM_COUNT_FIXED) {
+            node->param_count = (int)info->param_count;
+        } else if (info != NULL && (int)info->param_count > rule_count) {
+            node->param_count = (int)info->param_count;
+        } else {
+            node->param_count = rule_count;
+        }
+
+        if (node->param_count > 0) {
+            node->param_types = (nxld_param_type_t*)malloc((size_t)node->param_count * sizeof(nxld_param_type_t));
+            node->frame_template = (nxld_plan_value_t*)calloc((size_t)node->param_count, sizeof(nxld_plan_value_t));
+            compiler->bound[n] = (unsigned char*)calloc((size_t)node->param_count, 1);
+            if (node->param_types == NULL || node->frame_template == NULL || compiler->bound[n] == NULL) {
+                return -1;
+            }
+            for (int p = 0; p < node->param_count; p++) {
+                node->param_types[p] = (info != NULL && (size_t)p < info->param_count) ? info->params[p].type : NXLD_PARAM_TYPE_UNKNOWN;
+            }
+        }
+        node->frame_offset = plan->frame_slot_count;
+        plan->frame_slot_count += (size_t)node->param_count;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 将常量文本预解析为计划值 / Pre-parse constant text into a plan value / Konstantentext vorab in einen Planwert parsen
+ */
+static int parse_constant(const char* text, nxld_param_type_t type, nxld_plan_value_t* value) {
+    char* end = NULL;
+    long long number = strtoll(text, &end, 0);
+    int is_number = (end != text && *end == '\0');
+
+    switch (type) {
+        case NXLD_PARAM_TYPE_INT:
+        case NXLD_PARAM_TYPE_LONG:
+        case NXLD_PARAM_TYPE_CHAR:
+            value->kind = NXLD_PLAN_VALUE_INT;
+            value->data.int_value = number;
+            return 0;
+        case NXLD_PARAM_TYPE_STRING:
+        case NXLD_PARAM_TYPE_POINTER:
+            break;
+        default:
+            if (is_number) {
+                value->kind = NXLD_PLAN_VALUE_INT;
+                value->data.int_value = number;
+                return 0;
+            }
+            break;
+    }
+
+    char* copy = duplicate_string(text);
+    if (copy == NULL) {
+        return -1;
+    }
+    value->kind = NXLD_PLAN_VALUE_STRING;
+    value->data.string_value = copy;
+    return 0;
+}
+
+/**
+ * @brief 将规则常量预绑定到参数帧模板 / Pre-bind rule constants into argument frame templates / Regelkonstanten vorab in Argumentrahmen-Vorlagen binden
+ */
+static int bind_constants(plan_compiler_t* compiler) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    for (size_t r = 0; r < compiler->rules->rule_count; r++) {
+        const nxld_transfer_rule_t* rule = &compiler->rules->rules[r];
+        if (!compiler->rule_active[r] || rule->target_param_value == NULL) {
+            continue;
+        }
+
+        nxld_plan_node_t* node = &plan->nodes[compiler->rule_target_node[r]];
+        int slot = rule->target_param_index;
+        if (slot < 0 || slot >= node->param_count) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Constant for %s.%s[%d] is outside the interface parameters (param_count=%d), ignored",
+                             rule->target_plugin, rule->target_interface, slot, node->param_count);
+            continue;
+        }
+
+        if (node->frame_template[slot].kind != NXLD_PLAN_VALUE_NONE) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Conflicting constants for %s.%s[%d], keeping the first one",
+                             rule->target_plugin, rule->target_interface, slot);
+            continue;
+        }
+
+        if (parse_constant(rule->target_param_value, node->param_types[slot], &node->frame_template[slot]) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 将节点槽绑定状态恢复为模板状态 / Reset node slot binding state to template state / Slot-Bindungszustand des Knotens auf Vorlagenzustand zurücksetzen
+ * @details 流生产者接收句柄的槽由引擎绑定 / The slot receiving a stream handle is bound by the engine / Der Slot für das Stream-Handle wird von der Engine gebunden
+ */
+static void reset_bound(plan_compiler_t* compiler, size_t node) {
+    const nxld_plan_node_t* plan_node = &compiler->plan->nodes[node];
+    for (int p = 0; p < plan_node->param_count; p++) {
+        compiler->bound[node][p] = plan_node->frame_template[p].kind != NXLD_PLAN_VALUE_NONE;
+    }
+    if (compiler->node_stream[node] != NXLD_PLAN_INVALID_INDEX) {
+        int slot = compiler->plan->streams[compiler->node_stream[node]].producer_slot;
+        if (slot < plan_node->param_count) {
+            compiler->bound[node][slot] = 1;
+        }
+    }
+}
+
+/**
+ * @brief 按拓扑顺序排序节点 / Sort nodes in topological order / Knoten topologisch sortieren
+ * @return 成功返回0，存在环返回1，内存错误返回-1 / Returns 0 on success, 1 if a cycle exists, -1 on memory error / Gibt 0 bei Erfolg zurück, 1 bei Zyklus, -1 bei Speicherfehler
+ */
+static int sort_nodes(plan_compiler_t* compiler) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+    size_t* in_degree = (size_t*)calloc(plan->node_count + 1, sizeof(size_t));
+    plan->node_order = (size_t*)malloc((plan->node_count + 1) * sizeof(size_t));
+    if (in_degree == NULL || plan->node_order == NULL) {
+        free(in_degree);
+        return -1;
+    }
+
+    for (size_t r = 0; r < compiler->rules->rule_count; r++) {
+        if (compiler->rule_active[r] && compiler->rule_source_node[r] != NXLD_PLAN_INVALID_INDEX) {
+            in_degree[compiler->rule_target_node[r]]++;
+        }
+    }
+
+    size_t head = 0;
+    size_t tail = 0;
+    for (size_t n = 0; n < plan->node_count; n++) {
+        if (in_degree[n] == 0) {
+            plan->node_order[tail++] = n;
+        }
+    }
+
+    while (head < tail) {
+        size_t n = plan->node_order[head++];
+        for (size_t r = compiler->node_first_source[n]; r != NXLD_PLAN_INVALID_INDEX; r = compiler->rule_next_source[r]) {
+            if (rule_has_source(compiler, r, n) && --in_degree[compiler->rule_target_node[r]] == 0) {
+                plan->node_order[tail++] = compiler->rule_target_node[r];
+            }
+        }
+    }
+
+    free(in_degree);
+    return tail == plan->node_count ? 0 : 1;
+}
+
+/**
+ * @brief 追加步骤 / Append step / Schritt anhängen
+ * @return 步骤索引，失败返回NXLD_PLAN_INVALID_INDEX / Step index, NXLD_PLAN_INVALID_INDEX on failure / Schrittindex, NXLD_PLAN_INVALID_INDEX bei Fehler
+ */
+static size_t append_step(plan_compiler_t* compiler, nxld_plan_op_t op, size_t node, int slot, size_t rule) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    if (plan->step_count >= compiler->step_capacity) {
+        size_t new_capacity = compiler->step_capacity == 0 ? 32 : compiler->step_capacity * 2;
+        nxld_plan_step_t* new_steps = (nxld_plan_step_t*)realloc(plan->steps, new_capacity * sizeof(nxld_plan_step_t));
+        if (new_steps == NULL) {
+            compiler->error = NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+            return NXLD_PLAN_INVALID_INDEX;
+        }
+        plan->steps = new_steps;
+        compiler->step_capacity = new_capacity;
+    }
+
+    nxld_plan_step_t* step = &plan->steps[plan->step_count];
+    memset(step, 0, sizeof(nxld_plan_step_t));
+    step->op = op;
+    step->node = node;
+    step->slot = slot;
+    step->export_node = NXLD_PLAN_INVALID_INDEX;
+    step->skip_to = NXLD_PLAN_INVALID_INDEX;
+    step->stream = NXLD_PLAN_INVALID_INDEX;
+    step->predicate = NXLD_PLAN_INVALID_INDEX;
+    step->rule = rule;
+    return plan->step_count++;
+}
+
+/**
+ * @brief 检查节点所有参数槽是否已绑定 / Check whether all argument slots of a node are bound / Prüfen, ob alle Argument-Slots eines Knotens gebunden sind
+ */
+static int node_ready(const plan_compiler_t* compiler, size_t node) {
+    for (int p = 0; p < compiler->plan->nodes[node].param_count; p++) {
+        if (!compiler->bound[node][p]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 查找主动调用规则对应的导出接口规则 / Find export interface rule matching an active call rule / Exportschnittstellenregel zu einer aktiven Aufrufregel suchen
+ */
+static size_t find_export_rule(const plan_compiler_t* compiler, size_t active_rule) {
+    const nxld_transfer_rule_t* active = &compiler->rules->rules[active_rule];
+    const nxld_plan_node_t* source = &compiler->plan->nodes[compiler->rule_source_node[active_rule]];
+
+    size_t target = compiler->rule_target_node[active_rule];
+    for (size_t r = compiler->node_first_target[target]; r != NXLD_PLAN_INVALID_INDEX; r = compiler->rule_next_target[r]) {
+        const nxld_transfer_rule_t* rule = &compiler->rules->rules[r];
+        if (!compiler->rule_active[r] || rule->source_param_index < 0 || is_stream_rule(compiler, r) ||
+            compiler->rule_source_node[r] == NXLD_PLAN_INVALID_INDEX ||
+            compiler->plan->nodes[compiler->rule_source_node[r]].plugin_index != source->plugin_index) {
+            continue;
+        }
+        if (rule->target_param_index == active->target_param_index) {
+            return r;
+        }
+    }
+    return NXLD_PLAN_INVALID_INDEX;
+}
+
+/**
+ * @brief 将规则谓词复制到计划中 / Copy rule predicate into the plan / Regelprädikat in den Plan kopieren
+ * @return 谓词索引，无条件时返回NXLD_PLAN_INVALID_INDEX / Predicate index, NXLD_PLAN_INVALID_INDEX without condition / Prädikatindex, NXLD_PLAN_INVALID_INDEX ohne Bedingung
+ */
+static size_t add_predicate(plan_compiler_t* compiler, size_t rule) {
+    const nxld_transfer_rule_t* source = &compiler->rules->rules[rule];
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    if (source->condition_type != NXLD_TRANSFER_CONDITION_PREDICATE) {
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+
+    nxld_condition_t* new_predicates = (nxld_condition_t*)realloc(plan->predicates, (plan->predicate_count + 1) * sizeof(nxld_condition_t));
+    if (new_predicates == NULL) {
+        compiler->error = NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+    plan->predicates = new_predicates;
+    plan->predicates[plan->predicate_count] = source->predicate;
+    return plan->predicate_count++;
+}
+
+static void emit_call(plan_compiler_t* compiler, size_t node, size_t rule);
+
+/**
+ * @brief 在节点就绪时展开调用 / Unroll call once node is ready / Aufruf entrollen, sobald Knoten bereit ist
+ */
+static void emit_call_if_ready(plan_compiler_t* compiler, size_t node, size_t rule) {
+    if (compiler->error == NXLD_TRANSFER_PLAN_SUCCESS && node_ready(compiler, node)) {
+        emit_call(compiler, node, rule);
+    }
+}
+
+/**
+ * @brief 展开节点调用及其主动调用链 / Unroll node call and its active call chain / Knotenaufruf und seine aktive Aufrufkette entrollen
+ */
+static void emit_call(plan_compiler_t* compiler, size_t node, size_t rule) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    if (compiler->on_stack[node]) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Active call cycle detected at %s.%s",
+                       plan->plugins[plan->nodes[node].plugin_index].plugin_name, plan->nodes[node].interface_name);
+        compiler->error = NXLD_TRANSFER_PLAN_CYCLE;
+        return;
+    }
+
+    size_t call_step = append_step(compiler, NXLD_PLAN_OP_CALL, node, -1, rule);
+    if (call_step == NXLD_PLAN_INVALID_INDEX) {
+        return;
+    }
+    plan->steps[call_step].guarded = compiler->conditional[node];
+
+    plan->steps[call_step].stream = compiler->node_stream[node];
+
+    // 没有绑定值步骤的规则（如带常量值的主动调用规则）由调用步骤计为一次触发 / A rule without a value step (such as an active rule with a constant value) is counted as fired by the call step / Eine Regel ohne Wertschritt (etwa eine aktive Regel mit Konstantenwert) wird vom Aufrufschritt als ausgelöst gezählt
+    const nxld_plan_step_t* previous = call_step > 0 ? &plan->steps[call_step - 1] : NULL;
+    plan->steps[call_step].counts_rule = previous == NULL || previous->rule != rule || previous->op == NXLD_PLAN_OP_CALL;
+    plan->steps[call_step].trigger_node = compiler->rule_source_node[rule];
+
+    // 调用后参数帧恢复为模板 / Argument frame is reset to the template after the call / Argumentrahmen wird nach dem Aufruf auf die Vorlage zurückgesetzt
+    reset_bound(compiler, node);
+    compiler->conditional[node] = 0;
+    compiler->on_stack[node] = 1;
+
+    for (size_t r = compiler->node_first_source[node]; r != NXLD_PLAN_INVALID_INDEX && compiler->error == NXLD_TRANSFER_PLAN_SUCCESS;
+         r = compiler->rule_next_source[r]) {
+        const nxld_transfer_rule_t* active = &compiler->rules->rules[r];
+        if (!rule_has_source(compiler, r, node) || active->source_param_index >= 0) {
+            continue;
+        }
+
+        size_t target = compiler->rule_target_node[r];
+        int slot = active->target_param_index;
+        if (active->target_param_value == NULL && slot >= 0 && slot < plan->nodes[target].param_count) {
+            size_t export_rule = find_export_rule(compiler, r);
+            if (export_rule != NXLD_PLAN_INVALID_INDEX && compiler->rules->rules[export_rule].target_param_value == NULL) {
+                size_t fetch_step = append_step(compiler, NXLD_PLAN_OP_FETCH, target, slot, r);
+                if (fetch_step == NXLD_PLAN_INVALID_INDEX) {
+                    return;
+                }
+                plan->steps[fetch_step].export_node = compiler->rule_source_node[export_rule];
+                plan->steps[fetch_step].predicate = add_predicate(compiler, export_rule);
+                // 取值调用可能失败，目标调用总是受保护 / The fetch call may fail, so the target call is always guarded / Der Abrufaufruf kann fehlschlagen, daher ist der Zielaufruf immer geschützt
+                compiler->conditional[target] = 1;
+                compiler->bound[target][slot] = 1;
+                mark_dirty(compiler, target);
+            }
+        }
+
+        emit_call_if_ready(compiler, target, r);
+    }
+
+    compiler->on_stack[node] = 0;
+    plan->steps[call_step].skip_to = plan->step_count;
+}
+
+/**
+ * @brief 为一个源接口参数编译路由 / Compile route for one source interface parameter / Route für einen Quellschnittstellenparameter kompilieren
+ */
+static void emit_route(plan_compiler_t* compiler, nxld_plan_route_t* route) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+    route->first_step = plan->step_count;
+
+    // 只恢复上一条路由修改过的节点 / Only restore nodes the previous route changed / Nur die von der vorherigen Route geänderten Knoten zurücksetzen
+    for (size_t i = 0; i < compiler->dirty_count; i++) {
+        size_t n = compiler->dirty_nodes[i];
+        reset_bound(compiler, n);
+        compiler->conditional[n] = 0;
+        compiler->dirty[n] = 0;
+    }
+    compiler->dirty_count = 0;
+
+    for (size_t r = compiler->node_first_source[route->source_node];
+         r != NXLD_PLAN_INVALID_INDEX && compiler->error == NXLD_TRANSFER_PLAN_SUCCESS; r = compiler->rule_next_source[r]) {
+        const nxld_transfer_rule_t* rule = &compiler->rules->rules[r];
+        if (!rule_has_source(compiler, r, route->source_node) || rule->source_param_index != route->source_param_index ||
+            is_stream_rule(compiler, r)) {
+            continue;
+        }
+
+        size_t target = compiler->rule_target_node[r];
+        int slot = rule->target_param_index;
+        if (rule->target_param_value == NULL && slot >= 0 && slot < plan->nodes[target].param_count) {
+            size_t bind_step = append_step(compiler, NXLD_PLAN_OP_BIND_SOURCE, target, slot, r);
+            if (bind_step == NXLD_PLAN_INVALID_INDEX) {
+                return;
+            }
+            plan->steps[bind_step].predicate = add_predicate(compiler, r);
+            if (plan->steps[bind_step].predicate != NXLD_PLAN_INVALID_INDEX) {
+                compiler->conditional[target] = 1;
+            }
+            compiler->bound[target][slot] = 1;
+            mark_dirty(compiler, target);
+        }
+
+        emit_call_if_ready(compiler, target, r);
+    }
+
+    route->step_count = plan->step_count - route->first_step;
+}
+
+/**
+ * @brief 为所有源接口参数编译路由 / Compile routes for all source interface parameters / Routen für alle Quellschnittstellenparameter kompilieren
+ */
+static int build_routes(plan_compiler_t* compiler) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    for (size_t n = 0; n < plan->node_count; n++) {
+        reset_bound(compiler, n);
+        compiler->conditional[n] = 0;
+    }
+
+    for (size_t r = 0; r < compiler->rules->rule_count; r++) {
+        const nxld_transfer_rule_t* rule = &compiler->rules->rules[r];
+        if (!compiler->rule_active[r] || compiler->rule_source_node[r] == NXLD_PLAN_INVALID_INDEX || rule->source_param_index < 0 ||
+            is_stream_rule(compiler, r)) {
+            continue;
+        }
+
+        const nxld_plan_node_t* source = &plan->nodes[compiler->rule_source_node[r]];
+        char key[NXLD_STRING_INDEX_MAX_KEY];
+        if (!make_route_key(key, sizeof(key), plan->plugins[source->plugin_index].plugin_name, source->interface_name,
+                            rule->source_param_index)) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Transfer rule %zu source name is too long, removed from plan", r);
+            continue;
+        }
+        if (nxld_string_index_get(&plan->route_lookup, key) != NXLD_STRING_INDEX_NOT_FOUND) {
+            continue;
+        }
+
+        if (plan->route_count >= compiler->route_capacity) {
+            size_t new_capacity = compiler->route_capacity == 0 ? 16 : compiler->route_capacity * 2;
+            nxld_plan_route_t* new_routes = (nxld_plan_route_t*)realloc(plan->routes, new_capacity * sizeof(nxld_plan_route_t));
+            if (new_routes == NULL) {
+                compiler->error = NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+                return -1;
+            }
+            plan->routes = new_routes;
+            compiler->route_capacity = new_capacity;
+        }
+        if (nxld_string_index_set(&plan->route_lookup, key, plan->route_count) != 0) {
+            compiler->error = NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+            return -1;
+        }
+
+        nxld_plan_route_t* route = &plan->routes[plan->route_count++];
+        memset(route, 0, sizeof(nxld_plan_route_t));
+        route->source_node = compiler->rule_source_node[r];
+        route->source_param_index = rule->source_param_index;
+
+        emit_route(compiler, route);
+        if (compiler->error != NXLD_TRANSFER_PLAN_SUCCESS) {
+            return -1;
+        }
+
+        const char* source_plugin = plan->plugins[plan->nodes[route->source_node].plugin_index].plugin_name;
+        if (plan->entry_route == NXLD_PLAN_INVALID_INDEX && compiler->rules->entry_plugin_name != NULL &&
+            strcmp(source_plugin, compiler->rules->entry_plugin_name) == 0) {
+            plan->entry_route = plan->route_count - 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 为规则建立节点映射 / Build node mapping for rules / Knotenzuordnung für Regeln aufbauen
+ */
+static int map_rules(plan_compiler_t* compiler) {
+    const nxld_transfer_rule_set_t* rules = compiler->rules;
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    for (size_t r = 0; r < rules->rule_count; r++) {
+        const nxld_transfer_rule_t* rule = &rules->rules[r];
+        compiler->rule_source_node[r] = NXLD_PLAN_INVALID_INDEX;
+        compiler->rule_target_node[r] = NXLD_PLAN_INVALID_INDEX;
+
+        if (!rule->enabled || rule->target_plugin == NULL || rule->target_interface == NULL) {
+            plan->skipped_rule_count++;
+            continue;
+        }
+
+        if (rule->condition_type == NXLD_TRANSFER_CONDITION_UNKNOWN) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Transfer rule %zu has invalid condition '%s', removed from plan", r, rule->condition);
+            plan->skipped_rule_count++;
+            continue;
+        }
+
+        compiler->rule_target_node[r] = find_or_add_node(compiler, rule->target_plugin, rule->target_plugin_path, rule->target_interface);
+        if (compiler->rule_target_node[r] == NXLD_PLAN_INVALID_INDEX) {
+            return -1;
+        }
+
+        if (rule->source_plugin != NULL && rule->source_interface != NULL) {
+            const char* source_path = NULL;
+            if (rules->entry_plugin_name != NULL && strcmp(rule->source_plugin, rules->entry_plugin_name) == 0) {
+                source_path = rules->entry_plugin_path;
+            }
+            compiler->rule_source_node[r] = find_or_add_node(compiler, rule->source_plugin, source_path, rule->source_interface);
+            if (compiler->rule_source_node[r] == NXLD_PLAN_INVALID_INDEX) {
+                return -1;
+            }
+        }
+
+        compiler->rule_active[r] = 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 为流式规则建立流定义 / Build stream definitions for stream rules / Stream-Definitionen für Stream-Regeln aufbauen
+ */
+static int build_streams(plan_compiler_t* compiler) {
+    nxld_transfer_plan_t* plan = compiler->plan;
+
+    for (size_t r = 0; r < compiler->rules->rule_count; r++) {
+        const nxld_transfer_rule_t* rule = &compiler->rules->rules[r];
+        if (!compiler->rule_active[r] || !is_stream_rule(compiler, r)) {
+            continue;
+        }
+
+        size_t producer = compiler->rule_source_node[r];
+        size_t consumer = compiler->rule_target_node[r];
+        if (producer == NXLD_PLAN_INVALID_INDEX || producer == consumer || rule->source_param_index < 0 ||
+            rule->target_param_index < 0 || compiler->node_stream[producer] != NXLD_PLAN_INVALID_INDEX) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Stream rule %zu (%s.%s -> %s.%s) is invalid or duplicates another stream of the producer, removed from plan",
+                             r, rule->source_plugin != NULL ? rule->source_plugin : "NULL",
+                             rule->source_interface != NULL ? rule->source_interface : "NULL",
+                             rule->target_plugin, rule->target_interface);
+            compiler->rule_active[r] = 0;
+            plan->skipped_rule_count++;
+            continue;
+        }
+
+        nxld_plan_stream_t* new_streams = (nxld_plan_stream_t*)realloc(plan->streams, (plan->stream_count + 1) * sizeof(nxld_plan_stream_t));
+        if (new_streams == NULL) {
+            return -1;
+        }
+        plan->streams = new_streams;
+
+        nxld_plan_stream_t* stream = &plan->streams[plan->stream_count];
+        stream->producer_node = producer;
+        stream->producer_slot = rule->source_param_index;
+        stream->consumer_node = consumer;
+        stream->consumer_slot = rule->target_param_index;
+        stream->chunk_bytes = rule->stream_chunk_bytes != 0 ? rule->stream_chunk_bytes : DEFAULT_STREAM_CHUNK_BYTES;
+        stream->depth = rule->stream_depth != 0 ? rule->stream_depth : DEFAULT_STREAM_DEPTH;
+        compiler->node_stream[producer] = plan->stream_count++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 释放编译器临时状态 / Free compiler scratch state / Temporären Compiler-Zustand freigeben
+ */
+static void free_compiler(plan_compiler_t* compiler) {
+    if (compiler->bound != NULL) {
+        for (size_t n = 0; n < compiler->plan->node_count; n++) {
+            free(compiler->bound[n]);
+        }
+        free(compiler->bound);
+    }
+    free(compiler->rule_source_node);
+    free(compiler->rule_target_node);
+    free(compiler->rule_active);
+    free(compiler->conditional);
+    free(compiler->on_stack);
+    free(compiler->node_stream);
+    free(compiler->node_first_source);
+    free(compiler->rule_next_source);
+    free(compiler->node_first_target);
+    free(compiler->rule_next_target);
+    free(compiler->dirty_nodes);
+    free(compiler->dirty);
+    nxld_string_index_free(&compiler->plugin_lookup);
+    nxld_string_index_free(&compiler->node_lookup);
+}
+
+nxld_transfer_plan_result_t nxld_transfer_plan_compile(const nxld_transfer_rule_set_t* rules, nxld_transfer_plan_t* plan) {
+    if (rules == NULL || plan == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Invalid parameters for execution plan compilation");
+        return NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+    }
+
+    memset(plan, 0, sizeof(nxld_transfer_plan_t));
+    plan->entry_route = NXLD_PLAN_INVALID_INDEX;
+    plan->memo_enabled = rules->memoize_enabled;
+    nxld_string_index_init(&plan->route_lookup);
+    nxld_mutex_init(&plan->load_mutex);
+    nxld_mutex_init(&plan->exec_mutex);
+    plan->sync_initialized = 1;
+
+    plan_compiler_t compiler;
+    memset(&compiler, 0, sizeof(compiler));
+    compiler.rules = rules;
+    compiler.plan = plan;
+    nxld_string_index_init(&compiler.plugin_lookup);
+    nxld_string_index_init(&compiler.node_lookup);
+
+    size_t rule_slots = rules->rule_count + 1;
+    compiler.rule_source_node = (size_t*)malloc(rule_slots * sizeof(size_t));
+    compiler.rule_target_node = (size_t*)malloc(rule_slots * sizeof(size_t));
+    compiler.rule_active = (unsigned char*)calloc(rule_slots, 1);
+    if (compiler.rule_source_node == NULL || compiler.rule_target_node == NULL || compiler.rule_active == NULL ||
+        map_rules(&compiler) != 0 || link_rules(&compiler) != 0) {
+        free_compiler(&compiler);
+        nxld_transfer_plan_free(plan);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while mapping transfer rules");
+        return NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+    }
+
+    compiler.bound = (unsigned char**)calloc(plan->node_count + 1, sizeof(unsigned char*));
+    compiler.conditional = (unsigned char*)calloc(plan->node_count + 1, 1);
+    compiler.on_stack = (unsigned char*)calloc(plan->node_count + 1, 1);
+    compiler.node_stream = (size_t*)malloc((plan->node_count + 1) * sizeof(size_t));
+    if (compiler.node_stream != NULL) {
+        for (size_t n = 0; n <= plan->node_count; n++) {
+            compiler.node_stream[n] = NXLD_PLAN_INVALID_INDEX;
+        }
+    }
+    if (compiler.bound == NULL || compiler.conditional == NULL || compiler.on_stack == NULL || compiler.node_stream == NULL ||
+        build_streams(&compiler) != 0 || build_frames(&compiler) != 0 || bind_constants(&compiler) != 0) {
+        free_compiler(&compiler);
+        nxld_transfer_plan_free(plan);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while building argument frames");
+        return NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+    }
+
+    int sort_result = sort_nodes(&compiler);
+    if (sort_result != 0) {
+        free_compiler(&compiler);
+        nxld_transfer_plan_free(plan);
+        if (sort_result > 0) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Transfer rule graph contains a cycle, execution plan not compiled");
+            return NXLD_TRANSFER_PLAN_CYCLE;
+        }
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while sorting plan nodes");
+        return NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+    }
+
+    build_routes(&compiler);
+    nxld_transfer_plan_result_t result = compiler.error;
+    free_compiler(&compiler);
+    if (result == NXLD_TRANSFER_PLAN_SUCCESS && rules->metrics_enabled) {
+        plan->metrics = nxld_metrics_create(rules->rule_count + plan->node_count, rules->metrics_sampling);
+        plan->metrics_rule_count = rules->rule_count;
+        if (plan->metrics == NULL) {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for execution metrics, metrics disabled");
+        }
+    }
+    if (result == NXLD_TRANSFER_PLAN_SUCCESS) {
+        plan->default_context = nxld_transfer_plan_context_create(plan);
+        if (plan->default_context == NULL) {
+            result = NXLD_TRANSFER_PLAN_MEMORY_ERROR;
+        }
+    }
+    if (result != NXLD_TRANSFER_PLAN_SUCCESS) {
+        nxld_transfer_plan_free(plan);
+        return result;
+    }
+
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Compiled execution plan: %zu plugins, %zu nodes, %zu routes, %zu steps, %zu streams (%zu rules removed)",
+                  plan->plugin_count, plan->node_count, plan->route_count, plan->step_count, plan->stream_count,
+                  plan->skipped_rule_count);
+    return NXLD_TRANSFER_PLAN_SUCCESS;
+}
+
+size_t nxld_transfer_plan_find_route(const nxld_transfer_plan_t* plan, const char* source_plugin,
+                                     const char* source_interface, int param_index) {
+    if (plan == NULL || source_plugin == NULL || source_interface == NULL) {
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+
+    char key[NXLD_STRING_INDEX_MAX_KEY];
+    if (!make_route_key(key, sizeof(key), source_plugin, source_interface, param_index)) {
+        return NXLD_PLAN_INVALID_INDEX;
+    }
+
+    size_t route = nxld_string_index_get(&plan->route_lookup, key);
+    return route != NXLD_STRING_INDEX_NOT_FOUND ? route : NXLD_PLAN_INVALID_INDEX;
+}
+
+#ifdef _WIN32
+static nxld_plan_resolved_t* load_resolved(const nxld_plan_node_t* node) {
+    return (nxld_plan_resolved_t*)InterlockedCompareExchangePointer((PVOID volatile*)&node->resolved, NULL, NULL);
+}
+
+static void publish_resolved(nxld_plan_node_t* node, nxld_plan_resolved_t* resolved) {
+    InterlockedExchangePointer((PVOID volatile*)&node->resolved, resolved);
+}
+#else
+static nxld_plan_resolved_t* load_resolved(const nxld_plan_node_t* node) {
+    return __atomic_load_n(&node->resolved, __ATOMIC_ACQUIRE);
+}
+
+static void publish_resolved(nxld_plan_node_t* node, nxld_plan_resolved_t* resolved) {
+    __atomic_store_n(&node->resolved, resolved, __ATOMIC_RELEASE);
+}
+#endif
+
+/**
+ * @brief 获取节点当前的参数类型 / Get the current parameter types of a node / Aktuelle Parametertypen eines Knotens abrufen
+ */
+static const nxld_param_type_t* node_types(const nxld_plan_node_t* node) {
+    const nxld_plan_resolved_t* resolved = load_resolved(node);
+    return resolved != NULL ? resolved->param_types : node->param_types;
+}
+
+/**
+ * @brief 检查参数类型能否按值作为缓存键 / Check whether a parameter type can be part of a cache key by value / Prüfen, ob ein Parametertyp als Wert Teil eines Cache-Schlüssels sein kann
+ */
+static int memo_key_type(nxld_param_type_t type) {
+    return type == NXLD_PARAM_TYPE_INT || type == NXLD_PARAM_TYPE_LONG || type == NXLD_PARAM_TYPE_CHAR ||
+           type == NXLD_PARAM_TYPE_STRING || type == NXLD_PARAM_TYPE_BUFFER;
+}
+
+/**
+ * @brief 为纯接口节点创建结果缓存 / Create result cache for a pure interface node / Ergebniscache für den Knoten einer reinen Schnittstelle erstellen
+ * @param types 与插件核对后的参数类型 / Parameter types checked against the plugin / Mit dem Plugin abgeglichene Parametertypen
+ * @return 结果缓存，不缓存时返回NULL / Result cache, NULL when not cached / Ergebniscache, NULL wenn nicht zwischengespeichert
+ * @details 只有全部参数都能按值比较时才缓存；返回值作为缓冲区交给引擎释放或接收流句柄的接口不缓存。调用方须持有load_mutex / Only cached when every argument compares by value; interfaces whose return value is handed to the engine as a buffer to release, or that receive a stream handle, are not cached. Caller must hold load_mutex / Nur zwischengespeichert, wenn jedes Argument nach Wert vergleichbar ist; Schnittstellen, deren Rückgabewert der Engine als freizugebender Puffer übergeben wird oder die ein Stream-Handle erhalten, werden nicht zwischengespeichert. Aufrufer muss load_mutex halten
+ */
+static nxld_memo_t* create_node_memo(const nxld_transfer_plan_t* plan, const nxld_plan_node_t* node, const nxld_interface_info_t* info,
+                                     const nxld_param_type_t* types) {
+    if (!plan->memo_enabled || info == NULL || !info->pure) {
+        return NULL;
+    }
+
+    const char* plugin_name = plan->plugins[node->plugin_index].plugin_name;
+    size_t node_index = (size_t)(node - plan->nodes);
+    for (int p = 0; p < node->param_count; p++) {
+        if (!memo_key_type(types[p])) {
+            NXLD_LOG_DEBUG(NXLD_LOG_MODULE_DISPATCH, "Pure interface %s.%s not cached: parameter %d cannot be compared by value", plugin_name,
+                           node->interface_name, p);
+            return NULL;
+        }
+    }
+    for (size_t i = 0; i < plan->step_count; i++) {
+        const nxld_plan_step_t* step = &plan->steps[i];
+        int returns_buffer = step->op == NXLD_PLAN_OP_FETCH && step->export_node == node_index &&
+                             node_types(&plan->nodes[step->node])[step->slot] == NXLD_PARAM_TYPE_BUFFER;
+        int produces_stream = step->stream != NXLD_PLAN_INVALID_INDEX && step->node == node_index;
+        if (returns_buffer || produces_stream) {
+            NXLD_LOG_DEBUG(NXLD_LOG_MODULE_DISPATCH, "Pure interface %s.%s not cached: its %s", plugin_name, node->interface_name,
+                           returns_buffer ? "result is a buffer released after use" : "calls produce a stream");
+            return NULL;
+        }
+    }
+
+    nxld_memo_t* memo = nxld_memo_create(info->cache_capacity);
+    if (memo == NULL) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for result cache of %s.%s", plugin_name, node->interface_name);
+        return NULL;
+    }
+    nxld_memo_stats_t stats;
+    nxld_memo_get_stats(memo, &stats);
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Caching results of pure interface %s.%s (capacity %zu)", plugin_name, node->interface_name, stats.capacity);
+    return memo;
+}
+
+/**
+ * @brief 延迟加载插件并解析节点函数 / Lazily load plugin and resolve node function / Plugin verzögert laden und Knotenfunktion auflösen
+ * @details 调用方须持有load_mutex / Caller must hold load_mutex / Aufrufer muss load_mutex halten
+ */
+static int resolve_node(nxld_transfer_plan_t* plan, nxld_plan_node_t* node) {
+    nxld_plan_plugin_t* entry = &plan->plugins[node->plugin_index];
+
+    if (!entry->loaded) {
+        if (entry->load_failed || entry->plugin_path == NULL) {
+            return -1;
+        }
+        if (nxld_plugin_load(entry->plugin_path, &entry->plugin) != NXLD_PLUGIN_LOAD_SUCCESS) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to load target plugin: %s from %s", entry->plugin_name, entry->plugin_path);
+            entry->load_failed = 1;
+            return -1;
+        }
+        entry->loaded = 1;
+
+        // 三个上下文函数必须同时导出 / All three context functions must be exported together / Alle drei Kontextfunktionen müssen gemeinsam exportiert werden
+        entry->create_context = (nxld_plugin_create_context_func)nxld_plugin_get_symbol(&entry->plugin, "nxld_plugin_create_context");
+        entry->destroy_context = (nxld_plugin_destroy_context_func)nxld_plugin_get_symbol(&entry->plugin, "nxld_plugin_destroy_context");
+        entry->bind_context = (nxld_plugin_bind_context_func)nxld_plugin_get_symbol(&entry->plugin, "nxld_plugin_bind_context");
+        if (entry->create_context == NULL || entry->destroy_context == NULL || entry->bind_context == NULL) {
+            entry->create_context = NULL;
+            entry->destroy_context = NULL;
+            entry->bind_context = NULL;
+        } else {
+            NXLD_LOG_DEBUG(NXLD_LOG_MODULE_DISPATCH, "Plugin %s is context-aware", entry->plugin_name);
+        }
+    }
+
+    if (load_resolved(node) != NULL) {
+        return 0;
+    }
+
+    void* function = nxld_plugin_get_symbol(&entry->plugin, node->interface_name);
+    if (function == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Function %s not found in plugin %s", node->interface_name, entry->plugin_name);
+        return -1;
+    }
+
+    nxld_plan_resolved_t* resolved = (nxld_plan_resolved_t*)calloc(1, sizeof(nxld_plan_resolved_t));
+    if (resolved == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while resolving %s.%s", entry->plugin_name, node->interface_name);
+        return -1;
+    }
+    resolved->function = function;
+    resolved->param_types = node->param_types;
+
+    // 插件声明的类型与.nxp不同时使用副本，已发布的编译时类型保持不变 / When the plugin declares types other than the .nxp, use a copy so the published compile-time types stay unchanged / Deklariert das Plugin andere Typen als die .nxp, wird eine Kopie verwendet, damit die veröffentlichten Typen zur Kompilierzeit unverändert bleiben
+    const nxld_interface_info_t* info = nxld_plugin_find_interface(&entry->plugin, node->interface_name);
+    if (info != NULL && info->params != NULL) {
+        for (int p = 0; p < node->param_count && (size_t)p < info->param_count; p++) {
+            if (resolved->param_types[p] == info->params[p].type) {
+                continue;
+            }
+            if (resolved->param_types == node->param_types) {
+                resolved->param_types = (nxld_param_type_t*)malloc((size_t)node->param_count * sizeof(nxld_param_type_t));
+                if (resolved->param_types == NULL) {
+                    NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while resolving %s.%s", entry->plugin_name,
+                                   node->interface_name);
+                    free(resolved);
+                    return -1;
+                }
+                memcpy(resolved->param_types, node->param_types, (size_t)node->param_count * sizeof(nxld_param_type_t));
+            }
+            resolved->param_types[p] = info->params[p].type;
+        }
+    }
+    resolved->memo = create_node_memo(plan, node, info, resolved->param_types);
+    publish_resolved(node, resolved);
+    return 0;
+}
+
+/**
+ * @brief 在上下文中解析节点函数 / Resolve node function in a context / Knotenfunktion in einem Kontext auflösen
+ * @details 每个上下文只在首次使用节点时加锁；同时为上下文感知插件创建调用链上下文 / Each context takes the lock only on first use of a node; also creates the per-chain context of context-aware plugins / Jeder Kontext sperrt nur bei der ersten Verwendung eines Knotens; erstellt außerdem den Kettenkontext kontextbewusster Plugins
+ */
+static void* context_function(nxld_plan_context_t* context, size_t node_index) {
+    void* function = context->functions[node_index];
+    if (function != NULL) {
+        return function;
+    }
+
+    nxld_transfer_plan_t* plan = context->plan;
+    nxld_plan_node_t* node = &plan->nodes[node_index];
+    nxld_mutex_lock(&plan->load_mutex);
+    if (resolve_node(plan, node) == 0) {
+        nxld_plan_plugin_t* entry = &plan->plugins[node->plugin_index];
+        if (entry->create_context != NULL && context->plugin_contexts[node->plugin_index] == NULL) {
+            context->plugin_contexts[node->plugin_index] = entry->create_context();
+        }
+        function = load_resolved(node)->function;
+        context->functions[node_index] = function;
+    }
+    nxld_mutex_unlock(&plan->load_mutex);
+    return function;
+}
+
+/**
+ * @brief 按参数类型转换计划值 / Convert plan value according to parameter type / Planwert gemäß Parametertyp konvertieren
+ */
+static int marshal_value(const nxld_plan_value_t* value, nxld_param_type_t type, intptr_t* out) {
+    switch (type) {
+        case NXLD_PARAM_TYPE_FLOAT:
+        case NXLD_PARAM_TYPE_DOUBLE:
+            return -1;
+        case NXLD_PARAM_TYPE_INT:
+        case NXLD_PARAM_TYPE_LONG:
+        case NXLD_PARAM_TYPE_CHAR:
+            if (value->kind == NXLD_PLAN_VALUE_POINTER) {
+                const void* ptr = value->data.pointer_value;
+                if (ptr == NULL) {
+                    *out = 0;
+                } else if (type == NXLD_PARAM_TYPE_LONG) {
+                    *out = (intptr_t)*(const long*)ptr;
+                } else if (type == NXLD_PARAM_TYPE_CHAR) {
+                    *out = (intptr_t)*(const char*)ptr;
+                } else {
+                    *out = (intptr_t)*(const int*)ptr;
+                }
+                return 0;
+            }
+            break;
+        default:
+            break;
+    }
+
+    switch (value->kind) {
+        case NXLD_PLAN_VALUE_INT:
+        case NXLD_PLAN_VALUE_WORD:
+            *out = (intptr_t)value->data.int_value;
+            break;
+        case NXLD_PLAN_VALUE_STRING:
+            *out = (intptr_t)value->data.string_value;
+            break;
+        case NXLD_PLAN_VALUE_POINTER:
+            *out = (intptr_t)value->data.pointer_value;
+            break;
+        default:
+            *out = 0;
+            break;
+    }
+    return 0;
+}
+
+/**
+ * @brief 计算参数传递的字节数 / Compute bytes passed by an argument / Von einem Argument übergebene Bytes berechnen
+ * @details 只统计缓冲区和字符串，其他类型按值传递不计字节 / Only buffers and strings count, other types are passed by value / Nur Puffer und Zeichenfolgen zählen, andere Typen werden als Wert übergeben
+ */
+static uint64_t argument_bytes(nxld_param_type_t type, intptr_t arg) {
+    if (arg == 0) {
+        return 0;
+    }
+    if (type == NXLD_PARAM_TYPE_BUFFER) {
+        const nxld_buffer_t* buffer = (const nxld_buffer_t*)arg;
+        return (uint64_t)buffer->count * (uint64_t)buffer->element_size;
+    }
+    if (type == NXLD_PARAM_TYPE_STRING) {
+        return (uint64_t)strlen((const char*)arg);
+    }
+    return 0;
+}
+
+/**
+ * @brief 追加缓存键字节 / Append cache key bytes / Cache-Schlüsselbytes anhängen
+ * @return 成功返回0，超出键长度上限返回-1 / Returns 0 on success, -1 if the key length limit is exceeded / Gibt 0 bei Erfolg zurück, -1 bei Überschreitung der Schlüssellängengrenze
+ */
+static int append_key(unsigned char* key, size_t* length, const void* data, size_t size) {
+    if (size > NXLD_MEMO_MAX_KEY - *length) {
+        return -1;
+    }
+    memcpy(key + *length, data, size);
+    *length += size;
+    return 0;
+}
+
+/**
+ * @brief 由已转换的参数构建缓存键 / Build cache key from marshalled arguments / Cache-Schlüssel aus konvertierten Argumenten bilden
+ * @details 数值按字存入，字符串和缓冲区按长度加内容存入，使不同参数组合不会得到相同的键 / Numbers are stored as words, strings and buffers as length plus contents, so distinct argument combinations never share a key / Zahlen werden als Wörter gespeichert, Zeichenfolgen und Puffer als Länge plus Inhalt, damit verschiedene Argumentkombinationen nie denselben Schlüssel teilen
+ * @return 成功返回0，参数过大时返回-1（本次调用不缓存） / Returns 0 on success, -1 if the arguments are too large (this call is not cached) / Gibt 0 bei Erfolg zurück, -1 wenn die Argumente zu groß sind (dieser Aufruf wird nicht zwischengespeichert)
+ */
+static int build_memo_key(const nxld_plan_node_t* node, const intptr_t* args, unsigned char* key, size_t* length) {
+    const nxld_param_type_t* types = node_types(node);
+    *length = 0;
+    for (int p = 0; p < node->param_count; p++) {
+        int status;
+        if (types[p] == NXLD_PARAM_TYPE_STRING && args[p] != 0) {
+            size_t size = strlen((const char*)args[p]);
+            status = append_key(key, length, &size, sizeof(size));
+            status = status == 0 ? append_key(key, length, (const void*)args[p], size) : -1;
+        } else if (types[p] == NXLD_PARAM_TYPE_BUFFER && args[p] != 0) {
+            const nxld_buffer_t* buffer = (const nxld_buffer_t*)args[p];
+            size_t header[3];
+            header[0] = (size_t)buffer->element_type;
+            header[1] = buffer->element_size;
+            header[2] = buffer->data != NULL ? buffer->count : 0;
+            status = append_key(key, length, header, sizeof(header));
+            status = status == 0 ? append_key(key, length, buffer->data, header[1] * header[2]) : -1;
+        } else {
+            // 数值和空指针；空字符串指针与零长度字符串的键不同 / Numbers and null pointers; a null string pointer keys differently from an empty string / Zahlen und Nullzeiger; ein Null-Zeichenfolgenzeiger erhält einen anderen Schlüssel als eine leere Zeichenfolge
+            size_t marker = (size_t)-1;
+            status = types[p] == NXLD_PARAM_TYPE_STRING || types[p] == NXLD_PARAM_TYPE_BUFFER
+                         ? append_key(key, length, &marker, sizeof(marker))
+                         : append_key(key, length, &args[p], sizeof(args[p]));
+        }
+        if (status != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 格式化端点名称 / Format endpoint name / Endpunktnamen formatieren
+ */
+static void format_endpoint(char* out, size_t size, const char* plugin, const char* interface_name, int param_index) {
+    snprintf(out, size, "%s.%s[%d]", plugin != NULL ? plugin : "NULL", interface_name != NULL ? interface_name : "NULL", param_index);
+}
+
+/**
+ * @brief 记录接口调用的跟踪时间段及其参数 / Record trace span of an interface call with its arguments / Verfolgungszeitspanne eines Schnittstellenaufrufs mit seinen Argumenten aufzeichnen
+ * @param cached 结果是否来自结果缓存 / Whether the result came from the result cache / Ob das Ergebnis aus dem Ergebniscache stammt
+ * @details 每个参数只在剩余空间足够时写出，保证参数JSON完整 / Each argument is only written if it fits, so the argument JSON stays complete / Jedes Argument wird nur geschrieben, wenn es passt, damit das Argument-JSON vollständig bleibt
+ */
+static void trace_call(const nxld_transfer_plan_t* plan, const nxld_plan_node_t* node, const intptr_t* args,
+                       intptr_t result, int cached, uint64_t start_ns, uint64_t end_ns) {
+    char name[NXLD_TRACE_NAME_LENGTH];
+    char json[NXLD_TRACE_ARGS_LENGTH];
+    const nxld_param_type_t* types = node_types(node);
+    size_t length = 1;
+    json[0] = '{';
+
+    snprintf(name, sizeof(name), "%s.%s", plan->plugins[node->plugin_index].plugin_name, node->interface_name);
+    for (int p = 0; p <= node->param_count; p++) {
+        char piece[NXLD_TRACE_ARGS_LENGTH];
+        size_t piece_length;
+        if (p == node->param_count) {
+            piece_length = (size_t)snprintf(piece, sizeof(piece), "\"result\":%lld%s", (long long)result,
+                                            cached ? ",\"cached\":true" : "");
+        } else {
+            piece_length = (size_t)snprintf(piece, sizeof(piece), "\"p%d\":", p);
+            switch (types[p]) {
+                case NXLD_PARAM_TYPE_INT:
+                case NXLD_PARAM_TYPE_LONG:
+                case NXLD_PARAM_TYPE_CHAR:
+                    piece_length += (size_t)snprintf(piece + piece_length, sizeof(piece) - piece_length, "%lld", (long long)args[p]);
+                    break;
+                case NXLD_PARAM_TYPE_STRING: {
+                    char preview[TRACE_STRING_PREVIEW + 1];
+                    const char* text = args[p] != 0 ? (const char*)args[p] : "";
+                    size_t text_length = strlen(text);
+                    memcpy(preview, text, text_length < TRACE_STRING_PREVIEW ? text_length : TRACE_STRING_PREVIEW);
+                    preview[text_length < TRACE_STRING_PREVIEW ? text_length : TRACE_STRING_PREVIEW] = '\0';
+                    piece_length = nxld_trace_append_string(piece, sizeof(piece), piece_length, preview);
+                    break;
+                }
+                case NXLD_PARAM_TYPE_BUFFER:
+                    if (args[p] != 0) {
+                        const nxld_buffer_t* buffer = (const nxld_buffer_t*)args[p];
+                        piece_length += (size_t)snprintf(piece + piece_length, sizeof(piece) - piece_length, "\"buffer %zux%zu\"",
+                                                         buffer->count, buffer->element_size);
+                    } else {
+                        piece_length += (size_t)snprintf(piece + piece_length, sizeof(piece) - piece_length, "null");
+                    }
+                    break;
+                default:
+                    piece_length += (size_t)snprintf(piece + piece_length, sizeof(piece) - piece_length, "\"0x%llx\"",
+                                                     (unsigned long long)(uintptr_t)args[p]);
+                    break;
+            }
+        }
+        // 为分隔符、结尾花括号和终止符保留空间 / Keep room for the separator, closing brace and terminator / Platz für Trennzeichen, schließende Klammer und Terminator lassen
+        if (piece_length >= sizeof(piece) || length + piece_length + 3 > sizeof(json)) {
+            break;
+        }
+        if (length > 1) {
+            json[length++] = ',';
+        }
+        memcpy(json + length, piece, piece_length);
+        length += piece_length;
+    }
+    json[length++] = '}';
+    json[length] = '\0';
+    nxld_trace_span("call", name, start_ns, end_ns, json);
+}
+
+/**
+ * @brief 以参数帧调用节点函数 / Invoke node function with its argument frame / Knotenfunktion mit ihrem Argumentrahmen aufrufen
+ * @param shard 记录接口指标的分片（NULL表示不记录） / Shard recording interface metrics (NULL to skip) / Shard für Schnittstellenmetriken (NULL zum Überspringen)
+ * @param elapsed_ns 输出调用耗时，未计时为NXLD_METRICS_NO_LATENCY / Output call duration, NXLD_METRICS_NO_LATENCY if untimed / Ausgabe der Aufrufdauer, NXLD_METRICS_NO_LATENCY wenn ungemessen
+ * @param mark_ns 输出调用跟踪时间段内的时间点，未跟踪为0（可为NULL） / Output point in time inside the call's trace span, 0 if not traced (may be NULL) / Ausgabe eines Zeitpunkts innerhalb der Verfolgungszeitspanne des Aufrufs, 0 ohne Verfolgung (kann NULL sein)
+ */
+static int invoke_node(nxld_plan_context_t* context, nxld_metrics_shard_t* shard, size_t node_index,
+                       intptr_t* result, uint64_t* elapsed_ns, uint64_t* mark_ns) {
+    nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_node_t* node = &plan->nodes[node_index];
+    size_t series = plan->metrics_rule_count + node_index;
+    *elapsed_ns = NXLD_METRICS_NO_LATENCY;
+    if (mark_ns != NULL) {
+        *mark_ns = 0;
+    }
+
+    void* function = context_function(context, node_index);
+    if (function == NULL) {
+        nxld_metrics_record_error(shard, series);
+        return -1;
+    }
+
+    if (node->param_count > MAX_PLAN_CALL_ARGS) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Unsupported parameter count for generic call (count=%d)", node->param_count);
+        nxld_metrics_record_error(shard, series);
+        return -1;
+    }
+
+    // 函数已解析，解析结果已发布 / The function is resolved, so the resolution record is published / Die Funktion ist aufgelöst, daher ist das Auflösungsergebnis veröffentlicht
+    const nxld_plan_resolved_t* resolved = load_resolved(node);
+    const nxld_param_type_t* types = resolved->param_types;
+    const nxld_plan_value_t* frame = context->frames + node->frame_offset;
+    intptr_t args[MAX_PLAN_CALL_ARGS] = {0};
+    uint64_t bytes = 0;
+    for (int p = 0; p < node->param_count; p++) {
+        if (marshal_value(&frame[p], types[p], &args[p]) != 0) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Unsupported parameter type %d for parameter %d of %s.%s", types[p], p,
+                           plan->plugins[node->plugin_index].plugin_name, node->interface_name);
+            nxld_metrics_record_error(shard, series);
+            return -1;
+        }
+        if (shard != NULL) {
+            bytes += argument_bytes(types[p], args[p]);
+        }
+    }
+
+    // 纯接口按参数值查找结果缓存，命中时不调用插件，下游纯接口得到相同参数后同样命中 / Pure interfaces look up the result cache by argument value and skip the plugin on a hit; downstream pure interfaces then receive the same arguments and hit as well / Reine Schnittstellen suchen im Ergebniscache nach Argumentwert und überspringen bei einem Treffer das Plugin; nachgelagerte reine Schnittstellen erhalten dann dieselben Argumente und treffen ebenfalls
+    nxld_memo_t* memo = resolved->memo;
+    unsigned char key[NXLD_MEMO_MAX_KEY];
+    size_t key_length = 0;
+    uint64_t key_hash = 0;
+    if (memo != NULL) {
+        if (build_memo_key(node, args, key, &key_length) != 0) {
+            memo = NULL;
+        } else {
+            key_hash = nxld_memo_hash(key, key_length);
+            uint64_t lookup = context->trace_marks != NULL ? nxld_metrics_now_ns() : 0;
+            if (nxld_memo_get(memo, key, key_length, key_hash, result)) {
+                if (lookup != 0) {
+                    uint64_t end = nxld_metrics_now_ns();
+                    trace_call(plan, node, args, *result, 1, lookup, end);
+                    if (mark_ns != NULL) {
+                        *mark_ns = lookup + (end - lookup) / 2;
+                    }
+                }
+                // 命中也计为一次调用，不计时，以免缓存命中的调用从计数中消失 / A hit still counts as an untimed call so calls served by the cache do not vanish from the counts / Ein Treffer zählt als ungemessener Aufruf, damit aus dem Cache bediente Aufrufe nicht aus den Zählungen verschwinden
+                nxld_metrics_record(shard, series, NXLD_METRICS_NO_LATENCY, bytes);
+                context->results[node_index] = *result;
+                return 0;
+            }
+        }
+    }
+
+    const nxld_plan_plugin_t* entry = &plan->plugins[node->plugin_index];
+    if (entry->bind_context != NULL) {
+        entry->bind_context(context->plugin_contexts[node->plugin_index]);
+    }
+
+    // 只在采样到的调用上读取时钟 / The clock is only read on sampled calls / Die Uhr wird nur bei abgetasteten Aufrufen gelesen
+    int timed = nxld_metrics_sample(shard, series);
+    // 只有跟踪开启时创建的上下文才有时间点缓冲区，热路径上无需调用跟踪模块 / Only contexts created while tracing have a mark buffer, so the hot path needs no call into the tracer / Nur während der Verfolgung erstellte Kontexte haben einen Zeitpunktpuffer, daher braucht der heiße Pfad keinen Aufruf in den Tracer
+    int traced = context->trace_marks != NULL;
+    uint64_t start = timed || traced ? nxld_metrics_now_ns() : 0;
+    switch (node->param_count) {
+        case 0: *result = ((plan_func0_t)function)(); break;
+        case 1: *result = ((plan_func1_t)function)(args[0]); break;
+        case 2: *result = ((plan_func2_t)function)(args[0], args[1]); break;
+        case 3: *result = ((plan_func3_t)function)(args[0], args[1], args[2]); break;
+        case 4: *result = ((plan_func4_t)function)(args[0], args[1], args[2], args[3]); break;
+        case 5: *result = ((plan_func5_t)function)(args[0], args[1], args[2], args[3], args[4]); break;
+        case 6: *result = ((plan_func6_t)function)(args[0], args[1], args[2], args[3], args[4], args[5]); break;
+        case 7: *result = ((plan_func7_t)function)(args[0], args[1], args[2], args[3], args[4], args[5], args[6]); break;
+        default: *result = ((plan_func8_t)function)(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7]); break;
+    }
+    if (timed || traced) {
+        uint64_t end = nxld_metrics_now_ns();
+        if (timed) {
+            *elapsed_ns = end - start;
+        }
+        if (traced) {
+            trace_call(plan, node, args, *result, 0, start, end);
+            if (mark_ns != NULL) {
+                *mark_ns = start + (end - start) / 2;
+            }
+        }
+    }
+    if (memo != NULL) {
+        nxld_memo_put(memo, key, key_length, key_hash, *result);
+    }
+    nxld_metrics_record(shard, series, *elapsed_ns, bytes);
+    context->results[node_index] = *result;
+    return 0;
+}
+
+/**
+ * @brief 计算已提升的谓词 / Evaluate hoisted predicate / Angehobenes Prädikat auswerten
+ * @details 只在谓词需要时才解引用数值或计算长度 / Dereferences the value or computes the length only when the predicate needs it / Dereferenziert den Wert oder berechnet die Länge nur, wenn das Prädikat es benötigt
+ */
+static int condition_met(const nxld_transfer_plan_t* plan, size_t predicate, nxld_param_type_t type, const nxld_plan_value_t* value) {
+    if (predicate == NXLD_PLAN_INVALID_INDEX) {
+        return 1;
+    }
+
+    const nxld_condition_t* condition = &plan->predicates[predicate];
+    nxld_condition_operand_t operand;
+    const void* ptr = NULL;
+    operand.value = 0;
+    operand.length = 0;
+
+    switch (value->kind) {
+        case NXLD_PLAN_VALUE_POINTER: ptr = value->data.pointer_value; break;
+        case NXLD_PLAN_VALUE_STRING: ptr = value->data.string_value; break;
+        case NXLD_PLAN_VALUE_WORD: ptr = (const void*)(intptr_t)value->data.int_value; break;
+        default: break;
+    }
+
+    // 缓冲区以数据指针判空，数值和长度均为元素数量 / Buffers are null-checked by their data pointer, value and length are the element count / Puffer werden über ihren Datenzeiger geprüft, Wert und Länge sind die Elementanzahl
+    if (type == NXLD_PARAM_TYPE_BUFFER) {
+        const nxld_buffer_t* buffer = (const nxld_buffer_t*)ptr;
+        operand.pointer = buffer != NULL ? buffer->data : NULL;
+        operand.length = buffer != NULL ? buffer->count : 0;
+        operand.value = (long long)operand.length;
+        return nxld_condition_eval(condition, &operand);
+    }
+
+    operand.pointer = ptr;
+    int is_integer = (type == NXLD_PARAM_TYPE_INT || type == NXLD_PARAM_TYPE_LONG || type == NXLD_PARAM_TYPE_CHAR);
+    if (condition->needs_value) {
+        if (value->kind == NXLD_PLAN_VALUE_POINTER && is_integer) {
+            if (ptr != NULL) {
+                operand.value = type == NXLD_PARAM_TYPE_LONG ? (long long)*(const long*)ptr :
+                                type == NXLD_PARAM_TYPE_CHAR ? (long long)*(const char*)ptr : (long long)*(const int*)ptr;
+            }
+        } else if (value->kind == NXLD_PLAN_VALUE_POINTER) {
+            operand.value = (long long)(intptr_t)ptr;
+        } else {
+            operand.value = value->data.int_value;
+        }
+    }
+    if (condition->needs_length && ptr != NULL && !is_integer) {
+        operand.length = strlen((const char*)ptr);
+    }
+
+    return nxld_condition_eval(condition, &operand);
+}
+
+/**
+ * @brief 将参数帧恢复为模板 / Reset argument frame to template / Argumentrahmen auf Vorlage zurücksetzen
+ */
+static void reset_frame(nxld_plan_context_t* context, size_t node_index) {
+    const nxld_plan_node_t* node = &context->plan->nodes[node_index];
+    nxld_plan_value_t* frame = context->frames + node->frame_offset;
+    const nxld_param_type_t* types = node_types(node);
+
+    // 释放导出接口返回的缓冲区 / Release buffers returned by export interfaces / Von Exportschnittstellen zurückgegebene Puffer freigeben
+    for (int p = 0; p < node->param_count; p++) {
+        if (types[p] == NXLD_PARAM_TYPE_BUFFER && frame[p].kind == NXLD_PLAN_VALUE_WORD) {
+            nxld_buffer_release((nxld_buffer_t*)(intptr_t)frame[p].data.int_value);
+        }
+    }
+
+    if (node->param_count > 0) {
+        memcpy(frame, node->frame_template, (size_t)node->param_count * sizeof(nxld_plan_value_t));
+    }
+    context->blocked[node_index] = 0;
+}
+
+/**
+ * @brief 流消费者线程上下文结构体 / Stream consumer thread context structure / Kontextstruktur des Stream-Verbraucher-Threads
+ */
+typedef struct {
+    nxld_plan_context_t* context;           /**< 执行上下文 / Execution context / Ausführungskontext */
+    size_t consumer;                        /**< 消费者节点索引 / Consumer node index / Verbraucherknotenindex */
+    int slot;                               /**< 接收分块的参数槽 / Slot receiving each chunk / Slot, der jeden Block erhält */
+    nxld_stream_t* stream;                  /**< 流 / Stream / Stream */
+    size_t chunk_count;                     /**< 已处理分块数量 / Processed chunk count / Anzahl verarbeiteter Blöcke */
+    int failed;                             /**< 消费者调用是否失败 / Whether a consumer call failed / Ob ein Verbraucheraufruf fehlgeschlagen ist */
+} stream_consumer_t;
+
+/**
+ * @brief 处理一个分块：调用一次消费者接口 / Handle one chunk: call the consumer interface once / Einen Block verarbeiten: die Verbraucherschnittstelle einmal aufrufen
+ */
+static void consume_chunk(void* arg, nxld_buffer_t* chunk) {
+    stream_consumer_t* ctx = (stream_consumer_t*)arg;
+    nxld_plan_value_t* frame = ctx->context->frames + ctx->context->plan->nodes[ctx->consumer].frame_offset;
+    intptr_t word = 0;
+    uint64_t elapsed = 0;
+    frame[ctx->slot].kind = NXLD_PLAN_VALUE_POINTER;
+    frame[ctx->slot].data.pointer_value = chunk;
+    if (invoke_node(ctx->context, ctx->context->stream_metrics, ctx->consumer, &word, &elapsed, NULL) != 0) {
+        ctx->failed = 1;
+    }
+    reset_frame(ctx->context, ctx->consumer);
+    ctx->chunk_count++;
+}
+
+/**
+ * @brief 流消费者线程函数 / Stream consumer thread function / Stream-Verbraucher-Thread-Funktion
+ */
+static void stream_consumer_worker(void* arg) {
+    stream_consumer_t* ctx = (stream_consumer_t*)arg;
+    nxld_buffer_t* chunk;
+    nxld_trace_thread_name("stream consumer");
+
+    while ((chunk = nxld_stream_pop(ctx->stream)) != NULL) {
+        consume_chunk(ctx, chunk);
+        nxld_stream_recycle(ctx->stream, chunk);
+    }
+}
+
+/**
+ * @brief 检查流的两端是否都为上下文感知插件 / Check whether both ends of a stream are context-aware plugins / Prüfen, ob beide Enden eines Streams kontextbewusste Plugins sind
+ * @details 两端须已解析 / Both ends must already be resolved / Beide Enden müssen bereits aufgelöst sein
+ */
+static int stream_ends_context_aware(nxld_transfer_plan_t* plan, size_t producer_index, size_t consumer_index) {
+    nxld_mutex_lock(&plan->load_mutex);
+    int aware = plan->plugins[plan->nodes[producer_index].plugin_index].bind_context != NULL &&
+                plan->plugins[plan->nodes[consumer_index].plugin_index].bind_context != NULL;
+    nxld_mutex_unlock(&plan->load_mutex);
+    return aware;
+}
+
+/**
+ * @brief 以流方式调用生产者 / Invoke producer in stream mode / Erzeuger im Stream-Modus aufrufen
+ * @details 两端都为上下文感知插件时，消费者在另一线程中逐块处理，生产者与消费者同时运行，内存占用为depth个分块；否则消费者在每次提交时于生产者线程中运行，两个插件不会同时执行，保持执行锁的串行保证 / When both ends are context-aware plugins the consumer processes chunk by chunk on another thread, so producer and consumer run concurrently with depth chunks of memory; otherwise the consumer runs on the producer thread at each commit, so the two plugins never execute at the same time and the execution lock's serialization still holds / Sind beide Enden kontextbewusste Plugins, verarbeitet der Verbraucher Block für Block in einem anderen Thread, Erzeuger und Verbraucher laufen gleichzeitig mit depth Blöcken Speicher; sonst läuft der Verbraucher bei jeder Übergabe im Erzeuger-Thread, sodass die beiden Plugins nie gleichzeitig ausführen und die Serialisierung durch die Ausführungssperre erhalten bleibt
+ */
+static int invoke_stream(nxld_plan_context_t* context, size_t producer_index, const nxld_plan_stream_t* def,
+                         intptr_t* result, uint64_t* elapsed_ns, uint64_t* mark_ns) {
+    nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_node_t* producer = &plan->nodes[producer_index];
+    const nxld_plan_node_t* consumer = &plan->nodes[def->consumer_node];
+    *elapsed_ns = NXLD_METRICS_NO_LATENCY;
+    *mark_ns = 0;
+
+    // 在启动消费者线程前解析两端，消费者线程只读取上下文缓存 / Resolve both ends before starting the consumer thread, which only reads the context cache / Beide Enden vor dem Start des Verbraucher-Threads auflösen, der nur den Kontext-Cache liest
+    if (context_function(context, producer_index) == NULL || context_function(context, def->consumer_node) == NULL) {
+        return -1;
+    }
+    if (def->producer_slot >= producer->param_count || def->consumer_slot >= consumer->param_count) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Stream slot out of range for %s -> %s", producer->interface_name, consumer->interface_name);
+        return -1;
+    }
+
+    // 消费者线程与生产者并发记录指标，使用独立分片 / The consumer thread records metrics concurrently with the producer, so it uses its own shard / Der Verbraucher-Thread erfasst Metriken gleichzeitig mit dem Erzeuger und nutzt daher einen eigenen Shard
+    if (context->metrics != NULL && context->stream_metrics == NULL) {
+        context->stream_metrics = nxld_metrics_shard_acquire(plan->metrics);
+    }
+
+    nxld_stream_t* stream = nxld_stream_create(def->chunk_bytes, def->depth);
+    if (stream == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to create stream (%zu chunks of %zu bytes)", def->depth, def->chunk_bytes);
+        return -1;
+    }
+
+    stream_consumer_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.context = context;
+    ctx.consumer = def->consumer_node;
+    ctx.slot = def->consumer_slot;
+    ctx.stream = stream;
+
+    nxld_thread_t thread;
+    int threaded = stream_ends_context_aware(plan, producer_index, def->consumer_node);
+    if (!threaded) {
+        nxld_stream_set_sink(stream, consume_chunk, &ctx);
+    } else if (nxld_thread_create(&thread, stream_consumer_worker, &ctx) != 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to start stream consumer thread for %s", consumer->interface_name);
+        nxld_stream_destroy(stream);
+        return -1;
+    }
+
+    nxld_plan_value_t* frame = context->frames + producer->frame_offset;
+    frame[def->producer_slot].kind = NXLD_PLAN_VALUE_POINTER;
+    frame[def->producer_slot].data.pointer_value = stream;
+    int status = invoke_node(context, context->metrics, producer_index, result, elapsed_ns, mark_ns);
+
+    nxld_stream_close(stream);
+    if (threaded) {
+        nxld_thread_join(thread);
+    }
+    nxld_stream_destroy(stream);
+
+    if (ctx.failed) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Stream consumer %s failed on at least one of %zu chunks", consumer->interface_name, ctx.chunk_count);
+        status = -1;
+    }
+    return status;
+}
+
+/**
+ * @brief 获取步骤调用的节点 / Get node invoked by a step / Von einem Schritt aufgerufenen Knoten abrufen
+ */
+static size_t step_invoked_node(const nxld_plan_step_t* step) {
+    return step->op == NXLD_PLAN_OP_FETCH ? step->export_node :
+           step->op == NXLD_PLAN_OP_CALL ? step->node : NXLD_PLAN_INVALID_INDEX;
+}
+
+/**
+ * @brief 预先解析路由涉及的所有节点 / Resolve all nodes used by a route up front / Alle von einer Route verwendeten Knoten vorab auflösen
+ */
+static int prepare_route(nxld_plan_context_t* context, size_t route) {
+    const nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_route_t* current = &plan->routes[route];
+    int status = 0;
+
+    for (size_t i = current->first_step; i < current->first_step + current->step_count; i++) {
+        const nxld_plan_step_t* step = &plan->steps[i];
+        size_t node = step_invoked_node(step);
+        if (node != NXLD_PLAN_INVALID_INDEX && context_function(context, node) == NULL) {
+            status = -1;
+        }
+        if (step->stream != NXLD_PLAN_INVALID_INDEX && context_function(context, plan->streams[step->stream].consumer_node) == NULL) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief 检查插件是否阻止路由并发执行 / Check whether a plugin prevents concurrent route execution / Prüfen, ob ein Plugin die gleichzeitige Routenausführung verhindert
+ * @return 上下文感知返回0，未感知返回1，尚未加载返回-1 / Returns 0 if context-aware, 1 if not, -1 if not loaded yet / Gibt 0 bei Kontextbewusstsein zurück, 1 wenn nicht, -1 wenn noch nicht geladen
+ */
+static int plugin_blocks_concurrency(const nxld_plan_plugin_t* entry) {
+    if (!entry->loaded) {
+        return entry->load_failed ? 0 : -1;
+    }
+    return entry->bind_context == NULL;
+}
+
+/**
+ * @brief 确定路由的并发模式 / Determine concurrency mode of a route / Nebenläufigkeitsmodus einer Route bestimmen
+ * @details 仍有插件未加载时保守地串行执行，且不缓存结果 / Runs serialized without caching the result while some plugin is still unloaded / Läuft serialisiert ohne Zwischenspeicherung, solange ein Plugin noch nicht geladen ist
+ * @return 可并发返回1，须串行返回0 / Returns 1 if concurrent, 0 if serialized / Gibt 1 bei Nebenläufigkeit zurück, 0 bei Serialisierung
+ */
+static int route_concurrent(nxld_plan_context_t* context, size_t route) {
+    if (context->route_mode[route] != ROUTE_MODE_UNKNOWN) {
+        return context->route_mode[route] == ROUTE_MODE_CONCURRENT;
+    }
+
+    nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_route_t* current = &plan->routes[route];
+    int unknown = 0;
+    int blocking = 0;
+
+    nxld_mutex_lock(&plan->load_mutex);
+    for (size_t i = current->first_step; i < current->first_step + current->step_count && !blocking; i++) {
+        const nxld_plan_step_t* step = &plan->steps[i];
+        size_t nodes[2];
+        nodes[0] = step_invoked_node(step);
+        nodes[1] = step->stream != NXLD_PLAN_INVALID_INDEX ? plan->streams[step->stream].consumer_node : NXLD_PLAN_INVALID_INDEX;
+        for (int k = 0; k < 2; k++) {
+            if (nodes[k] == NXLD_PLAN_INVALID_INDEX) {
+                continue;
+            }
+            int state = plugin_blocks_concurrency(&plan->plugins[plan->nodes[nodes[k]].plugin_index]);
+            if (state > 0) {
+                blocking = 1;
+            } else if (state < 0) {
+                unknown = 1;
+            }
+        }
+    }
+    nxld_mutex_unlock(&plan->load_mutex);
+
+    if (blocking) {
+        context->route_mode[route] = ROUTE_MODE_SERIAL;
+        return 0;
+    }
+    if (!unknown) {
+        context->route_mode[route] = ROUTE_MODE_CONCURRENT;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 向观察函数报告目标调用的参数 / Report target call arguments to the observer / Argumente eines Zielaufrufs an den Beobachter melden
+ * @details 参数按调用时的方式转换；无法转换的参数报告为0，调用本身随后照常报错 / Arguments are converted the way the call converts them; an argument that cannot be converted is reported as 0 and the call itself then fails as usual / Argumente werden wie beim Aufruf konvertiert; ein nicht konvertierbares Argument wird als 0 gemeldet, der Aufruf selbst schlägt danach wie gewohnt fehl
+ */
+static void observe_call(const nxld_plan_context_t* context, size_t node_index) {
+    const nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_node_t* node = &plan->nodes[node_index];
+    const nxld_plan_value_t* frame = context->frames + node->frame_offset;
+    const nxld_param_type_t* types = node_types(node);
+    intptr_t args[MAX_PLAN_CALL_ARGS] = {0};
+    for (int p = 0; p < node->param_count && p < MAX_PLAN_CALL_ARGS; p++) {
+        if (marshal_value(&frame[p], types[p], &args[p]) != 0) {
+            args[p] = 0;
+        }
+    }
+    plan->observer(plan->observer_arg, NXLD_PLAN_EVENT_CALL, node_index, args);
+}
+
+/**
+ * @brief 执行路由步骤 / Run route steps / Routenschritte ausführen
+ */
+static int run_route(nxld_plan_context_t* context, size_t route, void* param_value) {
+    const nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_route_t* current = &plan->routes[route];
+    size_t end = current->first_step + current->step_count;
+    size_t i = current->first_step;
+    int status = 0;
+
+    // 规则序列索引即规则在集合中的索引 / The rule series index is the rule's index in the set / Der Regelserienindex ist der Index der Regel im Satz
+    nxld_metrics_shard_t* shard = context->metrics;
+
+    // 源节点的时间点位于外层路由时间段内，作为源参数触发的调用的流箭头起点 / The source node's point in time lies inside the enclosing route span and starts the flow arrows of calls triggered by the source parameter / Der Zeitpunkt des Quellknotens liegt in der umgebenden Routenzeitspanne und startet die Flusspfeile der vom Quellparameter ausgelösten Aufrufe
+    uint64_t* marks = context->trace_marks;
+    if (marks != NULL) {
+        marks[current->source_node] = nxld_trace_begin();
+    }
+    if (plan->observer != NULL) {
+        intptr_t source = (intptr_t)param_value;
+        plan->observer(plan->observer_arg, NXLD_PLAN_EVENT_ROUTE_BEGIN, route, &source);
+    }
+
+    while (i < end) {
+        const nxld_plan_step_t* step = &plan->steps[i];
+        const nxld_plan_node_t* node = &plan->nodes[step->node];
+        nxld_plan_value_t* frame = context->frames + node->frame_offset;
+        nxld_plan_value_t value;
+        nxld_param_type_t type;
+        intptr_t word = 0;
+        uint64_t elapsed = 0;
+        uint64_t mark = 0;
+
+        switch (step->op) {
+            case NXLD_PLAN_OP_BIND_SOURCE:
+                type = node_types(node)[step->slot];
+                value.kind = NXLD_PLAN_VALUE_POINTER;
+                value.data.pointer_value = param_value;
+                if (condition_met(plan, step->predicate, type, &value)) {
+                    frame[step->slot] = value;
+                    if (shard != NULL) {
+                        nxld_metrics_record(shard, step->rule, NXLD_METRICS_NO_LATENCY,
+                                            argument_bytes(type, (intptr_t)param_value));
+                    }
+                } else {
+                    context->blocked[step->node] = 1;
+                    nxld_metrics_record_skip(shard, step->rule);
+                }
+                i++;
+                break;
+            case NXLD_PLAN_OP_FETCH:
+                if (invoke_node(context, shard, step->export_node, &word, &elapsed, &mark) != 0) {
+                    context->blocked[step->node] = 1;
+                    nxld_metrics_record_error(shard, step->rule);
+                    status = -1;
+                } else {
+                    if (marks != NULL) {
+                        marks[step->export_node] = mark;
+                    }
+                    type = node_types(node)[step->slot];
+                    value.kind = NXLD_PLAN_VALUE_WORD;
+                    value.data.int_value = (long long)word;
+                    if (condition_met(plan, step->predicate, type, &value)) {
+                        frame[step->slot] = value;
+                        if (shard != NULL) {
+                            nxld_metrics_record(shard, step->rule, elapsed, argument_bytes(type, word));
+                        }
+                    } else {
+                        if (type == NXLD_PARAM_TYPE_BUFFER) {
+                            nxld_buffer_release((nxld_buffer_t*)word);
+                        }
+                        context->blocked[step->node] = 1;
+                        nxld_metrics_record_skip(shard, step->rule);
+                    }
+                }
+                i++;
+                break;
+            case NXLD_PLAN_OP_CALL:
+                // 被阻断的调用已在绑定规则上计为跳过或错误；没有绑定步骤的规则在此计为跳过 / A blocked call was already counted as a skip or error on the binding rule; a rule without a binding step is counted as a skip here / Ein blockierter Aufruf wurde bereits bei der bindenden Regel als Sprung oder Fehler gezählt; eine Regel ohne Bindungsschritt wird hier als Sprung gezählt
+                if (step->guarded && context->blocked[step->node]) {
+                    if (step->counts_rule) {
+                        nxld_metrics_record_skip(shard, step->rule);
+                    }
+                    reset_frame(context, step->node);
+                    i = step->skip_to;
+                    break;
+                }
+                if (plan->observer != NULL) {
+                    observe_call(context, step->node);
+                }
+                if ((step->stream != NXLD_PLAN_INVALID_INDEX ? invoke_stream(context, step->node, &plan->streams[step->stream], &word, &elapsed, &mark)
+                                                            : invoke_node(context, shard, step->node, &word, &elapsed, &mark)) != 0) {
+                    reset_frame(context, step->node);
+                    nxld_metrics_record_error(shard, step->rule);
+                    status = -1;
+                    i = step->skip_to;
+                    break;
+                }
+                // 已在绑定时计入的规则只补充目标调用的耗时 / Rules already counted when their value was bound only get the target call duration added / Bei Regeln, die beim Binden gezählt wurden, wird nur die Dauer des Zielaufrufs ergänzt
+                if (step->counts_rule) {
+                    nxld_metrics_record(shard, step->rule, elapsed, 0);
+                } else if (elapsed != NXLD_METRICS_NO_LATENCY) {
+                    nxld_metrics_record_latency(shard, step->rule, elapsed);
+                }
+                if (marks != NULL) {
+                    nxld_trace_flow(step->trigger_node != NXLD_PLAN_INVALID_INDEX ? marks[step->trigger_node] : 0, mark);
+                    marks[step->node] = mark;
+                }
+                reset_frame(context, step->node);
+                i++;
+                break;
+            default:
+                i++;
+                break;
+        }
+    }
+
+    if (plan->observer != NULL) {
+        plan->observer(plan->observer_arg, NXLD_PLAN_EVENT_ROUTE_END, route, NULL);
+    }
+    return status;
+}
+
+nxld_plan_context_t* nxld_transfer_plan_context_create(nxld_transfer_plan_t* plan) {
+    if (plan == NULL) {
+        return NULL;
+    }
+
+    nxld_plan_context_t* context = (nxld_plan_context_t*)calloc(1, sizeof(nxld_plan_context_t));
+    if (context == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for execution context");
+        return NULL;
+    }
+
+    context->plan = plan;
+    context->frames = (nxld_plan_value_t*)calloc(plan->frame_slot_count + 1, sizeof(nxld_plan_value_t));
+    context->blocked = (unsigned char*)calloc(plan->node_count + 1, 1);
+    context->results = (intptr_t*)calloc(plan->node_count + 1, sizeof(intptr_t));
+    context->functions = (void**)calloc(plan->node_count + 1, sizeof(void*));
+    context->plugin_contexts = (void**)calloc(plan->plugin_count + 1, sizeof(void*));
+    context->route_mode = (unsigned char*)calloc(plan->route_count + 1, 1);
+    context->metrics = nxld_metrics_shard_acquire(plan->metrics);
+    // 跟踪时间点缓冲区可选，分配失败只是不画流箭头 / The trace mark buffer is optional, failing to allocate it only loses flow arrows / Der Puffer für Verfolgungszeitpunkte ist optional, scheitert die Zuweisung, fehlen nur Flusspfeile
+    if (nxld_trace_enabled()) {
+        context->trace_marks = (uint64_t*)calloc(plan->node_count + 1, sizeof(uint64_t));
+    }
+    if (context->frames == NULL || context->blocked == NULL || context->results == NULL ||
+        context->functions == NULL || context->plugin_contexts == NULL || context->route_mode == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for execution context");
+        nxld_transfer_plan_context_free(context);
+        return NULL;
+    }
+
+    for (size_t n = 0; n < plan->node_count; n++) {
+        const nxld_plan_node_t* node = &plan->nodes[n];
+        if (node->param_count > 0) {
+            memcpy(context->frames + node->frame_offset, node->frame_template, (size_t)node->param_count * sizeof(nxld_plan_value_t));
+        }
+    }
+    return context;
+}
+
+void nxld_transfer_plan_context_free(nxld_plan_context_t* context) {
+    if (context == NULL) {
+        return;
+    }
+
+    nxld_transfer_plan_t* plan = context->plan;
+    if (context->plugin_contexts != NULL) {
+        for (size_t i = 0; i < plan->plugin_count; i++) {
+            if (context->plugin_contexts[i] != NULL && plan->plugins[i].destroy_context != NULL) {
+                plan->plugins[i].destroy_context(context->plugin_contexts[i]);
+            }
+        }
+    }
+
+    free(context->frames);
+    free(context->blocked);
+    free(context->results);
+    free(context->functions);
+    free(context->plugin_contexts);
+    free(context->route_mode);
+    free(context->trace_marks);
+    nxld_metrics_shard_release(plan->metrics, context->metrics);
+    nxld_metrics_shard_release(plan->metrics, context->stream_metrics);
+    free(context);
+}
+
+/**
+ * @brief 记录路由执行的跟踪时间段 / Record the trace span of a route execution / Verfolgungszeitspanne einer Routenausführung aufzeichnen
+ */
+static void trace_route(const nxld_plan_context_t* context, size_t route, uint64_t start, int status) {
+    if (start == 0) {
+        return;
+    }
+    const nxld_transfer_plan_t* plan = context->plan;
+    const nxld_plan_route_t* current = &plan->routes[route];
+    const nxld_plan_node_t* source = &plan->nodes[current->source_node];
+    char name[NXLD_TRACE_NAME_LENGTH];
+    format_endpoint(name, sizeof(name), plan->plugins[source->plugin_index].plugin_name, source->interface_name,
+                    current->source_param_index);
+    nxld_trace_span("route", name, start, nxld_metrics_now_ns(), status == 0 ? NULL : "{\"status\":-1}");
+}
+
+int nxld_transfer_plan_execute_context(nxld_plan_context_t* context, size_t route, void* param_value) {
+    if (context == NULL || route >= context->plan->route_count) {
+        return -1;
+    }
+
+    uint64_t start = nxld_trace_begin();
+    int status;
+    if (route_concurrent(context, route)) {
+        status = run_route(context, route, param_value);
+    } else {
+        // 未感知上下文的插件把结果保存在全局变量中，整条调用链须独占执行 / Context-unaware plugins keep results in globals, so the whole chain must run exclusively / Nicht kontextbewusste Plugins halten Ergebnisse in globalen Variablen, daher muss die ganze Kette exklusiv laufen
+        nxld_mutex_lock(&context->plan->exec_mutex);
+        status = run_route(context, route, param_value);
+        nxld_mutex_unlock(&context->plan->exec_mutex);
+    }
+    trace_route(context, route, start, status);
+    return status;
+}
+
+int nxld_transfer_plan_call_context(nxld_plan_context_t* context, const char* source_plugin,
+                                    const char* source_interface, int param_index, void* param_value) {
+    if (context == NULL) {
+        return -1;
+    }
+
+    uint64_t start = nxld_trace_begin();
+    size_t route = nxld_transfer_plan_find_route(context->plan, source_plugin, source_interface, param_index);
+    if (start != 0) {
+        char endpoint[NXLD_TRACE_NAME_LENGTH];
+        format_endpoint(endpoint, sizeof(endpoint), source_plugin, source_interface, param_index);
+        nxld_trace_end("match", "match route", start, endpoint);
+    }
+    if (route == NXLD_PLAN_INVALID_INDEX) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "No execution plan route for %s.%s[%d]",
+                         source_plugin != NULL ? source_plugin : "NULL",
+                         source_interface != NULL ? source_interface : "NULL", param_index);
+        return -1;
+    }
+    return nxld_transfer_plan_execute_context(context, route, param_value);
+}
+
+int nxld_transfer_plan_execute(nxld_transfer_plan_t* plan, size_t route, void* param_value) {
+    if (plan == NULL) {
+        return -1;
+    }
+    return nxld_transfer_plan_execute_context(plan->default_context, route, param_value);
+}
+
+int nxld_transfer_plan_call(nxld_transfer_plan_t* plan, const char* source_plugin,
+                            const char* source_interface, int param_index, void* param_value) {
+    if (plan == NULL) {
+        return -1;
+    }
+    return nxld_transfer_plan_call_context(plan->default_context, source_plugin, source_interface, param_index, param_value);
+}
+
+/**
+ * @brief 释放批量调用的路由数组 / Free the route array of a batch call / Routen-Array eines Stapelaufrufs freigeben
+ */
+static void free_batch_routes(size_t* routes, size_t* local_routes) {
+    if (routes != local_routes) {
+        free(routes);
+    }
+}
+
+int nxld_transfer_plan_call_batch_context(nxld_plan_context_t* context, const char* source_plugin,
+                                          const char* source_interface, int first_param_index, void* const* tuples,
+                                          size_t tuple_size, size_t tuple_count, int* statuses) {
+    if (context == NULL || first_param_index < 0 || (tuples == NULL && tuple_count > 0) || tuple_size == 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Invalid parameters for batch call");
+        return -1;
+    }
+
+    // 常见的短元组不分配内存 / Common short tuples need no allocation / Übliche kurze Tupel brauchen keine Zuweisung
+    size_t local_routes[BATCH_LOCAL_ROUTES];
+    size_t* routes = tuple_size <= BATCH_LOCAL_ROUTES ? local_routes : (size_t*)malloc(tuple_size * sizeof(size_t));
+    if (routes == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for batch call");
+        return -1;
+    }
+
+    // 每批只查找和准备一次路由，并确定是否须独占执行 / Look up and prepare routes and decide on exclusive execution once per batch / Routen suchen, vorbereiten und über exklusive Ausführung entscheiden, einmal pro Stapel
+    size_t route_count = 0;
+    int serial = 0;
+    for (size_t j = 0; j < tuple_size; j++) {
+        int param_index = first_param_index + (int)j;
+        routes[j] = nxld_transfer_plan_find_route(context->plan, source_plugin, source_interface, param_index);
+        if (routes[j] == NXLD_PLAN_INVALID_INDEX) {
+            continue;
+        }
+        if (prepare_route(context, routes[j]) != 0) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to prepare route for %s.%s[%d], batch aborted",
+                           source_plugin != NULL ? source_plugin : "NULL",
+                           source_interface != NULL ? source_interface : "NULL", param_index);
+            free_batch_routes(routes, local_routes);
+            return -1;
+        }
+        if (!route_concurrent(context, routes[j])) {
+            serial = 1;
+        }
+        route_count++;
+    }
+
+    if (route_count == 0) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "No execution plan route for %s.%s, batch of %zu tuples ignored",
+                         source_plugin != NULL ? source_plugin : "NULL",
+                         source_interface != NULL ? source_interface : "NULL", tuple_count);
+        free_batch_routes(routes, local_routes);
+        return -1;
+    }
+
+    // 有任一路由须串行时整批持有执行锁，而不是每个元组加锁一次 / If any route must be serialized the execution lock is held for the whole batch instead of once per tuple / Muss eine Route serialisiert werden, wird die Ausführungssperre für den ganzen Stapel statt einmal pro Tupel gehalten
+    if (serial) {
+        nxld_mutex_lock(&context->plan->exec_mutex);
+    }
+    size_t failed = 0;
+    for (size_t t = 0; t < tuple_count; t++) {
+        void* const* tuple = tuples + t * tuple_size;
+        int tuple_status = 0;
+        for (size_t j = 0; j < tuple_size; j++) {
+            if (routes[j] == NXLD_PLAN_INVALID_INDEX) {
+                continue;
+            }
+            uint64_t start = nxld_trace_begin();
+            int status = run_route(context, routes[j], tuple[j]);
+            trace_route(context, routes[j], start, status);
+            if (status != 0) {
+                tuple_status = -1;
+            }
+        }
+        if (statuses != NULL) {
+            statuses[t] = tuple_status;
+        }
+        if (tuple_status != 0) {
+            failed++;
+        }
+    }
+    if (serial) {
+        nxld_mutex_unlock(&context->plan->exec_mutex);
+    }
+
+    free_batch_routes(routes, local_routes);
+    if (failed > 0) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Batch call %s.%s: %zu of %zu tuples failed",
+                         source_plugin != NULL ? source_plugin : "NULL",
+                         source_interface != NULL ? source_interface : "NULL", failed, tuple_count);
+        return -1;
+    }
+    return 0;
+}
+
+int nxld_transfer_plan_call_batch(nxld_transfer_plan_t* plan, const char* source_plugin, const char* source_interface,
+                                  int first_param_index, void* const* tuples, size_t tuple_size, size_t tuple_count,
+                                  int* statuses) {
+    if (plan == NULL) {
+        return -1;
+    }
+    return nxld_transfer_plan_call_batch_context(plan->default_context, source_plugin, source_interface,
+                                                 first_param_index, tuples, tuple_size, tuple_count, statuses);
+}
+
+/**
+ * @brief 预热遍历状态结构体 / Warm-up walk state structure / Zustandsstruktur des Aufwärmdurchlaufs
+ */
+typedef struct {
+    const nxld_transfer_plan_t* plan;       /**< 计划 / Plan / Plan */
+    size_t* order;                          /**< 输出节点顺序 / Output node order / Ausgabe-Knotenreihenfolge */
+    size_t count;                           /**< 输出节点数量 / Output node count / Anzahl ausgegebener Knoten */
+    unsigned char* node_seen;               /**< 节点是否已输出 / Whether node was emitted / Ob Knoten ausgegeben wurde */
+    unsigned char* plugin_reached;          /**< 插件是否已可达 / Whether plugin is reachable / Ob Plugin erreichbar ist */
+    size_t* plugin_first_route;             /**< 以插件为源的第一条路由 / First route with the plugin as source / Erste Route mit dem Plugin als Quelle */
+    size_t* route_next;                     /**< 同一源插件的下一条路由 / Next route with the same source plugin / Nächste Route mit demselben Quell-Plugin */
+    size_t* queue;                          /**< 路由队列 / Route queue / Routenwarteschlange */
+    size_t queue_tail;                      /**< 队列尾 / Queue tail / Warteschlangenende */
+    unsigned char* route_queued;            /**< 路由是否已入队 / Whether route was queued / Ob Route eingereiht wurde */
+} warmup_walk_t;
+
+/**
+ * @brief 将路由加入遍历队列 / Queue route for the walk / Route für den Durchlauf einreihen
+ */
+static void walk_queue_route(warmup_walk_t* walk, size_t route) {
+    if (!walk->route_queued[route]) {
+        walk->route_queued[route] = 1;
+        walk->queue[walk->queue_tail++] = route;
+    }
+}
+
+/**
+ * @brief 标记插件可达并加入其路由 / Mark plugin reachable and queue its routes / Plugin als erreichbar markieren und seine Routen einreihen
+ * @details 被调用的插件可能以自身接口调用CallPlugin，因此其路由也被视为可达 / A called plugin may invoke CallPlugin with its own interfaces, so its routes count as reachable too / Ein aufgerufenes Plugin kann CallPlugin mit eigenen Schnittstellen aufrufen, daher gelten auch seine Routen als erreichbar
+ */
+static void walk_reach_plugin(warmup_walk_t* walk, size_t plugin_index) {
+    if (walk->plugin_reached[plugin_index]) {
+        return;
+    }
+    walk->plugin_reached[plugin_index] = 1;
+    for (size_t r = walk->plugin_first_route[plugin_index]; r != NXLD_PLAN_INVALID_INDEX; r = walk->route_next[r]) {
+        walk_queue_route(walk, r);
+    }
+}
+
+/**
+ * @brief 收集预热节点顺序 / Collect warm-up node order / Aufwärm-Knotenreihenfolge sammeln
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details predictive从入口插件的路由出发广度优先遍历，按首次可能调用的顺序输出节点；eager或没有入口路由时从所有路由出发 / predictive walks breadth-first from the entry plugin's routes and emits nodes in the order they may first be called; eager, or a plan without an entry route, starts from every route / predictive durchläuft ab den Routen des Einstiegs-Plugins in Breitensuche und gibt Knoten in der Reihenfolge ihres möglichen ersten Aufrufs aus; eager oder ein Plan ohne Einstiegsroute beginnt bei allen Routen
+ */
+static int collect_warmup_nodes(nxld_transfer_plan_t* plan, nxld_warmup_policy_t policy) {
+    warmup_walk_t walk;
+    memset(&walk, 0, sizeof(walk));
+    walk.plan = plan;
+    walk.order = (size_t*)malloc((plan->node_count + 1) * sizeof(size_t));
+    walk.node_seen = (unsigned char*)calloc(plan->node_count + 1, 1);
+    walk.plugin_reached = (unsigned char*)calloc(plan->plugin_count + 1, 1);
+    walk.plugin_first_route = (size_t*)malloc((plan->plugin_count + 1) * sizeof(size_t));
+    walk.route_next = (size_t*)malloc((plan->route_count + 1) * sizeof(size_t));
+    walk.queue = (size_t*)malloc((plan->route_count + 1) * sizeof(size_t));
+    walk.route_queued = (unsigned char*)calloc(plan->route_count + 1, 1);
+
+    int result = -1;
+    if (walk.order != NULL && walk.node_seen != NULL && walk.plugin_reached != NULL && walk.plugin_first_route != NULL &&
+        walk.route_next != NULL && walk.queue != NULL && walk.route_queued != NULL) {
+        for (size_t p = 0; p < plan->plugin_count; p++) {
+            walk.plugin_first_route[p] = NXLD_PLAN_INVALID_INDEX;
+        }
+        for (size_t r = plan->route_count; r-- > 0;) {
+            size_t plugin_index = plan->nodes[plan->routes[r].source_node].plugin_index;
+            walk.route_next[r] = walk.plugin_first_route[plugin_index];
+            walk.plugin_first_route[plugin_index] = r;
+        }
+
+        if (policy == NXLD_WARMUP_PREDICTIVE && plan->entry_route != NXLD_PLAN_INVALID_INDEX) {
+            walk_queue_route(&walk, plan->entry_route);
+            walk_reach_plugin(&walk, plan->nodes[plan->routes[plan->entry_route].source_node].plugin_index);
+        } else {
+            for (size_t r = 0; r < plan->route_count; r++) {
+                walk_queue_route(&walk, r);
+            }
+        }
+
+        for (size_t head = 0; head < walk.queue_tail; head++) {
+            const nxld_plan_route_t* route = &plan->routes[walk.queue[head]];
+            for (size_t i = route->first_step; i < route->first_step + route->step_count; i++) {
+                const nxld_plan_step_t* step = &plan->steps[i];
+                size_t nodes[2];
+                nodes[0] = step_invoked_node(step);
+                nodes[1] = step->stream != NXLD_PLAN_INVALID_INDEX ? plan->streams[step->stream].consumer_node : NXLD_PLAN_INVALID_INDEX;
+                for (int k = 0; k < 2; k++) {
+                    if (nodes[k] == NXLD_PLAN_INVALID_INDEX || walk.node_seen[nodes[k]]) {
+                        continue;
+                    }
+                    walk.node_seen[nodes[k]] = 1;
+                    walk.order[walk.count++] = nodes[k];
+                    walk_reach_plugin(&walk, plan->nodes[nodes[k]].plugin_index);
+                }
+            }
+        }
+
+        free(plan->warmup_order);
+        plan->warmup_order = walk.order;
+        plan->warmup_count = walk.count;
+        walk.order = NULL;
+        result = 0;
+    }
+
+    free(walk.order);
+    free(walk.node_seen);
+    free(walk.plugin_reached);
+    free(walk.plugin_first_route);
+    free(walk.route_next);
+    free(walk.queue);
+    free(walk.route_queued);
+    return result;
+}
+
+/**
+ * @brief 按收集的顺序预热节点 / Warm nodes in the collected order / Knoten in der gesammelten Reihenfolge aufwärmen
+ * @details 每个节点单独加锁，调用方只在需要同一把锁时等待单个节点；预热只发布尚未解析节点的解析结果并预先访问代码页，不改写已发布的状态 / Locks per node so callers wait for at most one node when they need the same lock; warm-up only publishes resolution records of unresolved nodes and faults in code pages, never rewriting published state / Sperrt je Knoten, sodass Aufrufer höchstens auf einen Knoten warten, wenn sie dieselbe Sperre brauchen; das Aufwärmen veröffentlicht nur Auflösungsergebnisse noch nicht aufgelöster Knoten und liest Codeseiten vorab ein, ohne veröffentlichten Zustand zu überschreiben
+ */
+static void run_warmup(nxld_transfer_plan_t* plan) {
+    size_t loaded_plugins = 0;
+    size_t resolved_nodes = 0;
+    size_t touched_pages = 0;
+
+    for (size_t i = 0; i < plan->warmup_count; i++) {
+        nxld_plan_node_t* node = &plan->nodes[plan->warmup_order[i]];
+        nxld_plan_plugin_t* entry = &plan->plugins[node->plugin_index];
+
+        nxld_mutex_lock(&plan->load_mutex);
+        if (plan->warmup_cancel) {
+            nxld_mutex_unlock(&plan->load_mutex);
+            break;
+        }
+        int was_loaded = entry->loaded;
+        if (resolve_node(plan, node) == 0) {
+            resolved_nodes++;
+        }
+        int newly_loaded = !was_loaded && entry->loaded;
+        nxld_mutex_unlock(&plan->load_mutex);
+
+        // 插件只在计划释放时卸载，释放前会等待预热线程 / Plugins are only unloaded when the plan is freed, which waits for the warm-up thread / Plugins werden erst beim Freigeben des Plans entladen, das auf den Aufwärm-Thread wartet
+        if (newly_loaded) {
+            loaded_plugins++;
+            touched_pages += nxld_plugin_prefault(&entry->plugin);
+        }
+    }
+
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Warm-up finished: %zu plugins loaded, %zu of %zu interfaces resolved, %zu pages faulted in",
+                  loaded_plugins, resolved_nodes, plan->warmup_count, touched_pages);
+}
+
+/**
+ * @brief 后台预热线程函数 / Background warm-up thread function / Hintergrund-Aufwärm-Thread-Funktion
+ */
+static void warmup_worker(void* arg) {
+    nxld_trace_thread_name("plugin warm-up");
+    run_warmup((nxld_transfer_plan_t*)arg);
+}
+
+int nxld_transfer_plan_warmup(nxld_transfer_plan_t* plan, nxld_warmup_policy_t policy) {
+    if (plan == NULL || plan->warmup_running) {
+        return -1;
+    }
+    if (policy == NXLD_WARMUP_LAZY) {
+        return 0;
+    }
+
+    if (collect_warmup_nodes(plan, policy) != 0) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed while collecting warm-up nodes");
+        return -1;
+    }
+
+    if (policy == NXLD_WARMUP_EAGER) {
+        run_warmup(plan);
+        return 0;
+    }
+
+    if (nxld_thread_create(&plan->warmup_thread, warmup_worker, plan) != 0) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_DISPATCH, "Failed to start warm-up thread, plugins will load on first call");
+        return -1;
+    }
+    plan->warmup_running = 1;
+    return 0;
+}
+
+void nxld_transfer_plan_warmup_wait(nxld_transfer_plan_t* plan) {
+    if (plan != NULL && plan->warmup_running) {
+        nxld_thread_join(plan->warmup_thread);
+        plan->warmup_running = 0;
+    }
+}
+
+void nxld_transfer_plan_set_observer(nxld_transfer_plan_t* plan, nxld_plan_observer_t observer, void* arg) {
+    if (plan == NULL) {
+        return;
+    }
+    plan->observer = observer;
+    plan->observer_arg = arg;
+}
+
+int nxld_transfer_plan_get_rule_metrics(const nxld_transfer_plan_t* plan, size_t rule, nxld_metrics_series_t* out) {
+    if (plan == NULL || rule >= plan->metrics_rule_count) {
+        return -1;
+    }
+    return nxld_metrics_snapshot(plan->metrics, rule, out);
+}
+
+int nxld_transfer_plan_get_interface_metrics(const nxld_transfer_plan_t* plan, size_t node, nxld_metrics_series_t* out) {
+    if (plan == NULL || node >= plan->node_count) {
+        return -1;
+    }
+    return nxld_metrics_snapshot(plan->metrics, plan->metrics_rule_count + node, out);
+}
+
+int nxld_transfer_plan_get_interface_cache_stats(const nxld_transfer_plan_t* plan, size_t node, nxld_memo_stats_t* out) {
+    if (plan == NULL || out == NULL || node >= plan->node_count) {
+        return -1;
+    }
+
+    // 缓存随解析结果一同发布 / The cache is published with the resolution record / Der Cache wird mit dem Auflösungsergebnis veröffentlicht
+    const nxld_plan_resolved_t* resolved = load_resolved(&plan->nodes[node]);
+    nxld_memo_t* memo = resolved != NULL ? resolved->memo : NULL;
+    if (memo == NULL) {
+        return -1;
+    }
+    nxld_memo_get_stats(memo, out);
+    return 0;
+}
+
+const nxld_param_type_t* nxld_transfer_plan_get_param_types(const nxld_transfer_plan_t* plan, size_t node) {
+    if (plan == NULL || node >= plan->node_count) {
+        return NULL;
+    }
+    return node_types(&plan->nodes[node]);
+}
+
+/**
+ * @brief 写出JSON字符串 / Write JSON string / JSON-Zeichenfolge schreiben
+ */
+static void write_json_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const unsigned char* p = (const unsigned char*)(text != NULL ? text : ""); *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(file, "\\%c", *p);
+        } else if (*p < 0x20) {
+            fprintf(file, "\\u%04x", *p);
+        } else {
+            fputc(*p, file);
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ * @brief 写出规则端点（插件.接口[参数]） / Write rule endpoint (plugin.interface[param]) / Regelendpunkt schreiben (Plugin.Schnittstelle[Parameter])
+ */
+static void write_json_endpoint(FILE* file, const char* plugin, const char* interface_name, int param_index) {
+    char endpoint[NXLD_STRING_INDEX_MAX_KEY];
+    snprintf(endpoint, sizeof(endpoint), "%s.%s[%d]", plugin != NULL ? plugin : "",
+             interface_name != NULL ? interface_name : "", param_index);
+    write_json_string(file, endpoint);
+}
+
+int nxld_transfer_plan_dump_metrics(const nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules, const char* path) {
+    if (plan == NULL || rules == NULL || path == NULL || plan->metrics == NULL) {
+        return -1;
+    }
+
+    char temp_path[MAX_PATH_LENGTH];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Metrics path too long: %s", path);
+        return -1;
+    }
+    FILE* file = fopen(temp_path, "w");
+    if (file == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to open metrics file: %s", temp_path);
+        return -1;
+    }
+
+    nxld_metrics_series_t* series = (nxld_metrics_series_t*)malloc(sizeof(nxld_metrics_series_t));
+    if (series == NULL) {
+        fclose(file);
+        remove(temp_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Memory allocation failed for metrics snapshot");
+        return -1;
+    }
+
+    fprintf(file, "{\n  \"rules\": [");
+    int first = 1;
+    size_t rule_count = rules->rule_count < plan->metrics_rule_count ? rules->rule_count : plan->metrics_rule_count;
+    for (size_t r = 0; r < rule_count; r++) {
+        if (nxld_metrics_snapshot(plan->metrics, r, series) != 0 ||
+            (series->calls == 0 && series->errors == 0 && series->skips == 0)) {
+            continue;
+        }
+        const nxld_transfer_rule_t* rule = &rules->rules[r];
+        fprintf(file, "%s\n    {\"file\": ", first ? "" : ",");
+        write_json_string(file, rule->file_index < rules->loaded_file_count ? rules->loaded_files[rule->file_index] : NULL);
+        fprintf(file, ", \"index\": %zu, \"source\": ", rule->rule_index);
+        write_json_endpoint(file, rule->source_plugin, rule->source_interface, rule->source_param_index);
+        fprintf(file, ", \"target\": ");
+        write_json_endpoint(file, rule->target_plugin, rule->target_interface, rule->target_param_index);
+        fprintf(file, ", ");
+        nxld_metrics_write_json(file, series);
+        fprintf(file, "}");
+        first = 0;
+    }
+
+    fprintf(file, "\n  ],\n  \"interfaces\": [");
+    first = 1;
+    for (size_t n = 0; n < plan->node_count; n++) {
+        if (nxld_transfer_plan_get_interface_metrics(plan, n, series) != 0 || (series->calls == 0 && series->errors == 0)) {
+            continue;
+        }
+        const nxld_plan_node_t* node = &plan->nodes[n];
+        fprintf(file, "%s\n    {\"plugin\": ", first ? "" : ",");
+        write_json_string(file, plan->plugins[node->plugin_index].plugin_name);
+        fprintf(file, ", \"interface\": ");
+        write_json_string(file, node->interface_name);
+        fprintf(file, ", ");
+        nxld_metrics_write_json(file, series);
+        nxld_memo_stats_t cache;
+        if (nxld_transfer_plan_get_interface_cache_stats(plan, n, &cache) == 0) {
+            fprintf(file, ", \"cache\": {\"hits\": %llu, \"misses\": %llu, \"evictions\": %llu, \"entries\": %zu, \"capacity\": %zu}",
+                    (unsigned long long)cache.hits, (unsigned long long)cache.misses,
+                    (unsigned long long)cache.evictions, cache.entries, cache.capacity);
+        }
+        fprintf(file, "}");
+        first = 0;
+    }
+    fprintf(file, "\n  ]\n}\n");
+    free(series);
+
+    int failed = ferror(file);
+    if (fclose(file) != 0 || failed) {
+        remove(temp_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to write metrics file: %s", temp_path);
+        return -1;
+    }
+#ifdef _WIN32
+    // Windows上rename不覆盖已有文件 / rename does not replace an existing file on Windows / rename ersetzt unter Windows keine vorhandene Datei
+    remove(path);
+#endif
+    if (rename(temp_path, path) != 0) {
+        remove(temp_path);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_DISPATCH, "Failed to replace metrics file: %s", path);
+        return -1;
+    }
+    return 0;
+}
+
+void nxld_transfer_plan_free(nxld_transfer_plan_t* plan) {
+    if (plan == NULL) {
+        return;
+    }
+
+    if (plan->warmup_running) {
+        nxld_mutex_lock(&plan->load_mutex);
+        plan->warmup_cancel = 1;
+        nxld_mutex_unlock(&plan->load_mutex);
+        nxld_transfer_plan_warmup_wait(plan);
+    }
+
+    // 插件上下文须在插件卸载前销毁 / Plugin contexts must be destroyed before the plugins are unloaded / Plugin-Kontexte müssen vor dem Entladen der Plugins zerstört werden
+    nxld_transfer_plan_context_free(plan->default_context);
+    plan->default_context = NULL;
+    nxld_metrics_destroy(plan->metrics);
+    plan->metrics = NULL;
+
+    if (plan->nodes != NULL) {
+        for (size_t n = 0; n < plan->node_count; n++) {
+            nxld_plan_node_t* node = &plan->nodes[n];
+            if (node->frame_template != NULL) {
+                for (int p = 0; p < node->param_count; p++) {
+                    if (node->frame_template[p].kind == NXLD_PLAN_VALUE_STRING) {
+                        free((void*)node->frame_template[p].data.string_value);
+                    }
+                }
+            }
+            nxld_plan_resolved_t* resolved = node->resolved;
+            if (resolved != NULL && resolved->memo != NULL) {
+                nxld_memo_stats_t stats;
+                nxld_memo_get_stats(resolved->memo, &stats);
+                NXLD_LOG_INFO(NXLD_LOG_MODULE_DISPATCH, "Result cache of %s.%s: %llu hits, %llu misses, %llu evictions",
+                              plan->plugins[node->plugin_index].plugin_name, node->interface_name,
+                              (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+                              (unsigned long long)stats.evictions);
+                nxld_memo_destroy(resolved->memo);
+            }
+            if (resolved != NULL) {
+                if (resolved->param_types != node->param_types) {
+                    free(resolved->param_types);
+                }
+                free(resolved);
+            }
+            free(node->interface_name);
+            free(node->param_types);
+            free(node->frame_template);
+        }
+        free(plan->nodes);
+    }
+
+    if (plan->plugins != NULL) {
+        for (size_t i = 0; i < plan->plugin_count; i++) {
+            if (plan->plugins[i].loaded) {
+                nxld_plugin_free(&plan->plugins[i].plugin);
+            }
+            nxld_plugin_free(&plan->plugins[i].metadata);
+            free(plan->plugins[i].plugin_name);
+            free(plan->plugins[i].plugin_path);
+        }
+        free(plan->plugins);
+    }
+
+    free(plan->node_order);
+    free(plan->streams);
+    free(plan->predicates);
+    free(plan->steps);
+    free(plan->routes);
+    free(plan->warmup_order);
+    nxld_string_index_free(&plan->route_lookup);
+    if (plan->sync_initialized) {
+        nxld_mutex_destroy(&plan->exec_mutex);
+        nxld_mutex_destroy(&plan->load_mutex);
+    }
+    memset(plan, 0, sizeof(nxld_transfer_plan_t));
+    plan->entry_route = NXLD_PLAN_INVALID_INDEX;
+}
+
+const char* nxld_transfer_plan_get_error_message(nxld_transfer_plan_result_t result) {
+    switch (result) {
+        case NXLD_TRANSFER_PLAN_SUCCESS:
+            return "Execution plan compiled successfully";
+        case NXLD_TRANSFER_PLAN_CYCLE:
+            return "Transfer rule graph contains a cycle";
+        case NXLD_TRANSFER_PLAN_MEMORY_ERROR:
+            return "Memory allocation error";
+        default:
+            return "Unknown error";
+    }
+}
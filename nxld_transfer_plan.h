@@ -0,0 +1,399 @@
+/**
+ * @file nxld_transfer_plan.h
+ * @brief NXLD传递执行计划接口 / NXLD Transfer Execution Plan Interface / NXLD-Übertragungs-Ausführungsplan-Schnittstelle
+ * @details 在首次调用前将链式加载的.nxpt规则图编译为静态执行计划 / Compiles the chain-loaded .nxpt rule graph into a static execution plan before the first call / Kompiliert den kettenweise geladenen .nxpt-Regelgraphen vor dem ersten Aufruf in einen statischen Ausführungsplan
+ */
+
+#ifndef NXLD_TRANSFER_PLAN_H
+#define NXLD_TRANSFER_PLAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nxld_plugin.h"
+#include "nxld_transfer_rules.h"
+#include "nxld_thread.h"
+#include "nxld_metrics.h"
+#include "nxld_memo.h"
+
+/**
+ * @brief 无效索引 / Invalid index / Ungültiger Index
+ */
+#define NXLD_PLAN_INVALID_INDEX ((size_t)-1)
+
+/**
+ * @brief 计划值类型枚举 / Plan value kind enumeration / Planwert-Art-Aufzählung
+ */
+typedef enum {
+    NXLD_PLAN_VALUE_NONE = 0,              /**< 未绑定 / Unbound / Nicht gebunden */
+    NXLD_PLAN_VALUE_INT,                   /**< 预解析的整数常量 / Pre-parsed integer constant / Vorab geparste Ganzzahlkonstante */
+    NXLD_PLAN_VALUE_STRING,                /**< 字符串常量 / String constant / Zeichenfolgenkonstante */
+    NXLD_PLAN_VALUE_POINTER,               /**< 传递的指针 / Transferred pointer / Übertragener Zeiger */
+    NXLD_PLAN_VALUE_WORD                   /**< 导出接口返回的原始值 / Raw value returned by export interface / Rohwert der Exportschnittstelle */
+} nxld_plan_value_kind_t;
+
+/**
+ * @brief 计划值结构体 / Plan value structure / Planwert-Struktur
+ */
+typedef struct {
+    nxld_plan_value_kind_t kind;            /**< 值类型 / Value kind / Wertart */
+    union {
+        long long int_value;                /**< 整数或原始返回值 / Integer or raw return value / Ganzzahl oder Rohrückgabewert */
+        const char* string_value;           /**< 字符串常量 / String constant / Zeichenfolgenkonstante */
+        void* pointer_value;                /**< 指针值 / Pointer value / Zeigerwert */
+    } data;                                 /**< 值数据 / Value data / Wertdaten */
+} nxld_plan_value_t;
+
+/**
+ * @brief 计划插件条目结构体 / Plan plugin entry structure / Plan-Plugin-Eintragsstruktur
+ */
+typedef struct {
+    char* plugin_name;                      /**< 插件名称 / Plugin name / Plugin-Name */
+    char* plugin_path;                      /**< 已解析插件路径（可能为NULL） / Resolved plugin path (may be NULL) / Aufgelöster Plugin-Pfad (kann NULL sein) */
+    nxld_plugin_t plugin;                   /**< 延迟加载的插件 / Lazily loaded plugin / Verzögert geladenes Plugin */
+    nxld_plugin_t metadata;                 /**< 从.nxp读取的元数据 / Metadata read from .nxp / Aus .nxp gelesene Metadaten */
+    int loaded;                             /**< 是否已加载 / Whether loaded / Ob geladen */
+    int load_failed;                        /**< 是否加载失败 / Whether loading failed / Ob Laden fehlgeschlagen ist */
+    nxld_plugin_create_context_func create_context;    /**< 上下文创建函数（可选） / Context create function (optional) / Kontext-Erstellungsfunktion (optional) */
+    nxld_plugin_destroy_context_func destroy_context;  /**< 上下文销毁函数（可选） / Context destroy function (optional) / Kontext-Zerstörungsfunktion (optional) */
+    nxld_plugin_bind_context_func bind_context;        /**< 上下文绑定函数（可选） / Context bind function (optional) / Kontext-Bindungsfunktion (optional) */
+} nxld_plan_plugin_t;
+
+/**
+ * @brief 节点解析结果结构体 / Node resolution record structure / Struktur des Knotenauflösungsergebnisses
+ * @details 插件加载后构建一次并以释放语义发布，之后不再修改 / Built once after the plugin is loaded and published with release semantics, never changed afterwards / Einmal nach dem Laden des Plugins erstellt und mit Release-Semantik veröffentlicht, danach nie geändert
+ */
+typedef struct {
+    void* function;                         /**< 接口函数 / Interface function / Schnittstellenfunktion */
+    nxld_param_type_t* param_types;         /**< 与已加载插件核对后的参数类型（与编译时相同则共用节点的数组） / Parameter types checked against the loaded plugin (shares the node's array when unchanged from compile time) / Mit dem geladenen Plugin abgeglichene Parametertypen (teilt das Array des Knotens, wenn seit dem Kompilieren unverändert) */
+    nxld_memo_t* memo;                      /**< 纯接口的结果缓存（无缓存时为NULL） / Result cache of a pure interface (NULL without cache) / Ergebniscache einer reinen Schnittstelle (NULL ohne Cache) */
+} nxld_plan_resolved_t;
+
+/**
+ * @brief 计划节点结构体（一个插件接口） / Plan node structure (one plugin interface) / Planknoten-Struktur (eine Plugin-Schnittstelle)
+ */
+typedef struct {
+    size_t plugin_index;                    /**< 插件条目索引 / Plugin entry index / Plugin-Eintragsindex */
+    char* interface_name;                   /**< 接口名称 / Interface name / Schnittstellenname */
+    int param_count;                        /**< 参数帧槽数量 / Argument frame slot count / Anzahl der Argumentrahmen-Slots */
+    nxld_param_type_t* param_types;         /**< 编译时的参数类型数组，解析后以resolved为准 / Compile-time parameter type array, superseded by resolved once set / Parametertyp-Array zur Kompilierzeit, nach dem Auflösen gilt resolved */
+    nxld_plan_value_t* frame_template;      /**< 预绑定常量的参数帧模板 / Argument frame template with pre-bound constants / Argumentrahmen-Vorlage mit vorab gebundenen Konstanten */
+    size_t frame_offset;                    /**< 在执行上下文参数帧中的偏移 / Offset into the execution context frames / Versatz in den Rahmen des Ausführungskontexts */
+    nxld_plan_resolved_t* resolved;         /**< 解析结果，写入须持有load_mutex，读取用获取语义（未解析时为NULL） / Resolution record, written under load_mutex and read with acquire semantics (NULL until resolved) / Auflösungsergebnis, unter load_mutex geschrieben und mit Acquire-Semantik gelesen (NULL bis aufgelöst) */
+} nxld_plan_node_t;
+
+/**
+ * @brief 计划指令枚举 / Plan operation enumeration / Plan-Operations-Aufzählung
+ */
+typedef enum {
+    NXLD_PLAN_OP_BIND_SOURCE = 0,          /**< 将调用值绑定到目标槽 / Bind invocation value to target slot / Aufrufwert an Ziel-Slot binden */
+    NXLD_PLAN_OP_FETCH,                    /**< 调用导出接口并绑定返回值 / Call export interface and bind its return value / Exportschnittstelle aufrufen und Rückgabewert binden */
+    NXLD_PLAN_OP_CALL                      /**< 调用参数已就绪的接口 / Call interface whose arguments are ready / Schnittstelle mit bereiten Argumenten aufrufen */
+} nxld_plan_op_t;
+
+/**
+ * @brief 计划步骤结构体 / Plan step structure / Planschritt-Struktur
+ */
+typedef struct {
+    nxld_plan_op_t op;                      /**< 指令 / Operation / Operation */
+    size_t node;                            /**< 目标或被调用节点索引 / Target or called node index / Index des Ziel- oder aufgerufenen Knotens */
+    int slot;                               /**< 目标参数槽 / Target argument slot / Ziel-Argument-Slot */
+    size_t export_node;                     /**< 导出接口节点索引（FETCH） / Export interface node index (FETCH) / Index des Exportschnittstellenknotens (FETCH) */
+    size_t predicate;                       /**< 已提升的谓词索引（BIND_SOURCE/FETCH，无条件时为NXLD_PLAN_INVALID_INDEX） / Hoisted predicate index (BIND_SOURCE/FETCH, NXLD_PLAN_INVALID_INDEX without condition) / Index des angehobenen Prädikats (BIND_SOURCE/FETCH, NXLD_PLAN_INVALID_INDEX ohne Bedingung) */
+    int guarded;                            /**< 调用是否依赖条件绑定或取值调用（CALL） / Whether the call depends on a conditional binding or a fetch call (CALL) / Ob der Aufruf von einer bedingten Bindung oder einem Abrufaufruf abhängt (CALL) */
+    size_t skip_to;                         /**< 调用被阻断时跳转的步骤（CALL） / Step to jump to when the call is blocked (CALL) / Schritt, zu dem bei blockiertem Aufruf gesprungen wird (CALL) */
+    size_t stream;                          /**< 流定义索引（CALL，无流时为NXLD_PLAN_INVALID_INDEX） / Stream definition index (CALL, NXLD_PLAN_INVALID_INDEX without stream) / Stream-Definitionsindex (CALL, NXLD_PLAN_INVALID_INDEX ohne Stream) */
+    size_t rule;                            /**< 来源规则索引 / Originating rule index / Index der Ursprungsregel */
+    int counts_rule;                        /**< 调用是否计为规则的一次触发（CALL，规则没有绑定值步骤时） / Whether the call counts as one firing of the rule (CALL, when the rule has no value step) / Ob der Aufruf als eine Auslösung der Regel zählt (CALL, wenn die Regel keinen Wertschritt hat) */
+    size_t trigger_node;                    /**< 触发调用的规则源节点（CALL，跟踪流箭头的起点） / Source node of the rule triggering the call (CALL, origin of the trace flow arrow) / Quellknoten der den Aufruf auslösenden Regel (CALL, Ursprung des Verfolgungsflusspfeils) */
+} nxld_plan_step_t;
+
+/**
+ * @brief 计划流定义结构体（TransferMode=stream规则） / Plan stream definition structure (TransferMode=stream rule) / Plan-Stream-Definitionsstruktur (TransferMode=stream-Regel)
+ */
+typedef struct {
+    size_t producer_node;                   /**< 生产者节点索引 / Producer node index / Erzeugerknotenindex */
+    int producer_slot;                      /**< 生产者接收流句柄的参数槽 / Producer slot receiving the stream handle / Erzeuger-Slot, der das Stream-Handle erhält */
+    size_t consumer_node;                   /**< 消费者节点索引 / Consumer node index / Verbraucherknotenindex */
+    int consumer_slot;                      /**< 消费者接收分块的参数槽 / Consumer slot receiving each chunk / Verbraucher-Slot, der jeden Block erhält */
+    size_t chunk_bytes;                     /**< 分块容量（字节） / Chunk capacity in bytes / Blockkapazität in Bytes */
+    size_t depth;                           /**< 环中分块数量 / Chunks in the ring / Blöcke im Ring */
+} nxld_plan_stream_t;
+
+/**
+ * @brief 执行观察事件枚举 / Execution observer event enumeration / Aufzählung der Ausführungsbeobachter-Ereignisse
+ */
+typedef enum {
+    NXLD_PLAN_EVENT_ROUTE_BEGIN = 0,       /**< 路由开始，index为路由，args[0]为源参数值 / Route begins, index is the route, args[0] is the source parameter value / Route beginnt, index ist die Route, args[0] ist der Quellparameterwert */
+    NXLD_PLAN_EVENT_CALL,                  /**< 目标调用即将执行，index为节点，args为按参数类型转换后的参数 / Target call is about to run, index is the node, args are the arguments converted by parameter type / Zielaufruf steht bevor, index ist der Knoten, args sind die nach Parametertyp konvertierten Argumente */
+    NXLD_PLAN_EVENT_ROUTE_END              /**< 路由结束，index为路由，args为NULL / Route ends, index is the route, args is NULL / Route endet, index ist die Route, args ist NULL */
+} nxld_plan_event_t;
+
+/**
+ * @brief 执行观察函数类型 / Execution observer function type / Funktionstyp des Ausführungsbeobachters
+ * @details 在执行路由的线程上调用；流消费者线程上的调用不通知 / Called on the thread running the route; calls on stream consumer threads are not reported / Wird im Thread aufgerufen, der die Route ausführt; Aufrufe in Stream-Verbraucher-Threads werden nicht gemeldet
+ */
+typedef void (*nxld_plan_observer_t)(void* arg, nxld_plan_event_t event, size_t index, const intptr_t* args);
+
+/**
+ * @brief 计划路由结构体（一个源接口参数的入口） / Plan route structure (entry for one source interface parameter) / Plan-Routen-Struktur (Einstieg für einen Quellschnittstellenparameter)
+ */
+typedef struct {
+    size_t source_node;                     /**< 源节点索引 / Source node index / Quellknotenindex */
+    int source_param_index;                 /**< 源参数索引 / Source parameter index / Quellparameterindex */
+    size_t first_step;                      /**< 第一个步骤索引 / First step index / Index des ersten Schritts */
+    size_t step_count;                      /**< 步骤数量 / Step count / Schrittanzahl */
+} nxld_plan_route_t;
+
+/**
+ * @brief 传递执行计划结构体 / Transfer execution plan structure / Übertragungs-Ausführungsplan-Struktur
+ */
+typedef struct {
+    nxld_plan_plugin_t* plugins;            /**< 插件条目数组 / Plugin entry array / Plugin-Eintragsarray */
+    size_t plugin_count;                    /**< 插件条目数量 / Plugin entry count / Anzahl der Plugin-Einträge */
+    nxld_plan_node_t* nodes;                /**< 节点数组 / Node array / Knotenarray */
+    size_t node_count;                      /**< 节点数量 / Node count / Knotenanzahl */
+    size_t* node_order;                     /**< 拓扑排序后的节点索引 / Topologically ordered node indices / Topologisch sortierte Knotenindizes */
+    nxld_plan_step_t* steps;                /**< 步骤数组 / Step array / Schrittarray */
+    size_t step_count;                      /**< 步骤数量 / Step count / Schrittanzahl */
+    nxld_plan_route_t* routes;              /**< 路由数组 / Route array / Routenarray */
+    size_t route_count;                     /**< 路由数量 / Route count / Routenanzahl */
+    nxld_string_index_t route_lookup;       /**< 源插件、接口和参数索引到路由的索引 / Index from source plugin, interface and parameter index to route / Index von Quell-Plugin, -Schnittstelle und Parameterindex auf die Route */
+    nxld_condition_t* predicates;           /**< 谓词数组 / Predicate array / Prädikatarray */
+    size_t predicate_count;                 /**< 谓词数量 / Predicate count / Anzahl der Prädikate */
+    nxld_plan_stream_t* streams;            /**< 流定义数组 / Stream definition array / Stream-Definitionsarray */
+    size_t stream_count;                    /**< 流定义数量 / Stream definition count / Anzahl der Stream-Definitionen */
+    size_t entry_route;                     /**< 入口插件路由索引 / Entry plugin route index / Routenindex des Einstiegs-Plugins */
+    size_t skipped_rule_count;              /**< 编译时移除的规则数量 / Rules removed at compile time / Beim Kompilieren entfernte Regeln */
+    size_t frame_slot_count;                /**< 所有节点参数帧槽总数 / Total argument frame slots of all nodes / Gesamtzahl der Argumentrahmen-Slots aller Knoten */
+    struct nxld_plan_context* default_context;  /**< 非上下文API使用的默认执行上下文 / Default execution context used by the context-free API / Standard-Ausführungskontext der kontextlosen API */
+    nxld_mutex_t load_mutex;                /**< 延迟加载互斥锁 / Lazy loading mutex / Mutex für verzögertes Laden */
+    nxld_mutex_t exec_mutex;                /**< 非上下文感知路由的执行互斥锁 / Execution mutex for routes that are not context-aware / Ausführungs-Mutex für nicht kontextbewusste Routen */
+    int sync_initialized;                   /**< 互斥锁已初始化 / Mutexes initialized / Mutexe initialisiert */
+    size_t* warmup_order;                   /**< 预热节点顺序 / Warm-up node order / Aufwärm-Knotenreihenfolge */
+    size_t warmup_count;                    /**< 预热节点数量 / Warm-up node count / Anzahl der Aufwärmknoten */
+    nxld_thread_t warmup_thread;            /**< 后台预热线程 / Background warm-up thread / Hintergrund-Aufwärm-Thread */
+    int warmup_running;                     /**< 预热线程尚未回收 / Warm-up thread not yet joined / Aufwärm-Thread noch nicht eingesammelt */
+    int warmup_cancel;                      /**< 预热取消标志（受load_mutex保护） / Warm-up cancel flag (guarded by load_mutex) / Aufwärm-Abbruchflag (durch load_mutex geschützt) */
+    nxld_metrics_t* metrics;                /**< 规则与接口指标（禁用时为NULL） / Rule and interface metrics (NULL when disabled) / Regel- und Schnittstellenmetriken (NULL wenn deaktiviert) */
+    size_t metrics_rule_count;              /**< 规则序列数量，接口序列排在其后 / Rule series count, interface series follow / Anzahl der Regelserien, Schnittstellenserien folgen */
+    int memo_enabled;                       /**< 是否缓存纯接口的结果 / Whether results of pure interfaces are cached / Ob Ergebnisse reiner Schnittstellen zwischengespeichert werden */
+    nxld_plan_observer_t observer;          /**< 执行观察函数（可为NULL） / Execution observer (may be NULL) / Ausführungsbeobachter (kann NULL sein) */
+    void* observer_arg;                     /**< 执行观察函数参数 / Execution observer argument / Argument des Ausführungsbeobachters */
+} nxld_transfer_plan_t;
+
+/**
+ * @brief 执行上下文结构体 / Execution context structure / Ausführungskontext-Struktur
+ * @details 保存一次调用链的参数帧、阻断标志、返回值和插件上下文，使多个调用链可以在不同线程中并发执行同一计划 / Holds argument frames, block flags, return values and plugin contexts of one chain so several chains can run the same plan concurrently on different threads / Hält Argumentrahmen, Blockierflags, Rückgabewerte und Plugin-Kontexte einer Kette, damit mehrere Ketten denselben Plan gleichzeitig in verschiedenen Threads ausführen können
+ */
+typedef struct nxld_plan_context {
+    nxld_transfer_plan_t* plan;             /**< 所属计划 / Owning plan / Zugehöriger Plan */
+    nxld_plan_value_t* frames;              /**< 所有节点的参数帧（按frame_offset索引） / Argument frames of all nodes (indexed by frame_offset) / Argumentrahmen aller Knoten (per frame_offset indiziert) */
+    unsigned char* blocked;                 /**< 每个节点的阻断标志 / Block flag per node / Blockierflag je Knoten */
+    intptr_t* results;                      /**< 每个节点最近一次调用的返回值 / Last return value per node / Letzter Rückgabewert je Knoten */
+    void** functions;                       /**< 本上下文已解析的节点函数 / Node functions resolved in this context / In diesem Kontext aufgelöste Knotenfunktionen */
+    void** plugin_contexts;                 /**< 每个插件的调用链上下文 / Per-chain context per plugin / Kettenkontext je Plugin */
+    unsigned char* route_mode;              /**< 每个路由的并发模式缓存 / Cached concurrency mode per route / Zwischengespeicherter Nebenläufigkeitsmodus je Route */
+    nxld_metrics_shard_t* metrics;          /**< 本上下文的指标分片 / Metrics shard of this context / Metrik-Shard dieses Kontexts */
+    nxld_metrics_shard_t* stream_metrics;   /**< 流消费者线程的指标分片 / Metrics shard of the stream consumer thread / Metrik-Shard des Stream-Verbraucher-Threads */
+    uint64_t* trace_marks;                  /**< 每个节点最近一次跟踪调用内的时间点（未跟踪时为NULL） / Point in time inside the last traced call per node (NULL when not tracing) / Zeitpunkt innerhalb des letzten verfolgten Aufrufs je Knoten (NULL ohne Verfolgung) */
+} nxld_plan_context_t;
+
+/**
+ * @brief 计划编译结果枚举 / Plan compile result enumeration / Plan-Kompilierungsergebnis-Aufzählung
+ */
+typedef enum {
+    NXLD_TRANSFER_PLAN_SUCCESS = 0,        /**< 编译成功 / Compile successful / Kompilierung erfolgreich */
+    NXLD_TRANSFER_PLAN_CYCLE,              /**< 规则图存在环 / Rule graph contains a cycle / Regelgraph enthält einen Zyklus */
+    NXLD_TRANSFER_PLAN_MEMORY_ERROR        /**< 内存分配错误 / Memory allocation error / Speicherzuweisungsfehler */
+} nxld_transfer_plan_result_t;
+
+/**
+ * @brief 编译执行计划 / Compile execution plan / Ausführungsplan kompilieren
+ * @param rules 已链式加载的规则集合 / Chain-loaded rule set / Kettenweise geladener Regelsatz
+ * @param plan 输出计划结构体指针 / Output plan structure pointer / Ausgabe-Planstruktur-Zeiger
+ * @return 编译结果 / Compile result / Kompilierungsergebnis
+ * @details 移除禁用规则，按拓扑顺序展开主动调用链，预绑定常量并提升条件；不加载任何插件 / Removes disabled rules, unrolls active call chains in topological order, pre-binds constants and hoists conditions; loads no plugins / Entfernt deaktivierte Regeln, entrollt aktive Aufrufketten in topologischer Reihenfolge, bindet Konstanten vorab und hebt Bedingungen an; lädt keine Plugins
+ */
+nxld_transfer_plan_result_t nxld_transfer_plan_compile(const nxld_transfer_rule_set_t* rules, nxld_transfer_plan_t* plan);
+
+/**
+ * @brief 查找路由 / Find route / Route suchen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param source_plugin 源插件名称 / Source plugin name / Quell-Plugin-Name
+ * @param source_interface 源接口名称 / Source interface name / Quellschnittstellenname
+ * @param param_index 源参数索引 / Source parameter index / Quellparameterindex
+ * @return 路由索引，未找到返回NXLD_PLAN_INVALID_INDEX / Route index, NXLD_PLAN_INVALID_INDEX if not found / Routenindex, NXLD_PLAN_INVALID_INDEX wenn nicht gefunden
+ */
+size_t nxld_transfer_plan_find_route(const nxld_transfer_plan_t* plan, const char* source_plugin,
+                                     const char* source_interface, int param_index);
+
+/**
+ * @brief 直接执行路由 / Execute route directly / Route direkt ausführen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param route 路由索引 / Route index / Routenindex
+ * @param param_value 源参数值 / Source parameter value / Quellparameterwert
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 不进行规则匹配、常量解析和就绪检查；使用计划的默认执行上下文，不可并发调用 / Performs no rule matching, constant parsing or readiness checks; uses the plan's default execution context and must not be called concurrently / Führt keinen Regelabgleich, keine Konstantenanalyse und keine Bereitschaftsprüfung durch; verwendet den Standard-Ausführungskontext des Plans und darf nicht gleichzeitig aufgerufen werden
+ */
+int nxld_transfer_plan_execute(nxld_transfer_plan_t* plan, size_t route, void* param_value);
+
+/**
+ * @brief 按源接口调用计划（与CallPlugin语义一致） / Call plan by source interface (same semantics as CallPlugin) / Plan nach Quellschnittstelle aufrufen (gleiche Semantik wie CallPlugin)
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param source_plugin 源插件名称 / Source plugin name / Quell-Plugin-Name
+ * @param source_interface 源接口名称 / Source interface name / Quellschnittstellenname
+ * @param param_index 源参数索引 / Source parameter index / Quellparameterindex
+ * @param param_value 源参数值 / Source parameter value / Quellparameterwert
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_transfer_plan_call(nxld_transfer_plan_t* plan, const char* source_plugin,
+                            const char* source_interface, int param_index, void* param_value);
+
+/**
+ * @brief 批量调用计划（CallPlugin的多元组变体） / Call plan in batch (multi-tuple variant of CallPlugin) / Plan im Stapel aufrufen (Mehrtupel-Variante von CallPlugin)
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param source_plugin 源插件名称 / Source plugin name / Quell-Plugin-Name
+ * @param source_interface 源接口名称 / Source interface name / Quellschnittstellenname
+ * @param first_param_index 元组第一个元素对应的源参数索引 / Source parameter index of the first tuple element / Quellparameterindex des ersten Tupelelements
+ * @param tuples 按行存储的参数元组数组（tuple_count * tuple_size） / Row-major argument tuple array (tuple_count * tuple_size) / Zeilenweise gespeichertes Argumenttupel-Array (tuple_count * tuple_size)
+ * @param tuple_size 每个元组的参数数量，第j个元素对应源参数索引first_param_index+j / Parameters per tuple, element j maps to source parameter index first_param_index+j / Parameter je Tupel, Element j entspricht Quellparameterindex first_param_index+j
+ * @param tuple_count 元组数量 / Tuple count / Anzahl der Tupel
+ * @param statuses 输出每个元组的结果（0或-1，可为NULL） / Output per-tuple result, 0 or -1 (may be NULL) / Ausgabe des Ergebnisses je Tupel, 0 oder -1 (kann NULL sein)
+ * @return 全部成功返回0，否则返回-1 / Returns 0 if all tuples succeed, -1 otherwise / Gibt 0 zurück, wenn alle Tupel erfolgreich sind, sonst -1
+ * @details 使用计划的默认执行上下文，不可并发调用；并发调用方使用nxld_transfer_plan_call_batch_context / Uses the plan's default execution context and must not be called concurrently; concurrent callers use nxld_transfer_plan_call_batch_context / Verwendet den Standard-Ausführungskontext des Plans und darf nicht gleichzeitig aufgerufen werden; gleichzeitige Aufrufer verwenden nxld_transfer_plan_call_batch_context
+ */
+int nxld_transfer_plan_call_batch(nxld_transfer_plan_t* plan, const char* source_plugin, const char* source_interface,
+                                  int first_param_index, void* const* tuples, size_t tuple_size, size_t tuple_count,
+                                  int* statuses);
+
+/**
+ * @brief 创建执行上下文 / Create execution context / Ausführungskontext erstellen
+ * @param plan 已编译的计划 / Compiled plan / Kompilierter Plan
+ * @return 上下文指针，失败返回NULL / Context pointer, NULL on failure / Kontextzeiger, NULL bei Fehler
+ * @details 每个并发调用链使用各自的上下文；上下文须在计划释放前释放 / Each concurrent chain uses its own context; contexts must be freed before the plan / Jede gleichzeitige Kette verwendet ihren eigenen Kontext; Kontexte müssen vor dem Plan freigegeben werden
+ */
+nxld_plan_context_t* nxld_transfer_plan_context_create(nxld_transfer_plan_t* plan);
+
+/**
+ * @brief 释放执行上下文 / Free execution context / Ausführungskontext freigeben
+ * @param context 上下文指针 / Context pointer / Kontextzeiger
+ */
+void nxld_transfer_plan_context_free(nxld_plan_context_t* context);
+
+/**
+ * @brief 在执行上下文中执行路由 / Execute route in an execution context / Route in einem Ausführungskontext ausführen
+ * @param context 上下文指针 / Context pointer / Kontextzeiger
+ * @param route 路由索引 / Route index / Routenindex
+ * @param param_value 源参数值 / Source parameter value / Quellparameterwert
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 路由涉及的插件全部为上下文感知时并发执行，否则与其他此类路由串行执行 / Runs concurrently when every plugin on the route is context-aware, otherwise serialized with other such routes / Läuft gleichzeitig, wenn alle Plugins der Route kontextbewusst sind, sonst serialisiert mit anderen solchen Routen
+ */
+int nxld_transfer_plan_execute_context(nxld_plan_context_t* context, size_t route, void* param_value);
+
+/**
+ * @brief 在执行上下文中按源接口调用计划 / Call plan by source interface in an execution context / Plan nach Quellschnittstelle in einem Ausführungskontext aufrufen
+ * @param context 上下文指针 / Context pointer / Kontextzeiger
+ * @param source_plugin 源插件名称 / Source plugin name / Quell-Plugin-Name
+ * @param source_interface 源接口名称 / Source interface name / Quellschnittstellenname
+ * @param param_index 源参数索引 / Source parameter index / Quellparameterindex
+ * @param param_value 源参数值 / Source parameter value / Quellparameterwert
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_transfer_plan_call_context(nxld_plan_context_t* context, const char* source_plugin,
+                                    const char* source_interface, int param_index, void* param_value);
+
+/**
+ * @brief 在执行上下文中批量调用计划 / Call plan in batch in an execution context / Plan im Stapel in einem Ausführungskontext aufrufen
+ * @param context 上下文指针 / Context pointer / Kontextzeiger
+ * @details 参数和返回值同nxld_transfer_plan_call_batch；路由查找、延迟加载检查和并发模式判断每批只进行一次，路由须串行时整批持有执行锁 / Parameters and return value as for nxld_transfer_plan_call_batch; route lookup, lazy-load checks and the concurrency decision happen once per batch, and the execution lock is held for the whole batch when a route must be serialized / Parameter und Rückgabewert wie bei nxld_transfer_plan_call_batch; Routensuche, Lade-Prüfungen und Nebenläufigkeitsentscheidung erfolgen einmal pro Stapel, und die Ausführungssperre wird für den ganzen Stapel gehalten, wenn eine Route serialisiert werden muss
+ */
+int nxld_transfer_plan_call_batch_context(nxld_plan_context_t* context, const char* source_plugin,
+                                          const char* source_interface, int first_param_index, void* const* tuples,
+                                          size_t tuple_size, size_t tuple_count, int* statuses);
+
+/**
+ * @brief 按策略预热目标插件 / Warm up target plugins according to policy / Ziel-Plugins gemäß Richtlinie aufwärmen
+ * @param plan 已编译的计划 / Compiled plan / Kompilierter Plan
+ * @param policy 预热策略 / Warm-up policy / Aufwärmrichtlinie
+ * @return 成功返回0，失败返回-1（插件仍在首次调用时加载） / Returns 0 on success, -1 on failure (plugins still load on first call) / Gibt 0 bei Erfolg zurück, -1 bei Fehler (Plugins laden weiterhin beim ersten Aufruf)
+ * @details 加载插件、解析接口符号并预先访问映像页面。predictive在后台线程中按从入口可达的顺序预热，不可达的插件保持延迟加载；eager在返回前预热所有被调用的插件；lazy不做任何事。预热可与执行同时进行：每个接口的解析结果只构建一次并原子发布，执行中读取的参数类型和结果缓存从不被改写 / Loads plugins, resolves interface symbols and faults in image pages. predictive warms plugins in the order they are reachable from the entry on a background thread and leaves unreachable plugins lazy; eager warms every invoked plugin before returning; lazy does nothing. Warm-up may run while routes execute: each interface's resolution record is built once and published atomically, and the parameter types and result caches that running routes read are never rewritten / Lädt Plugins, löst Schnittstellensymbole auf und liest Abbildseiten vorab ein. predictive wärmt im Hintergrund in der vom Einstieg aus erreichbaren Reihenfolge auf und lässt unerreichbare Plugins verzögert; eager wärmt alle aufgerufenen Plugins vor der Rückkehr auf; lazy tut nichts. Das Aufwärmen darf parallel zur Ausführung laufen: das Auflösungsergebnis jeder Schnittstelle wird einmal erstellt und atomar veröffentlicht, und die von laufenden Routen gelesenen Parametertypen und Ergebniscaches werden nie überschrieben
+ */
+int nxld_transfer_plan_warmup(nxld_transfer_plan_t* plan, nxld_warmup_policy_t policy);
+
+/**
+ * @brief 等待后台预热完成 / Wait for background warm-up to finish / Auf das Ende des Hintergrund-Aufwärmens warten
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ */
+void nxld_transfer_plan_warmup_wait(nxld_transfer_plan_t* plan);
+
+/**
+ * @brief 设置执行观察函数 / Set execution observer / Ausführungsbeobachter setzen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param observer 观察函数，NULL表示移除 / Observer, NULL removes it / Beobachter, NULL entfernt ihn
+ * @param arg 观察函数参数 / Observer argument / Argument des Beobachters
+ * @details 只能在没有路由执行时设置；未设置时执行路径只多一次指针判断 / Only set while no route is running; without an observer the execution path costs one extra pointer test / Nur setzen, während keine Route läuft; ohne Beobachter kostet der Ausführungspfad nur eine zusätzliche Zeigerprüfung
+ */
+void nxld_transfer_plan_set_observer(nxld_transfer_plan_t* plan, nxld_plan_observer_t observer, void* arg);
+
+/**
+ * @brief 获取规则指标快照 / Get rule metrics snapshot / Momentaufnahme der Regelmetriken abrufen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param rule 规则集合中的规则索引 / Rule index in the rule set / Regelindex im Regelsatz
+ * @param out 输出快照 / Output snapshot / Ausgabe-Momentaufnahme
+ * @return 成功返回0，指标禁用或索引无效返回-1 / Returns 0 on success, -1 if metrics are disabled or the index is invalid / Gibt 0 bei Erfolg zurück, -1 wenn Metriken deaktiviert sind oder der Index ungültig ist
+ * @details 条件跳过记在绑定值的规则上，延迟为该规则触发的导出或目标调用耗时 / Condition skips are counted on the rule that binds the value, latency is the export or target call the rule triggers / Bedingungssprünge werden bei der Regel gezählt, die den Wert bindet, die Latenz ist der von der Regel ausgelöste Export- oder Zielaufruf
+ */
+int nxld_transfer_plan_get_rule_metrics(const nxld_transfer_plan_t* plan, size_t rule, nxld_metrics_series_t* out);
+
+/**
+ * @brief 获取接口指标快照 / Get interface metrics snapshot / Momentaufnahme der Schnittstellenmetriken abrufen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param node 节点索引 / Node index / Knotenindex
+ * @param out 输出快照 / Output snapshot / Ausgabe-Momentaufnahme
+ * @return 成功返回0，指标禁用或索引无效返回-1 / Returns 0 on success, -1 if metrics are disabled or the index is invalid / Gibt 0 bei Erfolg zurück, -1 wenn Metriken deaktiviert sind oder der Index ungültig ist
+ */
+int nxld_transfer_plan_get_interface_metrics(const nxld_transfer_plan_t* plan, size_t node, nxld_metrics_series_t* out);
+
+/**
+ * @brief 获取接口结果缓存统计 / Get interface result cache statistics / Ergebniscache-Statistik einer Schnittstelle abrufen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param node 节点索引 / Node index / Knotenindex
+ * @param out 输出统计 / Output statistics / Ausgabestatistik
+ * @return 成功返回0，接口没有结果缓存或索引无效返回-1 / Returns 0 on success, -1 if the interface has no result cache or the index is invalid / Gibt 0 bei Erfolg zurück, -1 wenn die Schnittstelle keinen Ergebniscache hat oder der Index ungültig ist
+ * @details 结果缓存在纯接口首次解析时创建 / The result cache is created when a pure interface is first resolved / Der Ergebniscache wird bei der ersten Auflösung einer reinen Schnittstelle erstellt
+ */
+int nxld_transfer_plan_get_interface_cache_stats(const nxld_transfer_plan_t* plan, size_t node, nxld_memo_stats_t* out);
+
+/**
+ * @brief 获取节点当前的参数类型 / Get the current parameter types of a node / Aktuelle Parametertypen eines Knotens abrufen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param node 节点索引 / Node index / Knotenindex
+ * @return 已解析时返回与插件核对后的类型，否则返回编译时的类型；索引无效返回NULL / Types checked against the plugin once resolved, otherwise the compile-time types; NULL for an invalid index / Nach dem Auflösen die mit dem Plugin abgeglichenen Typen, sonst die Typen zur Kompilierzeit; NULL bei ungültigem Index
+ * @details 可在执行期间从任意线程调用 / May be called from any thread while routes run / Kann während der Ausführung aus jedem Thread aufgerufen werden
+ */
+const nxld_param_type_t* nxld_transfer_plan_get_param_types(const nxld_transfer_plan_t* plan, size_t node);
+
+/**
+ * @brief 将指标写出为JSON文件 / Write metrics as a JSON file / Metriken als JSON-Datei schreiben
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ * @param rules 编译计划所用的规则集合 / Rule set the plan was compiled from / Regelsatz, aus dem der Plan kompiliert wurde
+ * @param path 输出文件路径 / Output file path / Ausgabedateipfad
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 先写临时文件再替换，读取方不会看到写了一半的文件；只写出有记录的规则和接口 / Writes a temporary file and then replaces the target so readers never see a half-written file; only rules and interfaces with activity are written / Schreibt eine temporäre Datei und ersetzt dann das Ziel, sodass Leser nie eine halb geschriebene Datei sehen; nur Regeln und Schnittstellen mit Aktivität werden geschrieben
+ */
+int nxld_transfer_plan_dump_metrics(const nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules, const char* path);
+
+/**
+ * @brief 释放计划内存并卸载计划加载的插件 / Free plan memory and unload plugins loaded by the plan / Planspeicher freigeben und vom Plan geladene Plugins entladen
+ * @param plan 计划结构体指针 / Plan structure pointer / Planstruktur-Zeiger
+ */
+void nxld_transfer_plan_free(nxld_transfer_plan_t* plan);
+
+/**
+ * @brief 获取计划编译结果错误信息 / Get plan compile result error message / Plan-Kompilierungsergebnis-Fehlermeldung abrufen
+ * @param result 编译结果 / Compile result / Kompilierungsergebnis
+ * @return 错误信息字符串 / Error message string / Fehlermeldungszeichenfolge
+ */
+const char* nxld_transfer_plan_get_error_message(nxld_transfer_plan_result_t result);
+
+#endif /* NXLD_TRANSFER_PLAN_H */
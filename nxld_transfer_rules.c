@@ -0,0 +1,971 @@
+/**
+ * @file nxld_transfer_rules.c
+ * @brief NXLD传递规则文件解析实现 / NXLD Transfer Rule File Parsing Implementation / NXLD-Übertragungsregeldatei-Parsing-Implementierung
+ */
+
+#include "nxld_transfer_rules.h"
+#include "nxld_logger.h"
+#include "nxld_thread.h"
+#include "nxld_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define access _access
+#define F_OK 0
+#define strcasecmp _stricmp
+#else
+#include <unistd.h>
+#include <strings.h>
+#endif
+
+#define MAX_LINE_LENGTH 4096
+#define MAX_SECTION_NAME 256
+#define MAX_KEY_LENGTH 256
+#define MAX_VALUE_LENGTH 2048
+#define MAX_PATH_LENGTH 4096
+#define RULE_SECTION_PREFIX "TransferRule_"
+#define PREFETCH_MAX_THREADS 4
+#define DEFAULT_METRICS_SAMPLING 16
+
+/**
+ * @brief 去除字符串首尾空白字符 / Trim whitespace from string / Leerzeichen am Anfang und Ende entfernen
+ * @param str 字符串指针 / String pointer / Zeichenfolgenzeiger
+ * @return 去除空白后的字符串指针 / Pointer to trimmed string / Zeiger auf bereinigte Zeichenfolge
+ */
+static char* trim_whitespace(char* str) {
+    if (str == NULL) {
+        return NULL;
+    }
+
+    while (isspace((unsigned char)*str)) {
+        str++;
+    }
+
+    if (*str == 0) {
+        return str;
+    }
+
+    char* end = str + strlen(str) - 1;
+    while (end > str && isspace((unsigned char)*end)) {
+        end--;
+    }
+
+    end[1] = '\0';
+    return str;
+}
+
+/**
+ * @brief 复制字符串 / Duplicate string / Zeichenfolge duplizieren
+ * @param str 源字符串 / Source string / Quellzeichenfolge
+ * @return 新分配的字符串，失败返回NULL / Newly allocated string, NULL on failure / Neu zugewiesene Zeichenfolge, NULL bei Fehler
+ */
+static char* duplicate_string(const char* str) {
+    if (str == NULL) {
+        return NULL;
+    }
+
+    size_t len = strlen(str);
+    char* copy = (char*)malloc(len + 1);
+    if (copy != NULL) {
+        memcpy(copy, str, len + 1);
+    }
+    return copy;
+}
+
+/**
+ * @brief 将相对路径解析为基于基目录的路径 / Resolve relative path against base directory / Relativen Pfad gegen Basisverzeichnis auflösen
+ * @param base_dir 基目录（NULL表示不处理） / Base directory (NULL leaves path unchanged) / Basisverzeichnis (NULL lässt Pfad unverändert)
+ * @param path 输入路径 / Input path / Eingabepfad
+ * @param full_path 输出完整路径缓冲区 / Output full path buffer / Ausgabe-Vollpfad-Puffer
+ * @param full_path_size 缓冲区大小 / Buffer size / Puffergröße
+ * @return 成功返回1，失败返回0 / Returns 1 on success, 0 on failure / Gibt 1 bei Erfolg zurück, 0 bei Fehler
+ */
+static int resolve_path(const char* base_dir, const char* path, char* full_path, size_t full_path_size) {
+    if (path == NULL || full_path == NULL || full_path_size == 0) {
+        return 0;
+    }
+
+    int is_absolute = (path[0] == '/' || path[0] == '\\');
+#ifdef _WIN32
+    if (isalpha((unsigned char)path[0]) && path[1] == ':') {
+        is_absolute = 1;
+    }
+#endif
+
+    if (base_dir == NULL || is_absolute) {
+        size_t len = strlen(path);
+        if (len >= full_path_size) {
+            return 0;
+        }
+        memcpy(full_path, path, len + 1);
+        return 1;
+    }
+
+    const char* normalized_path = path;
+    if (path[0] == '.' && (path[1] == '/' || path[1] == '\\')) {
+        normalized_path = path + 2;
+    }
+
+    size_t base_len = strlen(base_dir);
+    size_t normalized_len = strlen(normalized_path);
+    if (base_len + normalized_len + 2 >= full_path_size) {
+        return 0;
+    }
+
+    memcpy(full_path, base_dir, base_len);
+    if (base_len > 0 && base_dir[base_len - 1] != '/' && base_dir[base_len - 1] != '\\') {
+#ifdef _WIN32
+        full_path[base_len++] = '\\';
+#else
+        full_path[base_len++] = '/';
+#endif
+    }
+    memcpy(full_path + base_len, normalized_path, normalized_len + 1);
+    return 1;
+}
+
+/**
+ * @brief 解析配置段名称 / Parse section name / Abschnittsname analysieren
+ * @param line 输入行 / Input line / Eingabezeile
+ * @param section_name 输出段名称缓冲区 / Output section name buffer / Ausgabe-Abschnittsname-Puffer
+ * @return 成功返回1，失败返回0 / Returns 1 on success, 0 on failure / Gibt 1 bei Erfolg zurück, 0 bei Fehler
+ */
+static int parse_section_name(const char* line, char* section_name) {
+    const char* start = strchr(line, '[');
+    if (start == NULL) {
+        return 0;
+    }
+
+    start++;
+    const char* end = strchr(start, ']');
+    if (end == NULL) {
+        return 0;
+    }
+
+    size_t len = end - start;
+    if (len >= MAX_SECTION_NAME) {
+        len = MAX_SECTION_NAME - 1;
+    }
+
+    memcpy(section_name, start, len);
+    section_name[len] = '\0';
+
+    char* trimmed = trim_whitespace(section_name);
+    memmove(section_name, trimmed, strlen(trimmed) + 1);
+    return 1;
+}
+
+/**
+ * @brief 解析键值对 / Parse key-value pair / Schlüssel-Wert-Paar analysieren
+ * @param line 输入行 / Input line / Eingabezeile
+ * @param key 输出键缓冲区 / Output key buffer / Ausgabe-Schlüssel-Puffer
+ * @param value 输出值缓冲区 / Output value buffer / Ausgabe-Wert-Puffer
+ * @return 成功返回1，失败返回0 / Returns 1 on success, 0 on failure / Gibt 1 bei Erfolg zurück, 0 bei Fehler
+ */
+static int parse_key_value(const char* line, char* key, char* value) {
+    const char* eq_pos = strchr(line, '=');
+    if (eq_pos == NULL) {
+        return 0;
+    }
+
+    size_t key_len = eq_pos - line;
+    if (key_len >= MAX_KEY_LENGTH) {
+        key_len = MAX_KEY_LENGTH - 1;
+    }
+
+    memcpy(key, line, key_len);
+    key[key_len] = '\0';
+    char* trimmed_key = trim_whitespace(key);
+    memmove(key, trimmed_key, strlen(trimmed_key) + 1);
+
+    const char* value_start = eq_pos + 1;
+    size_t value_len = strlen(value_start);
+    if (value_len >= MAX_VALUE_LENGTH) {
+        value_len = MAX_VALUE_LENGTH - 1;
+    }
+
+    memcpy(value, value_start, value_len);
+    value[value_len] = '\0';
+    char* trimmed_value = trim_whitespace(value);
+    memmove(value, trimmed_value, strlen(trimmed_value) + 1);
+    return 1;
+}
+
+/**
+ * @brief 解析传递模式字符串 / Parse transfer mode string / Übertragungsmodus-Zeichenfolge analysieren
+ * @param value 模式字符串 / Mode string / Moduszeichenfolge
+ * @return 传递模式 / Transfer mode / Übertragungsmodus
+ */
+static nxld_transfer_mode_t parse_transfer_mode(const char* value) {
+    if (strcasecmp(value, "broadcast") == 0) {
+        return NXLD_TRANSFER_MODE_BROADCAST;
+    }
+    if (strcasecmp(value, "multicast") == 0) {
+        return NXLD_TRANSFER_MODE_MULTICAST;
+    }
+    if (strcasecmp(value, "stream") == 0) {
+        return NXLD_TRANSFER_MODE_STREAM;
+    }
+    return NXLD_TRANSFER_MODE_UNICAST;
+}
+
+/**
+ * @brief 解析预热策略 / Parse warm-up policy / Aufwärmrichtlinie parsen
+ * @param value 策略字符串 / Policy string / Richtlinienzeichenfolge
+ * @return 预热策略，无法识别返回-1 / Warm-up policy, -1 if unrecognized / Aufwärmrichtlinie, -1 wenn unbekannt
+ */
+static int parse_warmup_policy(const char* value) {
+    if (strcasecmp(value, "predictive") == 0) {
+        return NXLD_WARMUP_PREDICTIVE;
+    }
+    if (strcasecmp(value, "eager") == 0) {
+        return NXLD_WARMUP_EAGER;
+    }
+    if (strcasecmp(value, "lazy") == 0) {
+        return NXLD_WARMUP_LAZY;
+    }
+    return -1;
+}
+
+/**
+ * @brief 编译条件字符串 / Compile condition string / Bedingungszeichenfolge kompilieren
+ * @param rule 规则指针 / Rule pointer / Regelzeiger
+ * @param value 条件字符串 / Condition string / Bedingungszeichenfolge
+ */
+static void compile_condition(nxld_transfer_rule_t* rule, const char* value) {
+    if (value == NULL || value[0] == '\0') {
+        rule->condition_type = NXLD_TRANSFER_CONDITION_NONE;
+        return;
+    }
+
+    char error[128];
+    if (nxld_condition_compile(value, &rule->predicate, error, sizeof(error)) != 0) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_LOADER, "Invalid transfer condition '%s': %s", value, error);
+        rule->condition_type = NXLD_TRANSFER_CONDITION_UNKNOWN;
+        return;
+    }
+    rule->condition_type = NXLD_TRANSFER_CONDITION_PREDICATE;
+}
+
+/**
+ * @brief 释放单条规则的字符串字段 / Free string fields of a single rule / Zeichenfolgenfelder einer einzelnen Regel freigeben
+ * @param rule 规则指针 / Rule pointer / Regelzeiger
+ */
+static void free_rule(nxld_transfer_rule_t* rule) {
+    free(rule->source_plugin);
+    free(rule->source_interface);
+    free(rule->target_plugin);
+    free(rule->target_plugin_path);
+    free(rule->target_interface);
+    free(rule->target_param_value);
+    free(rule->condition);
+    free(rule->description);
+    free(rule->multicast_group);
+    memset(rule, 0, sizeof(nxld_transfer_rule_t));
+}
+
+/**
+ * @brief 设置规则字段 / Set rule field / Regelfeld setzen
+ * @param rule 规则指针 / Rule pointer / Regelzeiger
+ * @param key 键 / Key / Schlüssel
+ * @param value 值 / Value / Wert
+ * @return 成功返回0，内存错误返回-1 / Returns 0 on success, -1 on memory error / Gibt 0 bei Erfolg zurück, -1 bei Speicherfehler
+ */
+static int set_rule_field(nxld_transfer_rule_t* rule, const char* key, const char* value) {
+    char** field = NULL;
+
+    if (strcmp(key, "SourcePlugin") == 0) {
+        field = &rule->source_plugin;
+    } else if (strcmp(key, "SourceInterface") == 0) {
+        field = &rule->source_interface;
+    } else if (strcmp(key, "SourceParamIndex") == 0) {
+        rule->source_param_index = atoi(value);
+        return 0;
+    } else if (strcmp(key, "TargetPlugin") == 0) {
+        field = &rule->target_plugin;
+    } else if (strcmp(key, "TargetPluginPath") == 0) {
+        field = &rule->target_plugin_path;
+    } else if (strcmp(key, "TargetInterface") == 0) {
+        field = &rule->target_interface;
+    } else if (strcmp(key, "TargetParamIndex") == 0) {
+        rule->target_param_index = atoi(value);
+        return 0;
+    } else if (strcmp(key, "TargetParamValue") == 0) {
+        if (value[0] == '\0') {
+            return 0;
+        }
+        field = &rule->target_param_value;
+    } else if (strcmp(key, "Condition") == 0) {
+        compile_condition(rule, value);
+        field = &rule->condition;
+    } else if (strcmp(key, "Description") == 0) {
+        field = &rule->description;
+    } else if (strcmp(key, "MulticastGroup") == 0) {
+        field = &rule->multicast_group;
+    } else if (strcmp(key, "TransferMode") == 0) {
+        rule->transfer_mode = parse_transfer_mode(value);
+        return 0;
+    } else if (strcmp(key, "Enabled") == 0) {
+        rule->enabled = (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0);
+        return 0;
+    } else if (strcmp(key, "StreamChunkBytes") == 0) {
+        rule->stream_chunk_bytes = (size_t)strtoull(value, NULL, 10);
+        return 0;
+    } else if (strcmp(key, "StreamDepth") == 0) {
+        rule->stream_depth = (size_t)strtoull(value, NULL, 10);
+        return 0;
+    } else {
+        return 0;
+    }
+
+    free(*field);
+    *field = duplicate_string(value);
+    return *field != NULL ? 0 : -1;
+}
+
+/**
+ * @brief 单个.nxpt文件的解析结果结构体 / Parse result of a single .nxpt file / Parse-Ergebnis einer einzelnen .nxpt-Datei
+ */
+typedef struct {
+    nxld_transfer_rule_t* rules;            /**< 文件中的规则 / Rules in the file / Regeln der Datei */
+    size_t rule_count;                      /**< 规则数量 / Rule count / Regelanzahl */
+    size_t rule_capacity;                   /**< 规则数组容量 / Rule array capacity / Regelarray-Kapazität */
+    char* entry_plugin_name;                /**< [EntryPlugin] PluginName / [EntryPlugin] PluginName / [EntryPlugin] PluginName */
+    char* entry_plugin_path;                /**< [EntryPlugin] PluginPath / [EntryPlugin] PluginPath / [EntryPlugin] PluginPath */
+    char* entry_nxpt_path;                  /**< [EntryPlugin] NxptPath / [EntryPlugin] NxptPath / [EntryPlugin] NxptPath */
+    int declared_count;                     /**< 声明的规则数量（-1表示未声明） / Declared rule count (-1 if not declared) / Deklarierte Regelanzahl (-1 wenn nicht deklariert) */
+    int warmup_policy;                      /**< [EntryPlugin] WarmupPolicy（-1表示未设置） / [EntryPlugin] WarmupPolicy (-1 if unset) / [EntryPlugin] WarmupPolicy (-1 wenn nicht gesetzt) */
+    int metrics_enabled;                    /**< [EntryPlugin] Metrics（-1表示未设置） / [EntryPlugin] Metrics (-1 if unset) / [EntryPlugin] Metrics (-1 wenn nicht gesetzt) */
+    int metrics_sampling;                   /**< [EntryPlugin] MetricsSampling（0表示未设置） / [EntryPlugin] MetricsSampling (0 if unset) / [EntryPlugin] MetricsSampling (0 wenn nicht gesetzt) */
+    int memoize_enabled;                    /**< [EntryPlugin] Memoize（-1表示未设置） / [EntryPlugin] Memoize (-1 if unset) / [EntryPlugin] Memoize (-1 wenn nicht gesetzt) */
+} parsed_file_t;
+
+/**
+ * @brief 预取任务结构体 / Prefetch job structure / Prefetch-Auftragsstruktur
+ */
+typedef struct {
+    char* path;                             /**< 已解析的.nxpt文件路径 / Resolved .nxpt file path / Aufgelöster .nxpt-Dateipfad */
+    size_t rule;                            /**< 发现该文件的规则索引 / Index of the rule that discovered the file / Index der Regel, die die Datei entdeckt hat */
+    parsed_file_t parsed;                   /**< 解析结果 / Parse result / Parse-Ergebnis */
+    nxld_transfer_rules_result_t result;    /**< 解析结果码 / Parse result code / Parse-Ergebniscode */
+    int done;                               /**< 是否已解析 / Whether parsed / Ob geparst */
+} prefetch_job_t;
+
+/**
+ * @brief 链式加载预取器结构体 / Chain loading prefetcher structure / Prefetcher-Struktur für das Kettenladen
+ * @details 任务按发现顺序排队，由后台线程解析，主线程按相同顺序合并 / Jobs are queued in discovery order, parsed by background threads and merged by the calling thread in the same order / Aufträge werden in Entdeckungsreihenfolge eingereiht, von Hintergrund-Threads geparst und vom aufrufenden Thread in derselben Reihenfolge zusammengeführt
+ */
+typedef struct {
+    prefetch_job_t** jobs;                  /**< 任务数组 / Job array / Auftragsarray */
+    size_t job_count;                       /**< 任务数量 / Job count / Auftragsanzahl */
+    size_t job_capacity;                    /**< 任务数组容量 / Job array capacity / Auftragsarray-Kapazität */
+    size_t next_job;                        /**< 下一个待解析任务 / Next job to parse / Nächster zu parsender Auftrag */
+    int stop;                               /**< 停止标志 / Stop flag / Stopp-Flag */
+    nxld_mutex_t mutex;                     /**< 队列互斥锁 / Queue mutex / Warteschlangen-Mutex */
+    nxld_cond_t job_ready;                  /**< 有新任务 / New job available / Neuer Auftrag verfügbar */
+    nxld_cond_t job_done;                   /**< 有任务完成 / A job finished / Ein Auftrag ist fertig */
+    nxld_thread_t threads[PREFETCH_MAX_THREADS];  /**< 预取线程 / Prefetch threads / Prefetch-Threads */
+    size_t thread_count;                    /**< 已启动线程数量 / Started thread count / Anzahl gestarteter Threads */
+    size_t thread_limit;                    /**< 线程数量上限 / Thread count limit / Obergrenze der Thread-Anzahl */
+} prefetcher_t;
+
+/**
+ * @brief 确保规则数组容量 / Ensure rule array capacity / Regelarray-Kapazität sicherstellen
+ * @param rules 规则数组指针 / Rule array pointer / Regelarray-Zeiger
+ * @param capacity 容量指针 / Capacity pointer / Kapazitätszeiger
+ * @param needed 所需规则数量 / Required rule count / Benötigte Regelanzahl
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+static int ensure_rule_capacity(nxld_transfer_rule_t** rules, size_t* capacity, size_t needed) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = *capacity == 0 ? 16 : *capacity * 2;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    nxld_transfer_rule_t* new_rules = (nxld_transfer_rule_t*)realloc(*rules, new_capacity * sizeof(nxld_transfer_rule_t));
+    if (new_rules == NULL) {
+        return -1;
+    }
+
+    *rules = new_rules;
+    *capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * @brief 检查文件是否已加载 / Check whether file is already loaded / Prüfen, ob Datei bereits geladen ist
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param path 已解析文件路径 / Resolved file path / Aufgelöster Dateipfad
+ * @return 已加载返回1，否则返回0 / Returns 1 if loaded, 0 otherwise / Gibt 1 zurück, wenn geladen, sonst 0
+ */
+static int is_file_loaded(const nxld_transfer_rule_set_t* set, const char* path) {
+    return nxld_string_index_get(&set->file_lookup, path) != NXLD_STRING_INDEX_NOT_FOUND;
+}
+
+/**
+ * @brief 记录已加载文件 / Record loaded file / Geladene Datei vermerken
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param path 已解析文件路径 / Resolved file path / Aufgelöster Dateipfad
+ * @return 成功返回文件索引，失败返回-1 / Returns file index on success, -1 on failure / Gibt Dateiindex bei Erfolg zurück, -1 bei Fehler
+ */
+static long add_loaded_file(nxld_transfer_rule_set_t* set, const char* path) {
+    if (set->loaded_file_count >= set->loaded_file_capacity) {
+        size_t new_capacity = set->loaded_file_capacity == 0 ? 8 : set->loaded_file_capacity * 2;
+        char** new_files = (char**)realloc(set->loaded_files, new_capacity * sizeof(char*));
+        if (new_files == NULL) {
+            return -1;
+        }
+        set->loaded_files = new_files;
+        set->loaded_file_capacity = new_capacity;
+    }
+
+    set->loaded_files[set->loaded_file_count] = duplicate_string(path);
+    if (set->loaded_files[set->loaded_file_count] == NULL ||
+        nxld_string_index_set(&set->file_lookup, path, set->loaded_file_count) != 0) {
+        free(set->loaded_files[set->loaded_file_count]);
+        return -1;
+    }
+    return (long)set->loaded_file_count++;
+}
+
+/**
+ * @brief 释放解析结果 / Free parse result / Parse-Ergebnis freigeben
+ * @param parsed 解析结果指针 / Parse result pointer / Parse-Ergebnis-Zeiger
+ */
+static void free_parsed_file(parsed_file_t* parsed) {
+    for (size_t i = 0; i < parsed->rule_count; i++) {
+        free_rule(&parsed->rules[i]);
+    }
+    free(parsed->rules);
+    free(parsed->entry_plugin_name);
+    free(parsed->entry_plugin_path);
+    free(parsed->entry_nxpt_path);
+    memset(parsed, 0, sizeof(parsed_file_t));
+}
+
+/**
+ * @brief 读取单个.nxpt文件中的规则 / Read the rules of a single .nxpt file / Regeln einer einzelnen .nxpt-Datei lesen
+ */
+static nxld_transfer_rules_result_t read_rules_file(const char* full_path, parsed_file_t* parsed) {
+    memset(parsed, 0, sizeof(parsed_file_t));
+    parsed->declared_count = -1;
+    parsed->warmup_policy = -1;
+    parsed->metrics_enabled = -1;
+    parsed->memoize_enabled = -1;
+
+    FILE* file = fopen(full_path, "r");
+    if (file == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Failed to open transfer rules file: %s", full_path);
+        return NXLD_TRANSFER_RULES_FILE_ERROR;
+    }
+
+    char line[MAX_LINE_LENGTH];
+    char section[MAX_SECTION_NAME] = {0};
+    char key[MAX_KEY_LENGTH];
+    char value[MAX_VALUE_LENGTH];
+    nxld_transfer_rule_t* current_rule = NULL;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char* trimmed_line = trim_whitespace(line);
+
+        if (trimmed_line[0] == '\0' || trimmed_line[0] == '#') {
+            continue;
+        }
+
+        if (trimmed_line[0] == '[') {
+            current_rule = NULL;
+            if (!parse_section_name(trimmed_line, section)) {
+                section[0] = '\0';
+                continue;
+            }
+
+            if (strncmp(section, RULE_SECTION_PREFIX, strlen(RULE_SECTION_PREFIX)) == 0) {
+                if (ensure_rule_capacity(&parsed->rules, &parsed->rule_capacity, parsed->rule_count + 1) != 0) {
+                    fclose(file);
+                    free_parsed_file(parsed);
+                    NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for transfer rule array");
+                    return NXLD_TRANSFER_RULES_MEMORY_ERROR;
+                }
+                current_rule = &parsed->rules[parsed->rule_count++];
+                memset(current_rule, 0, sizeof(nxld_transfer_rule_t));
+                current_rule->enabled = 1;
+                current_rule->rule_index = (size_t)atoi(section + strlen(RULE_SECTION_PREFIX));
+            }
+            continue;
+        }
+
+        if (!parse_key_value(trimmed_line, key, value)) {
+            continue;
+        }
+
+        if (current_rule != NULL) {
+            if (set_rule_field(current_rule, key, value) != 0) {
+                fclose(file);
+                free_parsed_file(parsed);
+                NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for transfer rule field %s", key);
+                return NXLD_TRANSFER_RULES_MEMORY_ERROR;
+            }
+        } else if (strcmp(section, "TransferRules") == 0 && strcmp(key, "Count") == 0) {
+            parsed->declared_count = atoi(value);
+        } else if (strcmp(section, "EntryPlugin") == 0) {
+            char** field = NULL;
+            if (strcmp(key, "PluginName") == 0) {
+                field = &parsed->entry_plugin_name;
+            } else if (strcmp(key, "PluginPath") == 0) {
+                field = &parsed->entry_plugin_path;
+            } else if (strcmp(key, "NxptPath") == 0) {
+                field = &parsed->entry_nxpt_path;
+            } else if (strcmp(key, "WarmupPolicy") == 0) {
+                parsed->warmup_policy = parse_warmup_policy(value);
+                if (parsed->warmup_policy < 0) {
+                    NXLD_LOG_WARNING(NXLD_LOG_MODULE_LOADER, "Unknown WarmupPolicy '%s' in %s, using predictive", value, full_path);
+                }
+            } else if (strcmp(key, "Metrics") == 0) {
+                parsed->metrics_enabled = (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0);
+            } else if (strcmp(key, "Memoize") == 0) {
+                parsed->memoize_enabled = (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0);
+            } else if (strcmp(key, "MetricsSampling") == 0) {
+                parsed->metrics_sampling = atoi(value);
+                if (parsed->metrics_sampling <= 0) {
+                    NXLD_LOG_WARNING(NXLD_LOG_MODULE_LOADER, "Invalid MetricsSampling '%s' in %s, using %d", value, full_path, DEFAULT_METRICS_SAMPLING);
+                    parsed->metrics_sampling = 0;
+                }
+            }
+            if (field != NULL) {
+                free(*field);
+                *field = duplicate_string(value);
+                if (*field == NULL) {
+                    fclose(file);
+                    free_parsed_file(parsed);
+                    NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for entry plugin field %s", key);
+                    return NXLD_TRANSFER_RULES_MEMORY_ERROR;
+                }
+            }
+        }
+    }
+
+    fclose(file);
+    return NXLD_TRANSFER_RULES_SUCCESS;
+}
+
+/**
+ * @brief 解析单个.nxpt文件 / Parse a single .nxpt file / Einzelne .nxpt-Datei parsen
+ * @param full_path 已解析文件路径 / Resolved file path / Aufgelöster Dateipfad
+ * @param parsed 输出解析结果 / Output parse result / Ausgabe-Parse-Ergebnis
+ * @return 解析结果 / Parse result / Parse-Ergebnis
+ * @details 不访问规则集合，可在预取线程中调用 / Does not touch the rule set, so it can run on prefetch threads / Greift nicht auf den Regelsatz zu und kann daher in Prefetch-Threads laufen
+ */
+static nxld_transfer_rules_result_t parse_file(const char* full_path, parsed_file_t* parsed) {
+    uint64_t start = nxld_trace_begin();
+    nxld_transfer_rules_result_t result = read_rules_file(full_path, parsed);
+    nxld_trace_end("nxpt", "parse .nxpt", start, full_path);
+    return result;
+}
+
+/**
+ * @brief 将解析结果合并到规则集合 / Merge parse result into the rule set / Parse-Ergebnis in den Regelsatz übernehmen
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param full_path 已解析文件路径 / Resolved file path / Aufgelöster Dateipfad
+ * @param parsed 解析结果（规则所有权转移到集合） / Parse result (rule ownership moves to the set) / Parse-Ergebnis (Regelbesitz geht auf den Satz über)
+ * @return 合并结果 / Merge result / Zusammenführungsergebnis
+ */
+static nxld_transfer_rules_result_t merge_parsed_file(nxld_transfer_rule_set_t* set, const char* full_path, parsed_file_t* parsed) {
+    uint64_t start = nxld_trace_begin();
+    long file_index = add_loaded_file(set, full_path);
+    if (file_index < 0) {
+        free_parsed_file(parsed);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for loaded transfer rules file list");
+        return NXLD_TRANSFER_RULES_MEMORY_ERROR;
+    }
+
+    if (ensure_rule_capacity(&set->rules, &set->rule_capacity, set->rule_count + parsed->rule_count) != 0) {
+        free_parsed_file(parsed);
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for transfer rule array");
+        return NXLD_TRANSFER_RULES_MEMORY_ERROR;
+    }
+
+    for (size_t i = 0; i < parsed->rule_count; i++) {
+        nxld_transfer_rule_t* rule = &set->rules[set->rule_count + i];
+        *rule = parsed->rules[i];
+        rule->file_index = (size_t)file_index;
+    }
+    set->rule_count += parsed->rule_count;
+
+    char** entry_fields[3] = { &set->entry_plugin_name, &set->entry_plugin_path, &set->entry_nxpt_path };
+    char** parsed_fields[3] = { &parsed->entry_plugin_name, &parsed->entry_plugin_path, &parsed->entry_nxpt_path };
+    for (size_t i = 0; i < 3; i++) {
+        if (*parsed_fields[i] != NULL) {
+            free(*entry_fields[i]);
+            *entry_fields[i] = *parsed_fields[i];
+            *parsed_fields[i] = NULL;
+        }
+    }
+
+    if (parsed->warmup_policy >= 0) {
+        set->warmup_policy = (nxld_warmup_policy_t)parsed->warmup_policy;
+    }
+    if (parsed->metrics_enabled >= 0) {
+        set->metrics_enabled = parsed->metrics_enabled;
+    }
+    if (parsed->metrics_sampling > 0) {
+        set->metrics_sampling = (unsigned int)parsed->metrics_sampling;
+    }
+    if (parsed->memoize_enabled >= 0) {
+        set->memoize_enabled = parsed->memoize_enabled;
+    }
+
+    if (parsed->declared_count >= 0 && (size_t)parsed->declared_count != parsed->rule_count) {
+        NXLD_LOG_WARNING(NXLD_LOG_MODULE_LOADER, "Transfer rules file %s declares Count=%d but contains %zu rules", full_path, parsed->declared_count, parsed->rule_count);
+    }
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_LOADER, "Loaded %zu transfer rules from %s", parsed->rule_count, full_path);
+
+    // 规则字段已转移，只释放数组 / Rule fields were moved, only the array is freed / Regelfelder wurden übernommen, nur das Array wird freigegeben
+    free(parsed->rules);
+    memset(parsed, 0, sizeof(parsed_file_t));
+    nxld_trace_end("nxpt", "merge .nxpt", start, full_path);
+    return NXLD_TRANSFER_RULES_SUCCESS;
+}
+
+/**
+ * @brief 预取线程函数 / Prefetch thread function / Prefetch-Thread-Funktion
+ */
+static void prefetch_worker(void* arg) {
+    prefetcher_t* prefetcher = (prefetcher_t*)arg;
+    nxld_trace_thread_name(".nxpt prefetch");
+
+    nxld_mutex_lock(&prefetcher->mutex);
+    for (;;) {
+        while (!prefetcher->stop && prefetcher->next_job >= prefetcher->job_count) {
+            nxld_cond_wait(&prefetcher->job_ready, &prefetcher->mutex);
+        }
+        if (prefetcher->stop) {
+            break;
+        }
+
+        prefetch_job_t* job = prefetcher->jobs[prefetcher->next_job++];
+        nxld_mutex_unlock(&prefetcher->mutex);
+
+        job->result = parse_file(job->path, &job->parsed);
+
+        nxld_mutex_lock(&prefetcher->mutex);
+        job->done = 1;
+        nxld_cond_broadcast(&prefetcher->job_done);
+    }
+    nxld_mutex_unlock(&prefetcher->mutex);
+}
+
+/**
+ * @brief 初始化预取器 / Initialize prefetcher / Prefetcher initialisieren
+ */
+static void prefetcher_init(prefetcher_t* prefetcher) {
+    memset(prefetcher, 0, sizeof(prefetcher_t));
+    nxld_mutex_init(&prefetcher->mutex);
+    nxld_cond_init(&prefetcher->job_ready);
+    nxld_cond_init(&prefetcher->job_done);
+
+    size_t cpu_count = nxld_thread_cpu_count();
+    prefetcher->thread_limit = cpu_count < PREFETCH_MAX_THREADS ? cpu_count : PREFETCH_MAX_THREADS;
+}
+
+/**
+ * @brief 将文件加入预取队列 / Queue file for prefetching / Datei zum Vorabladen einreihen
+ * @return 成功返回0，内存错误返回-1 / Returns 0 on success, -1 on memory error / Gibt 0 bei Erfolg zurück, -1 bei Speicherfehler
+ * @details 线程按需启动；无法启动线程时由调用线程在合并前自行解析 / Threads start on demand; if none can be started the calling thread parses the file itself before merging / Threads starten bei Bedarf; kann keiner gestartet werden, parst der aufrufende Thread die Datei vor dem Zusammenführen selbst
+ */
+static int prefetcher_enqueue(prefetcher_t* prefetcher, const char* path, size_t rule) {
+    prefetch_job_t* job = (prefetch_job_t*)calloc(1, sizeof(prefetch_job_t));
+    if (job == NULL || (job->path = duplicate_string(path)) == NULL) {
+        free(job);
+        return -1;
+    }
+    job->rule = rule;
+
+    nxld_mutex_lock(&prefetcher->mutex);
+    if (prefetcher->job_count >= prefetcher->job_capacity) {
+        size_t new_capacity = prefetcher->job_capacity == 0 ? 16 : prefetcher->job_capacity * 2;
+        prefetch_job_t** new_jobs = (prefetch_job_t**)realloc(prefetcher->jobs, new_capacity * sizeof(prefetch_job_t*));
+        if (new_jobs == NULL) {
+            nxld_mutex_unlock(&prefetcher->mutex);
+            free(job->path);
+            free(job);
+            return -1;
+        }
+        prefetcher->jobs = new_jobs;
+        prefetcher->job_capacity = new_capacity;
+    }
+    prefetcher->jobs[prefetcher->job_count++] = job;
+    size_t pending = prefetcher->job_count - prefetcher->next_job;
+    nxld_cond_signal(&prefetcher->job_ready);
+    nxld_mutex_unlock(&prefetcher->mutex);
+
+    if (prefetcher->thread_count < prefetcher->thread_limit && pending > prefetcher->thread_count) {
+        if (nxld_thread_create(&prefetcher->threads[prefetcher->thread_count], prefetch_worker, prefetcher) == 0) {
+            prefetcher->thread_count++;
+        } else {
+            prefetcher->thread_limit = prefetcher->thread_count;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 等待指定任务解析完成 / Wait until the given job is parsed / Warten, bis der angegebene Auftrag geparst ist
+ * @details 任务尚未被线程领取时由调用线程自行解析 / Parses the job on the calling thread if no thread has claimed it yet / Parst den Auftrag im aufrufenden Thread, wenn noch kein Thread ihn übernommen hat
+ */
+static prefetch_job_t* prefetcher_wait(prefetcher_t* prefetcher, size_t index) {
+    prefetch_job_t* job = prefetcher->jobs[index];
+
+    nxld_mutex_lock(&prefetcher->mutex);
+    if (!job->done && prefetcher->next_job == index) {
+        prefetcher->next_job++;
+        nxld_mutex_unlock(&prefetcher->mutex);
+        job->result = parse_file(job->path, &job->parsed);
+        nxld_mutex_lock(&prefetcher->mutex);
+        job->done = 1;
+    }
+    while (!job->done) {
+        nxld_cond_wait(&prefetcher->job_done, &prefetcher->mutex);
+    }
+    nxld_mutex_unlock(&prefetcher->mutex);
+    return job;
+}
+
+/**
+ * @brief 停止预取线程并释放未合并的任务 / Stop prefetch threads and free unmerged jobs / Prefetch-Threads stoppen und nicht zusammengeführte Aufträge freigeben
+ */
+static void prefetcher_shutdown(prefetcher_t* prefetcher) {
+    nxld_mutex_lock(&prefetcher->mutex);
+    prefetcher->stop = 1;
+    nxld_cond_broadcast(&prefetcher->job_ready);
+    nxld_mutex_unlock(&prefetcher->mutex);
+
+    for (size_t i = 0; i < prefetcher->thread_count; i++) {
+        nxld_thread_join(prefetcher->threads[i]);
+    }
+
+    for (size_t i = 0; i < prefetcher->job_count; i++) {
+        free_parsed_file(&prefetcher->jobs[i]->parsed);
+        free(prefetcher->jobs[i]->path);
+        free(prefetcher->jobs[i]);
+    }
+    free(prefetcher->jobs);
+
+    nxld_cond_destroy(&prefetcher->job_done);
+    nxld_cond_destroy(&prefetcher->job_ready);
+    nxld_mutex_destroy(&prefetcher->mutex);
+}
+
+int nxld_transfer_rules_init(nxld_transfer_rule_set_t* set, const char* base_dir) {
+    if (set == NULL) {
+        return -1;
+    }
+
+    memset(set, 0, sizeof(nxld_transfer_rule_set_t));
+    nxld_string_index_init(&set->file_lookup);
+    set->metrics_enabled = 1;
+    set->metrics_sampling = DEFAULT_METRICS_SAMPLING;
+    set->memoize_enabled = 1;
+    if (base_dir != NULL) {
+        set->base_dir = duplicate_string(base_dir);
+        if (set->base_dir == NULL) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed for transfer rule base directory");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+nxld_transfer_rules_result_t nxld_transfer_rules_load_file(nxld_transfer_rule_set_t* set, const char* nxpt_path) {
+    if (set == NULL || nxpt_path == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Invalid parameters for transfer rule loading");
+        return NXLD_TRANSFER_RULES_FILE_ERROR;
+    }
+
+    char full_path[MAX_PATH_LENGTH];
+    if (!resolve_path(set->base_dir, nxpt_path, full_path, sizeof(full_path))) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Failed to resolve transfer rules file path: %s", nxpt_path);
+        return NXLD_TRANSFER_RULES_FILE_ERROR;
+    }
+
+    if (is_file_loaded(set, full_path)) {
+        return NXLD_TRANSFER_RULES_SUCCESS;
+    }
+
+    parsed_file_t parsed;
+    nxld_transfer_rules_result_t result = parse_file(full_path, &parsed);
+    if (result != NXLD_TRANSFER_RULES_SUCCESS) {
+        return result;
+    }
+    return merge_parsed_file(set, full_path, &parsed);
+}
+
+nxld_transfer_rules_result_t nxld_transfer_rules_load_chain(nxld_transfer_rule_set_t* set, const char* entry_config_path) {
+    if (set == NULL || entry_config_path == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Invalid parameters for transfer rule chain loading");
+        return NXLD_TRANSFER_RULES_FILE_ERROR;
+    }
+
+    nxld_transfer_rules_result_t result = nxld_transfer_rules_load_file(set, entry_config_path);
+    if (result != NXLD_TRANSFER_RULES_SUCCESS) {
+        return result;
+    }
+
+    if (set->entry_plugin_name == NULL || set->entry_nxpt_path == NULL) {
+        NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Entry plugin config incomplete in %s", entry_config_path);
+        return NXLD_TRANSFER_RULES_ENTRY_MISSING;
+    }
+
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_LOADER, "Loading entry plugin .nxpt file: %s", set->entry_nxpt_path);
+    result = nxld_transfer_rules_load_file(set, set->entry_nxpt_path);
+    if (result != NXLD_TRANSFER_RULES_SUCCESS) {
+        return result;
+    }
+
+    prefetcher_t prefetcher;
+    prefetcher_init(&prefetcher);
+    nxld_string_index_t seen_files;
+    nxld_string_index_init(&seen_files);
+    size_t scanned = 0;
+    size_t merged = 0;
+
+    // 扫描新合并的规则并立即预取发现的文件，再按发现顺序合并 / Scan newly merged rules and prefetch discovered files at once, then merge them in discovery order / Neu übernommene Regeln durchsuchen und entdeckte Dateien sofort vorab laden, dann in Entdeckungsreihenfolge zusammenführen
+    while (result == NXLD_TRANSFER_RULES_SUCCESS) {
+        for (; scanned < set->rule_count && result == NXLD_TRANSFER_RULES_SUCCESS; scanned++) {
+            const nxld_transfer_rule_t* rule = &set->rules[scanned];
+            if (rule->target_plugin_path == NULL) {
+                continue;
+            }
+
+            char nxpt_path[MAX_PATH_LENGTH];
+            char full_path[MAX_PATH_LENGTH];
+            if (!nxld_transfer_rules_build_nxpt_path(rule->target_plugin_path, nxpt_path, sizeof(nxpt_path)) ||
+                !resolve_path(set->base_dir, nxpt_path, full_path, sizeof(full_path))) {
+                NXLD_LOG_WARNING(NXLD_LOG_MODULE_LOADER, "Failed to build .nxpt path for plugin %s", rule->target_plugin_path);
+                continue;
+            }
+
+            if (nxld_string_index_get(&seen_files, full_path) != NXLD_STRING_INDEX_NOT_FOUND) {
+                continue;
+            }
+            if (nxld_string_index_set(&seen_files, full_path, scanned) != 0) {
+                result = NXLD_TRANSFER_RULES_MEMORY_ERROR;
+                break;
+            }
+            if (is_file_loaded(set, full_path) || access(full_path, F_OK) != 0) {
+                continue;
+            }
+
+            NXLD_LOG_DEBUG(NXLD_LOG_MODULE_LOADER, "Chain loading .nxpt file for plugin %s: %s", rule->target_plugin, full_path);
+            if (prefetcher_enqueue(&prefetcher, full_path, scanned) != 0) {
+                result = NXLD_TRANSFER_RULES_MEMORY_ERROR;
+            }
+        }
+
+        if (result != NXLD_TRANSFER_RULES_SUCCESS || merged == prefetcher.job_count) {
+            break;
+        }
+
+        prefetch_job_t* job = prefetcher_wait(&prefetcher, merged++);
+        if (job->result == NXLD_TRANSFER_RULES_SUCCESS) {
+            result = merge_parsed_file(set, job->path, &job->parsed);
+        } else if (job->result == NXLD_TRANSFER_RULES_MEMORY_ERROR) {
+            result = job->result;
+        } else {
+            NXLD_LOG_WARNING(NXLD_LOG_MODULE_LOADER, "Failed to load .nxpt file for plugin %s: %s", set->rules[job->rule].target_plugin, job->path);
+        }
+    }
+
+    prefetcher_shutdown(&prefetcher);
+    nxld_string_index_free(&seen_files);
+    if (result != NXLD_TRANSFER_RULES_SUCCESS) {
+        if (result == NXLD_TRANSFER_RULES_MEMORY_ERROR) {
+            NXLD_LOG_ERROR(NXLD_LOG_MODULE_LOADER, "Memory allocation failed while chain loading transfer rules");
+        }
+        return result;
+    }
+
+    NXLD_LOG_INFO(NXLD_LOG_MODULE_LOADER, "Chain loading finished: %zu rules from %zu files", set->rule_count, set->loaded_file_count);
+    return NXLD_TRANSFER_RULES_SUCCESS;
+}
+
+void nxld_transfer_rules_free(nxld_transfer_rule_set_t* set) {
+    if (set == NULL) {
+        return;
+    }
+
+    if (set->rules != NULL) {
+        for (size_t i = 0; i < set->rule_count; i++) {
+            free_rule(&set->rules[i]);
+        }
+        free(set->rules);
+    }
+
+    if (set->loaded_files != NULL) {
+        for (size_t i = 0; i < set->loaded_file_count; i++) {
+            free(set->loaded_files[i]);
+        }
+        free(set->loaded_files);
+    }
+
+    free(set->base_dir);
+    free(set->entry_plugin_name);
+    free(set->entry_plugin_path);
+    free(set->entry_nxpt_path);
+    nxld_string_index_free(&set->file_lookup);
+    memset(set, 0, sizeof(nxld_transfer_rule_set_t));
+}
+
+int nxld_transfer_rules_build_nxpt_path(const char* plugin_path, char* nxpt_path, size_t nxpt_path_size) {
+    if (plugin_path == NULL || nxpt_path == NULL) {
+        return 0;
+    }
+
+    const char* ext_pos = strrchr(plugin_path, '.');
+    const char* last_slash = strrchr(plugin_path, '/');
+    const char* last_backslash = strrchr(plugin_path, '\\');
+    if (last_backslash != NULL && (last_slash == NULL || last_backslash > last_slash)) {
+        last_slash = last_backslash;
+    }
+
+    size_t base_len = strlen(plugin_path);
+    if (ext_pos != NULL && (last_slash == NULL || ext_pos > last_slash)) {
+        base_len = ext_pos - plugin_path;
+    }
+
+    if (base_len + 6 > nxpt_path_size) {
+        return 0;
+    }
+
+    memcpy(nxpt_path, plugin_path, base_len);
+    memcpy(nxpt_path + base_len, ".nxpt", 6);
+    return 1;
+}
+
+int nxld_transfer_rules_resolve_path(const nxld_transfer_rule_set_t* set, const char* path, char* full_path, size_t full_path_size) {
+    if (set == NULL) {
+        return 0;
+    }
+    return resolve_path(set->base_dir, path, full_path, full_path_size);
+}
+
+const char* nxld_transfer_rules_get_error_message(nxld_transfer_rules_result_t result) {
+    switch (result) {
+        case NXLD_TRANSFER_RULES_SUCCESS:
+            return "Transfer rules loaded successfully";
+        case NXLD_TRANSFER_RULES_FILE_ERROR:
+            return "Failed to read transfer rules file";
+        case NXLD_TRANSFER_RULES_ENTRY_MISSING:
+            return "Entry plugin config is missing or incomplete";
+        case NXLD_TRANSFER_RULES_MEMORY_ERROR:
+            return "Memory allocation error";
+        default:
+            return "Unknown error";
+    }
+}
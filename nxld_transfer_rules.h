@@ -0,0 +1,156 @@
+/**
+ * @file nxld_transfer_rules.h
+ * @brief NXLD传递规则文件解析接口 / NXLD Transfer Rule File Parsing Interface / NXLD-Übertragungsregeldatei-Parsing-Schnittstelle
+ * @details 解析.nxpt传递规则文件并按入口插件链式加载 / Parses .nxpt transfer rule files and chain loads them from the entry plugin / Parst .nxpt-Übertragungsregeldateien und lädt sie kettenweise ab dem Einstiegs-Plugin
+ */
+
+#ifndef NXLD_TRANSFER_RULES_H
+#define NXLD_TRANSFER_RULES_H
+
+#include <stddef.h>
+#include "nxld_condition.h"
+#include "nxld_string_index.h"
+
+/**
+ * @brief 传递模式枚举 / Transfer mode enumeration / Übertragungsmodus-Aufzählung
+ */
+typedef enum {
+    NXLD_TRANSFER_MODE_UNICAST = 0,        /**< 单播 / Unicast / Unicast */
+    NXLD_TRANSFER_MODE_BROADCAST,          /**< 广播 / Broadcast / Broadcast */
+    NXLD_TRANSFER_MODE_MULTICAST,          /**< 组播 / Multicast / Multicast */
+    NXLD_TRANSFER_MODE_STREAM              /**< 流式分块传递 / Streaming chunked transfer / Gestreamte Blockübertragung */
+} nxld_transfer_mode_t;
+
+/**
+ * @brief 传递条件枚举 / Transfer condition enumeration / Übertragungsbedingungs-Aufzählung
+ */
+typedef enum {
+    NXLD_TRANSFER_CONDITION_NONE = 0,      /**< 无条件 / No condition / Keine Bedingung */
+    NXLD_TRANSFER_CONDITION_PREDICATE,     /**< 已编译谓词 / Compiled predicate / Kompiliertes Prädikat */
+    NXLD_TRANSFER_CONDITION_UNKNOWN        /**< 无法编译的条件 / Condition that failed to compile / Nicht kompilierbare Bedingung */
+} nxld_transfer_condition_t;
+
+/**
+ * @brief 目标插件预热策略枚举 / Target plugin warm-up policy enumeration / Aufzählung der Aufwärmrichtlinie für Ziel-Plugins
+ */
+typedef enum {
+    NXLD_WARMUP_PREDICTIVE = 0,            /**< 后台预热从入口可达的插件（默认） / Warm plugins reachable from the entry in the background (default) / Vom Einstieg erreichbare Plugins im Hintergrund aufwärmen (Standard) */
+    NXLD_WARMUP_EAGER,                     /**< 首次调用前同步预热计划中的所有插件 / Warm every plugin in the plan synchronously before the first call / Alle Plugins des Plans vor dem ersten Aufruf synchron aufwärmen */
+    NXLD_WARMUP_LAZY                       /**< 仅在首次调用时加载 / Load only on first call / Nur beim ersten Aufruf laden */
+} nxld_warmup_policy_t;
+
+/**
+ * @brief 传递规则结构体 / Transfer rule structure / Übertragungsregelstruktur
+ */
+typedef struct {
+    char* source_plugin;                    /**< 源插件名称（常量规则为NULL） / Source plugin name (NULL for constant rules) / Quell-Plugin-Name (NULL bei Konstantenregeln) */
+    char* source_interface;                 /**< 源接口名称 / Source interface name / Quellschnittstellenname */
+    int source_param_index;                 /**< 源参数索引（-1表示主动调用规则） / Source parameter index (-1 for active call rules) / Quellparameterindex (-1 für aktive Aufrufregeln) */
+    char* target_plugin;                    /**< 目标插件名称 / Target plugin name / Ziel-Plugin-Name */
+    char* target_plugin_path;               /**< 目标插件路径 / Target plugin path / Ziel-Plugin-Pfad */
+    char* target_interface;                 /**< 目标接口名称 / Target interface name / Zielschnittstellenname */
+    int target_param_index;                 /**< 目标参数索引 / Target parameter index / Zielparameterindex */
+    char* target_param_value;               /**< 目标参数常量值（未设置或为空时为NULL） / Target parameter constant value (NULL when unset or empty) / Zielparameter-Konstantenwert (NULL wenn nicht gesetzt oder leer) */
+    char* condition;                        /**< 条件字符串 / Condition string / Bedingungszeichenfolge */
+    nxld_transfer_condition_t condition_type; /**< 条件类型 / Condition type / Bedingungstyp */
+    nxld_condition_t predicate;             /**< 加载时编译的谓词 / Predicate compiled at load time / Beim Laden kompiliertes Prädikat */
+    char* description;                      /**< 规则描述 / Rule description / Regelbeschreibung */
+    char* multicast_group;                  /**< 组播组名称 / Multicast group name / Multicast-Gruppenname */
+    nxld_transfer_mode_t transfer_mode;     /**< 传递模式 / Transfer mode / Übertragungsmodus */
+    int enabled;                            /**< 是否启用 / Whether enabled / Ob aktiviert */
+    size_t stream_chunk_bytes;              /**< 流分块容量（字节，0表示默认） / Stream chunk capacity in bytes (0 for default) / Stream-Blockkapazität in Bytes (0 für Standard) */
+    size_t stream_depth;                    /**< 流环分块数量（0表示默认） / Stream ring chunk count (0 for default) / Anzahl der Blöcke im Stream-Ring (0 für Standard) */
+    size_t file_index;                      /**< 所属文件索引 / Owning file index / Index der zugehörigen Datei */
+    size_t rule_index;                      /**< 文件内规则索引 / Rule index within file / Regelindex innerhalb der Datei */
+} nxld_transfer_rule_t;
+
+/**
+ * @brief 传递规则集合结构体 / Transfer rule set structure / Übertragungsregelsatz-Struktur
+ */
+typedef struct {
+    nxld_transfer_rule_t* rules;            /**< 规则数组 / Rule array / Regelarray */
+    size_t rule_count;                      /**< 规则数量 / Rule count / Regelanzahl */
+    size_t rule_capacity;                   /**< 规则数组容量 / Rule array capacity / Regelarray-Kapazität */
+    char** loaded_files;                    /**< 已加载的.nxpt文件路径 / Loaded .nxpt file paths / Geladene .nxpt-Dateipfade */
+    size_t loaded_file_count;               /**< 已加载文件数量 / Loaded file count / Anzahl geladener Dateien */
+    size_t loaded_file_capacity;            /**< 已加载文件数组容量 / Loaded file array capacity / Kapazität des Arrays geladener Dateien */
+    char* base_dir;                         /**< 相对路径解析目录 / Directory for resolving relative paths / Verzeichnis zur Auflösung relativer Pfade */
+    char* entry_plugin_name;                /**< 入口插件名称 / Entry plugin name / Einstiegs-Plugin-Name */
+    char* entry_plugin_path;                /**< 入口插件路径 / Entry plugin path / Einstiegs-Plugin-Pfad */
+    char* entry_nxpt_path;                  /**< 入口插件.nxpt路径 / Entry plugin .nxpt path / .nxpt-Pfad des Einstiegs-Plugins */
+    nxld_warmup_policy_t warmup_policy;     /**< [EntryPlugin] WarmupPolicy / [EntryPlugin] WarmupPolicy / [EntryPlugin] WarmupPolicy */
+    int metrics_enabled;                    /**< [EntryPlugin] Metrics（默认启用） / [EntryPlugin] Metrics (enabled by default) / [EntryPlugin] Metrics (standardmäßig aktiviert) */
+    unsigned int metrics_sampling;          /**< [EntryPlugin] MetricsSampling，每隔多少次调用计时一次 / [EntryPlugin] MetricsSampling, time one call in this many / [EntryPlugin] MetricsSampling, jeden so vielten Aufruf messen */
+    int memoize_enabled;                    /**< [EntryPlugin] Memoize，缓存纯接口的结果（默认启用） / [EntryPlugin] Memoize, cache results of pure interfaces (enabled by default) / [EntryPlugin] Memoize, Ergebnisse reiner Schnittstellen zwischenspeichern (standardmäßig aktiviert) */
+    nxld_string_index_t file_lookup;        /**< 已加载文件路径索引 / Index of loaded file paths / Index der geladenen Dateipfade */
+} nxld_transfer_rule_set_t;
+
+/**
+ * @brief 规则加载结果枚举 / Rule load result enumeration / Regelladeergebnis-Aufzählung
+ */
+typedef enum {
+    NXLD_TRANSFER_RULES_SUCCESS = 0,       /**< 加载成功 / Load successful / Laden erfolgreich */
+    NXLD_TRANSFER_RULES_FILE_ERROR,        /**< 文件读取错误 / File read error / Dateilesefehler */
+    NXLD_TRANSFER_RULES_ENTRY_MISSING,     /**< 缺少入口插件配置 / Entry plugin config missing / Einstiegs-Plugin-Konfiguration fehlt */
+    NXLD_TRANSFER_RULES_MEMORY_ERROR       /**< 内存分配错误 / Memory allocation error / Speicherzuweisungsfehler */
+} nxld_transfer_rules_result_t;
+
+/**
+ * @brief 初始化规则集合 / Initialize rule set / Regelsatz initialisieren
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param base_dir 相对路径解析目录（NULL表示当前目录） / Directory for resolving relative paths (NULL for current directory) / Verzeichnis zur Auflösung relativer Pfade (NULL für aktuelles Verzeichnis)
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_transfer_rules_init(nxld_transfer_rule_set_t* set, const char* base_dir);
+
+/**
+ * @brief 加载单个.nxpt文件 / Load a single .nxpt file / Einzelne .nxpt-Datei laden
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param nxpt_path .nxpt文件路径 / .nxpt file path / .nxpt-Dateipfad
+ * @return 加载结果 / Load result / Ladeergebnis
+ * @details 已加载的文件会被跳过 / Files that were already loaded are skipped / Bereits geladene Dateien werden übersprungen
+ */
+nxld_transfer_rules_result_t nxld_transfer_rules_load_file(nxld_transfer_rule_set_t* set, const char* nxpt_path);
+
+/**
+ * @brief 从指针传递插件配置链式加载所有规则 / Chain load all rules from the pointer transfer plugin config / Alle Regeln ab der Zeigerübertragungs-Plugin-Konfiguration kettenweise laden
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param entry_config_path 含[EntryPlugin]段的.nxpt文件路径 / Path of the .nxpt file containing the [EntryPlugin] section / Pfad der .nxpt-Datei mit dem Abschnitt [EntryPlugin]
+ * @return 加载结果 / Load result / Ladeergebnis
+ * @details 先加载入口插件.nxpt，再按目标插件路径递归加载其.nxpt文件；新发现的文件由后台线程预取解析，合并顺序与串行加载相同 / Loads the entry plugin .nxpt first, then recursively loads the .nxpt files of target plugin paths; newly discovered files are prefetched and parsed on background threads and merged in the same order as serial loading / Lädt zuerst die .nxpt des Einstiegs-Plugins, dann rekursiv die .nxpt-Dateien der Ziel-Plugin-Pfade; neu entdeckte Dateien werden von Hintergrund-Threads vorab gelesen und geparst und in derselben Reihenfolge wie beim seriellen Laden zusammengeführt
+ */
+nxld_transfer_rules_result_t nxld_transfer_rules_load_chain(nxld_transfer_rule_set_t* set, const char* entry_config_path);
+
+/**
+ * @brief 释放规则集合内存 / Free rule set memory / Regelsatz-Speicher freigeben
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ */
+void nxld_transfer_rules_free(nxld_transfer_rule_set_t* set);
+
+/**
+ * @brief 根据插件路径构建.nxpt路径 / Build .nxpt path from plugin path / .nxpt-Pfad aus Plugin-Pfad erstellen
+ * @param plugin_path 插件路径 / Plugin path / Plugin-Pfad
+ * @param nxpt_path 输出.nxpt路径缓冲区 / Output .nxpt path buffer / Ausgabe-.nxpt-Pfad-Puffer
+ * @param nxpt_path_size 缓冲区大小 / Buffer size / Puffergröße
+ * @return 成功返回1，失败返回0 / Returns 1 on success, 0 on failure / Gibt 1 bei Erfolg zurück, 0 bei Fehler
+ */
+int nxld_transfer_rules_build_nxpt_path(const char* plugin_path, char* nxpt_path, size_t nxpt_path_size);
+
+/**
+ * @brief 按规则集合基目录解析路径 / Resolve path against the rule set base directory / Pfad gegen das Basisverzeichnis des Regelsatzes auflösen
+ * @param set 规则集合指针 / Rule set pointer / Regelsatz-Zeiger
+ * @param path 输入路径 / Input path / Eingabepfad
+ * @param full_path 输出完整路径缓冲区 / Output full path buffer / Ausgabe-Vollpfad-Puffer
+ * @param full_path_size 缓冲区大小 / Buffer size / Puffergröße
+ * @return 成功返回1，失败返回0 / Returns 1 on success, 0 on failure / Gibt 1 bei Erfolg zurück, 0 bei Fehler
+ */
+int nxld_transfer_rules_resolve_path(const nxld_transfer_rule_set_t* set, const char* path, char* full_path, size_t full_path_size);
+
+/**
+ * @brief 获取规则加载结果错误信息 / Get rule load result error message / Regelladeergebnis-Fehlermeldung abrufen
+ * @param result 加载结果 / Load result / Ladeergebnis
+ * @return 错误信息字符串 / Error message string / Fehlermeldungszeichenfolge
+ */
+const char* nxld_transfer_rules_get_error_message(nxld_transfer_rules_result_t result);
+
+#endif /* NXLD_TRANSFER_RULES_H */
@@ -0,0 +1,257 @@
+/**
+ * @file nxld_uring.c
+ * @brief NXLD io_uring写入实现 / NXLD io_uring Write Implementation / NXLD-io_uring-Schreibimplementierung
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_uring.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#endif
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+
+/**
+ * @brief io_uring实例结构体 / io_uring instance structure / io_uring-Instanzstruktur
+ * @details 队列头尾由内核和本进程共享，读对方写入的值用获取语义，发布自己的值用释放语义 / Queue heads and tails are shared with the kernel; values written by the other side are read with acquire and our own are published with release / Warteschlangenköpfe und -enden werden mit dem Kernel geteilt; Werte der Gegenseite werden mit Acquire gelesen, eigene mit Release veröffentlicht
+ */
+struct nxld_uring {
+    int fd;                                 /**< io_uring文件描述符 / io_uring file descriptor / io_uring-Dateideskriptor */
+    void* sq_ring;                          /**< 提交队列映射 / Submission queue mapping / Abbildung der Übermittlungswarteschlange */
+    size_t sq_ring_size;                    /**< 提交队列映射大小 / Submission queue mapping size / Größe der Übermittlungswarteschlangen-Abbildung */
+    void* cq_ring;                          /**< 完成队列映射（可能与提交队列相同） / Completion queue mapping (may equal the submission queue) / Abbildung der Abschlusswarteschlange (kann der Übermittlungswarteschlange entsprechen) */
+    size_t cq_ring_size;                    /**< 完成队列映射大小 / Completion queue mapping size / Größe der Abschlusswarteschlangen-Abbildung */
+    struct io_uring_sqe* sqes;              /**< 提交队列条目数组 / Submission queue entries / Einträge der Übermittlungswarteschlange */
+    size_t sqes_size;                       /**< 条目数组映射大小 / Entry array mapping size / Größe der Eintragsarray-Abbildung */
+    unsigned* sq_head;                      /**< 提交队列头（内核写） / Submission queue head (written by the kernel) / Kopf der Übermittlungswarteschlange (vom Kernel geschrieben) */
+    unsigned* sq_tail;                      /**< 提交队列尾 / Submission queue tail / Ende der Übermittlungswarteschlange */
+    unsigned* sq_array;                     /**< 提交队列下标数组 / Submission queue index array / Indexarray der Übermittlungswarteschlange */
+    unsigned sq_mask;                       /**< 提交队列掩码 / Submission queue mask / Maske der Übermittlungswarteschlange */
+    unsigned sq_entries;                    /**< 提交队列条目数量 / Submission queue entry count / Eintragsanzahl der Übermittlungswarteschlange */
+    unsigned* cq_head;                      /**< 完成队列头 / Completion queue head / Kopf der Abschlusswarteschlange */
+    unsigned* cq_tail;                      /**< 完成队列尾（内核写） / Completion queue tail (written by the kernel) / Ende der Abschlusswarteschlange (vom Kernel geschrieben) */
+    unsigned cq_mask;                       /**< 完成队列掩码 / Completion queue mask / Maske der Abschlusswarteschlange */
+    struct io_uring_cqe* cqes;              /**< 完成队列条目数组 / Completion queue entries / Einträge der Abschlusswarteschlange */
+    unsigned pending;                       /**< 已排队未提交的数量 / Queued but not yet submitted / Eingereiht, aber noch nicht eingereicht */
+};
+
+static int uring_enter(int fd, unsigned submit, unsigned wait) {
+    for (;;) {
+        long result = syscall(__NR_io_uring_enter, fd, submit, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (result >= 0 || errno != EINTR) {
+            return (int)result;
+        }
+    }
+}
+
+nxld_uring_t* nxld_uring_create(unsigned entries) {
+    nxld_uring_t* ring = (nxld_uring_t*)calloc(1, sizeof(nxld_uring_t));
+    if (ring == NULL) {
+        return NULL;
+    }
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    // 内核不支持或被seccomp禁止时返回ENOSYS或EPERM / Returns ENOSYS or EPERM when the kernel lacks support or seccomp forbids it / Liefert ENOSYS oder EPERM, wenn der Kernel es nicht unterstützt oder seccomp es verbietet
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    int single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && ring->cq_ring_size > ring->sq_ring_size) {
+        ring->sq_ring_size = ring->cq_ring_size;
+    }
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+                         IORING_OFF_SQ_RING);
+    ring->cq_ring = single_mmap ? ring->sq_ring
+                                : mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                       ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, ring->sqes_size);
+        }
+        if (!single_mmap && ring->cq_ring != MAP_FAILED) {
+            munmap(ring->cq_ring, ring->cq_ring_size);
+        }
+        if (ring->sq_ring != MAP_FAILED) {
+            munmap(ring->sq_ring, ring->sq_ring_size);
+        }
+        close(ring->fd);
+        free(ring);
+        return NULL;
+    }
+    if (single_mmap) {
+        ring->cq_ring_size = 0;
+    }
+    ring->sqes = (struct io_uring_sqe*)sqes;
+
+    char* sq = (char*)ring->sq_ring;
+    char* cq = (char*)ring->cq_ring;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    return ring;
+}
+
+void nxld_uring_destroy(nxld_uring_t* ring) {
+    if (ring == NULL) {
+        return;
+    }
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring_size > 0) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+    free(ring);
+}
+
+int nxld_uring_register_files(nxld_uring_t* ring, const int* fds, unsigned count) {
+    return syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_FILES, fds, count) == 0 ? 0 : -1;
+}
+
+int nxld_uring_register_buffers(nxld_uring_t* ring, void* const* buffers, size_t size, unsigned count) {
+    struct iovec* vectors = (struct iovec*)malloc(count * sizeof(struct iovec));
+    if (vectors == NULL) {
+        return -1;
+    }
+    for (unsigned i = 0; i < count; i++) {
+        vectors[i].iov_base = buffers[i];
+        vectors[i].iov_len = size;
+    }
+    long result = syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, vectors, count);
+    free(vectors);
+    return result == 0 ? 0 : -1;
+}
+
+int nxld_uring_prepare_write(nxld_uring_t* ring, int file, int buffer, const void* data, size_t length,
+                             uint64_t offset, uint64_t user_data) {
+    unsigned tail = *ring->sq_tail;
+    if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->sq_entries) {
+        return -1;
+    }
+
+    unsigned index = tail & ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->fd = file;
+    sqe->addr = (uint64_t)(uintptr_t)data;
+    sqe->len = (uint32_t)length;
+    sqe->off = offset;
+    sqe->buf_index = (uint16_t)buffer;
+    sqe->user_data = user_data;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->pending++;
+    return 0;
+}
+
+int nxld_uring_submit(nxld_uring_t* ring) {
+    if (ring->pending == 0) {
+        return 0;
+    }
+    int submitted = uring_enter(ring->fd, ring->pending, 0);
+    if (submitted > 0) {
+        ring->pending -= (unsigned)submitted;
+    }
+    return submitted;
+}
+
+int nxld_uring_complete(nxld_uring_t* ring, int wait, uint64_t* user_data, int32_t* result) {
+    for (;;) {
+        unsigned head = *ring->cq_head;
+        if (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+            const struct io_uring_cqe* cqe = &ring->cqes[head & ring->cq_mask];
+            *user_data = cqe->user_data;
+            *result = cqe->res;
+            __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+            return 1;
+        }
+        if (!wait) {
+            return 0;
+        }
+        if (uring_enter(ring->fd, 0, 1) < 0) {
+            return -1;
+        }
+    }
+}
+
+#else
+
+// 非Linux平台没有io_uring，调用方使用write() / Non-Linux platforms have no io_uring, callers use write() / Nicht-Linux-Plattformen haben kein io_uring, Aufrufer verwenden write()
+
+nxld_uring_t* nxld_uring_create(unsigned entries) {
+    (void)entries;
+    return NULL;
+}
+
+void nxld_uring_destroy(nxld_uring_t* ring) {
+    (void)ring;
+}
+
+int nxld_uring_register_files(nxld_uring_t* ring, const int* fds, unsigned count) {
+    (void)ring;
+    (void)fds;
+    (void)count;
+    return -1;
+}
+
+int nxld_uring_register_buffers(nxld_uring_t* ring, void* const* buffers, size_t size, unsigned count) {
+    (void)ring;
+    (void)buffers;
+    (void)size;
+    (void)count;
+    return -1;
+}
+
+int nxld_uring_prepare_write(nxld_uring_t* ring, int file, int buffer, const void* data, size_t length,
+                             uint64_t offset, uint64_t user_data) {
+    (void)ring;
+    (void)file;
+    (void)buffer;
+    (void)data;
+    (void)length;
+    (void)offset;
+    (void)user_data;
+    return -1;
+}
+
+int nxld_uring_submit(nxld_uring_t* ring) {
+    (void)ring;
+    return -1;
+}
+
+int nxld_uring_complete(nxld_uring_t* ring, int wait, uint64_t* user_data, int32_t* result) {
+    (void)ring;
+    (void)wait;
+    (void)user_data;
+    (void)result;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file nxld_uring.h
+ * @brief NXLD io_uring写入接口 / NXLD io_uring Write Interface / NXLD-io_uring-Schreibschnittstelle
+ * @details 直接通过系统调用使用Linux io_uring提交写入并收取完成事件，不依赖liburing；其他平台或内核不支持时创建失败，调用方改用write() / Uses Linux io_uring directly through system calls to submit writes and reap completions, without liburing; creation fails on other platforms or unsupported kernels and callers fall back to write() / Verwendet Linux io_uring direkt über Systemaufrufe, um Schreibvorgänge einzureichen und Abschlüsse abzuholen, ohne liburing; auf anderen Plattformen oder nicht unterstützenden Kerneln schlägt die Erstellung fehl und Aufrufer greifen auf write() zurück
+ */
+
+#ifndef NXLD_URING_H
+#define NXLD_URING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief io_uring实例（不透明），只能由一个线程使用 / io_uring instance (opaque), used by a single thread only / io_uring-Instanz (undurchsichtig), nur von einem Thread verwendet
+ */
+typedef struct nxld_uring nxld_uring_t;
+
+/**
+ * @brief 创建io_uring实例 / Create io_uring instance / io_uring-Instanz erstellen
+ * @param entries 提交队列条目数量 / Submission queue entry count / Anzahl der Einträge der Übermittlungswarteschlange
+ * @return 实例指针，io_uring不可用时返回NULL / Instance pointer, NULL when io_uring is unavailable / Instanzzeiger, NULL wenn io_uring nicht verfügbar ist
+ */
+nxld_uring_t* nxld_uring_create(unsigned entries);
+
+/**
+ * @brief 销毁io_uring实例 / Destroy io_uring instance / io_uring-Instanz zerstören
+ * @param ring 实例指针（可为NULL） / Instance pointer (may be NULL) / Instanzzeiger (kann NULL sein)
+ * @details 不等待未完成的写入，调用方须先收取所有完成事件 / Does not wait for outstanding writes, callers reap every completion first / Wartet nicht auf ausstehende Schreibvorgänge, Aufrufer holen zuvor alle Abschlüsse ab
+ */
+void nxld_uring_destroy(nxld_uring_t* ring);
+
+/**
+ * @brief 注册文件描述符 / Register file descriptors / Dateideskriptoren registrieren
+ * @param ring 实例指针 / Instance pointer / Instanzzeiger
+ * @param fds 文件描述符数组，之后按下标引用 / File descriptor array, referenced by index afterwards / Dateideskriptor-Array, danach per Index referenziert
+ * @param count 数量 / Count / Anzahl
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int nxld_uring_register_files(nxld_uring_t* ring, const int* fds, unsigned count);
+
+/**
+ * @brief 注册固定缓冲区 / Register fixed buffers / Feste Puffer registrieren
+ * @param ring 实例指针 / Instance pointer / Instanzzeiger
+ * @param buffers 缓冲区地址数组，之后按下标引用 / Buffer address array, referenced by index afterwards / Pufferadressen-Array, danach per Index referenziert
+ * @param size 每个缓冲区的大小 / Size of every buffer / Größe jedes Puffers
+ * @param count 数量 / Count / Anzahl
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ * @details 内核在注册时固定这些页面，每次写入不再重新映射 / The kernel pins these pages once at registration instead of mapping them on every write / Der Kernel pinnt diese Seiten einmal bei der Registrierung, statt sie bei jedem Schreibvorgang abzubilden
+ */
+int nxld_uring_register_buffers(nxld_uring_t* ring, void* const* buffers, size_t size, unsigned count);
+
+/**
+ * @brief 把一次写入放入提交队列 / Queue one write on the submission queue / Einen Schreibvorgang in die Übermittlungswarteschlange stellen
+ * @param ring 实例指针 / Instance pointer / Instanzzeiger
+ * @param file 已注册文件的下标 / Index of a registered file / Index einer registrierten Datei
+ * @param buffer 已注册缓冲区的下标 / Index of a registered buffer / Index eines registrierten Puffers
+ * @param data 数据地址（位于该缓冲区内） / Data address inside that buffer / Datenadresse innerhalb dieses Puffers
+ * @param length 数据长度 / Data length / Datenlänge
+ * @param offset 文件偏移（O_APPEND文件忽略） / File offset (ignored for O_APPEND files) / Dateiversatz (bei O_APPEND-Dateien ignoriert)
+ * @param user_data 完成事件中带回的值 / Value returned with the completion / Mit dem Abschluss zurückgegebener Wert
+ * @return 成功返回0，提交队列已满返回-1 / Returns 0 on success, -1 when the submission queue is full / Gibt 0 bei Erfolg zurück, -1 wenn die Übermittlungswarteschlange voll ist
+ */
+int nxld_uring_prepare_write(nxld_uring_t* ring, int file, int buffer, const void* data, size_t length,
+                             uint64_t offset, uint64_t user_data);
+
+/**
+ * @brief 提交已排队的写入 / Submit queued writes / Eingereihte Schreibvorgänge einreichen
+ * @param ring 实例指针 / Instance pointer / Instanzzeiger
+ * @return 提交的数量，失败返回-1 / Number submitted, -1 on failure / Anzahl eingereichter Vorgänge, -1 bei Fehler
+ * @details 一次系统调用提交所有已排队的写入，不等待完成 / One system call submits every queued write without waiting for completion / Ein Systemaufruf reicht alle eingereihten Schreibvorgänge ein, ohne auf den Abschluss zu warten
+ */
+int nxld_uring_submit(nxld_uring_t* ring);
+
+/**
+ * @brief 收取一个完成事件 / Reap one completion / Einen Abschluss abholen
+ * @param ring 实例指针 / Instance pointer / Instanzzeiger
+ * @param wait 没有完成事件时是否等待 / Whether to wait when no completion is available / Ob gewartet wird, wenn kein Abschluss verfügbar ist
+ * @param user_data 输出写入时给出的值 / Output value given when queuing / Ausgabe des beim Einreihen angegebenen Werts
+ * @param result 输出写入的字节数或负的错误码 / Output bytes written or a negative error code / Ausgabe der geschriebenen Bytes oder eines negativen Fehlercodes
+ * @return 收到返回1，没有返回0，失败返回-1 / Returns 1 when reaped, 0 when none, -1 on failure / Gibt 1 bei Abholung zurück, 0 wenn keiner, -1 bei Fehler
+ */
+int nxld_uring_complete(nxld_uring_t* ring, int wait, uint64_t* user_data, int32_t* result);
+
+#endif /* NXLD_URING_H */
@@ -0,0 +1,458 @@
+/**
+ * @file random_generator_plugin.c
+ * @brief 随机数生成插件（Linux） / Random number generator plugin (Linux) / Zufallszahlengenerator-Plugin (Linux)
+ * @details 基于计数器的Philox4x32-10生成器：第i个数只取决于种子和i，因此可按区间分给多个线程，结果与线程数无关。x86-64上用AVX2每次计算8个计数器，其他情况用标量代码，两者输出相同。区间映射用乘法和移位，极少数会产生偏差的值按固定规则重抽，不用除法也没有取模偏差 / Counter-based Philox4x32-10 generator: the i-th number depends only on the seed and i, so ranges can be split across threads and the result does not depend on the thread count. On x86-64 AVX2 computes 8 counters at a time, otherwise scalar code runs; both give the same output. Values are mapped into the range with a multiply and shift, and the very few values that would introduce bias are redrawn by a fixed rule, so there is no division and no modulo bias / Zählerbasierter Philox4x32-10-Generator: die i-te Zahl hängt nur vom Seed und i ab, daher lassen sich Bereiche auf mehrere Threads verteilen und das Ergebnis hängt nicht von der Threadanzahl ab. Auf x86-64 berechnet AVX2 8 Zähler auf einmal, sonst läuft skalarer Code; beide liefern dieselbe Ausgabe. Werte werden per Multiplikation und Verschiebung in den Bereich abgebildet, die sehr wenigen Werte mit Verzerrung werden nach fester Regel neu gezogen, daher ohne Division und ohne Modulo-Verzerrung
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_plugin_interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define RANDOM_HAVE_AVX2 1
+#endif
+
+#define RANDOM_PLUGIN_NAME "RandomGeneratorPlugin"
+#define RANDOM_PLUGIN_VERSION "1.1.0"
+#define RANDOM_MAX_PARAMS 2
+#define RANDOM_DEFAULT_SEED 0x2545F491u
+#define RANDOM_KEY_HIGH 0x4E584C44u
+#define RANDOM_GROUP 32
+#define RANDOM_MIN_PER_THREAD (1u << 20)
+#define RANDOM_MAX_THREADS 256
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+/**
+ * @brief 接口描述结构体 / Interface description structure / Schnittstellenbeschreibungsstruktur
+ */
+typedef struct {
+    const char* name;                       /**< 接口名称 / Interface name / Schnittstellenname */
+    const char* description;                /**< 接口描述 / Interface description / Schnittstellenbeschreibung */
+    int param_count;                        /**< 参数数量 / Parameter count / Parameteranzahl */
+    const char* params[RANDOM_MAX_PARAMS];  /**< 参数名称（均为int） / Parameter names (all int) / Parameternamen (alle int) */
+} random_interface_t;
+
+static const random_interface_t g_interfaces[] = {
+    { "SetRange", "Set random number generation range (min, max) / 设置随机数生成区间（最小值，最大值） / Zufallszahlengenerierungsbereich festlegen (Min, Max)", 2, { "min", "max" } },
+    { "SetCount", "Set count of random numbers to generate / 设置生成随机数的数量 / Anzahl der zu generierenden Zufallszahlen festlegen", 1, { "count" } },
+    { "Generate", "Generate random numbers based on current settings / 根据当前设置生成随机数 / Zufallszahlen basierend auf aktuellen Einstellungen generieren", 0, { NULL } },
+    { "GetResult", "Get pointer to generated random number result array / 获取生成的随机数结果数组指针 / Zeiger auf generiertes Zufallszahlenergebnis-Array abrufen", 0, { NULL } },
+    { "GetResultCount", "Get count of generated results / 获取生成的结果数量 / Anzahl der generierten Ergebnisse abrufen", 0, { NULL } },
+    { "SetSeed", "Set the seed; the same seed gives the same numbers / 设置种子，相同种子得到相同的数 / Seed festlegen; derselbe Seed ergibt dieselben Zahlen", 1, { "seed" } },
+    { "SetThreads", "Set the generating thread count (0 for every core) / 设置生成线程数（0表示所有核心） / Anzahl der Generierungs-Threads festlegen (0 für alle Kerne)", 1, { "threads" } }
+};
+
+#define RANDOM_INTERFACE_COUNT (sizeof(g_interfaces) / sizeof(g_interfaces[0]))
+
+/**
+ * @brief 生成参数结构体 / Generation parameter structure / Generierungsparameterstruktur
+ * @details 所有线程只读 / Read-only for every thread / Für alle Threads nur lesbar
+ */
+typedef struct {
+    uint32_t key[2];                        /**< Philox密钥（由种子得出） / Philox key derived from the seed / Aus dem Seed abgeleiteter Philox-Schlüssel */
+    int32_t min;                            /**< 最小值 / Minimum / Minimum */
+    uint32_t range;                         /**< 区间大小，0表示整个32位区间 / Range size, 0 for the whole 32-bit range / Bereichsgröße, 0 für den gesamten 32-Bit-Bereich */
+    uint32_t threshold;                     /**< 低32位小于该值的乘积须重抽 / Products whose low 32 bits fall below this are redrawn / Produkte, deren untere 32 Bit darunter liegen, werden neu gezogen */
+    int32_t* out;                           /**< 输出数组 / Output array / Ausgabe-Array */
+} random_job_t;
+
+/**
+ * @brief 线程区间结构体 / Thread range structure / Thread-Bereichsstruktur
+ */
+typedef struct {
+    const random_job_t* job;                /**< 生成参数 / Generation parameters / Generierungsparameter */
+    size_t begin;                           /**< 起始下标 / First index / Erster Index */
+    size_t end;                             /**< 结束下标（不含） / End index, exclusive / Endindex, exklusiv */
+} random_range_t;
+
+static int g_min = 0;
+static int g_max = 99;
+static size_t g_count = 0;
+static uint32_t g_seed = RANDOM_DEFAULT_SEED;
+static int g_threads = 0;
+static int32_t* g_result = NULL;
+static size_t g_result_capacity = 0;
+static size_t g_result_count = 0;
+
+/**
+ * @brief 计算一个Philox4x32-10块 / Compute one Philox4x32-10 block / Einen Philox4x32-10-Block berechnen
+ * @param counter 128位计数器 / 128-bit counter / 128-Bit-Zähler
+ * @param key 64位密钥 / 64-bit key / 64-Bit-Schlüssel
+ * @param out 输出4个32位数 / Output four 32-bit numbers / Ausgabe von vier 32-Bit-Zahlen
+ */
+static void philox_block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * x0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * x2;
+        x0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+        x1 = (uint32_t)p1;
+        x2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+        x3 = (uint32_t)p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = x0;
+    out[1] = x1;
+    out[2] = x2;
+    out[3] = x3;
+}
+
+/**
+ * @brief 重抽一个会产生偏差的值 / Redraw a value that would introduce bias / Einen Wert mit Verzerrung neu ziehen
+ * @details 第index个数的第n次重抽使用计数器(index, n, 0x52455452)，结果仍只取决于种子和下标；概率约为区间/2^32 / The n-th redraw of number index uses the counter (index, n, 0x52455452), so the result still depends only on the seed and the index; it happens with probability about range/2^32 / Die n-te Neuziehung der Zahl index verwendet den Zähler (index, n, 0x52455452), das Ergebnis hängt also weiterhin nur von Seed und Index ab; Wahrscheinlichkeit etwa Bereich/2^32
+ */
+static int32_t redraw(const random_job_t* job, size_t index) {
+    for (uint32_t attempt = 1;; attempt++) {
+        uint32_t counter[4] = { (uint32_t)index, (uint32_t)((uint64_t)index >> 32), attempt, 0x52455452u };
+        uint32_t words[4];
+        philox_block(counter, job->key, words);
+        uint64_t product = (uint64_t)words[0] * job->range;
+        if ((uint32_t)product >= job->threshold) {
+            return (int32_t)((uint32_t)job->min + (uint32_t)(product >> 32));
+        }
+    }
+}
+
+/**
+ * @brief 把一个32位随机数映射到区间内 / Map one 32-bit random number into the range / Eine 32-Bit-Zufallszahl in den Bereich abbilden
+ */
+static int32_t map_value(const random_job_t* job, uint32_t word, size_t index) {
+    if (job->range == 0) {
+        return (int32_t)word;
+    }
+    uint64_t product = (uint64_t)word * job->range;
+    if ((uint32_t)product < job->threshold) {
+        return redraw(job, index);
+    }
+    return (int32_t)((uint32_t)job->min + (uint32_t)(product >> 32));
+}
+
+/**
+ * @brief 标量生成一组32个数 / Generate one group of 32 numbers with scalar code / Eine Gruppe von 32 Zahlen mit skalarem Code erzeugen
+ * @details 组g中第k个字、第j个块的数位于下标32g+8k+j，块编号为8g+j；与AVX2路径的寄存器布局一致 / Word k of block j in group g lands at index 32g+8k+j, the block number being 8g+j; this matches the register layout of the AVX2 path / Wort k von Block j in Gruppe g landet bei Index 32g+8k+j, die Blocknummer ist 8g+j; das entspricht dem Registerlayout des AVX2-Pfads
+ */
+static void generate_group_scalar(const random_job_t* job, size_t group, int32_t* out) {
+    for (uint32_t j = 0; j < 8; j++) {
+        uint64_t block = (uint64_t)group * 8 + j;
+        uint32_t counter[4] = { (uint32_t)block, (uint32_t)(block >> 32), 0, 0 };
+        uint32_t words[4];
+        philox_block(counter, job->key, words);
+        for (uint32_t k = 0; k < 4; k++) {
+            out[k * 8 + j] = map_value(job, words[k], group * RANDOM_GROUP + k * 8 + j);
+        }
+    }
+}
+
+static void generate_scalar(const random_job_t* job, size_t begin, size_t end) {
+    for (size_t index = begin; index < end; index += RANDOM_GROUP) {
+        generate_group_scalar(job, index / RANDOM_GROUP, job->out + index);
+    }
+}
+
+#ifdef RANDOM_HAVE_AVX2
+/**
+ * @brief 8路32x32位乘法的高低32位 / High and low 32 bits of eight 32x32-bit products / Obere und untere 32 Bit von acht 32x32-Bit-Produkten
+ */
+__attribute__((target("avx2"))) static inline void mulhilo8(__m256i x, __m256i m, __m256i* hi, __m256i* lo) {
+    __m256i even = _mm256_mul_epu32(x, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+    *lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    *hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+/**
+ * @brief 把8个随机数映射到区间内，返回需要重抽的通道掩码 / Map eight random numbers into the range and return the mask of lanes to redraw / Acht Zufallszahlen in den Bereich abbilden und die Maske neu zu ziehender Kanäle zurückgeben
+ */
+__attribute__((target("avx2"))) static inline __m256i map8(__m256i words, __m256i range, __m256i min, __m256i bias,
+                                                           __m256i threshold, int* reject) {
+    __m256i hi, lo;
+    mulhilo8(words, range, &hi, &lo);
+    // 无符号比较lo < threshold：两边翻转符号位后做有符号比较 / Unsigned lo < threshold: flip the sign bit on both sides and compare signed / Vorzeichenloses lo < threshold: Vorzeichenbit beidseitig kippen und vorzeichenbehaftet vergleichen
+    __m256i below = _mm256_cmpgt_epi32(threshold, _mm256_xor_si256(lo, bias));
+    *reject = _mm256_movemask_ps(_mm256_castsi256_ps(below));
+    return _mm256_add_epi32(hi, min);
+}
+
+/**
+ * @brief AVX2生成区间内的所有完整组 / Generate every full group of a range with AVX2 / Alle vollständigen Gruppen eines Bereichs mit AVX2 erzeugen
+ * @details 每次8个Philox块并行，输出直接流式写入内存，不经过缓存 / Eight Philox blocks run in parallel per step and the output is streamed straight to memory, bypassing the cache / Acht Philox-Blöcke laufen pro Schritt parallel und die Ausgabe wird direkt in den Speicher gestreamt, am Cache vorbei
+ */
+__attribute__((target("avx2"))) static void generate_avx2(const random_job_t* job, size_t begin, size_t end) {
+    const __m256i m0 = _mm256_set1_epi32((int)PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi32((int)PHILOX_M1);
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i range = _mm256_set1_epi32((int)job->range);
+    const __m256i min = _mm256_set1_epi32(job->min);
+    const __m256i bias = _mm256_set1_epi32((int)0x80000000u);
+    const __m256i threshold = _mm256_set1_epi32((int)(job->threshold ^ 0x80000000u));
+
+    for (size_t index = begin; index < end; index += RANDOM_GROUP) {
+        uint64_t block = (uint64_t)(index / RANDOM_GROUP) * 8;
+        // 8个块的计数器低位连续，高位相同（组内块号不跨2^32边界） / The eight blocks have consecutive low counter words and the same high word (block numbers in a group never cross a 2^32 boundary) / Die acht Blöcke haben aufeinanderfolgende untere Zählerwörter und dasselbe obere Wort (Blocknummern einer Gruppe überschreiten nie eine 2^32-Grenze)
+        __m256i x0 = _mm256_add_epi32(_mm256_set1_epi32((int)(uint32_t)block), lane);
+        __m256i x1 = _mm256_set1_epi32((int)(uint32_t)(block >> 32));
+        __m256i x2 = _mm256_setzero_si256();
+        __m256i x3 = _mm256_setzero_si256();
+        uint32_t k0 = job->key[0], k1 = job->key[1];
+        for (int round = 0; round < PHILOX_ROUNDS; round++) {
+            __m256i hi0, lo0, hi1, lo1;
+            mulhilo8(x0, m0, &hi0, &lo0);
+            mulhilo8(x2, m1, &hi1, &lo1);
+            x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), _mm256_set1_epi32((int)k0));
+            x1 = lo1;
+            x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), _mm256_set1_epi32((int)k1));
+            x3 = lo0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        __m256i words[4] = { x0, x1, x2, x3 };
+        int32_t* out = job->out + index;
+        for (int k = 0; k < 4; k++) {
+            __m256i value = words[k];
+            if (job->range != 0) {
+                int reject = 0;
+                value = map8(words[k], range, min, bias, threshold, &reject);
+                if (reject != 0) {
+                    int32_t lanes[8];
+                    _mm256_storeu_si256((__m256i*)lanes, value);
+                    for (int j = 0; j < 8; j++) {
+                        if (reject & (1 << j)) {
+                            lanes[j] = redraw(job, index + (size_t)k * 8 + (size_t)j);
+                        }
+                    }
+                    value = _mm256_loadu_si256((const __m256i*)lanes);
+                }
+            }
+            _mm256_stream_si256((__m256i*)(out + k * 8), value);
+        }
+    }
+    _mm_sfence();
+}
+#endif
+
+/**
+ * @brief 生成一个区间 / Generate one range / Einen Bereich erzeugen
+ * @details 起点按组对齐；不足一组的结尾先生成到临时数组再复制 / The start is group-aligned; a tail shorter than a group is generated into a scratch array and copied / Der Anfang ist gruppenweise ausgerichtet; ein Rest kürzer als eine Gruppe wird in ein Hilfsarray erzeugt und kopiert
+ */
+static void generate_range(const random_job_t* job, size_t begin, size_t end) {
+    size_t full_end = begin + (end - begin) / RANDOM_GROUP * RANDOM_GROUP;
+#ifdef RANDOM_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        generate_avx2(job, begin, full_end);
+    } else {
+        generate_scalar(job, begin, full_end);
+    }
+#else
+    generate_scalar(job, begin, full_end);
+#endif
+    if (full_end < end) {
+        int32_t tail[RANDOM_GROUP];
+        generate_group_scalar(job, full_end / RANDOM_GROUP, tail);
+        memcpy(job->out + full_end, tail, (end - full_end) * sizeof(int32_t));
+    }
+}
+
+static void* generate_thread(void* arg) {
+    const random_range_t* range = (const random_range_t*)arg;
+    generate_range(range->job, range->begin, range->end);
+    return NULL;
+}
+
+/**
+ * @brief 确定线程数 / Decide the thread count / Threadanzahl bestimmen
+ * @details 每个线程至少生成RANDOM_MIN_PER_THREAD个数，少量数据不值得启动线程 / Every thread generates at least RANDOM_MIN_PER_THREAD numbers, small counts are not worth starting threads for / Jeder Thread erzeugt mindestens RANDOM_MIN_PER_THREAD Zahlen, kleine Mengen lohnen keine Threads
+ */
+static size_t thread_count(size_t count) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = g_threads > 0 ? (size_t)g_threads : (cores > 0 ? (size_t)cores : 1);
+    size_t useful = count / RANDOM_MIN_PER_THREAD;
+    if (threads > useful) {
+        threads = useful > 0 ? useful : 1;
+    }
+    return threads > RANDOM_MAX_THREADS ? RANDOM_MAX_THREADS : threads;
+}
+
+static const char* get_type_name(nxld_param_type_t type) {
+    switch (type) {
+        case NXLD_PARAM_TYPE_INT: return "int";
+        default: return "unknown";
+    }
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_name(char* name, size_t name_size) {
+    if (name == NULL || name_size == 0) {
+        return -1;
+    }
+    snprintf(name, name_size, "%s", RANDOM_PLUGIN_NAME);
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_version(char* version, size_t version_size) {
+    if (version == NULL || version_size == 0) {
+        return -1;
+    }
+    snprintf(version, version_size, "%s", RANDOM_PLUGIN_VERSION);
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_count(size_t* count) {
+    if (count == NULL) {
+        return -1;
+    }
+    *count = RANDOM_INTERFACE_COUNT;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_info(size_t index, char* name, size_t name_size,
+                                                      char* description, size_t desc_size,
+                                                      char* version, size_t version_size) {
+    if (index >= RANDOM_INTERFACE_COUNT) {
+        return -1;
+    }
+    if (name != NULL && name_size > 0) {
+        snprintf(name, name_size, "%s", g_interfaces[index].name);
+    }
+    if (description != NULL && desc_size > 0) {
+        snprintf(description, desc_size, "%s", g_interfaces[index].description);
+    }
+    if (version != NULL && version_size > 0) {
+        snprintf(version, version_size, "%s", RANDOM_PLUGIN_VERSION);
+    }
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_count(size_t index, nxld_param_count_type_t* count_type,
+                                                             int* min_count, int* max_count) {
+    if (index >= RANDOM_INTERFACE_COUNT || count_type == NULL || min_count == NULL || max_count == NULL) {
+        return -1;
+    }
+    *count_type = NXLD_PARAM_COUNT_FIXED;
+    *min_count = g_interfaces[index].param_count;
+    *max_count = g_interfaces[index].param_count;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_info(size_t index, int param_index,
+                                                            char* param_name, size_t name_size,
+                                                            nxld_param_type_t* param_type,
+                                                            char* type_name, size_t type_name_size) {
+    if (index >= RANDOM_INTERFACE_COUNT || param_index < 0 || param_index >= g_interfaces[index].param_count) {
+        return -1;
+    }
+    if (param_name != NULL && name_size > 0) {
+        snprintf(param_name, name_size, "%s", g_interfaces[index].params[param_index]);
+    }
+    if (param_type != NULL) {
+        *param_type = NXLD_PARAM_TYPE_INT;
+    }
+    if (type_name != NULL && type_name_size > 0) {
+        snprintf(type_name, type_name_size, "%s", get_type_name(NXLD_PARAM_TYPE_INT));
+    }
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int SetRange(int min, int max) {
+    if (min > max) {
+        return -1;
+    }
+    g_min = min;
+    g_max = max;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int SetCount(int count) {
+    if (count < 0) {
+        return -1;
+    }
+    g_count = (size_t)count;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int SetSeed(int seed) {
+    g_seed = (uint32_t)seed;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int SetThreads(int threads) {
+    g_threads = threads < 0 ? 0 : threads;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int Generate(void) {
+    g_result_count = 0;
+    if (g_count == 0) {
+        return 0;
+    }
+    // 缓冲区按需增长并保留，重复生成时不再缺页 / The buffer grows on demand and is kept, so repeated generation does not fault pages again / Der Puffer wächst bei Bedarf und bleibt erhalten, damit wiederholtes Erzeugen keine Seitenfehler mehr auslöst
+    if (g_count > g_result_capacity) {
+        void* buffer = NULL;
+        if (posix_memalign(&buffer, 64, g_count * sizeof(int32_t)) != 0) {
+            return -1;
+        }
+        free(g_result);
+        g_result = (int32_t*)buffer;
+        g_result_capacity = g_count;
+    }
+
+    random_job_t job;
+    job.key[0] = g_seed;
+    job.key[1] = RANDOM_KEY_HIGH;
+    job.min = g_min;
+    job.range = (uint32_t)((int64_t)g_max - (int64_t)g_min + 1);
+    // 2^32 mod range，每次生成只算一次 / 2^32 mod range, computed once per generation / 2^32 mod range, einmal pro Erzeugung berechnet
+    job.threshold = job.range != 0 ? (uint32_t)(0u - job.range) % job.range : 0;
+    job.out = g_result;
+
+    // 按组对齐切分，每个线程写自己的区间；页面由写入的线程首次触及 / Split on group boundaries, every thread writes its own range; pages are first touched by the thread writing them / An Gruppengrenzen teilen, jeder Thread schreibt seinen eigenen Bereich; Seiten werden zuerst vom schreibenden Thread berührt
+    size_t threads = thread_count(g_count);
+    size_t groups = (g_count + RANDOM_GROUP - 1) / RANDOM_GROUP;
+    random_range_t ranges[RANDOM_MAX_THREADS];
+    pthread_t handles[RANDOM_MAX_THREADS];
+    size_t started = 0;
+    for (size_t t = 0; t < threads; t++) {
+        ranges[t].job = &job;
+        ranges[t].begin = groups * t / threads * RANDOM_GROUP;
+        ranges[t].end = t + 1 == threads ? g_count : groups * (t + 1) / threads * RANDOM_GROUP;
+    }
+    for (size_t t = 1; t < threads; t++) {
+        if (pthread_create(&handles[t], NULL, generate_thread, &ranges[t]) != 0) {
+            break;
+        }
+        started = t;
+    }
+    // 线程创建失败时由当前线程补做剩余区间 / If thread creation fails the calling thread covers the remaining ranges / Schlägt die Thread-Erstellung fehl, übernimmt der aufrufende Thread die restlichen Bereiche
+    generate_range(&job, ranges[0].begin, ranges[0].end);
+    for (size_t t = started + 1; t < threads; t++) {
+        generate_range(&job, ranges[t].begin, ranges[t].end);
+    }
+    for (size_t t = 1; t <= started; t++) {
+        pthread_join(handles[t], NULL);
+    }
+    g_result_count = g_count;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int* GetResult(void) {
+    return g_result_count > 0 ? (int*)g_result : NULL;
+}
+
+NXLD_PLUGIN_EXPORT int GetResultCount(void) {
+    return (int)g_result_count;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file nxld_test.h
+ * @brief NXLD测试辅助宏 / NXLD Test Helper Macros / NXLD-Testhilfsmakros
+ * @details 测试程序以第一个参数为临时文件目录（默认tests），所有检查通过时返回0 / Test programs take the directory for scratch files as their first argument (tests by default) and return 0 when every check passes / Testprogramme nehmen das Verzeichnis für temporäre Dateien als erstes Argument (standardmäßig tests) und geben 0 zurück, wenn alle Prüfungen bestehen
+ */
+
+#ifndef NXLD_TEST_H
+#define NXLD_TEST_H
+
+#include <stdio.h>
+
+/**
+ * @brief 默认临时文件目录 / Default directory for scratch files / Standardverzeichnis für temporäre Dateien
+ */
+#define NXLD_TEST_DEFAULT_DIR "tests"
+
+/**
+ * @brief 临时文件路径的最大长度 / Maximum length of a scratch file path / Maximale Länge eines temporären Dateipfads
+ */
+#define NXLD_TEST_MAX_PATH 4096
+
+/**
+ * @brief 失败的检查数量 / Number of failed checks / Anzahl fehlgeschlagener Prüfungen
+ */
+static int g_test_failures = 0;
+
+/**
+ * @brief 检查条件，失败时打印位置并计数 / Check a condition, print the location and count it on failure / Bedingung prüfen, bei Fehler Ort ausgeben und zählen
+ */
+#define NXLD_CHECK(condition)                                                                   \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);      \
+            g_test_failures++;                                                                  \
+        }                                                                                       \
+    } while (0)
+
+/**
+ * @brief 打印结果并返回进程退出码 / Print the result and return the process exit code / Ergebnis ausgeben und Prozess-Exitcode zurückgeben
+ */
+#define NXLD_TEST_RESULT(name)                                                                  \
+    (g_test_failures == 0 ? (printf("%s: passed\n", name), 0)                                   \
+                          : (printf("%s: %d checks failed\n", name, g_test_failures), 1))
+
+#endif /* NXLD_TEST_H */
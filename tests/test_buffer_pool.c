@@ -0,0 +1,116 @@
+/**
+ * @file test_buffer_pool.c
+ * @brief 大缓冲区池并发测试 / Large buffer pool concurrency test / Nebenläufigkeitstest des Großpufferpools
+ * @details 多个线程并发分配、填充、校验并归还不同大小的块；同一块不得同时交给两个线程，统计必须与调用次数一致，缓存不得超过上限。hugetlbfs通常不可用，因此也覆盖并发的回退路径 / Several threads concurrently allocate, fill, verify and return blocks of different sizes; no block may be handed to two threads at once, the statistics must match the calls and the cache must stay within its limit. hugetlbfs is usually unavailable, so the concurrent fallback path is covered as well / Mehrere Threads weisen gleichzeitig Blöcke verschiedener Größe zu, füllen, prüfen und geben sie zurück; kein Block darf gleichzeitig zwei Threads gehören, die Statistik muss den Aufrufen entsprechen und der Cache muss innerhalb seines Limits bleiben. hugetlbfs ist meist nicht verfügbar, daher wird auch der gleichzeitige Rückfallpfad abgedeckt
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tests/nxld_test.h"
+#include "nxld_buffer_pool.h"
+#include "nxld_logger.h"
+#include "nxld_thread.h"
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TEST_NAME "test_buffer_pool"
+#define TEST_THREADS 4
+#define TEST_ROUNDS 50
+#define TEST_HUGE_PAGE ((size_t)2 * 1024 * 1024)
+#define TEST_MAX_CACHED (8 * TEST_HUGE_PAGE)
+#define TEST_CHECK_STRIDE 4096
+
+/**
+ * @brief 工作线程参数结构体 / Worker thread argument structure / Argumentstruktur des Arbeitsthreads
+ */
+typedef struct {
+    unsigned char pattern;                  /**< 本线程写入的字节 / Byte written by this thread / Von diesem Thread geschriebenes Byte */
+    int failed;                             /**< 失败的分配或校验数量 / Failed allocations or checks / Fehlgeschlagene Zuweisungen oder Prüfungen */
+} pool_worker_t;
+
+/**
+ * @brief 校验块中每页的字节 / Check one byte per page of a block / Ein Byte je Seite eines Blocks prüfen
+ * @return 全部一致返回1，否则返回0 / Returns 1 if all match, 0 otherwise / Gibt 1 zurück, wenn alle übereinstimmen, sonst 0
+ */
+static int check_block(const unsigned char* block, size_t size, unsigned char pattern) {
+    for (size_t offset = 0; offset < size; offset += TEST_CHECK_STRIDE) {
+        if (block[offset] != pattern) {
+            return 0;
+        }
+    }
+    return block[size - 1] == pattern;
+}
+
+/**
+ * @brief 工作线程：分配、填充、让出处理器后校验并归还 / Worker thread: allocate, fill, yield, then verify and return / Arbeitsthread: zuweisen, füllen, Prozessor abgeben, dann prüfen und zurückgeben
+ */
+static void pool_thread(void* arg) {
+    pool_worker_t* worker = (pool_worker_t*)arg;
+    for (int i = 0; i < TEST_ROUNDS; i++) {
+        // 大小在一到三个大页之间变化且不对齐，覆盖复用和新映射 / Sizes vary between one and three huge pages and are unaligned, covering both reuse and fresh mappings / Größen schwanken zwischen einer und drei Huge Pages und sind nicht ausgerichtet, was Wiederverwendung und neue Abbildungen abdeckt
+        size_t size = (size_t)(1 + (i + worker->pattern) % 3) * TEST_HUGE_PAGE - 1000;
+        unsigned char* block = (unsigned char*)nxld_buffer_pool_alloc(size, 64);
+        if (block == NULL || ((uintptr_t)block & (TEST_HUGE_PAGE - 1)) != 0) {
+            worker->failed++;
+            continue;
+        }
+        memset(block, worker->pattern, size);
+        sched_yield();
+        if (!check_block(block, size, worker->pattern)) {
+            worker->failed++;
+        }
+        nxld_buffer_pool_free(block);
+    }
+}
+
+int main(void) {
+    nxld_buffer_pool_config_t config;
+    nxld_buffer_pool_stats_t stats;
+    pool_worker_t workers[TEST_THREADS];
+    nxld_thread_t threads[TEST_THREADS];
+
+    nxld_buffer_pool_default_config(&config);
+    config.max_cached_bytes = TEST_MAX_CACHED;
+    config.touch_threads = 4;
+    NXLD_CHECK(nxld_buffer_pool_init(&config) == 0);
+
+    int started = 0;
+    for (int i = 0; i < TEST_THREADS; i++) {
+        workers[i].pattern = (unsigned char)(0x11 * (i + 1));
+        workers[i].failed = 0;
+        if (nxld_thread_create(&threads[i], pool_thread, &workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    NXLD_CHECK(started == TEST_THREADS);
+    for (int i = 0; i < started; i++) {
+        nxld_thread_join(threads[i]);
+        NXLD_CHECK(workers[i].failed == 0);
+    }
+
+    // 全部归还后映射的字节都在缓存中 / Once everything is returned all mapped bytes are cached / Nachdem alles zurückgegeben ist, sind alle abgebildeten Bytes zwischengespeichert
+    nxld_buffer_pool_get_stats(&stats);
+    NXLD_CHECK(stats.allocations == (size_t)started * TEST_ROUNDS);
+    NXLD_CHECK(stats.reuses > 0 && stats.reuses < stats.allocations);
+    NXLD_CHECK(stats.cached_bytes == stats.mapped_bytes);
+    NXLD_CHECK(stats.cached_bytes <= TEST_MAX_CACHED);
+
+    // 缓冲区描述符通过释放回调归还到池中 / A buffer descriptor returns to the pool through its release callback / Ein Pufferdeskriptor kehrt über seinen Freigabe-Callback in den Pool zurück
+    nxld_buffer_t buffer;
+    NXLD_CHECK(nxld_buffer_pool_alloc_buffer(&buffer, 1000, NXLD_PARAM_TYPE_INT, sizeof(int)) == 0);
+    nxld_buffer_pool_get_stats(&stats);
+    NXLD_CHECK(stats.cached_bytes < stats.mapped_bytes);
+    buffer.release(buffer.owner, buffer.data);
+    nxld_buffer_pool_get_stats(&stats);
+    NXLD_CHECK(stats.cached_bytes == stats.mapped_bytes);
+
+    nxld_buffer_pool_shutdown();
+    nxld_buffer_pool_get_stats(&stats);
+    NXLD_CHECK(stats.mapped_bytes == 0 && stats.allocations == 0);
+    nxld_logger_close();
+    return NXLD_TEST_RESULT(TEST_NAME);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_context.c
+ * @brief 并发执行上下文测试 / Concurrent execution context test / Test gleichzeitiger Ausführungskontexte
+ * @details 多个线程经各自的执行上下文并发调用上下文感知测试插件上的调用链；每个值必须恰好到达一次；Produce读取同一上下文中Trigger保存的值，而Trigger之后让出处理器，因此插件状态在上下文之间串用时Consume收到的值之和会出错 / Several threads concurrently call a chain on the context-aware test plugin through their own execution contexts; every value must arrive exactly once. Produce reads the value Trigger saved in the same context and Trigger yields afterwards, so plugin state leaking between contexts corrupts the sum Consume receives / Mehrere Threads rufen über eigene Ausführungskontexte gleichzeitig eine Kette auf dem kontextbewussten Test-Plugin auf; jeder Wert muss genau einmal ankommen. Produce liest den Wert, den Trigger im selben Kontext gespeichert hat, und Trigger gibt danach den Prozessor ab, daher verfälscht zwischen Kontexten durchsickernder Plugin-Zustand die Summe, die Consume empfängt
+ */
+
+#include "tests/nxld_test.h"
+#include "tests/test_fixture.h"
+#include "nxld_logger.h"
+#include "nxld_thread.h"
+
+#define TEST_NAME "test_context"
+#define TEST_THREADS 8
+#define TEST_CALLS_PER_THREAD 2000
+#define TEST_INVOCATIONS (TEST_THREADS * TEST_CALLS_PER_THREAD)
+#define TEST_PRODUCED 7
+
+/**
+ * @brief 工作线程参数结构体 / Worker thread argument structure / Argumentstruktur des Arbeitsthreads
+ */
+typedef struct {
+    nxld_transfer_plan_t* plan;             /**< 执行计划 / Execution plan / Ausführungsplan */
+    int base;                               /**< 本线程的第一个值 / First value of this thread / Erster Wert dieses Threads */
+    int failed;                             /**< 失败的调用数量 / Failed calls / Fehlgeschlagene Aufrufe */
+} context_worker_t;
+
+/**
+ * @brief 工作线程：在自己的上下文中调用计划 / Worker thread: calls the plan on its own context / Arbeitsthread: ruft den Plan im eigenen Kontext auf
+ */
+static void context_thread(void* arg) {
+    context_worker_t* worker = (context_worker_t*)arg;
+    nxld_plan_context_t* context = nxld_transfer_plan_context_create(worker->plan);
+    if (context == NULL) {
+        worker->failed = TEST_CALLS_PER_THREAD;
+        return;
+    }
+    for (int i = 0; i < TEST_CALLS_PER_THREAD; i++) {
+        int value = worker->base + i;
+        if (nxld_transfer_plan_call_context(context, "TestDriver", "Src0", 0, &value) != 0) {
+            worker->failed++;
+        }
+    }
+    // 释放上下文时插件把本上下文的记录合并到全局记录 / Freeing the context makes the plugin merge this context's records into the global ones / Beim Freigeben des Kontexts führt das Plugin dessen Aufzeichnungen mit den globalen zusammen
+    nxld_transfer_plan_context_free(context);
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : NXLD_TEST_DEFAULT_DIR;
+    test_fixture_t fixture;
+    nxld_transfer_rule_set_t rules;
+    nxld_transfer_plan_t plan;
+    const long long value_sum = (long long)TEST_INVOCATIONS * (TEST_INVOCATIONS - 1) / 2;
+
+    if (test_fixture_open(&fixture, dir, TEST_FIXTURE_CONTEXT_PLUGIN) != 0) {
+        return 1;
+    }
+    FILE* fp = test_fixture_begin_rules(&fixture, TEST_NAME, 3);
+    if (fp != NULL) {
+        test_fixture_write_rule(&fixture, fp, 0, "TestDriver", "Src0", 0, "Trigger", 0, NULL);
+        test_fixture_write_rule(&fixture, fp, 1, "TestPlugin", "Trigger", -1, "Consume", 0, NULL);
+        test_fixture_write_rule(&fixture, fp, 2, "TestPlugin", "Produce", 0, "Consume", 0, NULL);
+        fclose(fp);
+    }
+    if (fp == NULL || test_fixture_compile(&fixture, TEST_NAME, &rules, &plan) != 0) {
+        fprintf(stderr, "Failed to compile the test plan\n");
+        test_fixture_remove_rules(&fixture, TEST_NAME);
+        test_fixture_close(&fixture);
+        return 1;
+    }
+    test_fixture_reset(&fixture);
+
+    context_worker_t workers[TEST_THREADS];
+    nxld_thread_t threads[TEST_THREADS];
+    int started = 0;
+    for (int i = 0; i < TEST_THREADS; i++) {
+        workers[i].plan = &plan;
+        workers[i].base = i * TEST_CALLS_PER_THREAD;
+        workers[i].failed = 0;
+        if (nxld_thread_create(&threads[i], context_thread, &workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    NXLD_CHECK(started == TEST_THREADS);
+    for (int i = 0; i < started; i++) {
+        nxld_thread_join(threads[i]);
+        NXLD_CHECK(workers[i].failed == 0);
+    }
+
+    if (started == TEST_THREADS) {
+        NXLD_CHECK(test_fixture_count(&fixture, "Trigger") == TEST_INVOCATIONS);
+        NXLD_CHECK(test_fixture_sum(&fixture, "Trigger") == value_sum);
+        NXLD_CHECK(test_fixture_count(&fixture, "Produce") == TEST_INVOCATIONS);
+        NXLD_CHECK(test_fixture_count(&fixture, "Consume") == TEST_INVOCATIONS);
+        NXLD_CHECK(test_fixture_sum(&fixture, "Consume") == value_sum + (long long)TEST_INVOCATIONS * TEST_PRODUCED);
+
+        // 各上下文的指标分片在读取时合并 / The metrics shards of the contexts are merged when read / Die Metrik-Shards der Kontexte werden beim Lesen zusammengeführt
+        nxld_metrics_series_t series;
+        size_t rule = test_fixture_find_rule(&rules, "Trigger", "Consume");
+        NXLD_CHECK(nxld_transfer_plan_get_rule_metrics(&plan, rule, &series) == 0);
+        NXLD_CHECK(series.calls == TEST_INVOCATIONS && series.errors == 0);
+    }
+
+    nxld_transfer_plan_free(&plan);
+    nxld_transfer_rules_free(&rules);
+    test_fixture_remove_rules(&fixture, TEST_NAME);
+    test_fixture_close(&fixture);
+    nxld_logger_close();
+    return NXLD_TEST_RESULT(TEST_NAME);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_fixture.c
+ * @brief 执行计划测试夹具实现 / Execution plan test fixture implementation / Implementierung der Testumgebung für Ausführungspläne
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "tests/test_fixture.h"
+#include <stdlib.h>
+#include <string.h>
+
+int test_fixture_open(test_fixture_t* fixture, const char* dir, const char* plugin_file) {
+    char plugin_path[TEST_FIXTURE_MAX_PATH];
+    memset(fixture, 0, sizeof(*fixture));
+    snprintf(plugin_path, sizeof(plugin_path), "%s/%s", dir, plugin_file);
+    if (realpath(dir, fixture->work_dir) == NULL || realpath(plugin_path, fixture->plugin_path) == NULL) {
+        fprintf(stderr, "Test plugin not found: %s\n", plugin_path);
+        return -1;
+    }
+    if (nxld_plugin_load(fixture->plugin_path, &fixture->plugin) != NXLD_PLUGIN_LOAD_SUCCESS) {
+        fprintf(stderr, "Failed to load test plugin: %s\n", fixture->plugin_path);
+        return -1;
+    }
+
+    // 计划从.so旁边的.nxp读取参数类型 / The plan reads parameter types from the .nxp next to the .so / Der Plan liest Parametertypen aus der .nxp neben der .so
+    char nxp_path[TEST_FIXTURE_MAX_PATH];
+    snprintf(nxp_path, sizeof(nxp_path), "%s", fixture->plugin_path);
+    strcpy(strrchr(nxp_path, '.'), ".nxp");
+    if (nxld_plugin_generate_metadata_file(&fixture->plugin, nxp_path) != 0) {
+        fprintf(stderr, "Failed to write test plugin metadata: %s\n", nxp_path);
+        nxld_plugin_free(&fixture->plugin);
+        return -1;
+    }
+    return 0;
+}
+
+void test_fixture_close(test_fixture_t* fixture) {
+    char nxp_path[TEST_FIXTURE_MAX_PATH];
+    snprintf(nxp_path, sizeof(nxp_path), "%s", fixture->plugin_path);
+    strcpy(strrchr(nxp_path, '.'), ".nxp");
+    remove(nxp_path);
+    nxld_plugin_free(&fixture->plugin);
+}
+
+FILE* test_fixture_begin_rules(const test_fixture_t* fixture, const char* name, size_t rule_count) {
+    char entry_path[TEST_FIXTURE_MAX_PATH + 64];
+    char rules_path[TEST_FIXTURE_MAX_PATH + 64];
+    snprintf(entry_path, sizeof(entry_path), "%s/%s.nxpt", fixture->work_dir, name);
+    snprintf(rules_path, sizeof(rules_path), "%s/%s_rules.nxpt", fixture->work_dir, name);
+
+    FILE* entry = fopen(entry_path, "w");
+    if (entry == NULL) {
+        return NULL;
+    }
+    fprintf(entry, "[EntryPlugin]\nPluginName=TestDriver\nPluginPath=%s\nNxptPath=%s\n", fixture->plugin_path, rules_path);
+    fclose(entry);
+
+    FILE* fp = fopen(rules_path, "w");
+    if (fp != NULL) {
+        fprintf(fp, "[TransferRules]\nCount=%zu\n", rule_count);
+    }
+    return fp;
+}
+
+void test_fixture_write_rule(const test_fixture_t* fixture, FILE* fp, size_t index, const char* source_plugin,
+                             const char* source_interface, int source_index, const char* target_interface,
+                             int target_index, const char* value) {
+    fprintf(fp, "[TransferRule_%zu]\nSourcePlugin=%s\nSourceInterface=%s\nSourceParamIndex=%d\n", index,
+            source_plugin, source_interface, source_index);
+    fprintf(fp, "TargetPlugin=TestPlugin\nTargetPluginPath=%s\nTargetInterface=%s\nTargetParamIndex=%d\n",
+            fixture->plugin_path, target_interface, target_index);
+    if (value != NULL) {
+        fprintf(fp, "TargetParamValue=%s\n", value);
+    }
+    fprintf(fp, "TransferMode=unicast\nEnabled=true\n");
+}
+
+int test_fixture_compile(const test_fixture_t* fixture, const char* name, nxld_transfer_rule_set_t* rules,
+                         nxld_transfer_plan_t* plan) {
+    char entry_path[TEST_FIXTURE_MAX_PATH + 64];
+    snprintf(entry_path, sizeof(entry_path), "%s/%s.nxpt", fixture->work_dir, name);
+
+    if (nxld_transfer_rules_init(rules, fixture->work_dir) != 0) {
+        return -1;
+    }
+    if (nxld_transfer_rules_load_chain(rules, entry_path) != NXLD_TRANSFER_RULES_SUCCESS) {
+        nxld_transfer_rules_free(rules);
+        return -1;
+    }
+    if (nxld_transfer_plan_compile(rules, plan) != NXLD_TRANSFER_PLAN_SUCCESS) {
+        nxld_transfer_rules_free(rules);
+        return -1;
+    }
+    return 0;
+}
+
+void test_fixture_remove_rules(const test_fixture_t* fixture, const char* name) {
+    char path[TEST_FIXTURE_MAX_PATH + 64];
+    snprintf(path, sizeof(path), "%s/%s.nxpt", fixture->work_dir, name);
+    remove(path);
+    snprintf(path, sizeof(path), "%s/%s_rules.nxpt", fixture->work_dir, name);
+    remove(path);
+}
+
+size_t test_fixture_find_rule(const nxld_transfer_rule_set_t* rules, const char* source_interface,
+                              const char* target_interface) {
+    for (size_t i = 0; i < rules->rule_count; i++) {
+        const nxld_transfer_rule_t* rule = &rules->rules[i];
+        if (rule->source_interface != NULL && strcmp(rule->source_interface, source_interface) == 0 &&
+            strcmp(rule->target_interface, target_interface) == 0) {
+            return i;
+        }
+    }
+    return NXLD_PLAN_INVALID_INDEX;
+}
+
+int test_fixture_count(const test_fixture_t* fixture, const char* interface_name) {
+    int (*count)(const char*) = NULL;
+    *(void**)&count = nxld_plugin_get_symbol(&fixture->plugin, "test_plugin_count");
+    return count != NULL ? count(interface_name) : -1;
+}
+
+long long test_fixture_sum(const test_fixture_t* fixture, const char* interface_name) {
+    long long (*sum)(const char*) = NULL;
+    *(void**)&sum = nxld_plugin_get_symbol(&fixture->plugin, "test_plugin_sum");
+    return sum != NULL ? sum(interface_name) : -1;
+}
+
+void test_fixture_reset(const test_fixture_t* fixture) {
+    void (*reset)(void) = NULL;
+    *(void**)&reset = nxld_plugin_get_symbol(&fixture->plugin, "test_plugin_reset");
+    if (reset != NULL) {
+        reset();
+    }
+}
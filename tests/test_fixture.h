@@ -0,0 +1,102 @@
+/**
+ * @file test_fixture.h
+ * @brief 执行计划测试夹具 / Execution plan test fixture / Testumgebung für Ausführungspläne
+ * @details 为tests/test_plugin生成元数据和规则文件并编译计划；规则的源插件为TestDriver，目标插件为TestPlugin / Generates the metadata and rule files for tests/test_plugin and compiles plans; rules use TestDriver as the source plugin and TestPlugin as the target plugin / Erzeugt Metadaten und Regeldateien für tests/test_plugin und kompiliert Pläne; Regeln verwenden TestDriver als Quell-Plugin und TestPlugin als Ziel-Plugin
+ */
+
+#ifndef TEST_FIXTURE_H
+#define TEST_FIXTURE_H
+
+#include "nxld_plugin.h"
+#include "nxld_transfer_rules.h"
+#include "nxld_transfer_plan.h"
+#include <stdio.h>
+
+/**
+ * @brief 测试插件文件名 / Test plugin file name / Dateiname des Test-Plugins
+ */
+#define TEST_FIXTURE_PLUGIN "test_plugin.so"
+
+/**
+ * @brief 上下文感知测试插件文件名 / Context-aware test plugin file name / Dateiname des kontextbewussten Test-Plugins
+ */
+#define TEST_FIXTURE_CONTEXT_PLUGIN "test_plugin_context.so"
+
+/**
+ * @brief 夹具路径缓冲区大小 / Fixture path buffer size / Größe der Pfadpuffer der Testumgebung
+ */
+#define TEST_FIXTURE_MAX_PATH 4096
+
+/**
+ * @brief 测试夹具结构体 / Test fixture structure / Struktur der Testumgebung
+ */
+typedef struct {
+    char work_dir[TEST_FIXTURE_MAX_PATH];    /**< 规则文件目录（绝对路径） / Directory of the rule files (absolute path) / Verzeichnis der Regeldateien (absoluter Pfad) */
+    char plugin_path[TEST_FIXTURE_MAX_PATH]; /**< 测试插件路径（绝对路径） / Test plugin path (absolute path) / Pfad des Test-Plugins (absoluter Pfad) */
+    nxld_plugin_t plugin;                    /**< 已加载的测试插件，与计划共享同一份库 / Loaded test plugin, sharing the library with the plan / Geladenes Test-Plugin, teilt die Bibliothek mit dem Plan */
+} test_fixture_t;
+
+/**
+ * @brief 加载测试插件并在其旁边写出.nxp / Load the test plugin and write the .nxp next to it / Test-Plugin laden und die .nxp daneben schreiben
+ * @param dir 包含测试插件的目录 / Directory containing the test plugin / Verzeichnis, das das Test-Plugin enthält
+ * @param plugin_file 测试插件文件名（TEST_FIXTURE_PLUGIN或TEST_FIXTURE_CONTEXT_PLUGIN） / Test plugin file name (TEST_FIXTURE_PLUGIN or TEST_FIXTURE_CONTEXT_PLUGIN) / Dateiname des Test-Plugins (TEST_FIXTURE_PLUGIN oder TEST_FIXTURE_CONTEXT_PLUGIN)
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int test_fixture_open(test_fixture_t* fixture, const char* dir, const char* plugin_file);
+
+/**
+ * @brief 释放测试插件 / Release the test plugin / Test-Plugin freigeben
+ */
+void test_fixture_close(test_fixture_t* fixture);
+
+/**
+ * @brief 开始写入入口文件和规则文件 / Begin writing the entry and rule files / Schreiben der Einstiegs- und Regeldatei beginnen
+ * @param name 文件名前缀 / File name prefix / Dateinamenpräfix
+ * @param rule_count 规则数量 / Rule count / Regelanzahl
+ * @return 规则文件，失败返回NULL / Rule file, NULL on failure / Regeldatei, NULL bei Fehler
+ */
+FILE* test_fixture_begin_rules(const test_fixture_t* fixture, const char* name, size_t rule_count);
+
+/**
+ * @brief 写入一条目标为TestPlugin的规则 / Write one rule targeting TestPlugin / Eine Regel mit Ziel TestPlugin schreiben
+ * @param value 目标参数常量值（可为NULL） / Constant target parameter value (may be NULL) / Konstanter Zielparameterwert (kann NULL sein)
+ */
+void test_fixture_write_rule(const test_fixture_t* fixture, FILE* fp, size_t index, const char* source_plugin,
+                             const char* source_interface, int source_index, const char* target_interface,
+                             int target_index, const char* value);
+
+/**
+ * @brief 加载规则并编译计划 / Load the rules and compile the plan / Regeln laden und Plan kompilieren
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+int test_fixture_compile(const test_fixture_t* fixture, const char* name, nxld_transfer_rule_set_t* rules,
+                         nxld_transfer_plan_t* plan);
+
+/**
+ * @brief 删除入口文件和规则文件 / Remove the entry and rule files / Einstiegs- und Regeldatei entfernen
+ */
+void test_fixture_remove_rules(const test_fixture_t* fixture, const char* name);
+
+/**
+ * @brief 查找规则索引 / Find a rule index / Regelindex suchen
+ * @return 规则索引，找不到时返回NXLD_PLAN_INVALID_INDEX / Rule index, NXLD_PLAN_INVALID_INDEX if not found / Regelindex, NXLD_PLAN_INVALID_INDEX wenn nicht gefunden
+ */
+size_t test_fixture_find_rule(const nxld_transfer_rule_set_t* rules, const char* source_interface,
+                              const char* target_interface);
+
+/**
+ * @brief 获取测试插件接口的调用次数 / Get how often a test plugin interface was called / Abrufen, wie oft eine Schnittstelle des Test-Plugins aufgerufen wurde
+ */
+int test_fixture_count(const test_fixture_t* fixture, const char* interface_name);
+
+/**
+ * @brief 获取测试插件接口收到的值之和 / Get the sum of the values a test plugin interface received / Summe der von einer Schnittstelle des Test-Plugins empfangenen Werte abrufen
+ */
+long long test_fixture_sum(const test_fixture_t* fixture, const char* interface_name);
+
+/**
+ * @brief 清零测试插件的调用记录 / Clear the test plugin's call records / Aufrufaufzeichnungen des Test-Plugins löschen
+ */
+void test_fixture_reset(const test_fixture_t* fixture);
+
+#endif /* TEST_FIXTURE_H */
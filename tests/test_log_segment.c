@@ -0,0 +1,265 @@
+/**
+ * @file test_log_segment.c
+ * @brief 日志段轮转测试 / Log segment rotation test / Test der Protokollsegment-Rotation
+ * @details 检查轮转、保留数量和截断，以及新段无法映射时段被锁定、日志系统改为追加到普通文件；映射失败由本文件中替换的mmap模拟 / Checks rotation, retention and trimming, and that a segment whose new mapping fails is latched while the logger switches to appending to a plain file; the mapping failure is simulated by the mmap this file substitutes / Prüft Rotation, Aufbewahrung und Kürzung sowie, dass ein Segment, dessen neue Abbildung fehlschlägt, gesperrt wird, während der Logger auf das Anhängen an eine normale Datei umschaltet; der Abbildungsfehler wird durch das in dieser Datei ersetzte mmap simuliert
+ *
+ * 用法 / Usage / Verwendung:
+ *   test_log_segment [DIR]
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_log_segment.h"
+#include "nxld_logger.h"
+#include "tests/nxld_test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SEGMENT_SIZE NXLD_LOG_SEGMENT_MIN_SIZE
+#define SEGMENT_COUNT 3
+#define LINE_SIZE 64
+#define LOGGER_LINES 60000
+#define SEGMENT_NAME "test_log_segment.log"
+#define LOGGER_NAME "test_log_segment_logger.log"
+
+/**
+ * @brief 非0时文件映射失败 / File mappings fail when non-zero / Dateiabbildungen schlagen fehl, wenn ungleich 0
+ */
+static volatile int g_fail_mappings = 0;
+
+/**
+ * @brief 替换的mmap：置位时让文件映射失败，匿名映射（malloc、线程栈）不受影响 / Substituted mmap: fails file mappings while set, anonymous mappings (malloc, thread stacks) are unaffected / Ersetztes mmap: lässt Dateiabbildungen fehlschlagen, solange gesetzt; anonyme Abbildungen (malloc, Thread-Stacks) sind nicht betroffen
+ */
+void* mmap(void* address, size_t length, int protection, int flags, int fd, off_t offset) {
+    static void* (*real_mmap)(void*, size_t, int, int, int, off_t) = NULL;
+    if (real_mmap == NULL) {
+        *(void**)&real_mmap = dlsym(RTLD_NEXT, "mmap");
+    }
+    if (g_fail_mappings && fd >= 0) {
+        return MAP_FAILED;
+    }
+    return real_mmap(address, length, protection, flags, fd, offset);
+}
+
+/**
+ * @brief 获取文件大小，不存在时返回-1 / Get a file size, -1 if it does not exist / Dateigröße abrufen, -1 wenn sie nicht existiert
+ */
+static long file_size(const char* path) {
+    struct stat info;
+    return stat(path, &info) == 0 ? (long)info.st_size : -1;
+}
+
+/**
+ * @brief 统计文件中包含某子串的行数 / Count the lines of a file containing a substring / Zeilen einer Datei zählen, die eine Teilzeichenfolge enthalten
+ */
+static size_t count_lines(const char* path, const char* needle) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    char line[512];
+    size_t count = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strstr(line, needle) != NULL) {
+            count++;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+/**
+ * @brief 检查文件中没有零字节 / Check that a file holds no zero bytes / Prüfen, dass eine Datei keine Nullbytes enthält
+ */
+static int has_no_zero_bytes(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    int c;
+    int clean = 1;
+    while ((c = fgetc(file)) != EOF) {
+        if (c == 0) {
+            clean = 0;
+            break;
+        }
+    }
+    fclose(file);
+    return clean;
+}
+
+/**
+ * @brief 生成段路径 / Build a segment path / Segmentpfad erzeugen
+ * @param index 保留段编号，0表示当前段 / Retained segment number, 0 for the active segment / Nummer des aufbewahrten Segments, 0 für das aktive Segment
+ */
+static void segment_path(char* out, const char* dir, const char* name, int index) {
+    if (index == 0) {
+        snprintf(out, NXLD_TEST_MAX_PATH, "%s/%s", dir, name);
+    } else {
+        snprintf(out, NXLD_TEST_MAX_PATH, "%s/%s.%d", dir, name, index);
+    }
+}
+
+/**
+ * @brief 删除当前段和所有保留的段 / Remove the active segment and every retained one / Aktives Segment und alle aufbewahrten entfernen
+ */
+static void remove_segments(const char* dir, const char* name) {
+    char path[NXLD_TEST_MAX_PATH];
+    for (int i = 0; i <= SEGMENT_COUNT + 1; i++) {
+        segment_path(path, dir, name, i);
+        remove(path);
+    }
+}
+
+/**
+ * @brief 写满当前段 / Fill the active segment / Aktives Segment füllen
+ * @return 写入的行数 / Lines written / Geschriebene Zeilen
+ */
+static size_t fill_segment(nxld_log_segment_t* segment, char tag) {
+    char line[LINE_SIZE];
+    memset(line, tag, sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\n';
+    size_t lines = 0;
+    while (nxld_log_segment_available(segment) >= sizeof(line)) {
+        nxld_log_segment_append(segment, line, sizeof(line));
+        lines++;
+    }
+    return lines;
+}
+
+/**
+ * @brief 轮转、保留数量和截断 / Rotation, retention and trimming / Rotation, Aufbewahrung und Kürzung
+ */
+static void test_rotation(const char* dir) {
+    char path[NXLD_TEST_MAX_PATH];
+    char rotated[NXLD_TEST_MAX_PATH];
+    char oldest[NXLD_TEST_MAX_PATH];
+    char dropped[NXLD_TEST_MAX_PATH];
+    segment_path(path, dir, SEGMENT_NAME, 0);
+    segment_path(rotated, dir, SEGMENT_NAME, 1);
+    segment_path(oldest, dir, SEGMENT_NAME, 2);
+    segment_path(dropped, dir, SEGMENT_NAME, 3);
+    remove_segments(dir, SEGMENT_NAME);
+
+    nxld_log_segment_t* segment = nxld_log_segment_open(path, SEGMENT_SIZE, SEGMENT_COUNT, 0, 0);
+    NXLD_CHECK(segment != NULL);
+    if (segment == NULL) {
+        return;
+    }
+    NXLD_CHECK(strcmp(nxld_log_segment_path(segment), path) == 0);
+    NXLD_CHECK(nxld_log_segment_available(segment) == SEGMENT_SIZE);
+
+    size_t lines = fill_segment(segment, 'a');
+    NXLD_CHECK(lines == SEGMENT_SIZE / LINE_SIZE);
+    NXLD_CHECK(nxld_log_segment_rotate(segment) == 0);
+    NXLD_CHECK(nxld_log_segment_available(segment) == SEGMENT_SIZE);
+    NXLD_CHECK(file_size(rotated) == (long)(lines * LINE_SIZE));
+    NXLD_CHECK(count_lines(rotated, "aaaa") == lines);
+
+    // 保留数量包含当前段，最旧的段被删除 / Retention counts the active segment and the oldest one is removed / Die Aufbewahrung zählt das aktive Segment mit, das älteste wird entfernt
+    fill_segment(segment, 'b');
+    NXLD_CHECK(nxld_log_segment_rotate(segment) == 0);
+    fill_segment(segment, 'c');
+    NXLD_CHECK(nxld_log_segment_rotate(segment) == 0);
+    NXLD_CHECK(count_lines(rotated, "cccc") == lines);
+    NXLD_CHECK(count_lines(oldest, "bbbb") == lines);
+    NXLD_CHECK(file_size(dropped) == -1);
+    NXLD_CHECK(nxld_log_segment_take_trim_failures(segment) == 0);
+
+    // 关闭时当前段截断到有效长度 / Closing trims the active segment to its valid length / Beim Schließen wird das aktive Segment auf seine gültige Länge gekürzt
+    nxld_log_segment_append(segment, "last\n", 5);
+    nxld_log_segment_close(segment);
+    NXLD_CHECK(file_size(path) == 5);
+
+    // 重新打开时在有效内容之后继续追加 / Reopening appends after the valid content / Beim erneuten Öffnen wird nach dem gültigen Inhalt angehängt
+    segment = nxld_log_segment_open(path, SEGMENT_SIZE, SEGMENT_COUNT, 0, 0);
+    NXLD_CHECK(segment != NULL);
+    if (segment != NULL) {
+        NXLD_CHECK(nxld_log_segment_available(segment) == SEGMENT_SIZE - 5);
+        nxld_log_segment_close(segment);
+    }
+    remove_segments(dir, SEGMENT_NAME);
+}
+
+/**
+ * @brief 新段无法映射时段被锁定，不再移动或删除保留的段 / A segment whose new mapping fails is latched and no longer moves or removes retained segments / Ein Segment, dessen neue Abbildung fehlschlägt, wird gesperrt und verschiebt oder entfernt keine aufbewahrten Segmente mehr
+ */
+static void test_mapping_failure(const char* dir) {
+    char path[NXLD_TEST_MAX_PATH];
+    char rotated[NXLD_TEST_MAX_PATH];
+    char oldest[NXLD_TEST_MAX_PATH];
+    segment_path(path, dir, SEGMENT_NAME, 0);
+    segment_path(rotated, dir, SEGMENT_NAME, 1);
+    segment_path(oldest, dir, SEGMENT_NAME, 2);
+    remove_segments(dir, SEGMENT_NAME);
+
+    nxld_log_segment_t* segment = nxld_log_segment_open(path, SEGMENT_SIZE, SEGMENT_COUNT, 0, 0);
+    NXLD_CHECK(segment != NULL);
+    if (segment == NULL) {
+        return;
+    }
+    size_t lines = fill_segment(segment, 'a');
+
+    g_fail_mappings = 1;
+    NXLD_CHECK(nxld_log_segment_rotate(segment) != 0);
+    NXLD_CHECK(nxld_log_segment_available(segment) == 0);
+    NXLD_CHECK(count_lines(rotated, "aaaa") == lines);
+    // 失败的新段截回原长度，而不是保留预分配的零字节 / The failed new segment is truncated back instead of keeping the preallocated zero bytes / Das fehlgeschlagene neue Segment wird zurückgekürzt, statt die vorab reservierten Nullbytes zu behalten
+    NXLD_CHECK(file_size(path) == 0);
+
+    // 锁定后再次轮转不再移动段 / Once latched, rotating again no longer shifts segments / Nach dem Sperren verschiebt erneutes Rotieren keine Segmente mehr
+    for (int i = 0; i < 10; i++) {
+        NXLD_CHECK(nxld_log_segment_rotate(segment) != 0);
+    }
+    g_fail_mappings = 0;
+    NXLD_CHECK(nxld_log_segment_rotate(segment) != 0);
+    NXLD_CHECK(count_lines(rotated, "aaaa") == lines);
+    NXLD_CHECK(file_size(oldest) == -1);
+
+    nxld_log_segment_append(segment, "ignored\n", 8);
+    nxld_log_segment_close(segment);
+    NXLD_CHECK(file_size(path) == 0);
+    remove_segments(dir, SEGMENT_NAME);
+}
+
+/**
+ * @brief 段失败后日志系统追加到普通文件，不丢失记录 / After a segment failure the logger appends to a plain file without losing records / Nach einem Segmentfehler hängt der Logger an eine normale Datei an, ohne Datensätze zu verlieren
+ */
+static void test_logger_fallback(const char* dir) {
+    char path[NXLD_TEST_MAX_PATH];
+    char rotated[NXLD_TEST_MAX_PATH];
+    segment_path(path, dir, LOGGER_NAME, 0);
+    segment_path(rotated, dir, LOGGER_NAME, 1);
+    remove_segments(dir, LOGGER_NAME);
+
+    nxld_logger_set_segments(SEGMENT_SIZE, SEGMENT_COUNT);
+    NXLD_CHECK(nxld_logger_init(path) == 0);
+    nxld_log_info("before the failure");
+    g_fail_mappings = 1;
+    for (int i = 0; i < LOGGER_LINES; i++) {
+        nxld_log_info("after the failure, line %d of the fallback test", i);
+    }
+    nxld_logger_close();
+    g_fail_mappings = 0;
+    nxld_logger_set_segments(0, 0);
+
+    NXLD_CHECK(count_lines(rotated, "before the failure") == 1);
+    NXLD_CHECK(count_lines(rotated, "after the failure") + count_lines(path, "after the failure") == LOGGER_LINES);
+    NXLD_CHECK(count_lines(path, "could not be mapped") == 1);
+    NXLD_CHECK(file_size(path) > 0 && has_no_zero_bytes(path));
+    remove_segments(dir, LOGGER_NAME);
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : NXLD_TEST_DEFAULT_DIR;
+    test_rotation(dir);
+    test_mapping_failure(dir);
+    test_logger_fallback(dir);
+    return NXLD_TEST_RESULT("test_log_segment");
+}
@@ -0,0 +1,213 @@
+/**
+ * @file test_lz.c
+ * @brief LZ4帧往返测试 / LZ4 frame round-trip test / LZ4-Rahmen-Roundtrip-Test
+ * @details 解码lz4命令行工具写出的参考帧，检查写出的帧头与参考格式逐字节一致，并往返压缩跨越多个块的文件；PATH中有lz4时再用它解压写出的帧 / Decodes reference frames written by the lz4 command line tool, checks that written frame headers match the reference format byte for byte and round-trips a file spanning several blocks; when lz4 is on PATH it also decompresses the written frame / Dekodiert vom lz4-Kommandozeilenwerkzeug geschriebene Referenzrahmen, prüft, dass geschriebene Rahmenköpfe Byte für Byte dem Referenzformat entsprechen, und komprimiert eine Datei über mehrere Blöcke hin und zurück; ist lz4 im PATH, dekomprimiert es den geschriebenen Rahmen zusätzlich
+ *
+ * 用法 / Usage / Verwendung:
+ *   test_lz [DIR]
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "nxld_lz.h"
+#include "tests/nxld_test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define REFERENCE_LINES 16
+#define ROUND_TRIP_SIZE (600 * 1024)
+#define RANDOM_START (300 * 1024)
+#define RANDOM_END (400 * 1024)
+
+/**
+ * @brief lz4 -qf写出的参考帧（独立块、内容校验和） / Reference frame written by lz4 -qf (independent blocks, content checksum) / Von lz4 -qf geschriebener Referenzrahmen (unabhängige Blöcke, Inhaltsprüfsumme)
+ */
+static const unsigned char g_reference_default[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0x7b, 0x00, 0x00, 0x00, 0xfb, 0x18, 0x72, 0x65, 0x66,
+    0x65, 0x72, 0x65, 0x6e, 0x63, 0x65, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x30, 0x20, 0x6f, 0x66,
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x4c, 0x5a, 0x34, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x74,
+    0x65, 0x73, 0x74, 0x0a, 0x27, 0x00, 0x1f, 0x31, 0x27, 0x00, 0x13, 0x1f, 0x32, 0x27, 0x00, 0x13,
+    0x1f, 0x33, 0x27, 0x00, 0x13, 0x1f, 0x34, 0x27, 0x00, 0x13, 0x1f, 0x35, 0x27, 0x00, 0x13, 0x1f,
+    0x36, 0x27, 0x00, 0x13, 0x1f, 0x37, 0x27, 0x00, 0x13, 0x1f, 0x38, 0x27, 0x00, 0x13, 0x1f, 0x39,
+    0x27, 0x00, 0x13, 0x1f, 0x31, 0x87, 0x01, 0x15, 0x0f, 0x88, 0x01, 0x14, 0x1f, 0x31, 0x89, 0x01,
+    0x14, 0x1f, 0x31, 0x8a, 0x01, 0x14, 0x1f, 0x31, 0x8b, 0x01, 0x14, 0x1f, 0x31, 0x8c, 0x01, 0x00,
+    0x50, 0x74, 0x65, 0x73, 0x74, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xfb, 0x18, 0x01, 0xef
+};
+
+/**
+ * @brief lz4 -qf -BX --content-size写出的参考帧（块校验和、内容大小） / Reference frame written by lz4 -qf -BX --content-size (block checksums, content size) / Von lz4 -qf -BX --content-size geschriebener Referenzrahmen (Blockprüfsummen, Inhaltsgröße)
+ */
+static const unsigned char g_reference_checksums[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x7c, 0x40, 0x76, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xbc, 0x7b,
+    0x00, 0x00, 0x00, 0xfb, 0x18, 0x72, 0x65, 0x66, 0x65, 0x72, 0x65, 0x6e, 0x63, 0x65, 0x20, 0x6c,
+    0x69, 0x6e, 0x65, 0x20, 0x30, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x4c, 0x5a, 0x34,
+    0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x74, 0x65, 0x73, 0x74, 0x0a, 0x27, 0x00, 0x1f, 0x31,
+    0x27, 0x00, 0x13, 0x1f, 0x32, 0x27, 0x00, 0x13, 0x1f, 0x33, 0x27, 0x00, 0x13, 0x1f, 0x34, 0x27,
+    0x00, 0x13, 0x1f, 0x35, 0x27, 0x00, 0x13, 0x1f, 0x36, 0x27, 0x00, 0x13, 0x1f, 0x37, 0x27, 0x00,
+    0x13, 0x1f, 0x38, 0x27, 0x00, 0x13, 0x1f, 0x39, 0x27, 0x00, 0x13, 0x1f, 0x31, 0x87, 0x01, 0x15,
+    0x0f, 0x88, 0x01, 0x14, 0x1f, 0x31, 0x89, 0x01, 0x14, 0x1f, 0x31, 0x8a, 0x01, 0x14, 0x1f, 0x31,
+    0x8b, 0x01, 0x14, 0x1f, 0x31, 0x8c, 0x01, 0x00, 0x50, 0x74, 0x65, 0x73, 0x74, 0x0a, 0xd9, 0xd4,
+    0x9f, 0x93, 0x00, 0x00, 0x00, 0x00, 0xfb, 0x18, 0x01, 0xef
+};
+
+/**
+ * @brief lz4 -B5 --no-frame-crc写出的帧头（256KB独立块、无校验和），即本模块写出的格式 / Frame header written by lz4 -B5 --no-frame-crc (256 KB independent blocks, no checksums), the format this module writes / Von lz4 -B5 --no-frame-crc geschriebener Rahmenkopf (unabhängige 256-KB-Blöcke, keine Prüfsummen), das Format, das dieses Modul schreibt
+ */
+static const unsigned char g_reference_header[NXLD_LZ_HEADER_SIZE] = { 0x04, 0x22, 0x4d, 0x18, 0x60, 0x50, 0xfb };
+
+/**
+ * @brief lz4 -B4 -BD写出的帧头（相互依赖的块）后接结束标记 / Frame header written by lz4 -B4 -BD (linked blocks) followed by an end mark / Von lz4 -B4 -BD geschriebener Rahmenkopf (verkettete Blöcke), gefolgt von einer Endmarke
+ */
+static const unsigned char g_reference_linked[] = { 0x04, 0x22, 0x4d, 0x18, 0x44, 0x40, 0x5e, 0x00, 0x00, 0x00, 0x00 };
+
+/**
+ * @brief 生成参考帧的原始内容 / Build the raw content of the reference frames / Rohinhalt der Referenzrahmen erzeugen
+ */
+static size_t reference_input(char* buffer, size_t capacity) {
+    size_t length = 0;
+    for (int i = 0; i < REFERENCE_LINES; i++) {
+        length += (size_t)snprintf(buffer + length, capacity - length, "reference line %d of the LZ4 frame test\n", i);
+    }
+    return length;
+}
+
+/**
+ * @brief 读取整个文件 / Read a whole file / Eine ganze Datei lesen
+ */
+static unsigned char* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = (unsigned char*)malloc(length > 0 ? (size_t)length : 1);
+    if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = (size_t)length;
+    return data;
+}
+
+/**
+ * @brief 解码lz4命令行工具写出的帧，拒绝相互依赖的块 / Decode frames written by the lz4 command line tool and reject linked blocks / Vom lz4-Kommandozeilenwerkzeug geschriebene Rahmen dekodieren und verkettete Blöcke ablehnen
+ */
+static void test_reference_frames(void) {
+    char expected[1024];
+    size_t expected_size = reference_input(expected, sizeof(expected));
+
+    const unsigned char* frames[] = { g_reference_default, g_reference_checksums };
+    const size_t sizes[] = { sizeof(g_reference_default), sizeof(g_reference_checksums) };
+    for (size_t i = 0; i < 2; i++) {
+        NXLD_CHECK(nxld_lz_is_frame(frames[i], sizes[i]));
+        size_t size = 0;
+        int complete = 0;
+        unsigned char* data = nxld_lz_decompress_frame(frames[i], sizes[i], &size, &complete);
+        NXLD_CHECK(data != NULL);
+        NXLD_CHECK(complete);
+        NXLD_CHECK(size == expected_size);
+        NXLD_CHECK(data != NULL && size == expected_size && memcmp(data, expected, size) == 0);
+        free(data);
+    }
+
+    size_t size = 0;
+    NXLD_CHECK(!nxld_lz_is_frame(g_reference_linked, sizeof(g_reference_linked)));
+    NXLD_CHECK(nxld_lz_decompress_frame(g_reference_linked, sizeof(g_reference_linked), &size, NULL) == NULL);
+}
+
+/**
+ * @brief 往返压缩跨越多个块的文件，包括截断的帧 / Round-trip a file spanning several blocks, including a truncated frame / Eine Datei über mehrere Blöcke hin und zurück komprimieren, einschließlich eines abgeschnittenen Rahmens
+ * @details 中间一段随机数据使该块原样存储 / A stretch of random data in the middle makes that block stored as is / Ein Abschnitt zufälliger Daten in der Mitte lässt diesen Block unverändert speichern
+ */
+static void test_round_trip(const char* dir) {
+    char raw_path[NXLD_TEST_MAX_PATH];
+    char frame_path[NXLD_TEST_MAX_PATH];
+    char decoded_path[NXLD_TEST_MAX_PATH];
+    snprintf(raw_path, sizeof(raw_path), "%s/test_lz.raw", dir);
+    snprintf(frame_path, sizeof(frame_path), "%s/test_lz.raw%s", dir, NXLD_LZ_EXTENSION);
+    snprintf(decoded_path, sizeof(decoded_path), "%s/test_lz.decoded", dir);
+
+    unsigned char* input = (unsigned char*)malloc(ROUND_TRIP_SIZE);
+    NXLD_CHECK(input != NULL);
+    if (input == NULL) {
+        return;
+    }
+    size_t length = 0;
+    for (int line = 0; length < ROUND_TRIP_SIZE; line++) {
+        char text[64];
+        int n = snprintf(text, sizeof(text), "[INFO] round trip line %d value %d\n", line, line * 7 % 1000);
+        for (int i = 0; i < n && length < ROUND_TRIP_SIZE; i++) {
+            input[length++] = (unsigned char)text[i];
+        }
+    }
+    uint32_t state = 2463534242u;
+    for (size_t i = RANDOM_START; i < RANDOM_END; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        input[i] = (unsigned char)state;
+    }
+
+    FILE* file = fopen(raw_path, "wb");
+    NXLD_CHECK(file != NULL);
+    if (file != NULL) {
+        fwrite(input, 1, ROUND_TRIP_SIZE, file);
+        fclose(file);
+    }
+    NXLD_CHECK(nxld_lz_compress_file(raw_path, frame_path) == 0);
+
+    size_t frame_size = 0;
+    unsigned char* frame = read_file(frame_path, &frame_size);
+    NXLD_CHECK(frame != NULL && frame_size > NXLD_LZ_HEADER_SIZE);
+    if (frame != NULL && frame_size > NXLD_LZ_HEADER_SIZE) {
+        NXLD_CHECK(memcmp(frame, g_reference_header, NXLD_LZ_HEADER_SIZE) == 0);
+        NXLD_CHECK(frame_size < ROUND_TRIP_SIZE);
+
+        size_t size = 0;
+        int complete = 0;
+        unsigned char* data = nxld_lz_decompress_frame(frame, frame_size, &size, &complete);
+        NXLD_CHECK(data != NULL && complete && size == ROUND_TRIP_SIZE);
+        NXLD_CHECK(data != NULL && size == ROUND_TRIP_SIZE && memcmp(data, input, size) == 0);
+        free(data);
+
+        // 截断的帧只返回完整的块 / A truncated frame returns only whole blocks / Ein abgeschnittener Rahmen liefert nur ganze Blöcke
+        data = nxld_lz_decompress_frame(frame, frame_size - 100, &size, &complete);
+        NXLD_CHECK(data != NULL && !complete);
+        NXLD_CHECK(size == 2 * NXLD_LZ_BLOCK_SIZE);
+        NXLD_CHECK(data != NULL && size <= ROUND_TRIP_SIZE && memcmp(data, input, size) == 0);
+        free(data);
+    }
+    free(frame);
+
+    // 参考解码器可用时用它解压 / Decompress with the reference decoder when it is available / Mit dem Referenzdecoder dekomprimieren, wenn er verfügbar ist
+    if (system("lz4 --version > /dev/null 2>&1") == 0) {
+        char command[3 * NXLD_TEST_MAX_PATH];
+        snprintf(command, sizeof(command), "lz4 -dqf '%s' '%s'", frame_path, decoded_path);
+        NXLD_CHECK(system(command) == 0);
+        size_t size = 0;
+        unsigned char* data = read_file(decoded_path, &size);
+        NXLD_CHECK(data != NULL && size == ROUND_TRIP_SIZE && memcmp(data, input, size) == 0);
+        free(data);
+    } else {
+        printf("test_lz: lz4 not on PATH, skipping the reference decoder check\n");
+    }
+
+    free(input);
+    remove(raw_path);
+    remove(frame_path);
+    remove(decoded_path);
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : NXLD_TEST_DEFAULT_DIR;
+    test_reference_frames();
+    test_round_trip(dir);
+    return NXLD_TEST_RESULT("test_lz");
+}
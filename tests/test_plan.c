@@ -0,0 +1,98 @@
+/**
+ * @file test_plan.c
+ * @brief 执行计划FETCH失败测试 / Execution plan FETCH failure test / Test für FETCH-Fehler im Ausführungsplan
+ * @details Trigger主动调用Consume和Sink，两者的参数由导出接口提供；Sink的导出接口Missing无法解析，FETCH失败时必须跳过Sink调用并计入规则错误，而Consume照常执行 / Trigger actively calls Consume and Sink, both fed by export interfaces; Sink's export interface Missing cannot be resolved, so the failing FETCH must skip the Sink call and count a rule error while Consume runs as usual / Trigger ruft Consume und Sink aktiv auf, beide werden von Exportschnittstellen versorgt; die Exportschnittstelle Missing von Sink lässt sich nicht auflösen, daher muss der fehlschlagende FETCH den Sink-Aufruf überspringen und einen Regelfehler zählen, während Consume normal läuft
+ */
+
+#include "tests/nxld_test.h"
+#include "tests/test_fixture.h"
+#include "nxld_logger.h"
+
+#define TEST_NAME "test_plan"
+#define TEST_VALUE 5
+#define TEST_PRODUCED 7
+#define TEST_CALLS 3
+#define TEST_CONTEXT_CALLS 2
+
+/**
+ * @brief 写入规则文件 / Write the rule file / Regeldatei schreiben
+ */
+static int write_rules(const test_fixture_t* fixture) {
+    FILE* fp = test_fixture_begin_rules(fixture, TEST_NAME, 5);
+    if (fp == NULL) {
+        return -1;
+    }
+    test_fixture_write_rule(fixture, fp, 0, "TestDriver", "Src0", 0, "Trigger", 0, NULL);
+    test_fixture_write_rule(fixture, fp, 1, "TestPlugin", "Trigger", -1, "Consume", 0, NULL);
+    test_fixture_write_rule(fixture, fp, 2, "TestPlugin", "Produce", 0, "Consume", 0, NULL);
+    test_fixture_write_rule(fixture, fp, 3, "TestPlugin", "Trigger", -1, "Sink", 0, NULL);
+    test_fixture_write_rule(fixture, fp, 4, "TestPlugin", "Missing", 0, "Sink", 0, NULL);
+    fclose(fp);
+    return 0;
+}
+
+/**
+ * @brief 检查计划结果 / Check the plan results / Planergebnisse prüfen
+ * @param calls 已执行的调用次数 / Number of calls executed / Anzahl ausgeführter Aufrufe
+ */
+static void check_results(const test_fixture_t* fixture, const nxld_transfer_rule_set_t* rules,
+                          const nxld_transfer_plan_t* plan, int calls) {
+    NXLD_CHECK(test_fixture_count(fixture, "Trigger") == calls);
+    NXLD_CHECK(test_fixture_sum(fixture, "Trigger") == (long long)calls * TEST_VALUE);
+    NXLD_CHECK(test_fixture_count(fixture, "Produce") == calls);
+    NXLD_CHECK(test_fixture_count(fixture, "Consume") == calls);
+    NXLD_CHECK(test_fixture_sum(fixture, "Consume") == (long long)calls * (TEST_VALUE + TEST_PRODUCED));
+    NXLD_CHECK(test_fixture_count(fixture, "Sink") == 0);
+
+    nxld_metrics_series_t consume;
+    nxld_metrics_series_t sink;
+    size_t consume_rule = test_fixture_find_rule(rules, "Trigger", "Consume");
+    size_t sink_rule = test_fixture_find_rule(rules, "Trigger", "Sink");
+    NXLD_CHECK(nxld_transfer_plan_get_rule_metrics(plan, consume_rule, &consume) == 0);
+    NXLD_CHECK(nxld_transfer_plan_get_rule_metrics(plan, sink_rule, &sink) == 0);
+    NXLD_CHECK(consume.calls == (uint64_t)calls && consume.errors == 0);
+    NXLD_CHECK(sink.calls == 0 && sink.errors == (uint64_t)calls);
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : NXLD_TEST_DEFAULT_DIR;
+    test_fixture_t fixture;
+    nxld_transfer_rule_set_t rules;
+    nxld_transfer_plan_t plan;
+    int value = TEST_VALUE;
+
+    if (test_fixture_open(&fixture, dir, TEST_FIXTURE_PLUGIN) != 0) {
+        return 1;
+    }
+    if (write_rules(&fixture) != 0 || test_fixture_compile(&fixture, TEST_NAME, &rules, &plan) != 0) {
+        fprintf(stderr, "Failed to compile the test plan\n");
+        test_fixture_remove_rules(&fixture, TEST_NAME);
+        test_fixture_close(&fixture);
+        return 1;
+    }
+    test_fixture_reset(&fixture);
+
+    // 每次调用都因Sink的FETCH失败而返回-1 / Every call returns -1 because Sink's FETCH fails / Jeder Aufruf gibt -1 zurück, weil der FETCH von Sink fehlschlägt
+    for (int i = 0; i < TEST_CALLS; i++) {
+        NXLD_CHECK(nxld_transfer_plan_call(&plan, "TestDriver", "Src0", 0, &value) == -1);
+    }
+    check_results(&fixture, &rules, &plan, TEST_CALLS);
+
+    // 独立的执行上下文同样跳过Sink而执行Consume / A separate execution context likewise skips Sink and runs Consume / Ein eigener Ausführungskontext überspringt Sink ebenso und führt Consume aus
+    nxld_plan_context_t* context = nxld_transfer_plan_context_create(&plan);
+    NXLD_CHECK(context != NULL);
+    if (context != NULL) {
+        for (int i = 0; i < TEST_CONTEXT_CALLS; i++) {
+            NXLD_CHECK(nxld_transfer_plan_call_context(context, "TestDriver", "Src0", 0, &value) == -1);
+        }
+        nxld_transfer_plan_context_free(context);
+        check_results(&fixture, &rules, &plan, TEST_CALLS + TEST_CONTEXT_CALLS);
+    }
+
+    nxld_transfer_plan_free(&plan);
+    nxld_transfer_rules_free(&rules);
+    test_fixture_remove_rules(&fixture, TEST_NAME);
+    test_fixture_close(&fixture);
+    nxld_logger_close();
+    return NXLD_TEST_RESULT(TEST_NAME);
+}
@@ -0,0 +1,237 @@
+/**
+ * @file test_plugin.c
+ * @brief 测试用插件 / Plugin for tests / Plugin für Tests
+ * @details 接口记录调用次数和收到的值，测试通过test_plugin_count和test_plugin_sum读取；Produce返回最近一次Trigger收到的值加TEST_PLUGIN_PRODUCED；Missing只在元数据中声明而不导出，用于模拟解析失败的导出接口。定义TEST_PLUGIN_CONTEXT时构建为上下文感知插件，每个调用链上下文单独保存状态，Trigger随后让出处理器以便其他调用链插入，上下文销毁时记录合并到全局记录 / Interfaces record how often they were called and the values they received, which tests read through test_plugin_count and test_plugin_sum; Produce returns the value last received by Trigger plus TEST_PLUGIN_PRODUCED; Missing is only declared in the metadata and not exported, simulating an export interface that fails to resolve. With TEST_PLUGIN_CONTEXT defined it builds as a context-aware plugin that keeps its state per chain context, Trigger then yields the processor so other chains interleave, and a context's records merge into the global records when it is destroyed / Schnittstellen zeichnen auf, wie oft sie aufgerufen wurden und welche Werte sie erhielten, was Tests über test_plugin_count und test_plugin_sum lesen; Produce gibt den zuletzt von Trigger empfangenen Wert plus TEST_PLUGIN_PRODUCED zurück; Missing wird nur in den Metadaten deklariert und nicht exportiert und simuliert eine Exportschnittstelle, die sich nicht auflösen lässt. Mit TEST_PLUGIN_CONTEXT wird es als kontextbewusstes Plugin gebaut, das seinen Zustand je Kettenkontext hält, Trigger gibt danach den Prozessor ab, damit sich andere Ketten einschieben, und die Aufzeichnungen eines Kontexts werden beim Zerstören in die globalen zusammengeführt
+ */
+
+#if defined(TEST_PLUGIN_CONTEXT) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "nxld_plugin_interface.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef TEST_PLUGIN_CONTEXT
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#endif
+
+#define TEST_PLUGIN_NAME "TestPlugin"
+#define TEST_PLUGIN_VERSION "1.0.0"
+
+/**
+ * @brief Produce在Trigger收到的值上加的偏移 / Offset Produce adds to the value Trigger received / Versatz, den Produce zum von Trigger empfangenen Wert addiert
+ */
+#define TEST_PLUGIN_PRODUCED 7
+
+/**
+ * @brief 接口描述结构体 / Interface description structure / Schnittstellenbeschreibungsstruktur
+ */
+typedef struct {
+    const char* name;                       /**< 接口名称 / Interface name / Schnittstellenname */
+    int param_count;                        /**< int参数数量 / Number of int parameters / Anzahl der int-Parameter */
+} test_interface_t;
+
+/**
+ * @brief 接口调用记录结构体 / Interface call record structure / Struktur der Schnittstellenaufrufe
+ */
+typedef struct {
+    int count;                              /**< 调用次数 / Call count / Anzahl der Aufrufe */
+    long long sum;                          /**< 收到的值之和 / Sum of the values received / Summe der empfangenen Werte */
+} test_calls_t;
+
+enum { TEST_TRIGGER, TEST_PRODUCE, TEST_MISSING, TEST_CONSUME, TEST_SINK };
+
+static const test_interface_t g_interfaces[] = {
+    { "Trigger", 1 },
+    { "Produce", 0 },
+    { "Missing", 0 },
+    { "Consume", 1 },
+    { "Sink", 1 }
+};
+
+#define TEST_INTERFACE_COUNT (sizeof(g_interfaces) / sizeof(g_interfaces[0]))
+
+/**
+ * @brief 插件状态结构体 / Plugin state structure / Plugin-Zustandsstruktur
+ */
+typedef struct {
+    test_calls_t calls[TEST_INTERFACE_COUNT]; /**< 各接口的调用记录 / Call records per interface / Aufrufaufzeichnungen je Schnittstelle */
+    int last;                               /**< 最近一次Trigger收到的值 / Value last received by Trigger / Zuletzt von Trigger empfangener Wert */
+} test_state_t;
+
+static test_state_t g_state;
+
+#ifdef TEST_PLUGIN_CONTEXT
+static pthread_mutex_t g_state_mutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread test_state_t* g_bound_state = NULL;
+#endif
+
+/**
+ * @brief 获取当前调用使用的状态 / Get the state the current call uses / Zustand abrufen, den der aktuelle Aufruf verwendet
+ */
+static test_state_t* current_state(void) {
+#ifdef TEST_PLUGIN_CONTEXT
+    if (g_bound_state != NULL) {
+        return g_bound_state;
+    }
+#endif
+    return &g_state;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_name(char* name, size_t name_size) {
+    if (name == NULL || name_size == 0) {
+        return -1;
+    }
+    snprintf(name, name_size, "%s", TEST_PLUGIN_NAME);
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_version(char* version, size_t version_size) {
+    if (version == NULL || version_size == 0) {
+        return -1;
+    }
+    snprintf(version, version_size, "%s", TEST_PLUGIN_VERSION);
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_count(size_t* count) {
+    if (count == NULL) {
+        return -1;
+    }
+    *count = TEST_INTERFACE_COUNT;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_info(size_t index, char* name, size_t name_size,
+                                                      char* description, size_t desc_size,
+                                                      char* version, size_t version_size) {
+    if (index >= TEST_INTERFACE_COUNT) {
+        return -1;
+    }
+    if (name != NULL && name_size > 0) {
+        snprintf(name, name_size, "%s", g_interfaces[index].name);
+    }
+    if (description != NULL && desc_size > 0) {
+        snprintf(description, desc_size, "Test interface");
+    }
+    if (version != NULL && version_size > 0) {
+        snprintf(version, version_size, "%s", TEST_PLUGIN_VERSION);
+    }
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_count(size_t index, nxld_param_count_type_t* count_type,
+                                                             int* min_count, int* max_count) {
+    if (index >= TEST_INTERFACE_COUNT || count_type == NULL || min_count == NULL || max_count == NULL) {
+        return -1;
+    }
+    *count_type = NXLD_PARAM_COUNT_FIXED;
+    *min_count = g_interfaces[index].param_count;
+    *max_count = g_interfaces[index].param_count;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int nxld_plugin_get_interface_param_info(size_t index, int param_index,
+                                                            char* param_name, size_t name_size,
+                                                            nxld_param_type_t* param_type,
+                                                            char* type_name, size_t type_name_size) {
+    if (index >= TEST_INTERFACE_COUNT || param_index < 0 || param_index >= g_interfaces[index].param_count) {
+        return -1;
+    }
+    if (param_name != NULL && name_size > 0) {
+        snprintf(param_name, name_size, "arg%d", param_index);
+    }
+    if (param_type != NULL) {
+        *param_type = NXLD_PARAM_TYPE_INT;
+    }
+    if (type_name != NULL && type_name_size > 0) {
+        snprintf(type_name, type_name_size, "int");
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取接口的调用次数 / Get how often an interface was called / Abrufen, wie oft eine Schnittstelle aufgerufen wurde
+ * @return 调用次数，未知接口返回-1 / Call count, -1 for an unknown interface / Anzahl der Aufrufe, -1 bei unbekannter Schnittstelle
+ */
+NXLD_PLUGIN_EXPORT int test_plugin_count(const char* interface_name) {
+    for (size_t i = 0; i < TEST_INTERFACE_COUNT; i++) {
+        if (strcmp(g_interfaces[i].name, interface_name) == 0) {
+            return g_state.calls[i].count;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 获取接口收到的值之和 / Get the sum of the values an interface received / Summe der von einer Schnittstelle empfangenen Werte abrufen
+ */
+NXLD_PLUGIN_EXPORT long long test_plugin_sum(const char* interface_name) {
+    for (size_t i = 0; i < TEST_INTERFACE_COUNT; i++) {
+        if (strcmp(g_interfaces[i].name, interface_name) == 0) {
+            return g_state.calls[i].sum;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 清零所有调用记录 / Clear every call record / Alle Aufrufaufzeichnungen löschen
+ */
+NXLD_PLUGIN_EXPORT void test_plugin_reset(void) {
+    memset(&g_state, 0, sizeof(g_state));
+}
+
+#ifdef TEST_PLUGIN_CONTEXT
+NXLD_PLUGIN_EXPORT void* nxld_plugin_create_context(void) {
+    return calloc(1, sizeof(test_state_t));
+}
+
+NXLD_PLUGIN_EXPORT void nxld_plugin_destroy_context(void* context) {
+    test_state_t* state = (test_state_t*)context;
+    pthread_mutex_lock(&g_state_mutex);
+    for (size_t i = 0; i < TEST_INTERFACE_COUNT; i++) {
+        g_state.calls[i].count += state->calls[i].count;
+        g_state.calls[i].sum += state->calls[i].sum;
+    }
+    pthread_mutex_unlock(&g_state_mutex);
+    free(state);
+}
+
+NXLD_PLUGIN_EXPORT void nxld_plugin_bind_context(void* context) {
+    g_bound_state = (test_state_t*)context;
+}
+#endif
+
+NXLD_PLUGIN_EXPORT int Trigger(int value) {
+    test_state_t* state = current_state();
+    state->calls[TEST_TRIGGER].count++;
+    state->calls[TEST_TRIGGER].sum += value;
+    state->last = value;
+#ifdef TEST_PLUGIN_CONTEXT
+    sched_yield();
+#endif
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int Produce(void) {
+    test_state_t* state = current_state();
+    state->calls[TEST_PRODUCE].count++;
+    return state->last + TEST_PLUGIN_PRODUCED;
+}
+
+NXLD_PLUGIN_EXPORT int Consume(int value) {
+    test_state_t* state = current_state();
+    state->calls[TEST_CONSUME].count++;
+    state->calls[TEST_CONSUME].sum += value;
+    return 0;
+}
+
+NXLD_PLUGIN_EXPORT int Sink(int value) {
+    test_state_t* state = current_state();
+    state->calls[TEST_SINK].count++;
+    state->calls[TEST_SINK].sum += value;
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_replay.c
+ * @brief 录制与回放轨迹测试 / Recording and replay trace test / Test für Aufzeichnungs- und Wiedergabespuren
+ * @details 多个线程经各自的执行上下文调用计划并录制入口数据和逐跳轨迹，回放必须逐跳与录制一致；入口数据与实际传入的值不同的录制必须被报告为偏离 / Several threads call the plan through their own execution contexts while entry data and hop traces are recorded, and the replay must match the recording at every hop; a recording whose entry data differs from the values actually passed must be reported as diverged / Mehrere Threads rufen den Plan über eigene Ausführungskontexte auf, während Einstiegsdaten und Sprungspuren aufgezeichnet werden, und die Wiedergabe muss bei jedem Sprung der Aufzeichnung entsprechen; eine Aufzeichnung, deren Einstiegsdaten von den tatsächlich übergebenen Werten abweichen, muss als abweichend gemeldet werden
+ */
+
+#include "tests/nxld_test.h"
+#include "tests/test_fixture.h"
+#include "nxld_logger.h"
+#include "nxld_replay.h"
+#include "nxld_thread.h"
+
+#define TEST_NAME "test_replay"
+#define TEST_THREADS 4
+#define TEST_CALLS_PER_THREAD 200
+#define TEST_INVOCATIONS (TEST_THREADS * TEST_CALLS_PER_THREAD)
+#define TEST_PRODUCED 7
+
+/**
+ * @brief 偏离录制中实际传入值的偏移，大于所有录制值的范围 / Offset of the values actually passed in the diverging recording, larger than the range of all recorded values / Versatz der tatsächlich übergebenen Werte in der abweichenden Aufzeichnung, größer als der Bereich aller aufgezeichneten Werte
+ */
+#define TEST_SKEW 100000
+
+/**
+ * @brief 录制线程参数结构体 / Recording thread argument structure / Argumentstruktur des Aufzeichnungsthreads
+ */
+typedef struct {
+    nxld_transfer_plan_t* plan;             /**< 执行计划 / Execution plan / Ausführungsplan */
+    nxld_replay_recorder_t* recorder;       /**< 录制器 / Recorder / Aufzeichner */
+    int base;                               /**< 本线程的第一个值 / First value of this thread / Erster Wert dieses Threads */
+    int skew;                               /**< 实际传入值相对录制值的偏移 / Offset of the passed value from the recorded one / Versatz des übergebenen Werts zum aufgezeichneten */
+    int failed;                             /**< 失败的调用数量 / Failed calls / Fehlgeschlagene Aufrufe */
+} record_worker_t;
+
+/**
+ * @brief 录制线程：录制入口值后在自己的上下文中调用计划 / Recording thread: records the entry value, then calls the plan on its own context / Aufzeichnungsthread: zeichnet den Einstiegswert auf und ruft dann den Plan im eigenen Kontext auf
+ */
+static void record_thread(void* arg) {
+    record_worker_t* worker = (record_worker_t*)arg;
+    nxld_plan_context_t* context = nxld_transfer_plan_context_create(worker->plan);
+    if (context == NULL) {
+        worker->failed = TEST_CALLS_PER_THREAD;
+        return;
+    }
+    for (int i = 0; i < TEST_CALLS_PER_THREAD; i++) {
+        int value = worker->base + i;
+        int passed = value + worker->skew;
+        nxld_replay_record(worker->recorder, "TestDriver", "Src0", 0, NXLD_PARAM_TYPE_INT, &value);
+        if (nxld_transfer_plan_call_context(context, "TestDriver", "Src0", 0, &passed) != 0) {
+            worker->failed++;
+        }
+    }
+    nxld_transfer_plan_context_free(context);
+}
+
+/**
+ * @brief 并发录制计划调用 / Record plan calls concurrently / Planaufrufe gleichzeitig aufzeichnen
+ * @return 成功返回0，失败返回-1 / Returns 0 on success, -1 on failure / Gibt 0 bei Erfolg zurück, -1 bei Fehler
+ */
+static int record_calls(nxld_transfer_plan_t* plan, const nxld_transfer_rule_set_t* rules, const char* path, int skew) {
+    nxld_replay_recorder_t* recorder = nxld_replay_recorder_open(path, rules);
+    if (recorder == NULL || nxld_replay_recorder_attach(recorder, plan) != 0) {
+        if (recorder != NULL) {
+            nxld_replay_recorder_close(recorder);
+        }
+        return -1;
+    }
+
+    record_worker_t workers[TEST_THREADS];
+    nxld_thread_t threads[TEST_THREADS];
+    int started = 0;
+    for (int i = 0; i < TEST_THREADS; i++) {
+        workers[i].plan = plan;
+        workers[i].recorder = recorder;
+        workers[i].base = i * TEST_CALLS_PER_THREAD;
+        workers[i].skew = skew;
+        workers[i].failed = 0;
+        if (nxld_thread_create(&threads[i], record_thread, &workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    int failed = started == TEST_THREADS ? 0 : 1;
+    for (int i = 0; i < started; i++) {
+        nxld_thread_join(threads[i]);
+        failed += workers[i].failed;
+    }
+    if (nxld_replay_recorder_close(recorder) != 0) {
+        return -1;
+    }
+    return failed == 0 ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : NXLD_TEST_DEFAULT_DIR;
+    test_fixture_t fixture;
+    nxld_transfer_rule_set_t rules;
+    nxld_transfer_plan_t plan;
+    nxld_replay_stats_t stats;
+    char path[TEST_FIXTURE_MAX_PATH + 64];
+    const long long recorded_sum = (long long)TEST_INVOCATIONS * (TEST_INVOCATIONS - 1) / 2;
+
+    if (test_fixture_open(&fixture, dir, TEST_FIXTURE_PLUGIN) != 0) {
+        return 1;
+    }
+    FILE* fp = test_fixture_begin_rules(&fixture, TEST_NAME, 3);
+    if (fp != NULL) {
+        test_fixture_write_rule(&fixture, fp, 0, "TestDriver", "Src0", 0, "Trigger", 0, NULL);
+        test_fixture_write_rule(&fixture, fp, 1, "TestPlugin", "Trigger", -1, "Consume", 0, NULL);
+        test_fixture_write_rule(&fixture, fp, 2, "TestPlugin", "Produce", 0, "Consume", 0, NULL);
+        fclose(fp);
+    }
+    if (fp == NULL || test_fixture_compile(&fixture, TEST_NAME, &rules, &plan) != 0) {
+        fprintf(stderr, "Failed to compile the test plan\n");
+        test_fixture_remove_rules(&fixture, TEST_NAME);
+        test_fixture_close(&fixture);
+        return 1;
+    }
+    snprintf(path, sizeof(path), "%s/%s.rec", fixture.work_dir, TEST_NAME);
+
+    // 并发完成的调用按内容配对，回放必须与录制逐跳一致 / Concurrently finished calls pair by content, and the replay must match the recording at every hop / Gleichzeitig beendete Aufrufe werden nach Inhalt gepaart, und die Wiedergabe muss bei jedem Sprung der Aufzeichnung entsprechen
+    test_fixture_reset(&fixture);
+    NXLD_CHECK(record_calls(&plan, &rules, path, 0) == 0);
+    NXLD_CHECK(plan.observer == NULL);
+    NXLD_CHECK(test_fixture_sum(&fixture, "Trigger") == recorded_sum);
+    test_fixture_reset(&fixture);
+    NXLD_CHECK(nxld_replay_run(&plan, &rules, path, NXLD_REPLAY_PACING_FAST, &stats) == 0);
+    NXLD_CHECK(stats.invocations == TEST_INVOCATIONS && stats.failed == 0 && stats.skipped == 0);
+    NXLD_CHECK(stats.traces == TEST_INVOCATIONS && stats.diverged == 0 && stats.constants_match);
+    NXLD_CHECK(test_fixture_count(&fixture, "Trigger") == TEST_INVOCATIONS);
+    NXLD_CHECK(test_fixture_sum(&fixture, "Trigger") == recorded_sum);
+    NXLD_CHECK(test_fixture_sum(&fixture, "Consume") == recorded_sum + (long long)TEST_INVOCATIONS * TEST_PRODUCED);
+
+    // 实际传入值与录制的入口值不同：每次回放都偏离 / The values actually passed differ from the recorded entry values, so every replayed call diverges / Die tatsächlich übergebenen Werte weichen von den aufgezeichneten Einstiegswerten ab, daher weicht jeder wiedergegebene Aufruf ab
+    NXLD_CHECK(record_calls(&plan, &rules, path, TEST_SKEW) == 0);
+    NXLD_CHECK(nxld_replay_run(&plan, &rules, path, NXLD_REPLAY_PACING_FAST, &stats) == -1);
+    NXLD_CHECK(stats.invocations == TEST_INVOCATIONS && stats.failed == 0);
+    NXLD_CHECK(stats.traces == TEST_INVOCATIONS && stats.diverged == TEST_INVOCATIONS);
+
+    remove(path);
+    nxld_transfer_plan_free(&plan);
+    nxld_transfer_rules_free(&rules);
+    test_fixture_remove_rules(&fixture, TEST_NAME);
+    test_fixture_close(&fixture);
+    nxld_logger_close();
+    return NXLD_TEST_RESULT(TEST_NAME);
+}